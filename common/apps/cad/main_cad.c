@@ -0,0 +1,457 @@
+/*!
+ * @file      main_cad.c
+ *
+ * @brief     Channel Activity Detection (CAD) example for LR11xx and SX126x chips
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "apps_common.h"
+#include "apps_cad_scan.h"
+#include "apps_cad_tuner.h"
+#include "apps_radio.h"
+#include "main_cad.h"
+#include "smtc_hal_mcu.h"
+#include "smtc_hal_dbg_trace.h"
+#include "uart_init.h"
+#include "atc.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/**
+ * @brief Interrupt mask used by the application
+ */
+#define IRQ_MASK                                                                                                 \
+    ( APPS_RADIO_IRQ_TX_DONE | APPS_RADIO_IRQ_RX_DONE | APPS_RADIO_IRQ_TIMEOUT | APPS_RADIO_IRQ_HEADER_ERROR | \
+      APPS_RADIO_IRQ_CRC_ERROR | APPS_RADIO_IRQ_CAD_DONE | APPS_RADIO_IRQ_CAD_DETECTED )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static apps_radio_t radio;
+
+static apps_radio_cad_params_t cad_params = {
+    .nb_symbols    = CAD_SYMBOL_NUM,
+    .detect_peak   = CAD_DETECT_PEAK,
+    .detect_min    = CAD_DETECT_MIN,
+    .exit_mode     = CAD_EXIT_MODE,
+    .timeout_in_ms = 0,
+};
+
+static uint8_t  buffer[PAYLOAD_LENGTH];
+static uint32_t iteration_number        = 0;
+static uint32_t received_packet_counter = 0;
+static uint32_t detection_counter       = 0;
+
+static smtc_hal_mcu_timer_soft_t cad_timer;
+
+/**
+ * @brief Adaptive CAD tuning state
+ */
+static bool     is_cad_tuning_enabled = false;
+static uint32_t cad_start_in_us       = 0;
+static uint32_t rx_start_in_us        = 0;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Dispatch the interrupts of the radio
+ *
+ * @param [in] radio_irq Radio that raised the interrupts
+ * @param [in] irq Interrupts raised
+ */
+static void cad_on_radio_irq( const apps_radio_t* radio_irq, apps_radio_irq_mask_t irq );
+
+static void cad_on_detected( void );
+static void cad_on_undetected( void );
+static void cad_on_tx_done( void );
+static void cad_on_rx_done( void );
+
+/**
+ * @brief Handle reception failure for CAD example
+ */
+static void cad_reception_failure_handling( void );
+
+/**
+ * @brief Add a delay before setting to CAD mode
+ *
+ * @param [in] delay_ms Delay time before setting to CAD mode, changing the value to adjust CAD pace
+ *
+ */
+static void start_cad_after_delay( uint16_t delay_ms );
+
+/**
+ * @brief Set the radio to CAD mode once the delay has elapsed
+ *
+ * @param [in] timer_context Unused
+ */
+static void start_cad( void* timer_context );
+
+/**
+ * @brief Scan the channels given with AT+CADSCAN with back-to-back CADs, then resume the periodic CAD
+ */
+static void cad_scan_run( void );
+
+/**
+ * @brief Start the adaptive tuning of the CAD of the current channel, from the parameters in cad_params
+ */
+static void cad_tuning_init( void );
+
+/**
+ * @brief Report the end of a reception to the adaptive CAD tuning
+ *
+ * @param [in] is_header_valid  true if a packet was received, even with a CRC error
+ */
+static void cad_tuning_on_rx_end( bool is_header_valid );
+
+static const char* cad_exit_mode_to_str( apps_radio_cad_exit_mode_t exit_mode );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+/**
+ * @brief Main application entry point.
+ */
+int main( void )
+{
+    const radio_registry_binding_t binding = RADIO_REGISTRY_BINDING_ARDUINO;
+
+    smtc_hal_mcu_init( );
+    apps_common_shield_init( );
+    uart_init( );
+
+    HAL_DBG_TRACE_INFO( "===== " APPS_RADIO_CHIP_NAME " CAD example =====\n\n" );
+    apps_radio_open( &radio, APPS_RADIO_CHIP_OPS, 0, &binding );
+    apps_radio_print_version( &radio );
+    HAL_DBG_TRACE_INFO( "CAD Exit Mode : %s\n", cad_exit_mode_to_str( cad_params.exit_mode ) );
+
+    // Radio parameters can be changed with AT commands until AT+START
+    main_loop( );
+
+    apps_radio_init( &radio );
+    apps_radio_set_irq_mask( &radio, IRQ_MASK );
+
+    if( USER_PROVIDED_CAD_PARAMETERS == false )
+    {
+        apps_radio_get_cad_recommended_params( &radio, ( apps_radio_lora_sf_t ) ATC_M_LORA_SF,
+                                               ( apps_radio_lora_bw_t ) ATC_M_LORA_BW, &cad_params );
+    }
+
+    if( cad_params.exit_mode == APPS_RADIO_CAD_EXIT_MODE_RX )
+    {
+        cad_params.timeout_in_ms = CAD_TIMEOUT_MS;
+    }
+    else if( cad_params.exit_mode == APPS_RADIO_CAD_EXIT_MODE_TX )
+    {
+        for( int i = 0; i < PAYLOAD_LENGTH; i++ )
+        {
+            buffer[i] = i;
+        }
+        apps_radio_write_payload( &radio, buffer, PAYLOAD_LENGTH );
+    }
+
+    if( ( CAD_ADAPTIVE_TUNING == true ) && ( cad_params.exit_mode == APPS_RADIO_CAD_EXIT_MODE_RX ) )
+    {
+        cad_tuning_init( );
+    }
+
+    smtc_hal_mcu_timer_soft_init( &cad_timer, start_cad, NULL );
+    start_cad_after_delay( DELAY_MS_BEFORE_CAD );
+
+    while( 1 )
+    {
+        apps_radio_irq_process( &radio, IRQ_MASK, cad_on_radio_irq );
+        uart_process_at_command( );
+        if( ATC_M_CAD_SCAN_SWITCH == 1 )
+        {
+            cad_scan_run( );
+        }
+        apps_radio_wait_for_event( &radio );
+    }
+}
+
+static void cad_on_radio_irq( const apps_radio_t* radio_irq, apps_radio_irq_mask_t irq )
+{
+    if( ( irq & APPS_RADIO_IRQ_TX_DONE ) != 0 )
+    {
+        cad_on_tx_done( );
+    }
+    else if( ( irq & APPS_RADIO_IRQ_HEADER_ERROR ) != 0 )
+    {
+        cad_tuning_on_rx_end( false );
+        cad_reception_failure_handling( );
+    }
+    else if( ( irq & APPS_RADIO_IRQ_CRC_ERROR ) != 0 )
+    {
+        cad_tuning_on_rx_end( true );
+        cad_reception_failure_handling( );
+    }
+    else if( ( irq & APPS_RADIO_IRQ_RX_DONE ) != 0 )
+    {
+        cad_on_rx_done( );
+    }
+    else if( ( irq & APPS_RADIO_IRQ_CAD_DONE ) != 0 )
+    {
+        if( ( irq & APPS_RADIO_IRQ_CAD_DETECTED ) != 0 )
+        {
+            cad_on_detected( );
+        }
+        else
+        {
+            cad_on_undetected( );
+        }
+    }
+    else if( ( irq & APPS_RADIO_IRQ_TIMEOUT ) != 0 )
+    {
+        cad_tuning_on_rx_end( false );
+        cad_reception_failure_handling( );
+    }
+}
+
+static void cad_on_detected( void )
+{
+    detection_counter++;
+    HAL_DBG_TRACE_INFO( "Consecutive detection(s): %d\n", detection_counter );
+    switch( cad_params.exit_mode )
+    {
+    case APPS_RADIO_CAD_EXIT_MODE_STANDBY:
+        HAL_DBG_TRACE_INFO( "Switch to StandBy mode\n" );
+        start_cad_after_delay( DELAY_MS_BEFORE_CAD );
+        break;
+    case APPS_RADIO_CAD_EXIT_MODE_RX:
+        HAL_DBG_TRACE_INFO( "Switch to RX mode\n" );
+        if( is_cad_tuning_enabled == true )
+        {
+            rx_start_in_us = apps_radio_get_irq_timestamp_in_us( );
+            apps_cad_tuner_on_cad_done( true, rx_start_in_us - cad_start_in_us );
+        }
+        break;
+    case APPS_RADIO_CAD_EXIT_MODE_TX:
+        start_cad_after_delay( DELAY_MS_BEFORE_CAD );
+        break;
+    default:
+        HAL_DBG_TRACE_ERROR( "Unknown CAD exit mode: 0x%02x\n", cad_params.exit_mode );
+        break;
+    }
+}
+
+static void cad_on_undetected( void )
+{
+    detection_counter = 0;
+    switch( cad_params.exit_mode )
+    {
+    case APPS_RADIO_CAD_EXIT_MODE_STANDBY:
+        HAL_DBG_TRACE_INFO( "Switch to StandBy mode\n" );
+        start_cad_after_delay( DELAY_MS_BEFORE_CAD );
+        break;
+    case APPS_RADIO_CAD_EXIT_MODE_RX:
+    {
+        uint32_t audit_time_in_ms = 0;
+
+        if( is_cad_tuning_enabled == true )
+        {
+            rx_start_in_us   = apps_radio_get_irq_timestamp_in_us( );
+            audit_time_in_ms = apps_cad_tuner_on_cad_done( false, rx_start_in_us - cad_start_in_us );
+        }
+        if( audit_time_in_ms > 0 )
+        {
+            // Listen anyway from time to time, to count the packets the CAD misses
+            apps_radio_set_rx( &radio, audit_time_in_ms );
+        }
+        else
+        {
+            start_cad_after_delay( DELAY_MS_BEFORE_CAD );
+        }
+        break;
+    }
+    case APPS_RADIO_CAD_EXIT_MODE_TX:
+        HAL_DBG_TRACE_INFO( "Switch to TX mode\n" );
+        break;
+    default:
+        HAL_DBG_TRACE_ERROR( "Unknown CAD exit mode: 0x%02x\n", cad_params.exit_mode );
+        break;
+    }
+}
+
+static void cad_on_tx_done( void )
+{
+    buffer[0] = buffer[0] + 1;
+    apps_radio_write_payload( &radio, buffer, PAYLOAD_LENGTH );
+    start_cad_after_delay( DELAY_MS_BEFORE_CAD );
+}
+
+static void cad_on_rx_done( void )
+{
+    memset( buffer, 0, PAYLOAD_LENGTH );
+    cad_tuning_on_rx_end( true );
+    apps_radio_read_payload( &radio, buffer, PAYLOAD_LENGTH );
+    HAL_DBG_TRACE_INFO( "Consecutive reception(s): %d\n", received_packet_counter );
+    received_packet_counter++;
+    HAL_DBG_TRACE_ARRAY( "Received packet: ", buffer, PAYLOAD_LENGTH );
+    start_cad_after_delay( DELAY_MS_BEFORE_CAD );
+}
+
+static void cad_reception_failure_handling( void )
+{
+    start_cad_after_delay( DELAY_MS_BEFORE_CAD );
+    received_packet_counter = 0;
+}
+
+static void start_cad_after_delay( uint16_t delay_ms )
+{
+    HAL_DBG_TRACE_PRINTF( "\nStart CAD, iteration %d\n", iteration_number++ );
+    smtc_hal_mcu_timer_soft_start( &cad_timer, delay_ms * 1000UL, 0 );
+}
+
+static void start_cad( void* timer_context )
+{
+    apps_radio_cad_params_t tuned_params;
+
+    if( ( is_cad_tuning_enabled == true ) && ( apps_cad_tuner_get_params( &tuned_params ) == true ) )
+    {
+        cad_params.nb_symbols  = tuned_params.nb_symbols;
+        cad_params.detect_peak = tuned_params.detect_peak;
+    }
+    cad_start_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+    apps_radio_start_cad( &radio, &cad_params );
+}
+
+static void cad_scan_run( void )
+{
+    const apps_radio_cad_params_t scan_cad_params = {
+        .nb_symbols  = cad_params.nb_symbols,
+        .detect_peak = cad_params.detect_peak,
+        .detect_min  = cad_params.detect_min,
+        .exit_mode   = APPS_RADIO_CAD_EXIT_MODE_STANDBY,
+    };
+    const uint32_t* freqs_in_hz;
+    const uint8_t   nb_channels = ATC_CadScanGetChannels( &freqs_in_hz );
+
+    ATC_M_CAD_SCAN_SWITCH = 0;
+
+    // Abort the periodic CAD and drop the interrupts it may have raised
+    smtc_hal_mcu_timer_soft_stop( &cad_timer );
+    apps_radio_set_standby( &radio, APPS_RADIO_STANDBY_CFG_RC );
+    apps_radio_irq_process( &radio, APPS_RADIO_IRQ_NONE, apps_cad_scan_on_radio_irq );
+
+    if( apps_cad_scan_init( &radio, freqs_in_hz, nb_channels, &scan_cad_params ) == true )
+    {
+        apps_cad_scan_start( ( uint32_t ) ATC_M_CAD_SCAN_NB_SWEEPS );
+        while( apps_cad_scan_is_running( ) == true )
+        {
+            apps_radio_irq_process( &radio, APPS_CAD_SCAN_IRQ_MASK, apps_cad_scan_on_radio_irq );
+            uart_process_at_command( );
+            apps_radio_wait_for_event( &radio );
+        }
+        apps_cad_scan_print( );
+    }
+    else
+    {
+        HAL_DBG_TRACE_ERROR( "Invalid CAD scan channel list\n" );
+    }
+
+    // The next periodic CAD gives its parameters back to the radio
+    apps_radio_set_rf_freq( &radio, ATC_M_RF_FREQ_IN_HZ );
+    start_cad_after_delay( DELAY_MS_BEFORE_CAD );
+}
+
+static void cad_tuning_init( void )
+{
+    const apps_radio_cad_params_t default_params = {
+        .nb_symbols  = cad_params.nb_symbols,
+        .detect_peak = cad_params.detect_peak,
+        .detect_min  = cad_params.detect_min,
+        .exit_mode   = APPS_RADIO_CAD_EXIT_MODE_RX,
+    };
+    const apps_cad_tuner_bounds_t bounds = {
+        .detect_peak_min =
+            ( cad_params.detect_peak > CAD_TUNING_DETECT_PEAK_SPAN + cad_params.detect_min )
+                ? ( uint8_t ) ( cad_params.detect_peak - CAD_TUNING_DETECT_PEAK_SPAN )
+                : cad_params.detect_min,
+        .detect_peak_max = ( uint8_t ) ( cad_params.detect_peak + CAD_TUNING_DETECT_PEAK_SPAN ),
+        .nb_symbols_min  = CAD_TUNING_SYMBOL_NUM_MIN,
+        .nb_symbols_max  = CAD_TUNING_SYMBOL_NUM_MAX,
+    };
+
+    apps_cad_tuner_init( ATC_M_RF_FREQ_IN_HZ, ( apps_radio_lora_sf_t ) ATC_M_LORA_SF,
+                         ( apps_radio_lora_bw_t ) ATC_M_LORA_BW, &default_params, &bounds );
+    is_cad_tuning_enabled = true;
+}
+
+static void cad_tuning_on_rx_end( bool is_header_valid )
+{
+    if( is_cad_tuning_enabled == true )
+    {
+        apps_cad_tuner_on_rx_end( is_header_valid, apps_radio_get_irq_timestamp_in_us( ) - rx_start_in_us );
+    }
+}
+
+static const char* cad_exit_mode_to_str( apps_radio_cad_exit_mode_t exit_mode )
+{
+    switch( exit_mode )
+    {
+    case APPS_RADIO_CAD_EXIT_MODE_STANDBY:
+        return "STANDBY";
+    case APPS_RADIO_CAD_EXIT_MODE_RX:
+        return "RX";
+    case APPS_RADIO_CAD_EXIT_MODE_TX:
+        return "TX";
+    default:
+        return "Unknown";
+    }
+}
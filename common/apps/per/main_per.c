@@ -0,0 +1,1211 @@
+/*!
+ * @file      main_per.c
+ *
+ * @brief     Packet Error Rate (PER) example for LR11xx and SX126x chips
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2022. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "apps_common.h"
+#include "apps_cycle_counter.h"
+#include "apps_link_stats.h"
+#include "apps_radio.h"
+#include "apps_rx_pool.h"
+#include "main_per.h"
+#include "smtc_hal_mcu.h"
+#include "smtc_hal_dbg_trace.h"
+#include "uart_init.h"
+#include "atc.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+#ifndef MIN
+#define MIN( a, b ) ( ( ( a ) < ( b ) ) ? ( a ) : ( b ) )
+#endif
+
+#ifndef MAX
+#define MAX( a, b ) ( ( ( a ) > ( b ) ) ? ( a ) : ( b ) )
+#endif
+
+/**
+ * @brief Interrupt mask used by the application
+ */
+#define IRQ_MASK                                                                                        \
+    ( APPS_RADIO_IRQ_TX_DONE | APPS_RADIO_IRQ_RX_DONE | APPS_RADIO_IRQ_TIMEOUT |                        \
+      APPS_RADIO_IRQ_PREAMBLE_DETECTED | APPS_RADIO_IRQ_HEADER_ERROR | APPS_RADIO_IRQ_LENGTH_ERROR | \
+      APPS_RADIO_IRQ_CRC_ERROR )
+
+/**
+ * @brief Interrupt mask of the saturating-throughput mode
+ *
+ * Preamble detection is left out: it would double the number of interrupts served per frame. No timeout either, the
+ * receiver stays in continuous reception.
+ */
+#define PER_FAST_IRQ_MASK                                                                         \
+    ( APPS_RADIO_IRQ_TX_DONE | APPS_RADIO_IRQ_RX_DONE | APPS_RADIO_IRQ_HEADER_ERROR | \
+      APPS_RADIO_IRQ_LENGTH_ERROR | APPS_RADIO_IRQ_CRC_ERROR )
+
+/**
+ * @brief Length of the sequence number at the start of the saturating-throughput frames
+ */
+#define PER_FAST_SEQ_LENGTH 4
+
+/**
+ * @brief Geometry of the per-frame RSSI and SNR histograms of the saturating-throughput mode
+ *
+ * Values outside of the histograms are counted in the first or the last bin
+ */
+#define PER_FAST_HISTOGRAM_NB_BINS 64
+#define PER_FAST_RSSI_HISTOGRAM_MIN_IN_DBM ( -140 )
+#define PER_FAST_RSSI_HISTOGRAM_BIN_IN_DB 2
+#define PER_FAST_SNR_HISTOGRAM_MIN_IN_DB ( -32 )
+#define PER_FAST_SNR_HISTOGRAM_BIN_IN_DB 1
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+static const char* const modes[] = { "Transmitter", "Receiver" };
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static apps_radio_t radio;
+
+static uint8_t buffer[PAYLOAD_LENGTH];
+
+static uint16_t nb_ok            = 0;
+static uint16_t nb_rx_timeout    = 0;
+static uint16_t nb_rx_error      = 0;
+static uint16_t nb_fsk_len_error = 0;
+
+static uint8_t rolling_counter = 0;
+
+static uint16_t per_index      = 0;
+static bool     first_pkt_flag = false;
+
+static uint8_t  per_msg[PAYLOAD_LENGTH];
+static uint32_t rx_timeout = RX_TIMEOUT_VALUE;
+
+static bool radio_reconfiguration_pending = false;
+
+static apps_radio_rx_latency_stats_t rx_latency;
+
+static smtc_hal_mcu_timer_soft_t tx_timer;
+
+/**
+ * @brief State of the on-device parameter sweep (AT+SWEEP)
+ *
+ * Sweep frames carry the frame counter in bytes 0-1 and the point index in bytes 2-3 (little endian)
+ */
+static struct
+{
+    uint32_t              index;
+    uint32_t              nb_points;
+    ATC_SweepPointTypeDef point;
+    bool                  is_point_done;
+    bool                  is_synchronised;  //!< Receiver only: false until the first frame of the sweep is received
+    uint16_t              frame_counter;
+    uint32_t              frame_period_in_ms;
+    uint32_t              start_in_ms;
+    uint32_t              deadline_in_ms;
+    uint16_t              nb_ok;
+    uint16_t              nb_rx_timeout;
+    uint16_t              nb_rx_error;
+    int16_t               rssi_min;
+    int16_t               rssi_max;
+    int32_t               rssi_sum;
+    int16_t               snr_min;
+    int16_t               snr_max;
+    int32_t               snr_sum;
+    struct
+    {
+        bool     is_pending;  //!< A frame from a later point ended the previous point and is yet to be counted
+        uint16_t point_index;
+        uint16_t frame_counter;
+        int8_t   rssi_in_dbm;
+        int8_t   snr_in_db;
+    } early_frame;  //!< Receiver only
+} sweep;
+
+/**
+ * @brief State of the saturating-throughput mode (AT+PERFAST)
+ *
+ * Frames carry a 32-bit sequence number in bytes 0-3 (little endian) so that nothing wraps on long runs. The
+ * transmitter numbers them from 0, so frames missed before the first one received are counted as lost.
+ */
+static struct
+{
+    bool     is_done;
+    bool     is_synchronised;  //!< Receiver only: false until the first frame is received
+    uint32_t seq;  //!< Transmitter: sequence number of the frame on air - receiver: highest sequence number received
+    uint32_t first_seq;
+    uint32_t nb_sent;
+    uint32_t nb_ok;
+    uint32_t nb_duplicates;  //!< Frames whose sequence number is not above the highest one received
+    uint32_t nb_crc_error;
+    uint32_t nb_header_error;
+    uint32_t nb_length_error;
+    uint32_t start_in_ms;
+    uint32_t end_in_ms;
+    int64_t  rssi_sum;
+    int64_t  snr_sum;
+    int8_t   rssi_min;
+    int8_t   rssi_max;
+    int8_t   snr_min;
+    int8_t   snr_max;
+    uint32_t rssi_histogram[PER_FAST_HISTOGRAM_NB_BINS];
+    uint32_t snr_histogram[PER_FAST_HISTOGRAM_NB_BINS];
+} per_fast;
+
+static smtc_hal_mcu_timer_soft_t per_fast_idle_timer;
+
+/**
+ * @brief Millisecond clock built on the microsecond time base, which wraps too often to time a whole sweep on its own
+ */
+static struct
+{
+    uint32_t last_in_us;
+    uint32_t remaining_in_us;
+    uint32_t time_in_ms;
+} sweep_clock;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Dispatch the interrupts of the radio
+ *
+ * @param [in] radio_irq Radio that raised the interrupts
+ * @param [in] irq Interrupts raised
+ */
+static void per_on_radio_irq( const apps_radio_t* radio_irq, apps_radio_irq_mask_t irq );
+
+static void per_on_tx_done( void );
+static void per_on_rx_done( void );
+static void per_on_header_error( void );
+
+/**
+ * @brief Handle reception failure for PER example
+ *
+ * @param [in] failure_counter pointer to the counter for each type of reception failure
+ */
+static void per_reception_failure_handling( uint16_t* failure_counter );
+
+/**
+ * @brief Apply the AT parameters changed during the test, if any, and restart reception
+ */
+static void per_restart_rx( void );
+
+/**
+ * @brief Count a received frame as valid if it has the expected length and content, and track the missed ones with
+ * its rolling counter
+ *
+ * @param [in] payload Received frame
+ * @param [in] size Length of the received frame
+ */
+static void per_check_rx_frame( const uint8_t* payload, uint8_t size );
+
+/**
+ * @brief Check the frames waiting in the RX packet pool queue and give their buffers back
+ */
+static void per_process_rx_frames( void );
+
+/**
+ * @brief Record the packet status of a received frame in the link statistics
+ *
+ * @param [in] lora_status Packet status, used if the radio is configured for LoRa
+ * @param [in] gfsk_status Packet status, used if the radio is configured for GFSK
+ * @param [in] end_of_packet_in_us On-air end of the frame
+ */
+static void per_record_link_stats( const apps_radio_lora_pkt_status_t* lora_status,
+                                   const apps_radio_gfsk_pkt_status_t* gfsk_status, uint32_t end_of_packet_in_us );
+
+/**
+ * @brief Apply the AT parameters changed during the test, if any
+ *
+ * @remark Called between two packets, when the transceiver is back in standby
+ */
+static void per_apply_pending_reconfiguration( void );
+
+/**
+ * @brief Send the next frame once the delay following a transmission has elapsed
+ *
+ * @param [in] timer_context Unused
+ */
+static void per_send_next_frame( void* timer_context );
+
+/**
+ * @brief Run the PER test over every point of the sweep grid defined with AT+SWEEP, printing one record per point
+ */
+static void per_sweep_run( void );
+
+/**
+ * @brief Apply the parameters of the current sweep point and start its first transmission / reception
+ */
+static void per_sweep_start_point( void );
+
+/**
+ * @brief Print the result record of the current sweep point
+ */
+static void per_sweep_print_record( void );
+
+/**
+ * @brief Sweep counterpart of the TX done / RX done / RX failure handlers
+ */
+static void per_sweep_on_tx_done( void );
+static void per_sweep_on_rx_done( void );
+
+/**
+ * @brief Count a frame of the current sweep point, then end the point or restart reception
+ */
+static void per_sweep_on_frame( uint16_t frame_counter, int8_t rssi_in_dbm, int8_t snr_in_db );
+static void per_sweep_on_rx_failure( uint16_t* failure_counter );
+
+/**
+ * @brief Send the next frame of the current sweep point once the guard time or the TX to TX delay has elapsed
+ *
+ * @param [in] timer_context Unused
+ */
+static void per_sweep_send_frame( void* timer_context );
+
+/**
+ * @brief Restart reception, or end the sweep point on the receiver side if the transmitter is done with it
+ */
+static void per_sweep_restart_rx( void );
+
+/**
+ * @brief Run the saturating-throughput PER test (AT+PERFAST): frames back to back, a summary at the end only
+ *
+ * The transmitter re-arms TX from the TX_DONE handler, rewriting only the sequence number. The receiver stays in
+ * continuous reception and reads the sequence number and the packet status of each frame.
+ */
+static void per_fast_run( void );
+
+/**
+ * @brief Saturating-throughput counterpart of the TX done / RX done / RX failure handlers
+ */
+static void per_fast_on_tx_done( void );
+static void per_fast_on_rx_done( void );
+static void per_fast_on_rx_failure( uint32_t* failure_counter );
+
+/**
+ * @brief Write the sequence number of the next frame and start its transmission
+ */
+static void per_fast_send_frame( void );
+
+/**
+ * @brief Account for the packet status of a frame received in the saturating-throughput mode
+ *
+ * @param [in] rssi_in_dbm Frame RSSI
+ * @param [in] snr_in_db Frame SNR, LoRa only
+ */
+static void per_fast_record_pkt_status( int8_t rssi_in_dbm, int8_t snr_in_db );
+
+/**
+ * @brief End the saturating-throughput reception once the transmitter has been silent for the RX timeout
+ *
+ * @param [in] timer_context Unused
+ */
+static void per_fast_on_idle_timeout( void* timer_context );
+
+/**
+ * @brief Print the summary of the saturating-throughput test
+ */
+static void per_fast_print_summary( void );
+
+/**
+ * @brief Print the non-empty bins of a histogram
+ *
+ * @param [in] name Histogram name
+ * @param [in] histogram Histogram, PER_FAST_HISTOGRAM_NB_BINS bins
+ * @param [in] min Lower bound of the first bin
+ * @param [in] bin_width Width of the bins
+ */
+static void per_fast_print_histogram( const char* name, const uint32_t* histogram, int min, int bin_width );
+
+/**
+ * @brief Get the time elapsed since the sweep clock started
+ *
+ * @remark Must be called at least once per time base period (about 71 minutes)
+ *
+ * @returns Time in milliseconds
+ */
+static uint32_t per_sweep_get_time_in_ms( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+/**
+ * @brief Main application entry point.
+ */
+int main( void )
+{
+    const radio_registry_binding_t binding = RADIO_REGISTRY_BINDING_ARDUINO;
+
+    smtc_hal_mcu_init( );
+    apps_common_shield_init( );
+
+    // Compile-time configuration is the default, parameters saved or set with AT commands override it until AT+START
+    ATC_M_TXRX_SWITCH = RECEIVER;
+    ATC_M_NB_FRAME    = NB_FRAME;
+    ATC_M_CW_SWITCH   = 0;
+    uart_init( );
+
+    HAL_DBG_TRACE_INFO( "===== " APPS_RADIO_CHIP_NAME " PER example =====\n\n" );
+    apps_radio_open( &radio, APPS_RADIO_CHIP_OPS, 0, &binding );
+    apps_radio_print_version( &radio );
+
+    main_loop( );
+    HAL_DBG_TRACE_INFO( "Mode: %s\n", modes[ATC_M_TXRX_SWITCH == 1] );
+
+    apps_radio_init( &radio );
+    apps_radio_print_gpio_benchmark( &radio );
+
+    smtc_hal_mcu_timer_soft_init( &tx_timer, ( ATC_M_SWEEP_SWITCH == 1 ) ? per_sweep_send_frame : per_send_next_frame,
+                                  NULL );
+
+    if( ATC_M_SWEEP_SWITCH == 1 )
+    {
+        per_sweep_run( );
+    }
+    else if( ATC_M_PER_FAST_SWITCH == 1 )
+    {
+        per_fast_run( );
+    }
+    else if( ATC_M_CW_SWITCH == 1 )
+    {
+        apps_radio_set_tx_cw( &radio );
+    }
+    else
+    {
+        apps_radio_set_irq_mask( &radio, IRQ_MASK );
+
+        for( int i = 1; i < PAYLOAD_LENGTH; i++ )
+        {
+            buffer[i] = i;
+        }
+        // Adjust reception timeout taking into account time on air
+        rx_timeout += get_time_on_air_in_ms( );
+
+        if( ATC_M_TXRX_SWITCH == 1 )
+        {
+            apps_rx_pool_init( );
+            apps_link_stats_init( TX_TO_TX_DELAY_IN_MS + get_time_on_air_in_ms( ) );
+            apps_radio_set_rx( &radio, rx_timeout );
+            memcpy( per_msg, &buffer[1], PAYLOAD_LENGTH - 1 );
+        }
+        else
+        {
+            buffer[0] = 0;
+            apps_radio_write_payload( &radio, buffer, PAYLOAD_LENGTH );
+            apps_radio_set_tx( &radio, 0 );
+        }
+
+        while( per_index < ATC_M_NB_FRAME )
+        {
+            apps_radio_irq_process( &radio, IRQ_MASK, per_on_radio_irq );
+            per_process_rx_frames( );
+
+            if( uart_process_at_command( ) == true )
+            {
+                radio_reconfiguration_pending = true;
+            }
+
+            if( per_index < ATC_M_NB_FRAME )
+            {
+                apps_radio_wait_for_event( &radio );
+            }
+        }
+        // The reception may have been re-armed before the last frame was checked
+        apps_radio_set_standby( &radio, APPS_RADIO_STANDBY_CFG_RC );
+
+        if( per_index > ATC_M_NB_FRAME )  // The last validated packet should not be counted in this case
+        {
+            nb_ok--;
+        }
+        /* Display PER*/
+        HAL_DBG_TRACE_PRINTF( "PER = %d \n", 100 - ( ( nb_ok * 100 ) / ATC_M_NB_FRAME ) );
+
+        HAL_DBG_TRACE_PRINTF( "Final PER index: %d \n", per_index );
+        HAL_DBG_TRACE_PRINTF( "Valid reception amount: %d \n", nb_ok );
+        HAL_DBG_TRACE_PRINTF( "Timeout reception amount: %d \n", nb_rx_timeout );
+        HAL_DBG_TRACE_PRINTF( "CRC Error reception amount: %d \n", nb_rx_error );
+        if( apps_radio_is_lora_pkt_type( &radio ) == false )
+        {
+            HAL_DBG_TRACE_PRINTF( "FSK Length Error reception amount: %d \n", nb_fsk_len_error );
+        }
+        if( ATC_M_TXRX_SWITCH == 1 )
+        {
+            apps_link_stats_print( );
+        }
+        apps_radio_print_irq_stats( &radio );
+        apps_radio_rx_latency_print(
+            ( PER_FUSED_RX_READ == 1 ) ? "apps_radio_receive_packet" : "apps_radio_read_payload", &rx_latency );
+#if( PER_FUSED_RX_READ == 1 )
+        apps_rx_pool_print_stats( );
+#endif
+        uart_print_lpm_stats( );
+    }
+
+    while( 1 )
+    {
+        apps_radio_wait_for_event( &radio );
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void per_on_radio_irq( const apps_radio_t* radio_irq, apps_radio_irq_mask_t irq )
+{
+    if( ( irq & APPS_RADIO_IRQ_TX_DONE ) != 0 )
+    {
+        per_on_tx_done( );
+    }
+    else if( ( irq & APPS_RADIO_IRQ_HEADER_ERROR ) != 0 )
+    {
+        per_on_header_error( );
+    }
+    else if( ( irq & APPS_RADIO_IRQ_CRC_ERROR ) != 0 )
+    {
+        per_reception_failure_handling( &nb_rx_error );
+    }
+    else if( ( irq & APPS_RADIO_IRQ_LENGTH_ERROR ) != 0 )
+    {
+        per_reception_failure_handling( &nb_fsk_len_error );
+    }
+    else if( ( irq & APPS_RADIO_IRQ_RX_DONE ) != 0 )
+    {
+        per_on_rx_done( );
+    }
+    else if( ( irq & APPS_RADIO_IRQ_TIMEOUT ) != 0 )
+    {
+        per_reception_failure_handling( &nb_rx_timeout );
+    }
+}
+
+static void per_on_tx_done( void )
+{
+    if( ATC_M_SWEEP_SWITCH == 1 )
+    {
+        per_sweep_on_tx_done( );
+        return;
+    }
+
+    if( ATC_M_PER_FAST_SWITCH == 1 )
+    {
+        per_fast_on_tx_done( );
+        return;
+    }
+
+    smtc_hal_mcu_timer_soft_start( &tx_timer, TX_TO_TX_DELAY_IN_MS * 1000, 0 );
+
+    HAL_DBG_TRACE_INFO( "End of packet on air: %u us\n",
+                        ( unsigned int ) apps_radio_get_tx_end_of_packet_in_us( &radio ) );
+}
+
+static void per_send_next_frame( void* timer_context )
+{
+    per_apply_pending_reconfiguration( );
+
+    buffer[0]++;
+    HAL_DBG_TRACE_INFO( "Counter value: %d\n", buffer[0] );
+    apps_radio_write_payload( &radio, buffer, PAYLOAD_LENGTH );
+
+    apps_radio_set_tx( &radio, 0 );
+}
+
+static void per_on_rx_done( void )
+{
+    if( ATC_M_SWEEP_SWITCH == 1 )
+    {
+        per_sweep_on_rx_done( );
+        return;
+    }
+
+    if( ATC_M_PER_FAST_SWITCH == 1 )
+    {
+        per_fast_on_rx_done( );
+        return;
+    }
+
+#if( PER_FUSED_RX_READ == 1 )
+    // Read the frame into a pooled buffer and re-arm the reception at once, unless the radio has to be reconfigured
+    // first - the frame is checked later by per_process_rx_frames, which also ends the test
+    if( radio_reconfiguration_pending == false )
+    {
+        apps_rx_pool_receive( &radio, rx_timeout );
+        return;
+    }
+    apps_rx_pool_receive( &radio, APPS_RADIO_RX_RESTART_NONE );
+#else
+    apps_radio_lora_pkt_status_t lora_status = { 0 };
+    apps_radio_gfsk_pkt_status_t gfsk_status = { 0 };
+
+    const uint8_t size = apps_radio_read_payload( &radio, buffer, PAYLOAD_LENGTH );
+    apps_radio_rx_latency_record( &rx_latency,
+                                  apps_common_cycle_counter_get( ) - apps_radio_get_irq_timestamp_in_cycles( ) );
+    per_check_rx_frame( buffer, size );
+
+    apps_radio_get_lora_pkt_status( &radio, &lora_status );
+    apps_radio_get_gfsk_pkt_status( &radio, &gfsk_status );
+    per_record_link_stats( &lora_status, &gfsk_status, apps_radio_get_rx_end_of_packet_in_us( &radio ) );
+
+    if( per_index >= ATC_M_NB_FRAME )
+    {
+        HAL_DBG_TRACE_INFO( "PER test complete.\n" );
+        return;
+    }
+#endif
+
+    per_restart_rx( );
+}
+
+static void per_on_header_error( void )
+{
+    if( ATC_M_PER_FAST_SWITCH == 1 )
+    {
+        per_fast_on_rx_failure( &per_fast.nb_header_error );
+        return;
+    }
+
+    HAL_DBG_TRACE_INFO( "Header error\n" );
+}
+
+static void per_reception_failure_handling( uint16_t* failure_counter )
+{
+    if( ATC_M_SWEEP_SWITCH == 1 )
+    {
+        per_sweep_on_rx_failure( failure_counter == &nb_rx_timeout ? &sweep.nb_rx_timeout : &sweep.nb_rx_error );
+        return;
+    }
+
+    if( ATC_M_PER_FAST_SWITCH == 1 )
+    {
+        per_fast_on_rx_failure( failure_counter == &nb_fsk_len_error ? &per_fast.nb_length_error
+                                                                      : &per_fast.nb_crc_error );
+        return;
+    }
+
+    // Let's start counting after the first received packet
+    if( first_pkt_flag == true )
+    {
+        ( *failure_counter )++;
+    }
+
+    per_restart_rx( );
+}
+
+static void per_restart_rx( void )
+{
+    per_apply_pending_reconfiguration( );
+    apps_radio_set_rx( &radio, rx_timeout );
+}
+
+static void per_check_rx_frame( const uint8_t* payload, uint8_t size )
+{
+    if( ( size != PAYLOAD_LENGTH ) || ( memcmp( &payload[1], per_msg, PAYLOAD_LENGTH - 1 ) != 0 ) )
+    {
+        HAL_DBG_TRACE_WARNING( "Invalid packet (size: %d, expected: %d)\n", size, PAYLOAD_LENGTH );
+        return;
+    }
+
+    // Let's start counting after the first received packet
+    if( first_pkt_flag == true )
+    {
+        uint8_t rolling_counter_gap = ( uint8_t ) ( payload[0] - rolling_counter );
+        nb_ok++;
+        per_index += rolling_counter_gap;
+        if( rolling_counter_gap > 1 )
+        {
+            HAL_DBG_TRACE_WARNING( "%d packet(s) missed\n", ( rolling_counter_gap - 1 ) );
+        }
+        rolling_counter = payload[0];
+    }
+    else
+    {
+        first_pkt_flag  = true;
+        rolling_counter = payload[0];
+    }
+    HAL_DBG_TRACE_INFO( "Counter value: %d, PER index: %d\n", payload[0], per_index );
+}
+
+static void per_process_rx_frames( void )
+{
+#if( PER_FUSED_RX_READ == 1 )
+    apps_radio_rx_packet_t* packet;
+
+    while( ( packet = apps_rx_pool_get_next( ) ) != NULL )
+    {
+        HAL_DBG_TRACE_INFO( "End of packet on air: %u us\n", ( unsigned int ) packet->end_of_packet_in_us );
+        apps_radio_rx_latency_record( &rx_latency, packet->latency_in_cycles );
+        per_check_rx_frame( packet->payload, packet->length );
+        per_record_link_stats( &packet->pkt_status.lora, &packet->pkt_status.gfsk, packet->end_of_packet_in_us );
+        apps_rx_pool_release( packet );
+    }
+#endif
+}
+
+static void per_record_link_stats( const apps_radio_lora_pkt_status_t* lora_status,
+                                   const apps_radio_gfsk_pkt_status_t* gfsk_status, uint32_t end_of_packet_in_us )
+{
+    smtc_link_stats_packet_t packet = {
+        .end_of_packet_in_us = end_of_packet_in_us,
+    };
+
+    if( apps_radio_is_lora_pkt_type( &radio ) == true )
+    {
+        packet.rssi_in_dbm        = lora_status->rssi_pkt_in_dbm;
+        packet.signal_rssi_in_dbm = lora_status->signal_rssi_pkt_in_dbm;
+        packet.snr_in_db          = lora_status->snr_pkt_in_db;
+        packet.is_lora            = true;
+    }
+    else
+    {
+        packet.rssi_in_dbm = gfsk_status->rssi_avg_in_dbm;
+    }
+
+    apps_link_stats_add_packet( &packet );
+}
+
+static void per_apply_pending_reconfiguration( void )
+{
+    if( radio_reconfiguration_pending == false )
+    {
+        return;
+    }
+    radio_reconfiguration_pending = false;
+
+    if( apps_radio_reconfigure( &radio ) == true )
+    {
+        // Time on air depends on the modulation parameters
+        rx_timeout = RX_TIMEOUT_VALUE + get_time_on_air_in_ms( );
+    }
+}
+
+static void per_sweep_run( void )
+{
+    sweep.nb_points              = ATC_SweepGetPointCount( );
+    sweep.is_synchronised        = false;
+    sweep.early_frame.is_pending = false;
+
+    apps_radio_set_irq_mask( &radio, IRQ_MASK );
+
+    sweep_clock.last_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+
+    HAL_DBG_TRACE_PRINTF( "SWEEP,point,freq_hz,sf,bw_khz,power_dbm,nb_frame,nb_ok,nb_crc_error,nb_timeout,per_pct,"
+                          "rssi_min,rssi_avg,rssi_max,snr_min,snr_avg,snr_max,duration_ms\n" );
+
+    for( sweep.index = 0; sweep.index < sweep.nb_points; sweep.index++ )
+    {
+        per_sweep_start_point( );
+
+        while( sweep.is_point_done == false )
+        {
+            apps_radio_irq_process( &radio, IRQ_MASK, per_on_radio_irq );
+
+            if( sweep.is_point_done == false )
+            {
+                apps_radio_wait_for_event( &radio );
+            }
+        }
+
+        per_sweep_print_record( );
+    }
+
+    HAL_DBG_TRACE_PRINTF( "SWEEP,done,%u\n", sweep.nb_points );
+    ATC_M_SWEEP_SWITCH = 0;
+}
+
+static void per_sweep_start_point( void )
+{
+    ATC_SweepApplyPoint( sweep.index, &sweep.point );
+    apps_radio_reconfigure( &radio );
+
+    sweep.is_point_done      = false;
+    sweep.frame_counter      = 0;
+    sweep.nb_ok              = 0;
+    sweep.nb_rx_timeout      = 0;
+    sweep.nb_rx_error        = 0;
+    sweep.rssi_min           = INT16_MAX;
+    sweep.rssi_max           = INT16_MIN;
+    sweep.rssi_sum           = 0;
+    sweep.snr_min            = INT16_MAX;
+    sweep.snr_max            = INT16_MIN;
+    sweep.snr_sum            = 0;
+    sweep.frame_period_in_ms = get_time_on_air_in_ms( ) + TX_TO_TX_DELAY_IN_MS;
+    sweep.start_in_ms        = per_sweep_get_time_in_ms( );
+    sweep.deadline_in_ms     = sweep.start_in_ms + SWEEP_POINT_GUARD_IN_MS +
+                           ( uint32_t ) ATC_M_NB_FRAME * sweep.frame_period_in_ms + SWEEP_FRAME_MARGIN_IN_MS;
+
+    if( sweep.index == 0 )
+    {
+        // Leave the operator time to start the transmitter
+        sweep.deadline_in_ms += SWEEP_START_TIMEOUT_IN_MS;
+    }
+
+    if( ATC_M_TXRX_SWITCH == 1 )
+    {
+        if( sweep.early_frame.is_pending == false )
+        {
+            apps_radio_set_rx( &radio, sweep.frame_period_in_ms + SWEEP_FRAME_MARGIN_IN_MS );
+        }
+        else if( sweep.early_frame.point_index == ( uint16_t ) sweep.index )
+        {
+            // The frame that ended the previous point belongs to this one
+            sweep.early_frame.is_pending = false;
+            per_sweep_on_frame( sweep.early_frame.frame_counter, sweep.early_frame.rssi_in_dbm,
+                                sweep.early_frame.snr_in_db );
+        }
+        else
+        {
+            // The transmitter is already past this point
+            sweep.is_point_done = true;
+        }
+    }
+    else
+    {
+        smtc_hal_mcu_timer_soft_start( &tx_timer, SWEEP_POINT_GUARD_IN_MS * 1000, 0 );
+    }
+}
+
+static void per_sweep_print_record( void )
+{
+    const uint32_t duration_in_ms = per_sweep_get_time_in_ms( ) - sweep.start_in_ms;
+
+    if( ATC_M_TXRX_SWITCH != 1 )
+    {
+        HAL_DBG_TRACE_PRINTF( "SWEEP,%u,%u,%d,%d,%d,%u,,,,,,,,,,,%u\n", sweep.index, sweep.point.Freq,
+                              sweep.point.Sf, sweep.point.Bw, sweep.point.Power, sweep.frame_counter,
+                              duration_in_ms );
+        return;
+    }
+
+    const uint16_t nb_ok = MIN( sweep.nb_ok, ATC_M_NB_FRAME );
+    const uint32_t per   = 100 - ( ( nb_ok * 100 ) / ATC_M_NB_FRAME );
+    const int32_t  n     = MAX( sweep.nb_ok, 1 );
+
+    if( sweep.nb_ok == 0 )
+    {
+        sweep.rssi_min = 0;
+        sweep.rssi_max = 0;
+        sweep.snr_min  = 0;
+        sweep.snr_max  = 0;
+    }
+
+    HAL_DBG_TRACE_PRINTF( "SWEEP,%u,%u,%d,%d,%d,%d,%u,%u,%u,%u,%d,%d,%d,%d,%d,%d,%u\n", sweep.index,
+                          sweep.point.Freq, sweep.point.Sf, sweep.point.Bw, sweep.point.Power, ATC_M_NB_FRAME,
+                          sweep.nb_ok, sweep.nb_rx_error, sweep.nb_rx_timeout, per, sweep.rssi_min,
+                          ( int ) ( sweep.rssi_sum / n ), sweep.rssi_max, sweep.snr_min, ( int ) ( sweep.snr_sum / n ),
+                          sweep.snr_max, duration_in_ms );
+}
+
+static void per_sweep_on_tx_done( void )
+{
+    sweep.frame_counter++;
+    if( sweep.frame_counter >= ATC_M_NB_FRAME )
+    {
+        sweep.is_point_done = true;
+        return;
+    }
+
+    smtc_hal_mcu_timer_soft_start( &tx_timer, TX_TO_TX_DELAY_IN_MS * 1000, 0 );
+}
+
+static void per_sweep_send_frame( void* timer_context )
+{
+    buffer[0] = ( uint8_t ) sweep.frame_counter;
+    buffer[1] = ( uint8_t ) ( sweep.frame_counter >> 8 );
+    buffer[2] = ( uint8_t ) sweep.index;
+    buffer[3] = ( uint8_t ) ( sweep.index >> 8 );
+
+    // The whole payload is written with the first frame of a point, only the frame counter changes afterwards
+    const uint8_t length = ( sweep.frame_counter == 0 ) ? PAYLOAD_LENGTH : 2;
+    apps_radio_write_payload( &radio, buffer, length );
+
+    apps_radio_set_tx( &radio, 0 );
+}
+
+static void per_sweep_on_rx_done( void )
+{
+    apps_radio_lora_pkt_status_t pkt_status = { 0 };
+
+    const uint8_t size = apps_radio_read_payload( &radio, buffer, PAYLOAD_LENGTH );
+    apps_radio_get_lora_pkt_status( &radio, &pkt_status );
+
+    const uint16_t frame_counter = buffer[0] | ( buffer[1] << 8 );
+    const uint16_t point_index   = buffer[2] | ( buffer[3] << 8 );
+
+    if( ( size == PAYLOAD_LENGTH ) && ( point_index > ( uint16_t ) sweep.index ) && ( point_index < sweep.nb_points ) )
+    {
+        // A frame from a later point (only the TX power differs) means the transmitter is done with this one: keep
+        // it for the point it belongs to
+        sweep.early_frame.is_pending    = true;
+        sweep.early_frame.point_index   = point_index;
+        sweep.early_frame.frame_counter = frame_counter;
+        sweep.early_frame.rssi_in_dbm   = pkt_status.rssi_pkt_in_dbm;
+        sweep.early_frame.snr_in_db     = pkt_status.snr_pkt_in_db;
+        sweep.is_synchronised           = true;
+        sweep.is_point_done             = true;
+        return;
+    }
+
+    if( ( size != PAYLOAD_LENGTH ) || ( point_index != ( uint16_t ) sweep.index ) )
+    {
+        per_sweep_restart_rx( );
+        return;
+    }
+
+    per_sweep_on_frame( frame_counter, pkt_status.rssi_pkt_in_dbm, pkt_status.snr_pkt_in_db );
+}
+
+static void per_sweep_on_frame( uint16_t frame_counter, int8_t rssi_in_dbm, int8_t snr_in_db )
+{
+    sweep.is_synchronised = true;
+    sweep.nb_ok++;
+    sweep.rssi_sum += rssi_in_dbm;
+    sweep.snr_sum += snr_in_db;
+    sweep.rssi_min = MIN( sweep.rssi_min, rssi_in_dbm );
+    sweep.rssi_max = MAX( sweep.rssi_max, rssi_in_dbm );
+    sweep.snr_min  = MIN( sweep.snr_min, snr_in_db );
+    sweep.snr_max  = MAX( sweep.snr_max, snr_in_db );
+
+    if( frame_counter + 1 >= ATC_M_NB_FRAME )
+    {
+        sweep.is_point_done = true;
+        return;
+    }
+
+    // The transmitter sends the remaining frames back to back: track the expected end of the point
+    sweep.deadline_in_ms = per_sweep_get_time_in_ms( ) +
+                           ( uint32_t ) ( ATC_M_NB_FRAME - 1 - frame_counter ) * sweep.frame_period_in_ms +
+                           SWEEP_FRAME_MARGIN_IN_MS;
+
+    per_sweep_restart_rx( );
+}
+
+static void per_sweep_on_rx_failure( uint16_t* failure_counter )
+{
+    if( sweep.is_synchronised == true )
+    {
+        ( *failure_counter )++;
+    }
+
+    per_sweep_restart_rx( );
+}
+
+static void per_sweep_restart_rx( void )
+{
+    if( ( int32_t ) ( per_sweep_get_time_in_ms( ) - sweep.deadline_in_ms ) >= 0 )
+    {
+        sweep.is_point_done = true;
+        return;
+    }
+
+    apps_radio_set_rx( &radio, sweep.frame_period_in_ms + SWEEP_FRAME_MARGIN_IN_MS );
+}
+
+static void per_fast_run( void )
+{
+    memset( &per_fast, 0, sizeof( per_fast ) );
+    per_fast.rssi_min = INT8_MAX;
+    per_fast.rssi_max = INT8_MIN;
+    per_fast.snr_min  = INT8_MAX;
+    per_fast.snr_max  = INT8_MIN;
+
+    apps_radio_set_irq_mask( &radio, PER_FAST_IRQ_MASK );
+
+    HAL_DBG_TRACE_INFO( "Saturating-throughput PER test: %d frames, time on air %u ms, summary at the end only\n",
+                        ATC_M_NB_FRAME, ( unsigned int ) get_time_on_air_in_ms( ) );
+
+    if( ATC_M_NB_FRAME <= 0 )
+    {
+        return;
+    }
+
+    sweep_clock.last_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+
+    if( ATC_M_TXRX_SWITCH == 1 )
+    {
+        rx_timeout = RX_TIMEOUT_VALUE + get_time_on_air_in_ms( );
+        smtc_hal_mcu_timer_soft_init( &per_fast_idle_timer, per_fast_on_idle_timeout, NULL );
+        apps_radio_set_rx_continuous( &radio );
+    }
+    else
+    {
+        for( int i = PER_FAST_SEQ_LENGTH; i < PAYLOAD_LENGTH; i++ )
+        {
+            buffer[i] = ( uint8_t ) i;
+        }
+        // The whole payload is written once, only the sequence number changes afterwards
+        apps_radio_write_payload( &radio, buffer, PAYLOAD_LENGTH );
+
+        per_fast.start_in_ms = per_sweep_get_time_in_ms( );
+        per_fast_send_frame( );
+    }
+
+    while( per_fast.is_done == false )
+    {
+        apps_radio_irq_process_quiet( &radio, PER_FAST_IRQ_MASK, per_on_radio_irq );
+
+        if( per_fast.is_done == false )
+        {
+            apps_radio_wait_for_event( &radio );
+        }
+    }
+
+    smtc_hal_mcu_timer_soft_stop( &per_fast_idle_timer );
+    apps_radio_set_standby( &radio, APPS_RADIO_STANDBY_CFG_RC );
+
+    per_fast_print_summary( );
+    apps_radio_print_irq_stats( &radio );
+    uart_print_lpm_stats( );
+}
+
+static void per_fast_on_tx_done( void )
+{
+    per_fast.nb_sent++;
+    // Sampled on every frame so that the millisecond clock sees each wrap of the microsecond time base
+    per_fast.end_in_ms = per_sweep_get_time_in_ms( );
+    if( per_fast.nb_sent >= ( uint32_t ) ATC_M_NB_FRAME )
+    {
+        per_fast.is_done = true;
+        return;
+    }
+
+    per_fast.seq++;
+    per_fast_send_frame( );
+}
+
+static void per_fast_send_frame( void )
+{
+    const uint8_t seq[PER_FAST_SEQ_LENGTH] = {
+        ( uint8_t ) per_fast.seq,
+        ( uint8_t ) ( per_fast.seq >> 8 ),
+        ( uint8_t ) ( per_fast.seq >> 16 ),
+        ( uint8_t ) ( per_fast.seq >> 24 ),
+    };
+
+    apps_radio_write_payload( &radio, seq, PER_FAST_SEQ_LENGTH );
+    apps_radio_set_tx( &radio, 0 );
+}
+
+static void per_fast_on_rx_done( void )
+{
+    uint8_t seq_bytes[PER_FAST_SEQ_LENGTH];
+    int8_t  rssi_in_dbm;
+    int8_t  snr_in_db = 0;
+
+    // The radio is still listening: only the sequence number and the packet status are read back
+    if( apps_radio_read_payload_head( &radio, seq_bytes, PER_FAST_SEQ_LENGTH ) < PER_FAST_SEQ_LENGTH )
+    {
+        per_fast.nb_length_error++;
+        return;
+    }
+
+    if( apps_radio_is_lora_pkt_type( &radio ) == true )
+    {
+        apps_radio_lora_pkt_status_t pkt_status;
+
+        apps_radio_get_lora_pkt_status( &radio, &pkt_status );
+        rssi_in_dbm = pkt_status.rssi_pkt_in_dbm;
+        snr_in_db   = pkt_status.snr_pkt_in_db;
+    }
+    else
+    {
+        apps_radio_gfsk_pkt_status_t pkt_status;
+
+        apps_radio_get_gfsk_pkt_status( &radio, &pkt_status );
+        rssi_in_dbm = pkt_status.rssi_avg_in_dbm;
+    }
+
+    const uint32_t seq = ( uint32_t ) seq_bytes[0] | ( ( uint32_t ) seq_bytes[1] << 8 ) |
+                         ( ( uint32_t ) seq_bytes[2] << 16 ) | ( ( uint32_t ) seq_bytes[3] << 24 );
+
+    if( per_fast.is_synchronised == false )
+    {
+        per_fast.is_synchronised = true;
+        per_fast.first_seq       = seq;
+        per_fast.seq             = seq;
+        per_fast.start_in_ms     = per_sweep_get_time_in_ms( );
+    }
+    else if( ( int32_t ) ( seq - per_fast.seq ) <= 0 )
+    {
+        per_fast.nb_duplicates++;
+        return;
+    }
+
+    per_fast.seq = seq;
+    per_fast.nb_ok++;
+    per_fast.end_in_ms = per_sweep_get_time_in_ms( );
+    per_fast_record_pkt_status( rssi_in_dbm, snr_in_db );
+
+    if( ( seq + 1 ) >= ( uint32_t ) ATC_M_NB_FRAME )
+    {
+        per_fast.is_done = true;
+        return;
+    }
+
+    smtc_hal_mcu_timer_soft_start( &per_fast_idle_timer, rx_timeout * 1000, 0 );
+}
+
+static void per_fast_on_rx_failure( uint32_t* failure_counter )
+{
+    // The continuous reception goes on by itself
+    if( per_fast.is_synchronised == true )
+    {
+        ( *failure_counter )++;
+    }
+}
+
+static void per_fast_record_pkt_status( int8_t rssi_in_dbm, int8_t snr_in_db )
+{
+    int rssi_bin = ( rssi_in_dbm - PER_FAST_RSSI_HISTOGRAM_MIN_IN_DBM ) / PER_FAST_RSSI_HISTOGRAM_BIN_IN_DB;
+    int snr_bin  = ( snr_in_db - PER_FAST_SNR_HISTOGRAM_MIN_IN_DB ) / PER_FAST_SNR_HISTOGRAM_BIN_IN_DB;
+
+    rssi_bin = MIN( MAX( rssi_bin, 0 ), PER_FAST_HISTOGRAM_NB_BINS - 1 );
+    snr_bin  = MIN( MAX( snr_bin, 0 ), PER_FAST_HISTOGRAM_NB_BINS - 1 );
+
+    per_fast.rssi_histogram[rssi_bin]++;
+    per_fast.snr_histogram[snr_bin]++;
+    per_fast.rssi_sum += rssi_in_dbm;
+    per_fast.snr_sum += snr_in_db;
+    per_fast.rssi_min = MIN( per_fast.rssi_min, rssi_in_dbm );
+    per_fast.rssi_max = MAX( per_fast.rssi_max, rssi_in_dbm );
+    per_fast.snr_min  = MIN( per_fast.snr_min, snr_in_db );
+    per_fast.snr_max  = MAX( per_fast.snr_max, snr_in_db );
+}
+
+static void per_fast_on_idle_timeout( void* timer_context )
+{
+    HAL_DBG_TRACE_WARNING( "No frame for %u ms, ending the test\n", ( unsigned int ) rx_timeout );
+    per_fast.is_done = true;
+}
+
+static void per_fast_print_summary( void )
+{
+    const uint32_t duration_in_ms = MAX( per_fast.end_in_ms - per_fast.start_in_ms, 1 );
+
+    if( ATC_M_TXRX_SWITCH != 1 )
+    {
+        // Time on air over the actual frame period: how close to radio-limited the transmitter ran
+        HAL_DBG_TRACE_PRINTF( "PERFAST,tx,sent=%u,duration_ms=%u,frames_per_s=%u.%02u,airtime_pct=%u\n",
+                              ( unsigned int ) per_fast.nb_sent, ( unsigned int ) duration_in_ms,
+                              ( unsigned int ) ( ( uint64_t ) per_fast.nb_sent * 1000 / duration_in_ms ),
+                              ( unsigned int ) ( ( ( uint64_t ) per_fast.nb_sent * 100000 / duration_in_ms ) % 100 ),
+                              ( unsigned int ) ( ( uint64_t ) per_fast.nb_sent * get_time_on_air_in_ms( ) * 100 /
+                                                 duration_in_ms ) );
+        return;
+    }
+
+    // Frames are numbered from 0 by the transmitter: the ones before the first received and after the last received
+    // ones are lost too
+    const uint32_t nb_expected = MAX( ( uint32_t ) ATC_M_NB_FRAME, per_fast.seq + 1 );
+    const uint32_t nb_lost     = nb_expected - per_fast.nb_ok;
+    const uint32_t per_in_bp   = ( uint32_t ) ( ( uint64_t ) nb_lost * 10000 / nb_expected );
+    const int32_t  n           = MAX( per_fast.nb_ok, 1 );
+
+    if( per_fast.nb_ok == 0 )
+    {
+        per_fast.rssi_min = 0;
+        per_fast.rssi_max = 0;
+        per_fast.snr_min  = 0;
+        per_fast.snr_max  = 0;
+    }
+
+    HAL_DBG_TRACE_PRINTF( "PERFAST,rx,expected=%u,ok=%u,lost=%u,per_pct=%u.%02u,first_seq=%u,last_seq=%u\n",
+                          ( unsigned int ) nb_expected, ( unsigned int ) per_fast.nb_ok, ( unsigned int ) nb_lost,
+                          ( unsigned int ) ( per_in_bp / 100 ), ( unsigned int ) ( per_in_bp % 100 ),
+                          ( unsigned int ) per_fast.first_seq, ( unsigned int ) per_fast.seq );
+    HAL_DBG_TRACE_PRINTF( "PERFAST,errors,crc=%u,header=%u,length=%u,duplicates=%u\n",
+                          ( unsigned int ) per_fast.nb_crc_error, ( unsigned int ) per_fast.nb_header_error,
+                          ( unsigned int ) per_fast.nb_length_error, ( unsigned int ) per_fast.nb_duplicates );
+    HAL_DBG_TRACE_PRINTF( "PERFAST,rssi,min=%d,avg=%d,max=%d,snr,min=%d,avg=%d,max=%d,duration_ms=%u\n",
+                          per_fast.rssi_min, ( int ) ( per_fast.rssi_sum / n ), per_fast.rssi_max, per_fast.snr_min,
+                          ( int ) ( per_fast.snr_sum / n ), per_fast.snr_max, ( unsigned int ) duration_in_ms );
+    per_fast_print_histogram( "rssi_dbm", per_fast.rssi_histogram, PER_FAST_RSSI_HISTOGRAM_MIN_IN_DBM,
+                              PER_FAST_RSSI_HISTOGRAM_BIN_IN_DB );
+    if( apps_radio_is_lora_pkt_type( &radio ) == true )
+    {
+        per_fast_print_histogram( "snr_db", per_fast.snr_histogram, PER_FAST_SNR_HISTOGRAM_MIN_IN_DB,
+                                  PER_FAST_SNR_HISTOGRAM_BIN_IN_DB );
+    }
+}
+
+static void per_fast_print_histogram( const char* name, const uint32_t* histogram, int min, int bin_width )
+{
+    HAL_DBG_TRACE_PRINTF( "PERFAST,histogram,%s", name );
+    for( int i = 0; i < PER_FAST_HISTOGRAM_NB_BINS; i++ )
+    {
+        if( histogram[i] != 0 )
+        {
+            HAL_DBG_TRACE_PRINTF( ",%d:%u", min + i * bin_width, ( unsigned int ) histogram[i] );
+        }
+    }
+    HAL_DBG_TRACE_PRINTF( "\n" );
+}
+
+static uint32_t per_sweep_get_time_in_ms( void )
+{
+    const uint32_t now_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+
+    sweep_clock.remaining_in_us += now_in_us - sweep_clock.last_in_us;
+    sweep_clock.last_in_us = now_in_us;
+
+    sweep_clock.time_in_ms += sweep_clock.remaining_in_us / 1000;
+    sweep_clock.remaining_in_us %= 1000;
+
+    return sweep_clock.time_in_ms;
+}
@@ -0,0 +1,703 @@
+/*!
+ * @file      main_ping_pong.c
+ *
+ * @brief     Ping-pong example for LR11xx and SX126x chips
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2022. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "apps_common.h"
+#include "apps_radio.h"
+#include "main_ping_pong.h"
+#include "smtc_hal_dbg_trace.h"
+#include "uart_init.h"
+#include "apps_entropy.h"
+#include "atc.h"
+#include "smtc_link_stats.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/**
+ * @brief Size of ping-pong message prefix
+ *
+ * Expressed in bytes
+ */
+#define PING_PONG_PREFIX_SIZE 4
+
+/**
+ * @brief Threshold:number of exchanges before informing user on UART that the board pair is still not synchronized
+ *
+ * Expressed in number of packet exchanged
+ */
+#define SYNC_PACKET_THRESHOLD 64
+
+/**
+ * @brief Number of exchanges are stored in the payload of the packet exchanged during this PING-PONG communication
+ *        this constant indicates where in the packet the two bytes used to count are located
+ *
+ * Expressed in bytes
+ */
+
+#define ITERATION_INDEX ( PING_PONG_PREFIX_SIZE + 1 )
+
+/**
+ * @brief Duration of the wait before packet transmission to assure reception status is ready on the other side
+ *
+ * Expressed in milliseconds
+ */
+#define DELAY_BEFORE_TX_MS 20
+
+/**
+ * @brief Duration of the wait between each ping-pong activity, can be used to adjust ping-pong speed
+ *
+ * Expressed in milliseconds
+ */
+#define DELAY_PING_PONG_PACE_MS 200
+
+/**
+ * @brief Interrupt mask used by the application
+ */
+#define IRQ_MASK                                                                                                 \
+    ( APPS_RADIO_IRQ_TX_DONE | APPS_RADIO_IRQ_RX_DONE | APPS_RADIO_IRQ_TIMEOUT | APPS_RADIO_IRQ_HEADER_ERROR | \
+      APPS_RADIO_IRQ_CRC_ERROR | APPS_RADIO_IRQ_LENGTH_ERROR )
+
+/**
+ * @brief Benchmark frame header: type, flags, little-endian sequence number and, in answers, the reception bitmap
+ */
+#define PING_PONG_BENCH_HEADER_LENGTH 7
+#define PING_PONG_BENCH_REQUEST 'Q'
+#define PING_PONG_BENCH_ANSWER 'A'
+#define PING_PONG_BENCH_FLAG_LAST_OF_WINDOW 0x01
+
+/**
+ * @brief Unit of the round-trip times given to the quantile estimator, which is limited to 20-bit values
+ */
+#define PING_PONG_BENCH_RTT_UNIT_IN_US 10
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static apps_radio_t radio;
+
+static uint8_t buffer_tx[PAYLOAD_LENGTH];
+static bool    is_master = true;
+
+static const uint8_t ping_msg[PING_PONG_PREFIX_SIZE] = "PING";
+static const uint8_t pong_msg[PING_PONG_PREFIX_SIZE] = "PONG";
+
+static uint8_t  iteration       = 0;
+static uint16_t packets_to_sync = 0;
+
+static smtc_hal_mcu_timer_soft_t rx_start_timer;
+static smtc_hal_mcu_timer_soft_t tx_start_timer;
+
+/**
+ * @brief State of the round-trip time benchmark (AT+PPBENCH)
+ *
+ * The initiator sends a window of requests back to back, the last one flagged, and the responder answers it at once
+ * with the highest sequence number received and a bitmap of the ones before. The round-trip time of a request runs from
+ * its end on air to the end of the answer on air.
+ */
+static struct
+{
+    bool                     is_done;
+    uint8_t                  window;
+    uint32_t                 seq;           //!< Initiator: next request - responder: highest request received
+    uint32_t                 window_start;  //!< Initiator: first request of the window in flight
+    uint8_t                  bitmap;        //!< Responder: bit i set if request seq - i has been received
+    uint32_t                 tx_end_of_packet_in_us[ATC_PING_PONG_WINDOW_MAX];
+    uint32_t                 nb_sent;   //!< Initiator: requests - responder: answers
+    uint32_t                 nb_acked;  //!< Initiator: requests answered - responder: requests received
+    uint32_t                 nb_timeouts;
+    uint32_t                 nb_rx_errors;
+    uint32_t                 last_in_us;
+    uint64_t                 elapsed_in_us;  //!< Initiator: time spent since the first request, wrap-safe
+    smtc_link_stats_metric_t rtt;            //!< In PING_PONG_BENCH_RTT_UNIT_IN_US
+} bench;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Dispatch the interrupts of the radio
+ *
+ * @param [in] radio_irq Radio that raised the interrupts
+ * @param [in] irq Interrupts raised
+ */
+static void ping_pong_on_radio_irq( const apps_radio_t* radio_irq, apps_radio_irq_mask_t irq );
+
+/**
+ * @brief Handle a packet received without error
+ */
+static void ping_pong_on_rx_done( void );
+
+/**
+ * @brief Handle reception failure for ping-pong example
+ */
+static void ping_pong_reception_failure_handling( void );
+
+/**
+ * @brief Start the reception once the pace delay following a transmission has elapsed
+ *
+ * @param [in] timer_context Unused
+ */
+static void ping_pong_start_rx( void* timer_context );
+
+/**
+ * @brief Start the transmission once the pace delay following a reception has elapsed
+ *
+ * @param [in] timer_context Unused
+ */
+static void ping_pong_start_tx( void* timer_context );
+
+/**
+ * @brief Run the round-trip time benchmark: requests and answers are sent as soon as possible, without traces
+ *
+ * @remark Never returns
+ */
+static void ping_pong_bench_run( void );
+
+/**
+ * @brief Dispatch the interrupts of the radio during the benchmark
+ *
+ * @param [in] radio_irq Radio that raised the interrupts
+ * @param [in] irq Interrupts raised
+ */
+static void ping_pong_bench_on_radio_irq( const apps_radio_t* radio_irq, apps_radio_irq_mask_t irq );
+
+/**
+ * @brief Write the header of a benchmark frame and start its transmission - the rest of the payload is pre-staged
+ *
+ * @param [in] type PING_PONG_BENCH_REQUEST or PING_PONG_BENCH_ANSWER
+ * @param [in] flags Frame flags
+ * @param [in] seq Sequence number
+ * @param [in] bitmap Reception bitmap, answers only
+ */
+static void ping_pong_bench_send( uint8_t type, uint8_t flags, uint32_t seq, uint8_t bitmap );
+
+/**
+ * @brief Initiator: send the first request of the next window, or end the benchmark
+ */
+static void ping_pong_bench_start_window( void );
+
+/**
+ * @brief Initiator: account for the answer to the window in flight
+ *
+ * @param [in] header Header of the answer
+ */
+static void ping_pong_bench_on_answer( const uint8_t* header );
+
+/**
+ * @brief Responder: record a request, and answer it if it closes a window
+ *
+ * @param [in] header Header of the request
+ */
+static void ping_pong_bench_on_request( const uint8_t* header );
+
+/**
+ * @brief Get the sequence number of a benchmark frame
+ *
+ * @param [in] header Frame header
+ *
+ * @returns Sequence number
+ */
+static uint32_t ping_pong_bench_get_seq( const uint8_t* header );
+
+/**
+ * @brief Print the benchmark summary
+ */
+static void ping_pong_bench_print_summary( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+/**
+ * @brief Main application entry point.
+ */
+int main( void )
+{
+    const radio_registry_binding_t binding = RADIO_REGISTRY_BINDING_ARDUINO;
+
+    smtc_hal_mcu_init( );
+    apps_common_shield_init( );
+    uart_init( );
+
+    HAL_DBG_TRACE_INFO( "===== " APPS_RADIO_CHIP_NAME " Ping-Pong example =====\n\n" );
+    apps_radio_open( &radio, APPS_RADIO_CHIP_OPS, 0, &binding );
+    apps_radio_print_version( &radio );
+
+    // Radio parameters can be changed with AT commands until AT+START
+    main_loop( );
+
+    apps_radio_init( &radio );
+    apps_radio_print_call_benchmark( &radio );
+    apps_radio_set_irq_mask( &radio, IRQ_MASK );
+
+    if( ATC_M_PING_PONG_WINDOW > 0 )
+    {
+        ping_pong_bench_run( );
+    }
+
+    smtc_hal_mcu_timer_soft_init( &rx_start_timer, ping_pong_start_rx, NULL );
+    smtc_hal_mcu_timer_soft_init( &tx_start_timer, ping_pong_start_tx, NULL );
+
+    memcpy( buffer_tx, ping_msg, PING_PONG_PREFIX_SIZE );
+    buffer_tx[PING_PONG_PREFIX_SIZE] = ( uint8_t ) 0;
+    buffer_tx[ITERATION_INDEX]       = ( uint8_t ) ( iteration );
+    for( int i = PING_PONG_PREFIX_SIZE + 1 + 1; i < PAYLOAD_LENGTH; i++ )
+    {
+        buffer_tx[i] = i;
+    }
+
+    apps_radio_write_payload( &radio, buffer_tx, PAYLOAD_LENGTH );
+    apps_radio_set_tx( &radio, 0 );
+
+    while( 1 )
+    {
+        apps_radio_irq_process( &radio, IRQ_MASK, ping_pong_on_radio_irq );
+        apps_radio_wait_for_event( &radio );
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void ping_pong_on_radio_irq( const apps_radio_t* radio_irq, apps_radio_irq_mask_t irq )
+{
+    if( ( irq & APPS_RADIO_IRQ_TX_DONE ) != 0 )
+    {
+        HAL_DBG_TRACE_INFO( "Sent message %s, iteration %d\n", buffer_tx, iteration );
+
+        smtc_hal_mcu_timer_soft_start( &rx_start_timer, DELAY_PING_PONG_PACE_MS * 1000, 0 );
+    }
+    else if( ( irq & ( APPS_RADIO_IRQ_CRC_ERROR | APPS_RADIO_IRQ_LENGTH_ERROR | APPS_RADIO_IRQ_HEADER_ERROR ) ) != 0 )
+    {
+        ping_pong_reception_failure_handling( );
+    }
+    else if( ( irq & APPS_RADIO_IRQ_RX_DONE ) != 0 )
+    {
+        ping_pong_on_rx_done( );
+    }
+    else if( ( irq & APPS_RADIO_IRQ_TIMEOUT ) != 0 )
+    {
+        packets_to_sync++;
+        if( packets_to_sync > SYNC_PACKET_THRESHOLD )
+        {
+            HAL_DBG_TRACE_WARNING(
+                "It looks like synchronisation is still not done, consider resetting one of the board\n" );
+        }
+        ping_pong_reception_failure_handling( );
+    }
+}
+
+static void ping_pong_on_rx_done( void )
+{
+    uint8_t                      buffer_rx[PAYLOAD_LENGTH];
+    apps_radio_lora_pkt_status_t pkt_status;
+
+    packets_to_sync = 0;
+
+    const uint8_t size = apps_radio_read_payload( &radio, buffer_rx, PAYLOAD_LENGTH );
+    if( size <= ITERATION_INDEX )
+    {
+        ping_pong_reception_failure_handling( );
+        return;
+    }
+
+    if( apps_radio_get_lora_pkt_status( &radio, &pkt_status ) == true )
+    {
+        HAL_DBG_TRACE_INFO( "Packet status: RSSI %i dBm, signal RSSI %i dBm, SNR %i dB\n", pkt_status.rssi_pkt_in_dbm,
+                            pkt_status.signal_rssi_pkt_in_dbm, pkt_status.snr_pkt_in_db );
+    }
+
+    iteration = buffer_rx[ITERATION_INDEX];
+
+    iteration++;
+    HAL_DBG_TRACE_INFO( "Received message %s, iteration %d\n", buffer_rx, iteration );
+
+    if( is_master == true )
+    {
+        if( memcmp( buffer_rx, ping_msg, PING_PONG_PREFIX_SIZE ) == 0 )
+        {
+            is_master = false;
+            memcpy( buffer_tx, pong_msg, PING_PONG_PREFIX_SIZE );
+        }
+        else if( memcmp( buffer_rx, pong_msg, PING_PONG_PREFIX_SIZE ) != 0 )
+        {
+            HAL_DBG_TRACE_ERROR( "Unexpected message\n" );
+        }
+    }
+    else
+    {
+        if( memcmp( buffer_rx, ping_msg, PING_PONG_PREFIX_SIZE ) != 0 )
+        {
+            HAL_DBG_TRACE_ERROR( "Unexpected message\n" );
+
+            is_master = true;
+            memcpy( buffer_tx, ping_msg, PING_PONG_PREFIX_SIZE );
+        }
+    }
+
+    smtc_hal_mcu_timer_soft_start( &tx_start_timer, ( DELAY_PING_PONG_PACE_MS + DELAY_BEFORE_TX_MS ) * 1000, 0 );
+}
+
+static void ping_pong_reception_failure_handling( void )
+{
+    is_master = true;
+    iteration = 0;
+    memcpy( buffer_tx, ping_msg, PING_PONG_PREFIX_SIZE );
+    buffer_tx[ITERATION_INDEX] = iteration;
+
+    apps_radio_write_payload( &radio, buffer_tx, PAYLOAD_LENGTH );
+    apps_radio_set_tx( &radio, 0 );
+}
+
+static void ping_pong_start_rx( void* timer_context )
+{
+    // Random delay to avoid unwanted synchronization: drawn from the entropy pool so that two boards running the same
+    // firmware do not follow the same sequence
+    apps_radio_set_rx( &radio, get_time_on_air_in_ms( ) + RX_TIMEOUT_VALUE + apps_entropy_get_range( 500 ) );
+}
+
+static void ping_pong_start_tx( void* timer_context )
+{
+    buffer_tx[ITERATION_INDEX] = iteration;
+
+    apps_radio_write_payload( &radio, buffer_tx, PAYLOAD_LENGTH );
+    apps_radio_set_tx( &radio, 0 );
+}
+
+static void ping_pong_bench_run( void )
+{
+    if( PAYLOAD_LENGTH < PING_PONG_BENCH_HEADER_LENGTH )
+    {
+        HAL_DBG_TRACE_ERROR( "The benchmark needs a payload of at least %d bytes\n", PING_PONG_BENCH_HEADER_LENGTH );
+        while( 1 )
+        {
+            apps_radio_wait_for_event( &radio );
+        }
+    }
+
+    memset( &bench, 0, sizeof( bench ) );
+    bench.window = ( uint8_t ) ATC_M_PING_PONG_WINDOW;
+
+    // The payload is written once, frames only rewrite their header
+    for( int i = 0; i < PAYLOAD_LENGTH; i++ )
+    {
+        buffer_tx[i] = ( uint8_t ) i;
+    }
+    apps_radio_write_payload( &radio, buffer_tx, PAYLOAD_LENGTH );
+
+    if( ATC_M_TXRX_SWITCH == 1 )
+    {
+        HAL_DBG_TRACE_INFO( "Round-trip time benchmark: responder\n" );
+        apps_radio_set_rx( &radio, 0 );
+    }
+    else
+    {
+        // The histogram spans twice the round-trip time of a full window without turnaround
+        const uint32_t rtt_in_units =
+            ( bench.window + 1u ) * get_time_on_air_in_ms( ) * ( 1000 / PING_PONG_BENCH_RTT_UNIT_IN_US );
+
+        smtc_link_stats_metric_init( &bench.rtt, 0,
+                                     ( int32_t ) ( ( 2 * rtt_in_units ) / SMTC_LINK_STATS_HISTOGRAM_NB_BINS + 1 ) );
+
+        HAL_DBG_TRACE_INFO( "Round-trip time benchmark: initiator, %d frames, window of %d, time on air %u ms\n",
+                            ATC_M_NB_FRAME, bench.window, ( unsigned int ) get_time_on_air_in_ms( ) );
+        bench.last_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+        ping_pong_bench_start_window( );
+    }
+
+    while( 1 )
+    {
+        apps_radio_irq_process_quiet( &radio, IRQ_MASK, ping_pong_bench_on_radio_irq );
+        apps_radio_wait_for_event( &radio );
+    }
+}
+
+static void ping_pong_bench_on_radio_irq( const apps_radio_t* radio_irq, apps_radio_irq_mask_t irq )
+{
+    uint8_t buffer_rx[PAYLOAD_LENGTH];
+
+    if( ( irq & APPS_RADIO_IRQ_TX_DONE ) != 0 )
+    {
+        if( ATC_M_TXRX_SWITCH == 1 )
+        {
+            apps_radio_set_rx( &radio, 0 );
+            return;
+        }
+
+        bench.tx_end_of_packet_in_us[bench.seq % ATC_PING_PONG_WINDOW_MAX] =
+            apps_radio_get_tx_end_of_packet_in_us( &radio );
+        bench.nb_sent++;
+        bench.seq++;
+
+        // Re-armed straight from TX_DONE until the window is full, then wait for the answer
+        if( ( bench.seq - bench.window_start ) < bench.window )
+        {
+            const uint8_t flags = ( ( bench.seq - bench.window_start + 1 ) == bench.window )
+                                      ? PING_PONG_BENCH_FLAG_LAST_OF_WINDOW
+                                      : 0;
+
+            ping_pong_bench_send( PING_PONG_BENCH_REQUEST, flags, bench.seq, 0 );
+        }
+        else
+        {
+            apps_radio_set_rx( &radio, get_time_on_air_in_ms( ) + RX_TIMEOUT_VALUE );
+        }
+    }
+    else if( ( irq & APPS_RADIO_IRQ_RX_DONE ) != 0 &&
+             ( irq & ( APPS_RADIO_IRQ_CRC_ERROR | APPS_RADIO_IRQ_LENGTH_ERROR | APPS_RADIO_IRQ_HEADER_ERROR ) ) == 0 )
+    {
+        const uint8_t size = apps_radio_read_payload( &radio, buffer_rx, PAYLOAD_LENGTH );
+
+        if( ( size >= PING_PONG_BENCH_HEADER_LENGTH ) && ( buffer_rx[0] == PING_PONG_BENCH_ANSWER ) &&
+            ( ATC_M_TXRX_SWITCH != 1 ) )
+        {
+            ping_pong_bench_on_answer( buffer_rx );
+        }
+        else if( ( size >= PING_PONG_BENCH_HEADER_LENGTH ) && ( buffer_rx[0] == PING_PONG_BENCH_REQUEST ) &&
+                 ( ATC_M_TXRX_SWITCH == 1 ) )
+        {
+            ping_pong_bench_on_request( buffer_rx );
+        }
+        else
+        {
+            bench.nb_rx_errors++;
+            if( ATC_M_TXRX_SWITCH == 1 )
+            {
+                apps_radio_set_rx( &radio, 0 );
+            }
+            else
+            {
+                ping_pong_bench_start_window( );
+            }
+        }
+    }
+    else
+    {
+        // Timeout or corrupted frame: the responder listens again, the initiator gives the window up
+        if( ( irq & APPS_RADIO_IRQ_TIMEOUT ) != 0 )
+        {
+            bench.nb_timeouts++;
+        }
+        else
+        {
+            bench.nb_rx_errors++;
+        }
+
+        if( ATC_M_TXRX_SWITCH == 1 )
+        {
+            apps_radio_set_rx( &radio, 0 );
+        }
+        else
+        {
+            ping_pong_bench_start_window( );
+        }
+    }
+}
+
+static void ping_pong_bench_send( uint8_t type, uint8_t flags, uint32_t seq, uint8_t bitmap )
+{
+    const uint8_t header[PING_PONG_BENCH_HEADER_LENGTH] = {
+        type, flags, ( uint8_t ) seq, ( uint8_t ) ( seq >> 8 ), ( uint8_t ) ( seq >> 16 ), ( uint8_t ) ( seq >> 24 ),
+        bitmap,
+    };
+
+    apps_radio_write_payload( &radio, header, PING_PONG_BENCH_HEADER_LENGTH );
+    apps_radio_set_tx( &radio, 0 );
+}
+
+static void ping_pong_bench_start_window( void )
+{
+    const uint32_t now_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+
+    bench.elapsed_in_us += now_in_us - bench.last_in_us;
+    bench.last_in_us = now_in_us;
+
+    if( bench.is_done == true )
+    {
+        return;
+    }
+
+    if( bench.nb_sent >= ( uint32_t ) ATC_M_NB_FRAME )
+    {
+        bench.is_done = true;
+        ping_pong_bench_print_summary( );
+        return;
+    }
+
+    bench.window_start = bench.seq;
+    ping_pong_bench_send( PING_PONG_BENCH_REQUEST, ( bench.window == 1 ) ? PING_PONG_BENCH_FLAG_LAST_OF_WINDOW : 0,
+                          bench.seq, 0 );
+}
+
+static void ping_pong_bench_on_answer( const uint8_t* header )
+{
+    const uint32_t rx_end_of_packet_in_us = apps_radio_get_rx_end_of_packet_in_us( &radio );
+    const uint32_t highest                = ping_pong_bench_get_seq( header );
+    const uint8_t  bitmap                 = header[6];
+
+    for( uint32_t i = 0; i < ATC_PING_PONG_WINDOW_MAX; i++ )
+    {
+        const uint32_t seq = highest - i;
+
+        // Only the requests of the window in flight count, a late answer to an older one is ignored
+        if( ( ( bitmap & ( 1u << i ) ) == 0 ) || ( ( seq - bench.window_start ) >= bench.window ) )
+        {
+            continue;
+        }
+
+        const uint32_t rtt_in_us =
+            rx_end_of_packet_in_us - bench.tx_end_of_packet_in_us[seq % ATC_PING_PONG_WINDOW_MAX];
+
+        smtc_link_stats_metric_add( &bench.rtt, ( int32_t ) ( rtt_in_us / PING_PONG_BENCH_RTT_UNIT_IN_US ) );
+        bench.nb_acked++;
+    }
+
+    ping_pong_bench_start_window( );
+}
+
+static void ping_pong_bench_on_request( const uint8_t* header )
+{
+    const uint32_t seq = ping_pong_bench_get_seq( header );
+    const uint32_t gap = seq - bench.seq;
+
+    if( ( bench.nb_acked == 0 ) || ( ( gap != 0 ) && ( gap < 0x80000000u ) ) )
+    {
+        // Newer request: slide the bitmap
+        bench.bitmap = ( ( bench.nb_acked == 0 ) || ( gap >= 8 ) ) ? 1 : ( uint8_t ) ( ( bench.bitmap << gap ) | 1 );
+        bench.seq    = seq;
+    }
+    else if( ( bench.seq - seq ) < 8 )
+    {
+        bench.bitmap |= ( uint8_t ) ( 1u << ( bench.seq - seq ) );
+    }
+    // Number of requests received
+    bench.nb_acked++;
+
+    if( ( header[1] & PING_PONG_BENCH_FLAG_LAST_OF_WINDOW ) != 0 )
+    {
+        ping_pong_bench_send( PING_PONG_BENCH_ANSWER, 0, bench.seq, bench.bitmap );
+        bench.nb_sent++;
+    }
+    else
+    {
+        apps_radio_set_rx( &radio, 0 );
+    }
+
+    if( ( seq + 1 ) == ( uint32_t ) ATC_M_NB_FRAME )
+    {
+        HAL_DBG_TRACE_PRINTF( "PPBENCH,responder,requests=%u,answers=%u,rx_errors=%u\n",
+                              ( unsigned int ) bench.nb_acked, ( unsigned int ) bench.nb_sent,
+                              ( unsigned int ) bench.nb_rx_errors );
+    }
+}
+
+static uint32_t ping_pong_bench_get_seq( const uint8_t* header )
+{
+    return ( uint32_t ) header[2] | ( ( uint32_t ) header[3] << 8 ) | ( ( uint32_t ) header[4] << 16 ) |
+           ( ( uint32_t ) header[5] << 24 );
+}
+
+static void ping_pong_bench_print_summary( void )
+{
+    const uint32_t duration_in_ms = ( uint32_t ) ( bench.elapsed_in_us / 1000 );
+    const uint64_t acked_per_1000_s =
+        ( duration_in_ms > 0 ) ? ( ( uint64_t ) bench.nb_acked * 1000000 / duration_in_ms ) : 0;
+
+    HAL_DBG_TRACE_PRINTF( "PPBENCH,initiator,window=%u,sent=%u,acked=%u,lost=%u,timeouts=%u,rx_errors=%u,"
+                          "duration_ms=%u,acked_per_s=%u.%03u,time_on_air_ms=%u\n",
+                          bench.window, ( unsigned int ) bench.nb_sent, ( unsigned int ) bench.nb_acked,
+                          ( unsigned int ) ( bench.nb_sent - bench.nb_acked ), ( unsigned int ) bench.nb_timeouts,
+                          ( unsigned int ) bench.nb_rx_errors, ( unsigned int ) duration_in_ms,
+                          ( unsigned int ) ( acked_per_1000_s / 1000 ), ( unsigned int ) ( acked_per_1000_s % 1000 ),
+                          ( unsigned int ) get_time_on_air_in_ms( ) );
+
+    if( bench.rtt.count == 0 )
+    {
+        return;
+    }
+
+    HAL_DBG_TRACE_PRINTF( "PPBENCH,rtt_us,min=%u,avg=%u,max=%u",
+                          ( unsigned int ) bench.rtt.min * PING_PONG_BENCH_RTT_UNIT_IN_US,
+                          ( unsigned int ) ( bench.rtt.sum / bench.rtt.count ) * PING_PONG_BENCH_RTT_UNIT_IN_US,
+                          ( unsigned int ) bench.rtt.max * PING_PONG_BENCH_RTT_UNIT_IN_US );
+    for( unsigned int q = 0; q < SMTC_LINK_STATS_NB_QUANTILES; q++ )
+    {
+        const int64_t quantile = smtc_link_stats_metric_get_quantile( &bench.rtt, q );
+
+        HAL_DBG_TRACE_PRINTF( ",p%u=%u", smtc_link_stats_get_quantile_in_per_mille( q ) / 10,
+                              ( unsigned int ) ( ( quantile * PING_PONG_BENCH_RTT_UNIT_IN_US ) >>
+                                                 SMTC_LINK_STATS_FRACTIONAL_BITS ) );
+    }
+    HAL_DBG_TRACE_PRINTF( "\n" );
+
+    HAL_DBG_TRACE_PRINTF( "PPBENCH,histogram,rtt_us" );
+    for( int bin = 0; bin < SMTC_LINK_STATS_HISTOGRAM_NB_BINS; bin++ )
+    {
+        if( bench.rtt.histogram[bin] != 0 )
+        {
+            HAL_DBG_TRACE_PRINTF( ",%u:%u",
+                                  ( unsigned int ) ( bin * bench.rtt.bin_width * PING_PONG_BENCH_RTT_UNIT_IN_US ),
+                                  ( unsigned int ) bench.rtt.histogram[bin] );
+        }
+    }
+    HAL_DBG_TRACE_PRINTF( "\n" );
+}
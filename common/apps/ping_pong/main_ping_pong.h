@@ -1,7 +1,7 @@
 /*!
  * @file      main_ping_pong.h
  *
- * @brief     Ping-pong example for SX126x chip
+ * @brief     Ping-pong example for LR11xx and SX126x chips
  *
  * The Clear BSD License
  * Copyright Semtech Corporation 2022. All rights reserved.
@@ -1,7 +1,7 @@
 /*!
  * @file      main_sigfox.c
  *
- * @brief     Sigfox PHY example for LR11xx chip
+ * @brief     Sigfox PHY example for LR11xx and SX126x chips
  *
  * The Clear BSD License
  * Copyright Semtech Corporation 2023. All rights reserved.
@@ -41,16 +41,12 @@
 #include <string.h>
 
 #include "apps_common.h"
-#include "apps_utilities.h"
-#include "lr11xx_radio.h"
-#include "lr11xx_regmem.h"
-#include "lr11xx_system.h"
 #include "main_sigfox.h"
 #include "smtc_hal_mcu.h"
 #include "smtc_hal_dbg_trace.h"
 #include "uart_init.h"
-#include "smtc_dbpsk.h"
-#include "smtc_shield_lr11xx.h"
+#include "apps_radio.h"
+#include "apps_sigfox_scheduler.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -77,7 +73,9 @@ const uint8_t sample0[] = { 0xaa, 0xaa, 0xa0, 0x8d, 0x01, 0x05, 0x98, 0xba, 0xdc
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-static lr11xx_hal_context_t* context;
+static apps_radio_t radio;
+
+static smtc_hal_mcu_timer_soft_t tx_timer;
 
 /*
  * -----------------------------------------------------------------------------
@@ -86,6 +84,18 @@ static lr11xx_hal_context_t* context;
 
 static void send_frame( void );
 
+/**
+ * @brief Print the scheduler statistics and wait before sending the next frame
+ */
+static void on_frame_done( void );
+
+/**
+ * @brief Send the next frame once the delay following the last transmission of a frame has elapsed
+ *
+ * @param [in] timer_context Unused
+ */
+static void on_tx_delay_elapsed( void* timer_context );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -96,48 +106,62 @@ static void send_frame( void );
  */
 int main( void )
 {
+    const radio_registry_binding_t binding = RADIO_REGISTRY_BINDING_ARDUINO;
+
     smtc_hal_mcu_init( );
     apps_common_shield_init( );
     uart_init( );
 
-    HAL_DBG_TRACE_INFO( "===== LR11xx Sigfox PHY example =====\n\n" );
-    apps_common_print_sdk_driver_version( );
-
-    context = apps_common_lr11xx_get_context( );
-
-    apps_common_lr11xx_system_init( ( void* ) context );
-    apps_common_lr11xx_fetch_and_print_version( ( void* ) context );
-    apps_common_lr11xx_radio_dbpsk_init( ( void* ) context, SIGFOX_PAYLOAD_LENGTH );
+    HAL_DBG_TRACE_INFO( "===== " APPS_RADIO_CHIP_NAME " Sigfox PHY example =====\n\n" );
+    apps_radio_open( &radio, APPS_RADIO_CHIP_OPS, 0, &binding );
+    apps_radio_print_version( &radio );
+
+    apps_radio_init_dbpsk( &radio, SIGFOX_PAYLOAD_LENGTH );
+    apps_radio_set_irq_mask( &radio, APPS_RADIO_IRQ_TX_DONE );
+
+    // The TX LED is driven by the radio API, so the scheduler hooks are left unset
+    const apps_sigfox_scheduler_cfg_t scheduler_cfg = {
+        .center_freq_in_hz       = SIGFOX_UPLINK_RF_FREQ_IN_HZ,
+        .band_width_in_hz        = SIGFOX_MACRO_CHANNEL_WIDTH_IN_HZ,
+        .guard_in_hz             = SIGFOX_MACRO_CHANNEL_GUARD_IN_HZ,
+        .inter_frame_delay_in_ms = SIGFOX_INTER_FRAME_DELAY_IN_MS,
+        .nb_transmissions        = SIGFOX_NB_TRANSMISSIONS,
+        .on_tx_start             = NULL,
+        .on_tx_done              = NULL,
+    };
+    if( apps_sigfox_scheduler_init( &radio, &scheduler_cfg, on_frame_done ) == false )
+    {
+        HAL_DBG_TRACE_ERROR( "Invalid Sigfox scheduler configuration\n" );
+        while( true )
+        {
+        }
+    }
 
-    ASSERT_LR11XX_RC( lr11xx_system_set_dio_irq_params( context, LR11XX_SYSTEM_IRQ_TX_DONE, 0 ) );
-    ASSERT_LR11XX_RC( lr11xx_system_clear_irq_status( context, LR11XX_SYSTEM_IRQ_ALL_MASK ) );
+    smtc_hal_mcu_timer_soft_init( &tx_timer, on_tx_delay_elapsed, NULL );
 
     send_frame( );
 
     while( 1 )
     {
-        apps_common_lr11xx_irq_process( context, LR11XX_SYSTEM_IRQ_TX_DONE );
+        apps_radio_irq_process( &radio, APPS_SIGFOX_SCHEDULER_IRQ_MASK, apps_sigfox_scheduler_on_radio_irq );
+        apps_radio_wait_for_event( &radio );
     }
 }
 
-void on_tx_done( void )
+static void on_frame_done( void )
 {
-    apps_common_lr11xx_handle_post_tx( );
+    apps_sigfox_scheduler_print_stats( );
 
-    LL_mDelay( TX_TO_TX_DELAY_IN_MS );
+    smtc_hal_mcu_timer_soft_start( &tx_timer, TX_TO_TX_DELAY_IN_MS * 1000, 0 );
+}
 
+static void on_tx_delay_elapsed( void* timer_context )
+{
     send_frame( );
 }
 
 void send_frame( void )
 {
-    uint8_t frame_buffer[smtc_dbpsk_get_pld_len_in_bytes( SIGFOX_PAYLOAD_LENGTH << 3 )];
-
-    smtc_dbpsk_encode_buffer( sample0, SIGFOX_PAYLOAD_LENGTH << 3, frame_buffer );
-
-    lr11xx_regmem_write_buffer8( context, frame_buffer, smtc_dbpsk_get_pld_len_in_bytes( SIGFOX_PAYLOAD_LENGTH << 3 ) );
-
-    apps_common_lr11xx_handle_pre_tx( );
-
-    lr11xx_radio_set_tx( context, 0 );
+    // The frame is encoded and written to the radio buffer only when it changes
+    apps_sigfox_scheduler_send( sample0, SIGFOX_PAYLOAD_LENGTH );
 }
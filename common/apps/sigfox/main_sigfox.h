@@ -1,7 +1,7 @@
 /*!
  * @file      main_sigfox.h
  *
- * @brief     Sigfox PHY example for LR11xx chip
+ * @brief     Sigfox PHY example for LR11xx and SX126x chips
  *
  * The Clear BSD License
  * Copyright Semtech Corporation 2023. All rights reserved.
@@ -50,12 +50,40 @@ extern "C" {
  */
 
 /*!
- *  @brief Delay in ms between the end of a transmission and the beginning of the next one
+ *  @brief Delay in ms between the end of the last transmission of a frame and the beginning of the next frame
  */
 #ifndef TX_TO_TX_DELAY_IN_MS
 #define TX_TO_TX_DELAY_IN_MS 200
 #endif
 
+/*!
+ *  @brief Number of transmissions of each frame: 1, or 3 for the frame and its two repetitions
+ */
+#ifndef SIGFOX_NB_TRANSMISSIONS
+#define SIGFOX_NB_TRANSMISSIONS 3
+#endif
+
+/*!
+ *  @brief Delay in ms between the end of a transmission and the repetition that follows it
+ */
+#ifndef SIGFOX_INTER_FRAME_DELAY_IN_MS
+#define SIGFOX_INTER_FRAME_DELAY_IN_MS 500
+#endif
+
+/*!
+ *  @brief Width in Hz of the macro channel, centered on SIGFOX_UPLINK_RF_FREQ_IN_HZ, the transmissions are spread over
+ */
+#ifndef SIGFOX_MACRO_CHANNEL_WIDTH_IN_HZ
+#define SIGFOX_MACRO_CHANNEL_WIDTH_IN_HZ 192000
+#endif
+
+/*!
+ *  @brief Distance in Hz kept between a transmission and the edges of its slice of the macro channel
+ */
+#ifndef SIGFOX_MACRO_CHANNEL_GUARD_IN_HZ
+#define SIGFOX_MACRO_CHANNEL_GUARD_IN_HZ 1000
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC CONSTANTS --------------------------------------------------------
@@ -0,0 +1,258 @@
+/*!
+ * @file      main_spectral_scan.c
+ *
+ * @brief     Spectral-scan example for LR11xx and SX126x chips
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2022. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "apps_common.h"
+#include "apps_utilities.h"
+#include "apps_radio.h"
+#include "apps_spectral_sweep.h"
+#include "apps_occupancy_recorder.h"
+#include "main_spectral_scan.h"
+#include "smtc_hal_mcu.h"
+#include "smtc_hal_dbg_trace.h"
+#include "uart_init.h"
+#include "atc.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*!
+ * @brief determine RSSI level scales
+ */
+#define RSSI_LEVEL_NUM ( ( RSSI_TOP_LEVEL_DBM - RSSI_BOTTOM_LEVEL_DBM ) / RSSI_SCALE + 1 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/**
+ * @brief Radio seen through the chip-agnostic API by the sweep engine
+ */
+static apps_radio_t radio;
+
+static apps_spectral_sweep_cfg_t sweep_cfg;
+
+static smtc_hal_mcu_timer_soft_t pace_timer;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Start a sweep of all the channels
+ *
+ * @param [in] timer_context Unused
+ */
+static void spectral_scan_start_sweep( void* timer_context );
+
+/**
+ * @brief Output a frame of the sweep engine, and pace the next sweep once the last channel is done
+ *
+ * @param [in] frame Frame
+ * @param [in] length Frame length
+ */
+static void spectral_scan_on_frame( const uint8_t* frame, uint16_t length );
+
+/**
+ * @brief Print the histogram of a channel frame as text
+ *
+ * @param [in] frame Channel frame
+ */
+static void spectral_scan_print_channel( const apps_spectral_sweep_frame_channel_t* frame );
+
+/**
+ * @brief Start the occupancy recorder on the sweep configuration
+ */
+static void spectral_scan_start_recorder( void );
+
+static void print_configuration( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+/**
+ * @brief Main application entry point.
+ */
+int main( void )
+{
+    const radio_registry_binding_t binding = RADIO_REGISTRY_BINDING_ARDUINO;
+
+    smtc_hal_mcu_init( );
+    apps_common_shield_init( );
+    uart_init( );
+
+    HAL_DBG_TRACE_INFO( "===== " APPS_RADIO_CHIP_NAME " Spectral Scan example =====\n\n" );
+    apps_radio_open( &radio, APPS_RADIO_CHIP_OPS, 0, &binding );
+    apps_radio_print_version( &radio );
+
+    // The scan starts at FREQ_START_HZ unless changed with AT+FREQ before AT+START
+    ATC_M_RF_FREQ_IN_HZ = FREQ_START_HZ;
+    main_loop( );
+
+    apps_radio_init( &radio );
+
+    sweep_cfg.freq_start_in_hz    = ATC_M_RF_FREQ_IN_HZ;
+    sweep_cfg.freq_step_in_hz     = WIDTH_CHAN_HZ;
+    sweep_cfg.nb_channels         = NB_CHAN;
+    sweep_cfg.nb_samples          = NB_SCAN;
+    sweep_cfg.sample_period_in_us = SAMPLE_PERIOD_US;
+    sweep_cfg.settle_time_in_us   = SETTLE_TIME_US;
+    sweep_cfg.rssi_top_in_dbm     = RSSI_TOP_LEVEL_DBM;
+    sweep_cfg.rssi_step_in_db     = RSSI_SCALE;
+    sweep_cfg.nb_bins             = RSSI_LEVEL_NUM;
+    if( apps_spectral_sweep_init( &radio, &sweep_cfg, spectral_scan_on_frame ) == false )
+    {
+        HAL_DBG_TRACE_ERROR( "Invalid spectral scan configuration\n" );
+        return 0;
+    }
+
+    print_configuration( );
+    spectral_scan_start_recorder( );
+
+    smtc_hal_mcu_timer_soft_init( &pace_timer, spectral_scan_start_sweep, NULL );
+    spectral_scan_start_sweep( NULL );
+
+    while( 1 )
+    {
+        // AT+OCC is served between two sweep steps
+        uart_process_at_command( );
+        apps_radio_wait_for_event( &radio );
+    }
+}
+
+static void spectral_scan_start_sweep( void* timer_context )
+{
+    // Without pacing, the engine chains the sweeps itself and the radio never leaves reception
+    apps_spectral_sweep_start( ( SWEEP_PACE_MS == 0 ) ? 0 : 1 );
+}
+
+static void spectral_scan_on_frame( const uint8_t* frame, uint16_t length )
+{
+    const apps_spectral_sweep_frame_channel_t* channel_frame = ( const apps_spectral_sweep_frame_channel_t* ) frame;
+
+    if( BINARY_OUTPUT == true )
+    {
+        uart_send_bytes( frame, length );
+    }
+    else if( channel_frame->type == APPS_SPECTRAL_SWEEP_FRAME_CHANNEL )
+    {
+        spectral_scan_print_channel( channel_frame );
+    }
+
+    apps_occupancy_recorder_add_channel( channel_frame );
+
+    if( ( channel_frame->type == APPS_SPECTRAL_SWEEP_FRAME_CHANNEL ) && ( apps_spectral_sweep_is_running( ) == false ) )
+    {
+        // Last channel of a paced sweep: rest in standby until the next one
+        apps_radio_set_standby( &radio, APPS_RADIO_STANDBY_CFG_XOSC );
+        smtc_hal_mcu_timer_soft_start( &pace_timer, SWEEP_PACE_MS * 1000UL, 0 );
+    }
+}
+
+static void spectral_scan_start_recorder( void )
+{
+    const smtc_occupancy_log_plan_t plan = {
+        .freq_start_in_hz   = sweep_cfg.freq_start_in_hz,
+        .freq_step_in_hz    = sweep_cfg.freq_step_in_hz,
+        .nb_channels        = sweep_cfg.nb_channels,
+        .rssi_top_in_dbm    = sweep_cfg.rssi_top_in_dbm,
+        .rssi_step_in_db    = sweep_cfg.rssi_step_in_db,
+        .nb_bins            = sweep_cfg.nb_bins,
+        .level_max          = RECORD_LEVEL_MAX,
+        .record_period_in_s = RECORD_PERIOD_S,
+    };
+
+    if( RECORD_PERIOD_S == 0 )
+    {
+        return;
+    }
+
+    if( apps_occupancy_recorder_init( &plan ) == true )
+    {
+        apps_occupancy_recorder_print_stats( );
+    }
+}
+
+static void spectral_scan_print_channel( const apps_spectral_sweep_frame_channel_t* frame )
+{
+    if( frame->channel_index == 0 )
+    {
+        HAL_DBG_TRACE_PRINTF( "\n" );
+    }
+    HAL_DBG_TRACE_INFO( "%.3f MHz: ", ( frame->freq_in_hz / 1E6 ) );
+    for( uint8_t i = 0; i < sweep_cfg.nb_bins; i++ )
+    {
+        HAL_DBG_TRACE_PRINTF( "%u ", frame->bins[i] );
+    }
+    HAL_DBG_TRACE_PRINTF( "(%u us)\n", frame->scan_time_in_us );
+}
+
+void print_configuration( void )
+{
+    HAL_DBG_TRACE_PRINTF( "\n" );
+    HAL_DBG_TRACE_INFO( "Spectral Scan configuration:\n" );
+    HAL_DBG_TRACE_INFO( "  - Number of scan points in each scan for statistics: %d\n", NB_SCAN );
+    HAL_DBG_TRACE_INFO( "  - Number of channels need to scan: %d\n", NB_CHAN );
+    HAL_DBG_TRACE_INFO( "  - Time between 2 scan points: %d us, after %d us of settling\n", SAMPLE_PERIOD_US,
+                        SETTLE_TIME_US );
+    HAL_DBG_TRACE_INFO( "  - Time delay between 2 sweeps: %d ms\n", SWEEP_PACE_MS );
+    HAL_DBG_TRACE_INFO( "  - Start frequency: %.3f MHz\n", ( ATC_M_RF_FREQ_IN_HZ / 10E5 ) );
+    HAL_DBG_TRACE_INFO( "  - Frequency step of scan channels: %.3f kHz\n", ( WIDTH_CHAN_HZ / 10E2 ) );
+    HAL_DBG_TRACE_INFO( "  - Output: %s\n", ( BINARY_OUTPUT == true ) ? "binary frames" : "text" );
+    HAL_DBG_TRACE_INFO( "  - Occupancy record period: %d s (0: not recorded)\n", RECORD_PERIOD_S );
+    HAL_DBG_TRACE_INFO( "Start Spectral Scan:\n" );
+}
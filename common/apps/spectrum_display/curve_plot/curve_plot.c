@@ -0,0 +1,603 @@
+/*!
+ * @file      curve_plot.c
+ *
+ * @brief     Curve_plot functions used in Spectrum_display example for LR11xx and SX126x chips
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2022. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "curve_plot.h"
+#include "main_spectrum_display.h"
+#include "smtc_hal_dbg_trace.h"
+#include "uart_init.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*!
+ * @brief Curve position offset from home position of the canvas
+ */
+#define COLUMN_OFFSET 5
+#define ROW_OFFSET 1
+#define X_AXIS_WIDTH 2
+
+/*!
+ * @brief Height of the status line reporting the UART cost of the display, below the x-axis
+ */
+#define STATUS_HEIGHT 1
+
+/*!
+ * @brief Number of RSSI levels, i.e. of rows of the plot area
+ */
+#define RSSI_LEVEL_NUM ( ( RSSI_TOP_LEVEL_DBM - RSSI_BOTTOM_LEVEL_DBM ) / RSSI_SCALE + 1 )
+
+/*!
+ * @brief Canvas size, in characters - the width leaves room for the status and legend texts
+ */
+#define CANVAS_TEXT_WIDTH 64
+#define CANVAS_ROWS ( ROW_OFFSET + RSSI_LEVEL_NUM + X_AXIS_WIDTH + STATUS_HEIGHT )
+#define CANVAS_AXIS_WIDTH ( COLUMN_OFFSET + ( NB_CHAN * 2 ) + 1 )
+#define CANVAS_COLUMNS ( ( CANVAS_AXIS_WIDTH > CANVAS_TEXT_WIDTH ) ? CANVAS_AXIS_WIDTH : CANVAS_TEXT_WIDTH )
+
+/*!
+ * @brief Canvas rows, counted from 1 at the home position
+ */
+#define PLOT_FIRST_ROW ( ROW_OFFSET + 1 )
+#define PLOT_LAST_ROW ( ROW_OFFSET + RSSI_LEVEL_NUM )
+#define X_AXIS_ROW ( PLOT_LAST_ROW + 1 )
+#define X_SCALE_ROW ( PLOT_LAST_ROW + 2 )
+#define STATUS_ROW ( PLOT_LAST_ROW + X_AXIS_WIDTH + 1 )
+
+/*!
+ * @brief Flag of a cell drawn in the curve color, the character itself being 7-bit ASCII
+ */
+#define CELL_COLOR_CURVE 0x80
+#define CELL_CHAR_MASK 0x7F
+
+/*!
+ * @brief Cursor color when the terminal attributes are not known
+ */
+#define CURSOR_COLOR_UNKNOWN 0xFF
+
+/*!
+ * @brief Longest sequence of unchanged cells crossed by printing them again rather than moving the cursor
+ */
+#define GAP_REPRINT_MAX 4
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * @brief Waterfall shades, from the weakest to the strongest RSSI level
+ */
+static const char waterfall_shades[] = " .:-=+*#%@";
+
+#define WATERFALL_SHADE_NUM ( sizeof( waterfall_shades ) - 1 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static curve_plot_mode_t plot_mode = CURVE_PLOT_MODE_CURVE;
+static uint8_t           curve_levels[NB_CHAN];
+
+/*!
+ * @brief Characters displayed by the terminal, and characters of the frame being composed
+ */
+static uint8_t canvas_shown[CANVAS_ROWS][CANVAS_COLUMNS];
+static uint8_t canvas_next[CANVAS_ROWS][CANVAS_COLUMNS];
+
+/*!
+ * @brief Terminal cursor, as left by the bytes of the current frame
+ */
+static bool     cursor_is_known;
+static uint16_t cursor_row;
+static uint16_t cursor_column;
+static uint8_t  cursor_color;
+
+static char     frame_buffer[CURVE_PLOT_FRAME_BUFFER_SIZE];
+static uint16_t frame_length;
+static uint32_t frame_bytes;
+
+/*!
+ * @brief UART cost of the display
+ */
+static uint32_t nb_frames;
+static uint32_t first_frame_bytes;
+static uint32_t last_frame_bytes;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static void plot_y_axis( void );
+static void plot_x_axis( void );
+static void plot_status( void );
+static void compose_curve( void );
+static void compose_waterfall( void );
+static void canvas_put( uint16_t row, uint16_t column, uint8_t cell );
+static void canvas_put_text( uint16_t row, uint16_t column, const char* text );
+static void canvas_clear( uint8_t canvas[CANVAS_ROWS][CANVAS_COLUMNS], uint16_t first_row, uint16_t last_row,
+                          uint16_t first_column );
+
+/*!
+ * @brief Send the cells of canvas_next which differ from canvas_shown, then account the frame
+ */
+static void render_frame( void );
+
+/*!
+ * @brief Shift the plot area of the terminal down by one row, with the VT102 delete line and insert line controls
+ */
+static void scroll_plot_area( void );
+
+/*!
+ * @brief Move the cursor with the shortest of the possible sequences
+ */
+static void set_cursor_on_canvas( uint16_t row, uint16_t column );
+static void set_color( uint8_t color );
+static uint16_t append_move( char* buffer, char final, uint16_t count );
+static void frame_put( const char* data, uint16_t length );
+static void frame_flush( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void create_canvas( curve_plot_mode_t mode )
+{
+    for( uint8_t i = 1; i < CANVAS_ROWS; i++ )
+    {
+        HAL_DBG_TRACE_PRINTF( "\n" );
+    }
+    HAL_DBG_TRACE_PRINTF( "\033[%dA", ( CANVAS_ROWS - 1 ) );  // Cursor up
+
+    /* Set the home of canvas */
+    HAL_DBG_TRACE_PRINTF( "\033[s" );   // Save cursor of home
+    HAL_DBG_TRACE_PRINTF( "\033[7l" );  // Disable line wrap
+    HAL_DBG_TRACE_PRINTF( "\033[0m" );  // Reset print color
+
+    plot_mode = mode;
+    memset( canvas_shown, ' ', sizeof( canvas_shown ) );
+    memset( canvas_next, ' ', sizeof( canvas_next ) );
+    plot_y_axis( );
+    plot_x_axis( );
+
+    nb_frames         = 0;
+    first_frame_bytes = 0;
+    last_frame_bytes  = 0;
+}
+
+void plot_curve( uint8_t column, uint8_t row )
+{
+    if( ( column < 1 ) || ( column > NB_CHAN ) )
+    {
+        return;
+    }
+
+    curve_levels[column - 1] = ( row < RSSI_LEVEL_NUM ) ? row : ( RSSI_LEVEL_NUM - 1 );  // Save rssi level
+    if( column < NB_CHAN )
+    {
+        return;
+    }
+
+    /* Last column: the sweep is complete */
+    if( plot_mode == CURVE_PLOT_MODE_WATERFALL )
+    {
+        compose_waterfall( );
+    }
+    else
+    {
+        compose_curve( );
+    }
+    plot_status( );
+    render_frame( );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+void plot_y_axis( void )
+{
+    char label[8];
+
+    canvas_put( 1, COLUMN_OFFSET, '^' );
+    for( uint8_t i = 1; i <= RSSI_LEVEL_NUM; i++ )
+    {
+        if( plot_mode == CURVE_PLOT_MODE_CURVE )
+        {
+            /* Print RSSI scales */
+            snprintf( label, sizeof( label ), "%*d", 4, ( RSSI_TOP_LEVEL_DBM - ( i - 1 ) * RSSI_SCALE ) );
+            canvas_put_text( ( i + ROW_OFFSET ), 1, label );
+        }
+        else if( ( i == 1 ) || ( i == RSSI_LEVEL_NUM ) )
+        {
+            /* Print the age of the newest and oldest sweeps only: the labels scroll with the plot lines and have to be
+             * printed again on every sweep */
+            snprintf( label, sizeof( label ), "%*d", 4, -( i - 1 ) );
+            canvas_put_text( ( i + ROW_OFFSET ), 1, label );
+        }
+        canvas_put( ( i + ROW_OFFSET ), COLUMN_OFFSET, '|' );
+    }
+    canvas_put_text( X_AXIS_ROW, 1, ( plot_mode == CURVE_PLOT_MODE_CURVE ) ? "/dBm" : "/swp" );  // Unit
+}
+
+void plot_x_axis( void )
+{
+    char     label[CANVAS_TEXT_WIDTH];
+    uint16_t column = COLUMN_OFFSET;
+
+    canvas_put( X_AXIS_ROW, column++, 'x' );
+    for( uint8_t i = 0; i < NB_CHAN; i++ )
+    {
+        canvas_put( X_AXIS_ROW, column++, '-' );
+        canvas_put( X_AXIS_ROW, column++, '-' );
+    }
+    canvas_put( X_AXIS_ROW, column, '>' );
+
+    if( plot_mode == CURVE_PLOT_MODE_CURVE )
+    {
+        snprintf( label, sizeof( label ), "%.0f --> %.0f MHz", ( FREQ_START_HZ / 10E5 ),
+                  ( ( FREQ_START_HZ + ( WIDTH_CHAN_HZ * NB_CHAN ) ) / 10E5 ) );
+    }
+    else
+    {
+        snprintf( label, sizeof( label ), "%.0f --> %.0f MHz, %d dBm [%s] %d dBm", ( FREQ_START_HZ / 10E5 ),
+                  ( ( FREQ_START_HZ + ( WIDTH_CHAN_HZ * NB_CHAN ) ) / 10E5 ), RSSI_BOTTOM_LEVEL_DBM, waterfall_shades,
+                  RSSI_TOP_LEVEL_DBM );
+    }
+    canvas_put_text( X_SCALE_ROW, ( COLUMN_OFFSET + 1 ), label );
+}
+
+void plot_status( void )
+{
+    char status[80];
+
+    if( last_frame_bytes == 0 )
+    {
+        return;
+    }
+
+    /* One byte takes 10 bit times on the line: start, 8 data, stop */
+    snprintf( status, sizeof( status ), "%5lu B/frame, %5lu fps max (full redraw %lu B)",
+              ( unsigned long ) last_frame_bytes, ( unsigned long ) ( UART_BAUDRATE / 10 / last_frame_bytes ),
+              ( unsigned long ) first_frame_bytes );
+    canvas_clear( canvas_next, STATUS_ROW, STATUS_ROW, 1 );
+    canvas_put_text( STATUS_ROW, 1, status );
+}
+
+void compose_curve( void )
+{
+    canvas_clear( canvas_next, PLOT_FIRST_ROW, PLOT_LAST_ROW, ( COLUMN_OFFSET + 1 ) );
+
+    for( uint8_t column = 1; column <= NB_CHAN; column++ )
+    {
+        const uint16_t row = PLOT_FIRST_ROW + curve_levels[column - 1];
+
+        if( column > 1 )
+        {
+            /* Improve curve continuity */
+            const uint16_t previous_row = PLOT_FIRST_ROW + curve_levels[column - 2];
+            const uint16_t link_column  = ( column - 1 ) * 2 + COLUMN_OFFSET;
+
+            if( row > previous_row )  // Go down
+            {
+                for( uint16_t i = previous_row + 1; i <= row; i++ )
+                {
+                    canvas_put( i, link_column, '|' | CELL_COLOR_CURVE );
+                }
+            }
+            else if( row < previous_row )  // Go up
+            {
+                for( uint16_t i = row + 1; i <= previous_row; i++ )
+                {
+                    canvas_put( i, link_column, '|' | CELL_COLOR_CURVE );
+                }
+            }
+            else
+            {
+                canvas_put( row, link_column, '.' | CELL_COLOR_CURVE );
+            }
+        }
+
+        canvas_put( row, ( column * 2 - 1 + COLUMN_OFFSET ), '_' | CELL_COLOR_CURVE );  // Symbol of the RSSI level
+    }
+}
+
+void compose_waterfall( void )
+{
+    /* Age the previous sweeps by one row, the oldest one falls off the plot */
+    for( uint16_t row = PLOT_LAST_ROW; row > PLOT_FIRST_ROW; row-- )
+    {
+        memcpy( &canvas_next[row - 1][COLUMN_OFFSET], &canvas_next[row - 2][COLUMN_OFFSET],
+                CANVAS_COLUMNS - COLUMN_OFFSET );
+    }
+
+    for( uint8_t column = 1; column <= NB_CHAN; column++ )
+    {
+        const uint8_t shade =
+            ( ( RSSI_LEVEL_NUM - 1 - curve_levels[column - 1] ) * WATERFALL_SHADE_NUM ) / RSSI_LEVEL_NUM;
+        const uint8_t cell  = ( shade == 0 ) ? ' ' : ( ( uint8_t ) waterfall_shades[shade] | CELL_COLOR_CURVE );
+
+        canvas_put( PLOT_FIRST_ROW, ( column * 2 - 1 + COLUMN_OFFSET ), cell );
+        canvas_put( PLOT_FIRST_ROW, ( column * 2 + COLUMN_OFFSET ), cell );
+    }
+}
+
+void canvas_put( uint16_t row, uint16_t column, uint8_t cell )
+{
+    if( ( row >= 1 ) && ( row <= CANVAS_ROWS ) && ( column >= 1 ) && ( column <= CANVAS_COLUMNS ) )
+    {
+        canvas_next[row - 1][column - 1] = cell;
+    }
+}
+
+void canvas_put_text( uint16_t row, uint16_t column, const char* text )
+{
+    while( *text != '\0' )
+    {
+        canvas_put( row, column++, ( uint8_t ) *text++ & CELL_CHAR_MASK );
+    }
+}
+
+void canvas_clear( uint8_t canvas[CANVAS_ROWS][CANVAS_COLUMNS], uint16_t first_row, uint16_t last_row,
+                   uint16_t first_column )
+{
+    for( uint16_t row = first_row; row <= last_row; row++ )
+    {
+        memset( &canvas[row - 1][first_column - 1], ' ', CANVAS_COLUMNS - first_column + 1 );
+    }
+}
+
+void render_frame( void )
+{
+    /* Other traces may have moved the cursor or changed the color since the previous frame */
+    cursor_is_known = false;
+    cursor_color    = CURSOR_COLOR_UNKNOWN;
+    frame_length    = 0;
+    frame_bytes     = 0;
+
+    if( ( plot_mode == CURVE_PLOT_MODE_WATERFALL ) && ( nb_frames > 0 ) )
+    {
+        scroll_plot_area( );
+    }
+
+    for( uint16_t row = 1; row <= CANVAS_ROWS; row++ )
+    {
+        for( uint16_t column = 1; column <= CANVAS_COLUMNS; column++ )
+        {
+            const uint8_t cell = canvas_next[row - 1][column - 1];
+            char          character;
+
+            if( cell == canvas_shown[row - 1][column - 1] )
+            {
+                continue;
+            }
+
+            set_cursor_on_canvas( row, column );
+            character = ( char ) ( cell & CELL_CHAR_MASK );
+            if( character != ' ' )
+            {
+                set_color( cell & CELL_COLOR_CURVE );
+            }
+            frame_put( &character, 1 );
+            cursor_column++;
+            canvas_shown[row - 1][column - 1] = cell;
+        }
+    }
+
+    if( ( cursor_color != CURSOR_COLOR_UNKNOWN ) && ( cursor_color != 0 ) )
+    {
+        set_color( 0 );  // Leave the other traces uncolored
+    }
+    frame_flush( );
+
+    if( nb_frames == 0 )
+    {
+        first_frame_bytes = frame_bytes;
+    }
+    last_frame_bytes = frame_bytes;
+    nb_frames++;
+}
+
+void scroll_plot_area( void )
+{
+    set_cursor_on_canvas( PLOT_LAST_ROW, 1 );
+    frame_put( "\033[M", 3 );  // Delete line, the lines below move up
+    set_cursor_on_canvas( PLOT_FIRST_ROW, 1 );
+    frame_put( "\033[L", 3 );  // Insert line, the lines below move back down
+    cursor_is_known = false;   // Some terminals also move the cursor to the left margin
+
+    memmove( &canvas_shown[PLOT_FIRST_ROW][0], &canvas_shown[PLOT_FIRST_ROW - 1][0],
+             ( PLOT_LAST_ROW - PLOT_FIRST_ROW ) * CANVAS_COLUMNS );
+    canvas_clear( canvas_shown, PLOT_FIRST_ROW, PLOT_FIRST_ROW, 1 );
+}
+
+void set_cursor_on_canvas( uint16_t row, uint16_t column )
+{
+    char     candidate[24];
+    uint16_t length;
+    char     best[24];
+    uint16_t best_length;
+
+    if( cursor_is_known && ( row == cursor_row ) && ( column == cursor_column ) )
+    {
+        return;
+    }
+
+    /* Go back to home of canvas, then down and forward */
+    memcpy( best, "\033[u", 3 );
+    best_length = 3;
+    best_length += append_move( &best[best_length], 'B', row - 1 );
+    best_length += append_move( &best[best_length], 'C', column - 1 );
+
+    if( cursor_is_known )
+    {
+        /* Print the unchanged cells again when it is shorter than a move */
+        if( ( row == cursor_row ) && ( column > cursor_column ) && ( ( column - cursor_column ) <= GAP_REPRINT_MAX ) )
+        {
+            length = 0;
+            for( uint16_t i = cursor_column; i < column; i++ )
+            {
+                const uint8_t cell = canvas_shown[row - 1][i - 1];
+
+                if( ( ( cell & CELL_CHAR_MASK ) != ' ' ) && ( ( cell & CELL_COLOR_CURVE ) != cursor_color ) )
+                {
+                    length = 0;
+                    break;
+                }
+                candidate[length++] = ( char ) ( cell & CELL_CHAR_MASK );
+            }
+            if( ( length > 0 ) && ( length < best_length ) )
+            {
+                memcpy( best, candidate, length );
+                best_length = length;
+            }
+        }
+
+        /* Relative move */
+        length = 0;
+        length += append_move( &candidate[length], ( row > cursor_row ) ? 'B' : 'A', abs( row - cursor_row ) );
+        length +=
+            append_move( &candidate[length], ( column > cursor_column ) ? 'C' : 'D', abs( column - cursor_column ) );
+        if( length < best_length )
+        {
+            memcpy( best, candidate, length );
+            best_length = length;
+        }
+
+        /* Carriage return, then relative move */
+        candidate[0] = '\r';
+        length       = 1;
+        length += append_move( &candidate[length], ( row > cursor_row ) ? 'B' : 'A', abs( row - cursor_row ) );
+        length += append_move( &candidate[length], 'C', column - 1 );
+        if( length < best_length )
+        {
+            memcpy( best, candidate, length );
+            best_length = length;
+        }
+    }
+
+    frame_put( best, best_length );
+    cursor_is_known = true;
+    cursor_row      = row;
+    cursor_column   = column;
+}
+
+void set_color( uint8_t color )
+{
+    if( color == cursor_color )
+    {
+        return;
+    }
+
+    if( color == CELL_COLOR_CURVE )
+    {
+        frame_put( "\033[0;32m", 7 );  // Set green color for the curve
+    }
+    else
+    {
+        frame_put( "\033[0m", 4 );  // Reset print color
+    }
+    cursor_color = color;
+}
+
+uint16_t append_move( char* buffer, char final, uint16_t count )
+{
+    if( count == 0 )
+    {
+        return 0;
+    }
+    if( count == 1 )  // The count defaults to 1
+    {
+        buffer[0] = '\033';
+        buffer[1] = '[';
+        buffer[2] = final;
+        return 3;
+    }
+    return ( uint16_t ) sprintf( buffer, "\033[%u%c", count, final );
+}
+
+void frame_put( const char* data, uint16_t length )
+{
+    frame_bytes += length;
+    while( length > 0 )
+    {
+        uint16_t chunk = CURVE_PLOT_FRAME_BUFFER_SIZE - frame_length;
+
+        if( chunk > length )
+        {
+            chunk = length;
+        }
+        memcpy( &frame_buffer[frame_length], data, chunk );
+        frame_length += chunk;
+        data += chunk;
+        length -= chunk;
+
+        if( frame_length == CURVE_PLOT_FRAME_BUFFER_SIZE )
+        {
+            frame_flush( );
+        }
+    }
+}
+
+void frame_flush( void )
+{
+    if( frame_length > 0 )
+    {
+        uart_send_bytes( ( const uint8_t* ) frame_buffer, frame_length );
+        frame_length = 0;
+    }
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -1,7 +1,7 @@
 /*!
  * @file      curve_plot.h
  *
- * @brief     Curve_plot functions used in Spectrum_display example for LR11xx chip
+ * @brief     Curve_plot functions used in Spectrum_display example for LR11xx and SX126x chips
  *
  * The Clear BSD License
  * Copyright Semtech Corporation 2022. All rights reserved.
@@ -44,11 +44,22 @@ extern "C" {
  * --- DEPENDENCIES ------------------------------------------------------------
  */
 
+#include <stdint.h>
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC MACROS -----------------------------------------------------------
  */
 
+/*!
+ * @brief Size of the buffer collecting the terminal output of a frame, in bytes
+ *
+ * @remark A frame larger than the buffer, e.g. the very first one which draws the axes, is sent in several writes
+ */
+#ifndef CURVE_PLOT_FRAME_BUFFER_SIZE
+#define CURVE_PLOT_FRAME_BUFFER_SIZE 1024
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC CONSTANTS --------------------------------------------------------
@@ -59,6 +70,15 @@ extern "C" {
  * --- PUBLIC TYPES ------------------------------------------------------------
  */
 
+/*!
+ * @brief Display modes
+ */
+typedef enum curve_plot_mode_e
+{
+    CURVE_PLOT_MODE_CURVE = 0,  //!< RSSI versus frequency curve of the last sweep
+    CURVE_PLOT_MODE_WATERFALL,  //!< One shaded line per sweep, the newest one on top
+} curve_plot_mode_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
@@ -67,8 +87,11 @@ extern "C" {
 /*!
  * @brief Interface to plot dynamic curve for spectral scan result
  *
- * @param [in] column Offset of column from home position of the canvas.
- * @param [in] row Offset of column from home position of the canvas.
+ * The levels are kept until the last channel of the sweep is given. The new frame is then compared with the one
+ * displayed, and only the characters which differ are sent, in a single UART write.
+ *
+ * @param [in] column Channel index, from 1 to NB_CHAN.
+ * @param [in] row RSSI level, in RSSI_SCALE steps below RSSI_TOP_LEVEL_DBM.
  *
  */
 void plot_curve( uint8_t column, uint8_t row );
@@ -76,9 +99,11 @@ void plot_curve( uint8_t column, uint8_t row );
 /*!
  * @brief Interface to create canvas space for curve ploting
  *
+ * @param [in] mode Display mode
+ *
  * @warning This function must be called to create space for ploting and set the home position for plot_curve function.
  */
-void create_canvas( void );
+void create_canvas( curve_plot_mode_t mode );
 
 #ifdef __cplusplus
 }
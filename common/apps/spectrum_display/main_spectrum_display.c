@@ -1,7 +1,7 @@
 /*!
  * @file      main_spectrum_display.c
  *
- * @brief     Spectrum-display example for SX126x chip
+ * @brief     Spectrum-display example for LR11xx and SX126x chips
  *
  * The Clear BSD License
  * Copyright Semtech Corporation 2022. All rights reserved.
@@ -37,14 +37,12 @@
  * --- DEPENDENCIES ------------------------------------------------------------
  */
 
-#include <stdlib.h>
+#include <stddef.h>
 
 #include "apps_common.h"
-#include "apps_utilities.h"
-#include "sx126x.h"
+#include "apps_radio.h"
 #include "main_spectrum_display.h"
 #include "curve_plot.h"
-#include "smtc_hal_mcu.h"
 #include "smtc_hal_dbg_trace.h"
 #include "uart_init.h"
 
@@ -79,12 +77,25 @@
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
+/**
+ * @brief Steps of the display loop, sequenced by the display timer
+ */
+typedef enum spectrum_display_state_e
+{
+    SPECTRUM_DISPLAY_STATE_FETCH_RSSI,  //!< Reception started, waiting for a stable instant RSSI
+    SPECTRUM_DISPLAY_STATE_PACE,        //!< All channels plotted, waiting before the next sweep
+} spectrum_display_state_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-static sx126x_hal_context_t* context;
+static apps_radio_t radio;
+
+static smtc_hal_mcu_timer_soft_t display_timer;
+static spectrum_display_state_t  display_state;
+static uint8_t                   freq_chan_index = 0;
 
 /*
  * -----------------------------------------------------------------------------
@@ -92,8 +103,24 @@ static sx126x_hal_context_t* context;
  */
 
 static void spectrum_display_start( uint32_t freq_hz );
+
+/**
+ * @brief Plot the instant RSSI of the current channel, or start the next sweep once paced
+ *
+ * @param [in] timer_context Unused
+ */
+static void spectrum_display_on_timer( void* timer_context );
 static void print_configuration( void );
 
+/**
+ * @brief Convert an instant RSSI to the level plotted, counted in RSSI_SCALE steps below RSSI_TOP_LEVEL_DBM
+ *
+ * @param [in] rssi_dbm Instant RSSI
+ *
+ * @returns Level, saturated to 0 above RSSI_TOP_LEVEL_DBM
+ */
+static uint8_t rssi_to_level( int16_t rssi_dbm );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -104,63 +131,93 @@ static void print_configuration( void );
  */
 int main( void )
 {
-    smtc_hal_mcu_init( );
-    uart_init();
-
-    HAL_DBG_TRACE_INFO( "===== SX126x Spectrum Display example =====\n\n" );
-    apps_common_sx126x_print_version_info( );
+    const radio_registry_binding_t binding = RADIO_REGISTRY_BINDING_ARDUINO;
 
+    smtc_hal_mcu_init( );
     apps_common_shield_init( );
-    context = apps_common_sx126x_get_context( );
+    uart_init( );
+
+    HAL_DBG_TRACE_INFO( "===== " APPS_RADIO_CHIP_NAME " Spectrum Display example =====\n\n" );
+    apps_radio_open( &radio, APPS_RADIO_CHIP_OPS, 0, &binding );
+    apps_radio_print_version( &radio );
 
-    apps_common_sx126x_init( ( void* ) context );
-    apps_common_sx126x_radio_init( ( void* ) context );
+    apps_radio_init( &radio );
 
     print_configuration( );
 
-    create_canvas( );
+    create_canvas( DISPLAY_MODE );
+
+    smtc_hal_mcu_timer_soft_init( &display_timer, spectrum_display_on_timer, NULL );
+    spectrum_display_start( FREQ_START_HZ );
 
     while( 1 )
     {
-        int16_t        result;
-        static uint8_t freq_chan_index = 0;
-        const uint32_t freq_hz         = FREQ_START_HZ + ( freq_chan_index * WIDTH_CHAN_HZ );
+        apps_radio_wait_for_event( &radio );
+    }
+}
 
-        /* Start Spectral scan */
-        spectrum_display_start( freq_hz );
+void spectrum_display_start( uint32_t freq_hz )
+{
+    /* Set frequency */
+    apps_radio_set_rf_freq( &radio, freq_hz );
 
-        LL_mDelay( DELAY_BETWEEN_EACH_INST_RSSI_FETCH_US );
-        ASSERT_SX126X_RC( sx126x_get_rssi_inst( context, &result ) );
-        plot_curve( ( freq_chan_index + 1 ), ( abs( result ) / RSSI_SCALE ) );
+    /* Set Radio in Rx continuous mode */
+    apps_radio_set_rx_continuous( &radio );
 
-        /* Switch to next channel */
-        ASSERT_SX126X_RC( sx126x_set_standby( context, SX126X_STANDBY_CFG_XOSC ) );
-        apps_common_sx126x_handle_post_rx( );
+    display_state = SPECTRUM_DISPLAY_STATE_FETCH_RSSI;
+    smtc_hal_mcu_timer_soft_start(
+        &display_timer, ( DELAY_BETWEEN_SET_RX_AND_VALID_RSSI_MS * 1000 ) + DELAY_BETWEEN_EACH_INST_RSSI_FETCH_US, 0 );
+}
 
-        freq_chan_index++;
-        if( freq_chan_index >= NB_CHAN )
-        {
-            freq_chan_index = 0;
+static void spectrum_display_on_timer( void* timer_context )
+{
+    int16_t result;
+
+    if( display_state == SPECTRUM_DISPLAY_STATE_PACE )
+    {
+        spectrum_display_start( FREQ_START_HZ );
+        return;
+    }
 
-            /* Pace the scan speed (1 sec min) */
-            for( uint16_t i = 0; i < ( int ) ( PACE_S ? PACE_S : 1 ); i++ )
-            {
-                LL_mDelay( 1000 );
-            }
+    result = apps_radio_get_rssi_inst( &radio );
+    plot_curve( ( freq_chan_index + 1 ), rssi_to_level( result ) );
+
+    /* Switch to next channel */
+    apps_radio_set_standby( &radio, APPS_RADIO_STANDBY_CFG_XOSC );
+
+    freq_chan_index++;
+    if( freq_chan_index >= NB_CHAN )
+    {
+        freq_chan_index = 0;
+
+        /* Pace the scan speed */
+        if( PACE_MS > 0 )
+        {
+            display_state = SPECTRUM_DISPLAY_STATE_PACE;
+            smtc_hal_mcu_timer_soft_start( &display_timer, ( uint32_t ) PACE_MS * 1000UL, 0 );
+        }
+        else
+        {
+            spectrum_display_start( FREQ_START_HZ );
         }
     }
+    else
+    {
+        spectrum_display_start( FREQ_START_HZ + ( freq_chan_index * WIDTH_CHAN_HZ ) );
+    }
 }
 
-void spectrum_display_start( uint32_t freq_hz )
+uint8_t rssi_to_level( int16_t rssi_dbm )
 {
-    /* Set frequency */
-    ASSERT_SX126X_RC( sx126x_set_rf_freq( context, freq_hz ) );
-
-    /* Set Radio in Rx continuous mode */
-    apps_common_sx126x_handle_pre_rx( );
-    ASSERT_SX126X_RC( sx126x_set_rx_with_timeout_in_rtc_step( context, RX_CONTINUOUS ) );
-
-    LL_mDelay( DELAY_BETWEEN_SET_RX_AND_VALID_RSSI_MS );
+    if( rssi_dbm >= RSSI_TOP_LEVEL_DBM )
+    {
+        return 0;
+    }
+    if( rssi_dbm <= RSSI_BOTTOM_LEVEL_DBM )
+    {
+        return ( RSSI_TOP_LEVEL_DBM - RSSI_BOTTOM_LEVEL_DBM ) / RSSI_SCALE;
+    }
+    return ( uint8_t ) ( ( RSSI_TOP_LEVEL_DBM - rssi_dbm ) / RSSI_SCALE );
 }
 
 void print_configuration( void )
@@ -168,7 +225,9 @@ void print_configuration( void )
     HAL_DBG_TRACE_PRINTF( "\n" );
     HAL_DBG_TRACE_INFO( "Spectral Scan configuration:\n" );
     HAL_DBG_TRACE_INFO( "  - Number of channels need to scan: %d\n", NB_CHAN );
-    HAL_DBG_TRACE_INFO( "  - Time delay between 2 scans: %d S\n", PACE_S );
+    HAL_DBG_TRACE_INFO( "  - Time delay between 2 scans: %d ms\n", PACE_MS );
+    HAL_DBG_TRACE_INFO( "  - Display mode: %s\n",
+                        ( DISPLAY_MODE == CURVE_PLOT_MODE_WATERFALL ) ? "waterfall" : "curve" );
     HAL_DBG_TRACE_INFO( "  - Start frequency: %.3f MHz\n", ( FREQ_START_HZ / 10E5 ) );
     HAL_DBG_TRACE_INFO( "  - Frequency step of scan channels: %.3f kHz\n", ( WIDTH_CHAN_HZ / 10E2 ) );
     HAL_DBG_TRACE_INFO( "Start Spectrum Display:\n" );
@@ -0,0 +1,522 @@
+/*!
+ * @file      main_time_sync.c
+ *
+ * @brief     Time synchronisation example for LR11xx and SX126x chips
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "apps_common.h"
+#include "apps_radio.h"
+#include "main_time_sync.h"
+#include "smtc_hal_dbg_trace.h"
+#include "smtc_hal_mcu_lpm.h"
+#include "smtc_time_sync.h"
+#include "uart_init.h"
+#include "apps_entropy.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/**
+ * @brief Magic number of the frames sent by the followers in their slot
+ */
+#define TIME_SYNC_SLOT_FRAME_MAGIC 0x53
+
+/**
+ * @brief Slot frame flag: the frame carries the end of the previous slot frame, in the reference clock
+ */
+#define TIME_SYNC_SLOT_FRAME_FLAG_PREVIOUS_VALID 0x01
+
+/**
+ * @brief Time before the next beacon at which the reference stops listening to the followers
+ *
+ * Expressed in milliseconds
+ */
+#define TIME_SYNC_RX_GUARD_IN_MS 100
+
+/**
+ * @brief Time before the slot start at which the software timer expires, the rest being waited for actively
+ *
+ * Covers the software timer resolution and the latency of the main loop.
+ *
+ * Expressed in microseconds
+ */
+#define TIME_SYNC_SLOT_WAKE_UP_MARGIN_IN_US 2000
+
+/**
+ * @brief Upper bound of the random extension of the search, so that two nodes started together do not both become
+ * the reference
+ *
+ * Expressed in milliseconds
+ */
+#define TIME_SYNC_SEARCH_RANDOM_IN_MS 2000
+
+/**
+ * @brief Interrupt mask used by the application
+ */
+#define IRQ_MASK                                                                                                 \
+    ( APPS_RADIO_IRQ_TX_DONE | APPS_RADIO_IRQ_RX_DONE | APPS_RADIO_IRQ_TIMEOUT | APPS_RADIO_IRQ_HEADER_ERROR | \
+      APPS_RADIO_IRQ_CRC_ERROR | APPS_RADIO_IRQ_LENGTH_ERROR )
+
+#if PAYLOAD_LENGTH < SMTC_TIME_SYNC_BEACON_LENGTH
+#error "PAYLOAD_LENGTH is too short for a time synchronisation beacon"
+#endif
+
+#if TIME_SYNC_SLOT_OFFSET_IN_MS >= TIME_SYNC_SUPERFRAME_IN_MS
+#error "The follower slot has to start within the superframe"
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Role of the node
+ */
+typedef enum time_sync_role_e
+{
+    TIME_SYNC_ROLE_FOLLOWER = 0,  //!< Searches for beacons, then disciplines its clock on them and sends in its slot
+    TIME_SYNC_ROLE_REFERENCE,     //!< Sends the beacons and listens to the followers in between
+} time_sync_role_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static apps_radio_t radio;
+
+static time_sync_role_t role = TIME_SYNC_ROLE_FOLLOWER;
+static uint8_t          buffer[PAYLOAD_LENGTH];
+
+static smtc_time_sync_reference_t reference;
+static smtc_hal_mcu_timer_soft_t  beacon_timer;
+static uint32_t                   next_beacon_in_us;
+
+/**
+ * @brief Reference side: slot frame waiting for the follower estimate of its on-air end
+ */
+static bool     is_slot_frame_pending = false;
+static uint8_t  pending_slot_frame_seq;
+static uint32_t pending_slot_frame_end_of_packet_in_us;
+
+static smtc_time_sync_t          sync;
+static smtc_hal_mcu_timer_soft_t slot_timer;
+static uint32_t                  slot_start_in_us;
+
+/**
+ * @brief Follower side: next slot frame
+ */
+static uint8_t  slot_frame_seq                     = 0;
+static bool     is_last_slot_frame_valid           = false;
+static uint32_t last_slot_frame_end_of_packet_in_us = 0;
+
+/**
+ * @brief Appended to the synchronisation errors printed when the timing model of the chip is not characterised
+ */
+static const char* error_note = "";
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Dispatch the interrupts of the radio
+ *
+ * @param [in] radio_irq Radio that raised the interrupts
+ * @param [in] irq Interrupts raised
+ */
+static void time_sync_on_radio_irq( const apps_radio_t* radio_irq, apps_radio_irq_mask_t irq );
+
+/**
+ * @brief Handle the end of a beacon or slot frame transmission
+ */
+static void time_sync_on_tx_done( void );
+
+/**
+ * @brief Handle a packet received without error
+ */
+static void time_sync_on_rx_done( void );
+
+/**
+ * @brief Handle a reception timeout: no beacon for TIME_SYNC_SEARCH_NB_SUPERFRAMES superframes on the follower side
+ */
+static void time_sync_on_rx_timeout( void );
+
+/**
+ * @brief Follower: use a received beacon and schedule the slot once locked
+ *
+ * @param [in] size Received payload length
+ * @param [in] end_of_packet_in_us On-air end of the beacon, in the local clock
+ */
+static void time_sync_on_beacon( uint8_t size, uint32_t end_of_packet_in_us );
+
+/**
+ * @brief Reference: measure the synchronisation error of a follower from its slot frames
+ *
+ * A slot frame carries the follower estimate, in the reference clock, of the on-air end of its previous slot frame,
+ * which the reference compares with its own timestamp of that frame. The difference also includes the propagation
+ * delay, twice.
+ *
+ * @param [in] size Received payload length
+ * @param [in] end_of_packet_in_us On-air end of the slot frame, in the reference clock
+ */
+static void time_sync_on_slot_frame( uint8_t size, uint32_t end_of_packet_in_us );
+
+/**
+ * @brief Start the reception for the current role
+ */
+static void time_sync_start_rx( void );
+
+/**
+ * @brief Stop searching and start sending the beacons
+ */
+static void time_sync_become_reference( void );
+
+/**
+ * @brief Send a beacon
+ *
+ * @param [in] timer_context Unused
+ */
+static void time_sync_send_beacon( void* timer_context );
+
+/**
+ * @brief Arm the slot timer for the next slot given by the synchronisation
+ */
+static void time_sync_schedule_slot( void );
+
+/**
+ * @brief Send a slot frame at the exact slot start, waiting actively for the last TIME_SYNC_SLOT_WAKE_UP_MARGIN_IN_US
+ *
+ * @param [in] timer_context Unused
+ */
+static void time_sync_send_slot_frame( void* timer_context );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+/**
+ * @brief Main application entry point.
+ */
+int main( void )
+{
+    const radio_registry_binding_t binding = RADIO_REGISTRY_BINDING_ARDUINO;
+
+    smtc_hal_mcu_init( );
+    apps_common_shield_init( );
+    uart_init( );
+
+    HAL_DBG_TRACE_INFO( "===== " APPS_RADIO_CHIP_NAME " Time synchronisation example =====\n\n" );
+    apps_radio_open( &radio, APPS_RADIO_CHIP_OPS, 0, &binding );
+    apps_radio_print_version( &radio );
+
+    // Radio parameters can be changed with AT commands until AT+START
+    main_loop( );
+
+    // In Stop 2 the microsecond timer is stopped and patched from the LSI-clocked RTC on wake-up: 31.25 us steps and
+    // an LSI a few percent off make the time base lose milliseconds per superframe, whatever AT+LPM selected
+    smtc_hal_mcu_lpm_set_max_mode( SMTC_HAL_MCU_LPM_MODE_SLEEP );
+
+    apps_radio_init( &radio );
+    apps_radio_set_irq_mask( &radio, IRQ_MASK );
+
+    if( apps_radio_is_timing_model_characterised( &radio ) == false )
+    {
+        HAL_DBG_TRACE_WARNING( "The " APPS_RADIO_CHIP_NAME " timing model uses placeholder IRQ processing times: the "
+                               "on-air timestamps carry a constant bias which has not been measured\n" );
+        error_note = " (+ unvalidated timing model bias)";
+    }
+
+    smtc_hal_mcu_timer_soft_init( &beacon_timer, time_sync_send_beacon, NULL );
+    smtc_hal_mcu_timer_soft_init( &slot_timer, time_sync_send_slot_frame, NULL );
+    smtc_time_sync_init( &sync );
+
+    HAL_DBG_TRACE_INFO( "Searching for a reference (superframe of %u ms, slot at %u ms)\n", TIME_SYNC_SUPERFRAME_IN_MS,
+                        TIME_SYNC_SLOT_OFFSET_IN_MS );
+    time_sync_start_rx( );
+
+    while( 1 )
+    {
+        apps_radio_irq_process( &radio, IRQ_MASK, time_sync_on_radio_irq );
+        apps_radio_wait_for_event( &radio );
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void time_sync_on_radio_irq( const apps_radio_t* radio_irq, apps_radio_irq_mask_t irq )
+{
+    if( ( irq & APPS_RADIO_IRQ_TX_DONE ) != 0 )
+    {
+        time_sync_on_tx_done( );
+    }
+    else if( ( irq & ( APPS_RADIO_IRQ_CRC_ERROR | APPS_RADIO_IRQ_LENGTH_ERROR | APPS_RADIO_IRQ_HEADER_ERROR ) ) != 0 )
+    {
+        HAL_DBG_TRACE_WARNING( "Reception error\n" );
+        time_sync_start_rx( );
+    }
+    else if( ( irq & APPS_RADIO_IRQ_RX_DONE ) != 0 )
+    {
+        time_sync_on_rx_done( );
+    }
+    else if( ( irq & APPS_RADIO_IRQ_TIMEOUT ) != 0 )
+    {
+        time_sync_on_rx_timeout( );
+    }
+}
+
+static void time_sync_on_tx_done( void )
+{
+    // Timestamped from the DIO edge, then moved back to the last bit on air with the timing model of the chip
+    const uint32_t end_of_packet_in_us = apps_radio_get_tx_end_of_packet_in_us( &radio );
+
+    if( role == TIME_SYNC_ROLE_REFERENCE )
+    {
+        smtc_time_sync_reference_on_tx_done( &reference, end_of_packet_in_us );
+    }
+    else
+    {
+        last_slot_frame_end_of_packet_in_us = smtc_time_sync_local_to_reference( &sync, end_of_packet_in_us );
+        is_last_slot_frame_valid            = true;
+        time_sync_schedule_slot( );
+    }
+
+    time_sync_start_rx( );
+}
+
+static void time_sync_on_rx_done( void )
+{
+    const uint32_t end_of_packet_in_us = apps_radio_get_rx_end_of_packet_in_us( &radio );
+    const uint8_t  size                = apps_radio_read_payload( &radio, buffer, PAYLOAD_LENGTH );
+
+    if( role == TIME_SYNC_ROLE_REFERENCE )
+    {
+        time_sync_on_slot_frame( size, end_of_packet_in_us );
+    }
+    else
+    {
+        time_sync_on_beacon( size, end_of_packet_in_us );
+    }
+
+    time_sync_start_rx( );
+}
+
+static void time_sync_on_rx_timeout( void )
+{
+    if( role == TIME_SYNC_ROLE_FOLLOWER )
+    {
+        if( smtc_time_sync_is_locked( &sync ) == true )
+        {
+            HAL_DBG_TRACE_WARNING( "Reference lost, searching again\n" );
+            smtc_hal_mcu_timer_soft_stop( &slot_timer );
+            smtc_time_sync_init( &sync );
+            is_last_slot_frame_valid = false;
+        }
+        else
+        {
+            time_sync_become_reference( );
+            return;
+        }
+    }
+
+    time_sync_start_rx( );
+}
+
+static void time_sync_on_beacon( uint8_t size, uint32_t end_of_packet_in_us )
+{
+    const smtc_time_sync_status_t status = smtc_time_sync_on_beacon( &sync, buffer, size, end_of_packet_in_us );
+    smtc_time_sync_stats_t        stats;
+
+    smtc_time_sync_get_stats( &sync, &stats );
+
+    switch( status )
+    {
+    case SMTC_TIME_SYNC_STATUS_OK:
+        HAL_DBG_TRACE_INFO( "Beacon %u: error %d us, drift %d ppb, max error %u us, %u beacons missed%s\n", buffer[1],
+                            ( int ) stats.last_error_in_us, ( int ) stats.drift_in_ppb,
+                            ( unsigned int ) stats.max_abs_error_in_us, ( unsigned int ) stats.nb_missed_beacons,
+                            error_note );
+        break;
+    case SMTC_TIME_SYNC_STATUS_RELOCKED:
+        HAL_DBG_TRACE_WARNING( "Beacon %u: error %d us, relocked%s\n", buffer[1], ( int ) stats.last_error_in_us,
+                               error_note );
+        break;
+    case SMTC_TIME_SYNC_STATUS_PENDING:
+        HAL_DBG_TRACE_INFO( "Beacon %u received, waiting for its reference time\n", buffer[1] );
+        break;
+    default:
+        HAL_DBG_TRACE_WARNING( "Not a beacon\n" );
+        break;
+    }
+
+    if( ( smtc_time_sync_is_locked( &sync ) == true ) &&
+        ( smtc_hal_mcu_timer_soft_is_running( &slot_timer ) == false ) )
+    {
+        time_sync_schedule_slot( );
+    }
+}
+
+static void time_sync_on_slot_frame( uint8_t size, uint32_t end_of_packet_in_us )
+{
+    if( ( size < SMTC_TIME_SYNC_BEACON_LENGTH ) || ( buffer[0] != TIME_SYNC_SLOT_FRAME_MAGIC ) )
+    {
+        HAL_DBG_TRACE_WARNING( "Unexpected frame\n" );
+        return;
+    }
+
+    if( ( is_slot_frame_pending == true ) && ( buffer[1] == ( uint8_t ) ( pending_slot_frame_seq + 1 ) ) &&
+        ( ( buffer[2] & TIME_SYNC_SLOT_FRAME_FLAG_PREVIOUS_VALID ) != 0 ) )
+    {
+        const uint32_t estimate_in_us = ( uint32_t ) buffer[3] | ( ( uint32_t ) buffer[4] << 8 ) |
+                                        ( ( uint32_t ) buffer[5] << 16 ) | ( ( uint32_t ) buffer[6] << 24 );
+
+        HAL_DBG_TRACE_INFO( "Slot frame %u: follower clock error %d us%s\n", pending_slot_frame_seq,
+                            ( int ) ( int32_t ) ( estimate_in_us - pending_slot_frame_end_of_packet_in_us ),
+                            error_note );
+    }
+    else
+    {
+        HAL_DBG_TRACE_INFO( "Slot frame %u received\n", buffer[1] );
+    }
+
+    is_slot_frame_pending                  = true;
+    pending_slot_frame_seq                 = buffer[1];
+    pending_slot_frame_end_of_packet_in_us = end_of_packet_in_us;
+}
+
+static void time_sync_start_rx( void )
+{
+    if( role == TIME_SYNC_ROLE_FOLLOWER )
+    {
+        apps_radio_set_rx( &radio, TIME_SYNC_SEARCH_NB_SUPERFRAMES * TIME_SYNC_SUPERFRAME_IN_MS +
+                                       apps_entropy_get_range( TIME_SYNC_SEARCH_RANDOM_IN_MS ) );
+    }
+    else
+    {
+        const int32_t remaining_in_ms =
+            ( int32_t ) ( next_beacon_in_us - smtc_hal_mcu_timer_get_time_in_us( ) ) / 1000 - TIME_SYNC_RX_GUARD_IN_MS;
+
+        // Too close to the next beacon: the radio stays idle until then
+        if( remaining_in_ms > 0 )
+        {
+            apps_radio_set_rx( &radio, ( uint32_t ) remaining_in_ms );
+        }
+    }
+}
+
+static void time_sync_become_reference( void )
+{
+    HAL_DBG_TRACE_INFO( "No beacon heard, acting as the reference\n" );
+
+    role = TIME_SYNC_ROLE_REFERENCE;
+    smtc_time_sync_reference_init( &reference );
+    smtc_hal_mcu_timer_soft_start( &beacon_timer, TIME_SYNC_SUPERFRAME_IN_MS * 1000,
+                                   TIME_SYNC_SUPERFRAME_IN_MS * 1000 );
+    time_sync_send_beacon( NULL );
+}
+
+static void time_sync_send_beacon( void* timer_context )
+{
+    // The beacon timer only sets the pace: the actual on-air time is measured on TX_DONE and sent with the next beacon
+    next_beacon_in_us = smtc_hal_mcu_timer_get_time_in_us( ) + TIME_SYNC_SUPERFRAME_IN_MS * 1000;
+
+    memset( buffer, 0, PAYLOAD_LENGTH );
+    smtc_time_sync_reference_build_beacon( &reference, buffer );
+    HAL_DBG_TRACE_INFO( "Sending beacon %u\n", buffer[1] );
+
+    apps_radio_write_payload( &radio, buffer, PAYLOAD_LENGTH );
+    apps_radio_set_tx( &radio, 0 );
+}
+
+static void time_sync_schedule_slot( void )
+{
+    const uint32_t now_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+
+    slot_start_in_us = smtc_time_sync_get_next_slot_in_us( &sync, now_in_us + TIME_SYNC_SLOT_WAKE_UP_MARGIN_IN_US,
+                                                           TIME_SYNC_SUPERFRAME_IN_MS * 1000,
+                                                           TIME_SYNC_SLOT_OFFSET_IN_MS * 1000 );
+
+    smtc_hal_mcu_timer_soft_start( &slot_timer, slot_start_in_us - now_in_us - TIME_SYNC_SLOT_WAKE_UP_MARGIN_IN_US,
+                                   0 );
+}
+
+static void time_sync_send_slot_frame( void* timer_context )
+{
+    memset( buffer, 0, PAYLOAD_LENGTH );
+    buffer[0] = TIME_SYNC_SLOT_FRAME_MAGIC;
+    buffer[1] = slot_frame_seq++;
+    buffer[2] = ( is_last_slot_frame_valid == true ) ? TIME_SYNC_SLOT_FRAME_FLAG_PREVIOUS_VALID : 0;
+    buffer[3] = ( uint8_t ) ( last_slot_frame_end_of_packet_in_us );
+    buffer[4] = ( uint8_t ) ( last_slot_frame_end_of_packet_in_us >> 8 );
+    buffer[5] = ( uint8_t ) ( last_slot_frame_end_of_packet_in_us >> 16 );
+    buffer[6] = ( uint8_t ) ( last_slot_frame_end_of_packet_in_us >> 24 );
+    is_last_slot_frame_valid = false;
+
+    apps_radio_write_payload( &radio, buffer, PAYLOAD_LENGTH );
+
+    const int32_t late_in_us = ( int32_t ) ( smtc_hal_mcu_timer_get_time_in_us( ) - slot_start_in_us );
+
+    while( ( int32_t ) ( smtc_hal_mcu_timer_get_time_in_us( ) - slot_start_in_us ) < 0 )
+    {
+    }
+
+    apps_radio_set_tx( &radio, 0 );
+
+    // Traced once the transmission has started, not to delay it
+    if( late_in_us > 0 )
+    {
+        HAL_DBG_TRACE_WARNING( "Slot start missed by %d us\n", ( int ) late_in_us );
+    }
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -1,10 +1,10 @@
 /*!
- * @file      curve_plot.h
+ * @file      main_time_sync.h
  *
- * @brief     Curve_plot functions used in Spectrum_display example for SX126x chip
+ * @brief     Time synchronisation example for LR11xx and SX126x chips
  *
  * The Clear BSD License
- * Copyright Semtech Corporation 2022. All rights reserved.
+ * Copyright Semtech Corporation 2024. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted (subject to the limitations in the disclaimer
@@ -32,8 +32,8 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef CURVE_PLOT_H
-#define CURVE_PLOT_H
+#ifndef MAIN_TIME_SYNC_H
+#define MAIN_TIME_SYNC_H
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,12 +43,37 @@ extern "C" {
  * -----------------------------------------------------------------------------
  * --- DEPENDENCIES ------------------------------------------------------------
  */
-
+#include "apps_common.h"
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC MACROS -----------------------------------------------------------
  */
 
+/**
+ * @brief Beacon period, which is also the TDMA superframe duration
+ *
+ * Expressed in milliseconds
+ */
+#ifndef TIME_SYNC_SUPERFRAME_IN_MS
+#define TIME_SYNC_SUPERFRAME_IN_MS 10000
+#endif
+
+/**
+ * @brief Start of the follower slot, counted from the on-air end of the beacon
+ *
+ * Expressed in milliseconds
+ */
+#ifndef TIME_SYNC_SLOT_OFFSET_IN_MS
+#define TIME_SYNC_SLOT_OFFSET_IN_MS 5000
+#endif
+
+/**
+ * @brief Number of superframes without a beacon after which a node stops searching and becomes the reference
+ */
+#ifndef TIME_SYNC_SEARCH_NB_SUPERFRAMES
+#define TIME_SYNC_SEARCH_NB_SUPERFRAMES 3
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC CONSTANTS --------------------------------------------------------
@@ -64,26 +89,10 @@ extern "C" {
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
  */
 
-/*!
- * @brief Interface to plot dynamic curve for spectral scan result
- *
- * @param [in] column Offset of column from home position of the canvas.
- * @param [in] row Offset of column from home position of the canvas.
- *
- */
-void plot_curve( uint8_t column, uint8_t row );
-
-/*!
- * @brief Interface to create canvas space for curve ploting
- *
- * @warning This function must be called to create space for ploting and set the home position for plot_curve function.
- */
-void create_canvas( void );
-
 #ifdef __cplusplus
 }
 #endif
 
-#endif  // CURVE_PLOT_H
+#endif  // MAIN_TIME_SYNC_H
 
 /* --- EOF ------------------------------------------------------------------ */
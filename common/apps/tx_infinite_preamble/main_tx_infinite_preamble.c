@@ -1,7 +1,7 @@
 /*!
  * @file      main_tx_infinite_preamble.c
  *
- * @brief     Example of the transmission of an infinite preamble for SX126x chip
+ * @brief     Example of the transmission of an infinite preamble for LR11xx and SX126x chips
  *
  * The Clear BSD License
  * Copyright Semtech Corporation 2022. All rights reserved.
@@ -41,9 +41,7 @@
 #include <string.h>
 
 #include "apps_common.h"
-#include "apps_utilities.h"
-#include "sx126x.h"
-#include "smtc_hal_mcu.h"
+#include "apps_radio.h"
 #include "smtc_hal_dbg_trace.h"
 #include "uart_init.h"
 
@@ -67,7 +65,7 @@
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-static sx126x_hal_context_t* context;
+static apps_radio_t radio;
 
 /*
  * -----------------------------------------------------------------------------
@@ -84,22 +82,21 @@ static sx126x_hal_context_t* context;
  */
 int main( void )
 {
-    smtc_hal_mcu_init( );
-    uart_init();
-
-    HAL_DBG_TRACE_INFO( "===== SX126x TX infinite preamble example =====\n\n" );
-    apps_common_sx126x_print_version_info( );
+    const radio_registry_binding_t binding = RADIO_REGISTRY_BINDING_ARDUINO;
 
+    smtc_hal_mcu_init( );
     apps_common_shield_init( );
-    context = apps_common_sx126x_get_context( );
+    uart_init( );
 
-    apps_common_sx126x_init( ( void* ) context );
-    apps_common_sx126x_radio_init( ( void* ) context );
+    HAL_DBG_TRACE_INFO( "===== " APPS_RADIO_CHIP_NAME " TX infinite preamble example =====\n\n" );
+    apps_radio_open( &radio, APPS_RADIO_CHIP_OPS, 0, &binding );
+    apps_radio_print_version( &radio );
 
-    apps_common_sx126x_handle_pre_tx( );
-    ASSERT_SX126X_RC( sx126x_set_tx_infinite_preamble( context ) );
+    apps_radio_init( &radio );
+    apps_radio_set_tx_infinite_preamble( &radio );
 
     while( 1 )
     {
+        apps_radio_wait_for_event( &radio );
     }
 }
@@ -0,0 +1,188 @@
+/*!
+ * @file      apps_cad_scan.h
+ *
+ * @brief     Multi-channel CAD scanner: chained CADs over a channel list, per-channel occupancy and quietest channel
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef APPS_CAD_SCAN_H
+#define APPS_CAD_SCAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "apps_radio.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*!
+ * @brief Largest number of channels in a scan
+ */
+#ifndef APPS_CAD_SCAN_NB_CHANNELS_MAX
+#define APPS_CAD_SCAN_NB_CHANNELS_MAX 16
+#endif
+
+/*!
+ * @brief Weight of the last CAD in the occupancy of a channel, as a power of two: 3 averages over about 8 CADs
+ */
+#ifndef APPS_CAD_SCAN_OCCUPANCY_SHIFT
+#define APPS_CAD_SCAN_OCCUPANCY_SHIFT 3
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * @brief Interrupts to give to apps_cad_scan_on_radio_irq
+ */
+#define APPS_CAD_SCAN_IRQ_MASK ( APPS_RADIO_IRQ_CAD_DONE | APPS_RADIO_IRQ_CAD_DETECTED )
+
+/*!
+ * @brief Full scale of apps_cad_scan_channel_t.occupancy, reached by a channel found busy at every CAD
+ */
+#define APPS_CAD_SCAN_OCCUPANCY_ONE ( 1u << 15 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * @brief Statistics of a scanned channel
+ */
+typedef struct apps_cad_scan_channel_s
+{
+    uint32_t freq_in_hz;
+    uint32_t nb_cad;               //!< Number of CADs run on the channel
+    uint32_t nb_detected;          //!< Number of CADs which detected LoRa activity
+    uint16_t occupancy;            //!< Exponential average of the detections, see APPS_CAD_SCAN_OCCUPANCY_ONE
+    uint32_t scan_time_min_in_us;  //!< Shortest time from the retune to the end of the CAD
+    uint32_t scan_time_max_in_us;  //!< Longest time from the retune to the end of the CAD
+    uint64_t scan_time_sum_in_us;
+} apps_cad_scan_channel_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * @brief Set the channels to scan and clear their statistics
+ *
+ * @remark The radio is expected to be in standby, configured for LoRa with the modulation to detect, and to route
+ * APPS_CAD_SCAN_IRQ_MASK to its DIO line
+ *
+ * @param [in] radio  Radio running the CADs
+ * @param [in] freqs_in_hz  Channel frequencies, scanned in this order
+ * @param [in] nb_channels  Number of channels, at most APPS_CAD_SCAN_NB_CHANNELS_MAX
+ * @param [in] cad_params  CAD parameters, with the detection peak tuned for the modulation - the exit mode is forced to
+ * standby
+ *
+ * @returns false if a parameter is out of range
+ */
+bool apps_cad_scan_init( const apps_radio_t* radio, const uint32_t* freqs_in_hz, uint8_t nb_channels,
+                         const apps_radio_cad_params_t* cad_params );
+
+/*!
+ * @brief Start scanning: each CAD is started from the CAD_DONE interrupt of the previous one
+ *
+ * @param [in] nb_sweeps  Number of passes over the channel list, 0 to scan until apps_cad_scan_stop
+ */
+void apps_cad_scan_start( uint32_t nb_sweeps );
+
+/*!
+ * @brief Stop scanning once the CAD in progress is done
+ */
+void apps_cad_scan_stop( void );
+
+/*!
+ * @brief Check whether a scan is in progress
+ */
+bool apps_cad_scan_is_running( void );
+
+/*!
+ * @brief Interrupt callback to give to apps_radio_irq_process with APPS_CAD_SCAN_IRQ_MASK while a scan is running
+ *
+ * @param [in] radio  Radio that raised the interrupts
+ * @param [in] irq  Interrupts raised
+ */
+void apps_cad_scan_on_radio_irq( const apps_radio_t* radio, apps_radio_irq_mask_t irq );
+
+/*!
+ * @brief Pick the channel to talk on
+ *
+ * The quietest channel has the lowest occupancy, then the lowest share of busy CADs since the statistics were
+ * cleared. Remaining ties go to the channel listed first.
+ *
+ * @param [out] channel_index  Index of the quietest channel in the list given to apps_cad_scan_init
+ *
+ * @returns false if no channel has been scanned yet
+ */
+bool apps_cad_scan_get_quietest_channel( uint8_t* channel_index );
+
+/*!
+ * @brief Get the statistics of a channel
+ *
+ * @param [in] channel_index  Index of the channel in the list given to apps_cad_scan_init
+ *
+ * @returns The statistics, NULL if the index is out of range
+ */
+const apps_cad_scan_channel_t* apps_cad_scan_get_channel( uint8_t channel_index );
+
+/*!
+ * @brief Clear the statistics of all the channels, keeping the channel list
+ */
+void apps_cad_scan_reset_stats( void );
+
+/*!
+ * @brief Print the scan rate, the statistics of each channel and the quietest channel
+ */
+void apps_cad_scan_print( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // APPS_CAD_SCAN_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,196 @@
+/*!
+ * @file      apps_cad_tuner.h
+ *
+ * @brief     Adaptive CAD tuning: detection peak and symbol count learned from false alarms and misses
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef APPS_CAD_TUNER_H
+#define APPS_CAD_TUNER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "apps_radio_types.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*!
+ * @brief Number of CADs a setting is evaluated over before the tuner moves
+ */
+#ifndef APPS_CAD_TUNER_EPOCH_NB_CAD
+#define APPS_CAD_TUNER_EPOCH_NB_CAD 100
+#endif
+
+/*!
+ * @brief One CAD without detection in this many is followed by an audit reception, to count the missed packets
+ */
+#ifndef APPS_CAD_TUNER_AUDIT_PERIOD
+#define APPS_CAD_TUNER_AUDIT_PERIOD 8
+#endif
+
+/*!
+ * @brief Length of an audit reception, in symbols: long enough for a 12-symbol preamble, the sync word and an
+ * explicit header
+ */
+#ifndef APPS_CAD_TUNER_AUDIT_WINDOW_IN_SYMB
+#define APPS_CAD_TUNER_AUDIT_WINDOW_IN_SYMB 25
+#endif
+
+/*!
+ * @brief Step of the detection peak
+ */
+#ifndef APPS_CAD_TUNER_PEAK_STEP
+#define APPS_CAD_TUNER_PEAK_STEP 2
+#endif
+
+/*!
+ * @brief Share of audits which caught a packet above which the CAD is made more sensitive, in per mille
+ */
+#ifndef APPS_CAD_TUNER_MISS_RATE_MAX
+#define APPS_CAD_TUNER_MISS_RATE_MAX 50
+#endif
+
+/*!
+ * @brief Share of CADs detecting activity without a valid header above which the CAD is made less sensitive, in per
+ * mille
+ */
+#ifndef APPS_CAD_TUNER_FALSE_ALARM_RATE_MAX
+#define APPS_CAD_TUNER_FALSE_ALARM_RATE_MAX 20
+#endif
+
+/*!
+ * @brief Number of channels whose learned setting is kept in flash
+ */
+#ifndef APPS_CAD_TUNER_NB_CHANNELS_MAX
+#define APPS_CAD_TUNER_NB_CHANNELS_MAX 16
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * @brief Range the tuner may move the CAD parameters in
+ */
+typedef struct apps_cad_tuner_bounds_s
+{
+    uint8_t detect_peak_min;
+    uint8_t detect_peak_max;
+    uint8_t nb_symbols_min;  //!< Power of two
+    uint8_t nb_symbols_max;  //!< Power of two
+} apps_cad_tuner_bounds_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * @brief Start tuning the CAD of a channel
+ *
+ * The setting learned for this channel and modulation is restored from the key-value store if there is one, otherwise
+ * tuning starts from default_params.
+ *
+ * @param [in] freq_in_hz  Channel frequency
+ * @param [in] sf  LoRa spreading factor
+ * @param [in] bw  LoRa bandwidth
+ * @param [in] default_params  CAD parameters to start from, typically tuned for the modulation by a look-up table
+ * @param [in] bounds  Range of the detection peak and of the number of symbols
+ */
+void apps_cad_tuner_init( uint32_t freq_in_hz, apps_radio_lora_sf_t sf, apps_radio_lora_bw_t bw,
+                          const apps_radio_cad_params_t* default_params, const apps_cad_tuner_bounds_t* bounds );
+
+/*!
+ * @brief Get the CAD parameters to use for the next CAD
+ *
+ * @param [in, out] params  CAD parameters: the number of symbols and the detection peak are updated
+ *
+ * @returns true if they changed since the previous call, in which case they have to be written to the radio
+ */
+bool apps_cad_tuner_get_params( apps_radio_cad_params_t* params );
+
+/*!
+ * @brief Record the result of a CAD
+ *
+ * @remark With a detection, the application is expected to receive and call apps_cad_tuner_on_rx_end
+ *
+ * @param [in] is_detected  true if LoRa activity was detected
+ * @param [in] cad_time_in_us  Duration of the CAD
+ *
+ * @returns 0, or the length in milliseconds of the audit reception the application has to run after this CAD without
+ * detection, then report with apps_cad_tuner_on_rx_end
+ */
+uint32_t apps_cad_tuner_on_cad_done( bool is_detected, uint32_t cad_time_in_us );
+
+/*!
+ * @brief Record the end of the reception following a detection or an audit
+ *
+ * @param [in] is_header_valid  true if a packet was received, even with a CRC error
+ * @param [in] rx_time_in_us  Duration of the reception
+ */
+void apps_cad_tuner_on_rx_end( bool is_header_valid, uint32_t rx_time_in_us );
+
+/*!
+ * @brief Forget the settings learned for all channels
+ *
+ * @returns false if the key-value store could not be updated
+ */
+bool apps_cad_tuner_clear( void );
+
+/*!
+ * @brief Print the current setting, the counters of the epoch in progress and the tuning history
+ */
+void apps_cad_tuner_print( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // APPS_CAD_TUNER_H
+
+/* --- EOF ------------------------------------------------------------------ */
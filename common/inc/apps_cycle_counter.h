@@ -1,10 +1,10 @@
 /*!
- * @file      main_sigfox.h
+ * @file      apps_cycle_counter.h
  *
- * @brief     Sigfox PHY example for SX126X chip
+ * @brief     Cortex-M cycle counter used to time the sample code
  *
  * The Clear BSD License
- * Copyright Semtech Corporation 2023. All rights reserved.
+ * Copyright Semtech Corporation 2024. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted (subject to the limitations in the disclaimer
@@ -32,8 +32,8 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef MAIN_SIGFOX_H
-#define MAIN_SIGFOX_H
+#ifndef APPS_CYCLE_COUNTER_H
+#define APPS_CYCLE_COUNTER_H
 
 #ifdef __cplusplus
 extern "C" {
@@ -44,18 +44,13 @@ extern "C" {
  * --- DEPENDENCIES ------------------------------------------------------------
  */
 
+#include <stdint.h>
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC MACROS -----------------------------------------------------------
  */
 
-/*!
- *  @brief Delay in ms between the end of a transmision and the beginning of the next one
- */
-#ifndef TX_TO_TX_DELAY_IN_MS
-#define TX_TO_TX_DELAY_IN_MS 200
-#endif
-
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC CONSTANTS --------------------------------------------------------
@@ -71,10 +66,32 @@ extern "C" {
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
  */
 
+/*!
+ * @brief Get the current value of the Cortex-M cycle counter, enabling it on first use
+ *
+ * @remark The counter wraps around every 2^32 core cycles (about 53 s at 80 MHz)
+ *
+ * @remark The counter is clocked by the core and stops in STOP2, so a span including a STOP2 period is undercounted by
+ * the time spent in STOP2. Such spans are measured with smtc_hal_mcu_timer_get_time_in_us, which the low-power
+ * manager compensates for the time spent in STOP2.
+ *
+ * @returns Cycle counter value
+ */
+uint32_t apps_common_cycle_counter_get( void );
+
+/*!
+ * @brief Convert a number of core cycles to microseconds
+ *
+ * @param [in] cycles  Number of core cycles
+ *
+ * @returns Duration in microseconds
+ */
+uint32_t apps_common_cycle_counter_to_us( uint32_t cycles );
+
 #ifdef __cplusplus
 }
 #endif
 
-#endif  // MAIN_SIGFOX_H
+#endif  // APPS_CYCLE_COUNTER_H
 
 /* --- EOF ------------------------------------------------------------------ */
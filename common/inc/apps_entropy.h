@@ -0,0 +1,142 @@
+/*!
+ * @file      apps_entropy.h
+ *
+ * @brief     Entropy pool shared by the applications: MCU and radio random number generators behind a DRBG
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef APPS_ENTROPY_H
+#define APPS_ENTROPY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Number of 32-bit words read from the radio random number generator per harvest
+ */
+#define APPS_ENTROPY_RADIO_HARVEST_NB_WORDS 8
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Seed the pool from the MCU random number generator, personalised with the MCU unique ID
+ *
+ * @retval true The pool is seeded with full entropy
+ * @retval false The MCU random number generator failed: the pool only becomes unpredictable once
+ * apps_entropy_add_radio_words has been called
+ */
+bool apps_entropy_init( void );
+
+/**
+ * @brief Mix a batch read from the radio random number generator into the pool, with as many fresh MCU random bytes
+ *
+ * @remark The batch is discarded if two consecutive words are equal: a radio that is not actually receiving returns
+ * a constant
+ *
+ * @param [in] words Words read from the radio
+ * @param [in] nb_words Number of words
+ * @param [in] harvest_time_in_us Time taken to read them, reported by apps_entropy_print_stats
+ *
+ * @retval true The batch has been mixed in
+ * @retval false The batch failed the health check
+ */
+bool apps_entropy_add_radio_words( const uint32_t* words, unsigned int nb_words, uint32_t harvest_time_in_us );
+
+/**
+ * @brief Reseed the pool from the MCU random number generator when it has served enough output since the last reseed
+ *
+ * @remark To be called from the application main loop, it never touches the radio
+ */
+void apps_entropy_process( void );
+
+/**
+ * @brief Get random bytes, served from RAM
+ *
+ * @param [out] buffer Output buffer
+ * @param [in] length Number of bytes
+ *
+ * @retval true The buffer has been filled
+ * @retval false The pool is not initialised
+ */
+bool apps_entropy_get_bytes( uint8_t* buffer, unsigned int length );
+
+/**
+ * @brief Get a uniformly distributed random integer in [0, range)
+ *
+ * @param [in] range Number of possible values - 0 gives a full 32-bit random number
+ *
+ * @returns The random integer
+ */
+uint32_t apps_entropy_get_range( uint32_t range );
+
+/**
+ * @brief Print the pool statistics and the cost of each entropy source
+ */
+void apps_entropy_print_stats( void );
+
+/**
+ * @brief Measure the bytes per second served by the pool for several request sizes, and by the MCU generator alone
+ */
+void apps_entropy_benchmark( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // APPS_ENTROPY_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,114 @@
+/*!
+ * @file      apps_kv_store.h
+ *
+ * @brief     Persistent key-value store shared by the applications
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef APPS_KV_STORE_H
+#define APPS_KV_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "smtc_kv_store.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Keys of the records kept in the store, allocated here so that applications do not collide
+ */
+typedef enum apps_kv_store_key_e
+{
+    APPS_KV_STORE_KEY_AT_PARAMETERS = 0x0001,  //!< ATC_M_* parameters saved with AT+SAVE
+    APPS_KV_STORE_KEY_CAD_TUNING    = 0x0002,  //!< CAD settings learned per channel by apps_cad_tuner
+} apps_kv_store_key_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Mount the store on the flash area reserved by the linker script, formatting it on first use
+ *
+ * @retval true The store is ready
+ * @retval false The store is not available, apps_kv_store_get returns NULL
+ */
+bool apps_kv_store_init( void );
+
+/**
+ * @brief Get the store
+ *
+ * @returns Pointer to the store, NULL if apps_kv_store_init has not succeeded
+ */
+smtc_kv_store_t* apps_kv_store_get( void );
+
+/**
+ * @brief Run one step of background compaction, to be called from the application main loop
+ *
+ * @retval true Some work has been done, the caller should not go to sleep
+ * @retval false Nothing to do
+ */
+bool apps_kv_store_process( void );
+
+/**
+ * @brief Print the store statistics: usage, write amplification and wear
+ */
+void apps_kv_store_print_stats( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // APPS_KV_STORE_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,138 @@
+/*!
+ * @file      apps_occupancy_recorder.h
+ *
+ * @brief     Long-term spectrum occupancy recorder: spectral sweep histograms stored in flash
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef APPS_OCCUPANCY_RECORDER_H
+#define APPS_OCCUPANCY_RECORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "apps_spectral_sweep.h"
+#include "smtc_occupancy_log.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*!
+ * @brief Largest number of channels whose histograms are accumulated between two records
+ */
+#ifndef APPS_OCCUPANCY_RECORDER_NB_CHANNELS_MAX
+#define APPS_OCCUPANCY_RECORDER_NB_CHANNELS_MAX 64
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * @brief Longest record period: the period of a software timer is limited to about 71 minutes
+ */
+#define APPS_OCCUPANCY_RECORDER_RECORD_PERIOD_MAX_IN_S 3600
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * @brief Mount the occupancy log on the flash area reserved by the linker script and start recording
+ *
+ * The histograms of the channel frames given to apps_occupancy_recorder_add_channel are accumulated, and written to
+ * flash as one record every plan->record_period_in_s seconds. The time of the records restarts from 0 at each boot, a
+ * new session number telling them apart.
+ *
+ * @remark Writing a record takes a few milliseconds, and up to about 25 ms more when a flash page has to be erased: the
+ * CPU is stalled meanwhile, so the sweep sample in progress is taken late.
+ *
+ * @param [in] plan  Channel plan and histogram layout, matching the sweep configuration
+ *
+ * @returns false if the plan is not valid or the flash area cannot be used
+ */
+bool apps_occupancy_recorder_init( const smtc_occupancy_log_plan_t* plan );
+
+/*!
+ * @brief Accumulate the histogram of a channel
+ *
+ * @remark Sweep frames are ignored. A count about to overflow halves the counts of its channel, which keeps the
+ * proportions the levels are computed from.
+ *
+ * @param [in] frame  Channel frame of the spectral sweep engine
+ */
+void apps_occupancy_recorder_add_channel( const apps_spectral_sweep_frame_channel_t* frame );
+
+/*!
+ * @brief Print the number of records, the compression ratio and the time span kept in flash
+ */
+void apps_occupancy_recorder_print_stats( void );
+
+/*!
+ * @brief Send the content of the log on the trace UART
+ *
+ * A text line gives the number of bytes following it, then the used part of each page is sent in binary, oldest first.
+ * The bytes are decoded by libs/smtc_occupancy_log/host/smtc_occupancy_log_decode.
+ *
+ * @returns false if the recorder is not running
+ */
+bool apps_occupancy_recorder_dump( void );
+
+/*!
+ * @brief Erase all records
+ *
+ * @returns false if the recorder is not running or the flash could not be erased
+ */
+bool apps_occupancy_recorder_clear( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // APPS_OCCUPANCY_RECORDER_H
+
+/* --- EOF ------------------------------------------------------------------ */
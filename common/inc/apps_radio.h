@@ -0,0 +1,550 @@
+/*!
+ * @file      apps_radio.h
+ *
+ * @brief     Chip-agnostic radio API shared by the LR11xx and SX126x applications
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef APPS_RADIO_H
+#define APPS_RADIO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "apps_radio_types.h"
+#include "apps_radio_chip.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*!
+ * @brief Resolve an operation of a radio
+ *
+ * When a single chip is linked, apps_radio_chip.h of that chip defines APPS_RADIO_CHIP_OP and every call below is
+ * bound at compile time to the inline adapter: the function table is not read and the call costs the same as the
+ * driver call it wraps. A build linking several chips leaves APPS_RADIO_CHIP_OP undefined and the calls go through the
+ * function table of the radio.
+ */
+#if defined( APPS_RADIO_CHIP_OP )
+#define APPS_RADIO_OP( radio, op ) APPS_RADIO_CHIP_OP( op )
+#else
+#define APPS_RADIO_OP( radio, op ) ( ( radio )->ops->op )
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * @brief Cycles spent in the calls of one path of apps_radio_print_call_benchmark
+ */
+typedef struct apps_radio_call_benchmark_s
+{
+    uint32_t nb_calls;
+    uint32_t min_in_cycles;
+    uint32_t sum_in_cycles;
+} apps_radio_call_benchmark_t;
+
+/*!
+ * @brief RX_DONE DIO edge to payload in RAM latency of a receive path
+ */
+typedef struct apps_radio_rx_latency_stats_s
+{
+    uint32_t nb_packets;
+    uint32_t min_in_cycles;
+    uint32_t max_in_cycles;
+    uint64_t sum_in_cycles;
+} apps_radio_rx_latency_stats_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * @brief Bind a radio to its adapter and get its HAL context
+ *
+ * @param [out] radio  Radio to initialize
+ * @param [in] ops  Adapter of the chip - APPS_RADIO_CHIP_OPS in single-chip builds
+ * @param [in] radio_id  Index of the radio in the registry
+ * @param [in] binding  MCU resources the radio is wired to
+ */
+void apps_radio_open( apps_radio_t* radio, const apps_radio_ops_t* ops, uint8_t radio_id,
+                      const radio_registry_binding_t* binding );
+
+/*!
+ * @brief Process the DIO events waiting for a radio
+ *
+ * @param [in] radio  Radio
+ * @param [in] irq_filter_mask  Interrupts to be given to the callback
+ * @param [in] callback  Application callback, called once per DIO event with the interrupts raised
+ */
+void apps_radio_irq_process( const apps_radio_t* radio, apps_radio_irq_mask_t irq_filter_mask,
+                             apps_radio_irq_callback_t callback );
+
+/*!
+ * @brief Same as apps_radio_irq_process, without the trace of the raised interrupts
+ *
+ * @remark For the loops that must not print anything per packet, like latency benchmarks
+ *
+ * @param [in] radio  Radio
+ * @param [in] irq_filter_mask  Interrupts to be given to the callback
+ * @param [in] callback  Application callback, called once per DIO event with the interrupts raised
+ */
+void apps_radio_irq_process_quiet( const apps_radio_t* radio, apps_radio_irq_mask_t irq_filter_mask,
+                                   apps_radio_irq_callback_t callback );
+
+/*!
+ * @brief Account for one call timed by a chip adapter for apps_radio_print_call_benchmark
+ *
+ * @param [in, out] result  Results of the path, zero-initialized before the first call
+ * @param [in] cycles  Duration of the call
+ */
+void apps_radio_call_benchmark_record( apps_radio_call_benchmark_t* result, uint32_t cycles );
+
+/*!
+ * @brief Print the results of one path of apps_radio_print_call_benchmark
+ *
+ * @param [in] name  Name of the path
+ * @param [in] result  Results of the path
+ */
+void apps_radio_call_benchmark_print( const char* name, const apps_radio_call_benchmark_t* result );
+
+/*!
+ * @brief Account for the RX_DONE to payload latency of one packet
+ *
+ * @param [in, out] stats  Statistics of the receive path, zero-initialized before the first packet
+ * @param [in] latency_in_cycles  Latency of the packet
+ */
+void apps_radio_rx_latency_record( apps_radio_rx_latency_stats_t* stats, uint32_t latency_in_cycles );
+
+/*!
+ * @brief Print the RX_DONE to payload latency of one receive path, if it has been used
+ *
+ * @param [in] name  Name of the receive path
+ * @param [in] stats  Statistics of the receive path
+ */
+void apps_radio_rx_latency_print( const char* name, const apps_radio_rx_latency_stats_t* stats );
+
+/*!
+ * @brief Get the time of the DIO edge of the event being dispatched by apps_radio_irq_process
+ *
+ * The edge is stamped with the cycle counter in the EXTI interrupt handler and moved to the timebase of
+ * smtc_hal_mcu_timer_get_time_in_us when the event is dispatched.
+ *
+ * @remark Only meaningful in the callback called by apps_radio_irq_process
+ *
+ * @returns DIO edge timestamp, in microseconds
+ */
+uint32_t apps_radio_get_irq_timestamp_in_us( void );
+
+/*!
+ * @brief Get the cycle counter value at the DIO edge of the event being dispatched by apps_radio_irq_process
+ *
+ * @remark Only meaningful in the callback called by apps_radio_irq_process
+ *
+ * @returns DIO edge timestamp, in cycles
+ */
+uint32_t apps_radio_get_irq_timestamp_in_cycles( void );
+
+/*!
+ * @brief Print the firmware and driver versions of the chip
+ */
+static inline void apps_radio_print_version( const apps_radio_t* radio )
+{
+    APPS_RADIO_OP( radio, print_version )( );
+}
+
+/*!
+ * @brief Reset the chip and apply the radio configuration of apps_configuration.h and of the AT commands
+ */
+static inline void apps_radio_init( const apps_radio_t* radio )
+{
+    APPS_RADIO_OP( radio, init )( radio->context );
+}
+
+/*!
+ * @brief Reset the chip and configure it to send DBPSK frames of a given length, as used by Sigfox uplinks
+ *
+ * @param [in] radio  Radio
+ * @param [in] payload_length  Length of the frame before DBPSK encoding, in bytes
+ */
+static inline void apps_radio_init_dbpsk( const apps_radio_t* radio, uint8_t payload_length )
+{
+    APPS_RADIO_OP( radio, init_dbpsk )( radio->context, payload_length );
+}
+
+/*!
+ * @brief Apply the radio parameters changed by AT commands since apps_radio_init
+ *
+ * @remark Must be called while the radio is in standby, typically from a TX / RX done handler before the next packet
+ * is started
+ *
+ * @returns true if the LoRa modulation parameters changed, so the time on air has to be computed again
+ */
+static inline bool apps_radio_reconfigure( const apps_radio_t* radio )
+{
+    return APPS_RADIO_OP( radio, reconfigure )( radio->context );
+}
+
+/*!
+ * @brief Tell whether the radio is configured for LoRa by apps_configuration.h, or for GFSK
+ */
+static inline bool apps_radio_is_lora_pkt_type( const apps_radio_t* radio )
+{
+    return APPS_RADIO_OP( radio, is_lora_pkt_type )( );
+}
+
+/*!
+ * @brief Set the RF frequency
+ */
+static inline void apps_radio_set_rf_freq( const apps_radio_t* radio, uint32_t freq_in_hz )
+{
+    APPS_RADIO_OP( radio, set_rf_freq )( radio->context, freq_in_hz );
+}
+
+/*!
+ * @brief Start the frequency synthesizer, to have the PLL locked before the next operation
+ */
+static inline void apps_radio_set_fs( const apps_radio_t* radio )
+{
+    APPS_RADIO_OP( radio, set_fs )( radio->context );
+}
+
+/*!
+ * @brief Set the LoRa modulation and packet parameters
+ *
+ * @remark The packet type is expected to be LoRa already
+ */
+static inline void apps_radio_set_lora_params( const apps_radio_t* radio, const apps_radio_lora_params_t* params )
+{
+    APPS_RADIO_OP( radio, set_lora_params )( radio->context, params );
+}
+
+/*!
+ * @brief Route the interrupts to the DIO line and clear the pending ones
+ */
+static inline void apps_radio_set_irq_mask( const apps_radio_t* radio, apps_radio_irq_mask_t irq_mask )
+{
+    APPS_RADIO_OP( radio, set_irq_mask )( radio->context, irq_mask );
+}
+
+/*!
+ * @brief Write the payload of the next transmission at the start of the radio buffer
+ */
+static inline void apps_radio_write_payload( const apps_radio_t* radio, const uint8_t* buffer, uint8_t length )
+{
+    APPS_RADIO_OP( radio, write_payload )( radio->context, buffer, length );
+}
+
+/*!
+ * @brief Read the payload of the last packet received
+ *
+ * @returns The payload length, 0 if it does not fit in max_length bytes
+ */
+static inline uint8_t apps_radio_read_payload( const apps_radio_t* radio, uint8_t* buffer, uint8_t max_length )
+{
+    return APPS_RADIO_OP( radio, read_payload )( radio->context, buffer, max_length );
+}
+
+/*!
+ * @brief Read the first bytes of the payload of the last packet received, leaving the radio as it is
+ *
+ * @remark For the receivers which only need a header of the payload, e.g. a sequence number in continuous reception
+ *
+ * @returns The payload length - buffer is only filled if it is at least length bytes
+ */
+static inline uint8_t apps_radio_read_payload_head( const apps_radio_t* radio, uint8_t* buffer, uint8_t length )
+{
+    return APPS_RADIO_OP( radio, read_payload_head )( radio->context, buffer, length );
+}
+
+/*!
+ * @brief Get the status of the last LoRa packet received
+ *
+ * @returns false if the radio is not configured for LoRa
+ */
+static inline bool apps_radio_get_lora_pkt_status( const apps_radio_t*           radio,
+                                                   apps_radio_lora_pkt_status_t* pkt_status )
+{
+    return APPS_RADIO_OP( radio, get_lora_pkt_status )( radio->context, pkt_status );
+}
+
+/*!
+ * @brief Get the status of the last GFSK packet received
+ *
+ * @returns false if the radio is not configured for GFSK
+ */
+static inline bool apps_radio_get_gfsk_pkt_status( const apps_radio_t*           radio,
+                                                   apps_radio_gfsk_pkt_status_t* pkt_status )
+{
+    return APPS_RADIO_OP( radio, get_gfsk_pkt_status )( radio->context, pkt_status );
+}
+
+/*!
+ * @brief Read the packet that raised RX_DONE with the shortest command sequence, then re-arm the reception
+ *
+ * The RX buffer status, the packet status and the payload are read back to back, without traces in between, and the
+ * reception is re-armed right after. The RX LED is lit again if the reception is re-armed.
+ *
+ * @remark To be called from the callback of apps_radio_irq_process, with rx_done_in_cycles set by the caller
+ *
+ * @param [in] radio  Radio
+ * @param [in] rx_restart_timeout_in_ms  Timeout to re-arm the reception with, or APPS_RADIO_RX_RESTART_NONE to leave
+ * the radio in standby
+ * @param [in, out] packet  Packet - the payload, its length, the packet status and latency_in_cycles are filled
+ *
+ * @returns false if the payload is longer than APPS_RADIO_RX_PACKET_MAX_LENGTH
+ */
+static inline bool apps_radio_receive_packet( const apps_radio_t* radio, uint32_t rx_restart_timeout_in_ms,
+                                              apps_radio_rx_packet_t* packet )
+{
+    return APPS_RADIO_OP( radio, receive_packet )( radio->context, rx_restart_timeout_in_ms, packet );
+}
+
+/*!
+ * @brief Transmit the payload of the radio buffer - 0 disables the timeout
+ */
+static inline void apps_radio_set_tx( const apps_radio_t* radio, uint32_t timeout_in_ms )
+{
+    APPS_RADIO_OP( radio, set_tx )( radio->context, timeout_in_ms );
+}
+
+/*!
+ * @brief Transmit a continuous wave
+ */
+static inline void apps_radio_set_tx_cw( const apps_radio_t* radio )
+{
+    APPS_RADIO_OP( radio, set_tx_cw )( radio->context );
+}
+
+/*!
+ * @brief Put the radio in standby, ending any transmission or reception
+ *
+ * @remark The TX and RX LEDs are switched off
+ */
+static inline void apps_radio_set_standby( const apps_radio_t* radio, apps_radio_standby_cfg_t cfg )
+{
+    APPS_RADIO_OP( radio, set_standby )( radio->context, cfg );
+}
+
+/*!
+ * @brief Transmit an infinite preamble
+ */
+static inline void apps_radio_set_tx_infinite_preamble( const apps_radio_t* radio )
+{
+    APPS_RADIO_OP( radio, set_tx_infinite_preamble )( radio->context );
+}
+
+/*!
+ * @brief Start a reception - 0 makes it single without timeout
+ */
+static inline void apps_radio_set_rx( const apps_radio_t* radio, uint32_t timeout_in_ms )
+{
+    APPS_RADIO_OP( radio, set_rx )( radio->context, timeout_in_ms );
+}
+
+/*!
+ * @brief Start a continuous reception, which lasts until the next mode change
+ */
+static inline void apps_radio_set_rx_continuous( const apps_radio_t* radio )
+{
+    APPS_RADIO_OP( radio, set_rx_continuous )( radio->context );
+}
+
+/*!
+ * @brief Get the instantaneous RSSI, in dBm
+ *
+ * @remark Only meaningful in reception
+ */
+static inline int16_t apps_radio_get_rssi_inst( const apps_radio_t* radio )
+{
+    return APPS_RADIO_OP( radio, get_rssi_inst )( radio->context );
+}
+
+/*!
+ * @brief Start a LoRa channel activity detection
+ */
+static inline void apps_radio_start_cad( const apps_radio_t* radio, const apps_radio_cad_params_t* params )
+{
+    APPS_RADIO_OP( radio, start_cad )( radio->context, params );
+}
+
+/*!
+ * @brief Start a LoRa channel activity detection with the parameters of the last apps_radio_start_cad call
+ *
+ * @remark Saves the parameters transfer when CADs are chained with the same settings
+ */
+static inline void apps_radio_restart_cad( const apps_radio_t* radio )
+{
+    APPS_RADIO_OP( radio, restart_cad )( radio->context );
+}
+
+/*!
+ * @brief Replace the detection settings of CAD parameters by the best ones measured on the chip for a modulation
+ *
+ * @remark The settings the chip has no better figures for are left unchanged, with a warning
+ *
+ * @param [in] radio  Radio
+ * @param [in] sf  Spreading factor
+ * @param [in] bw  Bandwidth
+ * @param [in, out] params  CAD parameters - the exit mode and the timeout are left unchanged
+ */
+static inline void apps_radio_get_cad_recommended_params( const apps_radio_t* radio, apps_radio_lora_sf_t sf,
+                                                          apps_radio_lora_bw_t bw, apps_radio_cad_params_t* params )
+{
+    APPS_RADIO_OP( radio, get_cad_recommended_params )( sf, bw, params );
+}
+
+/*!
+ * @brief Read and clear the interrupts raised by the radio
+ *
+ * @remark The adapters also drive the TX / RX LEDs and run the chip-specific post-reception steps
+ */
+static inline apps_radio_irq_mask_t apps_radio_get_and_clear_irq_status( const apps_radio_t* radio )
+{
+    return APPS_RADIO_OP( radio, get_and_clear_irq_status )( radio->context );
+}
+
+/*!
+ * @brief Get the delay between the last bit on air and the RX_DONE interrupt, from the timing model of the chip
+ *
+ * @remark Computed with the modulation parameters applied by apps_radio_init
+ */
+static inline uint32_t apps_radio_get_rx_done_delay_in_us( const apps_radio_t* radio )
+{
+    return APPS_RADIO_OP( radio, get_rx_done_delay_in_us )( radio->context );
+}
+
+/*!
+ * @brief Get the delay between the last bit on air and the TX_DONE interrupt, from the timing model of the chip
+ */
+static inline uint32_t apps_radio_get_tx_done_delay_in_us( const apps_radio_t* radio )
+{
+    return APPS_RADIO_OP( radio, get_tx_done_delay_in_us )( radio->context );
+}
+
+/*!
+ * @brief Tell whether the timing model of the chip has been characterised on that chip
+ *
+ * @returns false if the delays above use figures borrowed from another chip: the end-of-packet timestamps then carry a
+ * constant bias which has not been measured
+ */
+static inline bool apps_radio_is_timing_model_characterised( const apps_radio_t* radio )
+{
+    return APPS_RADIO_OP( radio, is_timing_model_characterised )( );
+}
+
+/*!
+ * @brief Get the time the last bit of the packet which raised RX_DONE was on air
+ *
+ * @remark Only meaningful in the callback called by apps_radio_irq_process
+ *
+ * @returns End of packet timestamp, in the timebase of smtc_hal_mcu_timer_get_time_in_us
+ */
+static inline uint32_t apps_radio_get_rx_end_of_packet_in_us( const apps_radio_t* radio )
+{
+    return apps_radio_get_irq_timestamp_in_us( ) - apps_radio_get_rx_done_delay_in_us( radio );
+}
+
+/*!
+ * @brief Get the time the last bit of the packet which raised TX_DONE was on air
+ *
+ * @remark Only meaningful in the callback called by apps_radio_irq_process
+ *
+ * @returns End of packet timestamp, in the timebase of smtc_hal_mcu_timer_get_time_in_us
+ */
+static inline uint32_t apps_radio_get_tx_end_of_packet_in_us( const apps_radio_t* radio )
+{
+    return apps_radio_get_irq_timestamp_in_us( ) - apps_radio_get_tx_done_delay_in_us( radio );
+}
+
+/*!
+ * @brief Sleep until an event needs the main loop, then run the expired software timers
+ */
+static inline void apps_radio_wait_for_event( const apps_radio_t* radio )
+{
+    APPS_RADIO_OP( radio, wait_for_event )( );
+}
+
+/*!
+ * @brief Print the cost of a radio call made directly, through this API and through the function table
+ *
+ * The call timed is get_tx_done_delay_in_us: it does not access the chip, so neither the SPI transfer nor the BUSY
+ * wait hide the dispatch cost. The cost of reading the cycle counter twice is printed too.
+ *
+ * @remark In single-chip builds the first two are expected to be equal
+ */
+static inline void apps_radio_print_call_benchmark( const apps_radio_t* radio )
+{
+    APPS_RADIO_OP( radio, print_call_benchmark )( radio->context );
+}
+
+/*!
+ * @brief Print the cost of an NSS toggle and of a GetIrqStatus transaction with the generic and the fast GPIO paths
+ *
+ * @remark The radio has to be awake
+ */
+static inline void apps_radio_print_gpio_benchmark( const apps_radio_t* radio )
+{
+    APPS_RADIO_OP( radio, print_gpio_benchmark )( radio->context );
+}
+
+/*!
+ * @brief Print the DIO event queue statistics of the radio
+ */
+static inline void apps_radio_print_irq_stats( const apps_radio_t* radio )
+{
+    APPS_RADIO_OP( radio, print_irq_stats )( radio->context );
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // APPS_RADIO_H
+
+/* --- EOF ------------------------------------------------------------------ */
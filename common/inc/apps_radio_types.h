@@ -0,0 +1,307 @@
+/*!
+ * @file      apps_radio_types.h
+ *
+ * @brief     Types of the chip-agnostic radio API
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef APPS_RADIO_TYPES_H
+#define APPS_RADIO_TYPES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "radio_registry.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*!
+ * @brief Timeout given to receive_packet to leave the radio in standby after the read
+ */
+#define APPS_RADIO_RX_RESTART_NONE UINT32_MAX
+
+/*!
+ * @brief Largest payload held by an apps_radio_rx_packet_t
+ */
+#ifndef APPS_RADIO_RX_PACKET_MAX_LENGTH
+#define APPS_RADIO_RX_PACKET_MAX_LENGTH 255
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * @brief Radio interrupts, translated from the chip-specific IRQ registers by the adapters
+ */
+enum apps_radio_irq_e
+{
+    APPS_RADIO_IRQ_NONE                  = ( 0 << 0 ),
+    APPS_RADIO_IRQ_TX_DONE               = ( 1 << 0 ),
+    APPS_RADIO_IRQ_RX_DONE               = ( 1 << 1 ),  //!< Raised along with CRC_ERROR or LENGTH_ERROR on failures
+    APPS_RADIO_IRQ_TIMEOUT               = ( 1 << 2 ),
+    APPS_RADIO_IRQ_PREAMBLE_DETECTED     = ( 1 << 3 ),
+    APPS_RADIO_IRQ_SYNCWORD_HEADER_VALID = ( 1 << 4 ),
+    APPS_RADIO_IRQ_HEADER_ERROR          = ( 1 << 5 ),
+    APPS_RADIO_IRQ_CRC_ERROR             = ( 1 << 6 ),
+    APPS_RADIO_IRQ_LENGTH_ERROR          = ( 1 << 7 ),  //!< GFSK length or address error
+    APPS_RADIO_IRQ_CAD_DONE              = ( 1 << 8 ),
+    APPS_RADIO_IRQ_CAD_DETECTED          = ( 1 << 9 ),
+    APPS_RADIO_IRQ_ALL = APPS_RADIO_IRQ_TX_DONE | APPS_RADIO_IRQ_RX_DONE | APPS_RADIO_IRQ_TIMEOUT |
+                         APPS_RADIO_IRQ_PREAMBLE_DETECTED | APPS_RADIO_IRQ_SYNCWORD_HEADER_VALID |
+                         APPS_RADIO_IRQ_HEADER_ERROR | APPS_RADIO_IRQ_CRC_ERROR | APPS_RADIO_IRQ_LENGTH_ERROR |
+                         APPS_RADIO_IRQ_CAD_DONE | APPS_RADIO_IRQ_CAD_DETECTED,
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * @brief Combination of apps_radio_irq_e values
+ */
+typedef uint16_t apps_radio_irq_mask_t;
+
+/*!
+ * @brief LoRa spreading factors
+ *
+ * @remark The values are the register codes shared by the LR11xx and the SX126x, so the adapters pass them through
+ */
+typedef enum apps_radio_lora_sf_e
+{
+    APPS_RADIO_LORA_SF5  = 0x05,
+    APPS_RADIO_LORA_SF6  = 0x06,
+    APPS_RADIO_LORA_SF7  = 0x07,
+    APPS_RADIO_LORA_SF8  = 0x08,
+    APPS_RADIO_LORA_SF9  = 0x09,
+    APPS_RADIO_LORA_SF10 = 0x0A,
+    APPS_RADIO_LORA_SF11 = 0x0B,
+    APPS_RADIO_LORA_SF12 = 0x0C,
+} apps_radio_lora_sf_t;
+
+/*!
+ * @brief LoRa bandwidths available on both chips
+ *
+ * @remark The values are the register codes shared by the LR11xx and the SX126x, so the adapters pass them through
+ */
+typedef enum apps_radio_lora_bw_e
+{
+    APPS_RADIO_LORA_BW_10  = 0x08,  //!< 10.42 kHz
+    APPS_RADIO_LORA_BW_15  = 0x01,  //!< 15.63 kHz
+    APPS_RADIO_LORA_BW_20  = 0x09,  //!< 20.83 kHz
+    APPS_RADIO_LORA_BW_31  = 0x02,  //!< 31.25 kHz
+    APPS_RADIO_LORA_BW_41  = 0x0A,  //!< 41.67 kHz
+    APPS_RADIO_LORA_BW_62  = 0x03,  //!< 62.50 kHz
+    APPS_RADIO_LORA_BW_125 = 0x04,  //!< 125 kHz
+    APPS_RADIO_LORA_BW_250 = 0x05,  //!< 250 kHz
+    APPS_RADIO_LORA_BW_500 = 0x06,  //!< 500 kHz
+} apps_radio_lora_bw_t;
+
+/*!
+ * @brief LoRa coding rates available on both chips
+ *
+ * @remark The values are the register codes shared by the LR11xx and the SX126x, so the adapters pass them through
+ */
+typedef enum apps_radio_lora_cr_e
+{
+    APPS_RADIO_LORA_CR_4_5 = 0x01,
+    APPS_RADIO_LORA_CR_4_6 = 0x02,
+    APPS_RADIO_LORA_CR_4_7 = 0x03,
+    APPS_RADIO_LORA_CR_4_8 = 0x04,
+} apps_radio_lora_cr_t;
+
+/*!
+ * @brief LoRa modulation and packet parameters
+ */
+typedef struct apps_radio_lora_params_s
+{
+    apps_radio_lora_sf_t sf;
+    apps_radio_lora_bw_t bw;
+    apps_radio_lora_cr_t cr;
+    bool                 ldro_is_on;          //!< Low data-rate optimization
+    uint16_t             preamble_len_in_symb;
+    bool                 header_is_implicit;
+    uint8_t              pld_len_in_bytes;
+    bool                 crc_is_on;
+    bool                 invert_iq_is_on;
+} apps_radio_lora_params_t;
+
+/*!
+ * @brief Action taken by the radio at the end of a CAD
+ *
+ * @remark The values are the register codes shared by the LR11xx and the SX126x, so the adapters pass them through
+ */
+typedef enum apps_radio_cad_exit_mode_e
+{
+    APPS_RADIO_CAD_EXIT_MODE_STANDBY = 0x00,  //!< Back to standby whatever the result
+    APPS_RADIO_CAD_EXIT_MODE_RX      = 0x01,  //!< Reception if activity is detected, for cad_timeout_in_ms
+    APPS_RADIO_CAD_EXIT_MODE_TX      = 0x10,  //!< Transmission if no activity is detected (listen before talk)
+} apps_radio_cad_exit_mode_t;
+
+/*!
+ * @brief Oscillator kept running in standby
+ * @remark The values are the register codes shared by the LR11xx and the SX126x, so the adapters pass them through
+ */
+typedef enum apps_radio_standby_cfg_e
+{
+    APPS_RADIO_STANDBY_CFG_RC   = 0x00,  //!< RC oscillator
+    APPS_RADIO_STANDBY_CFG_XOSC = 0x01,  //!< Crystal oscillator, for a faster switch to TX, RX or CAD
+} apps_radio_standby_cfg_t;
+
+/*!
+ * @brief Channel activity detection parameters
+ */
+typedef struct apps_radio_cad_params_s
+{
+    uint8_t                    nb_symbols;  //!< 1, 2, 4, 8 or 16 symbols
+    uint8_t                    detect_peak;
+    uint8_t                    detect_min;
+    apps_radio_cad_exit_mode_t exit_mode;
+    uint32_t                   timeout_in_ms;  //!< Duration of the reception or transmission following the CAD
+} apps_radio_cad_params_t;
+
+/*!
+ * @brief Status of the last LoRa packet received
+ */
+typedef struct apps_radio_lora_pkt_status_s
+{
+    int8_t rssi_pkt_in_dbm;         //!< Average RSSI over the packet
+    int8_t snr_pkt_in_db;           //!< SNR estimated on the packet
+    int8_t signal_rssi_pkt_in_dbm;  //!< RSSI of the despread signal
+} apps_radio_lora_pkt_status_t;
+
+/*!
+ * @brief Status of the last GFSK packet received
+ */
+typedef struct apps_radio_gfsk_pkt_status_s
+{
+    int8_t rssi_sync_in_dbm;  //!< RSSI at the sync word
+    int8_t rssi_avg_in_dbm;   //!< Average RSSI over the packet
+} apps_radio_gfsk_pkt_status_t;
+
+/*!
+ * @brief Packet read by receive_packet, with its metadata
+ */
+typedef struct apps_radio_rx_packet_s
+{
+    uint32_t rx_done_in_cycles;    //!< Cycle counter at the RX_DONE DIO edge
+    uint32_t latency_in_cycles;    //!< From the RX_DONE DIO edge to the payload in RAM
+    uint32_t end_of_packet_in_us;  //!< Time the last bit was on air, see apps_radio_get_rx_end_of_packet_in_us
+    union
+    {
+        apps_radio_lora_pkt_status_t lora;  //!< Valid if apps_radio_is_lora_pkt_type returns true
+        apps_radio_gfsk_pkt_status_t gfsk;  //!< Valid otherwise
+    } pkt_status;
+    uint8_t length;  //!< Payload length, 0 if the payload did not fit
+    uint8_t payload[APPS_RADIO_RX_PACKET_MAX_LENGTH];
+} apps_radio_rx_packet_t;
+
+/*!
+ * @brief Operations a chip adapter provides
+ *
+ * @remark Every operation takes the radio HAL context first, except the ones that are not tied to a radio. Driver
+ * errors are handled by the adapters with the ASSERT_*_RC macros, the same way as in apps_common
+ */
+typedef struct apps_radio_ops_s
+{
+    void* ( *get_context )( uint8_t radio_id, const radio_registry_binding_t* binding );
+    void ( *print_version )( void );
+    void ( *init )( const void* context );
+    void ( *init_dbpsk )( const void* context, uint8_t payload_length );
+    bool ( *reconfigure )( const void* context );
+    bool ( *is_lora_pkt_type )( void );
+    void ( *set_rf_freq )( const void* context, uint32_t freq_in_hz );
+    void ( *set_fs )( const void* context );
+    void ( *set_standby )( const void* context, apps_radio_standby_cfg_t cfg );
+    void ( *set_lora_params )( const void* context, const apps_radio_lora_params_t* params );
+    void ( *set_irq_mask )( const void* context, apps_radio_irq_mask_t irq_mask );
+    void ( *write_payload )( const void* context, const uint8_t* buffer, uint8_t length );
+    uint8_t ( *read_payload )( const void* context, uint8_t* buffer, uint8_t max_length );
+    uint8_t ( *read_payload_head )( const void* context, uint8_t* buffer, uint8_t length );
+    bool ( *get_lora_pkt_status )( const void* context, apps_radio_lora_pkt_status_t* pkt_status );
+    bool ( *get_gfsk_pkt_status )( const void* context, apps_radio_gfsk_pkt_status_t* pkt_status );
+    bool ( *receive_packet )( const void* context, uint32_t rx_restart_timeout_in_ms, apps_radio_rx_packet_t* packet );
+    void ( *set_tx )( const void* context, uint32_t timeout_in_ms );
+    void ( *set_tx_cw )( const void* context );
+    void ( *set_tx_infinite_preamble )( const void* context );
+    void ( *set_rx )( const void* context, uint32_t timeout_in_ms );
+    void ( *set_rx_continuous )( const void* context );
+    int16_t ( *get_rssi_inst )( const void* context );
+    void ( *start_cad )( const void* context, const apps_radio_cad_params_t* params );
+    void ( *restart_cad )( const void* context );
+    void ( *get_cad_recommended_params )( apps_radio_lora_sf_t sf, apps_radio_lora_bw_t bw,
+                                          apps_radio_cad_params_t* params );
+    apps_radio_irq_mask_t ( *get_and_clear_irq_status )( const void* context );
+    uint32_t ( *get_rx_done_delay_in_us )( const void* context );
+    uint32_t ( *get_tx_done_delay_in_us )( const void* context );
+    bool ( *is_timing_model_characterised )( void );
+    void ( *wait_for_event )( void );
+    void ( *print_call_benchmark )( const void* context );
+    void ( *print_gpio_benchmark )( const void* context );
+    void ( *print_irq_stats )( const void* context );
+} apps_radio_ops_t;
+
+/*!
+ * @brief Radio driven through the chip-agnostic API
+ */
+typedef struct apps_radio_s
+{
+    const apps_radio_ops_t* ops;      //!< Adapter of the chip
+    void*                   context;  //!< Radio HAL context
+} apps_radio_t;
+
+/*!
+ * @brief Interrupt callback of an application
+ *
+ * @param [in] radio  Radio that raised the interrupts
+ * @param [in] irq  Interrupts raised, after filtering
+ */
+typedef void ( *apps_radio_irq_callback_t )( const apps_radio_t* radio, apps_radio_irq_mask_t irq );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // APPS_RADIO_TYPES_H
+
+/* --- EOF ------------------------------------------------------------------ */
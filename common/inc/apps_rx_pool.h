@@ -0,0 +1,160 @@
+/*!
+ * @file      apps_rx_pool.h
+ *
+ * @brief     Pool of received packets and queue of packets waiting for the application
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef APPS_RX_POOL_H
+#define APPS_RX_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "apps_radio.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*!
+ * @brief Number of packet buffers in the pool - must be a power of two
+ *
+ * The RX queue has as many entries as the pool has buffers, so it can never overflow: a burst is only limited by the
+ * number of buffers the application has not released yet
+ */
+#ifndef APPS_RX_POOL_SIZE
+#define APPS_RX_POOL_SIZE 4
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * @brief Pool statistics
+ */
+typedef struct apps_rx_pool_stats_s
+{
+    uint32_t nb_received;             //!< Number of packets read into a buffer and queued
+    uint32_t nb_pool_exhausted;       //!< Number of packets dropped because no buffer was free
+    uint32_t nb_read_errors;          //!< Number of packets dropped because the payload did not fit in a buffer
+    uint8_t  queue_high_water_mark;   //!< Maximum number of packets waiting in the queue
+    uint8_t  in_use_high_water_mark;  //!< Maximum number of buffers queued or held by the application
+} apps_rx_pool_stats_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * @brief Return all the buffers to the pool, empty the queue and reset the statistics
+ */
+void apps_rx_pool_init( void );
+
+/*!
+ * @brief Read a received packet into a free buffer, re-arm the reception and queue the packet
+ *
+ * To be called from on_rx_done. The payload is read only once, from the radio to the pooled buffer, and the
+ * application gets the buffer itself from apps_rx_pool_get_next. If no buffer is free, the packet is dropped and
+ * counted, but the reception is re-armed all the same.
+ *
+ * @param [in] radio Radio abstraction
+ * @param [in] rx_restart_timeout_in_ms Timeout of the next reception, or APPS_RADIO_RX_RESTART_NONE
+ *
+ * @returns true if the packet has been queued
+ */
+bool apps_rx_pool_receive( const apps_radio_t* radio, uint32_t rx_restart_timeout_in_ms );
+
+/*!
+ * @brief Take the oldest packet out of the queue
+ *
+ * The buffer belongs to the application until it is given back with apps_rx_pool_release
+ *
+ * @returns The packet, NULL if the queue is empty
+ */
+apps_radio_rx_packet_t* apps_rx_pool_get_next( void );
+
+/*!
+ * @brief Give a buffer obtained from apps_rx_pool_get_next back to the pool
+ *
+ * @remark A buffer outside the pool, or one already given back, is rejected with an error trace
+ *
+ * @param [in] packet Packet buffer
+ */
+void apps_rx_pool_release( apps_radio_rx_packet_t* packet );
+
+/*!
+ * @brief Get the number of packets waiting in the queue
+ *
+ * @returns Number of queued packets
+ */
+uint8_t apps_rx_pool_get_queue_depth( void );
+
+/*!
+ * @brief Get a copy of the pool statistics
+ *
+ * @param [out] stats Statistics
+ */
+void apps_rx_pool_get_stats( apps_rx_pool_stats_t* stats );
+
+/*!
+ * @brief Reset the pool statistics, keeping the queued packets
+ */
+void apps_rx_pool_reset_stats( void );
+
+/*!
+ * @brief Print the pool statistics
+ */
+void apps_rx_pool_print_stats( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // APPS_RX_POOL_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,193 @@
+/*!
+ * @file      apps_sigfox_scheduler.h
+ *
+ * @brief     Sigfox frame scheduler: one encoding per frame, repetitions sent from the radio buffer on new frequencies
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef APPS_SIGFOX_SCHEDULER_H
+#define APPS_SIGFOX_SCHEDULER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "apps_radio.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*!
+ * @brief Largest number of transmissions of a frame: the frame and its two repetitions
+ */
+#ifndef APPS_SIGFOX_SCHEDULER_NB_TRANSMISSIONS_MAX
+#define APPS_SIGFOX_SCHEDULER_NB_TRANSMISSIONS_MAX 3
+#endif
+
+/*!
+ * @brief Largest physical frame, in bytes, before differential encoding
+ */
+#ifndef APPS_SIGFOX_SCHEDULER_FRAME_LENGTH_MAX
+#define APPS_SIGFOX_SCHEDULER_FRAME_LENGTH_MAX 32
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * @brief Interrupts to give to apps_sigfox_scheduler_on_radio_irq
+ */
+#define APPS_SIGFOX_SCHEDULER_IRQ_MASK ( APPS_RADIO_IRQ_TX_DONE )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * @brief Function called around each transmission, typically to drive the TX LED
+ */
+typedef void ( *apps_sigfox_scheduler_on_tx_t )( void );
+
+/*!
+ * @brief Scheduler configuration
+ */
+typedef struct apps_sigfox_scheduler_cfg_s
+{
+    uint32_t center_freq_in_hz;        //!< Center of the uplink macro channel
+    uint32_t band_width_in_hz;         //!< Width of the macro channel the transmissions are spread over
+    uint32_t guard_in_hz;              //!< Distance kept from the edges of each transmission's sub-band
+    uint32_t inter_frame_delay_in_ms;  //!< Delay between the end of a transmission and the start of the next one
+    uint8_t  nb_transmissions;  //!< Transmissions of a frame, 1 to APPS_SIGFOX_SCHEDULER_NB_TRANSMISSIONS_MAX
+    apps_sigfox_scheduler_on_tx_t on_tx_start;  //!< Called right before each transmission starts - can be NULL
+    apps_sigfox_scheduler_on_tx_t on_tx_done;   //!< Called on each TX_DONE, before anything else - can be NULL
+} apps_sigfox_scheduler_cfg_t;
+
+/*!
+ * @brief Scheduler statistics
+ */
+typedef struct apps_sigfox_scheduler_stats_s
+{
+    uint32_t nb_frames;                //!< Frames whose transmissions are all done
+    uint32_t nb_transmissions;         //!< Transmissions done, repetitions included
+    uint32_t nb_encodings;             //!< Frames encoded and written to the radio buffer
+    uint32_t nb_bytes_written;         //!< Encoded bytes written to the radio buffer
+    uint32_t nb_bytes_saved;           //!< Encoded bytes that a write per transmission would have added
+    uint32_t encode_time_max_in_us;    //!< Longest encoding and radio buffer write of a frame
+    uint32_t retune_time_max_in_us;    //!< Longest TX_DONE handling: retune to the next frequency and timer start
+    uint32_t last_freqs_in_hz[APPS_SIGFOX_SCHEDULER_NB_TRANSMISSIONS_MAX];  //!< Frequencies of the last frame
+} apps_sigfox_scheduler_stats_t;
+
+/*!
+ * @brief Function called once the last transmission of a frame is done
+ *
+ * @remark Called from apps_sigfox_scheduler_on_radio_irq, the radio is in standby
+ */
+typedef void ( *apps_sigfox_scheduler_on_done_t )( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * @brief Configure the scheduler and forget the content of the radio buffer
+ *
+ * @remark The radio is expected to be in standby, configured for DBPSK with the length of the frames to send, and to
+ * route APPS_SIGFOX_SCHEDULER_IRQ_MASK to its DIO line
+ *
+ * @param [in] radio  Radio sending the frames
+ * @param [in] cfg  Scheduler configuration
+ * @param [in] on_done  Function called at the end of each frame - can be NULL
+ *
+ * @returns false if the configuration is not valid
+ */
+bool apps_sigfox_scheduler_init( const apps_radio_t* radio, const apps_sigfox_scheduler_cfg_t* cfg,
+                                 apps_sigfox_scheduler_on_done_t on_done );
+
+/*!
+ * @brief Send a frame and its repetitions
+ *
+ * The frame is differentially encoded and written to the radio buffer once, unless it is the frame already in there.
+ * Each transmission then runs on a random frequency of its own slice of the macro channel. Between two transmissions
+ * the radio is retuned from the TX_DONE interrupt and a software timer only starts the next transmission.
+ *
+ * @remark The radio buffer must not be used by anything else until apps_sigfox_scheduler_init is called again
+ *
+ * @param [in] frame  Physical frame, before differential encoding
+ * @param [in] length_in_bytes  Frame length, at most APPS_SIGFOX_SCHEDULER_FRAME_LENGTH_MAX
+ *
+ * @returns false if the frame is too long or a frame is still being sent
+ */
+bool apps_sigfox_scheduler_send( const uint8_t* frame, uint8_t length_in_bytes );
+
+/*!
+ * @brief Check whether a frame is being sent
+ */
+bool apps_sigfox_scheduler_is_busy( void );
+
+/*!
+ * @brief Interrupt callback to give to apps_radio_irq_process with APPS_SIGFOX_SCHEDULER_IRQ_MASK
+ *
+ * @param [in] radio  Radio that raised the interrupts
+ * @param [in] irq  Interrupts raised
+ */
+void apps_sigfox_scheduler_on_radio_irq( const apps_radio_t* radio, apps_radio_irq_mask_t irq );
+
+/*!
+ * @brief Get the scheduler statistics
+ *
+ * @param [out] stats  Statistics
+ */
+void apps_sigfox_scheduler_get_stats( apps_sigfox_scheduler_stats_t* stats );
+
+/*!
+ * @brief Print the frequencies of the last frame and the statistics
+ */
+void apps_sigfox_scheduler_print_stats( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // APPS_SIGFOX_SCHEDULER_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,213 @@
+/*!
+ * @file      apps_spectral_sweep.h
+ *
+ * @brief     Spectral sweep: timer-paced instantaneous RSSI histograms streamed as binary frames
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef APPS_SPECTRAL_SWEEP_H
+#define APPS_SPECTRAL_SWEEP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "apps_radio.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*!
+ * @brief Largest number of RSSI bins of a histogram
+ */
+#ifndef APPS_SPECTRAL_SWEEP_NB_BINS_MAX
+#define APPS_SPECTRAL_SWEEP_NB_BINS_MAX 64
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * @brief Bytes starting every frame, so that a decoder can find them among the text traces
+ */
+#define APPS_SPECTRAL_SWEEP_SYNC_0 0xAA
+#define APPS_SPECTRAL_SWEEP_SYNC_1 0x55
+
+/*!
+ * @brief Length of the sync bytes, type and length fields starting every frame
+ */
+#define APPS_SPECTRAL_SWEEP_FRAME_HEADER_LENGTH 4
+
+/*!
+ * @brief Length of the CRC ending every frame
+ */
+#define APPS_SPECTRAL_SWEEP_FRAME_CRC_LENGTH 2
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * @brief Frame types
+ */
+typedef enum apps_spectral_sweep_frame_type_e
+{
+    APPS_SPECTRAL_SWEEP_FRAME_SWEEP   = 0x01,  //!< Start of a sweep, with the sweep configuration
+    APPS_SPECTRAL_SWEEP_FRAME_CHANNEL = 0x02,  //!< RSSI histogram of a channel
+} apps_spectral_sweep_frame_type_t;
+
+/*!
+ * @brief Sweep configuration
+ */
+typedef struct apps_spectral_sweep_cfg_s
+{
+    uint32_t freq_start_in_hz;
+    uint32_t freq_step_in_hz;
+    uint16_t nb_channels;
+    uint16_t nb_samples;           //!< Instantaneous RSSI samples per channel
+    uint16_t sample_period_in_us;  //!< Time between two samples
+    uint16_t settle_time_in_us;    //!< Time between the retune and the first sample
+    int8_t   rssi_top_in_dbm;      //!< Top of the first bin: higher samples are counted in it
+    uint8_t  rssi_step_in_db;      //!< Width of a bin
+    uint8_t  nb_bins;              //!< Number of bins: lower samples are counted in the last one
+} apps_spectral_sweep_cfg_t;
+
+/*!
+ * @brief Frame sent at the start of each sweep
+ *
+ * @remark Frames are sent as they are laid out in memory: all fields are little-endian and naturally aligned, the CRC
+ * is the CRC-16/CCITT-FALSE of everything after the sync bytes
+ */
+typedef struct apps_spectral_sweep_frame_sweep_s
+{
+    uint8_t  sync[2];
+    uint8_t  type;    //!< APPS_SPECTRAL_SWEEP_FRAME_SWEEP
+    uint8_t  length;  //!< Number of bytes between this field and the CRC
+    uint32_t freq_start_in_hz;
+    uint32_t freq_step_in_hz;
+    uint32_t last_sweep_time_in_us;  //!< Duration of the previous sweep, 0 for the first one after a start
+    uint16_t sweep_index;
+    uint16_t nb_channels;
+    uint16_t nb_samples;
+    uint16_t sample_period_in_us;
+    uint16_t settle_time_in_us;
+    int8_t   rssi_top_in_dbm;
+    uint8_t  rssi_step_in_db;
+    uint8_t  nb_bins;
+    uint8_t  reserved;
+    uint16_t crc;
+} apps_spectral_sweep_frame_sweep_t;
+
+/*!
+ * @brief Frame sent at the end of each channel
+ *
+ * @remark The histogram is accumulated in the frame itself. The CRC follows the last bin used, in bins[nb_bins].
+ */
+typedef struct apps_spectral_sweep_frame_channel_s
+{
+    uint8_t  sync[2];
+    uint8_t  type;    //!< APPS_SPECTRAL_SWEEP_FRAME_CHANNEL
+    uint8_t  length;  //!< Number of bytes between this field and the CRC
+    uint32_t freq_in_hz;
+    uint16_t sweep_index;
+    uint16_t channel_index;
+    uint16_t scan_time_in_us;  //!< Time from the retune to the last sample
+    uint16_t nb_samples;       //!< Samples counted in the bins
+    uint16_t bins[APPS_SPECTRAL_SWEEP_NB_BINS_MAX + 1];
+} apps_spectral_sweep_frame_channel_t;
+
+/*!
+ * @brief Function receiving each frame once it is complete
+ *
+ * @remark Called from the software timer context. The radio is already retuned to the next channel, so the time spent
+ * sending the frame overlaps the settling time. The frame is overwritten as soon as the function returns.
+ *
+ * @param [in] frame  Frame, starting with the sync bytes
+ * @param [in] length  Frame length, CRC included
+ */
+typedef void ( *apps_spectral_sweep_on_frame_t )( const uint8_t* frame, uint16_t length );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * @brief Configure the sweep
+ *
+ * @param [in] radio  Radio, in standby
+ * @param [in] cfg  Sweep configuration
+ * @param [in] on_frame  Function receiving the frames
+ *
+ * @returns false if the configuration is not valid
+ */
+bool apps_spectral_sweep_init( const apps_radio_t* radio, const apps_spectral_sweep_cfg_t* cfg,
+                               apps_spectral_sweep_on_frame_t on_frame );
+
+/*!
+ * @brief Start sweeping
+ *
+ * @param [in] nb_sweeps  Number of sweeps to run back to back, 0 to sweep until apps_spectral_sweep_stop
+ */
+void apps_spectral_sweep_start( uint32_t nb_sweeps );
+
+/*!
+ * @brief Stop sweeping, dropping the channel in progress
+ *
+ * @remark The radio is left in reception: the application puts it back in standby
+ */
+void apps_spectral_sweep_stop( void );
+
+/*!
+ * @brief Check whether a sweep is in progress
+ *
+ * @returns true until the last sweep is complete or apps_spectral_sweep_stop is called
+ */
+bool apps_spectral_sweep_is_running( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // APPS_SPECTRAL_SWEEP_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,139 @@
+#ifndef _ATC_H_
+#define _ATC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "smtc_hal_mcu_uart.h"
+
+typedef void (*ATC_EventCallback)(char* param1, char* param2);
+
+
+typedef struct {
+    char* Event;                     
+    ATC_EventCallback EventCallback;  
+} ATC_EventTypeDef;
+
+typedef struct {
+    smtc_hal_mcu_uart_inst_t hUart;
+    char Name[8];
+    ATC_EventTypeDef* psEvents;
+    uint32_t Events;
+    uint16_t Size;
+    uint16_t RxIndex;
+    uint8_t* pRxBuff;
+    uint8_t* pReadBuff;
+} ATC_HandleTypeDef;
+
+bool ATC_Init(ATC_HandleTypeDef* hAtc, smtc_hal_mcu_uart_inst_t hUart, uint16_t BufferSize, const char* pName);
+bool ATC_SetEvents(ATC_HandleTypeDef* hAtc, ATC_EventTypeDef* events);
+void ATC_Loop(ATC_HandleTypeDef* hAtc);
+void ATC_IdleLineCallback(ATC_HandleTypeDef* hAtc, uint16_t Len);
+
+// Radio family binding: AT command parameters (SF number, BW in kHz, CR index) <-> driver enum values stored in
+// ATC_M_LORA_SF / ATC_M_LORA_BW / ATC_M_LORA_CR
+typedef struct {
+    int Param;
+    int Value;
+} ATC_ParamMapTypeDef;
+
+typedef struct {
+    const char* pFamily;
+    const ATC_ParamMapTypeDef* pLoraSf;
+    uint8_t LoraSfCount;
+    const ATC_ParamMapTypeDef* pLoraBw;
+    uint8_t LoraBwCount;
+    const ATC_ParamMapTypeDef* pLoraCr;
+    uint8_t LoraCrCount;
+    uint32_t Features;  // ATC_FEATURE_* implemented by the apps of the family
+} ATC_BindingTypeDef;
+
+// Commands only some radio families implement: the others reply with an error instead of ignoring them
+#define ATC_FEATURE_PER_SWEEP (1UL << 0)  // AT+SWEEP
+#define ATC_FEATURE_PER_FAST  (1UL << 1)  // AT+PERFAST
+
+#define ATC_MAP_SIZE(map) (sizeof(map) / sizeof(map[0]))
+
+// Provided by the radio family, along with the radio-specific ATC_M_* defaults (e.g. lr11xx/common/atc_lr11xx.c)
+extern const ATC_BindingTypeDef ATC_Binding;
+
+bool ATC_LoraSfFromParam(int Param, int* pSf);
+bool ATC_LoraBwFromParam(int Param, int* pBw);
+bool ATC_LoraCrFromParam(int Param, int* pCr);
+int ATC_LoraSfToParam(int Sf);
+int ATC_LoraBwToParam(int Bw);
+
+// Ping-pong benchmark: largest number of frames in flight, one bit each in the answer
+#define ATC_PING_PONG_WINDOW_MAX 8
+
+// CAD scan: channels swept with back-to-back CADs, in Hz
+#define ATC_CAD_SCAN_CHANNELS_MAX 16
+
+bool ATC_CadScanSetChannels(const uint32_t* pFreqs, uint8_t Count);
+uint8_t ATC_CadScanGetChannels(const uint32_t** ppFreqs);
+
+// Sweep: grid of parameters iterated on-device, one value list per axis
+#define ATC_SWEEP_VALUES_MAX 16
+
+typedef enum {
+    ATC_SWEEP_AXIS_FREQ = 0,  // Hz
+    ATC_SWEEP_AXIS_SF,        // AT+SF parameter
+    ATC_SWEEP_AXIS_BW,        // AT+BW parameter
+    ATC_SWEEP_AXIS_POWER,     // dBm
+    ATC_SWEEP_AXIS_COUNT
+} ATC_SweepAxisTypeDef;
+
+typedef struct {
+    uint32_t Freq;
+    int Sf;
+    int Bw;
+    int Power;
+} ATC_SweepPointTypeDef;
+
+bool ATC_SweepSetAxis(ATC_SweepAxisTypeDef Axis, const int32_t* pValues, uint8_t Count);
+void ATC_SweepClear(void);
+uint8_t ATC_SweepGetAxisCount(ATC_SweepAxisTypeDef Axis);
+uint32_t ATC_SweepGetPointCount(void);
+bool ATC_SweepApplyPoint(uint32_t Index, ATC_SweepPointTypeDef* pPoint);
+
+
+//macros redefine
+extern int ATC_M_TX_OUTPUT_POWER_DBM;
+
+extern uint32_t ATC_M_RF_FREQ_IN_HZ;
+
+extern int ATC_M_TXRX_SWITCH;
+
+extern int ATC_M_LORA_SF;
+
+extern int ATC_M_LORA_BW;
+
+extern int ATC_M_LORA_CR;
+
+extern int ATC_M_CW_SWITCH;
+
+extern int ATC_M_NB_FRAME;
+
+extern int ATC_M_LORA_RX_BOOST;
+
+extern int ATC_M_LORA_SLEEP;
+
+extern int ATC_M_PA_PA_HP_SEL;
+
+extern int ATC_M_PA_PA_SEL;
+
+extern int ATC_M_PA_PA_RGE_SUPPLY;
+
+extern int ATC_M_PA_PA_DUTY_CYCLE;
+
+extern int ATC_M_PA_PA_REAL_POWER;
+
+extern int ATC_M_SWEEP_SWITCH;
+
+extern int ATC_M_PER_FAST_SWITCH;
+
+extern int ATC_M_PING_PONG_WINDOW;
+
+extern int ATC_M_CAD_SCAN_SWITCH;
+
+extern int ATC_M_CAD_SCAN_NB_SWEEPS;
+#endif
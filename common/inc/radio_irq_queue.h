@@ -0,0 +1,184 @@
+/*!
+ * @file      radio_irq_queue.h
+ *
+ * @brief     Lock-free queue of timestamped radio DIO interrupt events
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RADIO_IRQ_QUEUE_H
+#define RADIO_IRQ_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*!
+ * @brief Number of DIO events the queue can hold - must be a power of two
+ */
+#ifndef RADIO_IRQ_QUEUE_SIZE
+#define RADIO_IRQ_QUEUE_SIZE 8
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * @brief DIO interrupt event, as captured by the interrupt handler
+ */
+typedef struct radio_irq_event_s
+{
+    uint32_t timestamp_in_cycles;  //!< Cycle counter value when the DIO edge was serviced
+} radio_irq_event_t;
+
+/*!
+ * @brief Queue statistics
+ */
+typedef struct radio_irq_queue_stats_s
+{
+    uint32_t nb_events;              //!< Number of events pushed by the interrupt handler
+    uint32_t nb_overflows;           //!< Number of events dropped because the queue was full
+    uint8_t  depth_high_water_mark;  //!< Maximum number of events waiting in the queue
+    uint32_t nb_dispatched;          //!< Number of events dispatched by the main loop
+    uint32_t latency_min_in_cycles;  //!< Minimum delay between DIO edge and dispatch
+    uint32_t latency_max_in_cycles;  //!< Maximum delay between DIO edge and dispatch
+    uint64_t latency_sum_in_cycles;  //!< Sum of the delays between DIO edge and dispatch
+} radio_irq_queue_stats_t;
+
+/*!
+ * @brief Single-producer / single-consumer queue of DIO events
+ *
+ * The interrupt handler is the only writer of head, the main loop the only writer of tail. Both indexes run freely and
+ * are masked on access, so no lock nor interrupt masking is needed on a single-core MCU.
+ */
+typedef struct radio_irq_queue_s
+{
+    radio_irq_event_t       events[RADIO_IRQ_QUEUE_SIZE];
+    volatile uint32_t       head;
+    volatile uint32_t       tail;
+    radio_irq_queue_stats_t stats;
+} radio_irq_queue_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * @brief Empty the queue and reset its statistics
+ *
+ * @param [out] queue  Pointer to the queue
+ */
+void radio_irq_queue_init( radio_irq_queue_t* queue );
+
+/*!
+ * @brief Push an event in the queue
+ *
+ * @remark To be called from the DIO interrupt handler only
+ *
+ * @param [in] queue  Pointer to the queue
+ * @param [in] timestamp_in_cycles  Cycle counter value captured when entering the interrupt handler
+ *
+ * @returns false if the queue was full and the event has been dropped, true otherwise
+ */
+bool radio_irq_queue_push( radio_irq_queue_t* queue, uint32_t timestamp_in_cycles );
+
+/*!
+ * @brief Pop the oldest event from the queue
+ *
+ * @remark To be called from the main loop only
+ *
+ * @param [in] queue  Pointer to the queue
+ * @param [out] event  Pointer to the event to be filled
+ *
+ * @returns true if an event has been popped, false if the queue is empty
+ */
+bool radio_irq_queue_pop( radio_irq_queue_t* queue, radio_irq_event_t* event );
+
+/*!
+ * @brief Check if events are waiting in the queue
+ *
+ * @param [in] queue  Pointer to the queue
+ *
+ * @returns true if the queue is empty
+ */
+bool radio_irq_queue_is_empty( const radio_irq_queue_t* queue );
+
+/*!
+ * @brief Record the delay between the DIO edge of an event and its dispatch
+ *
+ * @remark To be called from the main loop only
+ *
+ * @param [in] queue  Pointer to the queue
+ * @param [in] latency_in_cycles  Delay in core cycles
+ */
+void radio_irq_queue_record_latency( radio_irq_queue_t* queue, uint32_t latency_in_cycles );
+
+/*!
+ * @brief Get a copy of the queue statistics
+ *
+ * @param [in] queue  Pointer to the queue
+ * @param [out] stats  Pointer to the statistics to be filled
+ */
+void radio_irq_queue_get_stats( const radio_irq_queue_t* queue, radio_irq_queue_stats_t* stats );
+
+/*!
+ * @brief Reset the queue statistics, keeping the queued events
+ *
+ * @param [in] queue  Pointer to the queue
+ */
+void radio_irq_queue_reset_stats( radio_irq_queue_t* queue );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RADIO_IRQ_QUEUE_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,196 @@
+/*!
+ * @file      radio_registry.h
+ *
+ * @brief     Registry of the radios driven by the MCU, with their bindings and interrupt queues
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RADIO_REGISTRY_H
+#define RADIO_REGISTRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "radio_irq_queue.h"
+#include "smtc_shield_pinout.h"
+#include "stm32l4xx_ll_spi.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*!
+ * @brief Maximum number of radios driven by the MCU
+ */
+#ifndef RADIO_REGISTRY_MAX_RADIOS
+#define RADIO_REGISTRY_MAX_RADIOS 2
+#endif
+
+/*!
+ * @brief Binding of a radio plugged on the Arduino connector, as expected by the shields
+ */
+#define RADIO_REGISTRY_BINDING_ARDUINO                                            \
+    {                                                                             \
+        .spi = SPI1, .busy = SMTC_SHIELD_PINOUT_D3, .irq = SMTC_SHIELD_PINOUT_D5, \
+        .nss = SMTC_SHIELD_PINOUT_D7, .reset = SMTC_SHIELD_PINOUT_A0,             \
+    }
+
+/*!
+ * @brief Binding of a second radio wired to SPI3 (PC10 / PC11 / PC12 on the morpho connector) and to Arduino pins left
+ * free by the shields
+ *
+ * @remark The DIO line (D9 - PC7) is on EXTI line 7, so it does not share its interrupt with the first radio (D5 - PB4)
+ */
+#define RADIO_REGISTRY_BINDING_SECONDARY                                          \
+    {                                                                             \
+        .spi = SPI3, .busy = SMTC_SHIELD_PINOUT_D6, .irq = SMTC_SHIELD_PINOUT_D9, \
+        .nss = SMTC_SHIELD_PINOUT_D10, .reset = SMTC_SHIELD_PINOUT_A1,            \
+    }
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*!
+ * @brief MCU resources a radio is wired to
+ *
+ * @remark Each radio needs its own NSS, BUSY, DIO and RESET lines. Radios can share a SPI bus: transactions are never
+ * interleaved as they all run from the main loop
+ */
+typedef struct radio_registry_binding_s
+{
+    SPI_TypeDef*         spi;    //!< SPI peripheral, SPI1 or SPI3
+    smtc_shield_pinout_t busy;   //!< BUSY input
+    smtc_shield_pinout_t irq;    //!< DIO interrupt input - must not share its EXTI line with another radio
+    smtc_shield_pinout_t nss;    //!< SPI chip select output
+    smtc_shield_pinout_t reset;  //!< Reset output
+} radio_registry_binding_t;
+
+/*!
+ * @brief Interrupt handler of a radio, called by radio_registry_dispatch when DIO events are waiting
+ *
+ * @param [in] context  Radio HAL context given to radio_registry_add
+ * @param [in] irq_filter_mask  Interrupts to be processed, passed on from radio_registry_dispatch
+ */
+typedef void ( *radio_registry_handler_t )( void* context, uint32_t irq_filter_mask );
+
+/*!
+ * @brief Radio registered to the dispatcher
+ */
+typedef struct radio_registry_entry_s
+{
+    void*                    context;    //!< Radio HAL context - NULL if the slot is free
+    radio_registry_handler_t handler;    //!< Chip-specific interrupt handler
+    radio_irq_queue_t        irq_queue;  //!< DIO events of this radio only
+} radio_registry_entry_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * @brief Register a radio and reset its interrupt queue
+ *
+ * @param [in] radio_id  Index of the radio, lower than RADIO_REGISTRY_MAX_RADIOS
+ * @param [in] context  Radio HAL context
+ * @param [in] handler  Chip-specific interrupt handler
+ *
+ * @returns The interrupt queue of the radio, to be given as context to its DIO interrupt callback - NULL if radio_id
+ * is out of range
+ */
+radio_irq_queue_t* radio_registry_add( uint8_t radio_id, void* context, radio_registry_handler_t handler );
+
+/*!
+ * @brief Get the HAL context of a registered radio
+ *
+ * @param [in] radio_id  Index of the radio
+ *
+ * @returns The radio HAL context, NULL if no radio has been registered at this index
+ */
+void* radio_registry_get_context( uint8_t radio_id );
+
+/*!
+ * @brief Get the index of a registered radio
+ *
+ * @param [in] context  Radio HAL context
+ *
+ * @returns The index of the radio, RADIO_REGISTRY_MAX_RADIOS if the context is not registered
+ */
+uint8_t radio_registry_get_id( const void* context );
+
+/*!
+ * @brief Get the interrupt queue of a registered radio
+ *
+ * @param [in] context  Radio HAL context
+ *
+ * @returns The interrupt queue of the radio, NULL if the context is not registered
+ */
+radio_irq_queue_t* radio_registry_get_irq_queue( const void* context );
+
+/*!
+ * @brief Check if DIO events are waiting for any of the registered radios
+ *
+ * @returns true if at least one interrupt queue is not empty
+ */
+bool radio_registry_is_event_pending( void );
+
+/*!
+ * @brief Call the interrupt handler of every radio with DIO events waiting
+ *
+ * @remark The radio served first rotates from one call to the next, so that a radio raising interrupts back to back
+ * cannot delay the others by more than one handler call
+ *
+ * @param [in] irq_filter_mask  Interrupts to be processed, passed on to the handlers
+ */
+void radio_registry_dispatch( uint32_t irq_filter_mask );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RADIO_REGISTRY_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -45,6 +45,7 @@ extern "C" {
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdarg.h>
 #include "smtc_hal_mcu_uart.h"
 #include "stm32l4xx.h"                  // Device header
@@ -54,6 +55,11 @@ extern "C" {
  * --- PUBLIC MACROS -----------------------------------------------------------
  */
 
+/**
+ * @brief Baudrate of the trace UART, 8N1 so that one byte takes 10 bit times on the line
+ */
+#define UART_BAUDRATE 921600
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC CONSTANTS --------------------------------------------------------
@@ -89,8 +95,45 @@ void uart_init_with_rx_callback( void ( *callback_rx )( uint8_t data ) );
 
 void vprint( const char* fmt, va_list argp );
 
+/**
+ * @brief Send raw bytes on the trace UART, e.g. binary frames interleaved with the text traces
+ *
+ * @param[in] buffer Bytes to send
+ * @param[in] length Number of bytes
+ */
+void uart_send_bytes( const uint8_t* buffer, uint16_t length );
+
+/**
+ * @brief Block and process AT commands until AT+START is received
+ *
+ * @see uart_process_at_command
+ */
 int main_loop(void);
 
+/**
+ * @brief Check if an AT command has been received and is waiting to be processed
+ *
+ * @remark Can be given to smtc_hal_mcu_lpm_wait_for_event to sleep until a command is received
+ *
+ * @returns true if an AT command is pending, false otherwise
+ */
+bool uart_is_at_command_pending(void);
+
+/**
+ * @brief Process the last AT command received, if any, without blocking
+ *
+ * Allows AT parameters to be changed while an application is running, e.g. to be applied with
+ * apps_radio_reconfigure.
+ *
+ * @returns true if an AT command has been processed, false otherwise
+ */
+bool uart_process_at_command(void);
+
+/**
+ * @brief Print the time spent in each MCU power mode since AT+START
+ */
+void uart_print_lpm_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
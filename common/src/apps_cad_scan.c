@@ -0,0 +1,354 @@
+/*!
+ * @file      apps_cad_scan.c
+ *
+ * @brief     Multi-channel CAD scanner: chained CADs over a channel list, per-channel occupancy and quietest channel
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "apps_cad_scan.h"
+#include "apps_radio.h"
+#include "smtc_hal_mcu.h"
+#include "smtc_hal_dbg_trace.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static struct
+{
+    const apps_radio_t*     radio;
+    apps_radio_cad_params_t cad_params;
+    apps_cad_scan_channel_t channels[APPS_CAD_SCAN_NB_CHANNELS_MAX];
+    uint8_t                 nb_channels;
+    uint8_t                 channel_index;        //!< Channel of the CAD in progress
+    uint32_t                channel_start_in_us;  //!< Time the CAD in progress was retuned
+    uint32_t                nb_sweeps;            //!< Passes to run, 0 until apps_cad_scan_stop
+    uint32_t                nb_sweeps_done;
+    uint32_t                last_cad_done_in_us;
+    uint64_t                duration_in_us;  //!< Time spent scanning, including the dispatch of the interrupts
+    bool                    is_running;
+    bool                    is_stop_requested;
+} scan;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * @brief Retune to the channel of scan.channel_index and start the frequency synthesizer
+ *
+ * @remark The PLL locks while the caller records the result of the previous CAD
+ */
+static void apps_cad_scan_tune( void );
+
+/*!
+ * @brief Record the result of a CAD
+ *
+ * @param [in, out] channel  Channel the CAD ran on
+ * @param [in] is_detected  true if LoRa activity was detected
+ * @param [in] scan_time_in_us  Time from the retune to the end of the CAD
+ */
+static void apps_cad_scan_record( apps_cad_scan_channel_t* channel, bool is_detected, uint32_t scan_time_in_us );
+
+/*!
+ * @brief Clear the statistics of a channel, keeping its frequency
+ *
+ * @param [out] channel  Channel
+ */
+static void apps_cad_scan_reset_channel( apps_cad_scan_channel_t* channel );
+
+/*!
+ * @brief Compute a ratio in per mille
+ *
+ * @param [in] numerator  Numerator
+ * @param [in] denominator  Denominator
+ *
+ * @returns numerator * 1000 / denominator, 0 if denominator is 0
+ */
+static uint32_t apps_cad_scan_per_mille( uint64_t numerator, uint64_t denominator );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+bool apps_cad_scan_init( const apps_radio_t* radio, const uint32_t* freqs_in_hz, uint8_t nb_channels,
+                         const apps_radio_cad_params_t* cad_params )
+{
+    if( ( radio == NULL ) || ( freqs_in_hz == NULL ) || ( cad_params == NULL ) || ( nb_channels == 0 ) ||
+        ( nb_channels > APPS_CAD_SCAN_NB_CHANNELS_MAX ) )
+    {
+        return false;
+    }
+
+    memset( &scan, 0, sizeof( scan ) );
+    scan.radio                = radio;
+    scan.cad_params           = *cad_params;
+    scan.cad_params.exit_mode = APPS_RADIO_CAD_EXIT_MODE_STANDBY;
+    scan.nb_channels          = nb_channels;
+
+    for( uint8_t i = 0; i < nb_channels; i++ )
+    {
+        scan.channels[i].freq_in_hz = freqs_in_hz[i];
+        apps_cad_scan_reset_channel( &scan.channels[i] );
+    }
+    return true;
+}
+
+void apps_cad_scan_start( uint32_t nb_sweeps )
+{
+    if( ( scan.nb_channels == 0 ) || ( scan.is_running == true ) )
+    {
+        return;
+    }
+
+    scan.nb_sweeps         = nb_sweeps;
+    scan.nb_sweeps_done    = 0;
+    scan.channel_index     = 0;
+    scan.is_stop_requested = false;
+    scan.is_running        = true;
+
+    apps_cad_scan_tune( );
+    scan.last_cad_done_in_us = scan.channel_start_in_us;
+
+    // The parameters are written once: the following CADs are restarted from the CAD_DONE interrupt
+    apps_radio_start_cad( scan.radio, &scan.cad_params );
+}
+
+void apps_cad_scan_stop( void )
+{
+    scan.is_stop_requested = true;
+}
+
+bool apps_cad_scan_is_running( void )
+{
+    return scan.is_running;
+}
+
+void apps_cad_scan_on_radio_irq( const apps_radio_t* radio, apps_radio_irq_mask_t irq )
+{
+    ( void ) radio;
+
+    if( ( scan.is_running == false ) || ( ( irq & APPS_RADIO_IRQ_CAD_DONE ) == 0 ) )
+    {
+        return;
+    }
+
+    const uint32_t                 cad_done_in_us  = apps_radio_get_irq_timestamp_in_us( );
+    apps_cad_scan_channel_t* const channel         = &scan.channels[scan.channel_index];
+    const uint32_t                 scan_time_in_us = cad_done_in_us - scan.channel_start_in_us;
+
+    scan.duration_in_us += cad_done_in_us - scan.last_cad_done_in_us;
+    scan.last_cad_done_in_us = cad_done_in_us;
+
+    scan.channel_index++;
+    if( scan.channel_index == scan.nb_channels )
+    {
+        scan.channel_index = 0;
+        scan.nb_sweeps_done++;
+        if( ( scan.nb_sweeps != 0 ) && ( scan.nb_sweeps_done == scan.nb_sweeps ) )
+        {
+            scan.is_stop_requested = true;
+        }
+    }
+
+    // The next channel is tuned first, so that its PLL locks while this result is recorded
+    if( scan.is_stop_requested == false )
+    {
+        apps_cad_scan_tune( );
+    }
+
+    apps_cad_scan_record( channel, ( irq & APPS_RADIO_IRQ_CAD_DETECTED ) != 0, scan_time_in_us );
+
+    if( scan.is_stop_requested == false )
+    {
+        apps_radio_restart_cad( scan.radio );
+    }
+    else
+    {
+        scan.is_running = false;
+    }
+}
+
+bool apps_cad_scan_get_quietest_channel( uint8_t* channel_index )
+{
+    const apps_cad_scan_channel_t* quietest = NULL;
+
+    for( uint8_t i = 0; i < scan.nb_channels; i++ )
+    {
+        const apps_cad_scan_channel_t* channel = &scan.channels[i];
+
+        if( channel->nb_cad == 0 )
+        {
+            continue;
+        }
+
+        // Busy shares are compared with cross products to stay in integers
+        if( ( quietest == NULL ) || ( channel->occupancy < quietest->occupancy ) ||
+            ( ( channel->occupancy == quietest->occupancy ) &&
+              ( ( ( uint64_t ) channel->nb_detected * quietest->nb_cad ) <
+                ( ( uint64_t ) quietest->nb_detected * channel->nb_cad ) ) ) )
+        {
+            quietest       = channel;
+            *channel_index = i;
+        }
+    }
+    return quietest != NULL;
+}
+
+const apps_cad_scan_channel_t* apps_cad_scan_get_channel( uint8_t channel_index )
+{
+    return ( channel_index < scan.nb_channels ) ? &scan.channels[channel_index] : NULL;
+}
+
+void apps_cad_scan_reset_stats( void )
+{
+    for( uint8_t i = 0; i < scan.nb_channels; i++ )
+    {
+        apps_cad_scan_reset_channel( &scan.channels[i] );
+    }
+    scan.nb_sweeps_done = 0;
+    scan.duration_in_us = 0;
+}
+
+void apps_cad_scan_print( void )
+{
+    uint32_t nb_cad = 0;
+    uint8_t  quietest_index;
+
+    for( uint8_t i = 0; i < scan.nb_channels; i++ )
+    {
+        nb_cad += scan.channels[i].nb_cad;
+    }
+
+    HAL_DBG_TRACE_PRINTF( "CADSCAN,channels=%u,sweeps=%u,cads=%u,duration_ms=%u,cads_per_s=%u\n",
+                          ( unsigned int ) scan.nb_channels, ( unsigned int ) scan.nb_sweeps_done,
+                          ( unsigned int ) nb_cad, ( unsigned int ) ( scan.duration_in_us / 1000 ),
+                          ( unsigned int ) apps_cad_scan_per_mille( ( uint64_t ) nb_cad * 1000, scan.duration_in_us ) );
+
+    for( uint8_t i = 0; i < scan.nb_channels; i++ )
+    {
+        const apps_cad_scan_channel_t* channel   = &scan.channels[i];
+        const uint32_t                 busy      = apps_cad_scan_per_mille( channel->nb_detected, channel->nb_cad );
+        const uint32_t                 occupancy =
+            apps_cad_scan_per_mille( channel->occupancy, APPS_CAD_SCAN_OCCUPANCY_ONE );
+
+        HAL_DBG_TRACE_PRINTF( "CADSCAN,channel=%u,freq_hz=%u,cads=%u,detected=%u,busy=%u.%u%%,occupancy=%u.%u%%",
+                              ( unsigned int ) i, ( unsigned int ) channel->freq_in_hz,
+                              ( unsigned int ) channel->nb_cad, ( unsigned int ) channel->nb_detected,
+                              ( unsigned int ) ( busy / 10 ), ( unsigned int ) ( busy % 10 ),
+                              ( unsigned int ) ( occupancy / 10 ), ( unsigned int ) ( occupancy % 10 ) );
+        if( channel->nb_cad > 0 )
+        {
+            HAL_DBG_TRACE_PRINTF( ",scan_us_min=%u,avg=%u,max=%u", ( unsigned int ) channel->scan_time_min_in_us,
+                                  ( unsigned int ) ( channel->scan_time_sum_in_us / channel->nb_cad ),
+                                  ( unsigned int ) channel->scan_time_max_in_us );
+        }
+        HAL_DBG_TRACE_PRINTF( "\n" );
+    }
+
+    if( apps_cad_scan_get_quietest_channel( &quietest_index ) == true )
+    {
+        HAL_DBG_TRACE_PRINTF( "CADSCAN,quietest,channel=%u,freq_hz=%u\n", ( unsigned int ) quietest_index,
+                              ( unsigned int ) scan.channels[quietest_index].freq_in_hz );
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void apps_cad_scan_tune( void )
+{
+    scan.channel_start_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+    apps_radio_set_rf_freq( scan.radio, scan.channels[scan.channel_index].freq_in_hz );
+    apps_radio_set_fs( scan.radio );
+}
+
+static void apps_cad_scan_record( apps_cad_scan_channel_t* channel, bool is_detected, uint32_t scan_time_in_us )
+{
+    const int32_t target = ( is_detected == true ) ? ( int32_t ) APPS_CAD_SCAN_OCCUPANCY_ONE : 0;
+
+    channel->nb_cad++;
+    channel->nb_detected += ( is_detected == true ) ? 1 : 0;
+    channel->occupancy =
+        ( uint16_t ) ( channel->occupancy + ( ( target - channel->occupancy ) >> APPS_CAD_SCAN_OCCUPANCY_SHIFT ) );
+
+    channel->scan_time_sum_in_us += scan_time_in_us;
+    if( scan_time_in_us < channel->scan_time_min_in_us )
+    {
+        channel->scan_time_min_in_us = scan_time_in_us;
+    }
+    if( scan_time_in_us > channel->scan_time_max_in_us )
+    {
+        channel->scan_time_max_in_us = scan_time_in_us;
+    }
+}
+
+static void apps_cad_scan_reset_channel( apps_cad_scan_channel_t* channel )
+{
+    const uint32_t freq_in_hz = channel->freq_in_hz;
+
+    memset( channel, 0, sizeof( *channel ) );
+    channel->freq_in_hz          = freq_in_hz;
+    channel->scan_time_min_in_us = UINT32_MAX;
+}
+
+static uint32_t apps_cad_scan_per_mille( uint64_t numerator, uint64_t denominator )
+{
+    return ( denominator > 0 ) ? ( uint32_t ) ( ( numerator * 1000 ) / denominator ) : 0;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,551 @@
+/*!
+ * @file      apps_cad_tuner.c
+ *
+ * @brief     Adaptive CAD tuning: detection peak and symbol count learned from false alarms and misses
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "apps_cad_tuner.h"
+#include "apps_kv_store.h"
+#include "smtc_kv_store.h"
+#include "smtc_hal_dbg_trace.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * @brief Version of the record layout kept in the key-value store
+ */
+#define APPS_CAD_TUNER_RECORDS_VERSION 1
+
+/*!
+ * @brief Names of the moves in the traces
+ */
+static const char* const move_names[] = { "none", "more_sensitive", "less_sensitive", "cheaper" };
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*!
+ * @brief Change of setting tried by the tuner
+ */
+typedef enum apps_cad_tuner_move_e
+{
+    APPS_CAD_TUNER_MOVE_NONE = 0,
+    APPS_CAD_TUNER_MOVE_MORE_SENSITIVE,  //!< Lower peak, or more symbols once at the lowest peak
+    APPS_CAD_TUNER_MOVE_LESS_SENSITIVE,  //!< Higher peak, or more symbols once at the highest peak
+    APPS_CAD_TUNER_MOVE_CHEAPER,         //!< Fewer symbols
+} apps_cad_tuner_move_t;
+
+/*!
+ * @brief Reception the tuner is waiting for
+ */
+typedef enum apps_cad_tuner_rx_e
+{
+    APPS_CAD_TUNER_RX_NONE = 0,
+    APPS_CAD_TUNER_RX_DETECTION,  //!< Reception following a detection
+    APPS_CAD_TUNER_RX_AUDIT,      //!< Reception following a CAD without detection
+} apps_cad_tuner_rx_t;
+
+/*!
+ * @brief CAD setting
+ */
+typedef struct apps_cad_tuner_setting_s
+{
+    uint8_t nb_symbols;
+    uint8_t detect_peak;
+} apps_cad_tuner_setting_t;
+
+/*!
+ * @brief Setting learned for a channel, as kept in the key-value store
+ */
+typedef struct apps_cad_tuner_record_s
+{
+    uint32_t                 freq_in_hz;
+    uint8_t                  sf;
+    uint8_t                  bw;
+    apps_cad_tuner_setting_t setting;
+} apps_cad_tuner_record_t;
+
+/*!
+ * @brief Records of all the channels, the most recently learned last
+ */
+typedef struct apps_cad_tuner_records_s
+{
+    uint16_t                version;
+    uint16_t                nb_records;
+    apps_cad_tuner_record_t records[APPS_CAD_TUNER_NB_CHANNELS_MAX];
+} apps_cad_tuner_records_t;
+
+/*!
+ * @brief Counters of an evaluation epoch
+ */
+typedef struct apps_cad_tuner_epoch_s
+{
+    uint32_t nb_cad;
+    uint32_t nb_detected;
+    uint32_t nb_packets;       //!< Detections followed by a valid header
+    uint32_t nb_false_alarms;  //!< Detections not followed by a valid header
+    uint32_t nb_audits;
+    uint32_t nb_misses;     //!< Audits which received a packet
+    uint64_t energy_in_us;  //!< Radio time spent in CAD and in the receptions following a detection
+} apps_cad_tuner_epoch_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static struct
+{
+    apps_cad_tuner_record_t  channel;  //!< Channel being tuned, with its current setting
+    apps_cad_tuner_bounds_t  bounds;
+    apps_cad_tuner_setting_t base;        //!< Last accepted setting
+    uint32_t                 base_score;  //!< Radio time per packet of the base setting, in us
+    apps_cad_tuner_move_t    probe;       //!< Move under evaluation, NONE when running the base setting
+    apps_cad_tuner_move_t    rejected;    //!< Last move which did worse than the base setting
+    apps_cad_tuner_epoch_t   epoch;
+    apps_cad_tuner_rx_t      pending_rx;
+    uint32_t                 nb_cad_without_detection;
+    uint32_t                 nb_epochs;
+    uint32_t                 nb_accepted;
+    uint32_t                 nb_rejected;
+    bool                     is_changed;  //!< Setting not yet handed out by apps_cad_tuner_get_params
+    bool                     is_init;
+} tuner;
+
+static apps_cad_tuner_records_t records;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * @brief Load the records from the key-value store, starting empty if there are none or if they are not readable
+ */
+static void apps_cad_tuner_load_records( void );
+
+/*!
+ * @brief Store the setting accepted for the current channel, as the most recently learned record
+ */
+static void apps_cad_tuner_save_record( void );
+
+/*!
+ * @brief Evaluate the epoch which just ended, then accept or revert the probe, or start a new one
+ */
+static void apps_cad_tuner_end_epoch( void );
+
+/*!
+ * @brief Choose the move to try from the miss and false alarm rates of the epoch
+ *
+ * @param [in] epoch  Counters of the epoch
+ *
+ * @returns The move, NONE if there was no traffic to judge from
+ */
+static apps_cad_tuner_move_t apps_cad_tuner_choose_move( const apps_cad_tuner_epoch_t* epoch );
+
+/*!
+ * @brief Apply a move to a setting, within the bounds
+ *
+ * @param [in] move  Move
+ * @param [in, out] setting  Setting
+ *
+ * @returns false if the setting is already at the bound in the direction of the move
+ */
+static bool apps_cad_tuner_apply_move( apps_cad_tuner_move_t move, apps_cad_tuner_setting_t* setting );
+
+/*!
+ * @brief Compute a ratio in per mille
+ *
+ * @param [in] numerator  Numerator
+ * @param [in] denominator  Denominator
+ *
+ * @returns numerator * 1000 / denominator, 0 if denominator is 0
+ */
+static uint32_t apps_cad_tuner_per_mille( uint32_t numerator, uint32_t denominator );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void apps_cad_tuner_init( uint32_t freq_in_hz, apps_radio_lora_sf_t sf, apps_radio_lora_bw_t bw,
+                          const apps_radio_cad_params_t* default_params, const apps_cad_tuner_bounds_t* bounds )
+{
+    memset( &tuner, 0, sizeof( tuner ) );
+    tuner.channel.freq_in_hz          = freq_in_hz;
+    tuner.channel.sf                  = ( uint8_t ) sf;
+    tuner.channel.bw                  = ( uint8_t ) bw;
+    tuner.channel.setting.nb_symbols  = default_params->nb_symbols;
+    tuner.channel.setting.detect_peak = default_params->detect_peak;
+    tuner.bounds                      = *bounds;
+    tuner.base_score                  = UINT32_MAX;
+
+    apps_cad_tuner_load_records( );
+    for( uint16_t i = 0; i < records.nb_records; i++ )
+    {
+        const apps_cad_tuner_record_t* record = &records.records[i];
+
+        if( ( record->freq_in_hz == freq_in_hz ) && ( record->sf == tuner.channel.sf ) &&
+            ( record->bw == tuner.channel.bw ) )
+        {
+            tuner.channel.setting = record->setting;
+            HAL_DBG_TRACE_INFO( "CAD setting restored from flash: %u symbols, peak %u\n",
+                                ( unsigned int ) record->setting.nb_symbols,
+                                ( unsigned int ) record->setting.detect_peak );
+        }
+    }
+
+    tuner.base       = tuner.channel.setting;
+    tuner.is_changed = true;
+    tuner.is_init    = true;
+}
+
+bool apps_cad_tuner_get_params( apps_radio_cad_params_t* params )
+{
+    const bool is_changed = tuner.is_changed;
+
+    params->nb_symbols  = tuner.channel.setting.nb_symbols;
+    params->detect_peak = tuner.channel.setting.detect_peak;
+    tuner.is_changed    = false;
+    return is_changed;
+}
+
+uint32_t apps_cad_tuner_on_cad_done( bool is_detected, uint32_t cad_time_in_us )
+{
+    uint32_t audit_time_in_ms = 0;
+
+    if( tuner.is_init == false )
+    {
+        return 0;
+    }
+
+    tuner.epoch.nb_cad++;
+    tuner.epoch.energy_in_us += cad_time_in_us;
+
+    if( is_detected == true )
+    {
+        tuner.epoch.nb_detected++;
+        tuner.pending_rx = APPS_CAD_TUNER_RX_DETECTION;
+        return 0;
+    }
+
+    tuner.nb_cad_without_detection++;
+    if( ( tuner.nb_cad_without_detection % APPS_CAD_TUNER_AUDIT_PERIOD ) == 0 )
+    {
+        // The CAD lasts about its number of symbols: the audit covers the symbols a packet needs to be received
+        const uint64_t audit_time_in_us = ( ( uint64_t ) cad_time_in_us * APPS_CAD_TUNER_AUDIT_WINDOW_IN_SYMB ) /
+                                          tuner.channel.setting.nb_symbols;
+
+        audit_time_in_ms = ( uint32_t ) ( ( audit_time_in_us + 999 ) / 1000 );
+        tuner.pending_rx = APPS_CAD_TUNER_RX_AUDIT;
+        return audit_time_in_ms;
+    }
+
+    if( tuner.epoch.nb_cad >= APPS_CAD_TUNER_EPOCH_NB_CAD )
+    {
+        apps_cad_tuner_end_epoch( );
+    }
+    return audit_time_in_ms;
+}
+
+void apps_cad_tuner_on_rx_end( bool is_header_valid, uint32_t rx_time_in_us )
+{
+    if( tuner.pending_rx == APPS_CAD_TUNER_RX_DETECTION )
+    {
+        tuner.epoch.energy_in_us += rx_time_in_us;
+        if( is_header_valid == true )
+        {
+            tuner.epoch.nb_packets++;
+        }
+        else
+        {
+            tuner.epoch.nb_false_alarms++;
+        }
+    }
+    else if( tuner.pending_rx == APPS_CAD_TUNER_RX_AUDIT )
+    {
+        // Audits measure the tuner and are left out of the energy of the setting
+        tuner.epoch.nb_audits++;
+        if( is_header_valid == true )
+        {
+            tuner.epoch.nb_misses++;
+        }
+    }
+    else
+    {
+        return;
+    }
+
+    tuner.pending_rx = APPS_CAD_TUNER_RX_NONE;
+    if( tuner.epoch.nb_cad >= APPS_CAD_TUNER_EPOCH_NB_CAD )
+    {
+        apps_cad_tuner_end_epoch( );
+    }
+}
+
+bool apps_cad_tuner_clear( void )
+{
+    const smtc_kv_store_status_t status = smtc_kv_store_delete( apps_kv_store_get( ), APPS_KV_STORE_KEY_CAD_TUNING );
+
+    memset( &records, 0, sizeof( records ) );
+    return ( status == SMTC_KV_STORE_STATUS_OK ) || ( status == SMTC_KV_STORE_STATUS_NOT_FOUND );
+}
+
+void apps_cad_tuner_print( void )
+{
+    const apps_cad_tuner_epoch_t* epoch = &tuner.epoch;
+
+    if( tuner.is_init == false )
+    {
+        HAL_DBG_TRACE_PRINTF( "CADTUNE,disabled\n" );
+        return;
+    }
+
+    HAL_DBG_TRACE_PRINTF( "CADTUNE,freq_hz=%u,sf=%u,bw=%u,symbols=%u,peak=%u,probe=%s,epochs=%u,accepted=%u,"
+                          "rejected=%u,stored_channels=%u\n",
+                          ( unsigned int ) tuner.channel.freq_in_hz, ( unsigned int ) tuner.channel.sf,
+                          ( unsigned int ) tuner.channel.bw, ( unsigned int ) tuner.channel.setting.nb_symbols,
+                          ( unsigned int ) tuner.channel.setting.detect_peak, move_names[tuner.probe],
+                          ( unsigned int ) tuner.nb_epochs, ( unsigned int ) tuner.nb_accepted,
+                          ( unsigned int ) tuner.nb_rejected, ( unsigned int ) records.nb_records );
+    HAL_DBG_TRACE_PRINTF( "CADTUNE,epoch,cads=%u,detected=%u,packets=%u,false_alarms=%u,audits=%u,misses=%u,"
+                          "energy_us=%u\n",
+                          ( unsigned int ) epoch->nb_cad, ( unsigned int ) epoch->nb_detected,
+                          ( unsigned int ) epoch->nb_packets, ( unsigned int ) epoch->nb_false_alarms,
+                          ( unsigned int ) epoch->nb_audits, ( unsigned int ) epoch->nb_misses,
+                          ( unsigned int ) epoch->energy_in_us );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void apps_cad_tuner_load_records( void )
+{
+    uint16_t length;
+
+    if( ( smtc_kv_store_read( apps_kv_store_get( ), APPS_KV_STORE_KEY_CAD_TUNING, ( uint8_t* ) &records,
+                              sizeof( records ), &length ) != SMTC_KV_STORE_STATUS_OK ) ||
+        ( records.version != APPS_CAD_TUNER_RECORDS_VERSION ) ||
+        ( records.nb_records > APPS_CAD_TUNER_NB_CHANNELS_MAX ) ||
+        ( length != ( offsetof( apps_cad_tuner_records_t, records ) +
+                      records.nb_records * sizeof( apps_cad_tuner_record_t ) ) ) )
+    {
+        memset( &records, 0, sizeof( records ) );
+    }
+    records.version = APPS_CAD_TUNER_RECORDS_VERSION;
+}
+
+static void apps_cad_tuner_save_record( void )
+{
+    uint16_t               index = 0;
+    smtc_kv_store_status_t status;
+
+    // The record of the channel is moved last; when full, the least recently learned one is dropped
+    while( ( index < records.nb_records ) &&
+           ( ( records.records[index].freq_in_hz != tuner.channel.freq_in_hz ) ||
+             ( records.records[index].sf != tuner.channel.sf ) || ( records.records[index].bw != tuner.channel.bw ) ) )
+    {
+        index++;
+    }
+    if( index == APPS_CAD_TUNER_NB_CHANNELS_MAX )
+    {
+        index = 0;
+    }
+    if( index < records.nb_records )
+    {
+        memmove( &records.records[index], &records.records[index + 1],
+                 ( records.nb_records - index - 1 ) * sizeof( apps_cad_tuner_record_t ) );
+        records.nb_records--;
+    }
+    records.records[records.nb_records++] = tuner.channel;
+
+    status = smtc_kv_store_write(
+        apps_kv_store_get( ), APPS_KV_STORE_KEY_CAD_TUNING, ( const uint8_t* ) &records,
+        ( uint16_t ) ( offsetof( apps_cad_tuner_records_t, records ) +
+                       records.nb_records * sizeof( apps_cad_tuner_record_t ) ) );
+    if( ( status != SMTC_KV_STORE_STATUS_OK ) && ( status != SMTC_KV_STORE_STATUS_NOT_INIT ) )
+    {
+        HAL_DBG_TRACE_WARNING( "CAD setting not saved (%d)\n", status );
+    }
+}
+
+static void apps_cad_tuner_end_epoch( void )
+{
+    const apps_cad_tuner_epoch_t epoch = tuner.epoch;
+    const uint32_t               score =
+        ( epoch.nb_packets > 0 ) ? ( uint32_t ) ( epoch.energy_in_us / epoch.nb_packets ) : UINT32_MAX;
+
+    memset( &tuner.epoch, 0, sizeof( tuner.epoch ) );
+    tuner.nb_epochs++;
+
+    HAL_DBG_TRACE_INFO( "CAD epoch: %u symbols, peak %u, %u packets, %u false alarms, %u misses in %u audits, "
+                        "%u us per packet\n",
+                        ( unsigned int ) tuner.channel.setting.nb_symbols,
+                        ( unsigned int ) tuner.channel.setting.detect_peak, ( unsigned int ) epoch.nb_packets,
+                        ( unsigned int ) epoch.nb_false_alarms, ( unsigned int ) epoch.nb_misses,
+                        ( unsigned int ) epoch.nb_audits, ( unsigned int ) score );
+
+    if( tuner.probe != APPS_CAD_TUNER_MOVE_NONE )
+    {
+        // A probe is kept only if it needs no more radio time per packet than the setting it moved from
+        if( score <= tuner.base_score )
+        {
+            tuner.nb_accepted++;
+            tuner.rejected   = APPS_CAD_TUNER_MOVE_NONE;
+            tuner.base       = tuner.channel.setting;
+            tuner.base_score = score;
+            apps_cad_tuner_save_record( );
+        }
+        else
+        {
+            tuner.nb_rejected++;
+            tuner.rejected        = tuner.probe;
+            tuner.channel.setting = tuner.base;
+            tuner.is_changed      = true;
+        }
+        tuner.probe = APPS_CAD_TUNER_MOVE_NONE;
+        return;
+    }
+
+    tuner.base_score = score;
+    if( score == UINT32_MAX )
+    {
+        // Without a packet the base setting has no score a probe could be judged against: run it for another epoch
+        return;
+    }
+
+    tuner.probe = apps_cad_tuner_choose_move( &epoch );
+    if( ( tuner.probe != APPS_CAD_TUNER_MOVE_NONE ) &&
+        ( apps_cad_tuner_apply_move( tuner.probe, &tuner.channel.setting ) == true ) )
+    {
+        tuner.is_changed = true;
+    }
+    else
+    {
+        tuner.probe = APPS_CAD_TUNER_MOVE_NONE;
+    }
+}
+
+static apps_cad_tuner_move_t apps_cad_tuner_choose_move( const apps_cad_tuner_epoch_t* epoch )
+{
+    apps_cad_tuner_move_t move;
+
+    if( ( epoch->nb_packets == 0 ) && ( epoch->nb_misses == 0 ) && ( epoch->nb_false_alarms == 0 ) )
+    {
+        return APPS_CAD_TUNER_MOVE_NONE;
+    }
+
+    if( apps_cad_tuner_per_mille( epoch->nb_misses, epoch->nb_audits ) > APPS_CAD_TUNER_MISS_RATE_MAX )
+    {
+        move = APPS_CAD_TUNER_MOVE_MORE_SENSITIVE;
+    }
+    else if( apps_cad_tuner_per_mille( epoch->nb_false_alarms, epoch->nb_cad ) > APPS_CAD_TUNER_FALSE_ALARM_RATE_MAX )
+    {
+        move = APPS_CAD_TUNER_MOVE_LESS_SENSITIVE;
+    }
+    else
+    {
+        move = ( tuner.channel.setting.nb_symbols > tuner.bounds.nb_symbols_min ) ? APPS_CAD_TUNER_MOVE_CHEAPER
+                                                                                  : APPS_CAD_TUNER_MOVE_LESS_SENSITIVE;
+    }
+
+    // Do not try again right away what just failed: alternate with the cheapest other move
+    if( move == tuner.rejected )
+    {
+        move = ( move == APPS_CAD_TUNER_MOVE_CHEAPER ) ? APPS_CAD_TUNER_MOVE_LESS_SENSITIVE
+                                                       : APPS_CAD_TUNER_MOVE_CHEAPER;
+    }
+    return move;
+}
+
+static bool apps_cad_tuner_apply_move( apps_cad_tuner_move_t move, apps_cad_tuner_setting_t* setting )
+{
+    switch( move )
+    {
+    case APPS_CAD_TUNER_MOVE_MORE_SENSITIVE:
+        if( setting->detect_peak >= tuner.bounds.detect_peak_min + APPS_CAD_TUNER_PEAK_STEP )
+        {
+            setting->detect_peak -= APPS_CAD_TUNER_PEAK_STEP;
+            return true;
+        }
+        break;
+    case APPS_CAD_TUNER_MOVE_LESS_SENSITIVE:
+        if( setting->detect_peak + APPS_CAD_TUNER_PEAK_STEP <= tuner.bounds.detect_peak_max )
+        {
+            setting->detect_peak += APPS_CAD_TUNER_PEAK_STEP;
+            return true;
+        }
+        break;
+    case APPS_CAD_TUNER_MOVE_CHEAPER:
+        if( setting->nb_symbols / 2 >= tuner.bounds.nb_symbols_min )
+        {
+            setting->nb_symbols /= 2;
+            return true;
+        }
+        return false;
+    default:
+        return false;
+    }
+
+    // At the end of the peak range, more symbols both detect weaker packets and reject more noise
+    if( setting->nb_symbols * 2 <= tuner.bounds.nb_symbols_max )
+    {
+        setting->nb_symbols *= 2;
+        return true;
+    }
+    return false;
+}
+
+static uint32_t apps_cad_tuner_per_mille( uint32_t numerator, uint32_t denominator )
+{
+    return ( denominator > 0 ) ? ( uint32_t ) ( ( ( uint64_t ) numerator * 1000 ) / denominator ) : 0;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
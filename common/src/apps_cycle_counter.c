@@ -1,10 +1,10 @@
 /*!
- * @file      main_tx_cw.c
+ * @file      apps_cycle_counter.c
  *
- * @brief     Execute Tx Continuous Wave for LR11xx chip
+ * @brief     Cortex-M cycle counter used to time the sample code
  *
  * The Clear BSD License
- * Copyright Semtech Corporation 2022. All rights reserved.
+ * Copyright Semtech Corporation 2024. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted (subject to the limitations in the disclaimer
@@ -37,14 +37,8 @@
  * --- DEPENDENCIES ------------------------------------------------------------
  */
 
-#include <stdio.h>
-#include <string.h>
-
-#include "apps_common.h"
-#include "apps_utilities.h"
-#include "lr11xx_radio.h"
-#include "smtc_hal_dbg_trace.h"
-#include "uart_init.h"
+#include "apps_cycle_counter.h"
+#include "stm32l4xx.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -66,8 +60,6 @@
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-static lr11xx_hal_context_t* context;
-
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -78,28 +70,26 @@ static lr11xx_hal_context_t* context;
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
  */
 
-/**
- * @brief Main application entry point.
- */
-int main( void )
+uint32_t apps_common_cycle_counter_get( void )
 {
-    smtc_hal_mcu_init( );
-    apps_common_shield_init( );
-    uart_init();
-
-    HAL_DBG_TRACE_INFO( "===== LR11xx TX CW example =====\n\n" );
-    apps_common_print_sdk_driver_version( );
+    if( ( DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk ) == 0 )
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
 
-    context = apps_common_lr11xx_get_context( );
+    return DWT->CYCCNT;
+}
 
-    apps_common_lr11xx_system_init( ( void* ) context );
-    apps_common_lr11xx_fetch_and_print_version( ( void* ) context );
-    apps_common_lr11xx_radio_init( ( void* ) context );
+uint32_t apps_common_cycle_counter_to_us( uint32_t cycles )
+{
+    return cycles / ( SystemCoreClock / 1000000 );
+}
 
-    apps_common_lr11xx_handle_pre_tx( );
-    ASSERT_LR11XX_RC( lr11xx_radio_set_tx_cw( context ) );
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
 
-    while( 1 )
-    {
-    }
-}
+/* --- EOF ------------------------------------------------------------------ */
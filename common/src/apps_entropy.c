@@ -0,0 +1,293 @@
+/*!
+ * @file      apps_entropy.c
+ *
+ * @brief     Entropy pool shared by the applications: MCU and radio random number generators behind a DRBG
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "apps_entropy.h"
+#include "smtc_entropy_pool.h"
+#include "smtc_hal_mcu_rng.h"
+#include "smtc_hal_mcu_rng_stm32l4.h"
+#include "smtc_hal_mcu_timer.h"
+#include "smtc_hal_dbg_trace.h"
+#include "stm32l4xx.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Length of the MCU unique ID used as personalization string
+ */
+#define APPS_ENTROPY_UID_LENGTH 12
+
+/**
+ * @brief Number of requests per request size of the benchmark
+ */
+#define APPS_ENTROPY_BENCHMARK_NB_REQUESTS 1000
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static smtc_hal_mcu_rng_inst_t rng_inst = NULL;
+static smtc_entropy_pool_t     entropy_pool;
+
+static uint32_t nb_radio_batches_rejected = 0;
+static uint32_t nb_mcu_failures           = 0;
+static uint32_t radio_harvest_time_in_us  = 0;  //!< Duration of the last accepted radio harvest
+static uint32_t radio_harvest_nb_bytes    = 0;  //!< Size of the last accepted radio harvest
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Read the MCU random number generator
+ *
+ * @param [out] buffer Output buffer
+ * @param [in] length Number of bytes
+ *
+ * @retval true The buffer has been filled
+ * @retval false The generator is not available or reported a clock or seed error
+ */
+static bool apps_entropy_read_mcu( uint8_t* buffer, unsigned int length );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+bool apps_entropy_init( void )
+{
+    struct smtc_hal_mcu_rng_cfg_s rng_cfg = { .rng = RNG };
+    uint8_t                       seed[SMTC_ENTROPY_POOL_SEED_LENGTH];
+    bool                          is_seeded;
+
+    if( entropy_pool.is_init == true )
+    {
+        return true;
+    }
+
+    if( smtc_entropy_pool_self_test( ) == false )
+    {
+        HAL_DBG_TRACE_ERROR( "Entropy pool: AES self-test failed\n" );
+        return false;
+    }
+
+    if( ( rng_inst == NULL ) && ( smtc_hal_mcu_rng_init( &rng_cfg, &rng_inst ) != SMTC_HAL_MCU_STATUS_OK ) )
+    {
+        rng_inst = NULL;
+    }
+
+    is_seeded = apps_entropy_read_mcu( seed, sizeof( seed ) );
+    if( is_seeded == false )
+    {
+        // Still instantiate so that callers get distinct sequences per device, the radio harvest brings the entropy
+        memset( seed, 0, sizeof( seed ) );
+        HAL_DBG_TRACE_WARNING( "Entropy pool: MCU RNG unavailable, waiting for the radio harvest\n" );
+    }
+
+    smtc_entropy_pool_init( &entropy_pool, seed, ( const uint8_t* ) UID_BASE, APPS_ENTROPY_UID_LENGTH );
+    memset( seed, 0, sizeof( seed ) );
+
+    return is_seeded;
+}
+
+bool apps_entropy_add_radio_words( const uint32_t* words, unsigned int nb_words, uint32_t harvest_time_in_us )
+{
+    uint8_t mcu_bytes[APPS_ENTROPY_RADIO_HARVEST_NB_WORDS * sizeof( uint32_t )];
+
+    if( ( entropy_pool.is_init == false ) || ( nb_words == 0 ) )
+    {
+        return false;
+    }
+
+    // Repetition check in the spirit of NIST SP 800-90B: a stuck source repeats its output
+    for( unsigned int i = 1; i < nb_words; i++ )
+    {
+        if( words[i] == words[i - 1] )
+        {
+            nb_radio_batches_rejected++;
+            return false;
+        }
+    }
+
+    smtc_entropy_pool_add_entropy( &entropy_pool, SMTC_ENTROPY_POOL_SOURCE_RADIO, ( const uint8_t* ) words,
+                                   nb_words * sizeof( uint32_t ) );
+
+    radio_harvest_time_in_us = harvest_time_in_us;
+    radio_harvest_nb_bytes   = nb_words * sizeof( uint32_t );
+
+    const unsigned int mcu_length =
+        ( radio_harvest_nb_bytes < sizeof( mcu_bytes ) ) ? radio_harvest_nb_bytes : sizeof( mcu_bytes );
+    if( apps_entropy_read_mcu( mcu_bytes, mcu_length ) == true )
+    {
+        smtc_entropy_pool_add_entropy( &entropy_pool, SMTC_ENTROPY_POOL_SOURCE_MCU, mcu_bytes, mcu_length );
+        memset( mcu_bytes, 0, sizeof( mcu_bytes ) );
+    }
+
+    return true;
+}
+
+void apps_entropy_process( void )
+{
+    uint8_t mcu_bytes[SMTC_ENTROPY_POOL_SEED_LENGTH];
+
+    if( smtc_entropy_pool_is_reseed_due( &entropy_pool ) == false )
+    {
+        return;
+    }
+
+    if( apps_entropy_read_mcu( mcu_bytes, sizeof( mcu_bytes ) ) == true )
+    {
+        smtc_entropy_pool_add_entropy( &entropy_pool, SMTC_ENTROPY_POOL_SOURCE_MCU, mcu_bytes, sizeof( mcu_bytes ) );
+        memset( mcu_bytes, 0, sizeof( mcu_bytes ) );
+    }
+}
+
+bool apps_entropy_get_bytes( uint8_t* buffer, unsigned int length )
+{
+    return smtc_entropy_pool_get_bytes( &entropy_pool, buffer, length ) == SMTC_ENTROPY_POOL_STATUS_OK;
+}
+
+uint32_t apps_entropy_get_range( uint32_t range )
+{
+    return smtc_entropy_pool_get_range( &entropy_pool, range );
+}
+
+void apps_entropy_print_stats( void )
+{
+    smtc_entropy_pool_stats_t stats;
+
+    if( entropy_pool.is_init == false )
+    {
+        HAL_DBG_TRACE_INFO( "Entropy pool not available\n" );
+        return;
+    }
+
+    smtc_entropy_pool_get_stats( &entropy_pool, &stats );
+
+    HAL_DBG_TRACE_INFO( "Entropy pool: %u bytes served in %u requests, %u refills, %u reseeds\n",
+                        stats.nb_bytes_served, stats.nb_requests, stats.nb_refills, stats.nb_reseeds );
+    HAL_DBG_TRACE_INFO( "  harvested: %u bytes from the MCU RNG (%u failures), %u bytes from the radio (%u batches "
+                        "rejected)\n",
+                        stats.nb_bytes_harvested[SMTC_ENTROPY_POOL_SOURCE_MCU], nb_mcu_failures,
+                        stats.nb_bytes_harvested[SMTC_ENTROPY_POOL_SOURCE_RADIO], nb_radio_batches_rejected );
+    if( radio_harvest_nb_bytes > 0 )
+    {
+        HAL_DBG_TRACE_INFO( "  last radio harvest: %u bytes in %u us\n", radio_harvest_nb_bytes,
+                            radio_harvest_time_in_us );
+    }
+}
+
+void apps_entropy_benchmark( void )
+{
+    static const unsigned int request_lengths[] = { 4, 16, 64, 256 };
+    static uint8_t            buffer[256];
+
+    if( entropy_pool.is_init == false )
+    {
+        HAL_DBG_TRACE_INFO( "Entropy pool not available\n" );
+        return;
+    }
+
+    for( unsigned int i = 0; i < sizeof( request_lengths ) / sizeof( request_lengths[0] ); i++ )
+    {
+        const uint32_t start_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+
+        for( int n = 0; n < APPS_ENTROPY_BENCHMARK_NB_REQUESTS; n++ )
+        {
+            smtc_entropy_pool_get_bytes( &entropy_pool, buffer, request_lengths[i] );
+        }
+
+        const uint32_t elapsed_in_us = smtc_hal_mcu_timer_get_elapsed_time_in_us( start_in_us );
+        const uint32_t nb_bytes      = APPS_ENTROPY_BENCHMARK_NB_REQUESTS * request_lengths[i];
+
+        HAL_DBG_TRACE_INFO( "Pool, %3u-byte requests: %u bytes/s, %u ns per request\n", request_lengths[i],
+                            ( uint32_t ) ( ( uint64_t ) nb_bytes * 1000000 / ( elapsed_in_us + 1 ) ),
+                            ( uint32_t ) ( ( uint64_t ) elapsed_in_us * 1000 / APPS_ENTROPY_BENCHMARK_NB_REQUESTS ) );
+    }
+
+    const uint32_t start_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+    if( apps_entropy_read_mcu( buffer, sizeof( buffer ) ) == true )
+    {
+        const uint32_t elapsed_in_us = smtc_hal_mcu_timer_get_elapsed_time_in_us( start_in_us );
+
+        HAL_DBG_TRACE_INFO( "MCU RNG alone: %u bytes/s\n",
+                            ( uint32_t ) ( ( uint64_t ) sizeof( buffer ) * 1000000 / ( elapsed_in_us + 1 ) ) );
+    }
+
+    if( radio_harvest_nb_bytes > 0 )
+    {
+        HAL_DBG_TRACE_INFO( "Radio RNG alone: %u bytes/s\n",
+                            ( uint32_t ) ( ( uint64_t ) radio_harvest_nb_bytes * 1000000 /
+                                           ( radio_harvest_time_in_us + 1 ) ) );
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static bool apps_entropy_read_mcu( uint8_t* buffer, unsigned int length )
+{
+    if( ( rng_inst == NULL ) || ( smtc_hal_mcu_rng_get_bytes( rng_inst, buffer, length ) != SMTC_HAL_MCU_STATUS_OK ) )
+    {
+        nb_mcu_failures++;
+        return false;
+    }
+
+    return true;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
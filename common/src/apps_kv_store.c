@@ -1,10 +1,10 @@
 /*!
- * @file      main_tx_infinite_preamble.c
+ * @file      apps_kv_store.c
  *
- * @brief     Example of the transmission of an infinite preamble for LR11xx chip
+ * @brief     Persistent key-value store shared by the applications
  *
  * The Clear BSD License
- * Copyright Semtech Corporation 2022. All rights reserved.
+ * Copyright Semtech Corporation 2024. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted (subject to the limitations in the disclaimer
@@ -37,14 +37,11 @@
  * --- DEPENDENCIES ------------------------------------------------------------
  */
 
-#include <stdio.h>
-#include <string.h>
-
-#include "apps_common.h"
-#include "apps_utilities.h"
-#include "lr11xx_radio.h"
+#include <stddef.h>
+#include "apps_kv_store.h"
+#include "smtc_hal_mcu_nvm.h"
+#include "smtc_hal_mcu_nvm_stm32l4.h"
 #include "smtc_hal_dbg_trace.h"
-#include "uart_init.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -56,6 +53,11 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+/**
+ * @brief Size of a store sector: one flash page, the smallest unit compaction reclaims
+ */
+#define APPS_KV_STORE_SECTOR_SIZE SMTC_HAL_MCU_NVM_STM32L4_PAGE_SIZE
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -66,7 +68,9 @@
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-static lr11xx_hal_context_t* context;
+static smtc_hal_mcu_nvm_inst_t nvm_inst = NULL;
+static smtc_kv_store_t         kv_store;
+static bool                    is_kv_store_ready = false;
 
 /*
  * -----------------------------------------------------------------------------
@@ -78,29 +82,74 @@ static lr11xx_hal_context_t* context;
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
  */
 
-/**
- * @brief Main application entry point.
- */
-int main( void )
+bool apps_kv_store_init( void )
 {
-    smtc_hal_mcu_init( );
-    apps_common_shield_init( );
-    uart_init();
+    struct smtc_hal_mcu_nvm_cfg_s nvm_cfg = {
+        .start_address = SMTC_HAL_MCU_NVM_STM32L4_DEFAULT_START_ADDRESS,
+        .size          = SMTC_HAL_MCU_NVM_STM32L4_DEFAULT_SIZE,
+    };
+    smtc_kv_store_cfg_t    kv_cfg;
+    smtc_kv_store_status_t status;
+
+    if( is_kv_store_ready == true )
+    {
+        return true;
+    }
 
-    HAL_DBG_TRACE_INFO( "===== LR11xx TX infinite preamble example =====\n\n" );
-    apps_common_print_sdk_driver_version( );
+    if( ( nvm_inst == NULL ) && ( smtc_hal_mcu_nvm_init( &nvm_cfg, &nvm_inst ) != SMTC_HAL_MCU_STATUS_OK ) )
+    {
+        HAL_DBG_TRACE_ERROR( "NVM initialisation failed\n" );
+        return false;
+    }
 
-    context = apps_common_lr11xx_get_context( );
+    kv_cfg.nvm         = nvm_inst;
+    kv_cfg.sector_size = APPS_KV_STORE_SECTOR_SIZE;
 
-    apps_common_lr11xx_system_init( ( void* ) context );
-    apps_common_lr11xx_fetch_and_print_version( ( void* ) context );
-    apps_common_lr11xx_radio_init( ( void* ) context );
+    status = smtc_kv_store_init( &kv_store, &kv_cfg );
+    if( status != SMTC_KV_STORE_STATUS_OK )
+    {
+        HAL_DBG_TRACE_ERROR( "Key-value store initialisation failed (%d)\n", status );
+        return false;
+    }
 
-    apps_common_lr11xx_handle_pre_tx( );
-    ASSERT_LR11XX_RC( lr11xx_radio_set_tx_infinite_preamble( context ) );
+    is_kv_store_ready = true;
 
-    // Reload watchdog counter to avoid reset
-    while( 1 )
+    return true;
+}
+
+smtc_kv_store_t* apps_kv_store_get( void )
+{
+    return ( is_kv_store_ready == true ) ? &kv_store : NULL;
+}
+
+bool apps_kv_store_process( void )
+{
+    return ( is_kv_store_ready == true ) && smtc_kv_store_process( &kv_store );
+}
+
+void apps_kv_store_print_stats( void )
+{
+    smtc_kv_store_stats_t stats;
+
+    if( is_kv_store_ready == false )
     {
+        HAL_DBG_TRACE_INFO( "Key-value store not available\n" );
+        return;
     }
+
+    smtc_kv_store_get_stats( &kv_store, &stats );
+
+    HAL_DBG_TRACE_INFO( "Key-value store: %u keys, %u / %u bytes used, %u free sectors\n", stats.nb_keys,
+                        stats.live_bytes, stats.capacity_bytes, stats.nb_free_sectors );
+    HAL_DBG_TRACE_INFO( "  %u bytes written for %u bytes of records, %u records compacted\n", stats.nvm_bytes_written,
+                        stats.user_bytes_written, stats.nb_records_compacted );
+    HAL_DBG_TRACE_INFO( "  %u sector erasures since boot, erase count per sector min %u max %u\n",
+                        stats.nb_sectors_erased, stats.sector_erase_count_min, stats.sector_erase_count_max );
 }
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,195 @@
+/*!
+ * @file      apps_link_stats.c
+ *
+ * @brief     Link statistics shared by the receivers: packet RSSI, SNR and inter-arrival distributions
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "apps_link_stats.h"
+#include "smtc_link_stats.h"
+#include "smtc_hal_dbg_trace.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Names of the metrics in the printed statistics
+ */
+static const char* const metric_names[SMTC_LINK_STATS_METRIC_COUNT] = { "rssi_dbm", "signal_rssi_dbm", "snr_db",
+                                                                        "inter_arrival_ms" };
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static smtc_link_stats_t link_stats;
+
+static bool is_link_stats_init = false;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Print a quantile estimate as ",p<percent>=<value>", with one decimal
+ *
+ * @param [in] per_mille Quantile probability, in per mille
+ * @param [in] value Estimate, with SMTC_LINK_STATS_FRACTIONAL_BITS fractional bits
+ */
+static void apps_link_stats_print_quantile( uint16_t per_mille, int32_t value );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void apps_link_stats_init( uint32_t expected_inter_arrival_in_ms )
+{
+    smtc_link_stats_init( &link_stats );
+
+    if( expected_inter_arrival_in_ms > 0 )
+    {
+        const uint32_t span_in_ms      = 2 * expected_inter_arrival_in_ms;
+        const uint32_t bin_width_in_ms =
+            ( span_in_ms + SMTC_LINK_STATS_HISTOGRAM_NB_BINS - 1 ) / SMTC_LINK_STATS_HISTOGRAM_NB_BINS;
+
+        smtc_link_stats_metric_init( &link_stats.metrics[SMTC_LINK_STATS_METRIC_INTER_ARRIVAL], 0,
+                                     ( int32_t ) bin_width_in_ms );
+    }
+    is_link_stats_init = true;
+}
+
+void apps_link_stats_reset( void )
+{
+    if( is_link_stats_init == false )
+    {
+        apps_link_stats_init( 0 );
+        return;
+    }
+    smtc_link_stats_reset( &link_stats );
+}
+
+void apps_link_stats_add_packet( const smtc_link_stats_packet_t* packet )
+{
+    if( is_link_stats_init == true )
+    {
+        smtc_link_stats_add_packet( &link_stats, packet );
+    }
+}
+
+void apps_link_stats_print( void )
+{
+    if( is_link_stats_init == false )
+    {
+        HAL_DBG_TRACE_INFO( "Link statistics not available\n" );
+        return;
+    }
+
+    for( int i = 0; i < SMTC_LINK_STATS_METRIC_COUNT; i++ )
+    {
+        const smtc_link_stats_metric_t* metric = &link_stats.metrics[i];
+
+        if( metric->count == 0 )
+        {
+            HAL_DBG_TRACE_PRINTF( "LINKSTATS,%s,count=0\n", metric_names[i] );
+            continue;
+        }
+
+        HAL_DBG_TRACE_PRINTF( "LINKSTATS,%s,count=%u,min=%d,avg=%d,max=%d", metric_names[i],
+                              ( unsigned int ) metric->count, ( int ) metric->min,
+                              ( int ) ( metric->sum / ( int64_t ) metric->count ), ( int ) metric->max );
+        for( unsigned int q = 0; q < SMTC_LINK_STATS_NB_QUANTILES; q++ )
+        {
+            apps_link_stats_print_quantile( smtc_link_stats_get_quantile_in_per_mille( q ),
+                                            smtc_link_stats_metric_get_quantile( metric, q ) );
+        }
+        HAL_DBG_TRACE_PRINTF( "\n" );
+
+        HAL_DBG_TRACE_PRINTF( "LINKSTATS,histogram,%s", metric_names[i] );
+        for( int bin = 0; bin < SMTC_LINK_STATS_HISTOGRAM_NB_BINS; bin++ )
+        {
+            if( metric->histogram[bin] != 0 )
+            {
+                HAL_DBG_TRACE_PRINTF( ",%d:%u", ( int ) ( metric->histogram_min + bin * metric->bin_width ),
+                                      ( unsigned int ) metric->histogram[bin] );
+            }
+        }
+        HAL_DBG_TRACE_PRINTF( "\n" );
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void apps_link_stats_print_quantile( uint16_t per_mille, int32_t value )
+{
+    // Rounded to the nearest tenth
+    const int64_t one       = 1 << SMTC_LINK_STATS_FRACTIONAL_BITS;
+    const int64_t half      = ( value >= 0 ) ? ( one / 2 ) : ( -one / 2 );
+    const int32_t value_x10 = ( int32_t ) ( ( ( int64_t ) value * 10 + half ) / one );
+    const int32_t tenths    = ( value_x10 >= 0 ) ? ( value_x10 % 10 ) : -( value_x10 % 10 );
+
+    if( ( per_mille % 10 ) == 0 )
+    {
+        HAL_DBG_TRACE_PRINTF( ",p%u=", per_mille / 10 );
+    }
+    else
+    {
+        HAL_DBG_TRACE_PRINTF( ",p%u.%u=", per_mille / 10, per_mille % 10 );
+    }
+    // -0.x has no integer part to carry the sign
+    HAL_DBG_TRACE_PRINTF( "%s%d.%d", ( ( value_x10 < 0 ) && ( value_x10 > -10 ) ) ? "-" : "",
+                          ( int ) ( value_x10 / 10 ), ( int ) tenths );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
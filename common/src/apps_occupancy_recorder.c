@@ -0,0 +1,277 @@
+/*!
+ * @file      apps_occupancy_recorder.c
+ *
+ * @brief     Long-term spectrum occupancy recorder: spectral sweep histograms stored in flash
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "apps_occupancy_recorder.h"
+#include "smtc_hal_mcu.h"
+#include "smtc_hal_mcu_nvm.h"
+#include "smtc_hal_mcu_nvm_stm32l4.h"
+#include "smtc_hal_dbg_trace.h"
+#include "uart_init.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * @brief Start address of the flash area of the log
+ *
+ * @remark Has to match the OCCUPANCY region of the linker script, just below the key-value store
+ */
+#define APPS_OCCUPANCY_RECORDER_NVM_START_ADDRESS 0x080D8000
+
+/*!
+ * @brief Size of the flash area of the log
+ */
+#define APPS_OCCUPANCY_RECORDER_NVM_SIZE 0x20000
+
+/*!
+ * @brief Size of a log page: one flash page, the oldest records are lost by pages of this size
+ */
+#define APPS_OCCUPANCY_RECORDER_PAGE_SIZE SMTC_HAL_MCU_NVM_STM32L4_PAGE_SIZE
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static smtc_hal_mcu_nvm_inst_t   nvm_inst = NULL;
+static smtc_occupancy_log_t      occupancy_log;
+static smtc_hal_mcu_timer_soft_t record_timer;
+static bool                      is_recording = false;
+
+/*!
+ * @brief Samples counted per channel and bin since the last record
+ */
+static uint16_t counts[APPS_OCCUPANCY_RECORDER_NB_CHANNELS_MAX][APPS_SPECTRAL_SWEEP_NB_BINS_MAX];
+
+/*!
+ * @brief Samples taken on the first channel since the last record, all channels being swept alike
+ */
+static uint32_t nb_samples;
+
+/*!
+ * @brief Time of the next record, in seconds since the boot
+ */
+static uint32_t record_time_in_s;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * @brief Write the histograms accumulated over the last period as one record, and start accumulating again
+ *
+ * @param [in] context  Unused
+ */
+static void apps_occupancy_recorder_on_timer( void* context );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+bool apps_occupancy_recorder_init( const smtc_occupancy_log_plan_t* plan )
+{
+    struct smtc_hal_mcu_nvm_cfg_s nvm_cfg = {
+        .start_address = APPS_OCCUPANCY_RECORDER_NVM_START_ADDRESS,
+        .size          = APPS_OCCUPANCY_RECORDER_NVM_SIZE,
+    };
+    smtc_occupancy_log_cfg_t    log_cfg;
+    smtc_occupancy_log_status_t status;
+
+    if( ( plan->nb_channels > APPS_OCCUPANCY_RECORDER_NB_CHANNELS_MAX ) ||
+        ( plan->nb_bins > APPS_SPECTRAL_SWEEP_NB_BINS_MAX ) || ( plan->record_period_in_s == 0 ) ||
+        ( plan->record_period_in_s > APPS_OCCUPANCY_RECORDER_RECORD_PERIOD_MAX_IN_S ) )
+    {
+        HAL_DBG_TRACE_ERROR( "Invalid occupancy recorder configuration\n" );
+        return false;
+    }
+
+    if( ( nvm_inst == NULL ) && ( smtc_hal_mcu_nvm_init( &nvm_cfg, &nvm_inst ) != SMTC_HAL_MCU_STATUS_OK ) )
+    {
+        HAL_DBG_TRACE_ERROR( "Occupancy log NVM initialisation failed\n" );
+        return false;
+    }
+
+    log_cfg.nvm       = nvm_inst;
+    log_cfg.page_size = APPS_OCCUPANCY_RECORDER_PAGE_SIZE;
+    log_cfg.plan      = *plan;
+
+    status = smtc_occupancy_log_init( &occupancy_log, &log_cfg );
+    if( status != SMTC_OCCUPANCY_LOG_STATUS_OK )
+    {
+        HAL_DBG_TRACE_ERROR( "Occupancy log initialisation failed (%d)\n", status );
+        return false;
+    }
+
+    memset( counts, 0, sizeof( counts ) );
+    nb_samples       = 0;
+    record_time_in_s = plan->record_period_in_s;
+
+    smtc_hal_mcu_timer_soft_init( &record_timer, apps_occupancy_recorder_on_timer, NULL );
+    smtc_hal_mcu_timer_soft_start( &record_timer, plan->record_period_in_s * 1000000UL,
+                                   plan->record_period_in_s * 1000000UL );
+    is_recording = true;
+
+    return true;
+}
+
+void apps_occupancy_recorder_add_channel( const apps_spectral_sweep_frame_channel_t* frame )
+{
+    uint16_t* channel_counts;
+
+    if( ( is_recording == false ) || ( frame->type != APPS_SPECTRAL_SWEEP_FRAME_CHANNEL ) ||
+        ( frame->channel_index >= occupancy_log.plan.nb_channels ) )
+    {
+        return;
+    }
+
+    channel_counts = counts[frame->channel_index];
+    for( uint8_t bin = 0; bin < occupancy_log.plan.nb_bins; bin++ )
+    {
+        if( ( uint32_t ) channel_counts[bin] + frame->bins[bin] > UINT16_MAX )
+        {
+            for( uint8_t i = 0; i < occupancy_log.plan.nb_bins; i++ )
+            {
+                channel_counts[i] >>= 1;
+            }
+        }
+        channel_counts[bin] += frame->bins[bin];
+    }
+
+    if( frame->channel_index == 0 )
+    {
+        nb_samples += frame->nb_samples;
+    }
+}
+
+void apps_occupancy_recorder_print_stats( void )
+{
+    smtc_occupancy_log_stats_t stats;
+    uint32_t                   span_in_s;
+
+    if( is_recording == false )
+    {
+        HAL_DBG_TRACE_INFO( "Occupancy recorder not running\n" );
+        return;
+    }
+
+    smtc_occupancy_log_get_stats( &occupancy_log, &stats );
+    span_in_s = stats.nb_records * occupancy_log.plan.record_period_in_s;
+
+    HAL_DBG_TRACE_INFO( "Occupancy log: session %u, %u records in %u / %u pages, about %u h %02u min of history\n",
+                        stats.session, stats.nb_records, stats.nb_pages_used, stats.nb_pages, span_in_s / 3600,
+                        ( span_in_s / 60 ) % 60 );
+    HAL_DBG_TRACE_INFO( "  %u bytes stored for %u bytes of raw histograms (ratio %u.%02u), %u bytes per record\n",
+                        stats.stored_bytes, stats.raw_bytes,
+                        ( stats.stored_bytes > 0 ) ? stats.raw_bytes / stats.stored_bytes : 0,
+                        ( stats.stored_bytes > 0 ) ? ( stats.raw_bytes % stats.stored_bytes ) * 100 / stats.stored_bytes
+                                                   : 0,
+                        ( stats.nb_records > 0 ) ? stats.stored_bytes / stats.nb_records : 0 );
+    HAL_DBG_TRACE_INFO( "  since boot: %u records appended, %u dropped, %u pages erased\n",
+                        stats.nb_records_appended, stats.nb_records_dropped, stats.nb_pages_erased );
+}
+
+bool apps_occupancy_recorder_dump( void )
+{
+    smtc_occupancy_log_stats_t stats;
+
+    if( is_recording == false )
+    {
+        return false;
+    }
+
+    smtc_occupancy_log_get_stats( &occupancy_log, &stats );
+    HAL_DBG_TRACE_INFO( "Occupancy log dump: %u bytes follow\n", stats.stored_bytes );
+
+    return smtc_occupancy_log_dump( &occupancy_log, uart_send_bytes ) == SMTC_OCCUPANCY_LOG_STATUS_OK;
+}
+
+bool apps_occupancy_recorder_clear( void )
+{
+    return ( is_recording == true ) && ( smtc_occupancy_log_clear( &occupancy_log ) == SMTC_OCCUPANCY_LOG_STATUS_OK );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void apps_occupancy_recorder_on_timer( void* context )
+{
+    smtc_occupancy_log_status_t status;
+
+    if( nb_samples > 0 )
+    {
+        status = smtc_occupancy_log_record_start( &occupancy_log, record_time_in_s, nb_samples );
+        for( uint16_t channel = 0;
+             ( channel < occupancy_log.plan.nb_channels ) && ( status == SMTC_OCCUPANCY_LOG_STATUS_OK ); channel++ )
+        {
+            status = smtc_occupancy_log_record_add_channel( &occupancy_log, counts[channel] );
+        }
+        if( status == SMTC_OCCUPANCY_LOG_STATUS_OK )
+        {
+            status = smtc_occupancy_log_record_end( &occupancy_log );
+        }
+        if( status != SMTC_OCCUPANCY_LOG_STATUS_OK )
+        {
+            HAL_DBG_TRACE_WARNING( "Occupancy record at %u s not stored (%d)\n", record_time_in_s, status );
+        }
+    }
+
+    memset( counts, 0, sizeof( counts ) );
+    nb_samples = 0;
+    record_time_in_s += occupancy_log.plan.record_period_in_s;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,216 @@
+/*!
+ * @file      apps_radio.c
+ *
+ * @brief     Chip-agnostic radio API shared by the LR11xx and SX126x applications
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include "apps_radio.h"
+#include "apps_common.h"
+#include "radio_irq_queue.h"
+#include "smtc_hal_dbg_trace.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*!
+ * @brief DIO edge of the event being dispatched, in the timebase of smtc_hal_mcu_timer_get_time_in_us
+ */
+static uint32_t irq_timestamp_in_us = 0;
+
+/*!
+ * @brief DIO edge of the event being dispatched, in cycles
+ */
+static uint32_t irq_timestamp_in_cycles = 0;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * @brief Dispatch the DIO events waiting for a radio, see apps_radio_irq_process
+ *
+ * @param [in] radio  Radio
+ * @param [in] irq_filter_mask  Interrupts to be given to the callback
+ * @param [in] callback  Application callback
+ * @param [in] is_traced  Print the interrupts raised once the callback has returned
+ */
+static void apps_radio_irq_dispatch( const apps_radio_t* radio, apps_radio_irq_mask_t irq_filter_mask,
+                                     apps_radio_irq_callback_t callback, bool is_traced );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void apps_radio_open( apps_radio_t* radio, const apps_radio_ops_t* ops, uint8_t radio_id,
+                      const radio_registry_binding_t* binding )
+{
+    radio->ops     = ops;
+    radio->context = ops->get_context( radio_id, binding );
+}
+
+void apps_radio_irq_process( const apps_radio_t* radio, apps_radio_irq_mask_t irq_filter_mask,
+                             apps_radio_irq_callback_t callback )
+{
+    apps_radio_irq_dispatch( radio, irq_filter_mask, callback, true );
+}
+
+void apps_radio_irq_process_quiet( const apps_radio_t* radio, apps_radio_irq_mask_t irq_filter_mask,
+                                   apps_radio_irq_callback_t callback )
+{
+    apps_radio_irq_dispatch( radio, irq_filter_mask, callback, false );
+}
+
+uint32_t apps_radio_get_irq_timestamp_in_us( void )
+{
+    return irq_timestamp_in_us;
+}
+
+uint32_t apps_radio_get_irq_timestamp_in_cycles( void )
+{
+    return irq_timestamp_in_cycles;
+}
+
+void apps_radio_call_benchmark_record( apps_radio_call_benchmark_t* result, uint32_t cycles )
+{
+    if( ( result->nb_calls == 0 ) || ( cycles < result->min_in_cycles ) )
+    {
+        result->min_in_cycles = cycles;
+    }
+    result->sum_in_cycles += cycles;
+    result->nb_calls++;
+}
+
+void apps_radio_call_benchmark_print( const char* name, const apps_radio_call_benchmark_t* result )
+{
+    if( result->nb_calls == 0 )
+    {
+        return;
+    }
+
+    HAL_DBG_TRACE_INFO( "  - %-14s: min %u cycles, avg %u cycles\n", name, result->min_in_cycles,
+                        result->sum_in_cycles / result->nb_calls );
+}
+
+void apps_radio_rx_latency_record( apps_radio_rx_latency_stats_t* stats, uint32_t latency_in_cycles )
+{
+    if( ( stats->nb_packets == 0 ) || ( latency_in_cycles < stats->min_in_cycles ) )
+    {
+        stats->min_in_cycles = latency_in_cycles;
+    }
+    if( latency_in_cycles > stats->max_in_cycles )
+    {
+        stats->max_in_cycles = latency_in_cycles;
+    }
+    stats->sum_in_cycles += latency_in_cycles;
+    stats->nb_packets++;
+}
+
+void apps_radio_rx_latency_print( const char* name, const apps_radio_rx_latency_stats_t* stats )
+{
+    if( stats->nb_packets == 0 )
+    {
+        return;
+    }
+
+    HAL_DBG_TRACE_PRINTF( "RX_DONE to payload, %s: %u packets, min %u us, avg %u us, max %u us\n", name,
+                          stats->nb_packets, apps_common_cycle_counter_to_us( stats->min_in_cycles ),
+                          apps_common_cycle_counter_to_us( ( uint32_t ) ( stats->sum_in_cycles / stats->nb_packets ) ),
+                          apps_common_cycle_counter_to_us( stats->max_in_cycles ) );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void apps_radio_irq_dispatch( const apps_radio_t* radio, apps_radio_irq_mask_t irq_filter_mask,
+                                     apps_radio_irq_callback_t callback, bool is_traced )
+{
+    radio_irq_queue_t* irq_queue = radio_registry_get_irq_queue( radio->context );
+    radio_irq_event_t  event;
+
+    if( irq_queue == NULL )
+    {
+        return;
+    }
+
+    while( radio_irq_queue_pop( irq_queue, &event ) == true )
+    {
+        const apps_radio_irq_mask_t irq          = apps_radio_get_and_clear_irq_status( radio );
+        const apps_radio_irq_mask_t irq_filtered = irq & irq_filter_mask;
+
+        const uint32_t now_in_us         = smtc_hal_mcu_timer_get_time_in_us( );
+        const uint32_t latency_in_cycles = apps_common_cycle_counter_get( ) - event.timestamp_in_cycles;
+
+        radio_irq_queue_record_latency( irq_queue, latency_in_cycles );
+        irq_timestamp_in_us     = now_in_us - apps_common_cycle_counter_to_us( latency_in_cycles );
+        irq_timestamp_in_cycles = event.timestamp_in_cycles;
+
+        if( irq_filtered != APPS_RADIO_IRQ_NONE )
+        {
+            callback( radio, irq_filtered );
+        }
+
+        // Traced once the callback has returned to keep it out of the dispatch latency
+        if( is_traced == true )
+        {
+            HAL_DBG_TRACE_INFO( "Radio %u interrupt flags = 0x%04X (after filtering = 0x%04X)\n",
+                                radio_registry_get_id( radio->context ), irq, irq_filtered );
+        }
+    }
+}
+
+/* --- EOF ------------------------------------------------------------------ */
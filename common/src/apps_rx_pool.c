@@ -0,0 +1,264 @@
+/*!
+ * @file      apps_rx_pool.c
+ *
+ * @brief     Pool of received packets and queue of packets waiting for the application
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "apps_rx_pool.h"
+#include "smtc_hal_dbg_trace.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+#if( APPS_RX_POOL_SIZE & ( APPS_RX_POOL_SIZE - 1 ) ) != 0
+#error "APPS_RX_POOL_SIZE must be a power of two"
+#endif
+
+#if( APPS_RX_POOL_SIZE > UINT8_MAX )
+#error "APPS_RX_POOL_SIZE must fit in the 8-bit statistics"
+#endif
+
+#if( APPS_RX_POOL_SIZE > 32 )
+#error "APPS_RX_POOL_SIZE must fit in the 32-bit in-use mask"
+#endif
+
+#define APPS_RX_POOL_QUEUE_INDEX( index ) ( ( index ) & ( APPS_RX_POOL_SIZE - 1 ) )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*!
+ * @brief Packet buffers
+ */
+static apps_radio_rx_packet_t packets[APPS_RX_POOL_SIZE];
+
+/*!
+ * @brief Stack of the free buffers
+ *
+ * Buffers are only taken in on_rx_done and given back by the application, both from the main loop, so neither the free
+ * stack nor the queue below needs interrupt masking
+ */
+static struct
+{
+    apps_radio_rx_packet_t* buffers[APPS_RX_POOL_SIZE];
+    uint8_t                 count;
+    uint32_t                in_use_mask;  //!< Bit i set while packets[i] is queued or held by the application
+} free_stack;
+
+/*!
+ * @brief Queue of the packets waiting for the application, oldest first
+ *
+ * Indexes run freely and are masked on access
+ */
+static struct
+{
+    apps_radio_rx_packet_t* packets[APPS_RX_POOL_SIZE];
+    uint32_t                head;
+    uint32_t                tail;
+} queue;
+
+static apps_rx_pool_stats_t rx_pool_stats;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * @brief Get a free buffer
+ *
+ * @returns The buffer, NULL if the pool is exhausted
+ */
+static apps_radio_rx_packet_t* apps_rx_pool_alloc( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void apps_rx_pool_init( void )
+{
+    for( uint8_t i = 0; i < APPS_RX_POOL_SIZE; i++ )
+    {
+        free_stack.buffers[i] = &packets[i];
+    }
+    free_stack.count       = APPS_RX_POOL_SIZE;
+    free_stack.in_use_mask = 0;
+
+    queue.head = 0;
+    queue.tail = 0;
+
+    apps_rx_pool_reset_stats( );
+}
+
+bool apps_rx_pool_receive( const apps_radio_t* radio, uint32_t rx_restart_timeout_in_ms )
+{
+    apps_radio_rx_packet_t* packet = apps_rx_pool_alloc( );
+
+    if( packet == NULL )
+    {
+        // Leave the packet in the radio buffer, it is overwritten by the next reception
+        rx_pool_stats.nb_pool_exhausted++;
+        if( rx_restart_timeout_in_ms != APPS_RADIO_RX_RESTART_NONE )
+        {
+            apps_radio_set_rx( radio, rx_restart_timeout_in_ms );
+        }
+        return false;
+    }
+
+    packet->rx_done_in_cycles   = apps_radio_get_irq_timestamp_in_cycles( );
+    packet->end_of_packet_in_us = apps_radio_get_rx_end_of_packet_in_us( radio );
+    if( apps_radio_receive_packet( radio, rx_restart_timeout_in_ms, packet ) == false )
+    {
+        rx_pool_stats.nb_read_errors++;
+        apps_rx_pool_release( packet );
+        return false;
+    }
+
+    queue.packets[APPS_RX_POOL_QUEUE_INDEX( queue.head )] = packet;
+    queue.head++;
+    rx_pool_stats.nb_received++;
+
+    const uint8_t depth = apps_rx_pool_get_queue_depth( );
+    if( depth > rx_pool_stats.queue_high_water_mark )
+    {
+        rx_pool_stats.queue_high_water_mark = depth;
+    }
+
+    return true;
+}
+
+apps_radio_rx_packet_t* apps_rx_pool_get_next( void )
+{
+    if( queue.head == queue.tail )
+    {
+        return NULL;
+    }
+
+    apps_radio_rx_packet_t* packet = queue.packets[APPS_RX_POOL_QUEUE_INDEX( queue.tail )];
+    queue.tail++;
+
+    return packet;
+}
+
+void apps_rx_pool_release( apps_radio_rx_packet_t* packet )
+{
+    const uintptr_t offset = ( uintptr_t ) packet - ( uintptr_t ) &packets[0];
+
+    if( ( offset >= sizeof( packets ) ) || ( ( offset % sizeof( packets[0] ) ) != 0 ) )
+    {
+        HAL_DBG_TRACE_ERROR( "Buffer %p does not belong to the RX pool\n", ( void* ) packet );
+        return;
+    }
+
+    const uint32_t slot_mask = 1UL << ( offset / sizeof( packets[0] ) );
+
+    if( ( free_stack.in_use_mask & slot_mask ) == 0 )
+    {
+        HAL_DBG_TRACE_ERROR( "Buffer %p of the RX pool is released but not in use\n", ( void* ) packet );
+        return;
+    }
+
+    free_stack.in_use_mask &= ~slot_mask;
+    free_stack.buffers[free_stack.count++] = packet;
+}
+
+uint8_t apps_rx_pool_get_queue_depth( void )
+{
+    return ( uint8_t ) ( queue.head - queue.tail );
+}
+
+void apps_rx_pool_get_stats( apps_rx_pool_stats_t* stats )
+{
+    *stats = rx_pool_stats;
+}
+
+void apps_rx_pool_reset_stats( void )
+{
+    memset( &rx_pool_stats, 0, sizeof( apps_rx_pool_stats_t ) );
+}
+
+void apps_rx_pool_print_stats( void )
+{
+    HAL_DBG_TRACE_PRINTF( "RX pool: %u packets queued, %u dropped (pool exhausted), %u dropped (too long)\n",
+                          ( unsigned int ) rx_pool_stats.nb_received, ( unsigned int ) rx_pool_stats.nb_pool_exhausted,
+                          ( unsigned int ) rx_pool_stats.nb_read_errors );
+    HAL_DBG_TRACE_PRINTF( "RX pool: queue high-water mark %u, buffers in use high-water mark %u / %u\n",
+                          rx_pool_stats.queue_high_water_mark, rx_pool_stats.in_use_high_water_mark,
+                          APPS_RX_POOL_SIZE );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static apps_radio_rx_packet_t* apps_rx_pool_alloc( void )
+{
+    if( free_stack.count == 0 )
+    {
+        return NULL;
+    }
+
+    apps_radio_rx_packet_t* packet = free_stack.buffers[--free_stack.count];
+
+    free_stack.in_use_mask |= 1UL << ( packet - &packets[0] );
+
+    const uint8_t in_use = APPS_RX_POOL_SIZE - free_stack.count;
+    if( in_use > rx_pool_stats.in_use_high_water_mark )
+    {
+        rx_pool_stats.in_use_high_water_mark = in_use;
+    }
+
+    return packet;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
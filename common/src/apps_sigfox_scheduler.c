@@ -0,0 +1,306 @@
+/*!
+ * @file      apps_sigfox_scheduler.c
+ *
+ * @brief     Sigfox frame scheduler: one encoding per frame, repetitions sent from the radio buffer on new frequencies
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "apps_sigfox_scheduler.h"
+#include "apps_radio.h"
+#include "apps_entropy.h"
+#include "smtc_dbpsk.h"
+#include "smtc_hal_mcu.h"
+#include "smtc_hal_dbg_trace.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * @brief Length of the longest frame after differential encoding, in bytes
+ */
+#define APPS_SIGFOX_SCHEDULER_ENCODED_LENGTH_MAX ( APPS_SIGFOX_SCHEDULER_FRAME_LENGTH_MAX + 1 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static struct
+{
+    const apps_radio_t*             radio;
+    apps_sigfox_scheduler_cfg_t     cfg;
+    apps_sigfox_scheduler_on_done_t on_done;
+    smtc_hal_mcu_timer_soft_t       timer;
+    uint8_t  frame[APPS_SIGFOX_SCHEDULER_FRAME_LENGTH_MAX];  //!< Frame held in the radio buffer, before encoding
+    uint8_t  frame_length;                                   //!< Length of frame, 0 if the radio buffer is unknown
+    uint32_t freqs_in_hz[APPS_SIGFOX_SCHEDULER_NB_TRANSMISSIONS_MAX];
+    uint8_t  transmission_index;  //!< Transmission in progress
+    bool     is_busy;
+    apps_sigfox_scheduler_stats_t stats;
+} scheduler;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * @brief Encode a frame and write it to the radio buffer
+ *
+ * @param [in] frame  Physical frame
+ * @param [in] length_in_bytes  Frame length
+ */
+static void apps_sigfox_scheduler_load( const uint8_t* frame, uint8_t length_in_bytes );
+
+/*!
+ * @brief Draw the frequency of each transmission of a frame
+ *
+ * The macro channel is split into one slice per transmission and each transmission gets a random frequency of its
+ * own slice, so the repetitions never share a frequency. The slice of the first transmission is random too.
+ */
+static void apps_sigfox_scheduler_draw_freqs( void );
+
+/*!
+ * @brief Start the next transmission once the inter-frame delay has elapsed
+ *
+ * @remark The radio is already tuned: this is the only radio access between two transmissions
+ *
+ * @param [in] context  Unused
+ */
+static void apps_sigfox_scheduler_on_timer( void* context );
+
+/*!
+ * @brief Call the on_tx_start hook and start the transmission of the radio buffer
+ */
+static void apps_sigfox_scheduler_start_tx( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+bool apps_sigfox_scheduler_init( const apps_radio_t* radio, const apps_sigfox_scheduler_cfg_t* cfg,
+                                 apps_sigfox_scheduler_on_done_t on_done )
+{
+    if( ( radio == NULL ) || ( cfg == NULL ) || ( cfg->nb_transmissions == 0 ) ||
+        ( cfg->nb_transmissions > APPS_SIGFOX_SCHEDULER_NB_TRANSMISSIONS_MAX ) ||
+        ( ( cfg->band_width_in_hz / cfg->nb_transmissions ) <= ( 2 * cfg->guard_in_hz ) ) )
+    {
+        return false;
+    }
+
+    smtc_hal_mcu_timer_soft_stop( &scheduler.timer );
+    memset( &scheduler, 0, sizeof( scheduler ) );
+    scheduler.radio   = radio;
+    scheduler.cfg     = *cfg;
+    scheduler.on_done = on_done;
+    smtc_hal_mcu_timer_soft_init( &scheduler.timer, apps_sigfox_scheduler_on_timer, NULL );
+
+    return true;
+}
+
+bool apps_sigfox_scheduler_send( const uint8_t* frame, uint8_t length_in_bytes )
+{
+    if( ( scheduler.radio == NULL ) || ( scheduler.is_busy == true ) || ( frame == NULL ) || ( length_in_bytes == 0 ) ||
+        ( length_in_bytes > APPS_SIGFOX_SCHEDULER_FRAME_LENGTH_MAX ) )
+    {
+        return false;
+    }
+
+    const uint8_t encoded_length = ( uint8_t ) smtc_dbpsk_get_pld_len_in_bytes( length_in_bytes << 3 );
+
+    if( ( scheduler.frame_length == length_in_bytes ) && ( memcmp( scheduler.frame, frame, length_in_bytes ) == 0 ) )
+    {
+        // The radio buffer still holds this frame
+        scheduler.stats.nb_bytes_saved += encoded_length;
+    }
+    else
+    {
+        apps_sigfox_scheduler_load( frame, length_in_bytes );
+    }
+    scheduler.stats.nb_bytes_saved += encoded_length * ( scheduler.cfg.nb_transmissions - 1 );
+
+    apps_sigfox_scheduler_draw_freqs( );
+
+    scheduler.transmission_index = 0;
+    scheduler.is_busy            = true;
+    apps_radio_set_rf_freq( scheduler.radio, scheduler.freqs_in_hz[0] );
+    apps_sigfox_scheduler_start_tx( );
+
+    return true;
+}
+
+bool apps_sigfox_scheduler_is_busy( void )
+{
+    return scheduler.is_busy;
+}
+
+void apps_sigfox_scheduler_on_radio_irq( const apps_radio_t* radio, apps_radio_irq_mask_t irq )
+{
+    ( void ) radio;
+
+    if( ( scheduler.is_busy == false ) || ( ( irq & APPS_RADIO_IRQ_TX_DONE ) == 0 ) )
+    {
+        return;
+    }
+
+    if( scheduler.cfg.on_tx_done != NULL )
+    {
+        scheduler.cfg.on_tx_done( );
+    }
+
+    scheduler.stats.nb_transmissions++;
+    scheduler.transmission_index++;
+
+    if( scheduler.transmission_index == scheduler.cfg.nb_transmissions )
+    {
+        scheduler.is_busy = false;
+        scheduler.stats.nb_frames++;
+        memcpy( scheduler.stats.last_freqs_in_hz, scheduler.freqs_in_hz, sizeof( scheduler.freqs_in_hz ) );
+        if( scheduler.on_done != NULL )
+        {
+            scheduler.on_done( );
+        }
+        return;
+    }
+
+    // The radio is in standby: retune now, the PLL has the whole inter-frame delay to lock
+    const uint32_t start_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+
+    apps_radio_set_rf_freq( scheduler.radio, scheduler.freqs_in_hz[scheduler.transmission_index] );
+    smtc_hal_mcu_timer_soft_start( &scheduler.timer, scheduler.cfg.inter_frame_delay_in_ms * 1000, 0 );
+
+    const uint32_t retune_time_in_us = smtc_hal_mcu_timer_get_time_in_us( ) - start_in_us;
+    if( retune_time_in_us > scheduler.stats.retune_time_max_in_us )
+    {
+        scheduler.stats.retune_time_max_in_us = retune_time_in_us;
+    }
+}
+
+void apps_sigfox_scheduler_get_stats( apps_sigfox_scheduler_stats_t* stats )
+{
+    *stats = scheduler.stats;
+}
+
+void apps_sigfox_scheduler_print_stats( void )
+{
+    const apps_sigfox_scheduler_stats_t* stats = &scheduler.stats;
+
+    HAL_DBG_TRACE_INFO( "Sigfox frame %u sent on", stats->nb_frames );
+    for( uint8_t i = 0; i < scheduler.cfg.nb_transmissions; i++ )
+    {
+        HAL_DBG_TRACE_PRINTF( " %u", stats->last_freqs_in_hz[i] );
+    }
+    HAL_DBG_TRACE_PRINTF( " Hz\n" );
+    HAL_DBG_TRACE_PRINTF( "   %u transmissions, %u encodings, %u bytes written to the radio buffer, %u saved\n",
+                          stats->nb_transmissions, stats->nb_encodings, stats->nb_bytes_written,
+                          stats->nb_bytes_saved );
+    HAL_DBG_TRACE_PRINTF( "   encoding and buffer write: %u us max, retune between transmissions: %u us max\n",
+                          stats->encode_time_max_in_us, stats->retune_time_max_in_us );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void apps_sigfox_scheduler_load( const uint8_t* frame, uint8_t length_in_bytes )
+{
+    uint8_t        encoded[APPS_SIGFOX_SCHEDULER_ENCODED_LENGTH_MAX];
+    const uint8_t  encoded_length = ( uint8_t ) smtc_dbpsk_get_pld_len_in_bytes( length_in_bytes << 3 );
+    const uint32_t start_in_us    = smtc_hal_mcu_timer_get_time_in_us( );
+
+    smtc_dbpsk_encode_buffer( frame, length_in_bytes << 3, encoded );
+    apps_radio_write_payload( scheduler.radio, encoded, encoded_length );
+
+    const uint32_t encode_time_in_us = smtc_hal_mcu_timer_get_time_in_us( ) - start_in_us;
+    if( encode_time_in_us > scheduler.stats.encode_time_max_in_us )
+    {
+        scheduler.stats.encode_time_max_in_us = encode_time_in_us;
+    }
+
+    memcpy( scheduler.frame, frame, length_in_bytes );
+    scheduler.frame_length = length_in_bytes;
+    scheduler.stats.nb_encodings++;
+    scheduler.stats.nb_bytes_written += encoded_length;
+}
+
+static void apps_sigfox_scheduler_draw_freqs( void )
+{
+    const uint8_t  nb_transmissions = scheduler.cfg.nb_transmissions;
+    const uint32_t slice_in_hz      = scheduler.cfg.band_width_in_hz / nb_transmissions;
+    const uint32_t band_start_in_hz = scheduler.cfg.center_freq_in_hz - scheduler.cfg.band_width_in_hz / 2;
+    const uint32_t first_slice      = apps_entropy_get_range( nb_transmissions );
+
+    for( uint8_t i = 0; i < nb_transmissions; i++ )
+    {
+        const uint32_t slice = ( first_slice + i ) % nb_transmissions;
+
+        scheduler.freqs_in_hz[i] = band_start_in_hz + slice * slice_in_hz + scheduler.cfg.guard_in_hz +
+                                   apps_entropy_get_range( slice_in_hz - 2 * scheduler.cfg.guard_in_hz + 1 );
+    }
+}
+
+static void apps_sigfox_scheduler_on_timer( void* context )
+{
+    ( void ) context;
+
+    apps_sigfox_scheduler_start_tx( );
+}
+
+static void apps_sigfox_scheduler_start_tx( void )
+{
+    if( scheduler.cfg.on_tx_start != NULL )
+    {
+        scheduler.cfg.on_tx_start( );
+    }
+    apps_radio_set_tx( scheduler.radio, 0 );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
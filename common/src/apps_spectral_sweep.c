@@ -0,0 +1,327 @@
+/*!
+ * @file      apps_spectral_sweep.c
+ *
+ * @brief     Spectral sweep: timer-paced instantaneous RSSI histograms streamed as binary frames
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "apps_spectral_sweep.h"
+#include "apps_radio.h"
+#include "smtc_hal_mcu.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * @brief Nibble lookup table of the CRC-16/CCITT polynomial
+ */
+static const uint16_t crc16_nibble_lut[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static struct
+{
+    const apps_radio_t*                 radio;
+    apps_spectral_sweep_cfg_t           cfg;
+    apps_spectral_sweep_on_frame_t      on_frame;
+    smtc_hal_mcu_timer_soft_t           timer;
+    apps_spectral_sweep_frame_sweep_t   sweep_frame;
+    apps_spectral_sweep_frame_channel_t channel_frame;
+    uint16_t                            channel_index;        //!< Channel being sampled
+    uint32_t                            channel_start_in_us;  //!< Time the channel being sampled was retuned
+    uint32_t                            sweep_start_in_us;
+    uint32_t                            nb_sweeps;  //!< Sweeps to run, 0 until apps_spectral_sweep_stop
+    uint32_t                            nb_sweeps_done;
+    bool                                is_sampling;  //!< false while waiting for the RSSI to settle
+    bool                                is_running;
+} sweep;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*!
+ * @brief Take the next sample, or start sampling once the RSSI has settled
+ *
+ * @param [in] context  Unused
+ */
+static void apps_spectral_sweep_on_timer( void* context );
+
+/*!
+ * @brief Retune the radio to a channel and wait for the RSSI to settle
+ *
+ * The radio goes from reception to frequency synthesis and back: the crystal and the regulators stay on, only the PLL
+ * relocks on the new frequency.
+ *
+ * @param [in] channel_index  Channel
+ */
+static void apps_spectral_sweep_retune( uint16_t channel_index );
+
+/*!
+ * @brief Send the histogram of the channel just sampled, then move on to the next channel or sweep
+ */
+static void apps_spectral_sweep_end_channel( void );
+
+/*!
+ * @brief Send the sweep frame of the sweep starting
+ *
+ * @param [in] last_sweep_time_in_us  Duration of the previous sweep, 0 for the first one
+ */
+static void apps_spectral_sweep_send_sweep_frame( uint32_t last_sweep_time_in_us );
+
+/*!
+ * @brief Update a CRC-16/CCITT with a buffer
+ *
+ * @param [in] crc CRC of the previous data, 0xFFFF to start
+ * @param [in] buffer Data
+ * @param [in] length Length of the data
+ *
+ * @returns Updated CRC
+ */
+static uint16_t apps_spectral_sweep_crc16( uint16_t crc, const uint8_t* buffer, uint32_t length );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+bool apps_spectral_sweep_init( const apps_radio_t* radio, const apps_spectral_sweep_cfg_t* cfg,
+                               apps_spectral_sweep_on_frame_t on_frame )
+{
+    if( ( cfg->nb_channels == 0 ) || ( cfg->nb_samples == 0 ) || ( cfg->rssi_step_in_db == 0 ) ||
+        ( cfg->nb_bins == 0 ) || ( cfg->nb_bins > APPS_SPECTRAL_SWEEP_NB_BINS_MAX ) || ( on_frame == NULL ) )
+    {
+        return false;
+    }
+
+    memset( &sweep, 0, sizeof( sweep ) );
+    sweep.radio    = radio;
+    sweep.cfg      = *cfg;
+    sweep.on_frame = on_frame;
+    smtc_hal_mcu_timer_soft_init( &sweep.timer, apps_spectral_sweep_on_timer, NULL );
+
+    sweep.sweep_frame.sync[0] = APPS_SPECTRAL_SWEEP_SYNC_0;
+    sweep.sweep_frame.sync[1] = APPS_SPECTRAL_SWEEP_SYNC_1;
+    sweep.sweep_frame.type    = APPS_SPECTRAL_SWEEP_FRAME_SWEEP;
+    sweep.sweep_frame.length =
+        ( uint8_t ) ( offsetof( apps_spectral_sweep_frame_sweep_t, crc ) - APPS_SPECTRAL_SWEEP_FRAME_HEADER_LENGTH );
+    sweep.sweep_frame.freq_start_in_hz    = cfg->freq_start_in_hz;
+    sweep.sweep_frame.freq_step_in_hz     = cfg->freq_step_in_hz;
+    sweep.sweep_frame.nb_channels         = cfg->nb_channels;
+    sweep.sweep_frame.nb_samples          = cfg->nb_samples;
+    sweep.sweep_frame.sample_period_in_us = cfg->sample_period_in_us;
+    sweep.sweep_frame.settle_time_in_us   = cfg->settle_time_in_us;
+    sweep.sweep_frame.rssi_top_in_dbm     = cfg->rssi_top_in_dbm;
+    sweep.sweep_frame.rssi_step_in_db     = cfg->rssi_step_in_db;
+    sweep.sweep_frame.nb_bins             = cfg->nb_bins;
+
+    sweep.channel_frame.sync[0] = APPS_SPECTRAL_SWEEP_SYNC_0;
+    sweep.channel_frame.sync[1] = APPS_SPECTRAL_SWEEP_SYNC_1;
+    sweep.channel_frame.type    = APPS_SPECTRAL_SWEEP_FRAME_CHANNEL;
+    sweep.channel_frame.length  = ( uint8_t ) ( offsetof( apps_spectral_sweep_frame_channel_t, bins ) +
+                                               ( cfg->nb_bins * sizeof( uint16_t ) ) -
+                                               APPS_SPECTRAL_SWEEP_FRAME_HEADER_LENGTH );
+    return true;
+}
+
+void apps_spectral_sweep_start( uint32_t nb_sweeps )
+{
+    sweep.nb_sweeps                = nb_sweeps;
+    sweep.nb_sweeps_done           = 0;
+    sweep.channel_frame.nb_samples = 0;
+    sweep.is_running               = true;
+    sweep.sweep_start_in_us        = smtc_hal_mcu_timer_get_time_in_us( );
+    memset( sweep.channel_frame.bins, 0, sizeof( sweep.channel_frame.bins ) );
+
+    apps_spectral_sweep_retune( 0 );
+    apps_spectral_sweep_send_sweep_frame( 0 );
+}
+
+void apps_spectral_sweep_stop( void )
+{
+    smtc_hal_mcu_timer_soft_stop( &sweep.timer );
+    sweep.is_running = false;
+}
+
+bool apps_spectral_sweep_is_running( void )
+{
+    return sweep.is_running;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void apps_spectral_sweep_on_timer( void* context )
+{
+    const apps_spectral_sweep_cfg_t*     cfg   = &sweep.cfg;
+    apps_spectral_sweep_frame_channel_t* frame = &sweep.channel_frame;
+    int32_t                              bin;
+
+    ( void ) context;
+
+    if( sweep.is_sampling == false )
+    {
+        // Samples are paced from the first one: the delay of this callback does not shift the following ones
+        sweep.is_sampling = true;
+        smtc_hal_mcu_timer_soft_start( &sweep.timer, cfg->sample_period_in_us, cfg->sample_period_in_us );
+    }
+
+    bin = ( ( int32_t ) cfg->rssi_top_in_dbm - apps_radio_get_rssi_inst( sweep.radio ) ) / cfg->rssi_step_in_db;
+    if( bin < 0 )
+    {
+        bin = 0;
+    }
+    else if( bin >= cfg->nb_bins )
+    {
+        bin = cfg->nb_bins - 1;
+    }
+    frame->bins[bin]++;
+
+    frame->nb_samples++;
+    if( frame->nb_samples >= cfg->nb_samples )
+    {
+        apps_spectral_sweep_end_channel( );
+    }
+}
+
+static void apps_spectral_sweep_retune( uint16_t channel_index )
+{
+    sweep.channel_index       = channel_index;
+    sweep.is_sampling         = false;
+    sweep.channel_start_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+
+    apps_radio_set_fs( sweep.radio );
+    apps_radio_set_rf_freq( sweep.radio, sweep.cfg.freq_start_in_hz + ( channel_index * sweep.cfg.freq_step_in_hz ) );
+    apps_radio_set_rx_continuous( sweep.radio );
+
+    smtc_hal_mcu_timer_soft_start( &sweep.timer, sweep.cfg.settle_time_in_us, 0 );
+}
+
+static void apps_spectral_sweep_end_channel( void )
+{
+    apps_spectral_sweep_frame_channel_t* frame           = &sweep.channel_frame;
+    const uint32_t                       now_in_us       = smtc_hal_mcu_timer_get_time_in_us( );
+    const uint32_t                       scan_time_in_us = now_in_us - sweep.channel_start_in_us;
+    uint32_t                             last_sweep_time_in_us;
+    bool                                 is_sweep_done;
+
+    smtc_hal_mcu_timer_soft_stop( &sweep.timer );
+
+    frame->freq_in_hz      = sweep.cfg.freq_start_in_hz + ( sweep.channel_index * sweep.cfg.freq_step_in_hz );
+    frame->sweep_index     = sweep.sweep_frame.sweep_index;
+    frame->channel_index   = sweep.channel_index;
+    frame->scan_time_in_us = ( scan_time_in_us > UINT16_MAX ) ? UINT16_MAX : ( uint16_t ) scan_time_in_us;
+    frame->bins[sweep.cfg.nb_bins] =
+        apps_spectral_sweep_crc16( 0xFFFF, &frame->type, frame->length + APPS_SPECTRAL_SWEEP_FRAME_HEADER_LENGTH - 2 );
+
+    // Retune before sending: the transfer of the frame overlaps the settling time of the next channel
+    is_sweep_done = ( sweep.channel_index + 1 ) >= sweep.cfg.nb_channels;
+    if( is_sweep_done == false )
+    {
+        apps_spectral_sweep_retune( sweep.channel_index + 1 );
+    }
+    else
+    {
+        last_sweep_time_in_us = now_in_us - sweep.sweep_start_in_us;
+        sweep.nb_sweeps_done++;
+        sweep.sweep_frame.sweep_index++;
+        if( ( sweep.nb_sweeps == 0 ) || ( sweep.nb_sweeps_done < sweep.nb_sweeps ) )
+        {
+            sweep.sweep_start_in_us = now_in_us;
+            apps_spectral_sweep_retune( 0 );
+        }
+        else
+        {
+            sweep.is_running = false;
+        }
+    }
+
+    sweep.on_frame( ( const uint8_t* ) frame, frame->length + APPS_SPECTRAL_SWEEP_FRAME_HEADER_LENGTH +
+                                                  APPS_SPECTRAL_SWEEP_FRAME_CRC_LENGTH );
+    memset( frame->bins, 0, sweep.cfg.nb_bins * sizeof( uint16_t ) );
+    frame->nb_samples = 0;
+
+    if( ( is_sweep_done == true ) && ( sweep.is_running == true ) )
+    {
+        apps_spectral_sweep_send_sweep_frame( last_sweep_time_in_us );
+    }
+}
+
+static void apps_spectral_sweep_send_sweep_frame( uint32_t last_sweep_time_in_us )
+{
+    apps_spectral_sweep_frame_sweep_t* frame = &sweep.sweep_frame;
+
+    frame->last_sweep_time_in_us = last_sweep_time_in_us;
+    frame->crc =
+        apps_spectral_sweep_crc16( 0xFFFF, &frame->type, frame->length + APPS_SPECTRAL_SWEEP_FRAME_HEADER_LENGTH - 2 );
+    sweep.on_frame( ( const uint8_t* ) frame, frame->length + APPS_SPECTRAL_SWEEP_FRAME_HEADER_LENGTH +
+                                                  APPS_SPECTRAL_SWEEP_FRAME_CRC_LENGTH );
+}
+
+static uint16_t apps_spectral_sweep_crc16( uint16_t crc, const uint8_t* buffer, uint32_t length )
+{
+    for( uint32_t i = 0; i < length; i++ )
+    {
+        crc = ( crc << 4 ) ^ crc16_nibble_lut[( crc >> 12 ) ^ ( buffer[i] >> 4 )];
+        crc = ( crc << 4 ) ^ crc16_nibble_lut[( crc >> 12 ) ^ ( buffer[i] & 0x0F )];
+    }
+
+    return crc;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
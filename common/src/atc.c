@@ -0,0 +1,289 @@
+#include "atc.h"
+#include <string.h>
+#include <stdlib.h>
+#include "smtc_hal_dbg_trace.h"
+//global macros initial
+// Radio-specific defaults (frequency, power, LoRa parameters, RX boost) are defined with the family binding
+int ATC_M_TXRX_SWITCH =1;
+
+int ATC_M_CW_SWITCH = 1;
+
+int ATC_M_NB_FRAME = 20;
+
+int ATC_M_LORA_SLEEP =0;
+
+int ATC_M_PA_PA_SEL =1000;
+
+int ATC_M_PA_PA_RGE_SUPPLY =1000;
+
+int ATC_M_PA_PA_DUTY_CYCLE =1000;
+
+int ATC_M_PA_PA_REAL_POWER =1000;
+
+int ATC_M_PA_PA_HP_SEL = 1000;
+
+int ATC_M_SWEEP_SWITCH = 0;
+
+int ATC_M_PER_FAST_SWITCH = 0;
+
+int ATC_M_PING_PONG_WINDOW = 0;
+
+int ATC_M_CAD_SCAN_SWITCH = 0;
+
+int ATC_M_CAD_SCAN_NB_SWEEPS = 0;
+
+static struct {
+    uint32_t Freq[ATC_CAD_SCAN_CHANNELS_MAX];
+    uint8_t Count;
+} ATC_CadScan;
+
+static struct {
+    int32_t Values[ATC_SWEEP_AXIS_COUNT][ATC_SWEEP_VALUES_MAX];
+    uint8_t Count[ATC_SWEEP_AXIS_COUNT];
+} ATC_Sweep;
+
+bool ATC_Init(ATC_HandleTypeDef* hAtc, smtc_hal_mcu_uart_inst_t hUart, uint16_t BufferSize, const char* pName) {
+    if (hAtc == NULL || hUart == NULL) {
+        HAL_DBG_TRACE_ERROR("ATC_Init failed: invalid parameters.\n");
+        return false;
+    }
+
+    memset(hAtc, 0, sizeof(ATC_HandleTypeDef));
+    hAtc->hUart = hUart;
+    strncpy(hAtc->Name, pName, sizeof(hAtc->Name) - 1);
+
+    hAtc->pRxBuff = malloc(BufferSize);
+    hAtc->pReadBuff = malloc(BufferSize);
+
+    if (hAtc->pRxBuff == NULL || hAtc->pReadBuff == NULL) {
+        HAL_DBG_TRACE_ERROR("ATC_Init failed: memory allocation failed.\n");
+        free(hAtc->pRxBuff);
+        free(hAtc->pReadBuff);
+        return false;
+    }
+
+    memset(hAtc->pRxBuff, 0, BufferSize);
+    memset(hAtc->pReadBuff, 0, BufferSize);
+    hAtc->Size = BufferSize;
+
+    hAtc->Events = 0;
+    hAtc->psEvents = NULL;
+
+    HAL_DBG_TRACE_INFO("ATC initialized on %s\n", pName);
+    return true;
+}
+
+
+bool ATC_SetEvents(ATC_HandleTypeDef* hAtc, ATC_EventTypeDef* events) {
+    if (hAtc == NULL || events == NULL) {
+        return false;
+    }
+
+    uint32_t count = 0;
+    while (events[count].Event != NULL && events[count].EventCallback != NULL) {
+        count++;
+    }
+
+    hAtc->psEvents = events;
+    hAtc->Events = count;
+
+    HAL_DBG_TRACE_INFO("ATC events configured. Total: %d\n", count);
+    return true;
+}
+
+void ATC_Loop(ATC_HandleTypeDef* hAtc) {
+    if (hAtc->RxIndex > 0) {
+        for (uint32_t i = 0; i < hAtc->Events; i++) {
+            //HAL_DBG_TRACE_INFO("Checking for event: %s\n", hAtc->psEvents[i].Event);
+            //HAL_DBG_TRACE_INFO("Received data: %s\n", hAtc->pReadBuff);
+
+            char* found = strstr((char*)hAtc->pReadBuff, hAtc->psEvents[i].Event);
+            if (found != NULL && hAtc->psEvents[i].EventCallback != NULL) {
+
+                char* param1 = NULL;
+                char* param2 = NULL;
+
+
+                if (found[strlen(hAtc->psEvents[i].Event)] == '=') {
+
+                    param1 = strtok(found + strlen(hAtc->psEvents[i].Event) + 1, ",");
+
+                    param2 = strtok(NULL, ",");
+                }
+
+                hAtc->psEvents[i].EventCallback(param1, param2);
+            }
+        }
+        hAtc->RxIndex = 0;
+        memset(hAtc->pReadBuff, 0, hAtc->Size);
+    }
+}
+
+
+void ATC_IdleLineCallback(ATC_HandleTypeDef* hAtc, uint16_t Len) {
+    //HAL_DBG_TRACE_INFO("ATC_IdleLineCallback called with Len: %d, RxIndex: %d\n", Len, hAtc->RxIndex);
+
+    if (Len > hAtc->Size - hAtc->RxIndex) {
+        //HAL_DBG_TRACE_WARNING("Len (%d) exceeds available buffer space (%d). Truncating to fit.\n", Len, hAtc->Size - hAtc->RxIndex);
+        Len = hAtc->Size - hAtc->RxIndex;
+    }
+
+
+    //HAL_DBG_TRACE_INFO("Copying data to pReadBuff at index %d. Data: %.*s\n", hAtc->RxIndex, Len, hAtc->pRxBuff);
+
+
+    memcpy(&hAtc->pReadBuff[hAtc->RxIndex], hAtc->pRxBuff, Len);
+    hAtc->RxIndex += Len;
+
+    //HAL_DBG_TRACE_INFO("Updated RxIndex: %d. Current buffer content: %s\n", hAtc->RxIndex, hAtc->pReadBuff);
+}
+
+
+static bool ATC_ParamMapFind(const ATC_ParamMapTypeDef* pMap, uint32_t Size, int Param, int* pValue) {
+    for (uint32_t i = 0; i < Size; i++) {
+        if (pMap[i].Param == Param) {
+            *pValue = pMap[i].Value;
+            return true;
+        }
+    }
+    return false;
+}
+
+static int ATC_ParamMapReverse(const ATC_ParamMapTypeDef* pMap, uint32_t Size, int Value) {
+    for (uint32_t i = 0; i < Size; i++) {
+        if (pMap[i].Value == Value) {
+            return pMap[i].Param;
+        }
+    }
+    return -1;
+}
+
+bool ATC_LoraSfFromParam(int Param, int* pSf) {
+    return ATC_ParamMapFind(ATC_Binding.pLoraSf, ATC_Binding.LoraSfCount, Param, pSf);
+}
+
+bool ATC_LoraBwFromParam(int Param, int* pBw) {
+    return ATC_ParamMapFind(ATC_Binding.pLoraBw, ATC_Binding.LoraBwCount, Param, pBw);
+}
+
+bool ATC_LoraCrFromParam(int Param, int* pCr) {
+    return ATC_ParamMapFind(ATC_Binding.pLoraCr, ATC_Binding.LoraCrCount, Param, pCr);
+}
+
+int ATC_LoraSfToParam(int Sf) {
+    return ATC_ParamMapReverse(ATC_Binding.pLoraSf, ATC_Binding.LoraSfCount, Sf);
+}
+
+int ATC_LoraBwToParam(int Bw) {
+    return ATC_ParamMapReverse(ATC_Binding.pLoraBw, ATC_Binding.LoraBwCount, Bw);
+}
+
+bool ATC_CadScanSetChannels(const uint32_t* pFreqs, uint8_t Count) {
+    if (pFreqs == NULL || Count > ATC_CAD_SCAN_CHANNELS_MAX) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < Count; i++) {
+        if (pFreqs[i] == 0) {
+            return false;
+        }
+    }
+
+    memcpy(ATC_CadScan.Freq, pFreqs, Count * sizeof(uint32_t));
+    ATC_CadScan.Count = Count;
+    return true;
+}
+
+uint8_t ATC_CadScanGetChannels(const uint32_t** ppFreqs) {
+    *ppFreqs = ATC_CadScan.Freq;
+    return ATC_CadScan.Count;
+}
+
+bool ATC_SweepSetAxis(ATC_SweepAxisTypeDef Axis, const int32_t* pValues, uint8_t Count) {
+    int Unused;
+
+    if (Axis >= ATC_SWEEP_AXIS_COUNT || pValues == NULL || Count > ATC_SWEEP_VALUES_MAX) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < Count; i++) {
+        if ((Axis == ATC_SWEEP_AXIS_SF && !ATC_LoraSfFromParam(pValues[i], &Unused)) ||
+            (Axis == ATC_SWEEP_AXIS_BW && !ATC_LoraBwFromParam(pValues[i], &Unused))) {
+            return false;
+        }
+    }
+
+    memcpy(ATC_Sweep.Values[Axis], pValues, Count * sizeof(int32_t));
+    ATC_Sweep.Count[Axis] = Count;
+    return true;
+}
+
+void ATC_SweepClear(void) {
+    memset(&ATC_Sweep, 0, sizeof(ATC_Sweep));
+    ATC_M_SWEEP_SWITCH = 0;
+}
+
+uint8_t ATC_SweepGetAxisCount(ATC_SweepAxisTypeDef Axis) {
+    return (Axis < ATC_SWEEP_AXIS_COUNT) ? ATC_Sweep.Count[Axis] : 0;
+}
+
+uint32_t ATC_SweepGetPointCount(void) {
+    uint32_t Points = 1;
+    bool Defined = false;
+
+    for (uint32_t Axis = 0; Axis < ATC_SWEEP_AXIS_COUNT; Axis++) {
+        if (ATC_Sweep.Count[Axis] > 0) {
+            Points *= ATC_Sweep.Count[Axis];
+            Defined = true;
+        }
+    }
+    return Defined ? Points : 0;
+}
+
+// Power is the innermost axis and frequency the outermost one, so that consecutive points mostly differ by the
+// cheapest parameters to reconfigure. Axes left empty keep the current ATC_M_* value.
+bool ATC_SweepApplyPoint(uint32_t Index, ATC_SweepPointTypeDef* pPoint) {
+    static const ATC_SweepAxisTypeDef Order[ATC_SWEEP_AXIS_COUNT] = {
+        ATC_SWEEP_AXIS_POWER, ATC_SWEEP_AXIS_SF, ATC_SWEEP_AXIS_BW, ATC_SWEEP_AXIS_FREQ};
+
+    if (Index >= ATC_SweepGetPointCount()) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < ATC_SWEEP_AXIS_COUNT; i++) {
+        const ATC_SweepAxisTypeDef Axis = Order[i];
+        const uint8_t Count = ATC_Sweep.Count[Axis];
+
+        if (Count == 0) {
+            continue;
+        }
+
+        const int32_t Value = ATC_Sweep.Values[Axis][Index % Count];
+        Index /= Count;
+
+        switch (Axis) {
+            case ATC_SWEEP_AXIS_FREQ:
+                ATC_M_RF_FREQ_IN_HZ = (uint32_t) Value;
+                break;
+            case ATC_SWEEP_AXIS_SF:
+                ATC_LoraSfFromParam(Value, &ATC_M_LORA_SF);
+                break;
+            case ATC_SWEEP_AXIS_BW:
+                ATC_LoraBwFromParam(Value, &ATC_M_LORA_BW);
+                break;
+            case ATC_SWEEP_AXIS_POWER:
+                ATC_M_TX_OUTPUT_POWER_DBM = Value;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (pPoint != NULL) {
+        pPoint->Freq = ATC_M_RF_FREQ_IN_HZ;
+        pPoint->Sf = ATC_LoraSfToParam(ATC_M_LORA_SF);
+        pPoint->Bw = ATC_LoraBwToParam(ATC_M_LORA_BW);
+        pPoint->Power = ATC_M_TX_OUTPUT_POWER_DBM;
+    }
+    return true;
+}
@@ -0,0 +1,171 @@
+/*!
+ * @file      radio_irq_queue.c
+ *
+ * @brief     Lock-free queue of timestamped radio DIO interrupt events
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "radio_irq_queue.h"
+#include "stm32l4xx.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+#if( RADIO_IRQ_QUEUE_SIZE & ( RADIO_IRQ_QUEUE_SIZE - 1 ) ) != 0
+#error "RADIO_IRQ_QUEUE_SIZE must be a power of two"
+#endif
+
+#define RADIO_IRQ_QUEUE_INDEX( index ) ( ( index ) & ( RADIO_IRQ_QUEUE_SIZE - 1 ) )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void radio_irq_queue_init( radio_irq_queue_t* queue )
+{
+    memset( queue, 0, sizeof( radio_irq_queue_t ) );
+    queue->stats.latency_min_in_cycles = UINT32_MAX;
+}
+
+bool radio_irq_queue_push( radio_irq_queue_t* queue, uint32_t timestamp_in_cycles )
+{
+    const uint32_t head  = queue->head;
+    const uint32_t depth = head - queue->tail;
+
+    queue->stats.nb_events++;
+
+    if( depth >= RADIO_IRQ_QUEUE_SIZE )
+    {
+        queue->stats.nb_overflows++;
+        return false;
+    }
+
+    queue->events[RADIO_IRQ_QUEUE_INDEX( head )].timestamp_in_cycles = timestamp_in_cycles;
+
+    // The event is written before head is published - the main loop cannot see a partially written entry. events[] is not
+    // volatile, so the barrier keeps the compiler from sinking the entry store below the index store
+    __DMB( );
+    queue->head = head + 1;
+
+    if( ( depth + 1 ) > queue->stats.depth_high_water_mark )
+    {
+        queue->stats.depth_high_water_mark = ( uint8_t ) ( depth + 1 );
+    }
+
+    return true;
+}
+
+bool radio_irq_queue_pop( radio_irq_queue_t* queue, radio_irq_event_t* event )
+{
+    const uint32_t tail = queue->tail;
+
+    if( queue->head == tail )
+    {
+        return false;
+    }
+
+    // The entry is not read before head says it is there
+    __DMB( );
+    *event = queue->events[RADIO_IRQ_QUEUE_INDEX( tail )];
+
+    // The entry is read before tail is released - the interrupt handler cannot overwrite it meanwhile. Same barrier as
+    // in radio_irq_queue_push, for the entry load
+    __DMB( );
+    queue->tail = tail + 1;
+
+    return true;
+}
+
+bool radio_irq_queue_is_empty( const radio_irq_queue_t* queue )
+{
+    return queue->head == queue->tail;
+}
+
+void radio_irq_queue_record_latency( radio_irq_queue_t* queue, uint32_t latency_in_cycles )
+{
+    queue->stats.nb_dispatched++;
+    queue->stats.latency_sum_in_cycles += latency_in_cycles;
+
+    if( latency_in_cycles < queue->stats.latency_min_in_cycles )
+    {
+        queue->stats.latency_min_in_cycles = latency_in_cycles;
+    }
+    if( latency_in_cycles > queue->stats.latency_max_in_cycles )
+    {
+        queue->stats.latency_max_in_cycles = latency_in_cycles;
+    }
+}
+
+void radio_irq_queue_get_stats( const radio_irq_queue_t* queue, radio_irq_queue_stats_t* stats )
+{
+    *stats = queue->stats;
+}
+
+void radio_irq_queue_reset_stats( radio_irq_queue_t* queue )
+{
+    memset( &queue->stats, 0, sizeof( radio_irq_queue_stats_t ) );
+    queue->stats.latency_min_in_cycles = UINT32_MAX;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/* --- EOF ------------------------------------------------------------------ */
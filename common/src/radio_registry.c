@@ -1,10 +1,10 @@
 /*!
- * @file      main_sigfox.c
+ * @file      radio_registry.c
  *
- * @brief     Sigfox PHY example for SX126X chip
+ * @brief     Registry of the radios driven by the MCU, with their bindings and interrupt queues
  *
  * The Clear BSD License
- * Copyright Semtech Corporation 2023. All rights reserved.
+ * Copyright Semtech Corporation 2024. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted (subject to the limitations in the disclaimer
@@ -37,17 +37,8 @@
  * --- DEPENDENCIES ------------------------------------------------------------
  */
 
-#include <stdio.h>
-#include <string.h>
-
-#include "apps_common.h"
-#include "sx126x.h"
-#include "sx126x_hal.h"
-#include "main_sigfox.h"
-#include "smtc_hal_mcu.h"
-#include "smtc_hal_dbg_trace.h"
-#include "uart_init.h"
-#include "smtc_dbpsk.h"
+#include <stddef.h>
+#include "radio_registry.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -59,11 +50,6 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
-// Application payload = 0x01
-const uint8_t sample0[] = { 0xaa, 0xaa, 0xa0, 0x8d, 0x01, 0x05, 0x98, 0xba, 0xdc, 0xfe, 0x01, 0x9a, 0x09, 0xfe, 0x04 };
-
-#define SIGFOX_PAYLOAD_LENGTH 15
-
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -74,66 +60,96 @@ const uint8_t sample0[] = { 0xaa, 0xaa, 0xa0, 0x8d, 0x01, 0x05, 0x98, 0xba, 0xdc
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-static sx126x_hal_context_t* context;
+static radio_registry_entry_t radios[RADIO_REGISTRY_MAX_RADIOS];
+
+/*!
+ * @brief Index of the radio served first by the next radio_registry_dispatch call
+ */
+static uint8_t next_radio_id = 0;
 
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
  */
 
-static void send_frame( void );
-
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
  */
 
-/**
- * @brief Main application entry point.
- */
-int main( void )
+radio_irq_queue_t* radio_registry_add( uint8_t radio_id, void* context, radio_registry_handler_t handler )
 {
-    smtc_hal_mcu_init( );
-    uart_init( );
-
-    HAL_DBG_TRACE_INFO( "===== SX126X Sigfox PHY example =====\n\n" );
-    apps_common_sx126x_print_version_info( );
+    if( radio_id >= RADIO_REGISTRY_MAX_RADIOS )
+    {
+        return NULL;
+    }
 
-    apps_common_shield_init( );
-    context = apps_common_sx126x_get_context( );
+    radios[radio_id].context = context;
+    radios[radio_id].handler = handler;
+    radio_irq_queue_init( &radios[radio_id].irq_queue );
 
-    apps_common_sx126x_init( ( void* ) context );
-    apps_common_sx126x_radio_dbpsk_init( ( void* ) context, SIGFOX_PAYLOAD_LENGTH );
+    return &radios[radio_id].irq_queue;
+}
 
-    sx126x_set_dio_irq_params( context, SX126X_IRQ_ALL, SX126X_IRQ_TX_DONE, SX126X_IRQ_NONE, SX126X_IRQ_NONE );
-    sx126x_clear_irq_status( context, SX126X_IRQ_ALL );
+void* radio_registry_get_context( uint8_t radio_id )
+{
+    return ( radio_id < RADIO_REGISTRY_MAX_RADIOS ) ? radios[radio_id].context : NULL;
+}
 
-    send_frame( );
+uint8_t radio_registry_get_id( const void* context )
+{
+    uint8_t radio_id = 0;
 
-    while( 1 )
+    while( ( radio_id < RADIO_REGISTRY_MAX_RADIOS ) &&
+           ( ( context == NULL ) || ( radios[radio_id].context != context ) ) )
     {
-        apps_common_sx126x_irq_process( context );
+        radio_id++;
     }
+
+    return radio_id;
 }
 
-void on_tx_done( void )
+radio_irq_queue_t* radio_registry_get_irq_queue( const void* context )
 {
-    apps_common_sx126x_handle_post_tx( );
-
-    LL_mDelay( TX_TO_TX_DELAY_IN_MS );
+    const uint8_t radio_id = radio_registry_get_id( context );
 
-    send_frame( );
+    return ( radio_id < RADIO_REGISTRY_MAX_RADIOS ) ? &radios[radio_id].irq_queue : NULL;
 }
 
-void send_frame( void )
+bool radio_registry_is_event_pending( void )
 {
-    uint8_t frame_buffer[smtc_dbpsk_get_pld_len_in_bytes( SIGFOX_PAYLOAD_LENGTH << 3 )];
+    for( uint8_t i = 0; i < RADIO_REGISTRY_MAX_RADIOS; i++ )
+    {
+        if( ( radios[i].context != NULL ) && ( radio_irq_queue_is_empty( &radios[i].irq_queue ) == false ) )
+        {
+            return true;
+        }
+    }
 
-    smtc_dbpsk_encode_buffer( sample0, SIGFOX_PAYLOAD_LENGTH << 3, frame_buffer );
+    return false;
+}
+
+void radio_registry_dispatch( uint32_t irq_filter_mask )
+{
+    const uint8_t first_radio_id = next_radio_id;
 
-    sx126x_write_buffer( context, 0, frame_buffer, smtc_dbpsk_get_pld_len_in_bytes( SIGFOX_PAYLOAD_LENGTH << 3 ) );
+    next_radio_id = ( uint8_t ) ( ( first_radio_id + 1 ) % RADIO_REGISTRY_MAX_RADIOS );
 
-    apps_common_sx126x_handle_pre_tx( );
+    for( uint8_t i = 0; i < RADIO_REGISTRY_MAX_RADIOS; i++ )
+    {
+        radio_registry_entry_t* radio = &radios[( first_radio_id + i ) % RADIO_REGISTRY_MAX_RADIOS];
 
-    sx126x_set_tx( context, 0 );
+        if( ( radio->context != NULL ) && ( radio->handler != NULL ) &&
+            ( radio_irq_queue_is_empty( &radio->irq_queue ) == false ) )
+        {
+            radio->handler( radio->context, irq_filter_mask );
+        }
+    }
 }
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/* --- EOF ------------------------------------------------------------------ */
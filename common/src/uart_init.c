@@ -12,15 +12,23 @@
  * --- DEPENDENCIES ------------------------------------------------------------
  */
 #include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "uart_init.h"
 #include "stm32l4xx.h"
 #include "smtc_hal_mcu_uart_stm32l4.h"
 #include "smtc_hal_dbg_trace.h"
 #include "smtc_hal_mcu.h"
+#include "smtc_hal_mcu_lpm.h"
 #include "stm32l4xx_ll_utils.h"
-#include "lr11xx_radio_types.h"
 #include "atc.h"  // Include the AT command handler header
+#include "apps_kv_store.h"
+#include "apps_entropy.h"
+#include "apps_link_stats.h"
+#include "apps_cad_scan.h"
+#include "apps_cad_tuner.h"
+#include "apps_occupancy_recorder.h"
 
 
 
@@ -31,6 +39,8 @@ uint16_t rx_length = 0;
 
 int AT_start_flag = 0;  // 启动标志位
 
+static smtc_hal_mcu_lpm_mode_t lpm_run_mode = SMTC_HAL_MCU_LPM_MODE_STOP;  // AT+START 之后允许的最深低功耗模式
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE VARIABLES -------------------------------------------------------
@@ -77,6 +87,26 @@ void AT_PA_DUTY_CYCLE_event_callback(char* param1, char* param2);
 
 void AT_PA_REAL_POWER_event_callback(char* param1, char* param2);  
 
+void AT_SWEEP_event_callback(char* param1, char* param2);  // 扫描指令
+
+void AT_PERFAST_event_callback(char* param1, char* param2);  // 满负荷PER测试指令
+
+void AT_LINKSTATS_event_callback(char* param1, char* param2);  // 链路统计指令
+
+void AT_PPBENCH_event_callback(char* param1, char* param2);  // 往返时延测试指令
+
+void AT_CADSCAN_event_callback(char* param1, char* param2);  // 多信道CAD扫描指令
+
+void AT_CADTUNE_event_callback(char* param1, char* param2);  // CAD参数自适应指令
+
+void AT_LPM_event_callback(char* param1, char* param2);  // 低功耗模式指令
+
+void AT_SAVE_event_callback(char* param1, char* param2);  // 参数保存指令
+
+void AT_RNG_event_callback(char* param1, char* param2);  // 随机数指令
+
+void AT_OCC_event_callback(char* param1, char* param2);  // 频谱占用记录指令
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -89,6 +119,11 @@ void AT_PA_REAL_POWER_event_callback(char* param1, char* param2);
  */
 static void uart_rx_callback(uint8_t data);
 
+/**
+ * @brief Restore the parameters saved with AT+SAVE, if any
+ */
+static void uart_load_at_parameters(void);
+
 /**
  * @brief Base function to initialize UART peripheral
  *
@@ -134,6 +169,16 @@ void uart_init(void)
 		{"AT+PA_RGE_SUPPLY", ATC_PA_RGE_SUPPLY_event_callback},  // PA_REG_SUPPLY
 		{"AT+PA_DUTY_CYCLE", AT_PA_DUTY_CYCLE_event_callback},  // PA_DUTY_CYCLE
 		{"AT+PA_REAL_POWER", AT_PA_REAL_POWER_event_callback},  // PA_REAL_POWER
+		{"AT+SWEEP", AT_SWEEP_event_callback},  // 扫描指令
+		{"AT+PERFAST", AT_PERFAST_event_callback},  // 满负荷PER测试指令
+		{"AT+LINKSTATS", AT_LINKSTATS_event_callback},  // 链路统计指令
+		{"AT+PPBENCH", AT_PPBENCH_event_callback},  // 往返时延测试指令
+		{"AT+CADSCAN", AT_CADSCAN_event_callback},  // 多信道CAD扫描指令
+		{"AT+CADTUNE", AT_CADTUNE_event_callback},  // CAD参数自适应指令
+		{"AT+LPM", AT_LPM_event_callback},  // 低功耗模式指令
+		{"AT+SAVE", AT_SAVE_event_callback},  // 参数保存指令
+		{"AT+RNG", AT_RNG_event_callback},  // 随机数指令
+		{"AT+OCC", AT_OCC_event_callback},  // 频谱占用记录指令
 		
 		
     {NULL, NULL}  // 事件结束标志
@@ -147,6 +192,10 @@ void uart_init(void)
 
     HAL_DBG_TRACE_INFO("UART and AT command handler initialized.\n");
 		rx_index = 0;
+
+    if (apps_kv_store_init()) {
+        uart_load_at_parameters();
+    }
 }
 
 void vprint(const char* fmt, va_list argp)
@@ -157,6 +206,11 @@ void vprint(const char* fmt, va_list argp)
     }
 }
 
+void uart_send_bytes(const uint8_t* buffer, uint16_t length)
+{
+    smtc_hal_mcu_uart_send(inst_uart, buffer, length);
+}
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
@@ -168,7 +222,7 @@ void uart_init_base(void (*callback_rx)(uint8_t data)) {
     };
 
     const smtc_hal_mcu_uart_cfg_app_t uart_cfg_app = {
-        .baudrate    = 921600,
+        .baudrate    = UART_BAUDRATE,
         .callback_rx = callback_rx,
     };
 
@@ -179,7 +233,7 @@ void uart_init_base(void (*callback_rx)(uint8_t data)) {
         return;
     }
 
-    HAL_DBG_TRACE_INFO("UART initialized on USART2 with baudrate 921600.\n");
+    HAL_DBG_TRACE_INFO("UART initialized on USART2 with baudrate %d.\n", UART_BAUDRATE);
 }
 
 void ATC_IdleLine(ATC_HandleTypeDef* hAtc, uint16_t Len) ;
@@ -224,22 +278,47 @@ void ATC_IdleLine(ATC_HandleTypeDef* hAtc, uint16_t Len) {
     //HAL_DBG_TRACE_INFO("Updated RxIndex: %d. Current buffer content: %s\n", hAtc->RxIndex, hAtc->pReadBuff);
 }
 
+bool uart_is_at_command_pending(void)
+{
+    return at_command_received;
+}
+
+bool uart_process_at_command(void)
+{
+    bool processed = false;
+
+    if (at_command_received) {
+        at_command_received = false;  // 清除标志位
+        if (rx_length > 0) {  // 确保只有在有数据时才处理
+            ATC_IdleLine(&atc_handle,rx_length);
+            ATC_Loop(&atc_handle);
+            processed = true;
+        }
+        rx_length = 0;  // 重置数据长度
+    }
+
+    return processed;
+}
+
 int main_loop(void)
 {
+    // 交互配置阶段不进入 STOP2，避免唤醒时丢失命令的首字节；AT+LPM 设置的模式在 AT+START 后生效
+    lpm_run_mode = smtc_hal_mcu_lpm_get_max_mode();
+    if (lpm_run_mode > SMTC_HAL_MCU_LPM_MODE_SLEEP) {
+        smtc_hal_mcu_lpm_set_max_mode(SMTC_HAL_MCU_LPM_MODE_SLEEP);
+    }
+
     while (1) {
-        if (at_command_received) {
-            at_command_received = false;  // 清除标志位
-            if (rx_length > 0) {  // 确保只有在有数据时才处理
-                ATC_IdleLine(&atc_handle,rx_length);
-                ATC_Loop(&atc_handle);
-            }
-            rx_length = 0;  // 重置数据长度
-        }
-				LL_mDelay( 20 );
+        uart_process_at_command();
         // 其他主循环代码
         if(AT_start_flag == 1){
+            smtc_hal_mcu_lpm_set_max_mode(lpm_run_mode);
+            smtc_hal_mcu_lpm_reset_stats();
             return 1;
         }
+        if (!apps_kv_store_process()) {
+            smtc_hal_mcu_lpm_wait_for_event(uart_is_at_command_pending);
+        }
     }
 }
 
@@ -305,34 +384,9 @@ void AT_SF_Callback(char* param1, char* param2) {
         HAL_DBG_TRACE_INFO("Parameter set to: %d\n", param);
         
         // 在这里进行超参数设置的具体操作
-        switch (param) {
-            case 5:
-                ATC_M_LORA_SF = LR11XX_RADIO_LORA_SF5;
-                break;
-            case 6:
-                ATC_M_LORA_SF = LR11XX_RADIO_LORA_SF6;
-                break;
-            case 7:
-                ATC_M_LORA_SF = LR11XX_RADIO_LORA_SF7;
-                break;
-            case 8:
-                ATC_M_LORA_SF = LR11XX_RADIO_LORA_SF8;
-                break;
-            case 9:
-                ATC_M_LORA_SF = LR11XX_RADIO_LORA_SF9;
-                break;
-            case 10:
-                ATC_M_LORA_SF = LR11XX_RADIO_LORA_SF10;
-                break;
-            case 11:
-                ATC_M_LORA_SF = LR11XX_RADIO_LORA_SF11;
-                break;
-            case 12:
-                ATC_M_LORA_SF = LR11XX_RADIO_LORA_SF12;
-                break;
-            default:
-                HAL_DBG_TRACE_INFO("Invalid parameter value.\n");
-                return;
+        if (!ATC_LoraSfFromParam(param, &ATC_M_LORA_SF)) {
+            HAL_DBG_TRACE_INFO("Invalid parameter value.\n");
+            return;
         }
     } else {
         HAL_DBG_TRACE_INFO("Invalid parameter.\n");
@@ -347,46 +401,9 @@ void AT_BW_Callback(char* param1, char* param2) {
         HAL_DBG_TRACE_INFO("Band width set to: %d\n", param);
         
         // 在这里进行超参数设置的具体操作
-        switch (param) {
-            case 10:
-                ATC_M_LORA_BW = LR11XX_RADIO_LORA_BW_10;
-                break;
-            case 15:
-                ATC_M_LORA_BW = LR11XX_RADIO_LORA_BW_15;
-                break;
-            case 20:
-                ATC_M_LORA_BW = LR11XX_RADIO_LORA_BW_20;
-                break;
-            case 31:
-                ATC_M_LORA_BW = LR11XX_RADIO_LORA_BW_31;
-                break;
-            case 41:
-                ATC_M_LORA_BW = LR11XX_RADIO_LORA_BW_41;
-                break;
-            case 62:
-                ATC_M_LORA_BW = LR11XX_RADIO_LORA_BW_62;
-                break;
-            case 125:
-                ATC_M_LORA_BW = LR11XX_RADIO_LORA_BW_125;
-                break;
-            case 250:
-                ATC_M_LORA_BW = LR11XX_RADIO_LORA_BW_250;
-                break;
-            case 500:
-                ATC_M_LORA_BW = LR11XX_RADIO_LORA_BW_500;
-                break;
-            case 200:
-                ATC_M_LORA_BW = LR11XX_RADIO_LORA_BW_200;
-                break;
-            case 400:
-                ATC_M_LORA_BW = LR11XX_RADIO_LORA_BW_400;
-                break;
-            case 800:
-                ATC_M_LORA_BW = LR11XX_RADIO_LORA_BW_800;
-                break;
-            default:
-                HAL_DBG_TRACE_INFO("Invalid parameter value.\n");
-                return;
+        if (!ATC_LoraBwFromParam(param, &ATC_M_LORA_BW)) {
+            HAL_DBG_TRACE_INFO("Invalid parameter value.\n");
+            return;
         }
     } else {
         HAL_DBG_TRACE_INFO("Invalid parameter.\n");
@@ -400,34 +417,9 @@ void AT_CR_Callback(char* param1, char* param2) {
         int param = atoi(param1);  // 将超参数字符串转换为整数
         HAL_DBG_TRACE_INFO("Parameter set to: %d\n", param);
         // 在这里进行超参数设置的具体操作
-        switch (param) {
-            case 0:
-                ATC_M_LORA_CR = LR11XX_RADIO_LORA_NO_CR;
-                break;
-            case 1:
-                ATC_M_LORA_CR = LR11XX_RADIO_LORA_CR_4_5;
-                break;
-            case 2:
-                ATC_M_LORA_CR = LR11XX_RADIO_LORA_CR_4_6;
-                break;
-            case 3:
-                ATC_M_LORA_CR = LR11XX_RADIO_LORA_CR_4_7;
-                break;
-            case 4:
-                ATC_M_LORA_CR = LR11XX_RADIO_LORA_CR_4_8;
-                break;
-            case 5:
-                ATC_M_LORA_CR = LR11XX_RADIO_LORA_CR_LI_4_5;
-                break;
-            case 6:
-                ATC_M_LORA_CR = LR11XX_RADIO_LORA_CR_LI_4_6;
-                break;
-            case 7:
-                ATC_M_LORA_CR = LR11XX_RADIO_LORA_CR_LI_4_8;
-                break;
-            default:
-                HAL_DBG_TRACE_INFO("Invalid parameter value.\n");
-                return;
+        if (!ATC_LoraCrFromParam(param, &ATC_M_LORA_CR)) {
+            HAL_DBG_TRACE_INFO("Invalid parameter value.\n");
+            return;
         }
     } else {
         HAL_DBG_TRACE_INFO("Invalid parameter.\n");
@@ -474,37 +466,50 @@ void AT_Help_Callback(char* param1, char* param2) {
     HAL_DBG_TRACE_INFO("AT+CR=<CR> : Set the Coding Rate (e.g., AT+CR=1 for 4/5 coding rate)\n");
     HAL_DBG_TRACE_INFO("AT+TRSW=<param> : Set the TX/RX switch parameter\n");
     HAL_DBG_TRACE_INFO("AT+CWSW=<param> : Set the CW switch parameter\n");
-    HAL_DBG_TRACE_INFO("Available Spreading Factors (SF):\n");
-    HAL_DBG_TRACE_INFO("  5: LR11XX_RADIO_LORA_SF5\n");
-    HAL_DBG_TRACE_INFO("  6: LR11XX_RADIO_LORA_SF6\n");
-    HAL_DBG_TRACE_INFO("  7: LR11XX_RADIO_LORA_SF7\n");
-    HAL_DBG_TRACE_INFO("  8: LR11XX_RADIO_LORA_SF8\n");
-    HAL_DBG_TRACE_INFO("  9: LR11XX_RADIO_LORA_SF9\n");
-    HAL_DBG_TRACE_INFO(" 10: LR11XX_RADIO_LORA_SF10\n");
-    HAL_DBG_TRACE_INFO(" 11: LR11XX_RADIO_LORA_SF11\n");
-    HAL_DBG_TRACE_INFO(" 12: LR11XX_RADIO_LORA_SF12\n");
-    HAL_DBG_TRACE_INFO("Available Bandwidths (BW):\n");
-    HAL_DBG_TRACE_INFO("   10.42 kHz\n");
-    HAL_DBG_TRACE_INFO("   15.63 kHz\n");
-    HAL_DBG_TRACE_INFO("   20.83 kHz\n");
-    HAL_DBG_TRACE_INFO("   31.25 kHz\n");
-    HAL_DBG_TRACE_INFO("  41.67 kHz\n");
-    HAL_DBG_TRACE_INFO("   62.50 kHz\n");
-    HAL_DBG_TRACE_INFO("   125.00 kHz\n");
-    HAL_DBG_TRACE_INFO("   250.00 kHz\n");
-    HAL_DBG_TRACE_INFO("   500.00 kHz\n");
-    HAL_DBG_TRACE_INFO("  203.00 kHz (2G4 and compatible with LR112x chips only)\n");
-    HAL_DBG_TRACE_INFO("  406.00 kHz (2G4 and compatible with LR112x chips only)\n");
-    HAL_DBG_TRACE_INFO("  812.00 kHz (2G4 and compatible with LR112x chips only)\n");
-    HAL_DBG_TRACE_INFO("Available Coding Rates (CR):\n");
-    HAL_DBG_TRACE_INFO("  0: No coding rate\n");
-    HAL_DBG_TRACE_INFO("  1: 4/5\n");
-    HAL_DBG_TRACE_INFO("  2: 4/6\n");
-    HAL_DBG_TRACE_INFO("  3: 4/7\n");
-    HAL_DBG_TRACE_INFO("  4: 4/8\n");
-    HAL_DBG_TRACE_INFO("  5: LI 4/5\n");
-    HAL_DBG_TRACE_INFO("  6: LI 4/6\n");
-    HAL_DBG_TRACE_INFO("  7: LI 4/8\n");
+    if (ATC_Binding.Features & ATC_FEATURE_PER_SWEEP) {
+        HAL_DBG_TRACE_INFO("AT+SWEEP=<FREQ|SF|BW|POWER>,<v1>:<v2>:... : Define the values of a sweep axis (up to %d)\n",
+                           ATC_SWEEP_VALUES_MAX);
+        HAL_DBG_TRACE_INFO("AT+SWEEP=RUN : Start a PER sweep over the grid, AT+NBFRAME frames per point\n");
+        HAL_DBG_TRACE_INFO("AT+SWEEP=CLEAR : Clear the sweep definition, AT+SWEEP : Show it\n");
+    }
+    if (ATC_Binding.Features & ATC_FEATURE_PER_FAST) {
+        HAL_DBG_TRACE_INFO("AT+PERFAST=<0|1> : PER test at full throughput, AT+NBFRAME frames, summary only\n");
+    }
+    HAL_DBG_TRACE_INFO("AT+LINKSTATS : Show the RSSI/SNR/inter-arrival distributions of the received packets, "
+                       "AT+LINKSTATS=CLEAR : Clear them\n");
+    HAL_DBG_TRACE_INFO("AT+PPBENCH=<window> : Ping-pong round-trip time benchmark with up to %d frames in flight, "
+                       "0 for the classic ping-pong - AT+TRSW=0 initiator, 1 responder\n", ATC_PING_PONG_WINDOW_MAX);
+    HAL_DBG_TRACE_INFO("AT+CADSCAN=<f1>:<f2>:... : Define the CAD scan channels in Hz (up to %d), "
+                       "AT+CADSCAN : Show them\n", ATC_CAD_SCAN_CHANNELS_MAX);
+    HAL_DBG_TRACE_INFO("AT+CADSCAN=RUN[,<sweeps>] : Scan the channels with back-to-back CADs, until AT+CADSCAN=STOP "
+                       "if <sweeps> is 0 or omitted\n");
+    HAL_DBG_TRACE_INFO("AT+CADSCAN=STATS : Show the channel occupancy and the quietest channel\n");
+    HAL_DBG_TRACE_INFO("AT+CADTUNE : Show the adaptive CAD setting and its false alarm/miss counters, "
+                       "AT+CADTUNE=CLEAR : Forget the settings learned for all channels\n");
+    HAL_DBG_TRACE_INFO("AT+LPM=<RUN|SLEEP|STOP> : Set the deepest MCU power mode, AT+LPM : Show the time spent in each\n");
+    HAL_DBG_TRACE_INFO("  In STOP mode, send an empty line first: the bytes received while waking up are lost\n");
+    HAL_DBG_TRACE_INFO("AT+SAVE : Save the current parameters to flash, restored at boot\n");
+    HAL_DBG_TRACE_INFO("AT+SAVE=CLEAR : Erase the saved parameters, AT+SAVE=STATS : Show the flash store usage and wear\n");
+    HAL_DBG_TRACE_INFO("AT+RNG : Print 16 random bytes and the entropy pool statistics, AT+RNG=BENCH : Measure its throughput\n");
+    HAL_DBG_TRACE_INFO("AT+OCC : Show the spectrum occupancy log usage, AT+OCC=DUMP : Send it in binary, "
+                       "AT+OCC=CLEAR : Erase it (spectral_scan)\n");
+    // 可用参数来自射频芯片系列的绑定表
+    HAL_DBG_TRACE_INFO("Available Spreading Factors (SF) for %s:", ATC_Binding.pFamily);
+    for (uint8_t i = 0; i < ATC_Binding.LoraSfCount; i++) {
+        HAL_DBG_TRACE_PRINTF(" %d", ATC_Binding.pLoraSf[i].Param);
+    }
+    HAL_DBG_TRACE_PRINTF("\n");
+    HAL_DBG_TRACE_INFO("Available Bandwidths (BW, kHz) for %s:", ATC_Binding.pFamily);
+    for (uint8_t i = 0; i < ATC_Binding.LoraBwCount; i++) {
+        HAL_DBG_TRACE_PRINTF(" %d", ATC_Binding.pLoraBw[i].Param);
+    }
+    HAL_DBG_TRACE_PRINTF("\n");
+    HAL_DBG_TRACE_INFO("Available Coding Rates (CR) for %s:", ATC_Binding.pFamily);
+    for (uint8_t i = 0; i < ATC_Binding.LoraCrCount; i++) {
+        HAL_DBG_TRACE_PRINTF(" %d", ATC_Binding.pLoraCr[i].Param);
+    }
+    HAL_DBG_TRACE_PRINTF("\n");
+    HAL_DBG_TRACE_INFO("  CR 0: no coding rate, 1-4: 4/5 to 4/8, 5-7: long interleaver 4/5, 4/6, 4/8\n");
 }
 
 void AT_START_event_callback(char* param1, char* param2){
@@ -625,3 +630,366 @@ void ATC_HP_PA_SEL_event_callback(char* param1, char* param2){
     }
 }
 
+static const char* const sweep_axis_names[ATC_SWEEP_AXIS_COUNT] = {"FREQ", "SF", "BW", "POWER"};
+
+void AT_SWEEP_event_callback(char* param1, char* param2){
+    if ((ATC_Binding.Features & ATC_FEATURE_PER_SWEEP) == 0) {
+        HAL_DBG_TRACE_ERROR("SWEEP not supported on %s.\n", ATC_Binding.pFamily);
+        return;
+    }
+    if (param1 == NULL) {
+        // 显示当前扫描定义
+        for (int axis = 0; axis < ATC_SWEEP_AXIS_COUNT; axis++) {
+            HAL_DBG_TRACE_INFO("SWEEP %s: %d value(s)\n", sweep_axis_names[axis], ATC_SweepGetAxisCount(axis));
+        }
+        HAL_DBG_TRACE_INFO("SWEEP points: %u\n", ATC_SweepGetPointCount());
+    } else if (strcmp(param1, "CLEAR") == 0) {
+        ATC_SweepClear();
+        HAL_DBG_TRACE_INFO("SWEEP cleared.\n");
+    } else if (strcmp(param1, "RUN") == 0) {
+        if (ATC_SweepGetPointCount() == 0) {
+            HAL_DBG_TRACE_INFO("SWEEP not defined.\n");
+            return;
+        }
+        HAL_DBG_TRACE_INFO("SWEEP started: %u points.\n", ATC_SweepGetPointCount());
+        ATC_M_SWEEP_SWITCH = 1;
+        AT_start_flag = 1;
+    } else {
+        int axis = 0;
+        while (axis < ATC_SWEEP_AXIS_COUNT && strcmp(param1, sweep_axis_names[axis]) != 0) {
+            axis++;
+        }
+        if (axis == ATC_SWEEP_AXIS_COUNT || param2 == NULL) {
+            HAL_DBG_TRACE_INFO("Invalid parameter.\n");
+            return;
+        }
+
+        // 数值列表以 ':' 分隔，例如 AT+SWEEP=SF,7:9:12
+        int32_t values[ATC_SWEEP_VALUES_MAX];
+        uint8_t count = 0;
+        char* cursor = param2;
+        while (*cursor != '\0') {
+            char* endptr;
+            long value = strtol(cursor, &endptr, 10);
+            if (endptr == cursor || (*endptr != ':' && *endptr != '\0') || count == ATC_SWEEP_VALUES_MAX) {
+                HAL_DBG_TRACE_INFO("Invalid sweep value list.\n");
+                return;
+            }
+            values[count++] = (int32_t) value;
+            cursor = (*endptr == ':') ? endptr + 1 : endptr;
+        }
+
+        if (!ATC_SweepSetAxis(axis, values, count)) {
+            HAL_DBG_TRACE_INFO("Invalid parameter value.\n");
+            return;
+        }
+        HAL_DBG_TRACE_INFO("SWEEP %s set: %d value(s), %u points.\n", sweep_axis_names[axis], count,
+                           ATC_SweepGetPointCount());
+    }
+}
+
+void AT_PERFAST_event_callback(char* param1, char* param2){
+    if ((ATC_Binding.Features & ATC_FEATURE_PER_FAST) == 0) {
+        HAL_DBG_TRACE_ERROR("PERFAST not supported on %s.\n", ATC_Binding.pFamily);
+        return;
+    }
+    if (param1 != NULL) {
+        int param = atoi(param1);
+        HAL_DBG_TRACE_INFO("PER fast mode set to: %d\n", param);
+        // 帧间无间隔，仅在测试结束时打印统计
+        ATC_M_PER_FAST_SWITCH = param;
+    } else {
+        HAL_DBG_TRACE_INFO("Invalid parameter.\n");
+    }
+}
+
+void AT_LINKSTATS_event_callback(char* param1, char* param2){
+    if (param1 == NULL) {
+        apps_link_stats_print();
+    } else if (strcmp(param1, "CLEAR") == 0) {
+        apps_link_stats_reset();
+        HAL_DBG_TRACE_INFO("Link statistics cleared.\n");
+    } else {
+        HAL_DBG_TRACE_INFO("Invalid parameter.\n");
+    }
+}
+
+void AT_PPBENCH_event_callback(char* param1, char* param2){
+    if (param1 != NULL) {
+        int param = atoi(param1);
+        if (param < 0 || param > ATC_PING_PONG_WINDOW_MAX) {
+            HAL_DBG_TRACE_INFO("Invalid parameter.\n");
+            return;
+        }
+        HAL_DBG_TRACE_INFO("Ping-pong benchmark window set to: %d\n", param);
+        ATC_M_PING_PONG_WINDOW = param;
+    } else {
+        HAL_DBG_TRACE_INFO("Invalid parameter.\n");
+    }
+}
+
+void AT_CADSCAN_event_callback(char* param1, char* param2){
+    const uint32_t* freqs;
+    uint8_t count = ATC_CadScanGetChannels(&freqs);
+
+    if (param1 == NULL) {
+        // 显示当前信道列表
+        HAL_DBG_TRACE_INFO("CADSCAN channels: %d\n", count);
+        for (uint8_t i = 0; i < count; i++) {
+            HAL_DBG_TRACE_INFO("CADSCAN channel %d: %u Hz\n", i, (unsigned int) freqs[i]);
+        }
+    } else if (strcmp(param1, "RUN") == 0) {
+        if (count == 0) {
+            HAL_DBG_TRACE_INFO("CADSCAN channels not defined.\n");
+            return;
+        }
+        ATC_M_CAD_SCAN_NB_SWEEPS = (param2 != NULL) ? atoi(param2) : 0;
+        if (ATC_M_CAD_SCAN_NB_SWEEPS < 0) {
+            HAL_DBG_TRACE_INFO("Invalid parameter.\n");
+            return;
+        }
+        HAL_DBG_TRACE_INFO("CADSCAN started: %d channel(s), %d sweep(s).\n", count, ATC_M_CAD_SCAN_NB_SWEEPS);
+        ATC_M_CAD_SCAN_SWITCH = 1;
+        AT_start_flag = 1;
+    } else if (strcmp(param1, "STOP") == 0) {
+        // 在当前CAD结束后停止扫描
+        ATC_M_CAD_SCAN_SWITCH = 0;
+        apps_cad_scan_stop();
+    } else if (strcmp(param1, "STATS") == 0) {
+        apps_cad_scan_print();
+    } else {
+        // 频率列表以 ':' 分隔，例如 AT+CADSCAN=868100000:868300000:868500000
+        uint32_t values[ATC_CAD_SCAN_CHANNELS_MAX];
+        count = 0;
+        char* cursor = param1;
+        while (*cursor != '\0') {
+            char* endptr;
+            unsigned long value = strtoul(cursor, &endptr, 10);
+            if (endptr == cursor || (*endptr != ':' && *endptr != '\0') || count == ATC_CAD_SCAN_CHANNELS_MAX) {
+                HAL_DBG_TRACE_INFO("Invalid channel list.\n");
+                return;
+            }
+            values[count++] = (uint32_t) value;
+            cursor = (*endptr == ':') ? endptr + 1 : endptr;
+        }
+
+        if (!ATC_CadScanSetChannels(values, count)) {
+            HAL_DBG_TRACE_INFO("Invalid parameter value.\n");
+            return;
+        }
+        HAL_DBG_TRACE_INFO("CADSCAN channels set: %d\n", count);
+    }
+}
+
+void AT_CADTUNE_event_callback(char* param1, char* param2){
+    if (param1 == NULL) {
+        apps_cad_tuner_print();
+    } else if (strcmp(param1, "CLEAR") == 0) {
+        // 只清除flash中的记录，当前信道继续使用正在调整的参数
+        if (!apps_cad_tuner_clear()) {
+            HAL_DBG_TRACE_INFO("CAD settings not erased.\n");
+            return;
+        }
+        HAL_DBG_TRACE_INFO("CAD settings erased.\n");
+    } else {
+        HAL_DBG_TRACE_INFO("Invalid parameter.\n");
+    }
+}
+
+static const char* const lpm_mode_names[SMTC_HAL_MCU_LPM_MODE_COUNT] = {"RUN", "SLEEP", "STOP"};
+
+void uart_print_lpm_stats(void)
+{
+    smtc_hal_mcu_lpm_stats_t stats;
+    if (smtc_hal_mcu_lpm_get_stats(&stats) != SMTC_HAL_MCU_STATUS_OK) {
+        HAL_DBG_TRACE_INFO("Low power mode management not initialized.\n");
+        return;
+    }
+    HAL_DBG_TRACE_INFO("LPM max mode: %s\n", lpm_mode_names[lpm_run_mode]);
+    for (uint8_t mode = 0; mode < SMTC_HAL_MCU_LPM_MODE_COUNT; mode++) {
+        HAL_DBG_TRACE_INFO("  %-5s: %u ms, %u wake-up(s)\n", lpm_mode_names[mode], stats.time_in_ms[mode],
+                           stats.nb_entries[mode]);
+    }
+}
+
+void AT_LPM_event_callback(char* param1, char* param2){
+    if (param1 == NULL) {
+        uart_print_lpm_stats();
+        return;
+    }
+
+    for (uint8_t mode = 0; mode < SMTC_HAL_MCU_LPM_MODE_COUNT; mode++) {
+        if (strcmp(param1, lpm_mode_names[mode]) == 0) {
+            lpm_run_mode = (smtc_hal_mcu_lpm_mode_t) mode;
+            if (AT_start_flag == 1) {
+                smtc_hal_mcu_lpm_set_max_mode(lpm_run_mode);
+                smtc_hal_mcu_lpm_reset_stats();
+            }
+            HAL_DBG_TRACE_INFO("LPM max mode set to: %s\n", lpm_mode_names[mode]);
+            return;
+        }
+    }
+    HAL_DBG_TRACE_INFO("Invalid parameter.\n");
+}
+
+// AT+SAVE 保存到 flash 的参数，结构变化时需要增加版本号
+#define AT_SAVED_PARAMETERS_VERSION 1
+
+typedef struct {
+    uint16_t version;
+    uint16_t lpm_run_mode;
+    uint32_t rf_freq_in_hz;
+    int32_t tx_output_power_dbm;
+    int32_t txrx_switch;
+    int32_t lora_sf;
+    int32_t lora_bw;
+    int32_t lora_cr;
+    int32_t cw_switch;
+    int32_t nb_frame;
+    int32_t lora_rx_boost;
+    int32_t lora_sleep;
+    int32_t pa_hp_sel;
+    int32_t pa_sel;
+    int32_t pa_reg_supply;
+    int32_t pa_duty_cycle;
+    int32_t pa_real_power;
+} at_saved_parameters_t;
+
+static void uart_load_at_parameters(void)
+{
+    at_saved_parameters_t params;
+    uint16_t length;
+
+    if (smtc_kv_store_read(apps_kv_store_get(), APPS_KV_STORE_KEY_AT_PARAMETERS, (uint8_t*) &params, sizeof(params),
+                           &length) != SMTC_KV_STORE_STATUS_OK) {
+        return;
+    }
+    if ((length != sizeof(params)) || (params.version != AT_SAVED_PARAMETERS_VERSION) ||
+        (params.lpm_run_mode >= SMTC_HAL_MCU_LPM_MODE_COUNT)) {
+        HAL_DBG_TRACE_WARNING("Saved parameters ignored: saved by another firmware version.\n");
+        return;
+    }
+
+    lpm_run_mode = (smtc_hal_mcu_lpm_mode_t) params.lpm_run_mode;
+    smtc_hal_mcu_lpm_set_max_mode(lpm_run_mode);
+    ATC_M_RF_FREQ_IN_HZ = params.rf_freq_in_hz;
+    ATC_M_TX_OUTPUT_POWER_DBM = params.tx_output_power_dbm;
+    ATC_M_TXRX_SWITCH = params.txrx_switch;
+    ATC_M_LORA_SF = params.lora_sf;
+    ATC_M_LORA_BW = params.lora_bw;
+    ATC_M_LORA_CR = params.lora_cr;
+    ATC_M_CW_SWITCH = params.cw_switch;
+    ATC_M_NB_FRAME = params.nb_frame;
+    ATC_M_LORA_RX_BOOST = params.lora_rx_boost;
+    ATC_M_LORA_SLEEP = params.lora_sleep;
+    ATC_M_PA_PA_HP_SEL = params.pa_hp_sel;
+    ATC_M_PA_PA_SEL = params.pa_sel;
+    ATC_M_PA_PA_RGE_SUPPLY = params.pa_reg_supply;
+    ATC_M_PA_PA_DUTY_CYCLE = params.pa_duty_cycle;
+    ATC_M_PA_PA_REAL_POWER = params.pa_real_power;
+
+    HAL_DBG_TRACE_INFO("Parameters restored from flash: %u Hz, %d dBm, SF%d, BW %d, CR %d.\n", ATC_M_RF_FREQ_IN_HZ,
+                       ATC_M_TX_OUTPUT_POWER_DBM, ATC_M_LORA_SF, ATC_M_LORA_BW, ATC_M_LORA_CR);
+}
+
+void AT_SAVE_event_callback(char* param1, char* param2){
+    smtc_kv_store_t* store = apps_kv_store_get();
+    smtc_kv_store_status_t status;
+
+    if (store == NULL) {
+        HAL_DBG_TRACE_INFO("Flash store not available.\n");
+        return;
+    }
+
+    if (param1 != NULL && strcmp(param1, "STATS") == 0) {
+        apps_kv_store_print_stats();
+        return;
+    }
+
+    if (param1 != NULL && strcmp(param1, "CLEAR") == 0) {
+        status = smtc_kv_store_delete(store, APPS_KV_STORE_KEY_AT_PARAMETERS);
+        if (status == SMTC_KV_STORE_STATUS_OK || status == SMTC_KV_STORE_STATUS_NOT_FOUND) {
+            HAL_DBG_TRACE_INFO("Saved parameters erased, defaults apply at next boot.\n");
+        } else {
+            HAL_DBG_TRACE_INFO("Erase failed (%d).\n", status);
+        }
+        return;
+    }
+
+    if (param1 != NULL) {
+        HAL_DBG_TRACE_INFO("Invalid parameter.\n");
+        return;
+    }
+
+    const at_saved_parameters_t params = {
+        .version = AT_SAVED_PARAMETERS_VERSION,
+        .lpm_run_mode = (uint16_t) lpm_run_mode,
+        .rf_freq_in_hz = ATC_M_RF_FREQ_IN_HZ,
+        .tx_output_power_dbm = ATC_M_TX_OUTPUT_POWER_DBM,
+        .txrx_switch = ATC_M_TXRX_SWITCH,
+        .lora_sf = ATC_M_LORA_SF,
+        .lora_bw = ATC_M_LORA_BW,
+        .lora_cr = ATC_M_LORA_CR,
+        .cw_switch = ATC_M_CW_SWITCH,
+        .nb_frame = ATC_M_NB_FRAME,
+        .lora_rx_boost = ATC_M_LORA_RX_BOOST,
+        .lora_sleep = ATC_M_LORA_SLEEP,
+        .pa_hp_sel = ATC_M_PA_PA_HP_SEL,
+        .pa_sel = ATC_M_PA_PA_SEL,
+        .pa_reg_supply = ATC_M_PA_PA_RGE_SUPPLY,
+        .pa_duty_cycle = ATC_M_PA_PA_DUTY_CYCLE,
+        .pa_real_power = ATC_M_PA_PA_REAL_POWER,
+    };
+
+    status = smtc_kv_store_write(store, APPS_KV_STORE_KEY_AT_PARAMETERS, (const uint8_t*) &params, sizeof(params));
+    if (status == SMTC_KV_STORE_STATUS_OK) {
+        HAL_DBG_TRACE_INFO("Parameters saved.\n");
+    } else {
+        HAL_DBG_TRACE_INFO("Save failed (%d).\n", status);
+    }
+}
+
+void AT_RNG_event_callback(char* param1, char* param2){
+    uint8_t random[16];
+
+    if (param1 != NULL && strcmp(param1, "BENCH") == 0) {
+        apps_entropy_benchmark();
+        return;
+    }
+
+    if (param1 != NULL) {
+        HAL_DBG_TRACE_INFO("Invalid parameter.\n");
+        return;
+    }
+
+    if (!apps_entropy_get_bytes(random, sizeof(random))) {
+        HAL_DBG_TRACE_INFO("Entropy pool not available.\n");
+        return;
+    }
+
+    HAL_DBG_TRACE_INFO("Random: ");
+    for (uint8_t i = 0; i < sizeof(random); i++) {
+        HAL_DBG_TRACE_PRINTF("%02X", random[i]);
+    }
+    HAL_DBG_TRACE_PRINTF("\n");
+    apps_entropy_print_stats();
+}
+
+void AT_OCC_event_callback(char* param1, char* param2){
+    if (param1 == NULL) {
+        apps_occupancy_recorder_print_stats();
+    } else if (strcmp(param1, "DUMP") == 0) {
+        // 二进制数据紧跟在提示行之后，用 smtc_occupancy_log_decode 解码
+        if (!apps_occupancy_recorder_dump()) {
+            HAL_DBG_TRACE_INFO("Occupancy recorder not running.\n");
+        }
+    } else if (strcmp(param1, "CLEAR") == 0) {
+        if (!apps_occupancy_recorder_clear()) {
+            HAL_DBG_TRACE_INFO("Occupancy log not erased.\n");
+            return;
+        }
+        HAL_DBG_TRACE_INFO("Occupancy log erased.\n");
+    } else {
+        HAL_DBG_TRACE_INFO("Invalid parameter.\n");
+    }
+}
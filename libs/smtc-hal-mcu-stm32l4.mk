@@ -41,6 +41,8 @@ $(TOP_DIR)/libs/smtc-hal-mcu-stm32l4/src/smtc_hal_mcu_gpio_stm32l4.c \
 $(TOP_DIR)/libs/smtc-hal-mcu-stm32l4/src/smtc_hal_mcu_rng_stm32l4.c \
 $(TOP_DIR)/libs/smtc-hal-mcu-stm32l4/src/smtc_hal_mcu_uart_stm32l4.c \
 $(TOP_DIR)/libs/smtc-hal-mcu-stm32l4/src/smtc_hal_mcu_timer_stm32l4.c \
+$(TOP_DIR)/libs/smtc-hal-mcu-stm32l4/src/smtc_hal_mcu_lpm_stm32l4.c \
+$(TOP_DIR)/libs/smtc-hal-mcu-stm32l4/src/smtc_hal_mcu_nvm_stm32l4.c \
 $(TOP_DIR)/libs/smtc-hal-mcu-stm32l4/src/smtc_hal_mcu_stm32l4.c \
 $(TOP_DIR)/libs/smtc-hal-mcu-stm32l4/third_party/STM32CubeL4/Drivers/CMSIS/Device/ST/STM32L4xx/Source/Templates/system_stm32l4xx.c
 
@@ -44,8 +44,10 @@ extern "C" {
  * --- DEPENDENCIES ------------------------------------------------------------
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "stm32l4xx.h"
+#include "smtc_hal_mcu_gpio.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -71,11 +73,69 @@ struct smtc_hal_mcu_gpio_cfg_s
     uint32_t      pin;
 };
 
+/**
+ * @brief GPIO resolved to its port registers, for the paths where the instance checks of smtc_hal_mcu_gpio_set_state
+ * and smtc_hal_mcu_gpio_get_state are too slow
+ *
+ * @remark Obtained once with smtc_hal_mcu_gpio_stm32l4_get_fast, then used with the inline functions below: setting
+ * or clearing the pin is a single BSRR write, which is atomic with respect to interrupts touching other pins
+ */
+typedef struct smtc_hal_mcu_gpio_stm32l4_fast_s
+{
+    GPIO_TypeDef* port;
+    uint32_t      pin_mask;
+} smtc_hal_mcu_gpio_stm32l4_fast_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
  */
 
+/**
+ * @brief Resolve an initialised GPIO to its port and pin mask
+ *
+ * @param [in] inst GPIO instance
+ * @param [out] fast Resolved GPIO
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK The GPIO has been resolved
+ * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS The instance is not genuine
+ * @retval SMTC_HAL_MCU_STATUS_NOT_INIT The GPIO is not initialised
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_gpio_stm32l4_get_fast( smtc_hal_mcu_gpio_inst_t          inst,
+                                                          smtc_hal_mcu_gpio_stm32l4_fast_t* fast );
+
+/**
+ * @brief Drive a resolved output GPIO high
+ *
+ * @param [in] fast Resolved GPIO
+ */
+inline static void smtc_hal_mcu_gpio_stm32l4_fast_set_high( const smtc_hal_mcu_gpio_stm32l4_fast_t* fast )
+{
+    fast->port->BSRR = fast->pin_mask;
+}
+
+/**
+ * @brief Drive a resolved output GPIO low
+ *
+ * @param [in] fast Resolved GPIO
+ */
+inline static void smtc_hal_mcu_gpio_stm32l4_fast_set_low( const smtc_hal_mcu_gpio_stm32l4_fast_t* fast )
+{
+    fast->port->BSRR = fast->pin_mask << GPIO_BSRR_BR0_Pos;
+}
+
+/**
+ * @brief Read the level of a resolved GPIO
+ *
+ * @param [in] fast Resolved GPIO
+ *
+ * @returns true if the pin is high
+ */
+inline static bool smtc_hal_mcu_gpio_stm32l4_fast_is_high( const smtc_hal_mcu_gpio_stm32l4_fast_t* fast )
+{
+    return ( fast->port->IDR & fast->pin_mask ) != 0;
+}
+
 #ifdef __cplusplus
 }
 #endif
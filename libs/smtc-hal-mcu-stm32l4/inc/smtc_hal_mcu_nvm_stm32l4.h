@@ -0,0 +1,111 @@
+/**
+ * @file      smtc_hal_mcu_nvm_stm32l4.h
+ *
+ * @brief      Types for implementation of NVM module on top of STM32L4 internal flash
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMTC_HAL_MCU_NVM_STM32L4_H
+#define SMTC_HAL_MCU_NVM_STM32L4_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include "stm32l4xx.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Size of a flash page, which is the erase granularity
+ */
+#define SMTC_HAL_MCU_NVM_STM32L4_PAGE_SIZE 0x800
+
+/**
+ * @brief Size of a flash double word, which is the write granularity
+ *
+ * @remark A double word can only be programmed once between two erases of its page
+ */
+#define SMTC_HAL_MCU_NVM_STM32L4_WRITE_SIZE 8
+
+/**
+ * @brief Start address of the flash area reserved for NVM storage
+ *
+ * @remark Has to match the NVM region of the linker script (last 32 kB of flash bank 2)
+ */
+#define SMTC_HAL_MCU_NVM_STM32L4_DEFAULT_START_ADDRESS 0x080F8000
+
+/**
+ * @brief Size of the flash area reserved for NVM storage
+ */
+#define SMTC_HAL_MCU_NVM_STM32L4_DEFAULT_SIZE 0x8000
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief NVM configuration structure
+ *
+ * @remark start_address and size have to be multiples of SMTC_HAL_MCU_NVM_STM32L4_PAGE_SIZE
+ */
+struct smtc_hal_mcu_nvm_cfg_s
+{
+    uint32_t start_address;
+    uint32_t size;
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SMTC_HAL_MCU_NVM_STM32L4_H
+
+/* --- EOF ------------------------------------------------------------------ */
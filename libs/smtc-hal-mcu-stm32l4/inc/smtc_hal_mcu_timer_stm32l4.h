@@ -74,6 +74,15 @@ struct smtc_hal_mcu_timer_cfg_s
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
  */
 
+/**
+ * @brief Advance the time base by the time spent in Stop mode, during which the timer clock is gated
+ *
+ * @remark To be called with the interrupts masked, right after waking up from Stop mode
+ *
+ * @param [in] time_in_us Time spent in Stop mode, in microseconds
+ */
+void smtc_hal_mcu_timer_stm32l4_compensate_stop_time( uint32_t time_in_us );
+
 #ifdef __cplusplus
 }
 #endif
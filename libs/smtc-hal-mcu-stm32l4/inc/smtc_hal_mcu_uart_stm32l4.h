@@ -44,6 +44,7 @@ extern "C" {
  * --- DEPENDENCIES ------------------------------------------------------------
  */
 
+#include <stdbool.h>
 #include "stm32l4xx.h"
 
 /*
@@ -74,6 +75,27 @@ struct smtc_hal_mcu_uart_cfg_s
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
  */
 
+/**
+ * @brief Configure the RX pin of the UART as an EXTI line so that a received byte wakes the MCU up from Stop mode
+ *
+ * @remark USART2 cannot wake the MCU up from Stop 2 by itself. The byte waking the MCU up - and the following ones
+ * until the clocks are restored - are lost.
+ */
+void smtc_hal_mcu_uart_stm32l4_enable_wakeup_from_stop( void );
+
+/**
+ * @brief Restore the RX pin configuration changed by smtc_hal_mcu_uart_stm32l4_enable_wakeup_from_stop
+ */
+void smtc_hal_mcu_uart_stm32l4_disable_wakeup_from_stop( void );
+
+/**
+ * @brief Check if bytes have been received since the last call
+ *
+ * @retval true At least one byte has been received
+ * @retval false No byte has been received
+ */
+bool smtc_hal_mcu_uart_stm32l4_get_and_clear_rx_activity( void );
+
 #ifdef __cplusplus
 }
 #endif
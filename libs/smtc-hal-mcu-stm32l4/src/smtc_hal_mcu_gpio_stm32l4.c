@@ -459,6 +459,25 @@ smtc_hal_mcu_status_t smtc_hal_mcu_gpio_get_state( smtc_hal_mcu_gpio_inst_t inst
     return SMTC_HAL_MCU_STATUS_OK;
 }
 
+smtc_hal_mcu_status_t smtc_hal_mcu_gpio_stm32l4_get_fast( smtc_hal_mcu_gpio_inst_t          inst,
+                                                          smtc_hal_mcu_gpio_stm32l4_fast_t* fast )
+{
+    if( smtc_hal_mcu_gpio_stm32l4_is_real_inst( inst ) == false )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    fast->port     = inst->port;
+    fast->pin_mask = inst->pin;
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
 smtc_hal_mcu_status_t smtc_hal_mcu_gpio_enable_irq( smtc_hal_mcu_gpio_inst_t inst )
 {
     if( smtc_hal_mcu_gpio_stm32l4_is_real_inst( inst ) == false )
@@ -0,0 +1,571 @@
+/*!
+ * @file      smtc_hal_mcu_lpm_stm32l4.c
+ *
+ * @brief      Implementation of low power mode module on top of STM32L4 Low Level drivers
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "stm32l4xx.h"
+#include "smtc_hal_mcu_lpm.h"
+#include "smtc_hal_mcu_timer.h"
+#include "smtc_hal_mcu_timer_stm32l4.h"
+#include "smtc_hal_mcu_uart_stm32l4.h"
+#include "stm32l4xx_ll_bus.h"
+#include "stm32l4xx_ll_cortex.h"
+#include "stm32l4xx_ll_exti.h"
+#include "stm32l4xx_ll_pwr.h"
+#include "stm32l4xx_ll_rcc.h"
+#include "stm32l4xx_ll_rtc.h"
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/**
+ * @brief Duration after the last received UART byte during which Stop mode is replaced by Sleep mode
+ *
+ * In Stop mode, the first bytes of a command are lost while the clocks are restored - keeping the MCU in Sleep mode for
+ * a while lets the rest of an interactive session through.
+ */
+#ifndef SMTC_HAL_MCU_LPM_STM32L4_UART_ACTIVITY_WINDOW_IN_MS
+#define SMTC_HAL_MCU_LPM_STM32L4_UART_ACTIVITY_WINDOW_IN_MS 5000
+#endif
+
+/**
+ * @brief Frequency of the RTC sub-second counter used as time base, clocked by LSI without asynchronous prescaler
+ */
+#define SMTC_HAL_MCU_LPM_STM32L4_TICKS_PER_SECOND 32000
+
+/**
+ * @brief Period of the RTC wake-up timer, clocked by LSI divided by 16
+ */
+#define SMTC_HAL_MCU_LPM_STM32L4_WAKEUP_TIMER_PERIOD_IN_US 500
+
+/**
+ * @brief Shortest time before the next software timer expiry for which Stop mode is entered
+ *
+ * Below this value, the MCU goes to Sleep mode so the software timer fires on time.
+ */
+#ifndef SMTC_HAL_MCU_LPM_STM32L4_STOP_MIN_DURATION_IN_US
+#define SMTC_HAL_MCU_LPM_STM32L4_STOP_MIN_DURATION_IN_US 2000
+#endif
+
+/**
+ * @brief Number of ticks before the RTC time of day wraps around
+ */
+#define SMTC_HAL_MCU_LPM_STM32L4_TICKS_PER_DAY ( 86400UL * SMTC_HAL_MCU_LPM_STM32L4_TICKS_PER_SECOND )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static bool is_init = false;
+
+static smtc_hal_mcu_lpm_mode_t max_mode = SMTC_HAL_MCU_LPM_MODE_STOP;
+
+/**
+ * @brief Statistics, in RTC ticks
+ */
+static struct
+{
+    uint32_t start_tick;
+    uint64_t time_in_ticks[SMTC_HAL_MCU_LPM_MODE_COUNT];
+    uint32_t nb_entries[SMTC_HAL_MCU_LPM_MODE_COUNT];
+} lpm_stats;
+
+static bool     is_uart_activity   = false;
+static uint32_t uart_activity_tick = 0;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Start the RTC, clocked by LSI, used as time base in all power modes
+ */
+static void smtc_hal_mcu_lpm_stm32l4_rtc_init( void );
+
+/**
+ * @brief Get the RTC time of day, in ticks
+ *
+ * @returns Time of day in ticks, wrapping around after SMTC_HAL_MCU_LPM_STM32L4_TICKS_PER_DAY ticks
+ */
+static uint32_t smtc_hal_mcu_lpm_stm32l4_get_tick( void );
+
+/**
+ * @brief Get the number of ticks elapsed between two time of day values
+ *
+ * @param [in] start Older time of day
+ * @param [in] end Newer time of day
+ *
+ * @returns Number of ticks elapsed
+ */
+static uint32_t smtc_hal_mcu_lpm_stm32l4_get_elapsed_ticks( uint32_t start, uint32_t end );
+
+/**
+ * @brief Start the RTC wake-up timer, waking the MCU up from Stop mode when the next software timer expires
+ *
+ * @param [in] time_in_us Time before the wake-up, in microseconds - rounded down to the wake-up timer period
+ */
+static void smtc_hal_mcu_lpm_stm32l4_start_wakeup_timer( uint32_t time_in_us );
+
+/**
+ * @brief Stop the RTC wake-up timer and clear its pending interrupt
+ */
+static void smtc_hal_mcu_lpm_stm32l4_stop_wakeup_timer( void );
+
+/**
+ * @brief Get the power mode to enter, taking the UART activity into account
+ *
+ * @returns Power mode to enter
+ */
+static smtc_hal_mcu_lpm_mode_t smtc_hal_mcu_lpm_stm32l4_get_mode( void );
+
+/**
+ * @brief Enter Stop 2 mode and restore the system clock on wake-up
+ */
+static void smtc_hal_mcu_lpm_stm32l4_enter_stop2( void );
+
+/**
+ * @brief Convert a number of ticks to milliseconds
+ *
+ * @param [in] ticks Number of ticks
+ *
+ * @returns Number of milliseconds
+ */
+static uint32_t smtc_hal_mcu_lpm_stm32l4_ticks_to_ms( uint64_t ticks );
+
+/**
+ * @brief Convert a number of ticks to microseconds
+ *
+ * @param [in] ticks Number of ticks
+ *
+ * @returns Number of microseconds
+ */
+static uint32_t smtc_hal_mcu_lpm_stm32l4_ticks_to_us( uint32_t ticks );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+smtc_hal_mcu_status_t smtc_hal_mcu_lpm_init( void )
+{
+    if( is_init == true )
+    {
+        return SMTC_HAL_MCU_STATUS_OK;
+    }
+
+    if( LL_RCC_LSI_IsReady( ) != 1 )
+    {
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
+    smtc_hal_mcu_lpm_stm32l4_rtc_init( );
+
+    // HSI16 is the PLL source: the PLL can be restarted as soon as the MCU wakes up
+    LL_RCC_SetClkAfterWakeFromStop( LL_RCC_STOP_WAKEUPCLOCK_HSI );
+
+    max_mode = SMTC_HAL_MCU_LPM_MODE_STOP;
+    is_init  = true;
+
+    return smtc_hal_mcu_lpm_reset_stats( );
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_lpm_set_max_mode( smtc_hal_mcu_lpm_mode_t mode )
+{
+    if( mode >= SMTC_HAL_MCU_LPM_MODE_COUNT )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    max_mode = mode;
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+smtc_hal_mcu_lpm_mode_t smtc_hal_mcu_lpm_get_max_mode( void )
+{
+    return max_mode;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_lpm_wait_for_event( bool ( *is_event_pending )( void ) )
+{
+    if( is_init == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    smtc_hal_mcu_lpm_mode_t mode = smtc_hal_mcu_lpm_stm32l4_get_mode( );
+
+    if( mode == SMTC_HAL_MCU_LPM_MODE_RUN )
+    {
+        return SMTC_HAL_MCU_STATUS_OK;
+    }
+
+    const uint32_t primask = __get_PRIMASK( );
+    __disable_irq( );
+
+    if( ( is_event_pending != NULL ) && ( is_event_pending( ) == true ) )
+    {
+        __set_PRIMASK( primask );
+        return SMTC_HAL_MCU_STATUS_OK;
+    }
+
+    uint32_t   time_to_timer_in_us = 0;
+    const bool is_timer_running    = smtc_hal_mcu_timer_soft_get_time_to_next_wakeup( &time_to_timer_in_us );
+
+    if( ( is_timer_running == true ) && ( time_to_timer_in_us == 0 ) )
+    {
+        __set_PRIMASK( primask );
+        return SMTC_HAL_MCU_STATUS_OK;
+    }
+
+    // The software timers are clocked by a timer stopped in Stop mode: the RTC takes over for long enough waits
+    if( ( mode == SMTC_HAL_MCU_LPM_MODE_STOP ) && ( is_timer_running == true ) &&
+        ( time_to_timer_in_us < SMTC_HAL_MCU_LPM_STM32L4_STOP_MIN_DURATION_IN_US ) )
+    {
+        mode = SMTC_HAL_MCU_LPM_MODE_SLEEP;
+    }
+
+    const uint32_t start_tick = smtc_hal_mcu_lpm_stm32l4_get_tick( );
+
+    if( mode == SMTC_HAL_MCU_LPM_MODE_STOP )
+    {
+        if( is_timer_running == true )
+        {
+            smtc_hal_mcu_lpm_stm32l4_start_wakeup_timer( time_to_timer_in_us );
+        }
+
+        smtc_hal_mcu_lpm_stm32l4_enter_stop2( );
+
+        if( is_timer_running == true )
+        {
+            smtc_hal_mcu_lpm_stm32l4_stop_wakeup_timer( );
+        }
+    }
+    else
+    {
+        LL_LPM_EnableSleep( );
+        __DSB( );
+        __WFI( );
+    }
+
+    const uint32_t elapsed_ticks =
+        smtc_hal_mcu_lpm_stm32l4_get_elapsed_ticks( start_tick, smtc_hal_mcu_lpm_stm32l4_get_tick( ) );
+
+    if( mode == SMTC_HAL_MCU_LPM_MODE_STOP )
+    {
+        smtc_hal_mcu_timer_stm32l4_compensate_stop_time( smtc_hal_mcu_lpm_stm32l4_ticks_to_us( elapsed_ticks ) );
+    }
+
+    lpm_stats.time_in_ticks[mode] += elapsed_ticks;
+    lpm_stats.nb_entries[mode]++;
+
+    // The interrupt handler which woke the MCU up runs here, with the clocks restored
+    __set_PRIMASK( primask );
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_lpm_get_stats( smtc_hal_mcu_lpm_stats_t* stats )
+{
+    if( is_init == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    const uint64_t total_in_ticks =
+        smtc_hal_mcu_lpm_stm32l4_get_elapsed_ticks( lpm_stats.start_tick, smtc_hal_mcu_lpm_stm32l4_get_tick( ) );
+    uint64_t low_power_in_ticks = 0;
+
+    for( int i = SMTC_HAL_MCU_LPM_MODE_SLEEP; i < SMTC_HAL_MCU_LPM_MODE_COUNT; i++ )
+    {
+        stats->time_in_ms[i] = smtc_hal_mcu_lpm_stm32l4_ticks_to_ms( lpm_stats.time_in_ticks[i] );
+        stats->nb_entries[i] = lpm_stats.nb_entries[i];
+        low_power_in_ticks += lpm_stats.time_in_ticks[i];
+    }
+
+    // Run mode time is what is left, the time spent to enter and leave the low power modes being negligible
+    const uint64_t run_in_ticks = ( total_in_ticks > low_power_in_ticks ) ? ( total_in_ticks - low_power_in_ticks ) : 0;
+
+    stats->time_in_ms[SMTC_HAL_MCU_LPM_MODE_RUN] = smtc_hal_mcu_lpm_stm32l4_ticks_to_ms( run_in_ticks );
+    stats->nb_entries[SMTC_HAL_MCU_LPM_MODE_RUN] = 0;
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_lpm_reset_stats( void )
+{
+    if( is_init == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    for( int i = 0; i < SMTC_HAL_MCU_LPM_MODE_COUNT; i++ )
+    {
+        lpm_stats.time_in_ticks[i] = 0;
+        lpm_stats.nb_entries[i]    = 0;
+    }
+    lpm_stats.start_tick = smtc_hal_mcu_lpm_stm32l4_get_tick( );
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void smtc_hal_mcu_lpm_stm32l4_rtc_init( void )
+{
+    LL_APB1_GRP1_EnableClock( LL_APB1_GRP1_PERIPH_PWR );
+    LL_PWR_EnableBkUpAccess( );
+
+    if( LL_RCC_GetRTCClockSource( ) != LL_RCC_RTC_CLKSOURCE_LSI )
+    {
+        // The RTC clock source can only be changed after a backup domain reset
+        LL_RCC_ForceBackupDomainReset( );
+        LL_RCC_ReleaseBackupDomainReset( );
+        LL_RCC_SetRTCClockSource( LL_RCC_RTC_CLKSOURCE_LSI );
+    }
+    LL_RCC_EnableRTC( );
+
+    LL_RTC_DisableWriteProtection( RTC );
+    LL_RTC_EnableInitMode( RTC );
+    while( LL_RTC_IsActiveFlag_INIT( RTC ) != 1 )
+    {
+    }
+
+    LL_RTC_SetAsynchPrescaler( RTC, 0 );
+    LL_RTC_SetSynchPrescaler( RTC, SMTC_HAL_MCU_LPM_STM32L4_TICKS_PER_SECOND - 1 );
+    LL_RTC_EnableShadowRegBypass( RTC );
+
+    LL_RTC_DisableInitMode( RTC );
+
+    LL_RTC_WAKEUP_Disable( RTC );
+    while( LL_RTC_IsActiveFlag_WUTW( RTC ) != 1 )
+    {
+    }
+    LL_RTC_WAKEUP_SetClock( RTC, LL_RTC_WAKEUPCLOCK_DIV_16 );
+
+    LL_RTC_EnableWriteProtection( RTC );
+
+    // RTC wake-up timer interrupt is routed to the wake-up logic through EXTI line 20
+    LL_EXTI_EnableIT_0_31( LL_EXTI_LINE_20 );
+    LL_EXTI_EnableRisingTrig_0_31( LL_EXTI_LINE_20 );
+
+    NVIC_SetPriority( RTC_WKUP_IRQn, 0 );
+    NVIC_EnableIRQ( RTC_WKUP_IRQn );
+}
+
+static uint32_t smtc_hal_mcu_lpm_stm32l4_get_tick( void )
+{
+    uint32_t sub_second;
+    uint32_t time;
+
+    // Shadow registers are bypassed: read until the sub-second counter is stable around the time read
+    do
+    {
+        sub_second = LL_RTC_TIME_GetSubSecond( RTC );
+        time       = LL_RTC_TIME_Get( RTC );
+    } while( sub_second != LL_RTC_TIME_GetSubSecond( RTC ) );
+
+    const uint32_t seconds = ( __LL_RTC_CONVERT_BCD2BIN( __LL_RTC_GET_HOUR( time ) ) * 3600UL ) +
+                             ( __LL_RTC_CONVERT_BCD2BIN( __LL_RTC_GET_MINUTE( time ) ) * 60UL ) +
+                             __LL_RTC_CONVERT_BCD2BIN( __LL_RTC_GET_SECOND( time ) );
+
+    // The sub-second counter counts down
+    return ( seconds * SMTC_HAL_MCU_LPM_STM32L4_TICKS_PER_SECOND ) +
+           ( SMTC_HAL_MCU_LPM_STM32L4_TICKS_PER_SECOND - 1 - sub_second );
+}
+
+static uint32_t smtc_hal_mcu_lpm_stm32l4_get_elapsed_ticks( uint32_t start, uint32_t end )
+{
+    if( end >= start )
+    {
+        return end - start;
+    }
+
+    return ( SMTC_HAL_MCU_LPM_STM32L4_TICKS_PER_DAY - start ) + end;
+}
+
+static void smtc_hal_mcu_lpm_stm32l4_start_wakeup_timer( uint32_t time_in_us )
+{
+    uint32_t nb_periods = time_in_us / SMTC_HAL_MCU_LPM_STM32L4_WAKEUP_TIMER_PERIOD_IN_US;
+
+    // A longer wait is split: the MCU goes back to Stop mode after the first wake-up
+    if( nb_periods > 0x10000 )
+    {
+        nb_periods = 0x10000;
+    }
+    else if( nb_periods == 0 )
+    {
+        nb_periods = 1;
+    }
+
+    LL_RTC_DisableWriteProtection( RTC );
+
+    LL_RTC_WAKEUP_Disable( RTC );
+    while( LL_RTC_IsActiveFlag_WUTW( RTC ) != 1 )
+    {
+    }
+    LL_RTC_WAKEUP_SetAutoReload( RTC, nb_periods - 1 );
+    LL_RTC_ClearFlag_WUT( RTC );
+    LL_RTC_EnableIT_WUT( RTC );
+    LL_RTC_WAKEUP_Enable( RTC );
+
+    LL_RTC_EnableWriteProtection( RTC );
+}
+
+static void smtc_hal_mcu_lpm_stm32l4_stop_wakeup_timer( void )
+{
+    LL_RTC_DisableWriteProtection( RTC );
+
+    LL_RTC_WAKEUP_Disable( RTC );
+    LL_RTC_DisableIT_WUT( RTC );
+    LL_RTC_ClearFlag_WUT( RTC );
+
+    LL_RTC_EnableWriteProtection( RTC );
+
+    LL_EXTI_ClearFlag_0_31( LL_EXTI_LINE_20 );
+    NVIC_ClearPendingIRQ( RTC_WKUP_IRQn );
+}
+
+static smtc_hal_mcu_lpm_mode_t smtc_hal_mcu_lpm_stm32l4_get_mode( void )
+{
+    const uint32_t now = smtc_hal_mcu_lpm_stm32l4_get_tick( );
+
+    if( smtc_hal_mcu_uart_stm32l4_get_and_clear_rx_activity( ) == true )
+    {
+        is_uart_activity   = true;
+        uart_activity_tick = now;
+    }
+
+    const uint32_t uart_activity_window_in_ticks =
+        SMTC_HAL_MCU_LPM_STM32L4_UART_ACTIVITY_WINDOW_IN_MS * ( SMTC_HAL_MCU_LPM_STM32L4_TICKS_PER_SECOND / 1000 );
+
+    if( ( is_uart_activity == true ) &&
+        ( smtc_hal_mcu_lpm_stm32l4_get_elapsed_ticks( uart_activity_tick, now ) >= uart_activity_window_in_ticks ) )
+    {
+        is_uart_activity = false;
+    }
+
+    if( ( max_mode == SMTC_HAL_MCU_LPM_MODE_STOP ) && ( is_uart_activity == true ) )
+    {
+        return SMTC_HAL_MCU_LPM_MODE_SLEEP;
+    }
+
+    return max_mode;
+}
+
+static void smtc_hal_mcu_lpm_stm32l4_enter_stop2( void )
+{
+    const bool is_sysclk_pll = ( LL_RCC_GetSysClkSource( ) == LL_RCC_SYS_CLKSOURCE_STATUS_PLL );
+    const bool is_pllsai1_on = ( LL_RCC_PLLSAI1_IsReady( ) == 1 );
+
+    smtc_hal_mcu_uart_stm32l4_enable_wakeup_from_stop( );
+
+    LL_PWR_SetPowerMode( LL_PWR_MODE_STOP2 );
+    LL_LPM_EnableDeepSleep( );
+    __DSB( );
+    __WFI( );
+    LL_LPM_EnableSleep( );
+
+    // The MCU wakes up on HSI16: PLL configuration is retained but the PLLs are off
+    if( is_pllsai1_on == true )
+    {
+        LL_RCC_PLLSAI1_Enable( );
+        while( LL_RCC_PLLSAI1_IsReady( ) != 1 )
+        {
+        }
+    }
+
+    if( is_sysclk_pll == true )
+    {
+        LL_RCC_PLL_Enable( );
+        while( LL_RCC_PLL_IsReady( ) != 1 )
+        {
+        }
+
+        LL_RCC_SetSysClkSource( LL_RCC_SYS_CLKSOURCE_PLL );
+        while( LL_RCC_GetSysClkSource( ) != LL_RCC_SYS_CLKSOURCE_STATUS_PLL )
+        {
+        }
+    }
+
+    smtc_hal_mcu_uart_stm32l4_disable_wakeup_from_stop( );
+}
+
+static uint32_t smtc_hal_mcu_lpm_stm32l4_ticks_to_ms( uint64_t ticks )
+{
+    return ( uint32_t ) ( ( ticks * 1000 ) / SMTC_HAL_MCU_LPM_STM32L4_TICKS_PER_SECOND );
+}
+
+static uint32_t smtc_hal_mcu_lpm_stm32l4_ticks_to_us( uint32_t ticks )
+{
+    return ( uint32_t ) ( ( ( uint64_t ) ticks * 1000000 ) / SMTC_HAL_MCU_LPM_STM32L4_TICKS_PER_SECOND );
+}
+
+/**
+ * @brief  This function handles RTC wake-up timer interrupts.
+ */
+void RTC_WKUP_IRQHandler( void )
+{
+    if( LL_RTC_IsActiveFlag_WUT( RTC ) == 1 )
+    {
+        LL_RTC_ClearFlag_WUT( RTC );
+    }
+
+    LL_EXTI_ClearFlag_0_31( LL_EXTI_LINE_20 );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
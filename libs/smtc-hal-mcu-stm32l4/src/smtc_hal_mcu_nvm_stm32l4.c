@@ -0,0 +1,481 @@
+/*!
+ * @file      smtc_hal_mcu_nvm_stm32l4.c
+ *
+ * @brief      Implementation of NVM module on top of STM32L4 internal flash
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "stm32l4xx.h"
+#include "smtc_hal_mcu_nvm.h"
+#include "smtc_hal_mcu_nvm_stm32l4.h"
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/**
+ * @brief Maximum number of NVM instances
+ */
+#ifndef SMTC_HAL_MCU_NVM_STM32L4_N_INSTANCES_MAX
+#define SMTC_HAL_MCU_NVM_STM32L4_N_INSTANCES_MAX 2
+#endif
+
+/**
+ * @brief Keys to be written in FLASH_KEYR to unlock FLASH_CR
+ */
+#define SMTC_HAL_MCU_NVM_STM32L4_KEY1 0x45670123U
+#define SMTC_HAL_MCU_NVM_STM32L4_KEY2 0xCDEF89ABU
+
+/**
+ * @brief Size of a flash bank
+ */
+#define SMTC_HAL_MCU_NVM_STM32L4_BANK_SIZE ( FLASH_BANK1_END - FLASH_BASE + 1 )
+
+/**
+ * @brief Mask of all the error flags of FLASH_SR
+ */
+#define SMTC_HAL_MCU_NVM_STM32L4_SR_ERRORS                                                                      \
+    ( FLASH_SR_OPERR | FLASH_SR_PROGERR | FLASH_SR_WRPERR | FLASH_SR_PGAERR | FLASH_SR_SIZERR | FLASH_SR_PGSERR | \
+      FLASH_SR_MISERR | FLASH_SR_FASTERR | FLASH_SR_RDERR | FLASH_SR_OPTVERR )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Structure defining a NVM instance
+ */
+struct smtc_hal_mcu_nvm_inst_s
+{
+    bool     is_cfged;
+    uint32_t start_address;
+    uint32_t size;
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/**
+ * @brief Array to store the NVM instances
+ */
+static struct smtc_hal_mcu_nvm_inst_s nvm_inst_array[SMTC_HAL_MCU_NVM_STM32L4_N_INSTANCES_MAX];
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Get a pointer to the first free slot
+ *
+ * @retval Pointer to the first free slot - NULL if there is no space left
+ */
+static struct smtc_hal_mcu_nvm_inst_s* smtc_hal_mcu_nvm_stm32l4_get_free_slot( void );
+
+/**
+ * @brief Check if the instance given as parameter is genuine
+ *
+ * @param [in] inst NVM instance
+ *
+ * @retval true Instance is genuine
+ * @retval false Instance is not genuine
+ */
+static bool smtc_hal_mcu_nvm_stm32l4_is_real_inst( smtc_hal_mcu_nvm_inst_t inst );
+
+/**
+ * @brief Check that an access stays within the NVM area of the instance
+ *
+ * @param [in] inst NVM instance
+ * @param [in] offset Offset in NVM
+ * @param [in] length Length of the access
+ *
+ * @retval true The access is within the NVM area
+ * @retval false The access overflows the NVM area
+ */
+static bool smtc_hal_mcu_nvm_stm32l4_is_in_range( smtc_hal_mcu_nvm_inst_t inst, unsigned int offset,
+                                                  unsigned int length );
+
+/**
+ * @brief Unlock the flash control register and clear the flags of a previous operation
+ */
+static void smtc_hal_mcu_nvm_stm32l4_unlock( void );
+
+/**
+ * @brief Lock the flash control register
+ */
+static void smtc_hal_mcu_nvm_stm32l4_lock( void );
+
+/**
+ * @brief Wait for the end of the ongoing flash operation
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK The operation completed without error
+ * @retval SMTC_HAL_MCU_STATUS_ERROR The flash reported an error
+ */
+static smtc_hal_mcu_status_t smtc_hal_mcu_nvm_stm32l4_wait_for_last_operation( void );
+
+/**
+ * @brief Program one double word
+ *
+ * @param [in] address Flash address, aligned on SMTC_HAL_MCU_NVM_STM32L4_WRITE_SIZE
+ * @param [in] data Data to be programmed
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK The double word has been programmed
+ * @retval SMTC_HAL_MCU_STATUS_ERROR The flash reported an error
+ */
+static smtc_hal_mcu_status_t smtc_hal_mcu_nvm_stm32l4_program_double_word( uint32_t address, const uint8_t* data );
+
+/**
+ * @brief Erase one flash page
+ *
+ * @param [in] address Flash address of the page, aligned on SMTC_HAL_MCU_NVM_STM32L4_PAGE_SIZE
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK The page has been erased
+ * @retval SMTC_HAL_MCU_STATUS_ERROR The flash reported an error
+ */
+static smtc_hal_mcu_status_t smtc_hal_mcu_nvm_stm32l4_erase_page( uint32_t address );
+
+/**
+ * @brief Flush the flash data cache so that erased pages are not read from stale cache lines
+ */
+static void smtc_hal_mcu_nvm_stm32l4_flush_data_cache( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_init( const smtc_hal_mcu_nvm_cfg_t cfg, smtc_hal_mcu_nvm_inst_t* inst )
+{
+    struct smtc_hal_mcu_nvm_inst_s* nvm_cfg_slot = smtc_hal_mcu_nvm_stm32l4_get_free_slot( );
+
+    if( nvm_cfg_slot == NULL )
+    {
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
+    if( ( cfg->size == 0 ) || ( ( cfg->start_address % SMTC_HAL_MCU_NVM_STM32L4_PAGE_SIZE ) != 0 ) ||
+        ( ( cfg->size % SMTC_HAL_MCU_NVM_STM32L4_PAGE_SIZE ) != 0 ) || ( cfg->start_address < FLASH_BASE ) ||
+        ( cfg->start_address > ( FLASH_END + 1 - cfg->size ) ) )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    nvm_cfg_slot->start_address = cfg->start_address;
+    nvm_cfg_slot->size          = cfg->size;
+    nvm_cfg_slot->is_cfged      = true;
+
+    *inst = nvm_cfg_slot;
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_deinit( smtc_hal_mcu_nvm_inst_t* inst )
+{
+    smtc_hal_mcu_nvm_inst_t inst_local = *inst;
+
+    if( smtc_hal_mcu_nvm_stm32l4_is_real_inst( inst_local ) == false )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst_local->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    inst_local->is_cfged = false;
+    *inst                = NULL;
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_write( smtc_hal_mcu_nvm_inst_t inst, unsigned int offset, const uint8_t* buffer,
+                                              unsigned int length )
+{
+    smtc_hal_mcu_status_t status = SMTC_HAL_MCU_STATUS_OK;
+
+    if( smtc_hal_mcu_nvm_stm32l4_is_real_inst( inst ) == false )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    if( ( buffer == NULL ) || ( ( offset % SMTC_HAL_MCU_NVM_STM32L4_WRITE_SIZE ) != 0 ) ||
+        ( smtc_hal_mcu_nvm_stm32l4_is_in_range( inst, offset, length ) == false ) )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    smtc_hal_mcu_nvm_stm32l4_unlock( );
+
+    for( unsigned int i = 0; ( i < length ) && ( status == SMTC_HAL_MCU_STATUS_OK );
+         i += SMTC_HAL_MCU_NVM_STM32L4_WRITE_SIZE )
+    {
+        uint8_t double_word[SMTC_HAL_MCU_NVM_STM32L4_WRITE_SIZE];
+
+        /* The last double word is padded with the erased value so that it can be programmed as a whole */
+        memset( double_word, 0xFF, sizeof( double_word ) );
+        memcpy( double_word, &buffer[i],
+                ( ( length - i ) < SMTC_HAL_MCU_NVM_STM32L4_WRITE_SIZE ) ? ( length - i )
+                                                                          : SMTC_HAL_MCU_NVM_STM32L4_WRITE_SIZE );
+
+        status = smtc_hal_mcu_nvm_stm32l4_program_double_word( inst->start_address + offset + i, double_word );
+    }
+
+    smtc_hal_mcu_nvm_stm32l4_lock( );
+
+    return status;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_read( smtc_hal_mcu_nvm_inst_t inst, unsigned int offset, uint8_t* buffer,
+                                             unsigned int length )
+{
+    if( smtc_hal_mcu_nvm_stm32l4_is_real_inst( inst ) == false )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    if( ( buffer == NULL ) || ( smtc_hal_mcu_nvm_stm32l4_is_in_range( inst, offset, length ) == false ) )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    /* The flash is memory mapped */
+    memcpy( buffer, ( const void* ) ( inst->start_address + offset ), length );
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_erase( smtc_hal_mcu_nvm_inst_t inst, unsigned int offset, unsigned int length )
+{
+    smtc_hal_mcu_status_t status = SMTC_HAL_MCU_STATUS_OK;
+
+    if( smtc_hal_mcu_nvm_stm32l4_is_real_inst( inst ) == false )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    if( ( ( offset % SMTC_HAL_MCU_NVM_STM32L4_PAGE_SIZE ) != 0 ) ||
+        ( ( length % SMTC_HAL_MCU_NVM_STM32L4_PAGE_SIZE ) != 0 ) ||
+        ( smtc_hal_mcu_nvm_stm32l4_is_in_range( inst, offset, length ) == false ) )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    smtc_hal_mcu_nvm_stm32l4_unlock( );
+
+    for( unsigned int i = 0; ( i < length ) && ( status == SMTC_HAL_MCU_STATUS_OK );
+         i += SMTC_HAL_MCU_NVM_STM32L4_PAGE_SIZE )
+    {
+        status = smtc_hal_mcu_nvm_stm32l4_erase_page( inst->start_address + offset + i );
+    }
+
+    smtc_hal_mcu_nvm_stm32l4_lock( );
+
+    smtc_hal_mcu_nvm_stm32l4_flush_data_cache( );
+
+    return status;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_get_total_size( smtc_hal_mcu_nvm_inst_t inst, unsigned int* size )
+{
+    if( smtc_hal_mcu_nvm_stm32l4_is_real_inst( inst ) == false )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    *size = inst->size;
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static struct smtc_hal_mcu_nvm_inst_s* smtc_hal_mcu_nvm_stm32l4_get_free_slot( void )
+{
+    for( int i = 0; i < SMTC_HAL_MCU_NVM_STM32L4_N_INSTANCES_MAX; i++ )
+    {
+        if( nvm_inst_array[i].is_cfged == false )
+        {
+            return &nvm_inst_array[i];
+        }
+    }
+
+    return NULL;
+}
+
+static bool smtc_hal_mcu_nvm_stm32l4_is_real_inst( smtc_hal_mcu_nvm_inst_t inst )
+{
+    for( int i = 0; i < SMTC_HAL_MCU_NVM_STM32L4_N_INSTANCES_MAX; i++ )
+    {
+        if( inst == &nvm_inst_array[i] )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool smtc_hal_mcu_nvm_stm32l4_is_in_range( smtc_hal_mcu_nvm_inst_t inst, unsigned int offset,
+                                                  unsigned int length )
+{
+    return ( offset <= inst->size ) && ( length <= ( inst->size - offset ) );
+}
+
+static void smtc_hal_mcu_nvm_stm32l4_unlock( void )
+{
+    if( ( FLASH->CR & FLASH_CR_LOCK ) != 0 )
+    {
+        FLASH->KEYR = SMTC_HAL_MCU_NVM_STM32L4_KEY1;
+        FLASH->KEYR = SMTC_HAL_MCU_NVM_STM32L4_KEY2;
+    }
+
+    /* Flags are cleared by writing 1 */
+    FLASH->SR = SMTC_HAL_MCU_NVM_STM32L4_SR_ERRORS | FLASH_SR_EOP;
+}
+
+static void smtc_hal_mcu_nvm_stm32l4_lock( void )
+{
+    FLASH->CR |= FLASH_CR_LOCK;
+}
+
+static smtc_hal_mcu_status_t smtc_hal_mcu_nvm_stm32l4_wait_for_last_operation( void )
+{
+    while( ( FLASH->SR & FLASH_SR_BSY ) != 0 )
+    {
+    };
+
+    if( ( FLASH->SR & SMTC_HAL_MCU_NVM_STM32L4_SR_ERRORS ) != 0 )
+    {
+        FLASH->SR = SMTC_HAL_MCU_NVM_STM32L4_SR_ERRORS;
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
+    FLASH->SR = FLASH_SR_EOP;
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+static smtc_hal_mcu_status_t smtc_hal_mcu_nvm_stm32l4_program_double_word( uint32_t address, const uint8_t* data )
+{
+    uint32_t              words[2];
+    smtc_hal_mcu_status_t status;
+
+    memcpy( words, data, sizeof( words ) );
+
+    FLASH->CR |= FLASH_CR_PG;
+
+    /* Both words have to be written back to back, the programming starts on the second one */
+    *( volatile uint32_t* ) address = words[0];
+    __ISB( );
+    *( volatile uint32_t* ) ( address + 4 ) = words[1];
+
+    status = smtc_hal_mcu_nvm_stm32l4_wait_for_last_operation( );
+
+    FLASH->CR &= ~FLASH_CR_PG;
+
+    return status;
+}
+
+static smtc_hal_mcu_status_t smtc_hal_mcu_nvm_stm32l4_erase_page( uint32_t address )
+{
+    const uint32_t        offset_in_flash = address - FLASH_BASE;
+    const uint32_t        page_in_bank = ( offset_in_flash % SMTC_HAL_MCU_NVM_STM32L4_BANK_SIZE ) /
+                                  SMTC_HAL_MCU_NVM_STM32L4_PAGE_SIZE;
+    smtc_hal_mcu_status_t status;
+
+    FLASH->CR &= ~( FLASH_CR_PNB_Msk | FLASH_CR_BKER );
+    if( offset_in_flash >= SMTC_HAL_MCU_NVM_STM32L4_BANK_SIZE )
+    {
+        FLASH->CR |= FLASH_CR_BKER;
+    }
+    FLASH->CR |= FLASH_CR_PER | ( page_in_bank << FLASH_CR_PNB_Pos );
+    FLASH->CR |= FLASH_CR_STRT;
+
+    status = smtc_hal_mcu_nvm_stm32l4_wait_for_last_operation( );
+
+    FLASH->CR &= ~( FLASH_CR_PER | FLASH_CR_PNB_Msk | FLASH_CR_BKER );
+
+    return status;
+}
+
+static void smtc_hal_mcu_nvm_stm32l4_flush_data_cache( void )
+{
+    if( ( FLASH->ACR & FLASH_ACR_DCEN ) != 0 )
+    {
+        FLASH->ACR &= ~FLASH_ACR_DCEN;
+        FLASH->ACR |= FLASH_ACR_DCRST;
+        FLASH->ACR &= ~FLASH_ACR_DCRST;
+        FLASH->ACR |= FLASH_ACR_DCEN;
+    }
+}
+
+/* --- EOF ------------------------------------------------------------------ */
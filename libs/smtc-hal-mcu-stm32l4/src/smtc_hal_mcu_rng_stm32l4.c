@@ -135,12 +135,17 @@ smtc_hal_mcu_status_t smtc_hal_mcu_rng_init( const smtc_hal_mcu_rng_cfg_t cfg, s
 
         LL_AHB2_GRP1_EnableClock( LL_AHB2_GRP1_PERIPH_RNG );
 
-        LL_RCC_PLLSAI1_ConfigDomain_48M( LL_RCC_PLLSOURCE_MSI, LL_RCC_PLLM_DIV_1, 24, LL_RCC_PLLSAI1Q_DIV_2 );
-        LL_RCC_PLLSAI1_Enable( );
-        LL_RCC_PLLSAI1_EnableDomain_48M( );
-        while( LL_RCC_PLLSAI1_IsReady( ) != 1 )
+        // smtc_hal_mcu_init already runs PLLSAI1 at 48 MHz: the PLL source is shared with the system PLL and must not
+        // be changed while it runs
+        if( LL_RCC_PLLSAI1_IsReady( ) != 1 )
         {
-        };
+            LL_RCC_PLLSAI1_ConfigDomain_48M( LL_RCC_PLLSOURCE_HSI, LL_RCC_PLLM_DIV_1, 12, LL_RCC_PLLSAI1Q_DIV_4 );
+            LL_RCC_PLLSAI1_Enable( );
+            LL_RCC_PLLSAI1_EnableDomain_48M( );
+            while( LL_RCC_PLLSAI1_IsReady( ) != 1 )
+            {
+            };
+        }
 
         LL_RCC_SetRNGClockSource( LL_RCC_RNG_CLKSOURCE_PLLSAI1 );
 
@@ -177,10 +182,6 @@ smtc_hal_mcu_status_t smtc_hal_mcu_rng_deinit( smtc_hal_mcu_rng_inst_t* inst )
 
     LL_RCC_SetRNGClockSource( LL_RCC_RNG_CLKSOURCE_NONE );
 
-    LL_RCC_PLLSAI1_DisableDomain_48M( );
-    LL_RCC_PLLSAI1_Disable( );
-    LL_RCC_PLLSAI1_ConfigDomain_48M( LL_RCC_PLLSOURCE_NONE, LL_RCC_PLLM_DIV_1, 24, LL_RCC_PLLSAI1Q_DIV_2 );
-
     LL_AHB2_GRP1_DisableClock( LL_AHB2_GRP1_PERIPH_RNG );
 
     inst_local->is_cfged = false;
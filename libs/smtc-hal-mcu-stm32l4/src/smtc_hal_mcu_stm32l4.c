@@ -44,6 +44,8 @@
 #include "stm32l4xx_ll_bus.h"
 #include "stm32l4xx_ll_utils.h"
 #include "smtc_hal_mcu_status.h"
+#include "smtc_hal_mcu_lpm.h"
+#include "smtc_hal_mcu_timer.h"
 #include <stddef.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -128,7 +130,12 @@ smtc_hal_mcu_status_t smtc_hal_mcu_init( )
 
     LL_APB2_GRP1_EnableClock( LL_APB2_GRP1_PERIPH_SYSCFG );
 
-    return SMTC_HAL_MCU_STATUS_OK;
+    if( smtc_hal_mcu_timer_timebase_init( ) != SMTC_HAL_MCU_STATUS_OK )
+    {
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
+    return smtc_hal_mcu_lpm_init( );
 }
 
 /*
@@ -43,6 +43,7 @@
 #include "stm32l4xx_ll_bus.h"
 #include "stm32l4xx_ll_rcc.h"
 #include "stm32l4xx_ll_lptim.h"
+#include "stm32l4xx_ll_tim.h"
 #include <stddef.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -59,6 +60,52 @@
 #define SMTC_HAL_MCU_TIMER_STM32L4_N_INSTANCES_MAX 1
 #endif
 
+/**
+ * @brief Frequency of the free-running time base counter
+ */
+#define SMTC_HAL_MCU_TIMER_STM32L4_TIMEBASE_FREQ_IN_HZ 1000000
+
+/**
+ * @brief Software timer resolution, as a power of two of the time base period
+ */
+#ifndef SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_TICK_SHIFT
+#define SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_TICK_SHIFT 4
+#endif
+
+/**
+ * @brief Software timer resolution, in microseconds
+ */
+#define SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_TICK_IN_US ( 1UL << SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_TICK_SHIFT )
+
+/**
+ * @brief Number of levels of the timer wheel
+ *
+ * Each level has 32 slots, each slot of a level spanning a whole revolution of the level below. With 5 levels and a
+ * 16 us tick, timers up to 2^25 ticks (about 9 minutes) are placed directly - longer ones are cascaded several times.
+ */
+#ifndef SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_LEVELS
+#define SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_LEVELS 5
+#endif
+
+#define SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_SLOT_BITS 5
+#define SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_SLOTS ( 1UL << SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_SLOT_BITS )
+#define SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_SLOT_MASK ( SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_SLOTS - 1 )
+
+/**
+ * @brief Longest delay, in ticks, that can be placed in the wheel without being cascaded
+ */
+#define SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_HORIZON_IN_TICKS \
+    ( 1UL << ( SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_SLOT_BITS * SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_LEVELS ) )
+
+/**
+ * @brief Level value given to an expired timer waiting for its callback to be called
+ */
+#define SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_LEVEL_EXPIRED SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_LEVELS
+
+#if( SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_LEVELS < 1 ) || ( SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_LEVELS > 6 )
+#error "SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_LEVELS must be between 1 and 6"
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE CONSTANTS -------------------------------------------------------
@@ -90,6 +137,35 @@ struct smtc_hal_mcu_timer_inst_s
  */
 static struct smtc_hal_mcu_timer_inst_s tim_inst_array[SMTC_HAL_MCU_TIMER_STM32L4_N_INSTANCES_MAX];
 
+static bool is_timebase_init = false;
+
+/**
+ * @brief Number of wrap-arounds of the 32-bit time base counter
+ */
+static volatile uint32_t timebase_nb_overflows = 0;
+
+/**
+ * @brief Set by the compare interrupt when the wheel has to be processed
+ */
+static volatile bool is_soft_expiry_pending = false;
+
+/**
+ * @brief Hierarchical timer wheel
+ *
+ * The time base compare unit is programmed for the next tick at which a level 0 slot expires or an upper level slot
+ * has to be cascaded, so the wheel is only walked when there is something to do.
+ */
+static struct
+{
+    smtc_hal_mcu_timer_soft_t* slots[SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_LEVELS]
+                                    [SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_SLOTS];
+    uint32_t                   occupancy[SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_LEVELS];  //!< One bit per non-empty slot
+    smtc_hal_mcu_timer_soft_t* expired;
+    uint32_t                   current_tick;
+    bool                       is_wakeup_armed;
+    uint32_t                   wakeup_tick;
+} wheel;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -122,6 +198,57 @@ static struct smtc_hal_mcu_timer_inst_s* smtc_hal_mcu_timer_stm32l4_get_free_slo
  */
 static bool smtc_hal_mcu_timer_stm32l4_is_real_inst( smtc_hal_mcu_timer_inst_t inst );
 
+/**
+ * @brief Get the 64-bit extended time base value
+ *
+ * @returns Time since the time base start, in microseconds
+ */
+static uint64_t smtc_hal_mcu_timer_stm32l4_get_time_in_us_64( void );
+
+/**
+ * @brief Get the current time, in software timer ticks
+ *
+ * @returns Current time, in ticks
+ */
+static uint32_t smtc_hal_mcu_timer_stm32l4_get_tick( void );
+
+/**
+ * @brief Link a software timer at the head of a list
+ *
+ * @param [in] head List head
+ * @param [in] timer Software timer
+ */
+static void smtc_hal_mcu_timer_stm32l4_wheel_link( smtc_hal_mcu_timer_soft_t** head, smtc_hal_mcu_timer_soft_t* timer );
+
+/**
+ * @brief Unlink a software timer from the wheel slot or the expired list it belongs to
+ *
+ * @param [in] timer Software timer
+ */
+static void smtc_hal_mcu_timer_stm32l4_wheel_unlink( smtc_hal_mcu_timer_soft_t* timer );
+
+/**
+ * @brief Place a software timer in the wheel slot matching its expiry
+ *
+ * @param [in] timer Software timer
+ */
+static void smtc_hal_mcu_timer_stm32l4_wheel_insert( smtc_hal_mcu_timer_soft_t* timer );
+
+/**
+ * @brief Get the next tick at which the wheel has to be walked
+ *
+ * @param [out] tick Next tick to process
+ *
+ * @retval true A slot is not empty
+ * @retval false The wheel is empty
+ */
+static bool smtc_hal_mcu_timer_stm32l4_wheel_get_next_tick( uint32_t* tick );
+
+/**
+ * @brief Program the time base compare unit for the next tick at which the wheel has to be walked
+ */
+static void smtc_hal_mcu_timer_stm32l4_wheel_program_wakeup( void );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -309,6 +436,243 @@ smtc_hal_mcu_status_t smtc_hal_mcu_timer_get_max_value( smtc_hal_mcu_timer_inst_
     return SMTC_HAL_MCU_STATUS_OK;
 }
 
+smtc_hal_mcu_status_t smtc_hal_mcu_timer_timebase_init( void )
+{
+    if( is_timebase_init == true )
+    {
+        return SMTC_HAL_MCU_STATUS_OK;
+    }
+
+    LL_APB1_GRP1_EnableClock( LL_APB1_GRP1_PERIPH_TIM2 );
+    while( LL_APB1_GRP1_IsEnabledClock( LL_APB1_GRP1_PERIPH_TIM2 ) != 1 )
+    {
+    }
+
+    // APB1 is not divided: TIM2 kernel clock is the system clock
+    LL_TIM_SetPrescaler( TIM2, __LL_TIM_CALC_PSC( SystemCoreClock, SMTC_HAL_MCU_TIMER_STM32L4_TIMEBASE_FREQ_IN_HZ ) );
+    LL_TIM_SetCounterMode( TIM2, LL_TIM_COUNTERMODE_UP );
+    LL_TIM_SetAutoReload( TIM2, 0xFFFFFFFF );
+    LL_TIM_OC_SetMode( TIM2, LL_TIM_CHANNEL_CH1, LL_TIM_OCMODE_FROZEN );
+
+    // Load the prescaler, then discard the update flag raised by the software event
+    LL_TIM_GenerateEvent_UPDATE( TIM2 );
+    LL_TIM_ClearFlag_UPDATE( TIM2 );
+    LL_TIM_SetCounter( TIM2, 0 );
+
+    LL_TIM_EnableIT_UPDATE( TIM2 );
+    NVIC_SetPriority( TIM2_IRQn, 0 );
+    NVIC_EnableIRQ( TIM2_IRQn );
+
+    LL_TIM_EnableCounter( TIM2 );
+
+    wheel.current_tick = smtc_hal_mcu_timer_stm32l4_get_tick( );
+    is_timebase_init   = true;
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+uint32_t smtc_hal_mcu_timer_get_time_in_us( void )
+{
+    return LL_TIM_GetCounter( TIM2 );
+}
+
+uint32_t smtc_hal_mcu_timer_get_elapsed_time_in_us( uint32_t timestamp_in_us )
+{
+    return LL_TIM_GetCounter( TIM2 ) - timestamp_in_us;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_timer_soft_init( smtc_hal_mcu_timer_soft_t* timer, void ( *callback )( void* context ),
+                                                    void* context )
+{
+    if( ( timer == NULL ) || ( callback == NULL ) )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    timer->next            = NULL;
+    timer->pprev           = NULL;
+    timer->expiry_in_ticks = 0;
+    timer->period_in_ticks = 0;
+    timer->level           = 0;
+    timer->slot            = 0;
+    timer->callback        = callback;
+    timer->context         = context;
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_timer_soft_start( smtc_hal_mcu_timer_soft_t* timer, uint32_t timeout_in_us,
+                                                     uint32_t period_in_us )
+{
+    if( ( timer == NULL ) || ( timer->callback == NULL ) )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( is_timebase_init == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    if( timer->pprev != NULL )
+    {
+        smtc_hal_mcu_timer_stm32l4_wheel_unlink( timer );
+    }
+
+    // Round up so that a timer never expires before the requested timeout
+    const uint64_t expiry_in_us = smtc_hal_mcu_timer_stm32l4_get_time_in_us_64( ) + timeout_in_us +
+                                  SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_TICK_IN_US - 1;
+
+    timer->expiry_in_ticks = ( uint32_t ) ( expiry_in_us >> SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_TICK_SHIFT );
+    timer->period_in_ticks = ( uint32_t ) ( ( ( uint64_t ) period_in_us + SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_TICK_IN_US - 1 ) >>
+                                            SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_TICK_SHIFT );
+
+    smtc_hal_mcu_timer_stm32l4_wheel_insert( timer );
+    smtc_hal_mcu_timer_stm32l4_wheel_program_wakeup( );
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_timer_soft_stop( smtc_hal_mcu_timer_soft_t* timer )
+{
+    if( timer == NULL )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( timer->pprev != NULL )
+    {
+        smtc_hal_mcu_timer_stm32l4_wheel_unlink( timer );
+        smtc_hal_mcu_timer_stm32l4_wheel_program_wakeup( );
+    }
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+bool smtc_hal_mcu_timer_soft_is_running( const smtc_hal_mcu_timer_soft_t* timer )
+{
+    return ( timer != NULL ) && ( timer->pprev != NULL );
+}
+
+bool smtc_hal_mcu_timer_soft_is_expiry_pending( void )
+{
+    return is_soft_expiry_pending;
+}
+
+void smtc_hal_mcu_timer_soft_process( void )
+{
+    if( is_timebase_init == false )
+    {
+        return;
+    }
+
+    // Cleared first: an expiry signalled from now on is caught by this call or the next one
+    is_soft_expiry_pending = false;
+
+    const uint32_t now = smtc_hal_mcu_timer_stm32l4_get_tick( );
+    uint32_t       tick;
+
+    while( ( smtc_hal_mcu_timer_stm32l4_wheel_get_next_tick( &tick ) == true ) && ( ( int32_t ) ( tick - now ) <= 0 ) )
+    {
+        wheel.current_tick = tick;
+
+        // Upper levels first, so that a timer cascaded down to the current level 0 slot expires right away
+        for( int level = SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_LEVELS - 1; level > 0; level-- )
+        {
+            const uint32_t shift = SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_SLOT_BITS * level;
+
+            if( ( tick & ( ( 1UL << shift ) - 1 ) ) == 0 )
+            {
+                smtc_hal_mcu_timer_soft_t** head =
+                    &wheel.slots[level][( tick >> shift ) & SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_SLOT_MASK];
+
+                while( *head != NULL )
+                {
+                    smtc_hal_mcu_timer_soft_t* timer = *head;
+
+                    smtc_hal_mcu_timer_stm32l4_wheel_unlink( timer );
+                    smtc_hal_mcu_timer_stm32l4_wheel_insert( timer );
+                }
+            }
+        }
+
+        smtc_hal_mcu_timer_soft_t** head = &wheel.slots[0][tick & SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_SLOT_MASK];
+
+        while( *head != NULL )
+        {
+            smtc_hal_mcu_timer_soft_t* timer = *head;
+
+            smtc_hal_mcu_timer_stm32l4_wheel_unlink( timer );
+            timer->level = SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_LEVEL_EXPIRED;
+            smtc_hal_mcu_timer_stm32l4_wheel_link( &wheel.expired, timer );
+        }
+    }
+
+    wheel.current_tick = now;
+
+    // A callback may stop or restart any timer, including the expired ones not processed yet
+    while( wheel.expired != NULL )
+    {
+        smtc_hal_mcu_timer_soft_t* timer = wheel.expired;
+
+        smtc_hal_mcu_timer_stm32l4_wheel_unlink( timer );
+
+        if( timer->period_in_ticks != 0 )
+        {
+            // Expiries missed because the main loop was busy are skipped, keeping the timer phase
+            const uint32_t nb_periods = ( ( now - timer->expiry_in_ticks ) / timer->period_in_ticks ) + 1;
+
+            timer->expiry_in_ticks += nb_periods * timer->period_in_ticks;
+            smtc_hal_mcu_timer_stm32l4_wheel_insert( timer );
+        }
+
+        timer->callback( timer->context );
+    }
+
+    smtc_hal_mcu_timer_stm32l4_wheel_program_wakeup( );
+}
+
+bool smtc_hal_mcu_timer_soft_get_time_to_next_wakeup( uint32_t* time_in_us )
+{
+    if( is_soft_expiry_pending == true )
+    {
+        *time_in_us = 0;
+        return true;
+    }
+
+    if( wheel.is_wakeup_armed == false )
+    {
+        return false;
+    }
+
+    const uint32_t remaining_in_us =
+        ( wheel.wakeup_tick << SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_TICK_SHIFT ) - smtc_hal_mcu_timer_get_time_in_us( );
+
+    *time_in_us = ( ( int32_t ) remaining_in_us > 0 ) ? remaining_in_us : 0;
+
+    return true;
+}
+
+void smtc_hal_mcu_timer_stm32l4_compensate_stop_time( uint32_t time_in_us )
+{
+    if( is_timebase_init == false )
+    {
+        return;
+    }
+
+    const uint64_t now_in_us = smtc_hal_mcu_timer_stm32l4_get_time_in_us_64( ) + time_in_us;
+
+    LL_TIM_ClearFlag_UPDATE( TIM2 );
+    timebase_nb_overflows = ( uint32_t ) ( now_in_us >> 32 );
+    LL_TIM_SetCounter( TIM2, ( uint32_t ) now_in_us );
+
+    // The compare value may have been jumped over
+    if( wheel.is_wakeup_armed == true )
+    {
+        is_soft_expiry_pending = true;
+    }
+}
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
@@ -356,6 +720,176 @@ static bool smtc_hal_mcu_timer_stm32l4_is_real_inst( smtc_hal_mcu_timer_inst_t i
     return false;
 }
 
+static uint64_t smtc_hal_mcu_timer_stm32l4_get_time_in_us_64( void )
+{
+    const uint32_t primask = __get_PRIMASK( );
+    __disable_irq( );
+
+    uint32_t       nb_overflows = timebase_nb_overflows;
+    const uint32_t counter      = LL_TIM_GetCounter( TIM2 );
+
+    // A wrap-around not serviced yet is accounted for if the counter was read after it
+    if( ( LL_TIM_IsActiveFlag_UPDATE( TIM2 ) == 1 ) && ( counter < 0x80000000UL ) )
+    {
+        nb_overflows++;
+    }
+
+    __set_PRIMASK( primask );
+
+    return ( ( uint64_t ) nb_overflows << 32 ) | counter;
+}
+
+static uint32_t smtc_hal_mcu_timer_stm32l4_get_tick( void )
+{
+    return ( uint32_t ) ( smtc_hal_mcu_timer_stm32l4_get_time_in_us_64( ) >> SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_TICK_SHIFT );
+}
+
+static void smtc_hal_mcu_timer_stm32l4_wheel_link( smtc_hal_mcu_timer_soft_t** head, smtc_hal_mcu_timer_soft_t* timer )
+{
+    timer->next = *head;
+    if( timer->next != NULL )
+    {
+        timer->next->pprev = &timer->next;
+    }
+    timer->pprev = head;
+    *head        = timer;
+}
+
+static void smtc_hal_mcu_timer_stm32l4_wheel_unlink( smtc_hal_mcu_timer_soft_t* timer )
+{
+    *timer->pprev = timer->next;
+    if( timer->next != NULL )
+    {
+        timer->next->pprev = timer->pprev;
+    }
+
+    if( ( timer->level < SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_LEVELS ) &&
+        ( wheel.slots[timer->level][timer->slot] == NULL ) )
+    {
+        wheel.occupancy[timer->level] &= ~( 1UL << timer->slot );
+    }
+
+    timer->next  = NULL;
+    timer->pprev = NULL;
+}
+
+static void smtc_hal_mcu_timer_stm32l4_wheel_insert( smtc_hal_mcu_timer_soft_t* timer )
+{
+    uint32_t delta = timer->expiry_in_ticks - wheel.current_tick;
+
+    if( ( int32_t ) delta < 0 )
+    {
+        // Overdue: placed in the current level 0 slot, processed on the next walk
+        delta = 0;
+    }
+    else if( delta >= SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_HORIZON_IN_TICKS )
+    {
+        // Too far: parked in the last slot in reach, and placed again when this slot is cascaded
+        delta = SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_HORIZON_IN_TICKS - 1;
+    }
+
+    uint8_t level = 0;
+    while( ( level < ( SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_LEVELS - 1 ) ) &&
+           ( delta >= ( 1UL << ( SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_SLOT_BITS * ( level + 1 ) ) ) ) )
+    {
+        level++;
+    }
+
+    const uint32_t placement_tick = wheel.current_tick + delta;
+
+    timer->level = level;
+    timer->slot  = ( placement_tick >> ( SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_SLOT_BITS * level ) ) &
+                  SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_SLOT_MASK;
+
+    smtc_hal_mcu_timer_stm32l4_wheel_link( &wheel.slots[level][timer->slot], timer );
+    wheel.occupancy[level] |= 1UL << timer->slot;
+}
+
+static bool smtc_hal_mcu_timer_stm32l4_wheel_get_next_tick( uint32_t* tick )
+{
+    bool     is_found  = false;
+    uint32_t min_delta = 0;
+
+    for( int level = 0; level < SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_NB_LEVELS; level++ )
+    {
+        const uint32_t occupancy = wheel.occupancy[level];
+
+        if( occupancy == 0 )
+        {
+            continue;
+        }
+
+        const uint32_t shift    = SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_SLOT_BITS * level;
+        const uint32_t position = ( wheel.current_tick >> shift ) & SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_SLOT_MASK;
+
+        // Level 0 slots expire from the current tick on, upper level slots are cascaded from the next slot boundary on
+        const uint32_t first_step = ( level == 0 ) ? 0 : 1;
+        const uint32_t first_slot = ( position + first_step ) & SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_SLOT_MASK;
+        const uint32_t rotated =
+            ( first_slot == 0 ) ? occupancy : ( ( occupancy >> first_slot ) | ( occupancy << ( 32 - first_slot ) ) );
+        const uint32_t nb_steps = first_step + __CLZ( __RBIT( rotated ) );
+
+        const uint32_t next_tick = ( ( wheel.current_tick >> shift ) + nb_steps ) << shift;
+        const uint32_t delta     = next_tick - wheel.current_tick;
+
+        if( ( is_found == false ) || ( delta < min_delta ) )
+        {
+            is_found  = true;
+            min_delta = delta;
+            *tick     = next_tick;
+        }
+    }
+
+    return is_found;
+}
+
+static void smtc_hal_mcu_timer_stm32l4_wheel_program_wakeup( void )
+{
+    uint32_t tick;
+
+    if( smtc_hal_mcu_timer_stm32l4_wheel_get_next_tick( &tick ) == false )
+    {
+        LL_TIM_DisableIT_CC1( TIM2 );
+        wheel.is_wakeup_armed = false;
+        return;
+    }
+
+    // Lower 32 bits of the time base value at this tick
+    const uint32_t compare = tick << SMTC_HAL_MCU_TIMER_STM32L4_WHEEL_TICK_SHIFT;
+
+    wheel.wakeup_tick     = tick;
+    wheel.is_wakeup_armed = true;
+
+    LL_TIM_OC_SetCompareCH1( TIM2, compare );
+    LL_TIM_ClearFlag_CC1( TIM2 );
+    LL_TIM_EnableIT_CC1( TIM2 );
+
+    // The compare unit only detects an equality: a value already passed would only match after a wrap-around
+    if( ( int32_t ) ( compare - LL_TIM_GetCounter( TIM2 ) ) <= 0 )
+    {
+        is_soft_expiry_pending = true;
+    }
+}
+
+/**
+ * @brief  This function handles TIM2 interrupts.
+ */
+void TIM2_IRQHandler( void )
+{
+    if( LL_TIM_IsActiveFlag_UPDATE( TIM2 ) == 1 )
+    {
+        LL_TIM_ClearFlag_UPDATE( TIM2 );
+        timebase_nb_overflows++;
+    }
+
+    if( ( LL_TIM_IsEnabledIT_CC1( TIM2 ) == 1 ) && ( LL_TIM_IsActiveFlag_CC1( TIM2 ) == 1 ) )
+    {
+        LL_TIM_ClearFlag_CC1( TIM2 );
+        LL_TIM_DisableIT_CC1( TIM2 );
+        is_soft_expiry_pending = true;
+    }
+}
+
 /**
  * @brief  This function handles LPTIM1 interrupts.
  */
@@ -43,6 +43,8 @@
 #include "stm32l4xx_ll_usart.h"
 #include "stm32l4xx_ll_gpio.h"
 #include "stm32l4xx_ll_bus.h"
+#include "stm32l4xx_ll_exti.h"
+#include "stm32l4xx_ll_system.h"
 #include <stddef.h>
 #include <stdbool.h>
 
@@ -88,6 +90,16 @@ struct smtc_hal_mcu_uart_inst_s
  */
 static struct smtc_hal_mcu_uart_inst_s uart_inst_array[SMTC_HAL_MCU_UART_STM32L4_N_INSTANCES_MAX];
 
+/**
+ * @brief Set by the interrupt handler each time a byte is received
+ */
+static volatile bool is_rx_activity = false;
+
+/**
+ * @brief True if the EXTI line of the USART2 RX pin has been configured to wake the MCU up from Stop mode
+ */
+static bool is_rx_wakeup_enabled = false;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -272,6 +284,50 @@ smtc_hal_mcu_status_t smtc_hal_mcu_uart_receive( smtc_hal_mcu_uart_inst_t inst,
     return SMTC_HAL_MCU_STATUS_OK;
 }
 
+void smtc_hal_mcu_uart_stm32l4_enable_wakeup_from_stop( void )
+{
+    for( int i = 0; i < SMTC_HAL_MCU_UART_STM32L4_N_INSTANCES_MAX; i++ )
+    {
+        if( ( uart_inst_array[i].is_cfged == true ) && ( uart_inst_array[i].usart == USART2 ) &&
+            ( uart_inst_array[i].callback_rx != NULL ) )
+        {
+            // Leave EXTI line 3 alone if a GPIO interrupt already uses it
+            if( LL_EXTI_IsEnabledIT_0_31( LL_EXTI_LINE_3 ) == 0 )
+            {
+                LL_SYSCFG_SetEXTISource( LL_SYSCFG_EXTI_PORTA, LL_SYSCFG_EXTI_LINE3 );
+                LL_EXTI_EnableFallingTrig_0_31( LL_EXTI_LINE_3 );
+                LL_EXTI_ClearFlag_0_31( LL_EXTI_LINE_3 );
+                LL_EXTI_EnableIT_0_31( LL_EXTI_LINE_3 );
+                NVIC_EnableIRQ( EXTI3_IRQn );
+
+                is_rx_wakeup_enabled = true;
+            }
+            return;
+        }
+    }
+}
+
+void smtc_hal_mcu_uart_stm32l4_disable_wakeup_from_stop( void )
+{
+    if( is_rx_wakeup_enabled == true )
+    {
+        LL_EXTI_DisableIT_0_31( LL_EXTI_LINE_3 );
+        LL_EXTI_DisableFallingTrig_0_31( LL_EXTI_LINE_3 );
+        LL_EXTI_ClearFlag_0_31( LL_EXTI_LINE_3 );
+
+        is_rx_wakeup_enabled = false;
+    }
+}
+
+bool smtc_hal_mcu_uart_stm32l4_get_and_clear_rx_activity( void )
+{
+    const bool is_rx_activity_local = is_rx_activity;
+
+    is_rx_activity = false;
+
+    return is_rx_activity_local;
+}
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
@@ -305,12 +361,20 @@ static bool smtc_hal_mcu_uart_stm32l4_is_real_inst( smtc_hal_mcu_uart_inst_t ins
 
 void USART2_IRQHandler( void )
 {
+    /* An overrun - e.g. while the clocks are restored after Stop mode - would otherwise keep the interrupt pending */
+    if( LL_USART_IsActiveFlag_ORE( USART2 ) )
+    {
+        LL_USART_ClearFlag_ORE( USART2 );
+    }
+
     /* Check RXNE flag value in ISR register */
     if( LL_USART_IsActiveFlag_RXNE( USART2 ) && LL_USART_IsEnabledIT_RXNE( USART2 ) )
     {
         /* RXNE flag will be cleared by reading of RDR register (done in call) */
         const uint8_t data = LL_USART_ReceiveData8( USART2 );
 
+        is_rx_activity = true;
+
         for( int i = 0; i < SMTC_HAL_MCU_UART_STM32L4_N_INSTANCES_MAX; i++ )
         {
             if( uart_inst_array[i].usart == USART2 )
@@ -0,0 +1,156 @@
+/**
+ * @file      smtc_hal_mcu_lpm.h
+ *
+ * @brief Interface to the low power modes of the MCU
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMTC_HAL_MCU_LPM_H
+#define SMTC_HAL_MCU_LPM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "smtc_hal_mcu_status.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Power modes of the MCU, from the shallowest to the deepest
+ */
+typedef enum smtc_hal_mcu_lpm_mode_e
+{
+    SMTC_HAL_MCU_LPM_MODE_RUN,    //!< Core running - waiting for an event is a busy loop
+    SMTC_HAL_MCU_LPM_MODE_SLEEP,  //!< Core stopped, clocks and peripherals running
+    SMTC_HAL_MCU_LPM_MODE_STOP,   //!< Core and high speed clocks stopped, RAM and wake-up sources retained
+    SMTC_HAL_MCU_LPM_MODE_COUNT,
+} smtc_hal_mcu_lpm_mode_t;
+
+/**
+ * @brief Time spent in each power mode since the last statistics reset
+ */
+typedef struct smtc_hal_mcu_lpm_stats_s
+{
+    uint32_t time_in_ms[SMTC_HAL_MCU_LPM_MODE_COUNT];
+    uint32_t nb_entries[SMTC_HAL_MCU_LPM_MODE_COUNT];  //!< Number of wake-ups for the low power modes
+} smtc_hal_mcu_lpm_stats_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Initialize the low power mode management
+ *
+ * @remark The deepest allowed mode is set to SMTC_HAL_MCU_LPM_MODE_STOP
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK Initialisation completed successfully
+ * @retval SMTC_HAL_MCU_STATUS_ERROR Another error occurred and the low power mode management is not initialised
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_lpm_init( void );
+
+/**
+ * @brief Set the deepest power mode the MCU is allowed to enter while waiting for an event
+ *
+ * @param [in] mode Deepest allowed power mode
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK Mode successfully set
+ * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_lpm_set_max_mode( smtc_hal_mcu_lpm_mode_t mode );
+
+/**
+ * @brief Get the deepest power mode the MCU is allowed to enter while waiting for an event
+ *
+ * @returns Deepest allowed power mode
+ */
+smtc_hal_mcu_lpm_mode_t smtc_hal_mcu_lpm_get_max_mode( void );
+
+/**
+ * @brief Put the MCU in the deepest allowed power mode until an interrupt occurs
+ *
+ * The pending event check and the entry in low power mode are done with interrupts masked, so an event raised by an
+ * interrupt handler right before going to sleep cannot be missed. On return, the clocks are restored and the interrupt
+ * handler which woke the MCU up has been executed.
+ *
+ * @param [in] is_event_pending Function returning true if an event is waiting to be processed - can be NULL
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK The MCU woke up or an event was already pending
+ * @retval SMTC_HAL_MCU_STATUS_NOT_INIT The operation failed as the low power mode management is not initialised
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_lpm_wait_for_event( bool ( *is_event_pending )( void ) );
+
+/**
+ * @brief Get the time spent in each power mode since the last statistics reset
+ *
+ * @param [out] stats Power mode statistics
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK Statistics successfully reported
+ * @retval SMTC_HAL_MCU_STATUS_NOT_INIT The operation failed as the low power mode management is not initialised
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_lpm_get_stats( smtc_hal_mcu_lpm_stats_t* stats );
+
+/**
+ * @brief Reset the power mode statistics
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK Statistics successfully reset
+ * @retval SMTC_HAL_MCU_STATUS_NOT_INIT The operation failed as the low power mode management is not initialised
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_lpm_reset_stats( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SMTC_HAL_MCU_LPM_H
+
+/* --- EOF ------------------------------------------------------------------ */
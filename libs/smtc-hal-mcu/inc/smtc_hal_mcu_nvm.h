@@ -91,7 +91,7 @@ typedef struct smtc_hal_mcu_nvm_cfg_s* smtc_hal_mcu_nvm_cfg_t;
  * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
  * @retval SMTC_HAL_MCU_STATUS_ERROR Another error occurred and the NVM peripheral is not initialised
  */
-smtc_hal_mcu_status_t smtc_hal_mcu_nvm_init( const smtc_hal_mcu_nvm_cfg_s cfg, smtc_hal_mcu_nvm_inst_s* inst );
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_init( const smtc_hal_mcu_nvm_cfg_t cfg, smtc_hal_mcu_nvm_inst_t* inst );
 
 /**
  * @brief Deinitialize the NVM peripheral
@@ -109,7 +109,7 @@ smtc_hal_mcu_status_t smtc_hal_mcu_nvm_deinit( smtc_hal_mcu_nvm_inst_t* inst );
  *
  * @param [in] inst NVM instance
  * @param [in] offset Offset in NVM
- * @param [out] buffer Buffer storing data to be written to the NVM
+ * @param [in] buffer Buffer storing data to be written to the NVM
  * @param [in] length Length of data to be written
  *
  * @retval SMTC_HAL_MCU_STATUS_OK Data succesfully written on the NVM
@@ -117,7 +117,7 @@ smtc_hal_mcu_status_t smtc_hal_mcu_nvm_deinit( smtc_hal_mcu_nvm_inst_t* inst );
  * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
  * @retval SMTC_HAL_MCU_STATUS_ERROR The operation failed because another error occurred
  */
-smtc_hal_mcu_status_t smtc_hal_mcu_nvm_write( smtc_hal_mcu_nvm_inst_s inst, unsigned int offset, const uint8_t* buffer,
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_write( smtc_hal_mcu_nvm_inst_t inst, unsigned int offset, const uint8_t* buffer,
                                               unsigned int length );
 
 /**
@@ -125,7 +125,7 @@ smtc_hal_mcu_status_t smtc_hal_mcu_nvm_write( smtc_hal_mcu_nvm_inst_s inst, unsi
  *
  * @param [in] inst NVM instance
  * @param [in] offset Offset in NVM
- * @param [in] buffer Buffer to store data read from the NVM
+ * @param [out] buffer Buffer to store data read from the NVM
  * @param [in] length Length of data to be read
  *
  * @retval SMTC_HAL_MCU_STATUS_OK Data succesfully read from the NVM
@@ -133,7 +133,7 @@ smtc_hal_mcu_status_t smtc_hal_mcu_nvm_write( smtc_hal_mcu_nvm_inst_s inst, unsi
  * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
  * @retval SMTC_HAL_MCU_STATUS_ERROR The operation failed because another error occurred
  */
-smtc_hal_mcu_status_t smtc_hal_mcu_nvm_read( smtc_hal_mcu_nvm_inst_s inst, unsigned int offset, uint8_t* buffer,
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_read( smtc_hal_mcu_nvm_inst_t inst, unsigned int offset, uint8_t* buffer,
                                              unsigned int length );
 
 /**
@@ -148,7 +148,7 @@ smtc_hal_mcu_status_t smtc_hal_mcu_nvm_read( smtc_hal_mcu_nvm_inst_s inst, unsig
  * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
  * @retval SMTC_HAL_MCU_STATUS_ERROR The operation failed because another error occurred
  */
-smtc_hal_mcu_status_t smtc_hal_mcu_nvm_erase( smtc_hal_mcu_nvm_inst_s inst, unsigned int offset, unsigned int length );
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_erase( smtc_hal_mcu_nvm_inst_t inst, unsigned int offset, unsigned int length );
 
 /**
  * @brief Get the total size of the NVM
@@ -156,12 +156,12 @@ smtc_hal_mcu_status_t smtc_hal_mcu_nvm_erase( smtc_hal_mcu_nvm_inst_s inst, unsi
  * @param [in] inst NVM instance
  * @param [out] size Size read from the NVM instance
  *
- * @retval SMTC_HAL_MCU_STATUS_OK The NVM peripheral successfully produced the random data
+ * @retval SMTC_HAL_MCU_STATUS_OK The total size of the NVM has been successfully retrieved
  * @retval SMTC_HAL_MCU_STATUS_NOT_INIT The operation failed as the NVM peripheral is not initialised
  * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
  * @retval SMTC_HAL_MCU_STATUS_ERROR The operation failed because another error occurred
  */
-smtc_hal_mcu_status_t smtc_hal_mcu_nvm_get_total_size( smtc_hal_mcu_nvm_inst_s inst, unsigned int* size );
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_get_total_size( smtc_hal_mcu_nvm_inst_t inst, unsigned int* size );
 
 #ifdef __cplusplus
 }
@@ -45,6 +45,7 @@ extern "C" {
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "smtc_hal_mcu_status.h"
 
 /*
@@ -84,6 +85,23 @@ typedef struct smtc_hal_mcu_timer_cfg_app_s
     void ( *expiry_func )( void );
 } smtc_hal_mcu_timer_cfg_app_t;
 
+/**
+ * @brief Software timer, multiplexed with all the other software timers over a single hardware timer
+ *
+ * @remark The fields are managed by the implementation and must not be accessed by the application
+ */
+typedef struct smtc_hal_mcu_timer_soft_s
+{
+    struct smtc_hal_mcu_timer_soft_s*  next;
+    struct smtc_hal_mcu_timer_soft_s** pprev;  //!< NULL when the timer is not running
+    uint32_t                           expiry_in_ticks;
+    uint32_t                           period_in_ticks;  //!< 0 for a one-shot timer
+    uint8_t                            level;
+    uint8_t                            slot;
+    void ( *callback )( void* context );
+    void* context;
+} smtc_hal_mcu_timer_soft_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
@@ -171,6 +189,114 @@ smtc_hal_mcu_status_t smtc_hal_mcu_timer_get_remaining_time( smtc_hal_mcu_timer_
  */
 smtc_hal_mcu_status_t smtc_hal_mcu_timer_get_max_value( smtc_hal_mcu_timer_inst_t inst, uint32_t* value_in_ms );
 
+/**
+ * @brief Start the free-running microsecond time base used by the timestamps and the software timers
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK Time base successfully started
+ * @retval SMTC_HAL_MCU_STATUS_ERROR The operation failed because another error occurred
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_timer_timebase_init( void );
+
+/**
+ * @brief Get the current timestamp, in microseconds
+ *
+ * @remark The timestamp wraps around after 2^32 us (about 71 minutes): durations must be computed with an unsigned
+ * subtraction
+ *
+ * @returns Current timestamp, in microseconds
+ */
+uint32_t smtc_hal_mcu_timer_get_time_in_us( void );
+
+/**
+ * @brief Get the time elapsed since a timestamp, in microseconds
+ *
+ * @param [in] timestamp_in_us Timestamp returned by @ref smtc_hal_mcu_timer_get_time_in_us
+ *
+ * @returns Elapsed time, in microseconds
+ */
+uint32_t smtc_hal_mcu_timer_get_elapsed_time_in_us( uint32_t timestamp_in_us );
+
+/**
+ * @brief Initialize a software timer
+ *
+ * @remark The callback is called from the context calling @ref smtc_hal_mcu_timer_soft_process, never from an
+ * interrupt handler
+ *
+ * @param [out] timer Software timer
+ * @param [in] callback Function called when the timer expires
+ * @param [in] context Parameter given to the callback
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK Software timer successfully initialized
+ * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_timer_soft_init( smtc_hal_mcu_timer_soft_t* timer, void ( *callback )( void* context ),
+                                                    void* context );
+
+/**
+ * @brief Start a software timer
+ *
+ * @remark Attempting to start a timer that is already running is allowed. The timer is restarted using the new
+ * parameters.
+ *
+ * @param [in] timer Software timer
+ * @param [in] timeout_in_us Time before the first expiry, in microseconds
+ * @param [in] period_in_us Time between the following expiries, in microseconds - 0 for a one-shot timer
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK Software timer successfully started
+ * @retval SMTC_HAL_MCU_STATUS_NOT_INIT The operation failed as the time base is not initialised
+ * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_timer_soft_start( smtc_hal_mcu_timer_soft_t* timer, uint32_t timeout_in_us,
+                                                     uint32_t period_in_us );
+
+/**
+ * @brief Stop a software timer
+ *
+ * @remark Stopping a timer which is not running is allowed
+ *
+ * @param [in] timer Software timer
+ *
+ * @retval SMTC_HAL_MCU_STATUS_OK Software timer successfully stopped
+ * @retval SMTC_HAL_MCU_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
+ */
+smtc_hal_mcu_status_t smtc_hal_mcu_timer_soft_stop( smtc_hal_mcu_timer_soft_t* timer );
+
+/**
+ * @brief Check whether a software timer is running
+ *
+ * @param [in] timer Software timer
+ *
+ * @retval true The timer is running, or has expired and its callback has not been called yet
+ * @retval false The timer is stopped
+ */
+bool smtc_hal_mcu_timer_soft_is_running( const smtc_hal_mcu_timer_soft_t* timer );
+
+/**
+ * @brief Check whether software timers are waiting for @ref smtc_hal_mcu_timer_soft_process to be called
+ *
+ * @retval true At least one software timer has to be processed
+ * @retval false No software timer has to be processed
+ */
+bool smtc_hal_mcu_timer_soft_is_expiry_pending( void );
+
+/**
+ * @brief Call the callbacks of the expired software timers and re-arm the periodic ones
+ *
+ * @remark The software timers are not protected against concurrent accesses: this function and all the other
+ * smtc_hal_mcu_timer_soft_* functions have to be called from the same context, typically the main loop
+ */
+void smtc_hal_mcu_timer_soft_process( void );
+
+/**
+ * @brief Get the time before the hardware timer has to wake the MCU up to process the software timers
+ *
+ * @param [out] time_in_us Time before the next wake-up, in microseconds - 0 if overdue
+ *
+ * @retval true At least one software timer is running
+ * @retval false No software timer is running
+ */
+bool smtc_hal_mcu_timer_soft_get_time_to_next_wakeup( uint32_t* time_in_us );
+
 #ifdef __cplusplus
 }
 #endif
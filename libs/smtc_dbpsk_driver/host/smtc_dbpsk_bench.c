@@ -0,0 +1,348 @@
+/**
+ * @file      smtc_dbpsk_bench.c
+ *
+ * @brief      Host benchmark of the DBPSK encoders: bit-exactness of the table encoder and encoding time
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "smtc_dbpsk.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Longest frame of the random check and of the timing, in bytes
+ */
+#define BENCH_FRAME_LENGTH_MAX 255
+
+/**
+ * @brief Slack after the buffers: the bitwise encoder reads one byte past the input and the output is checked for
+ * writes past its end
+ */
+#define BENCH_SLACK 4
+
+/**
+ * @brief Value of the output bytes the encoders must not write
+ */
+#define BENCH_CANARY 0xA5
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Benchmark configuration, from the command line
+ */
+typedef struct bench_cfg_s
+{
+    uint32_t nb_trials;  //!< Random frames checked per length
+    uint32_t nb_frames;  //!< Frames encoded per length by the timing
+    uint32_t seed;
+} bench_cfg_t;
+
+/**
+ * @brief Differential encoder
+ */
+typedef void ( *bench_encoder_t )( const uint8_t* data_in, int bpsk_pld_len_in_bits, uint8_t* data_out );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static uint32_t rng_state;
+
+/**
+ * @brief Frame lengths of the timing, in bytes: the shortest and longest Sigfox uplinks, the frame of the sigfox
+ * examples and a full radio buffer
+ */
+static const unsigned int frame_lengths[] = { 12, 15, 26, BENCH_FRAME_LENGTH_MAX };
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static uint32_t bench_rand( void );
+static uint64_t bench_get_time_in_ns( void );
+static bool     bench_compare( const uint8_t* data_in, int nb_bits, bool in_place );
+static bool     bench_run_exhaustive( void );
+static bool     bench_run_random( const bench_cfg_t* cfg );
+static double   bench_time_encoder( bench_encoder_t encoder, unsigned int length, uint32_t nb_frames );
+static void     bench_run_timing( const bench_cfg_t* cfg );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( int argc, char** argv )
+{
+    bench_cfg_t cfg = {
+        .nb_trials = 64,
+        .nb_frames = 1 << 20,
+        .seed      = 0x2545F491,
+    };
+    int opt;
+
+    while( ( opt = getopt( argc, argv, "t:n:s:" ) ) != -1 )
+    {
+        switch( opt )
+        {
+        case 't':
+            cfg.nb_trials = strtoul( optarg, NULL, 0 );
+            break;
+        case 'n':
+            cfg.nb_frames = strtoul( optarg, NULL, 0 );
+            break;
+        case 's':
+            cfg.seed = strtoul( optarg, NULL, 0 );
+            break;
+        default:
+            fprintf( stderr, "usage: %s [-t random frames per length] [-n timed frames per length] [-s seed]\n",
+                     argv[0] );
+            return EXIT_FAILURE;
+        }
+    }
+    rng_state = ( cfg.seed != 0 ) ? cfg.seed : 1;
+
+    if( ( bench_run_exhaustive( ) == false ) || ( bench_run_random( &cfg ) == false ) )
+    {
+        return EXIT_FAILURE;
+    }
+
+    bench_run_timing( &cfg );
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint32_t bench_rand( void )
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+
+    return rng_state;
+}
+
+static uint64_t bench_get_time_in_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ( uint64_t ) ts.tv_sec * 1000000000u + ( uint64_t ) ts.tv_nsec;
+}
+
+/**
+ * @brief Encode a frame with both encoders and compare the outputs
+ *
+ * @param [in] data_in Input frame, followed by BENCH_SLACK readable bytes
+ * @param [in] nb_bits Length of the frame, in bits
+ * @param [in] in_place Run the table encoder with the output buffer on top of the input one
+ *
+ * @returns true if the outputs are equal and the table encoder did not write past smtc_dbpsk_get_pld_len_in_bytes
+ */
+static bool bench_compare( const uint8_t* data_in, int nb_bits, bool in_place )
+{
+    static uint8_t expected[BENCH_FRAME_LENGTH_MAX + BENCH_SLACK];
+    static uint8_t actual[BENCH_FRAME_LENGTH_MAX + BENCH_SLACK];
+    const int      nb_in_bytes  = ( nb_bits + 7 ) >> 3;
+    const int      nb_out_bytes = smtc_dbpsk_get_pld_len_in_bytes( nb_bits );
+
+    memset( actual, BENCH_CANARY, sizeof( actual ) );
+    smtc_dbpsk_encode_buffer_bitwise( data_in, nb_bits, expected );
+
+    if( in_place == true )
+    {
+        memcpy( actual, data_in, nb_in_bytes );
+        smtc_dbpsk_encode_buffer( actual, nb_bits, actual );
+    }
+    else
+    {
+        smtc_dbpsk_encode_buffer( data_in, nb_bits, actual );
+    }
+
+    if( memcmp( expected, actual, nb_out_bytes ) != 0 )
+    {
+        fprintf( stderr, "%s encoding of %d bits differs from the bitwise encoder\n",
+                 ( in_place == true ) ? "in-place" : "table", nb_bits );
+        return false;
+    }
+    for( int i = ( nb_out_bytes > nb_in_bytes ) ? nb_out_bytes : nb_in_bytes; i < ( int ) sizeof( actual ); i++ )
+    {
+        if( actual[i] != BENCH_CANARY )
+        {
+            fprintf( stderr, "encoding of %d bits wrote byte %d\n", nb_bits, i );
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Compare the encoders on every frame of up to 16 bits
+ */
+static bool bench_run_exhaustive( void )
+{
+    uint8_t  data_in[2 + BENCH_SLACK] = { 0 };
+    uint32_t nb_frames                = 0;
+
+    for( int nb_bits = 0; nb_bits <= 16; nb_bits++ )
+    {
+        for( uint32_t pattern = 0; pattern < ( 1u << nb_bits ); pattern++ )
+        {
+            // Left-align the pattern, the unused bits are set to check they are ignored
+            const uint32_t aligned = ( pattern << ( 16 - nb_bits ) ) | ( ( 1u << ( 16 - nb_bits ) ) - 1 );
+
+            data_in[0] = ( uint8_t ) ( aligned >> 8 );
+            data_in[1] = ( uint8_t ) aligned;
+            if( ( bench_compare( data_in, nb_bits, false ) == false ) ||
+                ( bench_compare( data_in, nb_bits, true ) == false ) )
+            {
+                return false;
+            }
+            nb_frames++;
+        }
+    }
+
+    printf( "exhaustive check: %u frames of 0 to 16 bits are bit-exact\n", nb_frames );
+    return true;
+}
+
+/**
+ * @brief Compare the encoders on random frames of every length up to BENCH_FRAME_LENGTH_MAX bytes
+ */
+static bool bench_run_random( const bench_cfg_t* cfg )
+{
+    static uint8_t data_in[BENCH_FRAME_LENGTH_MAX + BENCH_SLACK];
+    uint32_t       nb_frames = 0;
+
+    for( int nb_bits = 0; nb_bits <= BENCH_FRAME_LENGTH_MAX * 8; nb_bits++ )
+    {
+        for( uint32_t trial = 0; trial < cfg->nb_trials; trial++ )
+        {
+            for( unsigned int i = 0; i < sizeof( data_in ); i++ )
+            {
+                data_in[i] = ( uint8_t ) bench_rand( );
+            }
+            if( bench_compare( data_in, nb_bits, ( trial & 1 ) != 0 ) == false )
+            {
+                return false;
+            }
+            nb_frames++;
+        }
+    }
+
+    printf( "random check: %u frames of 0 to %d bits are bit-exact\n\n", nb_frames, BENCH_FRAME_LENGTH_MAX * 8 );
+    return true;
+}
+
+/**
+ * @brief Time an encoder
+ *
+ * @returns Average encoding time of a frame, in nanoseconds
+ */
+static double bench_time_encoder( bench_encoder_t encoder, unsigned int length, uint32_t nb_frames )
+{
+    static uint8_t data_in[BENCH_FRAME_LENGTH_MAX + BENCH_SLACK];
+    static uint8_t data_out[BENCH_FRAME_LENGTH_MAX + BENCH_SLACK];
+    uint32_t       checksum = 0;
+
+    for( unsigned int i = 0; i < sizeof( data_in ); i++ )
+    {
+        data_in[i] = ( uint8_t ) bench_rand( );
+    }
+
+    const uint64_t start_in_ns = bench_get_time_in_ns( );
+    for( uint32_t n = 0; n < nb_frames; n++ )
+    {
+        // Change the input so the calls cannot be merged
+        data_in[0] = ( uint8_t ) n;
+        encoder( data_in, length << 3, data_out );
+        checksum += data_out[length];
+    }
+    const uint64_t elapsed_in_ns = bench_get_time_in_ns( ) - start_in_ns;
+
+    // Keep the output alive
+    if( checksum == 0x5A5A5A5A )
+    {
+        printf( " " );
+    }
+
+    return ( double ) elapsed_in_ns / nb_frames;
+}
+
+static void bench_run_timing( const bench_cfg_t* cfg )
+{
+    if( cfg->nb_frames == 0 )
+    {
+        return;
+    }
+
+    printf( "frame  bitwise ns/frame  table ns/frame  table MB/s  speedup\n" );
+
+    for( unsigned int i = 0; i < sizeof( frame_lengths ) / sizeof( frame_lengths[0] ); i++ )
+    {
+        const unsigned int length     = frame_lengths[i];
+        const double       bitwise_ns = bench_time_encoder( smtc_dbpsk_encode_buffer_bitwise, length, cfg->nb_frames );
+        const double       table_ns   = bench_time_encoder( smtc_dbpsk_encode_buffer, length, cfg->nb_frames );
+
+        printf( "%5u  %16.1f  %14.1f  %10.1f  %6.1fx\n", length, bitwise_ns, table_ns, ( length * 1000.0 ) / table_ns,
+                bitwise_ns / table_ns );
+    }
+}
+
+/* --- EOF ------------------------------------------------------------------ */
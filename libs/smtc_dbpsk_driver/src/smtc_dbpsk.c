@@ -43,15 +43,100 @@
 
 #include "smtc_dbpsk.h"
 
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*!
+ * \brief Differential encoding of every input byte, carrying the encoder state from one byte to the next
+ *
+ * The low byte of an entry is the encoded byte when the byte starts in state 0. Starting in state 1 gives its
+ * complement. The high byte is 0xFF if the byte toggles the state, 0x00 otherwise. With the state kept as a 0x00 / 0xFF
+ * mask, a byte is encoded with one lookup and two XORs.
+ */
+static const uint16_t smtc_dbpsk_lut[256] = {
+    0x0055, 0xFF55, 0xFF54, 0x0054, 0xFF56, 0x0056, 0x0057, 0xFF57,
+    0xFF52, 0x0052, 0x0053, 0xFF53, 0x0051, 0xFF51, 0xFF50, 0x0050,
+    0xFF5A, 0x005A, 0x005B, 0xFF5B, 0x0059, 0xFF59, 0xFF58, 0x0058,
+    0x005D, 0xFF5D, 0xFF5C, 0x005C, 0xFF5E, 0x005E, 0x005F, 0xFF5F,
+    0xFF4A, 0x004A, 0x004B, 0xFF4B, 0x0049, 0xFF49, 0xFF48, 0x0048,
+    0x004D, 0xFF4D, 0xFF4C, 0x004C, 0xFF4E, 0x004E, 0x004F, 0xFF4F,
+    0x0045, 0xFF45, 0xFF44, 0x0044, 0xFF46, 0x0046, 0x0047, 0xFF47,
+    0xFF42, 0x0042, 0x0043, 0xFF43, 0x0041, 0xFF41, 0xFF40, 0x0040,
+    0xFF6A, 0x006A, 0x006B, 0xFF6B, 0x0069, 0xFF69, 0xFF68, 0x0068,
+    0x006D, 0xFF6D, 0xFF6C, 0x006C, 0xFF6E, 0x006E, 0x006F, 0xFF6F,
+    0x0065, 0xFF65, 0xFF64, 0x0064, 0xFF66, 0x0066, 0x0067, 0xFF67,
+    0xFF62, 0x0062, 0x0063, 0xFF63, 0x0061, 0xFF61, 0xFF60, 0x0060,
+    0x0075, 0xFF75, 0xFF74, 0x0074, 0xFF76, 0x0076, 0x0077, 0xFF77,
+    0xFF72, 0x0072, 0x0073, 0xFF73, 0x0071, 0xFF71, 0xFF70, 0x0070,
+    0xFF7A, 0x007A, 0x007B, 0xFF7B, 0x0079, 0xFF79, 0xFF78, 0x0078,
+    0x007D, 0xFF7D, 0xFF7C, 0x007C, 0xFF7E, 0x007E, 0x007F, 0xFF7F,
+    0xFF2A, 0x002A, 0x002B, 0xFF2B, 0x0029, 0xFF29, 0xFF28, 0x0028,
+    0x002D, 0xFF2D, 0xFF2C, 0x002C, 0xFF2E, 0x002E, 0x002F, 0xFF2F,
+    0x0025, 0xFF25, 0xFF24, 0x0024, 0xFF26, 0x0026, 0x0027, 0xFF27,
+    0xFF22, 0x0022, 0x0023, 0xFF23, 0x0021, 0xFF21, 0xFF20, 0x0020,
+    0x0035, 0xFF35, 0xFF34, 0x0034, 0xFF36, 0x0036, 0x0037, 0xFF37,
+    0xFF32, 0x0032, 0x0033, 0xFF33, 0x0031, 0xFF31, 0xFF30, 0x0030,
+    0xFF3A, 0x003A, 0x003B, 0xFF3B, 0x0039, 0xFF39, 0xFF38, 0x0038,
+    0x003D, 0xFF3D, 0xFF3C, 0x003C, 0xFF3E, 0x003E, 0x003F, 0xFF3F,
+    0x0015, 0xFF15, 0xFF14, 0x0014, 0xFF16, 0x0016, 0x0017, 0xFF17,
+    0xFF12, 0x0012, 0x0013, 0xFF13, 0x0011, 0xFF11, 0xFF10, 0x0010,
+    0xFF1A, 0x001A, 0x001B, 0xFF1B, 0x0019, 0xFF19, 0xFF18, 0x0018,
+    0x001D, 0xFF1D, 0xFF1C, 0x001C, 0xFF1E, 0x001E, 0x001F, 0xFF1F,
+    0xFF0A, 0x000A, 0x000B, 0xFF0B, 0x0009, 0xFF09, 0xFF08, 0x0008,
+    0x000D, 0xFF0D, 0xFF0C, 0x000C, 0xFF0E, 0x000E, 0x000F, 0xFF0F,
+    0x0005, 0xFF05, 0xFF04, 0x0004, 0xFF06, 0x0006, 0x0007, 0xFF07,
+    0xFF02, 0x0002, 0x0003, 0xFF03, 0x0001, 0xFF01, 0xFF00, 0x0000,
+};
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTION DEFINITIONS ---------------------------------------------
  */
 
 void smtc_dbpsk_encode_buffer( const uint8_t* data_in, int bpsk_pld_len_in_bits, uint8_t* data_out )
+{
+    const int data_in_bytecount = bpsk_pld_len_in_bits >> 3;
+    const int remaining_bits    = bpsk_pld_len_in_bits & 7;
+    uint8_t   state_mask        = 0x00;
+
+    // Process full bytes
+    for( int i = 0; i < data_in_bytecount; i++ )
+    {
+        const uint16_t entry = smtc_dbpsk_lut[data_in[i]];
+
+        data_out[i] = ( uint8_t ) entry ^ state_mask;
+        state_mask ^= ( uint8_t ) ( entry >> 8 );
+    }
+
+    // The first remaining_bits + 1 bits of the encoded last byte only depend on its remaining_bits first input bits.
+    // With no bit left, the state mask gives the last data bit
+    uint8_t out_byte = state_mask;
+    if( remaining_bits != 0 )
+    {
+        out_byte = ( uint8_t ) smtc_dbpsk_lut[data_in[data_in_bytecount]] ^ state_mask;
+    }
+
+    // Keep the remaining bits and the last data bit, then add the duplicate bit and store
+    const uint8_t last_bit = ( out_byte >> ( 7 - remaining_bits ) ) & 0x01;
+
+    if( remaining_bits == 7 )
+    {
+        data_out[data_in_bytecount]     = out_byte;
+        data_out[data_in_bytecount + 1] = ( uint8_t ) ( last_bit << 7 );
+    }
+    else
+    {
+        data_out[data_in_bytecount] = ( uint8_t ) ( ( out_byte & ( 0xFF << ( 7 - remaining_bits ) ) ) |
+                                                    ( last_bit << ( 6 - remaining_bits ) ) );
+    }
+}
+
+void smtc_dbpsk_encode_buffer_bitwise( const uint8_t* data_in, int bpsk_pld_len_in_bits, uint8_t* data_out )
 {
     uint8_t in_byte;
-    uint8_t out_byte;
+    uint8_t out_byte = 0;
 
     int data_in_bytecount = bpsk_pld_len_in_bits >> 3;
     in_byte               = *data_in++;
@@ -62,9 +62,23 @@ extern "C" {
  * \param [in]  bpsk_pld_len_in_bits Length of the input BPSK frame, in bits
  * \param [out] data_out             Buffer for output data (can optionally be the same as data_in, but must have space
  * for bpsk_pld_len_in_bits + 2 bits)
+ *
+ * \remark Encodes a byte per table lookup. Only the ( bpsk_pld_len_in_bits + 7 ) / 8 first bytes of data_in are read
  */
 void smtc_dbpsk_encode_buffer( const uint8_t* data_in, int bpsk_pld_len_in_bits, uint8_t* data_out );
 
+/*!
+ * \brief Perform differential encoding for DBPSK modulation, one bit at a time.
+ *
+ * Reference implementation, the output is the same as the one of smtc_dbpsk_encode_buffer.
+ *
+ * \param [in]  data_in              Buffer with input data - one byte is read past the last input bit
+ * \param [in]  bpsk_pld_len_in_bits Length of the input BPSK frame, in bits
+ * \param [out] data_out             Buffer for output data (can optionally be the same as data_in, but must have space
+ * for bpsk_pld_len_in_bits + 2 bits)
+ */
+void smtc_dbpsk_encode_buffer_bitwise( const uint8_t* data_in, int bpsk_pld_len_in_bits, uint8_t* data_out );
+
 /*!
  * \brief Given the length of a BPSK frame, in bits, calculate the space necessary to hold the frame after differential
  * encoding, in bits.
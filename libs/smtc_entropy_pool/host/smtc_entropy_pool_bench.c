@@ -0,0 +1,288 @@
+/**
+ * @file      smtc_entropy_pool_bench.c
+ *
+ * @brief      Host benchmark of the entropy pool: bytes per second served for various request sizes
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "smtc_entropy_pool.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Largest request size of the benchmark
+ */
+#define BENCH_REQUEST_LENGTH_MAX 4096
+
+/**
+ * @brief Number of outcomes of the get_range uniformity check
+ */
+#define BENCH_RANGE 10
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static smtc_entropy_pool_t pool;
+
+/**
+ * @brief Request sizes of the throughput benchmark
+ */
+static const unsigned int request_lengths[] = { 1, 4, 16, 64, 256, BENCH_REQUEST_LENGTH_MAX };
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static uint64_t bench_get_time_in_ns( void );
+static void     bench_init_pool( void );
+static void     bench_dump( void );
+static void     bench_run_throughput( uint32_t nb_bytes );
+static void     bench_run_range( uint32_t nb_draws );
+static void     bench_run_byte_distribution( uint32_t nb_bytes );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( int argc, char** argv )
+{
+    uint32_t nb_bytes = 16 << 20;
+    bool     dump     = false;
+    int      opt;
+
+    while( ( opt = getopt( argc, argv, "n:x" ) ) != -1 )
+    {
+        switch( opt )
+        {
+        case 'n':
+            nb_bytes = strtoul( optarg, NULL, 0 );
+            break;
+        case 'x':
+            dump = true;
+            break;
+        default:
+            fprintf( stderr, "usage: %s [-n bytes per request size] [-x]\n", argv[0] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    if( smtc_entropy_pool_self_test( ) == false )
+    {
+        fprintf( stderr, "AES-128 known-answer test failed\n" );
+        return EXIT_FAILURE;
+    }
+
+    if( dump == true )
+    {
+        bench_dump( );
+        return EXIT_SUCCESS;
+    }
+
+    printf( "AES-128 known-answer test passed, cache of %u bytes\n\n", SMTC_ENTROPY_POOL_CACHE_SIZE );
+
+    bench_run_throughput( nb_bytes );
+    bench_run_range( nb_bytes / 4 );
+    bench_run_byte_distribution( nb_bytes );
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint64_t bench_get_time_in_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ( uint64_t ) ts.tv_sec * 1000000000u + ( uint64_t ) ts.tv_nsec;
+}
+
+static void bench_init_pool( void )
+{
+    uint8_t seed[SMTC_ENTROPY_POOL_SEED_LENGTH];
+
+    for( int i = 0; i < SMTC_ENTROPY_POOL_SEED_LENGTH; i++ )
+    {
+        seed[i] = ( uint8_t ) i;
+    }
+
+    smtc_entropy_pool_init( &pool, seed, NULL, 0 );
+}
+
+/**
+ * @brief Print the output for a fixed seed and after a fixed reseed, to compare with a reference CTR-DRBG
+ */
+static void bench_dump( void )
+{
+    uint8_t buffer[SMTC_ENTROPY_POOL_CACHE_SIZE];
+    uint8_t entropy[SMTC_ENTROPY_POOL_SEED_LENGTH];
+
+    bench_init_pool( );
+    smtc_entropy_pool_get_bytes( &pool, buffer, sizeof( buffer ) );
+    for( unsigned int i = 0; i < sizeof( buffer ); i++ )
+    {
+        printf( "%02x", buffer[i] );
+    }
+    printf( "\n" );
+
+    for( int i = 0; i < SMTC_ENTROPY_POOL_SEED_LENGTH; i++ )
+    {
+        entropy[i] = ( uint8_t ) ( 0x20 + i );
+    }
+    smtc_entropy_pool_add_entropy( &pool, SMTC_ENTROPY_POOL_SOURCE_RADIO, entropy, sizeof( entropy ) );
+    smtc_entropy_pool_get_bytes( &pool, buffer, sizeof( buffer ) );
+    for( unsigned int i = 0; i < sizeof( buffer ); i++ )
+    {
+        printf( "%02x", buffer[i] );
+    }
+    printf( "\n" );
+}
+
+static void bench_run_throughput( uint32_t nb_bytes )
+{
+    static uint8_t buffer[BENCH_REQUEST_LENGTH_MAX];
+
+    printf( "request  requests       ns/request  MB/s\n" );
+
+    for( unsigned int i = 0; i < sizeof( request_lengths ) / sizeof( request_lengths[0] ); i++ )
+    {
+        const unsigned int length      = request_lengths[i];
+        const uint32_t     nb_requests = ( nb_bytes + length - 1 ) / length;
+
+        bench_init_pool( );
+
+        const uint64_t start_in_ns = bench_get_time_in_ns( );
+        for( uint32_t n = 0; n < nb_requests; n++ )
+        {
+            smtc_entropy_pool_get_bytes( &pool, buffer, length );
+        }
+        const uint64_t elapsed_in_ns = bench_get_time_in_ns( ) - start_in_ns;
+
+        printf( "%7u  %-13u  %10.1f  %6.1f\n", length, nb_requests, ( double ) elapsed_in_ns / nb_requests,
+                ( ( double ) nb_requests * length * 1000.0 ) / ( double ) elapsed_in_ns );
+    }
+
+    smtc_entropy_pool_stats_t stats;
+    smtc_entropy_pool_get_stats( &pool, &stats );
+    printf( "\nlast run: %u refills for %u bytes served, reseed due: %s\n\n", stats.nb_refills, stats.nb_bytes_served,
+            smtc_entropy_pool_is_reseed_due( &pool ) ? "yes" : "no" );
+}
+
+static void bench_run_range( uint32_t nb_draws )
+{
+    uint32_t counts[BENCH_RANGE] = { 0 };
+    double   chi2                = 0.0;
+
+    if( nb_draws == 0 )
+    {
+        return;
+    }
+
+    bench_init_pool( );
+
+    const uint64_t start_in_ns = bench_get_time_in_ns( );
+    for( uint32_t n = 0; n < nb_draws; n++ )
+    {
+        counts[smtc_entropy_pool_get_range( &pool, BENCH_RANGE )]++;
+    }
+    const uint64_t elapsed_in_ns = bench_get_time_in_ns( ) - start_in_ns;
+
+    for( int i = 0; i < BENCH_RANGE; i++ )
+    {
+        const double expected = ( double ) nb_draws / BENCH_RANGE;
+        chi2 += ( counts[i] - expected ) * ( counts[i] - expected ) / expected;
+    }
+
+    printf( "get_range(%d): %.1f ns/draw, chi-square %.1f for %d degrees of freedom\n", BENCH_RANGE,
+            ( double ) elapsed_in_ns / nb_draws, chi2, BENCH_RANGE - 1 );
+}
+
+static void bench_run_byte_distribution( uint32_t nb_bytes )
+{
+    static uint8_t buffer[BENCH_REQUEST_LENGTH_MAX];
+    uint32_t       counts[256] = { 0 };
+    uint32_t       nb_done     = 0;
+    double         chi2        = 0.0;
+
+    bench_init_pool( );
+
+    while( nb_done < nb_bytes )
+    {
+        smtc_entropy_pool_get_bytes( &pool, buffer, sizeof( buffer ) );
+        for( unsigned int i = 0; i < sizeof( buffer ); i++ )
+        {
+            counts[buffer[i]]++;
+        }
+        nb_done += sizeof( buffer );
+    }
+
+    for( int i = 0; i < 256; i++ )
+    {
+        const double expected = ( double ) nb_done / 256;
+        chi2 += ( counts[i] - expected ) * ( counts[i] - expected ) / expected;
+    }
+
+    printf( "byte distribution over %u bytes: chi-square %.1f for 255 degrees of freedom\n", nb_done, chi2 );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,525 @@
+/**
+ * @file      smtc_entropy_pool.c
+ *
+ * @brief      Entropy pool: raw entropy sources mixed into an AES-128 CTR-DRBG
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "smtc_entropy_pool.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/**
+ * @brief Load a big-endian 32-bit word
+ */
+#define SMTC_ENTROPY_POOL_LOAD_BE32( buffer )                                            \
+    ( ( ( uint32_t ) ( buffer )[0] << 24 ) | ( ( uint32_t ) ( buffer )[1] << 16 ) | \
+      ( ( uint32_t ) ( buffer )[2] << 8 ) | ( ( uint32_t ) ( buffer )[3] ) )
+
+/**
+ * @brief Rotate a 32-bit word right - a single instruction on Cortex-M
+ */
+#define SMTC_ENTROPY_POOL_ROTR( x, n ) ( ( ( x ) >> ( n ) ) | ( ( x ) << ( 32 - ( n ) ) ) )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief AES block length, in bytes
+ */
+#define SMTC_ENTROPY_POOL_BLOCK_LENGTH 16
+
+/**
+ * @brief Number of AES-128 rounds
+ */
+#define SMTC_ENTROPY_POOL_AES_NB_ROUNDS 10
+
+#if( SMTC_ENTROPY_POOL_CACHE_SIZE % SMTC_ENTROPY_POOL_BLOCK_LENGTH ) != 0
+#error "SMTC_ENTROPY_POOL_CACHE_SIZE has to be a multiple of the AES block length"
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/**
+ * @brief AES S-box
+ */
+static const uint8_t smtc_entropy_pool_aes_sbox[256] = {
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+    0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+    0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+    0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+    0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+    0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+    0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+    0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+    0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+    0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+    0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16,
+};
+
+/**
+ * @brief AES round table: SubBytes and MixColumns of one byte, the other three columns are byte rotations of it
+ *
+ * @remark One 1 kB table rather than four keeps the flash footprint small for a few cycles per round
+ */
+
+static const uint32_t smtc_entropy_pool_aes_te[256] = {
+    0xC66363A5, 0xF87C7C84, 0xEE777799, 0xF67B7B8D, 0xFFF2F20D, 0xD66B6BBD, 0xDE6F6FB1, 0x91C5C554,
+    0x60303050, 0x02010103, 0xCE6767A9, 0x562B2B7D, 0xE7FEFE19, 0xB5D7D762, 0x4DABABE6, 0xEC76769A,
+    0x8FCACA45, 0x1F82829D, 0x89C9C940, 0xFA7D7D87, 0xEFFAFA15, 0xB25959EB, 0x8E4747C9, 0xFBF0F00B,
+    0x41ADADEC, 0xB3D4D467, 0x5FA2A2FD, 0x45AFAFEA, 0x239C9CBF, 0x53A4A4F7, 0xE4727296, 0x9BC0C05B,
+    0x75B7B7C2, 0xE1FDFD1C, 0x3D9393AE, 0x4C26266A, 0x6C36365A, 0x7E3F3F41, 0xF5F7F702, 0x83CCCC4F,
+    0x6834345C, 0x51A5A5F4, 0xD1E5E534, 0xF9F1F108, 0xE2717193, 0xABD8D873, 0x62313153, 0x2A15153F,
+    0x0804040C, 0x95C7C752, 0x46232365, 0x9DC3C35E, 0x30181828, 0x379696A1, 0x0A05050F, 0x2F9A9AB5,
+    0x0E070709, 0x24121236, 0x1B80809B, 0xDFE2E23D, 0xCDEBEB26, 0x4E272769, 0x7FB2B2CD, 0xEA75759F,
+    0x1209091B, 0x1D83839E, 0x582C2C74, 0x341A1A2E, 0x361B1B2D, 0xDC6E6EB2, 0xB45A5AEE, 0x5BA0A0FB,
+    0xA45252F6, 0x763B3B4D, 0xB7D6D661, 0x7DB3B3CE, 0x5229297B, 0xDDE3E33E, 0x5E2F2F71, 0x13848497,
+    0xA65353F5, 0xB9D1D168, 0x00000000, 0xC1EDED2C, 0x40202060, 0xE3FCFC1F, 0x79B1B1C8, 0xB65B5BED,
+    0xD46A6ABE, 0x8DCBCB46, 0x67BEBED9, 0x7239394B, 0x944A4ADE, 0x984C4CD4, 0xB05858E8, 0x85CFCF4A,
+    0xBBD0D06B, 0xC5EFEF2A, 0x4FAAAAE5, 0xEDFBFB16, 0x864343C5, 0x9A4D4DD7, 0x66333355, 0x11858594,
+    0x8A4545CF, 0xE9F9F910, 0x04020206, 0xFE7F7F81, 0xA05050F0, 0x783C3C44, 0x259F9FBA, 0x4BA8A8E3,
+    0xA25151F3, 0x5DA3A3FE, 0x804040C0, 0x058F8F8A, 0x3F9292AD, 0x219D9DBC, 0x70383848, 0xF1F5F504,
+    0x63BCBCDF, 0x77B6B6C1, 0xAFDADA75, 0x42212163, 0x20101030, 0xE5FFFF1A, 0xFDF3F30E, 0xBFD2D26D,
+    0x81CDCD4C, 0x180C0C14, 0x26131335, 0xC3ECEC2F, 0xBE5F5FE1, 0x359797A2, 0x884444CC, 0x2E171739,
+    0x93C4C457, 0x55A7A7F2, 0xFC7E7E82, 0x7A3D3D47, 0xC86464AC, 0xBA5D5DE7, 0x3219192B, 0xE6737395,
+    0xC06060A0, 0x19818198, 0x9E4F4FD1, 0xA3DCDC7F, 0x44222266, 0x542A2A7E, 0x3B9090AB, 0x0B888883,
+    0x8C4646CA, 0xC7EEEE29, 0x6BB8B8D3, 0x2814143C, 0xA7DEDE79, 0xBC5E5EE2, 0x160B0B1D, 0xADDBDB76,
+    0xDBE0E03B, 0x64323256, 0x743A3A4E, 0x140A0A1E, 0x924949DB, 0x0C06060A, 0x4824246C, 0xB85C5CE4,
+    0x9FC2C25D, 0xBDD3D36E, 0x43ACACEF, 0xC46262A6, 0x399191A8, 0x319595A4, 0xD3E4E437, 0xF279798B,
+    0xD5E7E732, 0x8BC8C843, 0x6E373759, 0xDA6D6DB7, 0x018D8D8C, 0xB1D5D564, 0x9C4E4ED2, 0x49A9A9E0,
+    0xD86C6CB4, 0xAC5656FA, 0xF3F4F407, 0xCFEAEA25, 0xCA6565AF, 0xF47A7A8E, 0x47AEAEE9, 0x10080818,
+    0x6FBABAD5, 0xF0787888, 0x4A25256F, 0x5C2E2E72, 0x381C1C24, 0x57A6A6F1, 0x73B4B4C7, 0x97C6C651,
+    0xCBE8E823, 0xA1DDDD7C, 0xE874749C, 0x3E1F1F21, 0x964B4BDD, 0x61BDBDDC, 0x0D8B8B86, 0x0F8A8A85,
+    0xE0707090, 0x7C3E3E42, 0x71B5B5C4, 0xCC6666AA, 0x904848D8, 0x06030305, 0xF7F6F601, 0x1C0E0E12,
+    0xC26161A3, 0x6A35355F, 0xAE5757F9, 0x69B9B9D0, 0x17868691, 0x99C1C158, 0x3A1D1D27, 0x279E9EB9,
+    0xD9E1E138, 0xEBF8F813, 0x2B9898B3, 0x22111133, 0xD26969BB, 0xA9D9D970, 0x078E8E89, 0x339494A7,
+    0x2D9B9BB6, 0x3C1E1E22, 0x15878792, 0xC9E9E920, 0x87CECE49, 0xAA5555FF, 0x50282878, 0xA5DFDF7A,
+    0x038C8C8F, 0x59A1A1F8, 0x09898980, 0x1A0D0D17, 0x65BFBFDA, 0xD7E6E631, 0x844242C6, 0xD06868B8,
+    0x824141C3, 0x299999B0, 0x5A2D2D77, 0x1E0F0F11, 0x7BB0B0CB, 0xA85454FC, 0x6DBBBBD6, 0x2C16163A,
+};
+
+/**
+ * @brief AES key expansion round constants
+ */
+static const uint8_t smtc_entropy_pool_aes_rcon[SMTC_ENTROPY_POOL_AES_NB_ROUNDS] = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36,
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Expand an AES-128 key
+ *
+ * @param [in] key 16-byte key
+ * @param [out] round_keys 44-word key schedule
+ */
+static void smtc_entropy_pool_aes_set_key( const uint8_t* key, uint32_t* round_keys );
+
+/**
+ * @brief Encrypt one block with AES-128
+ *
+ * @param [in] round_keys Key schedule
+ * @param [in] input 16-byte plaintext
+ * @param [out] output 16-byte ciphertext - can be the same buffer as input
+ */
+static void smtc_entropy_pool_aes_encrypt( const uint32_t* round_keys, const uint8_t* input, uint8_t* output );
+
+/**
+ * @brief Increment the DRBG counter block, as a 128-bit big-endian integer
+ *
+ * @param [in, out] v Counter block
+ */
+static void smtc_entropy_pool_increment_v( uint8_t* v );
+
+/**
+ * @brief CTR_DRBG_Update of NIST SP 800-90A: derive a new key and counter block from the current ones and the data
+ *
+ * @param [in, out] pool Entropy pool
+ * @param [in] provided_data SMTC_ENTROPY_POOL_SEED_LENGTH bytes XORed into the new state - NULL for all zeros
+ */
+static void smtc_entropy_pool_update( smtc_entropy_pool_t* pool, const uint8_t* provided_data );
+
+/**
+ * @brief Reseed the DRBG with the entropy collected so far
+ *
+ * @param [in, out] pool Entropy pool
+ */
+static void smtc_entropy_pool_reseed( smtc_entropy_pool_t* pool );
+
+/**
+ * @brief Fill the output cache with a CTR_DRBG_Generate call
+ *
+ * @param [in, out] pool Entropy pool
+ */
+static void smtc_entropy_pool_refill( smtc_entropy_pool_t* pool );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+smtc_entropy_pool_status_t smtc_entropy_pool_init( smtc_entropy_pool_t* pool, const uint8_t* seed,
+                                                   const uint8_t* personalization,
+                                                   unsigned int   personalization_length )
+{
+    static const uint8_t zero_key[SMTC_ENTROPY_POOL_BLOCK_LENGTH] = { 0 };
+    uint8_t              seed_material[SMTC_ENTROPY_POOL_SEED_LENGTH];
+
+    if( ( pool == NULL ) || ( seed == NULL ) || ( personalization_length > SMTC_ENTROPY_POOL_SEED_LENGTH ) ||
+        ( ( personalization == NULL ) && ( personalization_length > 0 ) ) )
+    {
+        return SMTC_ENTROPY_POOL_STATUS_BAD_PARAMETERS;
+    }
+
+    memset( pool, 0, sizeof( *pool ) );
+
+    // CTR_DRBG_Instantiate without derivation function: the seed material is the entropy input XOR the
+    // personalization string, and the update starts from an all-zero key and counter block
+    memcpy( seed_material, seed, SMTC_ENTROPY_POOL_SEED_LENGTH );
+    for( unsigned int i = 0; i < personalization_length; i++ )
+    {
+        seed_material[i] ^= personalization[i];
+    }
+
+    smtc_entropy_pool_aes_set_key( zero_key, pool->round_keys );
+    smtc_entropy_pool_update( pool, seed_material );
+    memset( seed_material, 0, sizeof( seed_material ) );
+
+    pool->reseed_counter = 1;
+    pool->cache_index    = SMTC_ENTROPY_POOL_CACHE_SIZE;
+    pool->is_init        = true;
+
+    return SMTC_ENTROPY_POOL_STATUS_OK;
+}
+
+smtc_entropy_pool_status_t smtc_entropy_pool_add_entropy( smtc_entropy_pool_t* pool, smtc_entropy_pool_source_t source,
+                                                          const uint8_t* data, unsigned int length )
+{
+    if( ( pool == NULL ) || ( ( data == NULL ) && ( length > 0 ) ) || ( source >= SMTC_ENTROPY_POOL_SOURCE_COUNT ) )
+    {
+        return SMTC_ENTROPY_POOL_STATUS_BAD_PARAMETERS;
+    }
+
+    if( pool->is_init == false )
+    {
+        return SMTC_ENTROPY_POOL_STATUS_NOT_INIT;
+    }
+
+    for( unsigned int i = 0; i < length; i++ )
+    {
+        pool->pending[pool->pending_length++] ^= data[i];
+
+        if( pool->pending_length == SMTC_ENTROPY_POOL_SEED_LENGTH )
+        {
+            smtc_entropy_pool_reseed( pool );
+        }
+    }
+
+    pool->stats.nb_bytes_harvested[source] += length;
+
+    return SMTC_ENTROPY_POOL_STATUS_OK;
+}
+
+bool smtc_entropy_pool_is_reseed_due( const smtc_entropy_pool_t* pool )
+{
+    return ( pool->is_init == true ) && ( pool->reseed_counter > SMTC_ENTROPY_POOL_RESEED_INTERVAL );
+}
+
+smtc_entropy_pool_status_t smtc_entropy_pool_get_bytes( smtc_entropy_pool_t* pool, uint8_t* buffer,
+                                                        unsigned int length )
+{
+    if( ( pool == NULL ) || ( ( buffer == NULL ) && ( length > 0 ) ) )
+    {
+        return SMTC_ENTROPY_POOL_STATUS_BAD_PARAMETERS;
+    }
+
+    if( pool->is_init == false )
+    {
+        return SMTC_ENTROPY_POOL_STATUS_NOT_INIT;
+    }
+
+    pool->stats.nb_requests++;
+    pool->stats.nb_bytes_served += length;
+
+    while( length > 0 )
+    {
+        if( pool->cache_index == SMTC_ENTROPY_POOL_CACHE_SIZE )
+        {
+            smtc_entropy_pool_refill( pool );
+        }
+
+        unsigned int chunk = SMTC_ENTROPY_POOL_CACHE_SIZE - pool->cache_index;
+        if( chunk > length )
+        {
+            chunk = length;
+        }
+
+        // Served bytes are wiped from the cache so that they cannot be recovered from RAM afterwards
+        memcpy( buffer, &pool->cache[pool->cache_index], chunk );
+        memset( &pool->cache[pool->cache_index], 0, chunk );
+
+        pool->cache_index += chunk;
+        buffer += chunk;
+        length -= chunk;
+    }
+
+    return SMTC_ENTROPY_POOL_STATUS_OK;
+}
+
+uint32_t smtc_entropy_pool_get_range( smtc_entropy_pool_t* pool, uint32_t range )
+{
+    uint32_t random;
+
+    if( smtc_entropy_pool_get_bytes( pool, ( uint8_t* ) &random, sizeof( random ) ) != SMTC_ENTROPY_POOL_STATUS_OK )
+    {
+        return 0;
+    }
+
+    if( range == 0 )
+    {
+        return random;
+    }
+
+    // Multiply-and-shift instead of a modulo, with the rejection of the few low products that would bias the result
+    // (Lemire, "Fast random integer generation in an interval"): no division unless a rejection is possible
+    uint64_t product = ( uint64_t ) random * range;
+    uint32_t low     = ( uint32_t ) product;
+
+    if( low < range )
+    {
+        const uint32_t threshold = -range % range;
+
+        while( low < threshold )
+        {
+            smtc_entropy_pool_get_bytes( pool, ( uint8_t* ) &random, sizeof( random ) );
+            product = ( uint64_t ) random * range;
+            low     = ( uint32_t ) product;
+        }
+    }
+
+    return ( uint32_t ) ( product >> 32 );
+}
+
+void smtc_entropy_pool_get_stats( const smtc_entropy_pool_t* pool, smtc_entropy_pool_stats_t* stats )
+{
+    *stats = pool->stats;
+}
+
+bool smtc_entropy_pool_self_test( void )
+{
+    // FIPS-197 appendix C.1
+    static const uint8_t key[SMTC_ENTROPY_POOL_BLOCK_LENGTH] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    };
+    static const uint8_t plaintext[SMTC_ENTROPY_POOL_BLOCK_LENGTH] = {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF,
+    };
+    static const uint8_t expected[SMTC_ENTROPY_POOL_BLOCK_LENGTH] = {
+        0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30, 0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A,
+    };
+    uint32_t round_keys[44];
+    uint8_t  ciphertext[SMTC_ENTROPY_POOL_BLOCK_LENGTH];
+
+    smtc_entropy_pool_aes_set_key( key, round_keys );
+    smtc_entropy_pool_aes_encrypt( round_keys, plaintext, ciphertext );
+
+    return memcmp( ciphertext, expected, sizeof( expected ) ) == 0;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void smtc_entropy_pool_aes_set_key( const uint8_t* key, uint32_t* round_keys )
+{
+    for( int i = 0; i < 4; i++ )
+    {
+        round_keys[i] = SMTC_ENTROPY_POOL_LOAD_BE32( &key[4 * i] );
+    }
+
+    for( int i = 4; i < 44; i++ )
+    {
+        uint32_t temp = round_keys[i - 1];
+
+        if( ( i % 4 ) == 0 )
+        {
+            // RotWord then SubWord
+            temp = ( ( uint32_t ) smtc_entropy_pool_aes_sbox[( temp >> 16 ) & 0xFF] << 24 ) |
+                   ( ( uint32_t ) smtc_entropy_pool_aes_sbox[( temp >> 8 ) & 0xFF] << 16 ) |
+                   ( ( uint32_t ) smtc_entropy_pool_aes_sbox[temp & 0xFF] << 8 ) |
+                   ( ( uint32_t ) smtc_entropy_pool_aes_sbox[temp >> 24] );
+            temp ^= ( uint32_t ) smtc_entropy_pool_aes_rcon[( i / 4 ) - 1] << 24;
+        }
+
+        round_keys[i] = round_keys[i - 4] ^ temp;
+    }
+}
+
+static void smtc_entropy_pool_aes_encrypt( const uint32_t* round_keys, const uint8_t* input, uint8_t* output )
+{
+    const uint32_t* rk = round_keys;
+    uint32_t        s0 = SMTC_ENTROPY_POOL_LOAD_BE32( &input[0] ) ^ rk[0];
+    uint32_t        s1 = SMTC_ENTROPY_POOL_LOAD_BE32( &input[4] ) ^ rk[1];
+    uint32_t        s2 = SMTC_ENTROPY_POOL_LOAD_BE32( &input[8] ) ^ rk[2];
+    uint32_t        s3 = SMTC_ENTROPY_POOL_LOAD_BE32( &input[12] ) ^ rk[3];
+    uint32_t        t0, t1, t2, t3;
+
+    const uint32_t* te = smtc_entropy_pool_aes_te;
+
+    for( int round = 1; round < SMTC_ENTROPY_POOL_AES_NB_ROUNDS; round++ )
+    {
+        rk += 4;
+        t0 = te[s0 >> 24] ^ SMTC_ENTROPY_POOL_ROTR( te[( s1 >> 16 ) & 0xFF], 8 ) ^
+             SMTC_ENTROPY_POOL_ROTR( te[( s2 >> 8 ) & 0xFF], 16 ) ^ SMTC_ENTROPY_POOL_ROTR( te[s3 & 0xFF], 24 ) ^ rk[0];
+        t1 = te[s1 >> 24] ^ SMTC_ENTROPY_POOL_ROTR( te[( s2 >> 16 ) & 0xFF], 8 ) ^
+             SMTC_ENTROPY_POOL_ROTR( te[( s3 >> 8 ) & 0xFF], 16 ) ^ SMTC_ENTROPY_POOL_ROTR( te[s0 & 0xFF], 24 ) ^ rk[1];
+        t2 = te[s2 >> 24] ^ SMTC_ENTROPY_POOL_ROTR( te[( s3 >> 16 ) & 0xFF], 8 ) ^
+             SMTC_ENTROPY_POOL_ROTR( te[( s0 >> 8 ) & 0xFF], 16 ) ^ SMTC_ENTROPY_POOL_ROTR( te[s1 & 0xFF], 24 ) ^ rk[2];
+        t3 = te[s3 >> 24] ^ SMTC_ENTROPY_POOL_ROTR( te[( s0 >> 16 ) & 0xFF], 8 ) ^
+             SMTC_ENTROPY_POOL_ROTR( te[( s1 >> 8 ) & 0xFF], 16 ) ^ SMTC_ENTROPY_POOL_ROTR( te[s2 & 0xFF], 24 ) ^ rk[3];
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    // Last round: no MixColumns
+    rk += 4;
+    const uint32_t state[4] = { s0, s1, s2, s3 };
+    const uint8_t* sbox     = smtc_entropy_pool_aes_sbox;
+    for( int col = 0; col < 4; col++ )
+    {
+        const uint32_t out = ( ( ( uint32_t ) sbox[state[col] >> 24] << 24 ) |
+                               ( ( uint32_t ) sbox[( state[( col + 1 ) & 3] >> 16 ) & 0xFF] << 16 ) |
+                               ( ( uint32_t ) sbox[( state[( col + 2 ) & 3] >> 8 ) & 0xFF] << 8 ) |
+                               ( ( uint32_t ) sbox[state[( col + 3 ) & 3] & 0xFF] ) ) ^
+                             rk[col];
+
+        output[4 * col]     = ( uint8_t ) ( out >> 24 );
+        output[4 * col + 1] = ( uint8_t ) ( out >> 16 );
+        output[4 * col + 2] = ( uint8_t ) ( out >> 8 );
+        output[4 * col + 3] = ( uint8_t ) out;
+    }
+}
+
+static void smtc_entropy_pool_increment_v( uint8_t* v )
+{
+    for( int i = SMTC_ENTROPY_POOL_BLOCK_LENGTH - 1; i >= 0; i-- )
+    {
+        if( ++v[i] != 0 )
+        {
+            break;
+        }
+    }
+}
+
+static void smtc_entropy_pool_update( smtc_entropy_pool_t* pool, const uint8_t* provided_data )
+{
+    uint8_t temp[SMTC_ENTROPY_POOL_SEED_LENGTH];
+
+    for( int offset = 0; offset < SMTC_ENTROPY_POOL_SEED_LENGTH; offset += SMTC_ENTROPY_POOL_BLOCK_LENGTH )
+    {
+        smtc_entropy_pool_increment_v( pool->v );
+        smtc_entropy_pool_aes_encrypt( pool->round_keys, pool->v, &temp[offset] );
+    }
+
+    if( provided_data != NULL )
+    {
+        for( int i = 0; i < SMTC_ENTROPY_POOL_SEED_LENGTH; i++ )
+        {
+            temp[i] ^= provided_data[i];
+        }
+    }
+
+    smtc_entropy_pool_aes_set_key( temp, pool->round_keys );
+    memcpy( pool->v, &temp[SMTC_ENTROPY_POOL_BLOCK_LENGTH], SMTC_ENTROPY_POOL_BLOCK_LENGTH );
+    memset( temp, 0, sizeof( temp ) );
+}
+
+static void smtc_entropy_pool_reseed( smtc_entropy_pool_t* pool )
+{
+    smtc_entropy_pool_update( pool, pool->pending );
+    memset( pool->pending, 0, sizeof( pool->pending ) );
+    pool->pending_length = 0;
+
+    // Output generated with the previous state must not be served after the reseed
+    memset( pool->cache, 0, sizeof( pool->cache ) );
+    pool->cache_index = SMTC_ENTROPY_POOL_CACHE_SIZE;
+
+    pool->reseed_counter = 1;
+    pool->stats.nb_reseeds++;
+}
+
+static void smtc_entropy_pool_refill( smtc_entropy_pool_t* pool )
+{
+    for( int offset = 0; offset < SMTC_ENTROPY_POOL_CACHE_SIZE; offset += SMTC_ENTROPY_POOL_BLOCK_LENGTH )
+    {
+        smtc_entropy_pool_increment_v( pool->v );
+        smtc_entropy_pool_aes_encrypt( pool->round_keys, pool->v, &pool->cache[offset] );
+    }
+
+    // Backtracking resistance: the state used for this output is replaced before any of it is handed out
+    smtc_entropy_pool_update( pool, NULL );
+
+    pool->cache_index = 0;
+    pool->reseed_counter++;
+    pool->stats.nb_refills++;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,232 @@
+/**
+ * @file      smtc_entropy_pool.h
+ *
+ * @brief      Entropy pool: raw entropy sources mixed into an AES-128 CTR-DRBG
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMTC_ENTROPY_POOL_H
+#define SMTC_ENTROPY_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/**
+ * @brief Number of DRBG output bytes generated at once and kept to serve the following requests
+ *
+ * @remark Each refill costs two AES blocks of state update on top of the output blocks: a larger cache makes small
+ * requests cheaper, at the price of keeping not yet served output in RAM
+ */
+#ifndef SMTC_ENTROPY_POOL_CACHE_SIZE
+#define SMTC_ENTROPY_POOL_CACHE_SIZE 64
+#endif
+
+/**
+ * @brief Number of cache refills after which smtc_entropy_pool_is_reseed_due reports that fresh entropy is wanted
+ */
+#ifndef SMTC_ENTROPY_POOL_RESEED_INTERVAL
+#define SMTC_ENTROPY_POOL_RESEED_INTERVAL 1024
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Length of the seed material of the DRBG (key and counter block), in bytes
+ */
+#define SMTC_ENTROPY_POOL_SEED_LENGTH 32
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Entropy pool status codes
+ */
+typedef enum smtc_entropy_pool_status_e
+{
+    SMTC_ENTROPY_POOL_STATUS_OK = 0,          //!< Operation completed successfully
+    SMTC_ENTROPY_POOL_STATUS_BAD_PARAMETERS,  //!< At least one parameter has an incorrect value
+    SMTC_ENTROPY_POOL_STATUS_NOT_INIT,        //!< The pool has not been seeded yet
+} smtc_entropy_pool_status_t;
+
+/**
+ * @brief Origin of the entropy fed to the pool, used for the statistics only
+ */
+typedef enum smtc_entropy_pool_source_e
+{
+    SMTC_ENTROPY_POOL_SOURCE_MCU = 0,  //!< MCU true random number generator
+    SMTC_ENTROPY_POOL_SOURCE_RADIO,    //!< Radio random number generator (RX front-end noise)
+    SMTC_ENTROPY_POOL_SOURCE_COUNT,
+} smtc_entropy_pool_source_t;
+
+/**
+ * @brief Entropy pool statistics
+ */
+typedef struct smtc_entropy_pool_stats_s
+{
+    uint32_t nb_requests;      //!< Number of calls to smtc_entropy_pool_get_bytes
+    uint32_t nb_bytes_served;  //!< Number of random bytes handed out
+    uint32_t nb_refills;       //!< Number of DRBG generate calls
+    uint32_t nb_reseeds;       //!< Number of reseeds since the instantiation
+    uint32_t nb_bytes_harvested[SMTC_ENTROPY_POOL_SOURCE_COUNT];  //!< Raw entropy bytes mixed in, per source
+} smtc_entropy_pool_stats_t;
+
+/**
+ * @brief Entropy pool
+ *
+ * @remark The structure is allocated by the caller and only accessed through the functions below
+ */
+typedef struct smtc_entropy_pool_s
+{
+    bool                      is_init;
+    uint32_t                  round_keys[44];  //!< Expanded AES-128 key of the DRBG
+    uint8_t                   v[16];           //!< DRBG counter block
+    uint32_t                  reseed_counter;  //!< Number of generate calls since the last (re)seed
+    uint8_t                   pending[SMTC_ENTROPY_POOL_SEED_LENGTH];  //!< Raw entropy waiting for the next reseed
+    uint16_t                  pending_length;  //!< Number of raw entropy bytes XORed into pending
+    uint8_t                   cache[SMTC_ENTROPY_POOL_CACHE_SIZE];  //!< DRBG output not handed out yet
+    uint16_t                  cache_index;  //!< Index of the first unused byte of the cache
+    smtc_entropy_pool_stats_t stats;
+} smtc_entropy_pool_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Instantiate the DRBG
+ *
+ * @param [out] pool Entropy pool
+ * @param [in] seed Full-entropy seed, SMTC_ENTROPY_POOL_SEED_LENGTH bytes long
+ * @param [in] personalization Device-specific string mixed into the seed, e.g. the MCU unique ID - can be NULL
+ * @param [in] personalization_length Length of personalization, at most SMTC_ENTROPY_POOL_SEED_LENGTH bytes
+ *
+ * @retval SMTC_ENTROPY_POOL_STATUS_OK The pool is ready
+ * @retval SMTC_ENTROPY_POOL_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
+ */
+smtc_entropy_pool_status_t smtc_entropy_pool_init( smtc_entropy_pool_t* pool, const uint8_t* seed,
+                                                   const uint8_t* personalization,
+                                                   unsigned int   personalization_length );
+
+/**
+ * @brief Mix raw entropy into the pool
+ *
+ * Bytes from all sources are XORed together until SMTC_ENTROPY_POOL_SEED_LENGTH bytes have been collected, then the
+ * DRBG is reseeded with the result. A reseed is combined with the current DRBG state, so a weak source cannot reduce the
+ * entropy brought by a good one.
+ *
+ * @param [in, out] pool Entropy pool
+ * @param [in] source Origin of the data
+ * @param [in] data Raw entropy
+ * @param [in] length Length of data
+ *
+ * @retval SMTC_ENTROPY_POOL_STATUS_OK The data has been mixed in
+ * @retval SMTC_ENTROPY_POOL_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
+ * @retval SMTC_ENTROPY_POOL_STATUS_NOT_INIT The pool has not been instantiated
+ */
+smtc_entropy_pool_status_t smtc_entropy_pool_add_entropy( smtc_entropy_pool_t* pool, smtc_entropy_pool_source_t source,
+                                                          const uint8_t* data, unsigned int length );
+
+/**
+ * @brief Check whether the DRBG has produced enough output since the last reseed to want fresh entropy
+ *
+ * @param [in] pool Entropy pool
+ *
+ * @returns true if the application should harvest its entropy sources when it is idle
+ */
+bool smtc_entropy_pool_is_reseed_due( const smtc_entropy_pool_t* pool );
+
+/**
+ * @brief Get random bytes
+ *
+ * @remark Requests are served from RAM and never touch a peripheral
+ *
+ * @param [in, out] pool Entropy pool
+ * @param [out] buffer Output buffer
+ * @param [in] length Number of bytes to produce
+ *
+ * @retval SMTC_ENTROPY_POOL_STATUS_OK The buffer has been filled
+ * @retval SMTC_ENTROPY_POOL_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
+ * @retval SMTC_ENTROPY_POOL_STATUS_NOT_INIT The pool has not been instantiated
+ */
+smtc_entropy_pool_status_t smtc_entropy_pool_get_bytes( smtc_entropy_pool_t* pool, uint8_t* buffer,
+                                                        unsigned int length );
+
+/**
+ * @brief Get a uniformly distributed random integer in [0, range)
+ *
+ * @param [in, out] pool Entropy pool
+ * @param [in] range Number of possible values - 0 gives a full 32-bit random number
+ *
+ * @returns The random integer, 0 if the pool has not been instantiated
+ */
+uint32_t smtc_entropy_pool_get_range( smtc_entropy_pool_t* pool, uint32_t range );
+
+/**
+ * @brief Get the pool statistics
+ *
+ * @param [in] pool Entropy pool
+ * @param [out] stats Statistics
+ */
+void smtc_entropy_pool_get_stats( const smtc_entropy_pool_t* pool, smtc_entropy_pool_stats_t* stats );
+
+/**
+ * @brief Run the AES-128 known-answer test of FIPS-197
+ *
+ * @returns true if the block cipher behind the DRBG produces the expected ciphertext
+ */
+bool smtc_entropy_pool_self_test( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SMTC_ENTROPY_POOL_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,316 @@
+/*!
+ * @file      smtc_hal_mcu_nvm_host.c
+ *
+ * @brief      Implementation of NVM module on top of a host file
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "smtc_hal_mcu_nvm.h"
+#include "smtc_hal_mcu_nvm_host.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Structure defining a NVM instance
+ */
+struct smtc_hal_mcu_nvm_inst_s
+{
+    bool     is_cfged;
+    FILE*    file;
+    uint8_t* mirror;
+    uint32_t size;
+    uint32_t page_size;
+    int32_t  write_budget;
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/**
+ * @brief Single NVM instance
+ */
+static struct smtc_hal_mcu_nvm_inst_s nvm_inst;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Write back a range of the RAM mirror to the file
+ */
+static smtc_hal_mcu_status_t smtc_hal_mcu_nvm_host_flush( smtc_hal_mcu_nvm_inst_t inst, unsigned int offset,
+                                                          unsigned int length );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_init( const smtc_hal_mcu_nvm_cfg_t cfg, smtc_hal_mcu_nvm_inst_t* inst )
+{
+    if( nvm_inst.is_cfged == true )
+    {
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
+    if( ( cfg->path == NULL ) || ( cfg->size == 0 ) || ( cfg->page_size == 0 ) ||
+        ( ( cfg->size % cfg->page_size ) != 0 ) || ( ( cfg->page_size % SMTC_HAL_MCU_NVM_HOST_WRITE_SIZE ) != 0 ) )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    nvm_inst.mirror = malloc( cfg->size );
+    if( nvm_inst.mirror == NULL )
+    {
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+    memset( nvm_inst.mirror, 0xFF, cfg->size );
+
+    nvm_inst.file = fopen( cfg->path, "r+b" );
+    if( nvm_inst.file != NULL )
+    {
+        /* A shorter file is extended with erased bytes */
+        ( void ) fread( nvm_inst.mirror, 1, cfg->size, nvm_inst.file );
+    }
+    else
+    {
+        nvm_inst.file = fopen( cfg->path, "w+b" );
+    }
+
+    if( nvm_inst.file == NULL )
+    {
+        free( nvm_inst.mirror );
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
+    nvm_inst.size         = cfg->size;
+    nvm_inst.page_size    = cfg->page_size;
+    nvm_inst.write_budget = -1;
+    nvm_inst.is_cfged     = true;
+
+    if( smtc_hal_mcu_nvm_host_flush( &nvm_inst, 0, cfg->size ) != SMTC_HAL_MCU_STATUS_OK )
+    {
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
+    *inst = &nvm_inst;
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_deinit( smtc_hal_mcu_nvm_inst_t* inst )
+{
+    smtc_hal_mcu_nvm_inst_t inst_local = *inst;
+
+    if( inst_local != &nvm_inst )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst_local->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    fclose( inst_local->file );
+    free( inst_local->mirror );
+
+    inst_local->is_cfged = false;
+    *inst                = NULL;
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_write( smtc_hal_mcu_nvm_inst_t inst, unsigned int offset, const uint8_t* buffer,
+                                              unsigned int length )
+{
+    unsigned int aligned_length;
+
+    if( inst != &nvm_inst )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    aligned_length = ( length + SMTC_HAL_MCU_NVM_HOST_WRITE_SIZE - 1 ) & ~( SMTC_HAL_MCU_NVM_HOST_WRITE_SIZE - 1 );
+    if( ( buffer == NULL ) || ( ( offset % SMTC_HAL_MCU_NVM_HOST_WRITE_SIZE ) != 0 ) || ( offset > inst->size ) ||
+        ( aligned_length > ( inst->size - offset ) ) )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    /* Like the flash, refuse to program a double word that is not erased */
+    for( unsigned int i = 0; i < aligned_length; i++ )
+    {
+        if( inst->mirror[offset + i] != 0xFF )
+        {
+            return SMTC_HAL_MCU_STATUS_ERROR;
+        }
+    }
+
+    for( unsigned int i = 0; i < length; i++ )
+    {
+        if( inst->write_budget == 0 )
+        {
+            ( void ) smtc_hal_mcu_nvm_host_flush( inst, offset, i );
+            return SMTC_HAL_MCU_STATUS_ERROR;
+        }
+        if( inst->write_budget > 0 )
+        {
+            inst->write_budget--;
+        }
+
+        inst->mirror[offset + i] = buffer[i];
+    }
+
+    return smtc_hal_mcu_nvm_host_flush( inst, offset, length );
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_read( smtc_hal_mcu_nvm_inst_t inst, unsigned int offset, uint8_t* buffer,
+                                             unsigned int length )
+{
+    if( inst != &nvm_inst )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    if( ( buffer == NULL ) || ( offset > inst->size ) || ( length > ( inst->size - offset ) ) )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    memcpy( buffer, &inst->mirror[offset], length );
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_erase( smtc_hal_mcu_nvm_inst_t inst, unsigned int offset, unsigned int length )
+{
+    if( inst != &nvm_inst )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    if( ( ( offset % inst->page_size ) != 0 ) || ( ( length % inst->page_size ) != 0 ) || ( offset > inst->size ) ||
+        ( length > ( inst->size - offset ) ) )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->write_budget == 0 )
+    {
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
+    memset( &inst->mirror[offset], 0xFF, length );
+
+    return smtc_hal_mcu_nvm_host_flush( inst, offset, length );
+}
+
+smtc_hal_mcu_status_t smtc_hal_mcu_nvm_get_total_size( smtc_hal_mcu_nvm_inst_t inst, unsigned int* size )
+{
+    if( inst != &nvm_inst )
+    {
+        return SMTC_HAL_MCU_STATUS_BAD_PARAMETERS;
+    }
+
+    if( inst->is_cfged == false )
+    {
+        return SMTC_HAL_MCU_STATUS_NOT_INIT;
+    }
+
+    *size = inst->size;
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+void smtc_hal_mcu_nvm_host_set_write_budget( smtc_hal_mcu_nvm_inst_t inst, int32_t nb_bytes )
+{
+    inst->write_budget = nb_bytes;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static smtc_hal_mcu_status_t smtc_hal_mcu_nvm_host_flush( smtc_hal_mcu_nvm_inst_t inst, unsigned int offset,
+                                                          unsigned int length )
+{
+    if( ( fseek( inst->file, offset, SEEK_SET ) != 0 ) ||
+        ( fwrite( &inst->mirror[offset], 1, length, inst->file ) != length ) || ( fflush( inst->file ) != 0 ) )
+    {
+        return SMTC_HAL_MCU_STATUS_ERROR;
+    }
+
+    return SMTC_HAL_MCU_STATUS_OK;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,104 @@
+/**
+ * @file      smtc_hal_mcu_nvm_host.h
+ *
+ * @brief      Types for implementation of NVM module on top of a host file
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMTC_HAL_MCU_NVM_HOST_H
+#define SMTC_HAL_MCU_NVM_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include "smtc_hal_mcu_nvm.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Size of an emulated flash double word, which is the write granularity
+ */
+#define SMTC_HAL_MCU_NVM_HOST_WRITE_SIZE 8
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief NVM configuration structure
+ *
+ * The file emulates the STM32L4 flash: erasure by pages, double words programmed once between two erasures.
+ */
+struct smtc_hal_mcu_nvm_cfg_s
+{
+    const char* path;       //!< File backing the NVM, created erased if it does not exist
+    uint32_t    size;       //!< Size of the NVM
+    uint32_t    page_size;  //!< Erase granularity
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Simulate a power failure after a number of bytes have been written
+ *
+ * Once the budget is exhausted, the write in progress is left torn and all subsequent writes and erasures fail until the
+ * NVM is deinitialised and initialised again.
+ *
+ * @param [in] inst NVM instance
+ * @param [in] nb_bytes Number of bytes that can still be written, -1 to disable
+ */
+void smtc_hal_mcu_nvm_host_set_write_budget( smtc_hal_mcu_nvm_inst_t inst, int32_t nb_bytes );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SMTC_HAL_MCU_NVM_HOST_H
+
+/* --- EOF ------------------------------------------------------------------ */
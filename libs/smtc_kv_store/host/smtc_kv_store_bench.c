@@ -0,0 +1,452 @@
+/*!
+ * @file      smtc_kv_store_bench.c
+ *
+ * @brief      Host benchmark of the key-value store: write amplification, wear, lookup latency and power-fail recovery
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "smtc_hal_mcu_nvm.h"
+#include "smtc_hal_mcu_nvm_host.h"
+#include "smtc_kv_store.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Largest value length the benchmark supports
+ */
+#define BENCH_VALUE_LENGTH_MAX 1024
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Benchmark parameters
+ */
+typedef struct bench_cfg_s
+{
+    const char* path;
+    uint32_t    nvm_size;
+    uint32_t    sector_size;
+    uint32_t    nb_keys;
+    uint32_t    value_length;
+    uint32_t    nb_writes;
+    uint32_t    nb_power_failures;
+} bench_cfg_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static smtc_hal_mcu_nvm_inst_t nvm;
+static smtc_kv_store_t         store;
+static uint32_t                rng_state = 0x2545F491;
+
+/**
+ * @brief Version of the value each key is expected to hold, 0 if the key has never been written
+ */
+static uint32_t expected_version[SMTC_KV_STORE_NB_KEYS_MAX];
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static uint32_t bench_rand( void );
+static uint64_t bench_get_time_in_ns( void );
+static uint16_t bench_pick_key( const bench_cfg_t* cfg );
+static void     bench_make_value( uint16_t key, uint32_t version, uint8_t* value, uint32_t length );
+static bool     bench_mount( const bench_cfg_t* cfg );
+static void     bench_unmount( void );
+static bool     bench_check_key( const bench_cfg_t* cfg, uint16_t key, uint32_t version );
+static bool     bench_run_writes( const bench_cfg_t* cfg );
+static bool     bench_run_lookups( const bench_cfg_t* cfg );
+static bool     bench_run_power_failures( const bench_cfg_t* cfg );
+static void     bench_print_stats( void );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( int argc, char** argv )
+{
+    bench_cfg_t cfg = {
+        .path              = "kv_store_bench.bin",
+        .nvm_size          = 0x8000,
+        .sector_size       = 0x800,
+        .nb_keys           = 32,
+        .value_length      = 24,
+        .nb_writes         = 100000,
+        .nb_power_failures = 2000,
+    };
+    int opt;
+
+    while( ( opt = getopt( argc, argv, "f:s:S:k:l:n:p:" ) ) != -1 )
+    {
+        switch( opt )
+        {
+        case 'f':
+            cfg.path = optarg;
+            break;
+        case 's':
+            cfg.nvm_size = strtoul( optarg, NULL, 0 );
+            break;
+        case 'S':
+            cfg.sector_size = strtoul( optarg, NULL, 0 );
+            break;
+        case 'k':
+            cfg.nb_keys = strtoul( optarg, NULL, 0 );
+            break;
+        case 'l':
+            cfg.value_length = strtoul( optarg, NULL, 0 );
+            break;
+        case 'n':
+            cfg.nb_writes = strtoul( optarg, NULL, 0 );
+            break;
+        case 'p':
+            cfg.nb_power_failures = strtoul( optarg, NULL, 0 );
+            break;
+        default:
+            fprintf( stderr,
+                     "usage: %s [-f file] [-s nvm size] [-S sector size] [-k keys] [-l value length] [-n writes] "
+                     "[-p power failures]\n",
+                     argv[0] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    if( ( cfg.nb_keys == 0 ) || ( cfg.nb_keys > SMTC_KV_STORE_NB_KEYS_MAX ) ||
+        ( cfg.value_length < 8 ) || ( cfg.value_length > BENCH_VALUE_LENGTH_MAX ) )
+    {
+        fprintf( stderr, "keys must be in [1, %d], value length in [8, %d]\n", SMTC_KV_STORE_NB_KEYS_MAX,
+                 BENCH_VALUE_LENGTH_MAX );
+        return EXIT_FAILURE;
+    }
+
+    remove( cfg.path );
+
+    printf( "NVM %u bytes, sectors of %u bytes, %u keys of %u bytes\n", cfg.nvm_size, cfg.sector_size, cfg.nb_keys,
+            cfg.value_length );
+
+    if( ( bench_mount( &cfg ) == false ) || ( bench_run_writes( &cfg ) == false ) ||
+        ( bench_run_lookups( &cfg ) == false ) || ( bench_run_power_failures( &cfg ) == false ) )
+    {
+        return EXIT_FAILURE;
+    }
+
+    bench_unmount( );
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint32_t bench_rand( void )
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+
+    return rng_state;
+}
+
+static uint64_t bench_get_time_in_ns( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return ( ( uint64_t ) now.tv_sec * 1000000000ULL ) + ( uint64_t ) now.tv_nsec;
+}
+
+static uint16_t bench_pick_key( const bench_cfg_t* cfg )
+{
+    const uint32_t nb_hot_keys = ( cfg->nb_keys + 4 ) / 5;
+
+    /* 80% of the writes go to 20% of the keys, like counters next to rarely changed settings */
+    if( ( bench_rand( ) % 100 ) < 80 )
+    {
+        return bench_rand( ) % nb_hot_keys;
+    }
+
+    return bench_rand( ) % cfg->nb_keys;
+}
+
+static void bench_make_value( uint16_t key, uint32_t version, uint8_t* value, uint32_t length )
+{
+    memcpy( &value[0], &key, sizeof( key ) );
+    memcpy( &value[2], &version, sizeof( version ) );
+    for( uint32_t i = 6; i < length; i++ )
+    {
+        value[i] = ( uint8_t ) ( ( version * 31 ) + i );
+    }
+}
+
+static bool bench_mount( const bench_cfg_t* cfg )
+{
+    struct smtc_hal_mcu_nvm_cfg_s nvm_cfg = {
+        .path      = cfg->path,
+        .size      = cfg->nvm_size,
+        .page_size = cfg->sector_size,
+    };
+    smtc_kv_store_cfg_t kv_cfg = {
+        .sector_size = cfg->sector_size,
+    };
+    smtc_kv_store_status_t status;
+
+    if( smtc_hal_mcu_nvm_init( &nvm_cfg, &nvm ) != SMTC_HAL_MCU_STATUS_OK )
+    {
+        fprintf( stderr, "cannot open %s\n", cfg->path );
+        return false;
+    }
+
+    kv_cfg.nvm = nvm;
+    status     = smtc_kv_store_init( &store, &kv_cfg );
+    if( status != SMTC_KV_STORE_STATUS_OK )
+    {
+        fprintf( stderr, "smtc_kv_store_init failed: %d\n", status );
+        return false;
+    }
+
+    return true;
+}
+
+static void bench_unmount( void )
+{
+    smtc_hal_mcu_nvm_deinit( &nvm );
+}
+
+static bool bench_check_key( const bench_cfg_t* cfg, uint16_t key, uint32_t version )
+{
+    uint8_t                expected[BENCH_VALUE_LENGTH_MAX];
+    uint8_t                value[BENCH_VALUE_LENGTH_MAX];
+    uint16_t               length;
+    smtc_kv_store_status_t status = smtc_kv_store_read( &store, key, value, sizeof( value ), &length );
+
+    if( version == 0 )
+    {
+        return status == SMTC_KV_STORE_STATUS_NOT_FOUND;
+    }
+
+    bench_make_value( key, version, expected, cfg->value_length );
+
+    return ( status == SMTC_KV_STORE_STATUS_OK ) && ( length == cfg->value_length ) &&
+           ( memcmp( value, expected, length ) == 0 );
+}
+
+static bool bench_run_writes( const bench_cfg_t* cfg )
+{
+    uint8_t  value[BENCH_VALUE_LENGTH_MAX];
+    uint64_t total_in_ns = 0;
+    uint64_t max_in_ns   = 0;
+
+    for( uint32_t i = 0; i < cfg->nb_writes; i++ )
+    {
+        const uint16_t         key = bench_pick_key( cfg );
+        uint64_t               start_in_ns;
+        uint64_t               duration_in_ns;
+        smtc_kv_store_status_t status;
+
+        bench_make_value( key, expected_version[key] + 1, value, cfg->value_length );
+
+        start_in_ns    = bench_get_time_in_ns( );
+        status         = smtc_kv_store_write( &store, key, value, cfg->value_length );
+        duration_in_ns = bench_get_time_in_ns( ) - start_in_ns;
+
+        if( status != SMTC_KV_STORE_STATUS_OK )
+        {
+            fprintf( stderr, "write %u of key %u failed: %d\n", i, key, status );
+            return false;
+        }
+        expected_version[key]++;
+
+        total_in_ns += duration_in_ns;
+        max_in_ns = ( duration_in_ns > max_in_ns ) ? duration_in_ns : max_in_ns;
+
+        /* Background compaction, as run from the application main loop */
+        smtc_kv_store_process( &store );
+    }
+
+    printf( "\n%u writes: %.1f us avg, %.1f us max (file I/O included)\n", cfg->nb_writes,
+            ( cfg->nb_writes > 0 ) ? ( double ) total_in_ns / cfg->nb_writes / 1000.0 : 0.0,
+            ( double ) max_in_ns / 1000.0 );
+    bench_print_stats( );
+
+    return true;
+}
+
+static bool bench_run_lookups( const bench_cfg_t* cfg )
+{
+    uint8_t  value[BENCH_VALUE_LENGTH_MAX];
+    uint64_t start_in_ns;
+    uint64_t total_in_ns;
+    uint64_t mount_in_ns;
+    uint32_t nb_lookups = ( cfg->nb_writes > 0 ) ? ( cfg->nb_writes * 10 ) : 1;
+
+    start_in_ns = bench_get_time_in_ns( );
+    for( uint32_t i = 0; i < nb_lookups; i++ )
+    {
+        smtc_kv_store_read( &store, bench_rand( ) % cfg->nb_keys, value, sizeof( value ), NULL );
+    }
+    total_in_ns = bench_get_time_in_ns( ) - start_in_ns;
+
+    bench_unmount( );
+    start_in_ns = bench_get_time_in_ns( );
+    if( bench_mount( cfg ) == false )
+    {
+        return false;
+    }
+    mount_in_ns = bench_get_time_in_ns( ) - start_in_ns;
+
+    for( uint16_t key = 0; key < cfg->nb_keys; key++ )
+    {
+        if( bench_check_key( cfg, key, expected_version[key] ) == false )
+        {
+            fprintf( stderr, "key %u lost after remount\n", key );
+            return false;
+        }
+    }
+
+    printf( "\n%u lookups: %.1f ns avg\n", nb_lookups, ( double ) total_in_ns / nb_lookups );
+    printf( "remount and index rebuild: %.1f us, all keys verified\n", ( double ) mount_in_ns / 1000.0 );
+
+    return true;
+}
+
+static bool bench_run_power_failures( const bench_cfg_t* cfg )
+{
+    uint8_t  value[BENCH_VALUE_LENGTH_MAX];
+    uint32_t nb_rolled_back = 0;
+
+    for( uint32_t i = 0; i < cfg->nb_power_failures; i++ )
+    {
+        uint16_t               key = 0;
+        smtc_kv_store_status_t status;
+
+        /* Cut the power somewhere within the next few records, compaction included */
+        smtc_hal_mcu_nvm_host_set_write_budget( nvm, bench_rand( ) % ( 4 * ( cfg->value_length + 8 ) ) );
+
+        while( true )
+        {
+            key = bench_pick_key( cfg );
+            bench_make_value( key, expected_version[key] + 1, value, cfg->value_length );
+
+            status = smtc_kv_store_write( &store, key, value, cfg->value_length );
+            if( status == SMTC_KV_STORE_STATUS_ERROR )
+            {
+                break;
+            }
+            if( status != SMTC_KV_STORE_STATUS_OK )
+            {
+                fprintf( stderr, "power failure %u: write of key %u failed: %d\n", i, key, status );
+                return false;
+            }
+            expected_version[key]++;
+
+            smtc_kv_store_process( &store );
+        }
+
+        bench_unmount( );
+        if( bench_mount( cfg ) == false )
+        {
+            return false;
+        }
+
+        /* The interrupted write is either fully there or not at all, every other key is untouched */
+        if( bench_check_key( cfg, key, expected_version[key] + 1 ) == true )
+        {
+            expected_version[key]++;
+        }
+        else
+        {
+            nb_rolled_back++;
+        }
+
+        for( uint16_t k = 0; k < cfg->nb_keys; k++ )
+        {
+            if( bench_check_key( cfg, k, expected_version[k] ) == false )
+            {
+                fprintf( stderr, "power failure %u: key %u corrupted\n", i, k );
+                return false;
+            }
+        }
+    }
+
+    if( cfg->nb_power_failures > 0 )
+    {
+        printf( "\n%u power failures: all keys consistent after each remount, interrupted write rolled back %u times\n",
+                cfg->nb_power_failures, nb_rolled_back );
+    }
+
+    return true;
+}
+
+static void bench_print_stats( void )
+{
+    smtc_kv_store_stats_t stats;
+
+    smtc_kv_store_get_stats( &store, &stats );
+
+    printf( "keys %u, live %u / %u bytes, %u free sectors\n", stats.nb_keys, stats.live_bytes, stats.capacity_bytes,
+            stats.nb_free_sectors );
+    printf( "write amplification %.3f (%u bytes written for %u bytes of records), %u records compacted\n",
+            ( stats.user_bytes_written > 0 ) ? ( double ) stats.nvm_bytes_written / stats.user_bytes_written : 0.0,
+            stats.nvm_bytes_written, stats.user_bytes_written, stats.nb_records_compacted );
+    printf( "%u sector erasures, erase count per sector min %u max %u\n", stats.nb_sectors_erased,
+            stats.sector_erase_count_min, stats.sector_erase_count_max );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
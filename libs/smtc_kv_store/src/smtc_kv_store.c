@@ -0,0 +1,1138 @@
+/*!
+ * @file      smtc_kv_store.c
+ *
+ * @brief      Log-structured key-value store on top of the NVM HAL
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "smtc_kv_store.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/**
+ * @brief Round a length up to the NVM write granularity
+ */
+#define SMTC_KV_STORE_ALIGN( length ) \
+    ( ( ( length ) + SMTC_KV_STORE_WRITE_SIZE - 1 ) & ~( uint32_t ) ( SMTC_KV_STORE_WRITE_SIZE - 1 ) )
+
+/**
+ * @brief Size of a record holding a value of the given length
+ */
+#define SMTC_KV_STORE_RECORD_SIZE( length ) ( SMTC_KV_STORE_RECORD_HEADER_SIZE + SMTC_KV_STORE_ALIGN( length ) )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief NVM write granularity, records are aligned on it so that each one is programmed in whole double words
+ */
+#define SMTC_KV_STORE_WRITE_SIZE 8
+
+/**
+ * @brief Value identifying the header of a formatted sector
+ */
+#define SMTC_KV_STORE_SECTOR_MAGIC 0x3153564BU
+
+/**
+ * @brief Size of the header at the beginning of each sector
+ */
+#define SMTC_KV_STORE_SECTOR_HEADER_SIZE 16
+
+/**
+ * @brief Size of the header of each record
+ */
+#define SMTC_KV_STORE_RECORD_HEADER_SIZE 8
+
+/**
+ * @brief Flag set in the length field of the record logging the removal of a key
+ */
+#define SMTC_KV_STORE_RECORD_TOMBSTONE 0x8000
+
+/**
+ * @brief Minimum number of erased sectors background compaction tries to maintain
+ */
+#define SMTC_KV_STORE_FREE_SECTORS_TARGET 2
+
+/**
+ * @brief Size of the buffer used to copy or check data by chunks
+ */
+#define SMTC_KV_STORE_CHUNK_SIZE 64
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Header written at the beginning of a sector when it becomes the head of the log
+ */
+typedef struct smtc_kv_store_sector_header_s
+{
+    uint32_t magic;        //!< SMTC_KV_STORE_SECTOR_MAGIC
+    uint32_t sequence;     //!< Position of the sector in the log, incremented at each new head
+    uint32_t erase_count;  //!< Number of times the sector has been erased
+    uint16_t crc;          //!< CRC of the fields above
+    uint16_t reserved;     //!< Left erased
+} smtc_kv_store_sector_header_t;
+
+/**
+ * @brief Header of a record
+ *
+ * A record is committed once its data matches data_crc: the header is written first so that a record interrupted by a
+ * reset still tells where the next one starts.
+ */
+typedef struct smtc_kv_store_record_header_s
+{
+    uint16_t key;         //!< Key
+    uint16_t length;      //!< Length of the value, SMTC_KV_STORE_RECORD_TOMBSTONE if the key is removed
+    uint16_t data_crc;    //!< CRC of the value
+    uint16_t header_crc;  //!< CRC of the fields above
+} smtc_kv_store_record_header_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/**
+ * @brief Nibble lookup table of the CRC-16/CCITT polynomial
+ */
+static const uint16_t crc16_nibble_lut[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Update a CRC-16/CCITT with a buffer
+ *
+ * @param [in] crc CRC of the previous data, 0xFFFF to start
+ * @param [in] buffer Data
+ * @param [in] length Length of the data
+ *
+ * @returns Updated CRC
+ */
+static uint16_t smtc_kv_store_crc16( uint16_t crc, const uint8_t* buffer, uint32_t length );
+
+/**
+ * @brief Compute the CRC of a record header
+ */
+static uint16_t smtc_kv_store_record_header_crc( const smtc_kv_store_record_header_t* header );
+
+/**
+ * @brief Compute the CRC of a sector header
+ */
+static uint16_t smtc_kv_store_sector_header_crc( const smtc_kv_store_sector_header_t* header );
+
+/**
+ * @brief Read from the NVM
+ */
+static smtc_kv_store_status_t smtc_kv_store_nvm_read( const smtc_kv_store_t* store, uint32_t offset, void* buffer,
+                                                      uint32_t length );
+
+/**
+ * @brief Write to the NVM and account for it in the statistics
+ */
+static smtc_kv_store_status_t smtc_kv_store_nvm_write( smtc_kv_store_t* store, uint32_t offset, const void* buffer,
+                                                       uint32_t length );
+
+/**
+ * @brief Check whether an area of the NVM is erased
+ */
+static bool smtc_kv_store_is_blank( const smtc_kv_store_t* store, uint32_t offset, uint32_t length );
+
+/**
+ * @brief Compute the CRC of a value stored in the NVM
+ */
+static smtc_kv_store_status_t smtc_kv_store_nvm_crc16( const smtc_kv_store_t* store, uint32_t offset, uint32_t length,
+                                                       uint16_t* crc );
+
+/**
+ * @brief Erase a sector and increment its erase count
+ */
+static smtc_kv_store_status_t smtc_kv_store_erase_sector( smtc_kv_store_t* store, uint8_t sector );
+
+/**
+ * @brief Read and check the header of a sector
+ *
+ * @retval true The sector is formatted
+ * @retval false The sector is blank or its header is corrupted
+ */
+static bool smtc_kv_store_read_sector_header( const smtc_kv_store_t* store, uint8_t sector,
+                                              smtc_kv_store_sector_header_t* header );
+
+/**
+ * @brief Make the next sector in the ring the head of the log
+ */
+static smtc_kv_store_status_t smtc_kv_store_open_next_sector( smtc_kv_store_t* store );
+
+/**
+ * @brief Make sure the head sector can hold a record, rotating and compacting as needed
+ *
+ * @param [in, out] store Key-value store instance
+ * @param [in] record_size Size of the record
+ * @param [in] use_reserve Allow the last erased sector to be used, only for records copied by the compaction
+ */
+static smtc_kv_store_status_t smtc_kv_store_make_room( smtc_kv_store_t* store, uint32_t record_size,
+                                                       bool use_reserve );
+
+/**
+ * @brief Append a record to the log
+ *
+ * @param [in, out] store Key-value store instance
+ * @param [in] header Record header, CRCs included
+ * @param [in] value Value in RAM, or NULL to copy it from the NVM at value_offset
+ * @param [in] value_offset Offset in NVM of the value to copy when value is NULL
+ * @param [in] use_reserve See smtc_kv_store_make_room
+ * @param [out] record_offset Offset in NVM of the appended record
+ */
+static smtc_kv_store_status_t smtc_kv_store_append( smtc_kv_store_t* store, const smtc_kv_store_record_header_t* header,
+                                                    const uint8_t* value, uint32_t value_offset, bool use_reserve,
+                                                    uint32_t* record_offset );
+
+/**
+ * @brief Copy one live record out of the tail sector, or erase the tail sector if it only holds stale records
+ *
+ * @retval SMTC_KV_STORE_STATUS_OK One step has been done
+ * @retval SMTC_KV_STORE_STATUS_NO_SPACE There is nothing to compact
+ * @retval SMTC_KV_STORE_STATUS_ERROR The NVM reported an error
+ */
+static smtc_kv_store_status_t smtc_kv_store_compact_step( smtc_kv_store_t* store );
+
+/**
+ * @brief Get the number of stale bytes compaction could reclaim
+ */
+static uint32_t smtc_kv_store_get_reclaimable_bytes( const smtc_kv_store_t* store );
+
+/**
+ * @brief Replay the records of a sector into the RAM index
+ *
+ * @returns Offset following the last record of the sector
+ */
+static smtc_kv_store_status_t smtc_kv_store_replay_sector( smtc_kv_store_t* store, uint8_t sector,
+                                                           uint32_t* end_offset );
+
+/**
+ * @brief Get the index entry slot a key hashes to
+ */
+static uint32_t smtc_kv_store_index_hash( uint16_t key );
+
+/**
+ * @brief Find the index entry of a key
+ *
+ * @returns Pointer to the entry, NULL if the key is not in the index
+ */
+static smtc_kv_store_index_entry_t* smtc_kv_store_index_find( const smtc_kv_store_t* store, uint16_t key );
+
+/**
+ * @brief Insert or update the index entry of a key
+ */
+static smtc_kv_store_status_t smtc_kv_store_index_put( smtc_kv_store_t* store, uint16_t key, uint16_t length,
+                                                       uint32_t offset );
+
+/**
+ * @brief Remove the index entry of a key, shifting back the entries of the same probe sequence
+ */
+static void smtc_kv_store_index_remove( smtc_kv_store_t* store, uint16_t key );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+smtc_kv_store_status_t smtc_kv_store_init( smtc_kv_store_t* store, const smtc_kv_store_cfg_t* cfg )
+{
+    smtc_kv_store_sector_header_t header;
+    bool                          is_formatted[SMTC_KV_STORE_NB_SECTORS_MAX];
+    unsigned int                  nvm_size;
+    uint32_t                      erase_count_max = 0;
+    uint8_t                       nb_formatted    = 0;
+    uint8_t                       nb_in_log       = 1;
+    smtc_kv_store_status_t        status;
+
+    if( ( store == NULL ) || ( cfg == NULL ) || ( cfg->sector_size % SMTC_KV_STORE_WRITE_SIZE != 0 ) ||
+        ( cfg->sector_size < ( SMTC_KV_STORE_SECTOR_HEADER_SIZE + SMTC_KV_STORE_RECORD_HEADER_SIZE ) ) ||
+        ( smtc_hal_mcu_nvm_get_total_size( cfg->nvm, &nvm_size ) != SMTC_HAL_MCU_STATUS_OK ) )
+    {
+        return SMTC_KV_STORE_STATUS_BAD_PARAMETERS;
+    }
+
+    memset( store, 0, sizeof( smtc_kv_store_t ) );
+    memset( store->index, 0xFF, sizeof( store->index ) );
+    store->nvm         = cfg->nvm;
+    store->sector_size = cfg->sector_size;
+    store->nb_sectors  = ( ( nvm_size / cfg->sector_size ) < SMTC_KV_STORE_NB_SECTORS_MAX )
+                             ? ( uint8_t ) ( nvm_size / cfg->sector_size )
+                             : SMTC_KV_STORE_NB_SECTORS_MAX;
+    store->stats.capacity_bytes =
+        ( store->nb_sectors - 2 ) * ( store->sector_size - SMTC_KV_STORE_SECTOR_HEADER_SIZE );
+
+    if( store->nb_sectors < 3 )
+    {
+        return SMTC_KV_STORE_STATUS_BAD_PARAMETERS;
+    }
+
+    /* Find the head of the log: the formatted sector with the highest sequence number */
+    for( uint8_t sector = 0; sector < store->nb_sectors; sector++ )
+    {
+        is_formatted[sector] = smtc_kv_store_read_sector_header( store, sector, &header );
+        if( is_formatted[sector] == true )
+        {
+            store->sector_erase_count[sector] = header.erase_count;
+            erase_count_max = ( header.erase_count > erase_count_max ) ? header.erase_count : erase_count_max;
+
+            if( ( nb_formatted == 0 ) || ( ( int32_t ) ( header.sequence - store->head_sequence ) > 0 ) )
+            {
+                store->head_sector   = sector;
+                store->head_sequence = header.sequence;
+            }
+            nb_formatted++;
+        }
+    }
+
+    /* The erase count of erased sectors is not stored anywhere, assume the worst */
+    for( uint8_t sector = 0; sector < store->nb_sectors; sector++ )
+    {
+        if( is_formatted[sector] == false )
+        {
+            store->sector_erase_count[sector] = erase_count_max;
+        }
+    }
+
+    store->is_init = true;
+
+    if( nb_formatted == 0 )
+    {
+        return smtc_kv_store_format( store );
+    }
+
+    /* Sectors are opened in ring order, the log runs from the tail to the head with decreasing sequence numbers */
+    store->tail_sector = store->head_sector;
+    while( nb_in_log < store->nb_sectors )
+    {
+        const uint8_t previous = ( store->tail_sector + store->nb_sectors - 1 ) % store->nb_sectors;
+
+        if( ( is_formatted[previous] == false ) ||
+            ( smtc_kv_store_read_sector_header( store, previous, &header ) == false ) ||
+            ( header.sequence != ( store->head_sequence - nb_in_log ) ) )
+        {
+            break;
+        }
+        store->tail_sector = previous;
+        nb_in_log++;
+    }
+
+    for( uint8_t i = 0; i < nb_in_log; i++ )
+    {
+        const uint8_t sector = ( store->tail_sector + i ) % store->nb_sectors;
+        uint32_t      end_offset;
+
+        status = smtc_kv_store_replay_sector( store, sector, &end_offset );
+        if( status != SMTC_KV_STORE_STATUS_OK )
+        {
+            store->is_init = false;
+            return status;
+        }
+
+        if( sector == store->head_sector )
+        {
+            store->write_offset = end_offset;
+        }
+    }
+
+    /* Everything outside of the log is free space, left over from an interrupted erasure at worst */
+    for( uint8_t i = nb_in_log; i < store->nb_sectors; i++ )
+    {
+        const uint8_t sector = ( store->tail_sector + i ) % store->nb_sectors;
+
+        if( smtc_kv_store_is_blank( store, sector * store->sector_size, store->sector_size ) == false )
+        {
+            status = smtc_kv_store_erase_sector( store, sector );
+            if( status != SMTC_KV_STORE_STATUS_OK )
+            {
+                store->is_init = false;
+                return status;
+            }
+        }
+    }
+    store->nb_free_sectors = store->nb_sectors - nb_in_log;
+
+    return SMTC_KV_STORE_STATUS_OK;
+}
+
+smtc_kv_store_status_t smtc_kv_store_format( smtc_kv_store_t* store )
+{
+    smtc_kv_store_status_t status;
+
+    if( ( store == NULL ) || ( store->is_init == false ) )
+    {
+        return SMTC_KV_STORE_STATUS_NOT_INIT;
+    }
+
+    for( uint8_t sector = 0; sector < store->nb_sectors; sector++ )
+    {
+        if( smtc_kv_store_is_blank( store, sector * store->sector_size, store->sector_size ) == false )
+        {
+            status = smtc_kv_store_erase_sector( store, sector );
+            if( status != SMTC_KV_STORE_STATUS_OK )
+            {
+                return status;
+            }
+        }
+    }
+
+    memset( store->index, 0xFF, sizeof( store->index ) );
+    store->stats.nb_keys    = 0;
+    store->stats.live_bytes = 0;
+
+    /* Start the new log right after the previous head to keep the wear even */
+    store->nb_free_sectors   = store->nb_sectors;
+    store->compaction_offset = 0;
+
+    status = smtc_kv_store_open_next_sector( store );
+    if( status != SMTC_KV_STORE_STATUS_OK )
+    {
+        return status;
+    }
+    store->tail_sector = store->head_sector;
+
+    return SMTC_KV_STORE_STATUS_OK;
+}
+
+smtc_kv_store_status_t smtc_kv_store_read( const smtc_kv_store_t* store, uint16_t key, uint8_t* buffer, uint16_t size,
+                                           uint16_t* length )
+{
+    const smtc_kv_store_index_entry_t* entry;
+
+    if( ( store == NULL ) || ( store->is_init == false ) )
+    {
+        return SMTC_KV_STORE_STATUS_NOT_INIT;
+    }
+
+    entry = smtc_kv_store_index_find( store, key );
+    if( entry == NULL )
+    {
+        return SMTC_KV_STORE_STATUS_NOT_FOUND;
+    }
+
+    if( length != NULL )
+    {
+        *length = entry->length;
+    }
+
+    if( ( entry->length > size ) || ( ( buffer == NULL ) && ( entry->length > 0 ) ) )
+    {
+        return SMTC_KV_STORE_STATUS_BAD_PARAMETERS;
+    }
+
+    return smtc_kv_store_nvm_read( store, entry->offset + SMTC_KV_STORE_RECORD_HEADER_SIZE, buffer, entry->length );
+}
+
+smtc_kv_store_status_t smtc_kv_store_write( smtc_kv_store_t* store, uint16_t key, const uint8_t* value,
+                                            uint16_t length )
+{
+    const smtc_kv_store_index_entry_t* entry;
+    smtc_kv_store_record_header_t      header;
+    uint32_t                           live_bytes;
+    uint32_t                           record_offset;
+    smtc_kv_store_status_t             status;
+
+    if( ( store == NULL ) || ( store->is_init == false ) )
+    {
+        return SMTC_KV_STORE_STATUS_NOT_INIT;
+    }
+
+    if( ( key == SMTC_KV_STORE_KEY_INVALID ) || ( length > SMTC_KV_STORE_VALUE_LENGTH_MAX ) ||
+        ( ( value == NULL ) && ( length > 0 ) ) ||
+        ( SMTC_KV_STORE_RECORD_SIZE( length ) > ( store->sector_size - SMTC_KV_STORE_SECTOR_HEADER_SIZE ) ) )
+    {
+        return SMTC_KV_STORE_STATUS_BAD_PARAMETERS;
+    }
+
+    header.key      = key;
+    header.length   = length;
+    header.data_crc = smtc_kv_store_crc16( 0xFFFF, value, length );
+
+    entry      = smtc_kv_store_index_find( store, key );
+    live_bytes = store->stats.live_bytes + SMTC_KV_STORE_RECORD_SIZE( length );
+    if( entry != NULL )
+    {
+        smtc_kv_store_record_header_t stored_header;
+
+        /* Rewriting the same value would only wear the flash */
+        status = smtc_kv_store_nvm_read( store, entry->offset, &stored_header, sizeof( stored_header ) );
+        if( ( status == SMTC_KV_STORE_STATUS_OK ) && ( entry->length == length ) &&
+            ( stored_header.data_crc == header.data_crc ) )
+        {
+            uint8_t  chunk[SMTC_KV_STORE_CHUNK_SIZE];
+            uint32_t i;
+
+            for( i = 0; i < length; i += sizeof( chunk ) )
+            {
+                const uint32_t chunk_length = ( ( length - i ) < sizeof( chunk ) ) ? ( length - i ) : sizeof( chunk );
+
+                if( ( smtc_kv_store_nvm_read( store, entry->offset + SMTC_KV_STORE_RECORD_HEADER_SIZE + i, chunk,
+                                              chunk_length ) != SMTC_KV_STORE_STATUS_OK ) ||
+                    ( memcmp( chunk, &value[i], chunk_length ) != 0 ) )
+                {
+                    break;
+                }
+            }
+
+            if( i >= length )
+            {
+                return SMTC_KV_STORE_STATUS_OK;
+            }
+        }
+
+        live_bytes -= SMTC_KV_STORE_RECORD_SIZE( entry->length );
+    }
+    else if( store->stats.nb_keys >= SMTC_KV_STORE_NB_KEYS_MAX )
+    {
+        return SMTC_KV_STORE_STATUS_NO_SPACE;
+    }
+
+    if( live_bytes > store->stats.capacity_bytes )
+    {
+        return SMTC_KV_STORE_STATUS_NO_SPACE;
+    }
+
+    header.header_crc = smtc_kv_store_record_header_crc( &header );
+
+    status = smtc_kv_store_append( store, &header, value, 0, false, &record_offset );
+    if( status != SMTC_KV_STORE_STATUS_OK )
+    {
+        return status;
+    }
+    store->stats.user_bytes_written += SMTC_KV_STORE_RECORD_SIZE( length );
+
+    return smtc_kv_store_index_put( store, key, length, record_offset );
+}
+
+smtc_kv_store_status_t smtc_kv_store_delete( smtc_kv_store_t* store, uint16_t key )
+{
+    smtc_kv_store_record_header_t header;
+    uint32_t                      record_offset;
+    smtc_kv_store_status_t        status;
+
+    if( ( store == NULL ) || ( store->is_init == false ) )
+    {
+        return SMTC_KV_STORE_STATUS_NOT_INIT;
+    }
+
+    if( smtc_kv_store_index_find( store, key ) == NULL )
+    {
+        return SMTC_KV_STORE_STATUS_NOT_FOUND;
+    }
+
+    header.key        = key;
+    header.length     = SMTC_KV_STORE_RECORD_TOMBSTONE;
+    header.data_crc   = smtc_kv_store_crc16( 0xFFFF, NULL, 0 );
+    header.header_crc = smtc_kv_store_record_header_crc( &header );
+
+    status = smtc_kv_store_append( store, &header, NULL, 0, false, &record_offset );
+    if( status != SMTC_KV_STORE_STATUS_OK )
+    {
+        return status;
+    }
+    store->stats.user_bytes_written += SMTC_KV_STORE_RECORD_HEADER_SIZE;
+
+    smtc_kv_store_index_remove( store, key );
+
+    return SMTC_KV_STORE_STATUS_OK;
+}
+
+bool smtc_kv_store_process( smtc_kv_store_t* store )
+{
+    if( ( store == NULL ) || ( store->is_init == false ) )
+    {
+        return false;
+    }
+
+    /* Only compact when running low on erased sectors, and when it reclaims at least one sector worth of space */
+    if( ( store->nb_free_sectors >= SMTC_KV_STORE_FREE_SECTORS_TARGET ) && ( store->compaction_offset == 0 ) )
+    {
+        return false;
+    }
+
+    if( ( store->compaction_offset == 0 ) &&
+        ( smtc_kv_store_get_reclaimable_bytes( store ) < ( store->sector_size - SMTC_KV_STORE_SECTOR_HEADER_SIZE ) ) )
+    {
+        return false;
+    }
+
+    return smtc_kv_store_compact_step( store ) == SMTC_KV_STORE_STATUS_OK;
+}
+
+void smtc_kv_store_get_stats( const smtc_kv_store_t* store, smtc_kv_store_stats_t* stats )
+{
+    *stats                        = store->stats;
+    stats->nb_free_sectors        = store->nb_free_sectors;
+    stats->sector_erase_count_min = store->sector_erase_count[0];
+    stats->sector_erase_count_max = store->sector_erase_count[0];
+
+    for( uint8_t sector = 1; sector < store->nb_sectors; sector++ )
+    {
+        if( store->sector_erase_count[sector] < stats->sector_erase_count_min )
+        {
+            stats->sector_erase_count_min = store->sector_erase_count[sector];
+        }
+        if( store->sector_erase_count[sector] > stats->sector_erase_count_max )
+        {
+            stats->sector_erase_count_max = store->sector_erase_count[sector];
+        }
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint16_t smtc_kv_store_crc16( uint16_t crc, const uint8_t* buffer, uint32_t length )
+{
+    for( uint32_t i = 0; i < length; i++ )
+    {
+        crc = ( crc << 4 ) ^ crc16_nibble_lut[( crc >> 12 ) ^ ( buffer[i] >> 4 )];
+        crc = ( crc << 4 ) ^ crc16_nibble_lut[( crc >> 12 ) ^ ( buffer[i] & 0x0F )];
+    }
+
+    return crc;
+}
+
+static uint16_t smtc_kv_store_record_header_crc( const smtc_kv_store_record_header_t* header )
+{
+    return smtc_kv_store_crc16( 0xFFFF, ( const uint8_t* ) header,
+                                offsetof( smtc_kv_store_record_header_t, header_crc ) );
+}
+
+static uint16_t smtc_kv_store_sector_header_crc( const smtc_kv_store_sector_header_t* header )
+{
+    return smtc_kv_store_crc16( 0xFFFF, ( const uint8_t* ) header, offsetof( smtc_kv_store_sector_header_t, crc ) );
+}
+
+static smtc_kv_store_status_t smtc_kv_store_nvm_read( const smtc_kv_store_t* store, uint32_t offset, void* buffer,
+                                                      uint32_t length )
+{
+    if( length == 0 )
+    {
+        return SMTC_KV_STORE_STATUS_OK;
+    }
+
+    return ( smtc_hal_mcu_nvm_read( store->nvm, offset, ( uint8_t* ) buffer, length ) == SMTC_HAL_MCU_STATUS_OK )
+               ? SMTC_KV_STORE_STATUS_OK
+               : SMTC_KV_STORE_STATUS_ERROR;
+}
+
+static smtc_kv_store_status_t smtc_kv_store_nvm_write( smtc_kv_store_t* store, uint32_t offset, const void* buffer,
+                                                       uint32_t length )
+{
+    if( length == 0 )
+    {
+        return SMTC_KV_STORE_STATUS_OK;
+    }
+
+    if( smtc_hal_mcu_nvm_write( store->nvm, offset, ( const uint8_t* ) buffer, length ) != SMTC_HAL_MCU_STATUS_OK )
+    {
+        return SMTC_KV_STORE_STATUS_ERROR;
+    }
+    store->stats.nvm_bytes_written += SMTC_KV_STORE_ALIGN( length );
+
+    return SMTC_KV_STORE_STATUS_OK;
+}
+
+static bool smtc_kv_store_is_blank( const smtc_kv_store_t* store, uint32_t offset, uint32_t length )
+{
+    uint8_t chunk[SMTC_KV_STORE_CHUNK_SIZE];
+
+    for( uint32_t i = 0; i < length; i += sizeof( chunk ) )
+    {
+        const uint32_t chunk_length = ( ( length - i ) < sizeof( chunk ) ) ? ( length - i ) : sizeof( chunk );
+
+        if( smtc_kv_store_nvm_read( store, offset + i, chunk, chunk_length ) != SMTC_KV_STORE_STATUS_OK )
+        {
+            return false;
+        }
+
+        for( uint32_t j = 0; j < chunk_length; j++ )
+        {
+            if( chunk[j] != 0xFF )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static smtc_kv_store_status_t smtc_kv_store_nvm_crc16( const smtc_kv_store_t* store, uint32_t offset, uint32_t length,
+                                                       uint16_t* crc )
+{
+    uint8_t chunk[SMTC_KV_STORE_CHUNK_SIZE];
+
+    *crc = 0xFFFF;
+    for( uint32_t i = 0; i < length; i += sizeof( chunk ) )
+    {
+        const uint32_t chunk_length = ( ( length - i ) < sizeof( chunk ) ) ? ( length - i ) : sizeof( chunk );
+
+        if( smtc_kv_store_nvm_read( store, offset + i, chunk, chunk_length ) != SMTC_KV_STORE_STATUS_OK )
+        {
+            return SMTC_KV_STORE_STATUS_ERROR;
+        }
+        *crc = smtc_kv_store_crc16( *crc, chunk, chunk_length );
+    }
+
+    return SMTC_KV_STORE_STATUS_OK;
+}
+
+static smtc_kv_store_status_t smtc_kv_store_erase_sector( smtc_kv_store_t* store, uint8_t sector )
+{
+    if( smtc_hal_mcu_nvm_erase( store->nvm, sector * store->sector_size, store->sector_size ) !=
+        SMTC_HAL_MCU_STATUS_OK )
+    {
+        return SMTC_KV_STORE_STATUS_ERROR;
+    }
+
+    store->sector_erase_count[sector]++;
+    store->stats.nb_sectors_erased++;
+
+    return SMTC_KV_STORE_STATUS_OK;
+}
+
+static bool smtc_kv_store_read_sector_header( const smtc_kv_store_t* store, uint8_t sector,
+                                              smtc_kv_store_sector_header_t* header )
+{
+    if( smtc_kv_store_nvm_read( store, sector * store->sector_size, header, sizeof( *header ) ) !=
+        SMTC_KV_STORE_STATUS_OK )
+    {
+        return false;
+    }
+
+    return ( header->magic == SMTC_KV_STORE_SECTOR_MAGIC ) &&
+           ( header->crc == smtc_kv_store_sector_header_crc( header ) );
+}
+
+static smtc_kv_store_status_t smtc_kv_store_open_next_sector( smtc_kv_store_t* store )
+{
+    const uint8_t                 next_sector = ( store->head_sector + 1 ) % store->nb_sectors;
+    smtc_kv_store_sector_header_t header;
+    smtc_kv_store_status_t        status;
+
+    if( store->nb_free_sectors == 0 )
+    {
+        return SMTC_KV_STORE_STATUS_NO_SPACE;
+    }
+
+    header.magic       = SMTC_KV_STORE_SECTOR_MAGIC;
+    header.sequence    = store->head_sequence + 1;
+    header.erase_count = store->sector_erase_count[next_sector];
+    header.crc         = smtc_kv_store_sector_header_crc( &header );
+    header.reserved    = 0xFFFF;
+
+    status = smtc_kv_store_nvm_write( store, next_sector * store->sector_size, &header, sizeof( header ) );
+    if( status != SMTC_KV_STORE_STATUS_OK )
+    {
+        return status;
+    }
+
+    store->head_sector   = next_sector;
+    store->head_sequence = header.sequence;
+    store->write_offset  = SMTC_KV_STORE_SECTOR_HEADER_SIZE;
+    store->nb_free_sectors--;
+
+    return SMTC_KV_STORE_STATUS_OK;
+}
+
+static smtc_kv_store_status_t smtc_kv_store_make_room( smtc_kv_store_t* store, uint32_t record_size,
+                                                       bool use_reserve )
+{
+    uint32_t               nb_erasures = store->stats.nb_sectors_erased;
+    smtc_kv_store_status_t status;
+
+    /* Once compaction has used the reserve, the rest of the head sector belongs to it until the tail is erased */
+    while( ( use_reserve == false ) && ( store->nb_free_sectors == 0 ) )
+    {
+        status = smtc_kv_store_compact_step( store );
+        if( status != SMTC_KV_STORE_STATUS_OK )
+        {
+            return status;
+        }
+    }
+
+    while( ( store->write_offset + record_size ) > store->sector_size )
+    {
+        if( store->nb_free_sectors > ( use_reserve ? 0 : 1 ) )
+        {
+            status = smtc_kv_store_open_next_sector( store );
+        }
+        else if( use_reserve == true )
+        {
+            status = SMTC_KV_STORE_STATUS_NO_SPACE;
+        }
+        else if( ( store->stats.nb_sectors_erased - nb_erasures ) > store->nb_sectors )
+        {
+            /* A full round of compaction did not free anything */
+            status = SMTC_KV_STORE_STATUS_NO_SPACE;
+        }
+        else
+        {
+            status = smtc_kv_store_compact_step( store );
+        }
+
+        if( status != SMTC_KV_STORE_STATUS_OK )
+        {
+            return status;
+        }
+    }
+
+    return SMTC_KV_STORE_STATUS_OK;
+}
+
+static smtc_kv_store_status_t smtc_kv_store_append( smtc_kv_store_t* store, const smtc_kv_store_record_header_t* header,
+                                                    const uint8_t* value, uint32_t value_offset, bool use_reserve,
+                                                    uint32_t* record_offset )
+{
+    const uint32_t         length = header->length & ~SMTC_KV_STORE_RECORD_TOMBSTONE;
+    uint32_t               offset;
+    smtc_kv_store_status_t status;
+
+    status = smtc_kv_store_make_room( store, SMTC_KV_STORE_RECORD_SIZE( length ), use_reserve );
+    if( status != SMTC_KV_STORE_STATUS_OK )
+    {
+        return status;
+    }
+
+    offset = ( store->head_sector * store->sector_size ) + store->write_offset;
+
+    /* Consume the space first: whatever happens next, this area has been written to */
+    store->write_offset += SMTC_KV_STORE_RECORD_SIZE( length );
+
+    status = smtc_kv_store_nvm_write( store, offset, header, sizeof( *header ) );
+    if( status != SMTC_KV_STORE_STATUS_OK )
+    {
+        return status;
+    }
+
+    if( value != NULL )
+    {
+        status = smtc_kv_store_nvm_write( store, offset + SMTC_KV_STORE_RECORD_HEADER_SIZE, value, length );
+    }
+    else
+    {
+        uint8_t chunk[SMTC_KV_STORE_CHUNK_SIZE];
+
+        for( uint32_t i = 0; ( i < length ) && ( status == SMTC_KV_STORE_STATUS_OK ); i += sizeof( chunk ) )
+        {
+            const uint32_t chunk_length = ( ( length - i ) < sizeof( chunk ) ) ? ( length - i ) : sizeof( chunk );
+
+            status = smtc_kv_store_nvm_read( store, value_offset + i, chunk, chunk_length );
+            if( status == SMTC_KV_STORE_STATUS_OK )
+            {
+                status = smtc_kv_store_nvm_write( store, offset + SMTC_KV_STORE_RECORD_HEADER_SIZE + i, chunk,
+                                                  chunk_length );
+            }
+        }
+    }
+
+    *record_offset = offset;
+
+    return status;
+}
+
+static smtc_kv_store_status_t smtc_kv_store_compact_step( smtc_kv_store_t* store )
+{
+    const uint32_t         sector_offset = store->tail_sector * store->sector_size;
+    smtc_kv_store_status_t status;
+
+    if( store->tail_sector == store->head_sector )
+    {
+        return SMTC_KV_STORE_STATUS_NO_SPACE;
+    }
+
+    if( store->compaction_offset == 0 )
+    {
+        store->compaction_offset = SMTC_KV_STORE_SECTOR_HEADER_SIZE;
+    }
+
+    while( ( store->compaction_offset + SMTC_KV_STORE_RECORD_HEADER_SIZE ) <= store->sector_size )
+    {
+        const uint32_t                     offset = sector_offset + store->compaction_offset;
+        smtc_kv_store_record_header_t      header;
+        const smtc_kv_store_index_entry_t* entry;
+        uint32_t                           record_offset;
+
+        status = smtc_kv_store_nvm_read( store, offset, &header, sizeof( header ) );
+        if( status != SMTC_KV_STORE_STATUS_OK )
+        {
+            return status;
+        }
+
+        if( ( header.key == SMTC_KV_STORE_KEY_INVALID ) ||
+            ( header.header_crc != smtc_kv_store_record_header_crc( &header ) ) )
+        {
+            if( smtc_kv_store_is_blank( store, offset, sizeof( header ) ) == true )
+            {
+                /* End of the records of the sector */
+                break;
+            }
+
+            /* Header interrupted by a reset, see smtc_kv_store_replay_sector */
+            store->compaction_offset += SMTC_KV_STORE_RECORD_HEADER_SIZE;
+            continue;
+        }
+        store->compaction_offset += SMTC_KV_STORE_RECORD_SIZE( header.length & ~SMTC_KV_STORE_RECORD_TOMBSTONE );
+
+        /* Only the record the index points to is live: older values and removals are dropped */
+        entry = smtc_kv_store_index_find( store, header.key );
+        if( ( entry == NULL ) || ( entry->offset != offset ) )
+        {
+            continue;
+        }
+
+        status = smtc_kv_store_append( store, &header, NULL, offset + SMTC_KV_STORE_RECORD_HEADER_SIZE, true,
+                                       &record_offset );
+        if( status != SMTC_KV_STORE_STATUS_OK )
+        {
+            return status;
+        }
+        store->stats.nb_records_compacted++;
+
+        return smtc_kv_store_index_put( store, header.key, header.length, record_offset );
+    }
+
+    /* The live records have all been copied, and will be found first on the next initialisation */
+    status = smtc_kv_store_erase_sector( store, store->tail_sector );
+    if( status != SMTC_KV_STORE_STATUS_OK )
+    {
+        return status;
+    }
+
+    store->tail_sector       = ( store->tail_sector + 1 ) % store->nb_sectors;
+    store->compaction_offset = 0;
+    store->nb_free_sectors++;
+
+    return SMTC_KV_STORE_STATUS_OK;
+}
+
+static uint32_t smtc_kv_store_get_reclaimable_bytes( const smtc_kv_store_t* store )
+{
+    const uint32_t nb_full_sectors = ( store->nb_sectors - store->nb_free_sectors ) - 1;
+    const uint32_t used_bytes      = ( nb_full_sectors * ( store->sector_size - SMTC_KV_STORE_SECTOR_HEADER_SIZE ) ) +
+                                ( store->write_offset - SMTC_KV_STORE_SECTOR_HEADER_SIZE );
+
+    return ( used_bytes > store->stats.live_bytes ) ? ( used_bytes - store->stats.live_bytes ) : 0;
+}
+
+static smtc_kv_store_status_t smtc_kv_store_replay_sector( smtc_kv_store_t* store, uint8_t sector,
+                                                           uint32_t* end_offset )
+{
+    const uint32_t         sector_offset = sector * store->sector_size;
+    uint32_t               offset        = SMTC_KV_STORE_SECTOR_HEADER_SIZE;
+    smtc_kv_store_status_t status;
+
+    while( ( offset + SMTC_KV_STORE_RECORD_HEADER_SIZE ) <= store->sector_size )
+    {
+        smtc_kv_store_record_header_t header;
+        uint32_t                      length;
+        uint16_t                      data_crc;
+
+        status = smtc_kv_store_nvm_read( store, sector_offset + offset, &header, sizeof( header ) );
+        if( status != SMTC_KV_STORE_STATUS_OK )
+        {
+            return status;
+        }
+
+        if( ( header.key == SMTC_KV_STORE_KEY_INVALID ) ||
+            ( header.header_crc != smtc_kv_store_record_header_crc( &header ) ) )
+        {
+            if( smtc_kv_store_is_blank( store, sector_offset + offset, sizeof( header ) ) == true )
+            {
+                /* Erased end of the sector */
+                break;
+            }
+
+            /* A header interrupted by a reset: nothing was written after it, the next record follows it */
+            offset += SMTC_KV_STORE_RECORD_HEADER_SIZE;
+            continue;
+        }
+
+        length = header.length & ~SMTC_KV_STORE_RECORD_TOMBSTONE;
+        if( ( offset + SMTC_KV_STORE_RECORD_SIZE( length ) ) > store->sector_size )
+        {
+            offset = store->sector_size;
+            break;
+        }
+
+        status = smtc_kv_store_nvm_crc16( store, sector_offset + offset + SMTC_KV_STORE_RECORD_HEADER_SIZE, length,
+                                          &data_crc );
+        if( status != SMTC_KV_STORE_STATUS_OK )
+        {
+            return status;
+        }
+
+        /* A record whose data does not match was interrupted by a reset and never committed */
+        if( data_crc == header.data_crc )
+        {
+            if( ( header.length & SMTC_KV_STORE_RECORD_TOMBSTONE ) != 0 )
+            {
+                smtc_kv_store_index_remove( store, header.key );
+            }
+            else
+            {
+                status = smtc_kv_store_index_put( store, header.key, header.length, sector_offset + offset );
+                if( status != SMTC_KV_STORE_STATUS_OK )
+                {
+                    return status;
+                }
+            }
+        }
+
+        offset += SMTC_KV_STORE_RECORD_SIZE( length );
+    }
+
+    *end_offset = offset;
+
+    return SMTC_KV_STORE_STATUS_OK;
+}
+
+static uint32_t smtc_kv_store_index_hash( uint16_t key )
+{
+    return ( ( uint32_t ) key * 0x9E3779B1U ) >> ( 32 - SMTC_KV_STORE_INDEX_BITS );
+}
+
+static smtc_kv_store_index_entry_t* smtc_kv_store_index_find( const smtc_kv_store_t* store, uint16_t key )
+{
+    uint32_t slot = smtc_kv_store_index_hash( key );
+
+    while( store->index[slot].key != SMTC_KV_STORE_KEY_INVALID )
+    {
+        if( store->index[slot].key == key )
+        {
+            return ( smtc_kv_store_index_entry_t* ) &store->index[slot];
+        }
+        slot = ( slot + 1 ) & ( SMTC_KV_STORE_INDEX_SIZE - 1 );
+    }
+
+    return NULL;
+}
+
+static smtc_kv_store_status_t smtc_kv_store_index_put( smtc_kv_store_t* store, uint16_t key, uint16_t length,
+                                                       uint32_t offset )
+{
+    smtc_kv_store_index_entry_t* entry = smtc_kv_store_index_find( store, key );
+
+    if( entry != NULL )
+    {
+        store->stats.live_bytes -= SMTC_KV_STORE_RECORD_SIZE( entry->length );
+    }
+    else
+    {
+        uint32_t slot = smtc_kv_store_index_hash( key );
+
+        if( store->stats.nb_keys >= SMTC_KV_STORE_NB_KEYS_MAX )
+        {
+            return SMTC_KV_STORE_STATUS_NO_SPACE;
+        }
+
+        while( store->index[slot].key != SMTC_KV_STORE_KEY_INVALID )
+        {
+            slot = ( slot + 1 ) & ( SMTC_KV_STORE_INDEX_SIZE - 1 );
+        }
+
+        entry      = &store->index[slot];
+        entry->key = key;
+        store->stats.nb_keys++;
+    }
+
+    entry->length = length;
+    entry->offset = offset;
+    store->stats.live_bytes += SMTC_KV_STORE_RECORD_SIZE( length );
+
+    return SMTC_KV_STORE_STATUS_OK;
+}
+
+static void smtc_kv_store_index_remove( smtc_kv_store_t* store, uint16_t key )
+{
+    smtc_kv_store_index_entry_t* entry = smtc_kv_store_index_find( store, key );
+    uint32_t                     hole;
+    uint32_t                     slot;
+
+    if( entry == NULL )
+    {
+        return;
+    }
+
+    store->stats.live_bytes -= SMTC_KV_STORE_RECORD_SIZE( entry->length );
+    store->stats.nb_keys--;
+
+    /* Shift back the following entries of the probe sequence so that lookups never need tombstones */
+    hole = ( uint32_t ) ( entry - store->index );
+    slot = hole;
+    while( true )
+    {
+        uint32_t home;
+
+        slot = ( slot + 1 ) & ( SMTC_KV_STORE_INDEX_SIZE - 1 );
+        if( store->index[slot].key == SMTC_KV_STORE_KEY_INVALID )
+        {
+            break;
+        }
+
+        /* The entry can fill the hole unless its home slot lies cyclically in ( hole, slot ] */
+        home = smtc_kv_store_index_hash( store->index[slot].key );
+        if( ( ( slot > hole ) && ( ( home <= hole ) || ( home > slot ) ) ) ||
+            ( ( slot < hole ) && ( home <= hole ) && ( home > slot ) ) )
+        {
+            store->index[hole] = store->index[slot];
+            hole               = slot;
+        }
+    }
+
+    store->index[hole].key = SMTC_KV_STORE_KEY_INVALID;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,287 @@
+/**
+ * @file      smtc_kv_store.h
+ *
+ * @brief      Log-structured key-value store on top of the NVM HAL
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMTC_KV_STORE_H
+#define SMTC_KV_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "smtc_hal_mcu_nvm.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/**
+ * @brief Number of bits of the RAM index, which holds up to half of 2^bits keys
+ */
+#ifndef SMTC_KV_STORE_INDEX_BITS
+#define SMTC_KV_STORE_INDEX_BITS 7
+#endif
+
+/**
+ * @brief Maximum number of sectors the NVM area can be split into
+ */
+#ifndef SMTC_KV_STORE_NB_SECTORS_MAX
+#define SMTC_KV_STORE_NB_SECTORS_MAX 32
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Number of entries of the RAM index
+ */
+#define SMTC_KV_STORE_INDEX_SIZE ( 1 << SMTC_KV_STORE_INDEX_BITS )
+
+/**
+ * @brief Maximum number of keys that can be stored
+ *
+ * @remark The index is kept at most half full to bound the length of the probe sequences
+ */
+#define SMTC_KV_STORE_NB_KEYS_MAX ( SMTC_KV_STORE_INDEX_SIZE / 2 )
+
+/**
+ * @brief Key value reserved to mark erased records and free index entries
+ */
+#define SMTC_KV_STORE_KEY_INVALID 0xFFFF
+
+/**
+ * @brief Maximum length of a value
+ */
+#define SMTC_KV_STORE_VALUE_LENGTH_MAX 0x7FFF
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Key-value store status codes
+ */
+typedef enum smtc_kv_store_status_e
+{
+    SMTC_KV_STORE_STATUS_OK = 0,          //!< Operation completed successfully
+    SMTC_KV_STORE_STATUS_NOT_FOUND,       //!< The key is not in the store
+    SMTC_KV_STORE_STATUS_NO_SPACE,        //!< Not enough space left, even after compaction
+    SMTC_KV_STORE_STATUS_BAD_PARAMETERS,  //!< At least one parameter has an incorrect value
+    SMTC_KV_STORE_STATUS_NOT_INIT,        //!< The store is not initialised
+    SMTC_KV_STORE_STATUS_ERROR,           //!< The NVM reported an error
+} smtc_kv_store_status_t;
+
+/**
+ * @brief Key-value store configuration
+ *
+ * @remark sector_size has to be a multiple of the NVM erase size, and the NVM has to hold at least 3 sectors: one is
+ * kept erased so that compaction can always make progress
+ */
+typedef struct smtc_kv_store_cfg_s
+{
+    smtc_hal_mcu_nvm_inst_t nvm;          //!< NVM instance backing the store
+    uint32_t                sector_size;  //!< Size of a sector, in bytes
+} smtc_kv_store_cfg_t;
+
+/**
+ * @brief Key-value store statistics
+ */
+typedef struct smtc_kv_store_stats_s
+{
+    uint32_t nb_keys;                  //!< Number of keys currently stored
+    uint32_t live_bytes;               //!< Space used by the latest record of each key, headers included
+    uint32_t capacity_bytes;           //!< Maximum value of live_bytes
+    uint32_t user_bytes_written;       //!< Bytes of records written on request of the user
+    uint32_t nvm_bytes_written;        //!< Bytes written to the NVM, compaction and sector headers included
+    uint32_t nb_records_compacted;     //!< Number of live records copied by the compaction
+    uint32_t nb_sectors_erased;        //!< Number of sector erasures since the initialisation
+    uint32_t sector_erase_count_min;   //!< Lowest erase count of all sectors
+    uint32_t sector_erase_count_max;   //!< Highest erase count of all sectors
+    uint32_t nb_free_sectors;          //!< Number of erased sectors ready to be written
+} smtc_kv_store_stats_t;
+
+/**
+ * @brief Entry of the RAM index
+ */
+typedef struct smtc_kv_store_index_entry_s
+{
+    uint16_t key;     //!< Key, SMTC_KV_STORE_KEY_INVALID if the entry is free
+    uint16_t length;  //!< Length of the value
+    uint32_t offset;  //!< Offset in NVM of the record holding the value
+} smtc_kv_store_index_entry_t;
+
+/**
+ * @brief Key-value store instance
+ *
+ * @remark Allocated by the caller, all fields are private
+ */
+typedef struct smtc_kv_store_s
+{
+    bool                        is_init;
+    smtc_hal_mcu_nvm_inst_t     nvm;
+    uint32_t                    sector_size;
+    uint8_t                     nb_sectors;
+    uint8_t                     head_sector;
+    uint8_t                     tail_sector;
+    uint8_t                     nb_free_sectors;
+    uint32_t                    head_sequence;
+    uint32_t                    write_offset;
+    uint32_t                    compaction_offset;
+    uint32_t                    sector_erase_count[SMTC_KV_STORE_NB_SECTORS_MAX];
+    smtc_kv_store_index_entry_t index[SMTC_KV_STORE_INDEX_SIZE];
+    smtc_kv_store_stats_t       stats;
+} smtc_kv_store_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Mount the store, or format the NVM if it does not hold a store yet
+ *
+ * The records of all sectors are replayed, oldest first, to rebuild the RAM index. Records interrupted by a reset are
+ * discarded.
+ *
+ * @param [out] store Key-value store instance
+ * @param [in] cfg Configuration
+ *
+ * @retval SMTC_KV_STORE_STATUS_OK The store is ready
+ * @retval SMTC_KV_STORE_STATUS_BAD_PARAMETERS The configuration does not fit the NVM
+ * @retval SMTC_KV_STORE_STATUS_NO_SPACE The NVM holds more keys than the RAM index
+ * @retval SMTC_KV_STORE_STATUS_ERROR The NVM reported an error
+ */
+smtc_kv_store_status_t smtc_kv_store_init( smtc_kv_store_t* store, const smtc_kv_store_cfg_t* cfg );
+
+/**
+ * @brief Erase all keys
+ *
+ * @param [in, out] store Key-value store instance
+ *
+ * @retval SMTC_KV_STORE_STATUS_OK The store is empty
+ * @retval SMTC_KV_STORE_STATUS_NOT_INIT The store is not initialised
+ * @retval SMTC_KV_STORE_STATUS_ERROR The NVM reported an error
+ */
+smtc_kv_store_status_t smtc_kv_store_format( smtc_kv_store_t* store );
+
+/**
+ * @brief Read the value of a key
+ *
+ * @param [in] store Key-value store instance
+ * @param [in] key Key
+ * @param [out] buffer Buffer to store the value
+ * @param [in] size Size of the buffer
+ * @param [out] length Length of the value, can be NULL. Set even if the buffer is too small
+ *
+ * @retval SMTC_KV_STORE_STATUS_OK The value has been read
+ * @retval SMTC_KV_STORE_STATUS_NOT_FOUND The key is not in the store
+ * @retval SMTC_KV_STORE_STATUS_BAD_PARAMETERS The buffer is too small to hold the value
+ * @retval SMTC_KV_STORE_STATUS_NOT_INIT The store is not initialised
+ * @retval SMTC_KV_STORE_STATUS_ERROR The NVM reported an error
+ */
+smtc_kv_store_status_t smtc_kv_store_read( const smtc_kv_store_t* store, uint16_t key, uint8_t* buffer, uint16_t size,
+                                           uint16_t* length );
+
+/**
+ * @brief Write the value of a key
+ *
+ * The record is appended to the log and becomes the value of the key only once entirely written, so a reset during the
+ * write leaves the previous value in place. Compaction is run first if there is not enough erased space left.
+ *
+ * @param [in, out] store Key-value store instance
+ * @param [in] key Key, any value but SMTC_KV_STORE_KEY_INVALID
+ * @param [in] value Value
+ * @param [in] length Length of the value, at most SMTC_KV_STORE_VALUE_LENGTH_MAX
+ *
+ * @retval SMTC_KV_STORE_STATUS_OK The value has been written
+ * @retval SMTC_KV_STORE_STATUS_NO_SPACE The store is full
+ * @retval SMTC_KV_STORE_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
+ * @retval SMTC_KV_STORE_STATUS_NOT_INIT The store is not initialised
+ * @retval SMTC_KV_STORE_STATUS_ERROR The NVM reported an error
+ */
+smtc_kv_store_status_t smtc_kv_store_write( smtc_kv_store_t* store, uint16_t key, const uint8_t* value,
+                                            uint16_t length );
+
+/**
+ * @brief Remove a key
+ *
+ * @param [in, out] store Key-value store instance
+ * @param [in] key Key
+ *
+ * @retval SMTC_KV_STORE_STATUS_OK The key has been removed
+ * @retval SMTC_KV_STORE_STATUS_NOT_FOUND The key is not in the store
+ * @retval SMTC_KV_STORE_STATUS_NO_SPACE There is no space left to log the removal
+ * @retval SMTC_KV_STORE_STATUS_NOT_INIT The store is not initialised
+ * @retval SMTC_KV_STORE_STATUS_ERROR The NVM reported an error
+ */
+smtc_kv_store_status_t smtc_kv_store_delete( smtc_kv_store_t* store, uint16_t key );
+
+/**
+ * @brief Run one step of background compaction
+ *
+ * Copies at most one live record out of the oldest sector, or erases it once it only holds stale records. Meant to be
+ * called from the application main loop so that writes rarely have to compact.
+ *
+ * @param [in, out] store Key-value store instance
+ *
+ * @retval true Some work has been done, more may be pending
+ * @retval false Nothing to do
+ */
+bool smtc_kv_store_process( smtc_kv_store_t* store );
+
+/**
+ * @brief Get the statistics of the store
+ *
+ * @param [in] store Key-value store instance
+ * @param [out] stats Statistics
+ */
+void smtc_kv_store_get_stats( const smtc_kv_store_t* store, smtc_kv_store_stats_t* stats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SMTC_KV_STORE_H
+
+/* --- EOF ------------------------------------------------------------------ */
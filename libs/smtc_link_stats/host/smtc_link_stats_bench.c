@@ -0,0 +1,265 @@
+/**
+ * @file      smtc_link_stats_bench.c
+ *
+ * @brief      Host check of the link statistics quantile estimator against exact quantiles, and its cost
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "smtc_link_stats.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Synthetic distribution
+ */
+typedef struct bench_distribution_s
+{
+    const char* name;
+    int32_t ( *draw )( void );
+} bench_distribution_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static uint64_t prng_state = 0x9E3779B97F4A7C15u;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static uint64_t bench_get_time_in_ns( void );
+static double   bench_uniform( void );
+static double   bench_gaussian( double mean, double sigma );
+static int32_t  bench_draw_rssi( void );
+static int32_t  bench_draw_snr( void );
+static int32_t  bench_draw_two_paths( void );
+static int32_t  bench_draw_inter_arrival( void );
+static int      bench_compare( const void* a, const void* b );
+static void     bench_run( const bench_distribution_t* distribution, uint32_t nb_values );
+
+/**
+ * @brief Distributions of the check: RSSI and SNR of a fading link, a two-path RSSI and exponential inter-arrivals
+ */
+static const bench_distribution_t distributions[] = {
+    { "rssi_dbm", bench_draw_rssi },
+    { "snr_db", bench_draw_snr },
+    { "two_paths_dbm", bench_draw_two_paths },
+    { "inter_arrival_ms", bench_draw_inter_arrival },
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( int argc, char** argv )
+{
+    uint32_t nb_values = 1000000;
+    int      opt;
+
+    while( ( opt = getopt( argc, argv, "n:" ) ) != -1 )
+    {
+        switch( opt )
+        {
+        case 'n':
+            nb_values = strtoul( optarg, NULL, 0 );
+            break;
+        default:
+            fprintf( stderr, "usage: %s [-n values per distribution]\n", argv[0] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    if( nb_values == 0 )
+    {
+        return EXIT_FAILURE;
+    }
+
+    printf( "%u values per distribution, %u markers, %u bytes per metric\n\n", nb_values, SMTC_LINK_STATS_NB_MARKERS,
+            ( unsigned int ) sizeof( smtc_link_stats_metric_t ) );
+    printf( "%-18s %-6s %10s %10s %10s %14s\n", "distribution", "p", "exact", "estimate", "rank err", "ns per value" );
+
+    for( unsigned int i = 0; i < sizeof( distributions ) / sizeof( distributions[0] ); i++ )
+    {
+        bench_run( &distributions[i], nb_values );
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint64_t bench_get_time_in_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ( uint64_t ) ts.tv_sec * 1000000000u + ( uint64_t ) ts.tv_nsec;
+}
+
+static double bench_uniform( void )
+{
+    // xorshift64*
+    prng_state ^= prng_state >> 12;
+    prng_state ^= prng_state << 25;
+    prng_state ^= prng_state >> 27;
+
+    return ( double ) ( ( prng_state * 0x2545F4914F6CDD1Du ) >> 11 ) / 9007199254740992.0;
+}
+
+static double bench_gaussian( double mean, double sigma )
+{
+    const double u = 1.0 - bench_uniform( );
+
+    return mean + sigma * sqrt( -2.0 * log( u ) ) * cos( 6.283185307179586 * bench_uniform( ) );
+}
+
+static int32_t bench_draw_rssi( void )
+{
+    return ( int32_t ) lround( bench_gaussian( -95.0, 6.0 ) );
+}
+
+static int32_t bench_draw_snr( void )
+{
+    return ( int32_t ) lround( bench_gaussian( 2.0, 4.0 ) );
+}
+
+static int32_t bench_draw_two_paths( void )
+{
+    // Direct path most of the time, a stronger reflected path otherwise
+    const double rssi_in_dbm =
+        ( bench_uniform( ) < 0.7 ) ? bench_gaussian( -110.0, 3.0 ) : bench_gaussian( -80.0, 3.0 );
+
+    return ( int32_t ) lround( rssi_in_dbm );
+}
+
+static int32_t bench_draw_inter_arrival( void )
+{
+    return ( int32_t ) lround( -250.0 * log( 1.0 - bench_uniform( ) ) );
+}
+
+static int bench_compare( const void* a, const void* b )
+{
+    const int32_t x = *( const int32_t* ) a;
+    const int32_t y = *( const int32_t* ) b;
+
+    return ( x > y ) - ( x < y );
+}
+
+/**
+ * @brief Feed a distribution to a metric, then compare each quantile estimate with the exact quantile
+ *
+ * The rank error is the fraction of the values between the estimate and the exact quantile, which stays meaningful
+ * for integer-valued data with many ties
+ */
+static void bench_run( const bench_distribution_t* distribution, uint32_t nb_values )
+{
+    smtc_link_stats_metric_t metric;
+    int32_t*                 values = malloc( nb_values * sizeof( int32_t ) );
+
+    if( values == NULL )
+    {
+        return;
+    }
+
+    for( uint32_t i = 0; i < nb_values; i++ )
+    {
+        values[i] = distribution->draw( );
+    }
+
+    smtc_link_stats_metric_init( &metric, -150, 4 );
+    const uint64_t start_in_ns = bench_get_time_in_ns( );
+    for( uint32_t i = 0; i < nb_values; i++ )
+    {
+        smtc_link_stats_metric_add( &metric, values[i] );
+    }
+    const double ns_per_value = ( double ) ( bench_get_time_in_ns( ) - start_in_ns ) / nb_values;
+
+    qsort( values, nb_values, sizeof( int32_t ), bench_compare );
+
+    for( unsigned int q = 0; q < SMTC_LINK_STATS_NB_QUANTILES; q++ )
+    {
+        const uint16_t p        = smtc_link_stats_get_quantile_in_per_mille( q );
+        const int32_t  exact    = values[( uint64_t ) ( nb_values - 1 ) * p / 1000];
+        const double   estimate = ( double ) smtc_link_stats_metric_get_quantile( &metric, q ) /
+                                ( 1 << SMTC_LINK_STATS_FRACTIONAL_BITS );
+        uint32_t below = 0;
+
+        // Rank of the estimate: values strictly below it, plus half of the ties
+        while( ( below < nb_values ) && ( values[below] < estimate ) )
+        {
+            below++;
+        }
+        uint32_t ties = below;
+        while( ( ties < nb_values ) && ( values[ties] <= estimate ) )
+        {
+            ties++;
+        }
+        const double rank_error = ( below + ( ties - below ) / 2.0 ) / nb_values - p / 1000.0;
+
+        printf( "%-18s %-6.3f %10d %10.2f %+9.2f%% %14.1f\n", distribution->name, p / 1000.0, exact, estimate,
+                100.0 * rank_error, ns_per_value );
+    }
+
+    free( values );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,396 @@
+/**
+ * @file      smtc_link_stats.c
+ *
+ * @brief      Fixed-memory link statistics: histograms and streaming quantiles of the received packets
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "smtc_link_stats.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Unit of the marker fractions: quantiles are in per mille, the middles between them in half per mille
+ */
+#define SMTC_LINK_STATS_FRACTION_ONE 2000
+
+/**
+ * @brief Default histograms: [-150, -22[ dBm in 4 dB bins, [-20, 12[ dB in 1 dB bins and [0, 3200[ ms in 100 ms bins
+ */
+#define SMTC_LINK_STATS_DEFAULT_RSSI_MIN_IN_DBM ( -150 )
+#define SMTC_LINK_STATS_DEFAULT_RSSI_BIN_IN_DB 4
+#define SMTC_LINK_STATS_DEFAULT_SNR_MIN_IN_DB ( -20 )
+#define SMTC_LINK_STATS_DEFAULT_SNR_BIN_IN_DB 1
+#define SMTC_LINK_STATS_DEFAULT_INTER_ARRIVAL_BIN_IN_MS 100
+
+/**
+ * @brief Probabilities of the estimated quantiles, in increasing order
+ */
+static const uint16_t smtc_link_stats_quantiles_in_per_mille[SMTC_LINK_STATS_NB_QUANTILES] = { 50, 500, 950, 990 };
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Get the fraction of the values a marker should have below it
+ *
+ * @param [in] marker Marker index
+ *
+ * @returns The fraction, in 1/SMTC_LINK_STATS_FRACTION_ONE
+ */
+static uint32_t smtc_link_stats_get_marker_fraction( unsigned int marker );
+
+/**
+ * @brief Move a marker one position towards its desired position, adjusting its height
+ *
+ * @param [in, out] metric Metric
+ * @param [in] marker Marker index, neither the first nor the last one
+ * @param [in] direction +1 or -1
+ */
+static void smtc_link_stats_move_marker( smtc_link_stats_metric_t* metric, unsigned int marker, int32_t direction );
+
+/**
+ * @brief Sort the first values of a metric, in place
+ *
+ * @param [in, out] heights Values
+ * @param [in] count Number of values
+ */
+static void smtc_link_stats_sort( int32_t* heights, uint32_t count );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void smtc_link_stats_init( smtc_link_stats_t* stats )
+{
+    if( stats == NULL )
+    {
+        return;
+    }
+
+    memset( stats, 0, sizeof( smtc_link_stats_t ) );
+    smtc_link_stats_metric_init( &stats->metrics[SMTC_LINK_STATS_METRIC_RSSI], SMTC_LINK_STATS_DEFAULT_RSSI_MIN_IN_DBM,
+                                 SMTC_LINK_STATS_DEFAULT_RSSI_BIN_IN_DB );
+    smtc_link_stats_metric_init( &stats->metrics[SMTC_LINK_STATS_METRIC_SIGNAL_RSSI],
+                                 SMTC_LINK_STATS_DEFAULT_RSSI_MIN_IN_DBM, SMTC_LINK_STATS_DEFAULT_RSSI_BIN_IN_DB );
+    smtc_link_stats_metric_init( &stats->metrics[SMTC_LINK_STATS_METRIC_SNR], SMTC_LINK_STATS_DEFAULT_SNR_MIN_IN_DB,
+                                 SMTC_LINK_STATS_DEFAULT_SNR_BIN_IN_DB );
+    smtc_link_stats_metric_init( &stats->metrics[SMTC_LINK_STATS_METRIC_INTER_ARRIVAL], 0,
+                                 SMTC_LINK_STATS_DEFAULT_INTER_ARRIVAL_BIN_IN_MS );
+}
+
+void smtc_link_stats_reset( smtc_link_stats_t* stats )
+{
+    if( stats == NULL )
+    {
+        return;
+    }
+
+    for( int i = 0; i < SMTC_LINK_STATS_METRIC_COUNT; i++ )
+    {
+        smtc_link_stats_metric_init( &stats->metrics[i], stats->metrics[i].histogram_min,
+                                     stats->metrics[i].bin_width );
+    }
+    stats->is_last_end_of_packet_valid = false;
+}
+
+void smtc_link_stats_add_packet( smtc_link_stats_t* stats, const smtc_link_stats_packet_t* packet )
+{
+    if( ( stats == NULL ) || ( packet == NULL ) )
+    {
+        return;
+    }
+
+    smtc_link_stats_metric_add( &stats->metrics[SMTC_LINK_STATS_METRIC_RSSI], packet->rssi_in_dbm );
+    if( packet->is_lora == true )
+    {
+        smtc_link_stats_metric_add( &stats->metrics[SMTC_LINK_STATS_METRIC_SIGNAL_RSSI], packet->signal_rssi_in_dbm );
+        smtc_link_stats_metric_add( &stats->metrics[SMTC_LINK_STATS_METRIC_SNR], packet->snr_in_db );
+    }
+
+    if( stats->is_last_end_of_packet_valid == true )
+    {
+        const uint32_t inter_arrival_in_us = packet->end_of_packet_in_us - stats->last_end_of_packet_in_us;
+
+        smtc_link_stats_metric_add( &stats->metrics[SMTC_LINK_STATS_METRIC_INTER_ARRIVAL],
+                                    ( int32_t ) ( ( inter_arrival_in_us + 500 ) / 1000 ) );
+    }
+    stats->is_last_end_of_packet_valid = true;
+    stats->last_end_of_packet_in_us    = packet->end_of_packet_in_us;
+}
+
+void smtc_link_stats_metric_init( smtc_link_stats_metric_t* metric, int32_t histogram_min, int32_t bin_width )
+{
+    if( metric == NULL )
+    {
+        return;
+    }
+
+    memset( metric, 0, sizeof( smtc_link_stats_metric_t ) );
+    metric->histogram_min = histogram_min;
+    metric->bin_width     = ( bin_width > 0 ) ? bin_width : 1;
+    metric->min           = INT32_MAX;
+    metric->max           = INT32_MIN;
+}
+
+void smtc_link_stats_metric_add( smtc_link_stats_metric_t* metric, int32_t value )
+{
+    if( metric == NULL )
+    {
+        return;
+    }
+
+    if( value > SMTC_LINK_STATS_VALUE_MAX )
+    {
+        value = SMTC_LINK_STATS_VALUE_MAX;
+    }
+    else if( value < -SMTC_LINK_STATS_VALUE_MAX )
+    {
+        value = -SMTC_LINK_STATS_VALUE_MAX;
+    }
+
+    int32_t bin = 0;
+    if( value >= metric->histogram_min )
+    {
+        bin = ( value - metric->histogram_min ) / metric->bin_width;
+        if( bin >= SMTC_LINK_STATS_HISTOGRAM_NB_BINS )
+        {
+            bin = SMTC_LINK_STATS_HISTOGRAM_NB_BINS - 1;
+        }
+    }
+    metric->histogram[bin]++;
+
+    metric->sum += value;
+    if( value < metric->min )
+    {
+        metric->min = value;
+    }
+    if( value > metric->max )
+    {
+        metric->max = value;
+    }
+
+    const int32_t height = value * ( 1 << SMTC_LINK_STATS_FRACTIONAL_BITS );
+
+    if( metric->count < SMTC_LINK_STATS_NB_MARKERS )
+    {
+        // The first values are the markers themselves
+        metric->heights[metric->count] = height;
+        metric->count++;
+        if( metric->count == SMTC_LINK_STATS_NB_MARKERS )
+        {
+            smtc_link_stats_sort( metric->heights, SMTC_LINK_STATS_NB_MARKERS );
+            for( unsigned int i = 0; i < SMTC_LINK_STATS_NB_MARKERS; i++ )
+            {
+                metric->positions[i] = i + 1;
+            }
+        }
+        return;
+    }
+    metric->count++;
+
+    // Find the cell holding the value, stretching the extreme markers if needed
+    unsigned int cell;
+    if( height < metric->heights[0] )
+    {
+        metric->heights[0] = height;
+        cell               = 0;
+    }
+    else if( height >= metric->heights[SMTC_LINK_STATS_NB_MARKERS - 1] )
+    {
+        metric->heights[SMTC_LINK_STATS_NB_MARKERS - 1] = height;
+        cell                                            = SMTC_LINK_STATS_NB_MARKERS - 2;
+    }
+    else
+    {
+        cell = 0;
+        while( height >= metric->heights[cell + 1] )
+        {
+            cell++;
+        }
+    }
+
+    for( unsigned int i = cell + 1; i < SMTC_LINK_STATS_NB_MARKERS; i++ )
+    {
+        metric->positions[i]++;
+    }
+
+    // Desired position of marker i: 1 + ( count - 1 ) * fraction_i, compared in 1/SMTC_LINK_STATS_FRACTION_ONE
+    for( unsigned int i = 1; i < ( SMTC_LINK_STATS_NB_MARKERS - 1 ); i++ )
+    {
+        const int64_t desired = SMTC_LINK_STATS_FRACTION_ONE +
+                                ( int64_t ) ( metric->count - 1 ) * smtc_link_stats_get_marker_fraction( i );
+        const int64_t offset  = desired - ( int64_t ) metric->positions[i] * SMTC_LINK_STATS_FRACTION_ONE;
+
+        if( ( offset >= SMTC_LINK_STATS_FRACTION_ONE ) && ( ( metric->positions[i + 1] - metric->positions[i] ) > 1 ) )
+        {
+            smtc_link_stats_move_marker( metric, i, 1 );
+        }
+        else if( ( offset <= -SMTC_LINK_STATS_FRACTION_ONE ) &&
+                 ( ( metric->positions[i] - metric->positions[i - 1] ) > 1 ) )
+        {
+            smtc_link_stats_move_marker( metric, i, -1 );
+        }
+    }
+}
+
+int32_t smtc_link_stats_metric_get_quantile( const smtc_link_stats_metric_t* metric, unsigned int index )
+{
+    if( ( metric == NULL ) || ( index >= SMTC_LINK_STATS_NB_QUANTILES ) || ( metric->count == 0 ) )
+    {
+        return 0;
+    }
+
+    if( metric->count >= SMTC_LINK_STATS_NB_MARKERS )
+    {
+        return metric->heights[2 * index + 2];
+    }
+
+    // Too few values for the estimator yet: nearest rank on the values themselves
+    int32_t heights[SMTC_LINK_STATS_NB_MARKERS];
+
+    memcpy( heights, metric->heights, metric->count * sizeof( int32_t ) );
+    smtc_link_stats_sort( heights, metric->count );
+
+    return heights[( ( metric->count - 1 ) * smtc_link_stats_quantiles_in_per_mille[index] + 500 ) / 1000];
+}
+
+uint16_t smtc_link_stats_get_quantile_in_per_mille( unsigned int index )
+{
+    return ( index < SMTC_LINK_STATS_NB_QUANTILES ) ? smtc_link_stats_quantiles_in_per_mille[index] : 0;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint32_t smtc_link_stats_get_marker_fraction( unsigned int marker )
+{
+    if( ( marker & 1 ) == 0 )
+    {
+        // Minimum, quantiles and maximum
+        if( marker == 0 )
+        {
+            return 0;
+        }
+        if( marker == ( SMTC_LINK_STATS_NB_MARKERS - 1 ) )
+        {
+            return SMTC_LINK_STATS_FRACTION_ONE;
+        }
+        return 2u * smtc_link_stats_quantiles_in_per_mille[( marker - 2 ) / 2];
+    }
+
+    // Middle between the two neighbouring markers
+    const unsigned int next = ( marker - 1 ) / 2;
+    const uint32_t     low  = ( next == 0 ) ? 0 : smtc_link_stats_quantiles_in_per_mille[next - 1];
+    const uint32_t     high =
+        ( next == SMTC_LINK_STATS_NB_QUANTILES ) ? 1000 : smtc_link_stats_quantiles_in_per_mille[next];
+
+    return low + high;
+}
+
+static void smtc_link_stats_move_marker( smtc_link_stats_metric_t* metric, unsigned int marker, int32_t direction )
+{
+    const int64_t q_prev = metric->heights[marker - 1];
+    const int64_t q      = metric->heights[marker];
+    const int64_t q_next = metric->heights[marker + 1];
+    const int64_t n_prev = metric->positions[marker - 1];
+    const int64_t n      = metric->positions[marker];
+    const int64_t n_next = metric->positions[marker + 1];
+
+    // Piecewise-parabolic prediction
+    int64_t height = q + direction *
+                             ( ( n - n_prev + direction ) * ( q_next - q ) / ( n_next - n ) +
+                               ( n_next - n - direction ) * ( q - q_prev ) / ( n - n_prev ) ) /
+                             ( n_next - n_prev );
+
+    if( ( height <= q_prev ) || ( height >= q_next ) )
+    {
+        // The parabola is not monotonic here: linear prediction towards the neighbour instead
+        if( direction > 0 )
+        {
+            height = q + ( q_next - q ) / ( n_next - n );
+        }
+        else
+        {
+            height = q - ( q - q_prev ) / ( n - n_prev );
+        }
+    }
+
+    metric->heights[marker] = ( int32_t ) height;
+    metric->positions[marker] += ( uint32_t ) direction;
+}
+
+static void smtc_link_stats_sort( int32_t* heights, uint32_t count )
+{
+    for( uint32_t i = 1; i < count; i++ )
+    {
+        const int32_t height = heights[i];
+        uint32_t      j      = i;
+
+        while( ( j > 0 ) && ( heights[j - 1] > height ) )
+        {
+            heights[j] = heights[j - 1];
+            j--;
+        }
+        heights[j] = height;
+    }
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,226 @@
+/**
+ * @file      smtc_link_stats.h
+ *
+ * @brief      Fixed-memory link statistics: histograms and streaming quantiles of the received packets
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMTC_LINK_STATS_H
+#define SMTC_LINK_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/**
+ * @brief Number of bins of each histogram
+ *
+ * @remark Values below the first bin are counted in it, values above the last one in the last one
+ */
+#ifndef SMTC_LINK_STATS_HISTOGRAM_NB_BINS
+#define SMTC_LINK_STATS_HISTOGRAM_NB_BINS 32
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Number of quantiles estimated for each metric, see smtc_link_stats_get_quantile_in_per_mille
+ */
+#define SMTC_LINK_STATS_NB_QUANTILES 4
+
+/**
+ * @brief Number of markers of the P-square estimator: the minimum, the maximum, the quantiles and the middles between
+ * them
+ */
+#define SMTC_LINK_STATS_NB_MARKERS ( 2 * SMTC_LINK_STATS_NB_QUANTILES + 3 )
+
+/**
+ * @brief Number of fractional bits of the quantile estimates
+ */
+#define SMTC_LINK_STATS_FRACTIONAL_BITS 8
+
+/**
+ * @brief Largest magnitude of a metric value, larger ones are clamped
+ *
+ * @remark Keeps the fixed-point arithmetic of the estimator within 64 bits
+ */
+#define SMTC_LINK_STATS_VALUE_MAX ( ( 1 << 20 ) - 1 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Metrics recorded for each packet
+ */
+typedef enum smtc_link_stats_metric_id_e
+{
+    SMTC_LINK_STATS_METRIC_RSSI = 0,       //!< Packet RSSI, in dBm
+    SMTC_LINK_STATS_METRIC_SIGNAL_RSSI,    //!< LoRa signal RSSI (after despreading), in dBm
+    SMTC_LINK_STATS_METRIC_SNR,            //!< LoRa SNR, in dB
+    SMTC_LINK_STATS_METRIC_INTER_ARRIVAL,  //!< Time between the ends of two consecutive packets, in ms
+    SMTC_LINK_STATS_METRIC_COUNT,
+} smtc_link_stats_metric_id_t;
+
+/**
+ * @brief Distribution of one metric
+ *
+ * The quantiles are tracked with the extended P-square algorithm (Jain and Chlamtac, Raatikainen): a fixed number of
+ * markers whose heights are adjusted by piecewise-parabolic interpolation, in fixed point. The first
+ * SMTC_LINK_STATS_NB_MARKERS values are kept as they are and give exact quantiles.
+ */
+typedef struct smtc_link_stats_metric_s
+{
+    int32_t  histogram_min;  //!< Lower bound of the first bin
+    int32_t  bin_width;      //!< Width of the bins
+    uint32_t count;          //!< Number of values
+    int32_t  min;
+    int32_t  max;
+    int64_t  sum;
+    uint32_t histogram[SMTC_LINK_STATS_HISTOGRAM_NB_BINS];
+    int32_t  heights[SMTC_LINK_STATS_NB_MARKERS];    //!< Marker heights, SMTC_LINK_STATS_FRACTIONAL_BITS fixed point
+    uint32_t positions[SMTC_LINK_STATS_NB_MARKERS];  //!< Marker positions, from 1
+} smtc_link_stats_metric_t;
+
+/**
+ * @brief Packet status given to smtc_link_stats_add_packet
+ */
+typedef struct smtc_link_stats_packet_s
+{
+    int16_t  rssi_in_dbm;
+    int16_t  signal_rssi_in_dbm;   //!< Valid if is_lora is true
+    int16_t  snr_in_db;            //!< Valid if is_lora is true
+    bool     is_lora;              //!< false for a GFSK packet: only the RSSI is recorded
+    uint32_t end_of_packet_in_us;  //!< On-air end of the packet, only differences between packets are used
+} smtc_link_stats_packet_t;
+
+/**
+ * @brief Link statistics
+ *
+ * @remark The structure is allocated by the caller and only accessed through the functions below
+ */
+typedef struct smtc_link_stats_s
+{
+    smtc_link_stats_metric_t metrics[SMTC_LINK_STATS_METRIC_COUNT];
+    bool                     is_last_end_of_packet_valid;
+    uint32_t                 last_end_of_packet_in_us;
+} smtc_link_stats_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Initialise the statistics, with the default histogram of each metric
+ *
+ * @param [out] stats Link statistics
+ */
+void smtc_link_stats_init( smtc_link_stats_t* stats );
+
+/**
+ * @brief Clear the statistics, keeping the histogram configuration
+ *
+ * @param [in, out] stats Link statistics
+ */
+void smtc_link_stats_reset( smtc_link_stats_t* stats );
+
+/**
+ * @brief Record the status of a received packet
+ *
+ * @remark O(1) and integer only, to be called from on_rx_done
+ *
+ * @param [in, out] stats Link statistics
+ * @param [in] packet Packet status
+ */
+void smtc_link_stats_add_packet( smtc_link_stats_t* stats, const smtc_link_stats_packet_t* packet );
+
+/**
+ * @brief Clear a metric and set its histogram
+ *
+ * @param [out] metric Metric
+ * @param [in] histogram_min Lower bound of the first bin
+ * @param [in] bin_width Width of the bins, at least 1
+ */
+void smtc_link_stats_metric_init( smtc_link_stats_metric_t* metric, int32_t histogram_min, int32_t bin_width );
+
+/**
+ * @brief Record a value
+ *
+ * @remark O(1) and integer only
+ *
+ * @param [in, out] metric Metric
+ * @param [in] value Value, clamped to +/-SMTC_LINK_STATS_VALUE_MAX
+ */
+void smtc_link_stats_metric_add( smtc_link_stats_metric_t* metric, int32_t value );
+
+/**
+ * @brief Get the estimate of a quantile
+ *
+ * @param [in] metric Metric
+ * @param [in] index Quantile index, below SMTC_LINK_STATS_NB_QUANTILES
+ *
+ * @returns The quantile, with SMTC_LINK_STATS_FRACTIONAL_BITS fractional bits - 0 if the metric has no value
+ */
+int32_t smtc_link_stats_metric_get_quantile( const smtc_link_stats_metric_t* metric, unsigned int index );
+
+/**
+ * @brief Get the probability of a quantile
+ *
+ * @param [in] index Quantile index, below SMTC_LINK_STATS_NB_QUANTILES
+ *
+ * @returns The probability, in per mille - 0 if the index is out of range
+ */
+uint16_t smtc_link_stats_get_quantile_in_per_mille( unsigned int index );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SMTC_LINK_STATS_H
+
+/* --- EOF ------------------------------------------------------------------ */
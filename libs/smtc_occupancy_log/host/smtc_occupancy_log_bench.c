@@ -0,0 +1,574 @@
+/**
+ * @file      smtc_occupancy_log_bench.c
+ *
+ * @brief      Host benchmark of the occupancy log: synthetic site survey, rollover, power failures and dump decoding
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "smtc_hal_mcu_nvm.h"
+#include "smtc_hal_mcu_nvm_host.h"
+#include "smtc_occupancy_log.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Largest number of channels the benchmark supports
+ */
+#define BENCH_NB_CHANNELS_MAX 256
+
+/**
+ * @brief Size of the buffer receiving the dump
+ */
+#define BENCH_DUMP_SIZE_MAX 0x100000
+
+/**
+ * @brief File the dump is saved to, for smtc_occupancy_log_decode
+ */
+#define BENCH_DUMP_PATH "occupancy_log_dump.bin"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Benchmark parameters
+ */
+typedef struct bench_cfg_s
+{
+    const char* path;
+    uint32_t    nvm_size;
+    uint32_t    page_size;
+    uint16_t    nb_channels;
+    uint8_t     nb_bins;
+    uint8_t     level_max;
+    uint16_t    record_period_in_s;
+    uint32_t    nb_samples;
+    uint32_t    nb_days;
+    uint32_t    nb_power_failures;
+} bench_cfg_t;
+
+/**
+ * @brief Expected content of a record
+ */
+typedef struct bench_record_s
+{
+    uint16_t session;
+    uint32_t time_in_s;
+    uint8_t* levels;
+} bench_record_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static smtc_hal_mcu_nvm_inst_t nvm;
+static smtc_occupancy_log_t    occupancy_log;
+static uint32_t                rng_state = 0x2545F491;
+
+/**
+ * @brief Records appended so far, in order
+ */
+static bench_record_t* records;
+static uint32_t        nb_records;
+
+static uint8_t  dump[BENCH_DUMP_SIZE_MAX];
+static uint32_t dump_length;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static uint32_t bench_rand( void );
+static uint64_t bench_get_time_in_ns( void );
+static bool     bench_mount( const bench_cfg_t* cfg );
+static void     bench_unmount( void );
+static void     bench_make_histogram( const bench_cfg_t* cfg, uint16_t channel, uint32_t time_in_s, uint16_t* counts );
+static void     bench_get_levels( const bench_cfg_t* cfg, const uint16_t* counts, uint8_t* levels );
+static bool     bench_append( const bench_cfg_t* cfg, uint32_t time_in_s, bool is_power_failure,
+                              uint64_t* total_in_ns );
+static void     bench_dump_write( const uint8_t* data, uint16_t length );
+static bool     bench_check_dump( const bench_cfg_t* cfg );
+static bool     bench_walk_dump( const bench_cfg_t* cfg, bool is_check, uint32_t first_record, uint32_t* nb_decoded,
+                                 uint32_t* nb_corrupted );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( int argc, char** argv )
+{
+    bench_cfg_t cfg = {
+        .path               = "occupancy_log_bench.bin",
+        .nvm_size           = 0x20000,
+        .page_size          = 0x800,
+        .nb_channels        = 30,
+        .nb_bins            = 33,
+        .level_max          = 63,
+        .record_period_in_s = 300,
+        .nb_samples         = 20000,
+        .nb_days            = 60,
+        .nb_power_failures  = 20,
+    };
+    smtc_occupancy_log_stats_t stats;
+    uint32_t                   nb_records_total;
+    uint32_t                   time_in_s      = 0;
+    uint64_t                   total_in_ns    = 0;
+    uint32_t                   nb_failures    = 0;
+    uint32_t                   failure_period = 0;
+    int                        opt;
+
+    while( ( opt = getopt( argc, argv, "f:s:S:c:b:L:P:n:d:p:" ) ) != -1 )
+    {
+        switch( opt )
+        {
+        case 'f':
+            cfg.path = optarg;
+            break;
+        case 's':
+            cfg.nvm_size = strtoul( optarg, NULL, 0 );
+            break;
+        case 'S':
+            cfg.page_size = strtoul( optarg, NULL, 0 );
+            break;
+        case 'c':
+            cfg.nb_channels = ( uint16_t ) strtoul( optarg, NULL, 0 );
+            break;
+        case 'b':
+            cfg.nb_bins = ( uint8_t ) strtoul( optarg, NULL, 0 );
+            break;
+        case 'L':
+            cfg.level_max = ( uint8_t ) strtoul( optarg, NULL, 0 );
+            break;
+        case 'P':
+            cfg.record_period_in_s = ( uint16_t ) strtoul( optarg, NULL, 0 );
+            break;
+        case 'n':
+            cfg.nb_samples = strtoul( optarg, NULL, 0 );
+            break;
+        case 'd':
+            cfg.nb_days = strtoul( optarg, NULL, 0 );
+            break;
+        case 'p':
+            cfg.nb_power_failures = strtoul( optarg, NULL, 0 );
+            break;
+        default:
+            fprintf( stderr,
+                     "usage: %s [-f file] [-s nvm size] [-S page size] [-c channels] [-b bins] [-L level full scale] "
+                     "[-P record period in s] [-n samples per record] [-d days] [-p power failures]\n",
+                     argv[0] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    if( ( cfg.nb_channels == 0 ) || ( cfg.nb_channels > BENCH_NB_CHANNELS_MAX ) || ( cfg.nb_bins < 2 ) ||
+        ( cfg.nb_bins > SMTC_OCCUPANCY_LOG_NB_BINS_MAX ) || ( cfg.level_max == 0 ) || ( cfg.record_period_in_s == 0 ) ||
+        ( cfg.nb_samples == 0 ) || ( cfg.nb_samples > UINT16_MAX ) || ( cfg.nvm_size > BENCH_DUMP_SIZE_MAX ) )
+    {
+        fprintf( stderr,
+                 "channels must be in [1, %d], bins in [2, %d], full scale in [1, 255], samples in [1, 65535], "
+                 "NVM up to %d bytes\n",
+                 BENCH_NB_CHANNELS_MAX, SMTC_OCCUPANCY_LOG_NB_BINS_MAX, BENCH_DUMP_SIZE_MAX );
+        return EXIT_FAILURE;
+    }
+
+    nb_records_total = cfg.nb_days * ( 86400 / cfg.record_period_in_s );
+    records          = calloc( nb_records_total + cfg.nb_power_failures + 1, sizeof( bench_record_t ) );
+    if( records == NULL )
+    {
+        return EXIT_FAILURE;
+    }
+    if( cfg.nb_power_failures > 0 )
+    {
+        failure_period = nb_records_total / ( cfg.nb_power_failures + 1 );
+    }
+
+    remove( cfg.path );
+
+    printf( "NVM %u bytes, pages of %u bytes, %u channels of %u bins scaled to %u, a record every %u s, %u days\n",
+            cfg.nvm_size, cfg.page_size, cfg.nb_channels, cfg.nb_bins, cfg.level_max, cfg.record_period_in_s,
+            cfg.nb_days );
+
+    if( bench_mount( &cfg ) == false )
+    {
+        return EXIT_FAILURE;
+    }
+
+    for( uint32_t i = 0; i < nb_records_total; i++ )
+    {
+        const bool is_power_failure = ( failure_period != 0 ) && ( ( i % failure_period ) == ( failure_period - 1 ) ) &&
+                                      ( nb_failures < cfg.nb_power_failures );
+
+        time_in_s += cfg.record_period_in_s;
+        if( bench_append( &cfg, time_in_s, is_power_failure, &total_in_ns ) == false )
+        {
+            return EXIT_FAILURE;
+        }
+
+        if( is_power_failure == true )
+        {
+            /* The board restarts: a new session begins, the clock restarts from zero */
+            nb_failures++;
+            bench_unmount( );
+            if( bench_mount( &cfg ) == false )
+            {
+                return EXIT_FAILURE;
+            }
+            time_in_s = 0;
+        }
+    }
+
+    smtc_occupancy_log_get_stats( &occupancy_log, &stats );
+    printf( "\n%u records appended, %u power failures: %.1f us per record (file I/O included)\n", nb_records_total,
+            nb_failures, ( double ) total_in_ns / nb_records_total / 1000.0 );
+    printf( "%u records kept in %u/%u pages, %u pages erased in the last session\n", stats.nb_records,
+            stats.nb_pages_used, stats.nb_pages, stats.nb_pages_erased );
+    printf( "%.1f bytes per record (raw: %.1f), compression ratio %.2f\n",
+            ( double ) stats.stored_bytes / stats.nb_records, ( double ) stats.raw_bytes / stats.nb_records,
+            ( double ) stats.raw_bytes / stats.stored_bytes );
+    printf( "history kept: %.1f days, %.1f days if the NVM were full\n",
+            ( double ) stats.nb_records * cfg.record_period_in_s / 86400.0,
+            ( double ) stats.nb_records * cfg.record_period_in_s / 86400.0 * cfg.nvm_size / stats.stored_bytes );
+
+    if( bench_check_dump( &cfg ) == false )
+    {
+        return EXIT_FAILURE;
+    }
+
+    bench_unmount( );
+    for( uint32_t i = 0; i < nb_records; i++ )
+    {
+        free( records[i].levels );
+    }
+    free( records );
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint32_t bench_rand( void )
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+
+    return rng_state;
+}
+
+static uint64_t bench_get_time_in_ns( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return ( ( uint64_t ) now.tv_sec * 1000000000ULL ) + ( uint64_t ) now.tv_nsec;
+}
+
+static bool bench_mount( const bench_cfg_t* cfg )
+{
+    struct smtc_hal_mcu_nvm_cfg_s nvm_cfg = {
+        .path      = cfg->path,
+        .size      = cfg->nvm_size,
+        .page_size = cfg->page_size,
+    };
+    smtc_occupancy_log_cfg_t log_cfg = {
+        .page_size = cfg->page_size,
+        .plan      = {
+            .freq_start_in_hz   = 2400000000,
+            .freq_step_in_hz    = 200000,
+            .nb_channels        = cfg->nb_channels,
+            .rssi_top_in_dbm    = 0,
+            .rssi_step_in_db    = 4,
+            .nb_bins            = cfg->nb_bins,
+            .level_max          = cfg->level_max,
+            .record_period_in_s = cfg->record_period_in_s,
+        },
+    };
+    smtc_occupancy_log_status_t status;
+
+    if( smtc_hal_mcu_nvm_init( &nvm_cfg, &nvm ) != SMTC_HAL_MCU_STATUS_OK )
+    {
+        fprintf( stderr, "cannot open %s\n", cfg->path );
+        return false;
+    }
+
+    log_cfg.nvm = nvm;
+    status      = smtc_occupancy_log_init( &occupancy_log, &log_cfg );
+    if( status != SMTC_OCCUPANCY_LOG_STATUS_OK )
+    {
+        fprintf( stderr, "smtc_occupancy_log_init failed: %d\n", status );
+        return false;
+    }
+
+    return true;
+}
+
+static void bench_unmount( void )
+{
+    smtc_hal_mcu_nvm_deinit( &nvm );
+}
+
+static void bench_make_histogram( const bench_cfg_t* cfg, uint16_t channel, uint32_t time_in_s, uint16_t* counts )
+{
+    /* Noise floor around -112 dBm, and a busy share following the time of day on some channels */
+    const uint8_t  floor_bin   = ( cfg->nb_bins > 29 ) ? 28 : ( cfg->nb_bins - 1 );
+    const uint32_t hour        = ( time_in_s / 3600 ) % 24;
+    const uint32_t busy_permil = ( ( channel % 7 ) == 3 ) ? ( ( hour >= 8 ) && ( hour < 20 ) ? 300 : 40 )
+                                 : ( ( channel % 5 ) == 1 ) ? 10
+                                                            : 0;
+    uint32_t       busy        = cfg->nb_samples * busy_permil / 1000;
+
+    memset( counts, 0, cfg->nb_bins * sizeof( uint16_t ) );
+
+    if( busy > 0 )
+    {
+        busy += bench_rand( ) % ( busy / 4 + 1 );
+        busy = ( busy > cfg->nb_samples ) ? cfg->nb_samples : busy;
+    }
+    for( uint32_t i = 0; i < busy; i++ )
+    {
+        /* Transmitters heard between -60 and -80 dBm */
+        const uint8_t bin = 15 + ( bench_rand( ) % 5 );
+
+        counts[( bin < cfg->nb_bins ) ? bin : ( cfg->nb_bins - 1 )]++;
+    }
+    for( uint32_t i = busy; i < cfg->nb_samples; i++ )
+    {
+        const uint32_t draw = bench_rand( ) % 100;
+        int            bin  = floor_bin + ( ( draw < 70 ) ? 0 : ( draw < 85 ) ? -1 : ( draw < 97 ) ? 1 : -2 );
+
+        bin = ( bin < 0 ) ? 0 : ( bin >= cfg->nb_bins ) ? ( cfg->nb_bins - 1 ) : bin;
+        counts[bin]++;
+    }
+}
+
+static void bench_get_levels( const bench_cfg_t* cfg, const uint16_t* counts, uint8_t* levels )
+{
+    uint32_t total = 0;
+
+    for( uint8_t bin = 0; bin < cfg->nb_bins; bin++ )
+    {
+        total += counts[bin];
+    }
+    for( uint8_t bin = 0; bin < cfg->nb_bins; bin++ )
+    {
+        levels[bin] = ( total == 0 ) ? 0 : ( uint8_t ) ( ( counts[bin] * cfg->level_max + total / 2 ) / total );
+    }
+}
+
+static bool bench_append( const bench_cfg_t* cfg, uint32_t time_in_s, bool is_power_failure,
+                          uint64_t* total_in_ns )
+{
+    static uint16_t             counts[BENCH_NB_CHANNELS_MAX][SMTC_OCCUPANCY_LOG_NB_BINS_MAX];
+    bench_record_t*             record = &records[nb_records];
+    uint64_t                    start_in_ns;
+    smtc_occupancy_log_status_t status;
+
+    record->session   = occupancy_log.session;
+    record->time_in_s = time_in_s;
+    record->levels    = malloc( ( size_t ) cfg->nb_channels * cfg->nb_bins );
+    if( record->levels == NULL )
+    {
+        return false;
+    }
+    for( uint16_t channel = 0; channel < cfg->nb_channels; channel++ )
+    {
+        bench_make_histogram( cfg, channel, time_in_s, counts[channel] );
+        bench_get_levels( cfg, counts[channel], &record->levels[channel * cfg->nb_bins] );
+    }
+
+    start_in_ns = bench_get_time_in_ns( );
+    status      = smtc_occupancy_log_record_start( &occupancy_log, time_in_s, cfg->nb_samples );
+    for( uint16_t channel = 0; ( channel < cfg->nb_channels ) && ( status == SMTC_OCCUPANCY_LOG_STATUS_OK ); channel++ )
+    {
+        status = smtc_occupancy_log_record_add_channel( &occupancy_log, counts[channel] );
+    }
+
+    if( is_power_failure == true )
+    {
+        /* Cut the power in the middle of the record: it must be reported as corrupted, never decoded wrong */
+        smtc_hal_mcu_nvm_host_set_write_budget( nvm, ( bench_rand( ) % 40 ) + 1 );
+        smtc_occupancy_log_record_end( &occupancy_log );
+        free( record->levels );
+        return true;
+    }
+
+    if( status == SMTC_OCCUPANCY_LOG_STATUS_OK )
+    {
+        status = smtc_occupancy_log_record_end( &occupancy_log );
+    }
+    *total_in_ns += bench_get_time_in_ns( ) - start_in_ns;
+    if( status != SMTC_OCCUPANCY_LOG_STATUS_OK )
+    {
+        fprintf( stderr, "record %u failed: %d\n", nb_records, status );
+        return false;
+    }
+    nb_records++;
+
+    return true;
+}
+
+static void bench_dump_write( const uint8_t* data, uint16_t length )
+{
+    if( ( dump_length + length ) <= sizeof( dump ) )
+    {
+        memcpy( &dump[dump_length], data, length );
+    }
+    dump_length += length;
+}
+
+static bool bench_check_dump( const bench_cfg_t* cfg )
+{
+    uint64_t start_in_ns = bench_get_time_in_ns( );
+    uint64_t duration_in_ns;
+    uint32_t nb_decoded;
+    uint32_t nb_corrupted;
+    FILE*    file;
+
+    dump_length = 0;
+    if( smtc_occupancy_log_dump( &occupancy_log, bench_dump_write ) != SMTC_OCCUPANCY_LOG_STATUS_OK )
+    {
+        fprintf( stderr, "dump failed\n" );
+        return false;
+    }
+    duration_in_ns = bench_get_time_in_ns( ) - start_in_ns;
+
+    file = fopen( BENCH_DUMP_PATH, "wb" );
+    if( file != NULL )
+    {
+        fwrite( dump, 1, dump_length, file );
+        fclose( file );
+    }
+
+    /* The dump holds the newest records: count them first, then compare them with the expected ones */
+    if( ( bench_walk_dump( cfg, false, 0, &nb_decoded, &nb_corrupted ) == false ) || ( nb_decoded > nb_records ) ||
+        ( bench_walk_dump( cfg, true, nb_records - nb_decoded, &nb_decoded, &nb_corrupted ) == false ) )
+    {
+        return false;
+    }
+
+    printf( "dump: %u bytes in %.1f us, %u records decoded bit-exact, %u torn records detected, saved to %s\n",
+            dump_length, ( double ) duration_in_ns / 1000.0, nb_decoded, nb_corrupted, BENCH_DUMP_PATH );
+
+    return true;
+}
+
+static bool bench_walk_dump( const bench_cfg_t* cfg, bool is_check, uint32_t first_record, uint32_t* nb_decoded,
+                             uint32_t* nb_corrupted )
+{
+    static uint8_t                   levels[BENCH_NB_CHANNELS_MAX * SMTC_OCCUPANCY_LOG_NB_BINS_MAX];
+    smtc_occupancy_log_page_header_t header;
+    uint32_t                         offset = 0;
+
+    *nb_decoded   = 0;
+    *nb_corrupted = 0;
+    while( offset < dump_length )
+    {
+        uint32_t time_in_s;
+
+        if( smtc_occupancy_log_parse_page_header( &dump[offset], dump_length - offset, &header ) == false )
+        {
+            fprintf( stderr, "no page header at offset %u of the dump\n", offset );
+            return false;
+        }
+        offset += SMTC_OCCUPANCY_LOG_PAGE_HEADER_SIZE;
+        time_in_s = header.base_time_in_s;
+
+        for( ;; )
+        {
+            uint32_t                    record_size;
+            uint32_t                    time_delta_in_s;
+            uint32_t                    nb_samples;
+            const bench_record_t*       expected;
+            smtc_occupancy_log_status_t status =
+                smtc_occupancy_log_decode_record( &header, &dump[offset], dump_length - offset, &record_size,
+                                                  &time_delta_in_s, &nb_samples, levels );
+
+            if( status == SMTC_OCCUPANCY_LOG_STATUS_NO_SPACE )
+            {
+                break;
+            }
+            offset += record_size;
+            if( status != SMTC_OCCUPANCY_LOG_STATUS_OK )
+            {
+                ( *nb_corrupted )++;
+                continue;
+            }
+
+            time_in_s += time_delta_in_s;
+            if( is_check == false )
+            {
+                ( *nb_decoded )++;
+                continue;
+            }
+
+            expected = &records[first_record + *nb_decoded];
+            if( ( header.session != expected->session ) || ( time_in_s != expected->time_in_s ) ||
+                ( nb_samples != cfg->nb_samples ) ||
+                ( memcmp( levels, expected->levels, ( size_t ) cfg->nb_channels * cfg->nb_bins ) != 0 ) )
+            {
+                fprintf( stderr, "record %u of the dump does not match\n", *nb_decoded );
+                return false;
+            }
+            ( *nb_decoded )++;
+        }
+    }
+
+    return true;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,318 @@
+/**
+ * @file      smtc_occupancy_log_decode.c
+ *
+ * @brief      Decode an occupancy log dump into a time x frequency occupancy matrix
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "smtc_occupancy_log.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Largest number of channels of a plan
+ */
+#define DECODE_NB_CHANNELS_MAX 1024
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Decoder options
+ */
+typedef struct decode_cfg_s
+{
+    const char* path;
+    int         threshold_in_dbm;  //!< Samples at or above it count as occupied
+    bool        is_raw;            //!< Print the levels of all bins instead of the occupancy
+} decode_cfg_t;
+
+/**
+ * @brief Decoder counters
+ */
+typedef struct decode_stats_s
+{
+    uint32_t nb_pages;
+    uint32_t nb_records;
+    uint32_t nb_records_corrupted;
+    uint32_t nb_bytes_skipped;
+} decode_stats_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static uint8_t levels[DECODE_NB_CHANNELS_MAX * SMTC_OCCUPANCY_LOG_NB_BINS_MAX];
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static uint8_t* decode_load( const char* path, uint32_t* length );
+static bool     decode_is_same_plan( const smtc_occupancy_log_page_header_t* a,
+                                     const smtc_occupancy_log_page_header_t* b );
+static void     decode_print_columns( const decode_cfg_t* cfg, const smtc_occupancy_log_page_header_t* header );
+static void     decode_print_row( const decode_cfg_t* cfg, const smtc_occupancy_log_page_header_t* header,
+                                  uint32_t time_in_s, uint32_t nb_samples );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( int argc, char** argv )
+{
+    decode_cfg_t cfg = {
+        .path             = NULL,
+        .threshold_in_dbm = -90,
+        .is_raw           = false,
+    };
+    smtc_occupancy_log_page_header_t header;
+    smtc_occupancy_log_page_header_t columns     = { 0 };
+    bool                             has_columns = false;
+    decode_stats_t                   stats       = { 0 };
+    uint8_t*                         data;
+    uint32_t                         length;
+    uint32_t                         offset = 0;
+    int                              opt;
+
+    while( ( opt = getopt( argc, argv, "t:r" ) ) != -1 )
+    {
+        switch( opt )
+        {
+        case 't':
+            cfg.threshold_in_dbm = atoi( optarg );
+            break;
+        case 'r':
+            cfg.is_raw = true;
+            break;
+        default:
+            optind = argc + 1;
+            break;
+        }
+    }
+    if( optind != ( argc - 1 ) )
+    {
+        fprintf( stderr,
+                 "usage: %s [-t threshold in dBm] [-r] dump.bin\n"
+                 "  prints one CSV row per record: session, time in s, then the occupancy in %% of each channel,\n"
+                 "  i.e. the share of samples at or above the threshold (-90 dBm by default) - or, with -r, the\n"
+                 "  level of each bin, the levels of a channel adding up to the full scale of the plan\n",
+                 argv[0] );
+        return EXIT_FAILURE;
+    }
+    cfg.path = argv[optind];
+
+    data = decode_load( cfg.path, &length );
+    if( data == NULL )
+    {
+        fprintf( stderr, "cannot read %s\n", cfg.path );
+        return EXIT_FAILURE;
+    }
+
+    while( offset < length )
+    {
+        uint32_t time_in_s;
+
+        /* Look for the next page header: the dump holds the used part of each page, oldest first */
+        if( ( smtc_occupancy_log_parse_page_header( &data[offset], length - offset, &header ) == false ) ||
+            ( header.nb_channels > DECODE_NB_CHANNELS_MAX ) || ( header.nb_bins > SMTC_OCCUPANCY_LOG_NB_BINS_MAX ) )
+        {
+            offset++;
+            stats.nb_bytes_skipped++;
+            continue;
+        }
+        stats.nb_pages++;
+        offset += SMTC_OCCUPANCY_LOG_PAGE_HEADER_SIZE;
+        time_in_s = header.base_time_in_s;
+
+        if( ( has_columns == false ) || ( decode_is_same_plan( &header, &columns ) == false ) )
+        {
+            decode_print_columns( &cfg, &header );
+            columns     = header;
+            has_columns = true;
+        }
+
+        for( ;; )
+        {
+            uint32_t                    record_size = 0;
+            uint32_t                    time_delta_in_s;
+            uint32_t                    nb_samples;
+            smtc_occupancy_log_status_t status =
+                smtc_occupancy_log_decode_record( &header, &data[offset], length - offset, &record_size,
+                                                  &time_delta_in_s, &nb_samples, levels );
+
+            if( status == SMTC_OCCUPANCY_LOG_STATUS_NO_SPACE )
+            {
+                break;
+            }
+            if( status != SMTC_OCCUPANCY_LOG_STATUS_OK )
+            {
+                /* A torn record: skip it if its size is sound, otherwise resynchronise on the next page */
+                stats.nb_records_corrupted++;
+                if( ( record_size == 0 ) || ( record_size > ( length - offset ) ) ||
+                    ( record_size > SMTC_OCCUPANCY_LOG_RECORD_SIZE_MAX ) )
+                {
+                    break;
+                }
+                offset += record_size;
+                continue;
+            }
+
+            offset += record_size;
+            time_in_s += time_delta_in_s;
+            stats.nb_records++;
+            decode_print_row( &cfg, &header, time_in_s, nb_samples );
+        }
+    }
+
+    fprintf( stderr, "%u pages, %u records, %u corrupted records, %u bytes skipped\n", stats.nb_pages,
+             stats.nb_records, stats.nb_records_corrupted, stats.nb_bytes_skipped );
+    free( data );
+
+    return ( stats.nb_pages > 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint8_t* decode_load( const char* path, uint32_t* length )
+{
+    FILE*    file = fopen( path, "rb" );
+    uint8_t* data = NULL;
+    long     size;
+
+    if( file == NULL )
+    {
+        return NULL;
+    }
+
+    if( ( fseek( file, 0, SEEK_END ) == 0 ) && ( ( size = ftell( file ) ) >= 0 ) &&
+        ( fseek( file, 0, SEEK_SET ) == 0 ) )
+    {
+        data = malloc( ( size > 0 ) ? ( size_t ) size : 1 );
+        if( ( data != NULL ) && ( fread( data, 1, ( size_t ) size, file ) != ( size_t ) size ) )
+        {
+            free( data );
+            data = NULL;
+        }
+        *length = ( uint32_t ) size;
+    }
+    fclose( file );
+
+    return data;
+}
+
+static bool decode_is_same_plan( const smtc_occupancy_log_page_header_t* a, const smtc_occupancy_log_page_header_t* b )
+{
+    return ( a->nb_channels == b->nb_channels ) && ( a->freq_start_in_hz == b->freq_start_in_hz ) &&
+           ( a->freq_step_in_hz == b->freq_step_in_hz ) && ( a->rssi_top_in_dbm == b->rssi_top_in_dbm ) &&
+           ( a->rssi_step_in_db == b->rssi_step_in_db ) && ( a->nb_bins == b->nb_bins ) &&
+           ( a->level_max == b->level_max );
+}
+
+static void decode_print_columns( const decode_cfg_t* cfg, const smtc_occupancy_log_page_header_t* header )
+{
+    printf( "session,time_s,samples" );
+    for( uint16_t channel = 0; channel < header->nb_channels; channel++ )
+    {
+        const double freq_in_mhz =
+            ( header->freq_start_in_hz + ( double ) channel * header->freq_step_in_hz ) / 1000000.0;
+
+        if( cfg->is_raw == false )
+        {
+            printf( ",%.3f", freq_in_mhz );
+            continue;
+        }
+        for( uint8_t bin = 0; bin < header->nb_bins; bin++ )
+        {
+            printf( ",%.3f@%d", freq_in_mhz, header->rssi_top_in_dbm - bin * header->rssi_step_in_db );
+        }
+    }
+    printf( "\n" );
+}
+
+static void decode_print_row( const decode_cfg_t* cfg, const smtc_occupancy_log_page_header_t* header,
+                              uint32_t time_in_s, uint32_t nb_samples )
+{
+    printf( "%u,%u,%u", header->session, time_in_s, nb_samples );
+    for( uint16_t channel = 0; channel < header->nb_channels; channel++ )
+    {
+        const uint8_t* channel_levels = &levels[channel * header->nb_bins];
+        uint32_t       occupied       = 0;
+
+        if( cfg->is_raw == true )
+        {
+            for( uint8_t bin = 0; bin < header->nb_bins; bin++ )
+            {
+                printf( ",%u", channel_levels[bin] );
+            }
+            continue;
+        }
+
+        /* A bin counts when its lower edge is at or above the threshold */
+        for( uint8_t bin = 0; bin < header->nb_bins; bin++ )
+        {
+            if( ( header->rssi_top_in_dbm - ( bin + 1 ) * header->rssi_step_in_db ) >= cfg->threshold_in_dbm )
+            {
+                occupied += channel_levels[bin];
+            }
+        }
+        printf( ",%.1f", 100.0 * occupied / header->level_max );
+    }
+    printf( "\n" );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
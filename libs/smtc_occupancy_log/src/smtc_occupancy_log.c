@@ -0,0 +1,729 @@
+/**
+ * @file      smtc_occupancy_log.c
+ *
+ * @brief      Spectrum occupancy log: per-channel RSSI histograms, delta and varint encoded in a ring of NVM pages
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "smtc_occupancy_log.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/**
+ * @brief Round a length up to the NVM write granularity
+ */
+#define SMTC_OCCUPANCY_LOG_ALIGN( length ) \
+    ( ( ( length ) + SMTC_OCCUPANCY_LOG_WRITE_SIZE - 1 ) & ~( uint32_t ) ( SMTC_OCCUPANCY_LOG_WRITE_SIZE - 1 ) )
+
+/**
+ * @brief Size of a record holding a payload of the given length
+ */
+#define SMTC_OCCUPANCY_LOG_RECORD_SIZE( length )                                                  \
+    SMTC_OCCUPANCY_LOG_ALIGN( SMTC_OCCUPANCY_LOG_RECORD_HEADER_SIZE + ( length ) + \
+                              SMTC_OCCUPANCY_LOG_RECORD_CRC_SIZE )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Longest varint, for a 32-bit value
+ */
+#define SMTC_OCCUPANCY_LOG_VARINT_SIZE_MAX 5
+
+/**
+ * @brief Room left at the start of the payload for the time and the sample count, written once the record is complete
+ */
+#define SMTC_OCCUPANCY_LOG_PAYLOAD_PREFIX_SIZE ( 2 * SMTC_OCCUPANCY_LOG_VARINT_SIZE_MAX )
+
+/**
+ * @brief Size of the buffer used to read or dump the NVM by chunks
+ */
+#define SMTC_OCCUPANCY_LOG_CHUNK_SIZE 128
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/**
+ * @brief Nibble lookup table of the CRC-16/CCITT polynomial
+ */
+static const uint16_t crc16_nibble_lut[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Update a CRC-16/CCITT with a buffer
+ *
+ * @param [in] crc CRC of the previous data, 0xFFFF to start
+ * @param [in] buffer Data
+ * @param [in] length Length of the data
+ *
+ * @returns Updated CRC
+ */
+static uint16_t smtc_occupancy_log_crc16( uint16_t crc, const uint8_t* buffer, uint32_t length );
+
+/**
+ * @brief Append a varint to a buffer: 7 bits per byte, least significant group first, MSB set on all bytes but the last
+ *
+ * @returns Number of bytes written
+ */
+static uint8_t smtc_occupancy_log_put_varint( uint8_t* buffer, uint32_t value );
+
+/**
+ * @brief Read a varint
+ *
+ * @param [in] buffer Data
+ * @param [in] length Number of bytes available
+ * @param [in, out] index Position of the varint, moved past it
+ * @param [out] value Value
+ *
+ * @retval true The varint has been read
+ * @retval false The varint runs past the end of the data or does not fit in 32 bits
+ */
+static bool smtc_occupancy_log_get_varint( const uint8_t* buffer, uint32_t length, uint32_t* index, uint32_t* value );
+
+/**
+ * @brief Append a varint to the record being encoded, flagging an overflow if it does not fit
+ */
+static void smtc_occupancy_log_record_put_varint( smtc_occupancy_log_t* log, uint32_t value );
+
+/**
+ * @brief Write the pending run of null differences to the record being encoded
+ */
+static void smtc_occupancy_log_record_flush_zero_run( smtc_occupancy_log_t* log );
+
+/**
+ * @brief Walk the records of a page
+ *
+ * @param [in] log Occupancy log instance
+ * @param [in] page Page
+ * @param [out] used_length Offset following the last record
+ * @param [out] nb_records Number of records, torn ones included
+ */
+static smtc_occupancy_log_status_t smtc_occupancy_log_scan_page( const smtc_occupancy_log_t* log, uint8_t page,
+                                                                 uint16_t* used_length, uint16_t* nb_records );
+
+/**
+ * @brief Erase the next page of the ring and make it the head of the log
+ */
+static smtc_occupancy_log_status_t smtc_occupancy_log_open_next_page( smtc_occupancy_log_t* log, uint32_t time_in_s );
+
+/**
+ * @brief Get the size of the same record with 16-bit bins and a 32-bit time and sample count
+ */
+static uint32_t smtc_occupancy_log_get_raw_record_size( uint16_t nb_channels, uint8_t nb_bins );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+smtc_occupancy_log_status_t smtc_occupancy_log_init( smtc_occupancy_log_t* log, const smtc_occupancy_log_cfg_t* cfg )
+{
+    smtc_occupancy_log_page_header_t header;
+    uint8_t                          data[SMTC_OCCUPANCY_LOG_PAGE_HEADER_SIZE];
+    unsigned int                     nvm_size;
+    bool                             has_head = false;
+    smtc_occupancy_log_status_t      status;
+
+    if( ( log == NULL ) || ( cfg == NULL ) || ( cfg->page_size < 256 ) || ( cfg->page_size > 0x8000 ) ||
+        ( ( cfg->page_size & ( cfg->page_size - 1 ) ) != 0 ) || ( cfg->plan.nb_channels == 0 ) ||
+        ( cfg->plan.nb_bins == 0 ) || ( cfg->plan.nb_bins > SMTC_OCCUPANCY_LOG_NB_BINS_MAX ) ||
+        ( cfg->plan.level_max == 0 ) ||
+        ( smtc_hal_mcu_nvm_get_total_size( cfg->nvm, &nvm_size ) != SMTC_HAL_MCU_STATUS_OK ) ||
+        ( ( nvm_size / cfg->page_size ) < 2 ) || ( ( nvm_size / cfg->page_size ) > SMTC_OCCUPANCY_LOG_NB_PAGES_MAX ) )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_BAD_PARAMETERS;
+    }
+
+    memset( log, 0, sizeof( smtc_occupancy_log_t ) );
+    log->nvm       = cfg->nvm;
+    log->page_size = cfg->page_size;
+    log->nb_pages  = ( uint8_t ) ( nvm_size / cfg->page_size );
+    log->plan      = cfg->plan;
+
+    for( uint8_t page = 0; page < log->nb_pages; page++ )
+    {
+        if( smtc_hal_mcu_nvm_read( log->nvm, page * log->page_size, data, sizeof( data ) ) != SMTC_HAL_MCU_STATUS_OK )
+        {
+            return SMTC_OCCUPANCY_LOG_STATUS_ERROR;
+        }
+        if( smtc_occupancy_log_parse_page_header( data, sizeof( data ), &header ) == false )
+        {
+            continue;
+        }
+
+        status = smtc_occupancy_log_scan_page( log, page, &log->used_length[page], &log->nb_records[page] );
+        if( status != SMTC_OCCUPANCY_LOG_STATUS_OK )
+        {
+            return status;
+        }
+        log->raw_bytes[page] =
+            log->nb_records[page] * smtc_occupancy_log_get_raw_record_size( header.nb_channels, header.nb_bins );
+
+        if( ( has_head == false ) || ( ( int32_t ) ( header.sequence - log->head_sequence ) > 0 ) )
+        {
+            has_head           = true;
+            log->head_page     = page;
+            log->head_sequence = header.sequence;
+        }
+        if( ( int16_t ) ( header.session - log->session ) > 0 )
+        {
+            log->session = header.session;
+        }
+    }
+
+    if( has_head == false )
+    {
+        /* Blank log: the first page opened is page 0 */
+        log->head_page     = log->nb_pages - 1;
+        log->head_sequence = 0;
+    }
+    log->session++;
+    log->stats.session = log->session;
+    log->is_init       = true;
+
+    return SMTC_OCCUPANCY_LOG_STATUS_OK;
+}
+
+smtc_occupancy_log_status_t smtc_occupancy_log_clear( smtc_occupancy_log_t* log )
+{
+    if( ( log == NULL ) || ( log->is_init == false ) )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_NOT_INIT;
+    }
+
+    for( uint8_t page = 0; page < log->nb_pages; page++ )
+    {
+        if( log->used_length[page] == 0 )
+        {
+            continue;
+        }
+        if( smtc_hal_mcu_nvm_erase( log->nvm, page * log->page_size, log->page_size ) != SMTC_HAL_MCU_STATUS_OK )
+        {
+            return SMTC_OCCUPANCY_LOG_STATUS_ERROR;
+        }
+        log->used_length[page] = 0;
+        log->nb_records[page]  = 0;
+        log->raw_bytes[page]   = 0;
+        log->stats.nb_pages_erased++;
+    }
+
+    /* The sequence keeps increasing, the next record opens a new page */
+    log->is_head_open = false;
+
+    return SMTC_OCCUPANCY_LOG_STATUS_OK;
+}
+
+smtc_occupancy_log_status_t smtc_occupancy_log_record_start( smtc_occupancy_log_t* log, uint32_t time_in_s,
+                                                             uint32_t nb_samples )
+{
+    if( ( log == NULL ) || ( log->is_init == false ) )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_NOT_INIT;
+    }
+
+    if( ( log->is_head_open == true ) && ( time_in_s < log->last_time_in_s ) )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_BAD_PARAMETERS;
+    }
+
+    log->record_time_in_s   = time_in_s;
+    log->record_nb_samples  = nb_samples;
+    log->record_length      = SMTC_OCCUPANCY_LOG_RECORD_HEADER_SIZE + SMTC_OCCUPANCY_LOG_PAYLOAD_PREFIX_SIZE;
+    log->record_channel     = 0;
+    log->zero_run           = 0;
+    log->is_record_overflow = false;
+    memset( log->previous_levels, 0, sizeof( log->previous_levels ) );
+
+    return SMTC_OCCUPANCY_LOG_STATUS_OK;
+}
+
+smtc_occupancy_log_status_t smtc_occupancy_log_record_add_channel( smtc_occupancy_log_t* log, const uint16_t* counts )
+{
+    uint32_t total = 0;
+
+    if( ( log == NULL ) || ( log->is_init == false ) )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_NOT_INIT;
+    }
+
+    if( ( counts == NULL ) || ( log->record_length == 0 ) || ( log->record_channel >= log->plan.nb_channels ) )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_BAD_PARAMETERS;
+    }
+
+    for( uint8_t bin = 0; bin < log->plan.nb_bins; bin++ )
+    {
+        total += counts[bin];
+    }
+
+    for( uint8_t bin = 0; bin < log->plan.nb_bins; bin++ )
+    {
+        uint8_t  level = 0;
+        int16_t  delta;
+        uint32_t zigzag;
+
+        if( total != 0 )
+        {
+            level = ( uint8_t ) ( ( counts[bin] * ( uint32_t ) log->plan.level_max + total / 2 ) / total );
+        }
+        delta = ( int16_t ) level - ( int16_t ) log->previous_levels[bin];
+
+        log->previous_levels[bin] = level;
+        if( delta == 0 )
+        {
+            log->zero_run++;
+            continue;
+        }
+
+        /* Zigzag mapping, so that small differences of both signs give short varints */
+        zigzag = ( uint32_t ) ( ( delta < 0 ) ? ( -2 * delta - 1 ) : ( 2 * delta ) );
+        smtc_occupancy_log_record_flush_zero_run( log );
+        smtc_occupancy_log_record_put_varint( log, zigzag << 1 );
+    }
+    log->record_channel++;
+
+    return SMTC_OCCUPANCY_LOG_STATUS_OK;
+}
+
+smtc_occupancy_log_status_t smtc_occupancy_log_record_end( smtc_occupancy_log_t* log )
+{
+    uint8_t                     prefix[SMTC_OCCUPANCY_LOG_PAYLOAD_PREFIX_SIZE];
+    uint8_t                     prefix_length;
+    uint16_t                    payload_length;
+    uint32_t                    crc_offset;
+    uint32_t                    record_size;
+    uint16_t                    crc;
+    bool                        is_new_page = false;
+    smtc_occupancy_log_status_t status;
+
+    if( ( log == NULL ) || ( log->is_init == false ) )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_NOT_INIT;
+    }
+
+    if( ( log->record_length == 0 ) || ( log->record_channel != log->plan.nb_channels ) )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_BAD_PARAMETERS;
+    }
+
+    smtc_occupancy_log_record_flush_zero_run( log );
+
+    /* The time is relative to the previous record of the page: find out first whether a new page is needed */
+    payload_length = log->record_length - SMTC_OCCUPANCY_LOG_RECORD_HEADER_SIZE;
+    record_size    = SMTC_OCCUPANCY_LOG_RECORD_SIZE( payload_length );
+    payload_length -= SMTC_OCCUPANCY_LOG_PAYLOAD_PREFIX_SIZE;
+    if( ( log->is_head_open == false ) ||
+        ( ( log->used_length[log->head_page] + record_size ) > log->page_size ) )
+    {
+        is_new_page = true;
+    }
+
+    prefix_length = smtc_occupancy_log_put_varint( prefix, ( is_new_page == true )
+                                                               ? 0
+                                                               : ( log->record_time_in_s - log->last_time_in_s ) );
+    prefix_length += smtc_occupancy_log_put_varint( &prefix[prefix_length], log->record_nb_samples );
+    payload_length += prefix_length;
+    record_size = SMTC_OCCUPANCY_LOG_RECORD_SIZE( payload_length );
+
+    log->record_length = 0;
+    if( ( log->is_record_overflow == true ) || ( record_size > SMTC_OCCUPANCY_LOG_RECORD_SIZE_MAX ) ||
+        ( record_size > ( log->page_size - SMTC_OCCUPANCY_LOG_PAGE_HEADER_SIZE ) ) )
+    {
+        log->stats.nb_records_dropped++;
+        return SMTC_OCCUPANCY_LOG_STATUS_NO_SPACE;
+    }
+
+    /* Move the levels next to the prefix, then complete the header, CRC and padding */
+    memmove( &log->record[SMTC_OCCUPANCY_LOG_RECORD_HEADER_SIZE + prefix_length],
+             &log->record[SMTC_OCCUPANCY_LOG_RECORD_HEADER_SIZE + SMTC_OCCUPANCY_LOG_PAYLOAD_PREFIX_SIZE],
+             payload_length - prefix_length );
+    memcpy( &log->record[SMTC_OCCUPANCY_LOG_RECORD_HEADER_SIZE], prefix, prefix_length );
+    log->record[0] = SMTC_OCCUPANCY_LOG_RECORD_MARKER;
+    log->record[1] = 0;
+    log->record[2] = ( uint8_t ) payload_length;
+    log->record[3] = ( uint8_t ) ( payload_length >> 8 );
+    crc_offset     = SMTC_OCCUPANCY_LOG_RECORD_HEADER_SIZE + payload_length;
+    crc            = smtc_occupancy_log_crc16( 0xFFFF, log->record, crc_offset );
+    log->record[crc_offset]     = ( uint8_t ) crc;
+    log->record[crc_offset + 1] = ( uint8_t ) ( crc >> 8 );
+    memset( &log->record[crc_offset + SMTC_OCCUPANCY_LOG_RECORD_CRC_SIZE], 0xFF,
+            record_size - ( crc_offset + SMTC_OCCUPANCY_LOG_RECORD_CRC_SIZE ) );
+
+    if( is_new_page == true )
+    {
+        status = smtc_occupancy_log_open_next_page( log, log->record_time_in_s );
+        if( status != SMTC_OCCUPANCY_LOG_STATUS_OK )
+        {
+            return status;
+        }
+    }
+
+    if( smtc_hal_mcu_nvm_write( log->nvm, log->head_page * log->page_size + log->used_length[log->head_page],
+                                log->record, record_size ) != SMTC_HAL_MCU_STATUS_OK )
+    {
+        /* Never program the same double words twice: move on to a new page */
+        log->is_head_open = false;
+        return SMTC_OCCUPANCY_LOG_STATUS_ERROR;
+    }
+
+    log->used_length[log->head_page] += record_size;
+    log->nb_records[log->head_page]++;
+    log->raw_bytes[log->head_page] +=
+        smtc_occupancy_log_get_raw_record_size( log->plan.nb_channels, log->plan.nb_bins );
+    log->last_time_in_s = log->record_time_in_s;
+    log->stats.nb_records_appended++;
+
+    return SMTC_OCCUPANCY_LOG_STATUS_OK;
+}
+
+smtc_occupancy_log_status_t smtc_occupancy_log_dump( const smtc_occupancy_log_t* log,
+                                                     smtc_occupancy_log_write_t  write )
+{
+    uint8_t chunk[SMTC_OCCUPANCY_LOG_CHUNK_SIZE];
+
+    if( ( log == NULL ) || ( log->is_init == false ) )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_NOT_INIT;
+    }
+
+    /* Pages are opened in ring order, so the oldest one follows the head */
+    for( uint8_t i = 1; i <= log->nb_pages; i++ )
+    {
+        const uint8_t page = ( log->head_page + i ) % log->nb_pages;
+
+        for( uint32_t offset = 0; offset < log->used_length[page]; offset += sizeof( chunk ) )
+        {
+            const uint32_t length = ( ( log->used_length[page] - offset ) < sizeof( chunk ) )
+                                        ? ( log->used_length[page] - offset )
+                                        : sizeof( chunk );
+
+            if( smtc_hal_mcu_nvm_read( log->nvm, page * log->page_size + offset, chunk, length ) !=
+                SMTC_HAL_MCU_STATUS_OK )
+            {
+                return SMTC_OCCUPANCY_LOG_STATUS_ERROR;
+            }
+            write( chunk, ( uint16_t ) length );
+        }
+    }
+
+    return SMTC_OCCUPANCY_LOG_STATUS_OK;
+}
+
+void smtc_occupancy_log_get_stats( const smtc_occupancy_log_t* log, smtc_occupancy_log_stats_t* stats )
+{
+    *stats               = log->stats;
+    stats->nb_pages      = log->nb_pages;
+    stats->nb_pages_used = 0;
+    stats->nb_records    = 0;
+    stats->stored_bytes  = 0;
+    stats->raw_bytes     = 0;
+
+    for( uint8_t page = 0; page < log->nb_pages; page++ )
+    {
+        if( log->used_length[page] != 0 )
+        {
+            stats->nb_pages_used++;
+            stats->nb_records += log->nb_records[page];
+            stats->stored_bytes += log->used_length[page];
+            stats->raw_bytes += log->raw_bytes[page];
+        }
+    }
+}
+
+bool smtc_occupancy_log_parse_page_header( const uint8_t* data, uint32_t length,
+                                           smtc_occupancy_log_page_header_t* header )
+{
+    uint16_t crc;
+
+    if( length < SMTC_OCCUPANCY_LOG_PAGE_HEADER_SIZE )
+    {
+        return false;
+    }
+
+    memcpy( header, data, sizeof( smtc_occupancy_log_page_header_t ) );
+    crc = smtc_occupancy_log_crc16( 0xFFFF, data, offsetof( smtc_occupancy_log_page_header_t, crc ) );
+
+    return ( header->magic == SMTC_OCCUPANCY_LOG_PAGE_MAGIC ) && ( header->crc == crc ) &&
+           ( header->nb_channels != 0 ) && ( header->nb_bins != 0 ) && ( header->level_max != 0 );
+}
+
+smtc_occupancy_log_status_t smtc_occupancy_log_decode_record( const smtc_occupancy_log_page_header_t* header,
+                                                              const uint8_t* data, uint32_t length,
+                                                              uint32_t* record_size, uint32_t* time_delta_in_s,
+                                                              uint32_t* nb_samples, uint8_t* levels )
+{
+    const uint32_t nb_levels = ( uint32_t ) header->nb_channels * header->nb_bins;
+    uint32_t       payload_length;
+    uint32_t       payload_end;
+    uint32_t       index = SMTC_OCCUPANCY_LOG_RECORD_HEADER_SIZE;
+    uint32_t       level = 0;
+    uint32_t       value;
+
+    if( ( length < SMTC_OCCUPANCY_LOG_RECORD_HEADER_SIZE ) || ( data[0] != SMTC_OCCUPANCY_LOG_RECORD_MARKER ) )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_NO_SPACE;
+    }
+
+    payload_length = data[2] | ( ( uint32_t ) data[3] << 8 );
+    payload_end    = SMTC_OCCUPANCY_LOG_RECORD_HEADER_SIZE + payload_length;
+    *record_size   = SMTC_OCCUPANCY_LOG_RECORD_SIZE( payload_length );
+    if( ( *record_size > length ) || ( smtc_occupancy_log_crc16( 0xFFFF, data, payload_end ) !=
+                                       ( data[payload_end] | ( data[payload_end + 1] << 8 ) ) ) )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_CORRUPTED;
+    }
+
+    if( ( smtc_occupancy_log_get_varint( data, payload_end, &index, time_delta_in_s ) == false ) ||
+        ( smtc_occupancy_log_get_varint( data, payload_end, &index, nb_samples ) == false ) )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_CORRUPTED;
+    }
+
+    /* Each level is coded as its difference with the same bin of the previous channel */
+    while( level < nb_levels )
+    {
+        if( smtc_occupancy_log_get_varint( data, payload_end, &index, &value ) == false )
+        {
+            return SMTC_OCCUPANCY_LOG_STATUS_CORRUPTED;
+        }
+
+        if( ( value & 1 ) != 0 )
+        {
+            /* Run of null differences */
+            value >>= 1;
+            if( value >= ( nb_levels - level ) )
+            {
+                return SMTC_OCCUPANCY_LOG_STATUS_CORRUPTED;
+            }
+            for( uint32_t i = 0; i <= value; i++, level++ )
+            {
+                levels[level] = ( level < header->nb_bins ) ? 0 : levels[level - header->nb_bins];
+            }
+        }
+        else
+        {
+            const uint32_t zigzag   = value >> 1;
+            const int32_t  delta    = ( int32_t ) ( zigzag >> 1 ) ^ -( int32_t ) ( zigzag & 1 );
+            const int32_t  previous = ( level < header->nb_bins ) ? 0 : levels[level - header->nb_bins];
+
+            if( ( delta == 0 ) || ( ( previous + delta ) < 0 ) || ( ( previous + delta ) > header->level_max ) )
+            {
+                return SMTC_OCCUPANCY_LOG_STATUS_CORRUPTED;
+            }
+            levels[level++] = ( uint8_t ) ( previous + delta );
+        }
+    }
+
+    return ( index == payload_end ) ? SMTC_OCCUPANCY_LOG_STATUS_OK : SMTC_OCCUPANCY_LOG_STATUS_CORRUPTED;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint16_t smtc_occupancy_log_crc16( uint16_t crc, const uint8_t* buffer, uint32_t length )
+{
+    for( uint32_t i = 0; i < length; i++ )
+    {
+        crc = ( uint16_t ) ( crc << 4 ) ^ crc16_nibble_lut[( crc >> 12 ) ^ ( buffer[i] >> 4 )];
+        crc = ( uint16_t ) ( crc << 4 ) ^ crc16_nibble_lut[( crc >> 12 ) ^ ( buffer[i] & 0x0F )];
+    }
+
+    return crc;
+}
+
+static uint8_t smtc_occupancy_log_put_varint( uint8_t* buffer, uint32_t value )
+{
+    uint8_t length = 0;
+
+    while( value >= 0x80 )
+    {
+        buffer[length++] = ( uint8_t ) ( value | 0x80 );
+        value >>= 7;
+    }
+    buffer[length++] = ( uint8_t ) value;
+
+    return length;
+}
+
+static bool smtc_occupancy_log_get_varint( const uint8_t* buffer, uint32_t length, uint32_t* index, uint32_t* value )
+{
+    *value = 0;
+
+    for( uint8_t shift = 0; shift < 35; shift += 7 )
+    {
+        uint8_t byte;
+
+        if( *index >= length )
+        {
+            return false;
+        }
+        byte = buffer[( *index )++];
+        *value |= ( uint32_t ) ( byte & 0x7F ) << shift;
+        if( ( byte & 0x80 ) == 0 )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void smtc_occupancy_log_record_put_varint( smtc_occupancy_log_t* log, uint32_t value )
+{
+    /* Keep room for the CRC */
+    if( ( log->record_length + SMTC_OCCUPANCY_LOG_VARINT_SIZE_MAX + SMTC_OCCUPANCY_LOG_RECORD_CRC_SIZE ) >
+        SMTC_OCCUPANCY_LOG_RECORD_SIZE_MAX )
+    {
+        log->is_record_overflow = true;
+        return;
+    }
+
+    log->record_length += smtc_occupancy_log_put_varint( &log->record[log->record_length], value );
+}
+
+static void smtc_occupancy_log_record_flush_zero_run( smtc_occupancy_log_t* log )
+{
+    if( log->zero_run > 0 )
+    {
+        smtc_occupancy_log_record_put_varint( log, ( ( uint32_t ) ( log->zero_run - 1 ) << 1 ) | 1 );
+        log->zero_run = 0;
+    }
+}
+
+static smtc_occupancy_log_status_t smtc_occupancy_log_scan_page( const smtc_occupancy_log_t* log, uint8_t page,
+                                                                 uint16_t* used_length, uint16_t* nb_records )
+{
+    uint8_t  header[SMTC_OCCUPANCY_LOG_RECORD_HEADER_SIZE];
+    uint32_t offset = SMTC_OCCUPANCY_LOG_PAGE_HEADER_SIZE;
+
+    *nb_records = 0;
+    while( ( offset + SMTC_OCCUPANCY_LOG_RECORD_HEADER_SIZE ) <= log->page_size )
+    {
+        uint32_t record_size;
+
+        if( smtc_hal_mcu_nvm_read( log->nvm, page * log->page_size + offset, header, sizeof( header ) ) !=
+            SMTC_HAL_MCU_STATUS_OK )
+        {
+            return SMTC_OCCUPANCY_LOG_STATUS_ERROR;
+        }
+
+        /* Records are written in one go: a blank or garbled marker ends the page */
+        record_size = SMTC_OCCUPANCY_LOG_RECORD_SIZE( header[2] | ( ( uint32_t ) header[3] << 8 ) );
+        if( ( header[0] != SMTC_OCCUPANCY_LOG_RECORD_MARKER ) || ( ( offset + record_size ) > log->page_size ) )
+        {
+            break;
+        }
+        offset += record_size;
+        ( *nb_records )++;
+    }
+    *used_length = ( uint16_t ) offset;
+
+    return SMTC_OCCUPANCY_LOG_STATUS_OK;
+}
+
+static smtc_occupancy_log_status_t smtc_occupancy_log_open_next_page( smtc_occupancy_log_t* log, uint32_t time_in_s )
+{
+    smtc_occupancy_log_page_header_t header;
+    const uint8_t                    page = ( log->head_page + 1 ) % log->nb_pages;
+
+    if( smtc_hal_mcu_nvm_erase( log->nvm, page * log->page_size, log->page_size ) != SMTC_HAL_MCU_STATUS_OK )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_ERROR;
+    }
+    log->stats.nb_pages_erased++;
+    log->used_length[page] = 0;
+    log->nb_records[page]  = 0;
+    log->raw_bytes[page]   = 0;
+
+    memset( &header, 0, sizeof( header ) );
+    header.magic              = SMTC_OCCUPANCY_LOG_PAGE_MAGIC;
+    header.sequence           = log->head_sequence + 1;
+    header.base_time_in_s     = time_in_s;
+    header.session            = log->session;
+    header.nb_channels        = log->plan.nb_channels;
+    header.freq_start_in_hz   = log->plan.freq_start_in_hz;
+    header.freq_step_in_hz    = log->plan.freq_step_in_hz;
+    header.rssi_top_in_dbm    = log->plan.rssi_top_in_dbm;
+    header.rssi_step_in_db    = log->plan.rssi_step_in_db;
+    header.nb_bins            = log->plan.nb_bins;
+    header.level_max          = log->plan.level_max;
+    header.record_period_in_s = log->plan.record_period_in_s;
+    header.crc                = smtc_occupancy_log_crc16( 0xFFFF, ( const uint8_t* ) &header,
+                                                          offsetof( smtc_occupancy_log_page_header_t, crc ) );
+
+    if( smtc_hal_mcu_nvm_write( log->nvm, page * log->page_size, ( const uint8_t* ) &header, sizeof( header ) ) !=
+        SMTC_HAL_MCU_STATUS_OK )
+    {
+        return SMTC_OCCUPANCY_LOG_STATUS_ERROR;
+    }
+
+    log->head_page         = page;
+    log->head_sequence     = header.sequence;
+    log->is_head_open      = true;
+    log->last_time_in_s    = time_in_s;
+    log->used_length[page] = SMTC_OCCUPANCY_LOG_PAGE_HEADER_SIZE;
+
+    return SMTC_OCCUPANCY_LOG_STATUS_OK;
+}
+
+static uint32_t smtc_occupancy_log_get_raw_record_size( uint16_t nb_channels, uint8_t nb_bins )
+{
+    return 8 + ( uint32_t ) nb_channels * nb_bins * sizeof( uint16_t );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,373 @@
+/**
+ * @file      smtc_occupancy_log.h
+ *
+ * @brief      Spectrum occupancy log: per-channel RSSI histograms, delta and varint encoded in a ring of NVM pages
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMTC_OCCUPANCY_LOG_H
+#define SMTC_OCCUPANCY_LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "smtc_hal_mcu_nvm.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/**
+ * @brief Maximum number of pages the NVM area can be split into
+ */
+#ifndef SMTC_OCCUPANCY_LOG_NB_PAGES_MAX
+#define SMTC_OCCUPANCY_LOG_NB_PAGES_MAX 64
+#endif
+
+/**
+ * @brief Maximum number of RSSI bins of a histogram
+ */
+#ifndef SMTC_OCCUPANCY_LOG_NB_BINS_MAX
+#define SMTC_OCCUPANCY_LOG_NB_BINS_MAX 64
+#endif
+
+/**
+ * @brief Size of the buffer holding a record while it is encoded, header and padding included
+ */
+#ifndef SMTC_OCCUPANCY_LOG_RECORD_SIZE_MAX
+#define SMTC_OCCUPANCY_LOG_RECORD_SIZE_MAX 1024
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Value identifying the header of a page
+ */
+#define SMTC_OCCUPANCY_LOG_PAGE_MAGIC 0x3143434FU
+
+/**
+ * @brief Size of the header at the beginning of each page
+ */
+#define SMTC_OCCUPANCY_LOG_PAGE_HEADER_SIZE 32
+
+/**
+ * @brief First byte of a record
+ */
+#define SMTC_OCCUPANCY_LOG_RECORD_MARKER 0x52
+
+/**
+ * @brief Size of the header of a record: marker, reserved byte and payload length
+ */
+#define SMTC_OCCUPANCY_LOG_RECORD_HEADER_SIZE 4
+
+/**
+ * @brief Size of the CRC following the payload of a record
+ */
+#define SMTC_OCCUPANCY_LOG_RECORD_CRC_SIZE 2
+
+/**
+ * @brief NVM write granularity, records are padded with 0xFF up to a multiple of it
+ */
+#define SMTC_OCCUPANCY_LOG_WRITE_SIZE 8
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Occupancy log status codes
+ */
+typedef enum smtc_occupancy_log_status_e
+{
+    SMTC_OCCUPANCY_LOG_STATUS_OK = 0,          //!< Operation completed successfully
+    SMTC_OCCUPANCY_LOG_STATUS_NO_SPACE,        //!< The record does not fit in a page or in the encoding buffer
+    SMTC_OCCUPANCY_LOG_STATUS_BAD_PARAMETERS,  //!< At least one parameter has an incorrect value
+    SMTC_OCCUPANCY_LOG_STATUS_NOT_INIT,        //!< The log is not initialised
+    SMTC_OCCUPANCY_LOG_STATUS_CORRUPTED,       //!< The data does not decode, or its CRC does not match
+    SMTC_OCCUPANCY_LOG_STATUS_ERROR,           //!< The NVM reported an error
+} smtc_occupancy_log_status_t;
+
+/**
+ * @brief Channel plan and histogram layout of the records
+ */
+typedef struct smtc_occupancy_log_plan_s
+{
+    uint32_t freq_start_in_hz;
+    uint32_t freq_step_in_hz;
+    uint16_t nb_channels;
+    int8_t   rssi_top_in_dbm;     //!< Top of the first bin: higher samples are counted in it
+    uint8_t  rssi_step_in_db;     //!< Width of a bin
+    uint8_t  nb_bins;             //!< Number of bins: lower samples are counted in the last one
+    uint8_t  level_max;           //!< Full scale of the levels: the levels of a channel add up to about this value
+    uint16_t record_period_in_s;  //!< Time covered by a record, for information only
+} smtc_occupancy_log_plan_t;
+
+/**
+ * @brief Occupancy log configuration
+ */
+typedef struct smtc_occupancy_log_cfg_s
+{
+    smtc_hal_mcu_nvm_inst_t   nvm;        //!< NVM instance backing the log
+    uint32_t                  page_size;  //!< Size of a page: a power of two multiple of the NVM erase size
+    smtc_occupancy_log_plan_t plan;       //!< Layout of the records appended from now on
+} smtc_occupancy_log_cfg_t;
+
+/**
+ * @brief Header written at the beginning of a page when it becomes the head of the log
+ *
+ * @remark Stored as laid out in memory: all fields are little-endian and naturally aligned. Each page carries the plan
+ * of its records, so that a page can be decoded on its own once the older ones have been overwritten.
+ */
+typedef struct smtc_occupancy_log_page_header_s
+{
+    uint32_t magic;               //!< SMTC_OCCUPANCY_LOG_PAGE_MAGIC
+    uint32_t sequence;            //!< Position of the page in the log, incremented at each new head
+    uint32_t base_time_in_s;      //!< Time of the first record of the page, in seconds since the start of the session
+    uint16_t session;             //!< Incremented at each initialisation: the time restarts from 0
+    uint16_t nb_channels;         //!< See smtc_occupancy_log_plan_t
+    uint32_t freq_start_in_hz;    //!< See smtc_occupancy_log_plan_t
+    uint32_t freq_step_in_hz;     //!< See smtc_occupancy_log_plan_t
+    int8_t   rssi_top_in_dbm;     //!< See smtc_occupancy_log_plan_t
+    uint8_t  rssi_step_in_db;     //!< See smtc_occupancy_log_plan_t
+    uint8_t  nb_bins;             //!< See smtc_occupancy_log_plan_t
+    uint8_t  level_max;           //!< See smtc_occupancy_log_plan_t
+    uint16_t record_period_in_s;  //!< See smtc_occupancy_log_plan_t
+    uint16_t crc;                 //!< CRC-16/CCITT-FALSE of the fields above
+} smtc_occupancy_log_page_header_t;
+
+/**
+ * @brief Occupancy log statistics
+ */
+typedef struct smtc_occupancy_log_stats_s
+{
+    uint32_t nb_pages;             //!< Number of pages of the NVM area
+    uint32_t nb_pages_used;        //!< Number of pages holding a header
+    uint32_t nb_records;           //!< Number of records in the NVM
+    uint32_t stored_bytes;         //!< Bytes of all used pages up to their last record, i.e. the size of a dump
+    uint32_t raw_bytes;            //!< Size of the same records with 16-bit bins and a 32-bit time and sample count
+    uint32_t nb_records_appended;  //!< Records appended since the initialisation
+    uint32_t nb_records_dropped;   //!< Records too large to be stored, dropped since the initialisation
+    uint32_t nb_pages_erased;      //!< Pages erased since the initialisation, the oldest records being lost
+    uint16_t session;              //!< Current session
+} smtc_occupancy_log_stats_t;
+
+/**
+ * @brief Occupancy log instance
+ *
+ * @remark Allocated by the caller, all fields are private
+ */
+typedef struct smtc_occupancy_log_s
+{
+    bool                       is_init;
+    smtc_hal_mcu_nvm_inst_t    nvm;
+    uint32_t                   page_size;
+    uint8_t                    nb_pages;
+    smtc_occupancy_log_plan_t  plan;
+    uint16_t                   session;
+    bool                       is_head_open;    //!< A page has been opened during this session
+    uint8_t                    head_page;       //!< Page of the highest sequence
+    uint32_t                   head_sequence;   //!< Sequence of the head page
+    uint32_t                   last_time_in_s;  //!< Time of the last record of the head page
+    uint16_t                   used_length[SMTC_OCCUPANCY_LOG_NB_PAGES_MAX];  //!< Up to the last record, 0 if blank
+    uint16_t                   nb_records[SMTC_OCCUPANCY_LOG_NB_PAGES_MAX];   //!< Records in each page
+    uint32_t                   raw_bytes[SMTC_OCCUPANCY_LOG_NB_PAGES_MAX];    //!< Raw size of the page records
+    uint8_t                    record[SMTC_OCCUPANCY_LOG_RECORD_SIZE_MAX];    //!< Record being encoded
+    uint32_t                   record_time_in_s;    //!< Time of the record being encoded
+    uint32_t                   record_nb_samples;   //!< Samples per channel of the record being encoded
+    uint16_t                   record_length;       //!< Bytes of the record encoded so far
+    uint16_t                   record_channel;      //!< Number of channels added to the record
+    uint16_t                   zero_run;            //!< Null differences not written yet
+    bool                       is_record_overflow;  //!< The record does not fit in the buffer
+    uint8_t                    previous_levels[SMTC_OCCUPANCY_LOG_NB_BINS_MAX];  //!< Levels of the previous channel
+    smtc_occupancy_log_stats_t stats;
+} smtc_occupancy_log_t;
+
+/**
+ * @brief Function receiving the bytes of a dump
+ *
+ * @param [in] data Bytes
+ * @param [in] length Number of bytes
+ */
+typedef void ( *smtc_occupancy_log_write_t )( const uint8_t* data, uint16_t length );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Mount the log and start a new session
+ *
+ * The page headers are read to find the newest page, and the records of each page are walked to know how much of it is
+ * used. The first record of the session opens a new page, so each page holds the records of a single session and plan.
+ *
+ * @param [out] log Occupancy log instance
+ * @param [in] cfg Configuration
+ *
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_OK The log is ready
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_BAD_PARAMETERS The configuration does not fit the NVM or the limits above
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_ERROR The NVM reported an error
+ */
+smtc_occupancy_log_status_t smtc_occupancy_log_init( smtc_occupancy_log_t* log, const smtc_occupancy_log_cfg_t* cfg );
+
+/**
+ * @brief Erase all records
+ *
+ * @param [in, out] log Occupancy log instance
+ *
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_OK The log is empty
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_NOT_INIT The log is not initialised
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_ERROR The NVM reported an error
+ */
+smtc_occupancy_log_status_t smtc_occupancy_log_clear( smtc_occupancy_log_t* log );
+
+/**
+ * @brief Start a record
+ *
+ * @param [in, out] log Occupancy log instance
+ * @param [in] time_in_s Time at the end of the period covered by the record, in seconds since the initialisation
+ * @param [in] nb_samples Number of samples taken on each channel during the period
+ *
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_OK The record is started, the channels are expected next
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_BAD_PARAMETERS The time is older than the one of the previous record
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_NOT_INIT The log is not initialised
+ */
+smtc_occupancy_log_status_t smtc_occupancy_log_record_start( smtc_occupancy_log_t* log, uint32_t time_in_s,
+                                                             uint32_t nb_samples );
+
+/**
+ * @brief Add the histogram of the next channel to the record
+ *
+ * The counts are scaled to levels adding up to the level full scale of the plan, and each level is replaced by its
+ * difference with the same bin of the previous channel. The differences are written as varints, the low bit telling a
+ * single non-null difference (zigzag mapped, in the upper bits) from a run of null ones (length minus one, in the upper
+ * bits): a quiet channel next to a similar one often costs a single byte.
+ *
+ * @param [in, out] log Occupancy log instance
+ * @param [in] counts Samples counted in each bin, plan.nb_bins values
+ *
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_OK The channel has been encoded
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_BAD_PARAMETERS No record is started, or all its channels have been added
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_NOT_INIT The log is not initialised
+ */
+smtc_occupancy_log_status_t smtc_occupancy_log_record_add_channel( smtc_occupancy_log_t* log, const uint16_t* counts );
+
+/**
+ * @brief Write the record to the NVM
+ *
+ * When the head page is full, the next page of the ring is erased and becomes the head: the records of the oldest page
+ * are lost.
+ *
+ * @param [in, out] log Occupancy log instance
+ *
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_OK The record has been written
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_NO_SPACE The record does not fit in the encoding buffer or in a page, it is dropped
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_BAD_PARAMETERS Not all the channels have been added
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_NOT_INIT The log is not initialised
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_ERROR The NVM reported an error
+ */
+smtc_occupancy_log_status_t smtc_occupancy_log_record_end( smtc_occupancy_log_t* log );
+
+/**
+ * @brief Send the used part of each page, oldest page first
+ *
+ * @param [in] log Occupancy log instance
+ * @param [in] write Function receiving the bytes
+ *
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_OK All the pages have been sent, stats.stored_bytes in total
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_NOT_INIT The log is not initialised
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_ERROR The NVM reported an error
+ */
+smtc_occupancy_log_status_t smtc_occupancy_log_dump( const smtc_occupancy_log_t* log,
+                                                     smtc_occupancy_log_write_t  write );
+
+/**
+ * @brief Get the statistics of the log
+ *
+ * @param [in] log Occupancy log instance
+ * @param [out] stats Statistics
+ */
+void smtc_occupancy_log_get_stats( const smtc_occupancy_log_t* log, smtc_occupancy_log_stats_t* stats );
+
+/**
+ * @brief Check a page header
+ *
+ * @param [in] data Bytes starting with the header
+ * @param [in] length Number of bytes available
+ * @param [out] header Header
+ *
+ * @retval true The header is valid
+ * @retval false The bytes do not hold a valid header
+ */
+bool smtc_occupancy_log_parse_page_header( const uint8_t* data, uint32_t length,
+                                           smtc_occupancy_log_page_header_t* header );
+
+/**
+ * @brief Decode a record
+ *
+ * @param [in] header Header of the page holding the record
+ * @param [in] data Bytes starting with the record
+ * @param [in] length Number of bytes available
+ * @param [out] record_size Size of the record, padding included - set whenever the record header is valid, so that the
+ * next record can be reached even if this one is corrupted
+ * @param [out] time_delta_in_s Time since the previous record of the page, or since the page base time for the first
+ * one
+ * @param [out] nb_samples Number of samples taken on each channel
+ * @param [out] levels Levels, header->nb_channels times header->nb_bins values, channel after channel
+ *
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_OK The record has been decoded
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_NO_SPACE There is no record at the start of the bytes: end of the page
+ * @retval SMTC_OCCUPANCY_LOG_STATUS_CORRUPTED The record is torn or corrupted
+ */
+smtc_occupancy_log_status_t smtc_occupancy_log_decode_record( const smtc_occupancy_log_page_header_t* header,
+                                                              const uint8_t* data, uint32_t length,
+                                                              uint32_t* record_size, uint32_t* time_delta_in_s,
+                                                              uint32_t* nb_samples, uint8_t* levels );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SMTC_OCCUPANCY_LOG_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,554 @@
+/**
+ * @file      smtc_time_sync_sim.c
+ *
+ * @brief      Host simulation of the time synchronisation over a simulated radio link: achieved sync error
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "smtc_time_sync.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#define SIM_PI 3.14159265358979323846
+
+/**
+ * @brief Radio configuration of the simulated link: LoRa SF7, BW 125 kHz, 7-byte beacon
+ */
+#define SIM_SYMBOL_IN_US 1024.0
+#define SIM_TIME_ON_AIR_IN_US 36096.0
+
+/**
+ * @brief TX and RX timing models of the radio, as applied by the firmware
+ *
+ * @remark Same formulas as lr11xx_radio_timings / sx126x_radio_timings for SF7 BW125 and a 40 us PA ramp
+ */
+#define SIM_TX_DONE_MODEL_IN_US ( 40.0 + 111.0 )
+#define SIM_RX_DONE_MODEL_IN_US ( 57.0 + 2.0 * SIM_SYMBOL_IN_US + 74.0 )
+
+/**
+ * @brief Difference between the actual radio delays and the models, assumed for an uncharacterised chip
+ */
+#define SIM_TX_DONE_BIAS_IN_US 3.0
+#define SIM_RX_DONE_BIAS_IN_US 5.0
+
+/**
+ * @brief Standard deviation of the RX_DONE instant around its mean: LoRa demodulator timing uncertainty
+ */
+#define SIM_RX_DONE_JITTER_IN_US 2.0
+
+/**
+ * @brief Standard deviation of the DIO edge stamp: cycle counter to microsecond conversion and TX_DONE jitter
+ */
+#define SIM_EDGE_STAMP_JITTER_IN_US 0.3
+
+/**
+ * @brief Latency between the DIO edge and the main loop handler, when the timestamp is read there
+ */
+#define SIM_DISPATCH_LATENCY_MIN_IN_US 50.0
+#define SIM_DISPATCH_LATENCY_MAX_IN_US 400.0
+
+/**
+ * @brief Occasional extra dispatch latency: the main loop busy with a trace, a flash write or a long SPI transfer
+ */
+#define SIM_DISPATCH_STALL_PROBABILITY 0.02
+#define SIM_DISPATCH_STALL_MAX_IN_US 8000.0
+
+/**
+ * @brief Propagation delay over 1 km, not corrected
+ */
+#define SIM_PROPAGATION_IN_US 3.3
+
+/**
+ * @brief Beacon loss probability on the follower side
+ */
+#define SIM_BEACON_LOSS_PROBABILITY 0.05
+
+/**
+ * @brief Random walk of the follower crystal frequency, in ppm per square root of second (temperature changes)
+ */
+#define SIM_WANDER_IN_PPM_PER_SQRT_S 0.005
+
+/**
+ * @brief STM32L4 Stop 2 time base: the microsecond timer is stopped and the time spent in Stop 2 is added back from
+ * the RTC, clocked by the LSI without asynchronous prescaler and converted with its nominal frequency
+ *
+ * The LSI is only accurate to a few percent (31.04 to 32.96 kHz) and drifts with temperature and supply
+ */
+#define SIM_LSI_NOMINAL_IN_HZ 32000.0
+#define SIM_LSI_ACCURACY_IN_PPM 30000.0
+#define SIM_LSI_WANDER_IN_PPM_PER_SQRT_S 20.0
+
+/**
+ * @brief Follower schedule over a beacon period when it may enter Stop 2: awake from the RX window opening to the
+ * beacon handling, then from the slot wake-up margin to the end of the slot frame
+ */
+#define SIM_RX_WINDOW_GUARD_IN_US 20000.0
+#define SIM_AWAKE_AFTER_BEACON_IN_US 2000.0
+#define SIM_SLOT_POINT 0.5
+#define SIM_SLOT_WAKE_UP_MARGIN_IN_US 3000.0
+#define SIM_SLOT_AWAKE_IN_US ( SIM_TIME_ON_AIR_IN_US + 2000.0 )
+
+/**
+ * @brief Fraction of the beacon period after a beacon at which the error is measured: the worst case, just before
+ * the next beacon
+ */
+#define SIM_MEASURE_POINT 0.9
+
+/**
+ * @brief Number of beacons ignored at the start of a run while the estimators converge
+ */
+#define SIM_WARMUP_NB_BEACONS ( SMTC_TIME_SYNC_WINDOW_SIZE + 2 )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Synchronisation methods compared
+ */
+typedef enum sim_method_e
+{
+    SIM_METHOD_NAIVE = 0,    //!< Timestamps read in the main loop, offset of the last pair only
+    SIM_METHOD_OFFSET_ONLY,  //!< DIO edge timestamps corrected by the timing models, offset of the last pair only
+    SIM_METHOD_FULL,         //!< DIO edge timestamps corrected by the timing models, smtc_time_sync drift estimation
+    SIM_METHOD_FULL_STOP2,   //!< Same as SIM_METHOD_FULL, the follower entering Stop 2 between radio events
+    SIM_METHOD_COUNT,
+} sim_method_t;
+
+/**
+ * @brief Offset-only follower, the baseline
+ */
+typedef struct sim_offset_only_s
+{
+    bool     is_pending;
+    uint8_t  pending_seq;
+    uint32_t pending_local_in_us;
+    bool     is_locked;
+    int32_t  offset_in_us;
+} sim_offset_only_t;
+
+/**
+ * @brief Follower clock: integrated frequency error on top of the true time
+ */
+typedef struct sim_clock_s
+{
+    double t_in_us;      //!< True time of the last update
+    double local_in_us;  //!< Clock value at t_in_us, not wrapped
+    double ppm;          //!< Current frequency error relative to the reference
+    double lsi_ppm;      //!< Current frequency error of the LSI clocking the RTC while in Stop 2
+} sim_clock_t;
+
+/**
+ * @brief Error statistics of a method over a run
+ */
+typedef struct sim_result_s
+{
+    double   mean_in_us;
+    double   p99_in_us;
+    double   max_in_us;
+    uint32_t nb_samples;
+} sim_result_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static uint64_t sim_prng_state = 0x9E3779B97F4A7C15u;
+
+/**
+ * @brief Frequency errors of the follower relative to the reference, in ppm
+ */
+static const double drifts_in_ppm[] = { 2.0, 20.0, 50.0 };
+
+/**
+ * @brief Beacon periods, in seconds
+ */
+static const double periods_in_s[] = { 1.0, 10.0, 60.0 };
+
+static const char* const method_names[SIM_METHOD_COUNT] = { "naive", "offset only", "edge + drift",
+                                                                    "edge + STOP2" };
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static double   sim_rand_uniform( void );
+static double   sim_rand_gauss( double sigma );
+static double   sim_get_dispatch_latency_in_us( void );
+static uint32_t sim_clock_read( sim_clock_t* clock, double t_in_us );
+static void     sim_clock_stop( sim_clock_t* clock, double t_start_in_us, double t_end_in_us );
+static void     sim_offset_only_on_beacon( sim_offset_only_t* follower, const uint8_t* beacon, uint32_t local_in_us );
+static int      sim_compare_double( const void* a, const void* b );
+static void     sim_compute_result( double* abs_errors, uint32_t nb_samples, sim_result_t* result );
+static void     sim_run( double drift_in_ppm, double period_in_s, uint32_t nb_beacons,
+                         sim_result_t results[SIM_METHOD_COUNT], smtc_time_sync_stats_t stats[2] );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+int main( int argc, char** argv )
+{
+    uint32_t nb_beacons = 2000;
+    int      opt;
+
+    while( ( opt = getopt( argc, argv, "n:s:" ) ) != -1 )
+    {
+        switch( opt )
+        {
+        case 'n':
+            nb_beacons = strtoul( optarg, NULL, 0 );
+            break;
+        case 's':
+            sim_prng_state = strtoull( optarg, NULL, 0 ) | 1;
+            break;
+        default:
+            fprintf( stderr, "usage: %s [-n beacons per run] [-s seed]\n", argv[0] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    if( nb_beacons <= SIM_WARMUP_NB_BEACONS )
+    {
+        fprintf( stderr, "at least %d beacons are needed\n", SIM_WARMUP_NB_BEACONS + 1 );
+        return EXIT_FAILURE;
+    }
+
+    printf( "%u beacons per run, window of %d points, error measured %.0f%% into the beacon period\n\n", nb_beacons,
+            SMTC_TIME_SYNC_WINDOW_SIZE, SIM_MEASURE_POINT * 100.0 );
+    printf( "drift   period  method        mean |e| us  p99 |e| us  max |e| us\n" );
+
+    for( unsigned int d = 0; d < sizeof( drifts_in_ppm ) / sizeof( drifts_in_ppm[0] ); d++ )
+    {
+        for( unsigned int p = 0; p < sizeof( periods_in_s ) / sizeof( periods_in_s[0] ); p++ )
+        {
+            sim_result_t           results[SIM_METHOD_COUNT];
+            smtc_time_sync_stats_t stats[2];
+
+            sim_run( drifts_in_ppm[d], periods_in_s[p], nb_beacons, results, stats );
+
+            for( int m = 0; m < SIM_METHOD_COUNT; m++ )
+            {
+                printf( "%4.0fppm  %4.0fs   %-12s  %11.1f  %10.1f  %10.1f\n", drifts_in_ppm[d], periods_in_s[p],
+                        method_names[m], results[m].mean_in_us, results[m].p99_in_us, results[m].max_in_us );
+            }
+            printf( "                      drift estimate %d ppb, %u beacons missed, %u relocks\n", stats[0].drift_in_ppb,
+                    stats[0].nb_missed_beacons, stats[0].nb_relocks );
+            printf( "                      Stop 2: drift estimate %d ppb, %u relocks\n\n", stats[1].drift_in_ppb,
+                    stats[1].nb_relocks );
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/**
+ * @brief xorshift64* generator: fixed seed, so that runs are reproducible
+ */
+static double sim_rand_uniform( void )
+{
+    sim_prng_state ^= sim_prng_state >> 12;
+    sim_prng_state ^= sim_prng_state << 25;
+    sim_prng_state ^= sim_prng_state >> 27;
+
+    return ( double ) ( ( sim_prng_state * 0x2545F4914F6CDD1Du ) >> 11 ) / 9007199254740992.0;
+}
+
+static double sim_rand_gauss( double sigma )
+{
+    const double u1 = 1.0 - sim_rand_uniform( );
+    const double u2 = sim_rand_uniform( );
+
+    return sigma * sqrt( -2.0 * log( u1 ) ) * cos( 2.0 * SIM_PI * u2 );
+}
+
+static double sim_get_dispatch_latency_in_us( void )
+{
+    double latency_in_us = SIM_DISPATCH_LATENCY_MIN_IN_US +
+                           ( SIM_DISPATCH_LATENCY_MAX_IN_US - SIM_DISPATCH_LATENCY_MIN_IN_US ) * sim_rand_uniform( );
+
+    if( sim_rand_uniform( ) < SIM_DISPATCH_STALL_PROBABILITY )
+    {
+        latency_in_us += SIM_DISPATCH_STALL_MAX_IN_US * sim_rand_uniform( );
+    }
+
+    return latency_in_us;
+}
+
+/**
+ * @brief Advance the follower clock to t_in_us and read it as the 32-bit microsecond timer would
+ *
+ * @remark Calls have to be made with increasing times
+ */
+static uint32_t sim_clock_read( sim_clock_t* clock, double t_in_us )
+{
+    clock->local_in_us += ( t_in_us - clock->t_in_us ) * ( 1.0 + clock->ppm * 1e-6 );
+    clock->t_in_us = t_in_us;
+
+    return ( uint32_t ) ( uint64_t ) floor( clock->local_in_us );
+}
+
+/**
+ * @brief Put the follower in Stop 2 from t_start_in_us to t_end_in_us: the microsecond timer is frozen, then moved
+ * forward by the number of whole LSI ticks counted by the RTC, converted with the nominal LSI frequency
+ */
+static void sim_clock_stop( sim_clock_t* clock, double t_start_in_us, double t_end_in_us )
+{
+    const double nb_ticks = floor( ( t_end_in_us - t_start_in_us ) * 1e-6 * SIM_LSI_NOMINAL_IN_HZ *
+                                   ( 1.0 + clock->lsi_ppm * 1e-6 ) );
+
+    sim_clock_read( clock, t_start_in_us );
+    clock->local_in_us += nb_ticks * 1e6 / SIM_LSI_NOMINAL_IN_HZ;
+    clock->t_in_us = t_end_in_us;
+}
+
+static void sim_offset_only_on_beacon( sim_offset_only_t* follower, const uint8_t* beacon, uint32_t local_in_us )
+{
+    if( ( follower->is_pending == true ) && ( beacon[1] == ( uint8_t ) ( follower->pending_seq + 1 ) ) &&
+        ( ( beacon[2] & 0x01 ) != 0 ) )
+    {
+        const uint32_t reference_in_us = ( uint32_t ) beacon[3] | ( ( uint32_t ) beacon[4] << 8 ) |
+                                         ( ( uint32_t ) beacon[5] << 16 ) | ( ( uint32_t ) beacon[6] << 24 );
+
+        follower->offset_in_us = ( int32_t ) ( reference_in_us - follower->pending_local_in_us );
+        follower->is_locked    = true;
+    }
+
+    follower->is_pending          = true;
+    follower->pending_seq         = beacon[1];
+    follower->pending_local_in_us = local_in_us;
+}
+
+static int sim_compare_double( const void* a, const void* b )
+{
+    const double x = *( const double* ) a;
+    const double y = *( const double* ) b;
+
+    return ( x > y ) - ( x < y );
+}
+
+static void sim_compute_result( double* abs_errors, uint32_t nb_samples, sim_result_t* result )
+{
+    double sum = 0.0;
+
+    memset( result, 0, sizeof( sim_result_t ) );
+    if( nb_samples == 0 )
+    {
+        return;
+    }
+
+    qsort( abs_errors, nb_samples, sizeof( double ), sim_compare_double );
+    for( uint32_t i = 0; i < nb_samples; i++ )
+    {
+        sum += abs_errors[i];
+    }
+
+    result->nb_samples = nb_samples;
+    result->mean_in_us = sum / nb_samples;
+    result->p99_in_us  = abs_errors[( uint32_t ) ( 0.99 * ( nb_samples - 1 ) )];
+    result->max_in_us  = abs_errors[nb_samples - 1];
+}
+
+/**
+ * @brief Run one scenario
+ *
+ * Both clocks start a few seconds before their 32-bit wrap-around. The reference clock is the time base of the
+ * simulation; the follower clock runs drift_in_ppm faster, plus a random walk. Each method gets its own reference
+ * node so that each one timestamps the TX_DONE the way it does the RX_DONE. The Stop 2 follower has its own clock,
+ * with the same crystal, that is frozen between its radio events and patched from the RTC on each wake-up.
+ */
+static void sim_run( double drift_in_ppm, double period_in_s, uint32_t nb_beacons,
+                     sim_result_t results[SIM_METHOD_COUNT], smtc_time_sync_stats_t stats[2] )
+{
+    const double               reference_origin_in_us = 4294967296.0 - 5e6;
+    const double               period_in_us           = period_in_s * 1e6;
+    smtc_time_sync_reference_t edge_reference;
+    smtc_time_sync_reference_t naive_reference;
+    smtc_time_sync_t           sync;
+    smtc_time_sync_t           stop_sync;
+    sim_offset_only_t          offset_only[2];
+    sim_clock_t                clock = { .t_in_us = 0.0, .local_in_us = 4294967296.0 - 30e6, .ppm = drift_in_ppm };
+    sim_clock_t                stop_clock = clock;
+    double                     stop_clock_wake_up_in_us = 0.0;
+    double*                    abs_errors[SIM_METHOD_COUNT];
+    uint32_t                   nb_samples[SIM_METHOD_COUNT] = { 0 };
+
+    smtc_time_sync_reference_init( &edge_reference );
+    smtc_time_sync_reference_init( &naive_reference );
+    smtc_time_sync_init( &sync );
+    smtc_time_sync_init( &stop_sync );
+    stop_clock.lsi_ppm = SIM_LSI_ACCURACY_IN_PPM * ( 2.0 * sim_rand_uniform( ) - 1.0 );
+    memset( offset_only, 0, sizeof( offset_only ) );
+    for( int m = 0; m < SIM_METHOD_COUNT; m++ )
+    {
+        abs_errors[m] = malloc( nb_beacons * sizeof( double ) );
+    }
+
+    for( uint32_t k = 0; k < nb_beacons; k++ )
+    {
+        uint8_t edge_beacon[SMTC_TIME_SYNC_BEACON_LENGTH];
+        uint8_t naive_beacon[SMTC_TIME_SYNC_BEACON_LENGTH];
+
+        // Reference: the beacon carries the end of the previous one, then its own TX_DONE is timestamped
+        smtc_time_sync_reference_build_beacon( &edge_reference, edge_beacon );
+        smtc_time_sync_reference_build_beacon( &naive_reference, naive_beacon );
+
+        const double t_end_of_packet_in_us = ( double ) k * period_in_us + SIM_TIME_ON_AIR_IN_US;
+        const double t_tx_done_in_us       = t_end_of_packet_in_us + SIM_TX_DONE_MODEL_IN_US + SIM_TX_DONE_BIAS_IN_US;
+
+        smtc_time_sync_reference_on_tx_done(
+            &edge_reference,
+            ( uint32_t ) ( uint64_t ) floor( reference_origin_in_us + t_tx_done_in_us +
+                                             sim_rand_gauss( SIM_EDGE_STAMP_JITTER_IN_US ) ) -
+                ( uint32_t ) SIM_TX_DONE_MODEL_IN_US );
+        smtc_time_sync_reference_on_tx_done(
+            &naive_reference,
+            ( uint32_t ) ( uint64_t ) floor( reference_origin_in_us + t_tx_done_in_us +
+                                             sim_get_dispatch_latency_in_us( ) ) -
+                ( uint32_t ) SIM_TX_DONE_MODEL_IN_US );
+
+        // Stop 2 follower: asleep since its last wake-up, until its RX window opens
+        if( k > 0 )
+        {
+            sim_clock_stop( &stop_clock, stop_clock_wake_up_in_us, t_end_of_packet_in_us - SIM_RX_WINDOW_GUARD_IN_US );
+        }
+
+        // Follower
+        if( sim_rand_uniform( ) >= SIM_BEACON_LOSS_PROBABILITY )
+        {
+            const double t_rx_done_in_us = t_end_of_packet_in_us + SIM_PROPAGATION_IN_US + SIM_RX_DONE_MODEL_IN_US +
+                                           SIM_RX_DONE_BIAS_IN_US + sim_rand_gauss( SIM_RX_DONE_JITTER_IN_US );
+            const uint32_t edge_in_us =
+                sim_clock_read( &clock, t_rx_done_in_us + sim_rand_gauss( SIM_EDGE_STAMP_JITTER_IN_US ) ) -
+                ( uint32_t ) SIM_RX_DONE_MODEL_IN_US;
+            const uint32_t naive_in_us =
+                sim_clock_read( &clock, t_rx_done_in_us + sim_get_dispatch_latency_in_us( ) ) -
+                ( uint32_t ) SIM_RX_DONE_MODEL_IN_US;
+            const uint32_t stop_edge_in_us =
+                sim_clock_read( &stop_clock, t_rx_done_in_us + sim_rand_gauss( SIM_EDGE_STAMP_JITTER_IN_US ) ) -
+                ( uint32_t ) SIM_RX_DONE_MODEL_IN_US;
+
+            smtc_time_sync_on_beacon( &sync, edge_beacon, SMTC_TIME_SYNC_BEACON_LENGTH, edge_in_us );
+            smtc_time_sync_on_beacon( &stop_sync, edge_beacon, SMTC_TIME_SYNC_BEACON_LENGTH, stop_edge_in_us );
+            sim_offset_only_on_beacon( &offset_only[SIM_METHOD_OFFSET_ONLY], edge_beacon, edge_in_us );
+            sim_offset_only_on_beacon( &offset_only[SIM_METHOD_NAIVE], naive_beacon, naive_in_us );
+        }
+
+        // Stop 2 follower: asleep until its slot, then until the measure point
+        const double t_slot_in_us    = t_end_of_packet_in_us + SIM_SLOT_POINT * period_in_us;
+        const double t_measure_in_us = t_end_of_packet_in_us + SIM_MEASURE_POINT * period_in_us;
+
+        sim_clock_stop( &stop_clock, t_end_of_packet_in_us + SIM_AWAKE_AFTER_BEACON_IN_US,
+                        t_slot_in_us - SIM_SLOT_WAKE_UP_MARGIN_IN_US );
+        sim_clock_stop( &stop_clock, t_slot_in_us + SIM_SLOT_AWAKE_IN_US, t_measure_in_us );
+        stop_clock_wake_up_in_us = t_measure_in_us;
+
+        // Measure when the follower would use the synchronisation the most stale
+        const uint32_t local_in_us      = sim_clock_read( &clock, t_measure_in_us );
+        const uint32_t stop_local_in_us = sim_clock_read( &stop_clock, t_measure_in_us );
+        const uint32_t reference_in_us = ( uint32_t ) ( uint64_t ) floor( reference_origin_in_us + t_measure_in_us );
+
+        for( int m = 0; ( k >= SIM_WARMUP_NB_BEACONS ) && ( m < SIM_METHOD_COUNT ); m++ )
+        {
+            uint32_t predicted_in_us;
+
+            if( m == SIM_METHOD_FULL_STOP2 )
+            {
+                if( smtc_time_sync_is_locked( &stop_sync ) == false )
+                {
+                    continue;
+                }
+                predicted_in_us = smtc_time_sync_local_to_reference( &stop_sync, stop_local_in_us );
+            }
+            else if( m == SIM_METHOD_FULL )
+            {
+                if( smtc_time_sync_is_locked( &sync ) == false )
+                {
+                    continue;
+                }
+                predicted_in_us = smtc_time_sync_local_to_reference( &sync, local_in_us );
+            }
+            else
+            {
+                if( offset_only[m].is_locked == false )
+                {
+                    continue;
+                }
+                predicted_in_us = local_in_us + ( uint32_t ) offset_only[m].offset_in_us;
+            }
+
+            abs_errors[m][nb_samples[m]++] = fabs( ( double ) ( int32_t ) ( predicted_in_us - reference_in_us ) );
+        }
+
+        clock.ppm += sim_rand_gauss( SIM_WANDER_IN_PPM_PER_SQRT_S * sqrt( period_in_s ) );
+        stop_clock.ppm = clock.ppm;
+        stop_clock.lsi_ppm += sim_rand_gauss( SIM_LSI_WANDER_IN_PPM_PER_SQRT_S * sqrt( period_in_s ) );
+    }
+
+    for( int m = 0; m < SIM_METHOD_COUNT; m++ )
+    {
+        sim_compute_result( abs_errors[m], nb_samples[m], &results[m] );
+        free( abs_errors[m] );
+    }
+
+    smtc_time_sync_get_stats( &sync, &stats[0] );
+    smtc_time_sync_get_stats( &stop_sync, &stats[1] );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,376 @@
+/**
+ * @file      smtc_time_sync.c
+ *
+ * @brief      Beacon-based time synchronisation of follower clocks on a reference clock
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "smtc_time_sync.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/**
+ * @brief Round a double to the nearest integer without pulling libm in
+ */
+#define SMTC_TIME_SYNC_ROUND( x ) ( ( int32_t ) ( ( ( x ) >= 0.0 ) ? ( ( x ) + 0.5 ) : ( ( x ) - 0.5 ) ) )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Beacon magic number, "T"
+ */
+#define SMTC_TIME_SYNC_BEACON_MAGIC 0x54
+
+/**
+ * @brief Beacon flag: the beacon carries the on-air end of the previous one
+ */
+#define SMTC_TIME_SYNC_BEACON_FLAG_PREVIOUS_VALID 0x01
+
+#if( SMTC_TIME_SYNC_WINDOW_SIZE < 2 ) || ( SMTC_TIME_SYNC_WINDOW_SIZE > 255 )
+#error "SMTC_TIME_SYNC_WINDOW_SIZE has to be in [2, 255]"
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Drop the history and lock on a single synchronisation point
+ *
+ * @remark The drift estimate is kept: it is a property of the crystals, which a clock jump does not change
+ *
+ * @param [in, out] sync Follower
+ * @param [in] point Synchronisation point
+ */
+static void smtc_time_sync_lock( smtc_time_sync_t* sync, const smtc_time_sync_point_t* point );
+
+/**
+ * @brief Fit the anchor and the drift on the points of the window
+ *
+ * Timestamps are taken relative to the newest point so that 32-bit wrap-arounds cancel out, and the unit slope is
+ * removed before the fit so that only the small drift term goes through floating point.
+ *
+ * @param [in, out] sync Follower
+ */
+static void smtc_time_sync_fit( smtc_time_sync_t* sync );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void smtc_time_sync_reference_init( smtc_time_sync_reference_t* reference )
+{
+    if( reference != NULL )
+    {
+        memset( reference, 0, sizeof( smtc_time_sync_reference_t ) );
+    }
+}
+
+uint8_t smtc_time_sync_reference_build_beacon( smtc_time_sync_reference_t* reference, uint8_t* buffer )
+{
+    if( ( reference == NULL ) || ( buffer == NULL ) )
+    {
+        return 0;
+    }
+
+    buffer[0] = SMTC_TIME_SYNC_BEACON_MAGIC;
+    buffer[1] = reference->seq;
+    buffer[2] = ( reference->is_last_end_of_packet_valid == true ) ? SMTC_TIME_SYNC_BEACON_FLAG_PREVIOUS_VALID : 0;
+    buffer[3] = ( uint8_t ) ( reference->last_end_of_packet_in_us );
+    buffer[4] = ( uint8_t ) ( reference->last_end_of_packet_in_us >> 8 );
+    buffer[5] = ( uint8_t ) ( reference->last_end_of_packet_in_us >> 16 );
+    buffer[6] = ( uint8_t ) ( reference->last_end_of_packet_in_us >> 24 );
+
+    // Until the TX_DONE of this beacon, the next one cannot tell when it has been sent
+    reference->is_last_end_of_packet_valid = false;
+    reference->seq++;
+
+    return SMTC_TIME_SYNC_BEACON_LENGTH;
+}
+
+void smtc_time_sync_reference_on_tx_done( smtc_time_sync_reference_t* reference, uint32_t end_of_packet_in_us )
+{
+    if( reference != NULL )
+    {
+        reference->last_end_of_packet_in_us    = end_of_packet_in_us;
+        reference->is_last_end_of_packet_valid = true;
+    }
+}
+
+void smtc_time_sync_init( smtc_time_sync_t* sync )
+{
+    if( sync != NULL )
+    {
+        memset( sync, 0, sizeof( smtc_time_sync_t ) );
+    }
+}
+
+smtc_time_sync_status_t smtc_time_sync_on_beacon( smtc_time_sync_t* sync, const uint8_t* payload, uint8_t length,
+                                                  uint32_t end_of_packet_in_us )
+{
+    smtc_time_sync_status_t status = SMTC_TIME_SYNC_STATUS_PENDING;
+
+    if( ( sync == NULL ) || ( payload == NULL ) )
+    {
+        return SMTC_TIME_SYNC_STATUS_BAD_PARAMETERS;
+    }
+
+    if( ( length < SMTC_TIME_SYNC_BEACON_LENGTH ) || ( payload[0] != SMTC_TIME_SYNC_BEACON_MAGIC ) )
+    {
+        return SMTC_TIME_SYNC_STATUS_NOT_A_BEACON;
+    }
+
+    const uint8_t seq = payload[1];
+
+    sync->stats.nb_beacons++;
+
+    if( sync->is_pending == true )
+    {
+        const uint8_t nb_missed = ( uint8_t ) ( seq - sync->pending_seq - 1 );
+
+        sync->stats.nb_missed_beacons += nb_missed;
+
+        // The reference time is only usable if it belongs to the beacon received just before
+        if( ( nb_missed == 0 ) && ( ( payload[2] & SMTC_TIME_SYNC_BEACON_FLAG_PREVIOUS_VALID ) != 0 ) )
+        {
+            const smtc_time_sync_point_t point = {
+                .local_in_us     = sync->pending_local_in_us,
+                .reference_in_us = ( uint32_t ) payload[3] | ( ( uint32_t ) payload[4] << 8 ) |
+                                   ( ( uint32_t ) payload[5] << 16 ) | ( ( uint32_t ) payload[6] << 24 ),
+            };
+
+            status = smtc_time_sync_add_point( sync, &point );
+        }
+    }
+
+    sync->is_pending          = true;
+    sync->pending_seq         = seq;
+    sync->pending_local_in_us = end_of_packet_in_us;
+
+    return status;
+}
+
+smtc_time_sync_status_t smtc_time_sync_add_point( smtc_time_sync_t* sync, const smtc_time_sync_point_t* point )
+{
+    if( ( sync == NULL ) || ( point == NULL ) )
+    {
+        return SMTC_TIME_SYNC_STATUS_BAD_PARAMETERS;
+    }
+
+    if( sync->is_locked == false )
+    {
+        smtc_time_sync_lock( sync, point );
+        return SMTC_TIME_SYNC_STATUS_OK;
+    }
+
+    const int32_t error_in_us =
+        ( int32_t ) ( point->reference_in_us - smtc_time_sync_local_to_reference( sync, point->local_in_us ) );
+    const uint32_t abs_error_in_us = ( error_in_us < 0 ) ? ( uint32_t ) ( -( int64_t ) error_in_us )
+                                                         : ( uint32_t ) error_in_us;
+
+    sync->stats.last_error_in_us = error_in_us;
+
+    // With a single point the prediction may have no drift correction yet: its error can be large without any clock
+    // jump, and says nothing about the steady state
+    if( sync->nb_points >= 2 )
+    {
+        if( abs_error_in_us > SMTC_TIME_SYNC_RELOCK_THRESHOLD_IN_US )
+        {
+            sync->stats.nb_relocks++;
+            smtc_time_sync_lock( sync, point );
+            return SMTC_TIME_SYNC_STATUS_RELOCKED;
+        }
+
+        if( abs_error_in_us > sync->stats.max_abs_error_in_us )
+        {
+            sync->stats.max_abs_error_in_us = abs_error_in_us;
+        }
+    }
+
+    sync->points[sync->point_index] = *point;
+    sync->point_index               = ( uint8_t ) ( ( sync->point_index + 1 ) % SMTC_TIME_SYNC_WINDOW_SIZE );
+    if( sync->nb_points < SMTC_TIME_SYNC_WINDOW_SIZE )
+    {
+        sync->nb_points++;
+    }
+    sync->stats.nb_points++;
+
+    smtc_time_sync_fit( sync );
+
+    return SMTC_TIME_SYNC_STATUS_OK;
+}
+
+bool smtc_time_sync_is_locked( const smtc_time_sync_t* sync )
+{
+    return ( sync != NULL ) && ( sync->is_locked == true );
+}
+
+uint32_t smtc_time_sync_local_to_reference( const smtc_time_sync_t* sync, uint32_t local_in_us )
+{
+    const int32_t elapsed_in_us = ( int32_t ) ( local_in_us - sync->anchor_local_in_us );
+    const int32_t drift_in_us   = ( int32_t ) ( ( ( int64_t ) elapsed_in_us * sync->drift_in_ppb ) / 1000000000 );
+
+    return sync->anchor_reference_in_us + ( uint32_t ) elapsed_in_us + ( uint32_t ) drift_in_us;
+}
+
+uint32_t smtc_time_sync_reference_to_local( const smtc_time_sync_t* sync, uint32_t reference_in_us )
+{
+    const int32_t elapsed_in_us = ( int32_t ) ( reference_in_us - sync->anchor_reference_in_us );
+    // First-order inverse of smtc_time_sync_local_to_reference: the dropped term is below 1 us for any real crystal
+    const int32_t drift_in_us = ( int32_t ) ( ( ( int64_t ) elapsed_in_us * sync->drift_in_ppb ) / 1000000000 );
+
+    return sync->anchor_local_in_us + ( uint32_t ) elapsed_in_us - ( uint32_t ) drift_in_us;
+}
+
+uint32_t smtc_time_sync_get_next_slot_in_us( const smtc_time_sync_t* sync, uint32_t now_in_us,
+                                             uint32_t superframe_in_us, uint32_t slot_offset_in_us )
+{
+    if( ( sync == NULL ) || ( superframe_in_us == 0 ) )
+    {
+        return now_in_us;
+    }
+
+    const uint32_t first_slot_in_us = sync->anchor_reference_in_us + slot_offset_in_us;
+    const int32_t  elapsed_in_us =
+        ( int32_t ) ( smtc_time_sync_local_to_reference( sync, now_in_us ) - first_slot_in_us );
+    int32_t        nb_superframes;
+
+    if( elapsed_in_us >= 0 )
+    {
+        nb_superframes = ( int32_t ) ( ( uint32_t ) elapsed_in_us / superframe_in_us ) + 1;
+    }
+    else
+    {
+        nb_superframes = -( int32_t ) ( ( uint32_t ) ( -( int64_t ) elapsed_in_us ) / superframe_in_us );
+    }
+
+    return smtc_time_sync_reference_to_local(
+        sync, first_slot_in_us + ( uint32_t ) ( ( int64_t ) nb_superframes * superframe_in_us ) );
+}
+
+void smtc_time_sync_get_stats( const smtc_time_sync_t* sync, smtc_time_sync_stats_t* stats )
+{
+    if( ( sync != NULL ) && ( stats != NULL ) )
+    {
+        *stats = sync->stats;
+        stats->drift_in_ppb = sync->drift_in_ppb;
+    }
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void smtc_time_sync_lock( smtc_time_sync_t* sync, const smtc_time_sync_point_t* point )
+{
+    sync->points[0]              = *point;
+    sync->nb_points              = 1;
+    sync->point_index            = 1;
+    sync->anchor_local_in_us     = point->local_in_us;
+    sync->anchor_reference_in_us = point->reference_in_us;
+    sync->is_locked              = true;
+
+    sync->stats.nb_points++;
+    sync->stats.max_abs_error_in_us = 0;
+}
+
+static void smtc_time_sync_fit( smtc_time_sync_t* sync )
+{
+    const uint8_t newest_index =
+        ( uint8_t ) ( ( sync->point_index + SMTC_TIME_SYNC_WINDOW_SIZE - 1 ) % SMTC_TIME_SYNC_WINDOW_SIZE );
+    const smtc_time_sync_point_t* newest = &sync->points[newest_index];
+    int64_t                       sum_x        = 0;
+    int64_t                       sum_y        = 0;
+
+    // x is the local time and y the reference minus the local time, both relative to the newest point
+    for( uint8_t i = 0; i < sync->nb_points; i++ )
+    {
+        const int32_t x = ( int32_t ) ( sync->points[i].local_in_us - newest->local_in_us );
+
+        sum_x += x;
+        sum_y += ( int32_t ) ( sync->points[i].reference_in_us - newest->reference_in_us ) - x;
+    }
+
+    const double mean_x = ( double ) sum_x / sync->nb_points;
+    const double mean_y = ( double ) sum_y / sync->nb_points;
+    double       sxx    = 0.0;
+    double       sxy    = 0.0;
+
+    for( uint8_t i = 0; i < sync->nb_points; i++ )
+    {
+        const int32_t x  = ( int32_t ) ( sync->points[i].local_in_us - newest->local_in_us );
+        const int32_t y  = ( int32_t ) ( sync->points[i].reference_in_us - newest->reference_in_us ) - x;
+        const double  dx = ( double ) x - mean_x;
+
+        sxx += dx * dx;
+        sxy += dx * ( ( double ) y - mean_y );
+    }
+
+    if( sxx <= 0.0 )
+    {
+        return;
+    }
+
+    const double slope = sxy / sxx;
+
+    // Anchor on the fitted line at the newest point, where the fit is the most relevant for the coming predictions
+    sync->anchor_local_in_us     = newest->local_in_us;
+    sync->anchor_reference_in_us =
+        newest->reference_in_us + ( uint32_t ) SMTC_TIME_SYNC_ROUND( mean_y - slope * mean_x );
+    sync->drift_in_ppb           = SMTC_TIME_SYNC_ROUND( slope * 1e9 );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
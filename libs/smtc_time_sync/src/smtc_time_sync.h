@@ -0,0 +1,288 @@
+/**
+ * @file      smtc_time_sync.h
+ *
+ * @brief      Beacon-based time synchronisation of follower clocks on a reference clock
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMTC_TIME_SYNC_H
+#define SMTC_TIME_SYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/**
+ * @brief Number of synchronisation points the drift is estimated on
+ *
+ * @remark A longer window averages more timestamp jitter out but follows temperature-induced drift changes more slowly
+ */
+#ifndef SMTC_TIME_SYNC_WINDOW_SIZE
+#define SMTC_TIME_SYNC_WINDOW_SIZE 8
+#endif
+
+/**
+ * @brief Error above which a follower drops its history and locks again on the next synchronisation point
+ *
+ * @remark Such an error means that one of the clocks has jumped, or that the beacons are from another reference. It is
+ * only checked once the drift has been estimated on two points.
+ */
+#ifndef SMTC_TIME_SYNC_RELOCK_THRESHOLD_IN_US
+#define SMTC_TIME_SYNC_RELOCK_THRESHOLD_IN_US 2000
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Length of a beacon, in bytes
+ *
+ * A beacon is made of the magic number 'T', a sequence number, a flags byte and the little-endian reference time of
+ * the previous beacon. Application data may follow.
+ */
+#define SMTC_TIME_SYNC_BEACON_LENGTH 7
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Time synchronisation status codes
+ */
+typedef enum smtc_time_sync_status_e
+{
+    SMTC_TIME_SYNC_STATUS_OK = 0,          //!< A synchronisation point has been used
+    SMTC_TIME_SYNC_STATUS_BAD_PARAMETERS,  //!< At least one parameter has an incorrect value
+    SMTC_TIME_SYNC_STATUS_NOT_A_BEACON,    //!< The payload is not a time synchronisation beacon
+    SMTC_TIME_SYNC_STATUS_PENDING,  //!< The beacon has been recorded, its reference time comes with the next one
+    SMTC_TIME_SYNC_STATUS_RELOCKED,  //!< The error was above SMTC_TIME_SYNC_RELOCK_THRESHOLD_IN_US, history dropped
+} smtc_time_sync_status_t;
+
+/**
+ * @brief Reference side: the node whose clock is distributed
+ */
+typedef struct smtc_time_sync_reference_s
+{
+    uint8_t  seq;                          //!< Sequence number of the next beacon
+    bool     is_last_end_of_packet_valid;  //!< The previous beacon has been sent and timestamped
+    uint32_t last_end_of_packet_in_us;     //!< On-air end of the previous beacon
+} smtc_time_sync_reference_t;
+
+/**
+ * @brief Pair of timestamps of the same on-air event
+ */
+typedef struct smtc_time_sync_point_s
+{
+    uint32_t local_in_us;      //!< Follower clock
+    uint32_t reference_in_us;  //!< Reference clock
+} smtc_time_sync_point_t;
+
+/**
+ * @brief Follower statistics
+ */
+typedef struct smtc_time_sync_stats_s
+{
+    uint32_t nb_beacons;           //!< Number of beacons given to smtc_time_sync_on_beacon
+    uint32_t nb_points;            //!< Number of synchronisation points used
+    uint32_t nb_missed_beacons;    //!< Number of beacons lost, from the gaps in the sequence numbers
+    uint32_t nb_relocks;           //!< Number of times the history has been dropped
+    int32_t  last_error_in_us;     //!< Reference time of the last point minus its prediction before the update
+    uint32_t max_abs_error_in_us;  //!< Largest absolute prediction error since the last lock, once the drift is known
+    int32_t  drift_in_ppb;         //!< Current drift estimate, see smtc_time_sync_t
+} smtc_time_sync_stats_t;
+
+/**
+ * @brief Follower side: the node whose clock is disciplined
+ *
+ * The local clock is mapped to the reference one with reference = anchor_reference + d + d * drift, where d is the
+ * local time elapsed since anchor_local. The anchor and the drift are the least-squares fit of the last
+ * SMTC_TIME_SYNC_WINDOW_SIZE synchronisation points.
+ *
+ * @remark The structure is allocated by the caller and only accessed through the functions below
+ */
+typedef struct smtc_time_sync_s
+{
+    bool                   is_locked;        //!< At least one synchronisation point has been used
+    bool                   is_pending;       //!< A beacon waits for its reference time
+    uint8_t                pending_seq;      //!< Sequence number of the pending beacon
+    uint32_t               pending_local_in_us;  //!< Local on-air end of the pending beacon
+    smtc_time_sync_point_t points[SMTC_TIME_SYNC_WINDOW_SIZE];
+    uint8_t                nb_points;    //!< Number of valid entries of points
+    uint8_t                point_index;  //!< Index of the next entry of points to be written
+    uint32_t               anchor_local_in_us;
+    uint32_t               anchor_reference_in_us;
+    int32_t                drift_in_ppb;  //!< Reference clock rate relative to the local one, in parts per billion
+    smtc_time_sync_stats_t stats;
+} smtc_time_sync_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Initialise the reference side
+ *
+ * @param [out] reference Reference
+ */
+void smtc_time_sync_reference_init( smtc_time_sync_reference_t* reference );
+
+/**
+ * @brief Build the next beacon
+ *
+ * A beacon cannot carry its own transmission time, which is only known once it has been sent: it carries the on-air end
+ * of the previous beacon instead, and followers pair it with their own timestamp of that beacon.
+ *
+ * @param [in, out] reference Reference
+ * @param [out] buffer Beacon, SMTC_TIME_SYNC_BEACON_LENGTH bytes long
+ *
+ * @returns Beacon length
+ */
+uint8_t smtc_time_sync_reference_build_beacon( smtc_time_sync_reference_t* reference, uint8_t* buffer );
+
+/**
+ * @brief Record the on-air end of the beacon just sent
+ *
+ * @param [in, out] reference Reference
+ * @param [in] end_of_packet_in_us TX_DONE timestamp corrected with the TX timing model of the radio
+ */
+void smtc_time_sync_reference_on_tx_done( smtc_time_sync_reference_t* reference, uint32_t end_of_packet_in_us );
+
+/**
+ * @brief Initialise the follower side
+ *
+ * @param [out] sync Follower
+ */
+void smtc_time_sync_init( smtc_time_sync_t* sync );
+
+/**
+ * @brief Give a received packet to the follower
+ *
+ * @param [in, out] sync Follower
+ * @param [in] payload Received payload
+ * @param [in] length Length of payload, at least SMTC_TIME_SYNC_BEACON_LENGTH
+ * @param [in] end_of_packet_in_us RX_DONE timestamp corrected with the RX timing model of the radio, in the local clock
+ *
+ * @retval SMTC_TIME_SYNC_STATUS_OK The model has been updated
+ * @retval SMTC_TIME_SYNC_STATUS_PENDING The beacon will be used when the next one is received
+ * @retval SMTC_TIME_SYNC_STATUS_RELOCKED The model has been reset on this beacon
+ * @retval SMTC_TIME_SYNC_STATUS_NOT_A_BEACON The packet is not a beacon and has been ignored
+ * @retval SMTC_TIME_SYNC_STATUS_BAD_PARAMETERS At least one parameter has an incorrect value
+ */
+smtc_time_sync_status_t smtc_time_sync_on_beacon( smtc_time_sync_t* sync, const uint8_t* payload, uint8_t length,
+                                                  uint32_t end_of_packet_in_us );
+
+/**
+ * @brief Feed a synchronisation point directly, for transports other than the beacon
+ *
+ * @param [in, out] sync Follower
+ * @param [in] point Local and reference timestamps of the same event
+ *
+ * @retval SMTC_TIME_SYNC_STATUS_OK The model has been updated
+ * @retval SMTC_TIME_SYNC_STATUS_RELOCKED The model has been reset on this point
+ */
+smtc_time_sync_status_t smtc_time_sync_add_point( smtc_time_sync_t* sync, const smtc_time_sync_point_t* point );
+
+/**
+ * @brief Check whether the follower can convert timestamps
+ *
+ * @param [in] sync Follower
+ *
+ * @returns true once a synchronisation point has been used
+ */
+bool smtc_time_sync_is_locked( const smtc_time_sync_t* sync );
+
+/**
+ * @brief Convert a local timestamp to the reference clock
+ *
+ * @param [in] sync Follower
+ * @param [in] local_in_us Local timestamp
+ *
+ * @returns Reference timestamp
+ */
+uint32_t smtc_time_sync_local_to_reference( const smtc_time_sync_t* sync, uint32_t local_in_us );
+
+/**
+ * @brief Convert a reference timestamp to the local clock
+ *
+ * @param [in] sync Follower
+ * @param [in] reference_in_us Reference timestamp
+ *
+ * @returns Local timestamp
+ */
+uint32_t smtc_time_sync_reference_to_local( const smtc_time_sync_t* sync, uint32_t reference_in_us );
+
+/**
+ * @brief Get the next start of a TDMA slot, in the local clock
+ *
+ * Superframes start at the on-air end of a beacon, the reference sending one beacon per superframe: the slot starts
+ * slot_offset_in_us after the start of each superframe.
+ *
+ * @param [in] sync Follower
+ * @param [in] now_in_us Current local time
+ * @param [in] superframe_in_us Superframe duration
+ * @param [in] slot_offset_in_us Start of the slot in the superframe
+ *
+ * @returns Local time of the first slot start after now_in_us
+ */
+uint32_t smtc_time_sync_get_next_slot_in_us( const smtc_time_sync_t* sync, uint32_t now_in_us,
+                                             uint32_t superframe_in_us, uint32_t slot_offset_in_us );
+
+/**
+ * @brief Get the follower statistics
+ *
+ * @param [in] sync Follower
+ * @param [out] stats Statistics
+ */
+void smtc_time_sync_get_stats( const smtc_time_sync_t* sync, smtc_time_sync_stats_t* stats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SMTC_TIME_SYNC_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -43,6 +43,8 @@
 
 #include "apps_common.h"
 #include "apps_utilities.h"
+#include "apps_entropy.h"
+#include "apps_radio.h"
 #include "lr11xx_radio.h"
 #include "lr11xx_system.h"
 #include "main_bluetooth_low_energy_beaconing_compatibility.h"
@@ -64,11 +66,51 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+/**
+ * @brief Number of advertising channels
+ */
+#define NB_ADV_CHANNELS 3
+
+/**
+ * @brief Time on air of a byte at 1 Mbit/s [us]
+ */
+#define BYTE_TIME_ON_AIR_US 8
+
+/**
+ * @brief Bytes sent on air around the PDU: preamble, access address and CRC
+ */
+#define PDU_OVERHEAD_IN_BYTES ( 1 + 4 + 3 )
+
+/**
+ * @brief Offsets of the mutable fields of the Eddystone-TLM PDU, patched before each TLM advertising event
+ */
+#define TLM_VBATT_OFFSET 21
+#define TLM_TEMP_OFFSET 23
+#define TLM_ADV_CNT_OFFSET 25
+#define TLM_SEC_CNT_OFFSET 29
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
+/**
+ * @brief Advertising scheduler statistics
+ */
+typedef struct adv_stats_s
+{
+    uint32_t nb_events;                //!< Advertising events started
+    uint32_t nb_pdus;                  //!< PDUs sent, all channels included
+    uint32_t nb_pdu_writes;            //!< PDUs transferred to the radio, the other sends reuse the PDU it holds
+    uint32_t nb_intervals;             //!< Intervals measured between the starts of two advertising events
+    uint32_t interval_min_us;          //!< Shortest interval, advDelay included
+    uint32_t interval_max_us;          //!< Longest interval, advDelay included
+    uint64_t interval_sum_us;
+    int32_t  schedule_error_min_us;    //!< Earliest event start, relative to its planned start
+    int32_t  schedule_error_max_us;    //!< Latest event start, relative to its planned start
+    uint32_t channel_switch_max_us;    //!< Longest time from a TX_DONE edge to the send on the next channel
+} adv_stats_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE VARIABLES -------------------------------------------------------
@@ -76,15 +118,113 @@
 
 static lr11xx_hal_context_t* context;
 
+static apps_radio_t radio;
+
+static smtc_hal_mcu_timer_soft_t beacon_timer;
+
+/**
+ * @brief Advertising Channel PDU (Eddystone-URL beacon)
+ */
+static const uint8_t url_pdu[30] = {
+    0x02,                                     // Preamble (ADV_NONCONN_IND)
+    28,                                       // Length
+    0xa4, 0x63, 0xef, 0x8c, 0x89, 0xe6,       // ADV Address
+    0x02, 0x01, 0x06,                         // Advertising Data AD0
+    0x03, 0x03, 0xaa, 0xfe,                   // Advertising Data AD1
+    0x0e,                                     // Advertising Data AD2 - AD Length
+    0x16,                                     // Advertising Data AD2 - AD Type
+    0xaa, 0xfe,                               // Advertising Data AD2 - Eddystone UUID
+    0x10,                                     // Eddystone URL Frame - Frame Type
+    0x09,                                     // Eddystone URL Frame - TX Power
+    0x00,                                     // Eddystone URL Frame - URL Scheme
+    's',  'e',  'm',  't',  'e',  'c',  'h',  // Eddystone URL Frame - Encoded URL
+    0x07                                      // Eddystone URL Frame - Encoded URL (.com)
+};
+
+/**
+ * @brief Advertising Channel PDU (unencrypted Eddystone-TLM beacon) - the mutable fields are patched in place
+ */
+static uint8_t tlm_pdu[33] = {
+    0x02,                                // Preamble (ADV_NONCONN_IND)
+    31,                                  // Length
+    0xa4, 0x63, 0xef, 0x8c, 0x89, 0xe6,  // ADV Address
+    0x02, 0x01, 0x06,                    // Advertising Data AD0
+    0x03, 0x03, 0xaa, 0xfe,              // Advertising Data AD1
+    0x11,                                // Advertising Data AD2 - AD Length
+    0x16,                                // Advertising Data AD2 - AD Type
+    0xaa, 0xfe,                          // Advertising Data AD2 - Eddystone UUID
+    0x20,                                // Eddystone TLM Frame - Frame Type
+    0x00,                                // Eddystone TLM Frame - Version
+    0x00, 0x00,                          // Eddystone TLM Frame - Battery voltage [mV]
+    0x80, 0x00,                          // Eddystone TLM Frame - Temperature [1/256 degC], 0x8000 if not supported
+    0x00, 0x00, 0x00, 0x00,              // Eddystone TLM Frame - Advertising PDU count
+    0x00, 0x00, 0x00, 0x00,              // Eddystone TLM Frame - Time since power-on [0.1 s]
+};
+
+/**
+ * @brief Advertising scheduler state
+ */
+static struct
+{
+    uint8_t        channels[NB_ADV_CHANNELS];  //!< Advertising channels, in the order of an event
+    uint8_t        nb_channels;
+    uint8_t        channel_index;         //!< Channel of the PDU on air
+    const uint8_t* pdu;                   //!< PDU of the current advertising event
+    uint8_t        pdu_length;
+    const uint8_t* pdu_in_radio;          //!< PDU the radio holds, NULL if it has to be transferred
+    uint32_t       planned_start_in_us;   //!< Planned start of the current advertising event
+    uint32_t       last_start_in_us;      //!< Start of the previous advertising event, on air
+    uint32_t       last_event_in_us;      //!< Time of the previous event start, for the uptime
+    uint64_t       uptime_in_us;          //!< Time since the first advertising event
+    adv_stats_t    stats;
+} adv;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
  */
 
 /**
- * @brief Start Bluetooth Low Energy(R) beacon transmission.
+ * @brief Start an advertising event, once the advertising interval and the advDelay have elapsed.
+ *
+ * @param [in] timer_context Unused
+ */
+static void send_bluetooth_low_energy_beacon( void* timer_context );
+
+/**
+ * @brief Send the PDU on the next channel of the advertising event, or plan the next event after the last channel
+ *
+ * @param [in] radio Radio that raised the interrupts
+ * @param [in] irq Interrupts raised
+ */
+static void on_radio_irq( const apps_radio_t* radio, apps_radio_irq_mask_t irq );
+
+/**
+ * @brief Select the PDU of the next advertising event, patch its mutable fields and start the timer of the event
+ *
+ * @remark Called at the end of an advertising event, so the next one starts with a single radio command
+ */
+static void schedule_next_event( void );
+
+/**
+ * @brief Update the battery voltage, temperature and counters of the Eddystone-TLM PDU
+ */
+static void patch_tlm_pdu( void );
+
+/**
+ * @brief Write a 16-bit or 32-bit field of a PDU, most significant byte first
+ */
+static void write_be( uint8_t* field, uint32_t value, uint8_t length );
+
+/**
+ * @brief Record the start time of an advertising event, estimated from the TX_DONE edge of its first PDU
+ */
+static void record_event_start( uint32_t start_in_us );
+
+/**
+ * @brief Print the advertising interval and jitter statistics
  */
-static void send_bluetooth_low_energy_beacon( void );
+static void print_stats( void );
 
 /**
  * @brief Execute PLL calibration steps specific to LR1110 transceiver
@@ -147,43 +287,208 @@ int main( void )
     ASSERT_LR11XX_RC(
         lr11xx_radio_set_tx_params( context, BLUETOOTH_LOW_ENERGY_BEACON_TX_POWER, LR11XX_RADIO_RAMP_16_US ) );
 
-    // Advertising Channel PDU (Eddystone-format Beacon)
-    const uint8_t pdu_buf[30] = {
-        0x02,                                     // Preamble (ADV_NONCONN_IND)
-        28,                                       // Length
-        0xa4, 0x63, 0xef, 0x8c, 0x89, 0xe6,       // ADV Address
-        0x02, 0x01, 0x06,                         // Advertising Data AD0
-        0x03, 0x03, 0xaa, 0xfe,                   // Advertising Data AD1
-        0x0e,                                     // Advertising Data AD2 - AD Length
-        0x16,                                     // Advertising Data AD2 - AD Type
-        0xaa, 0xfe,                               // Advertising Data AD2 - Eddystone UUID
-        0x10,                                     // Eddystone URL Frame - Frame Type
-        0x09,                                     // Eddystone URL Frame - TX Power
-        0x00,                                     // Eddystone URL Frame - URL Scheme
-        's',  'e',  'm',  't',  'e',  'c',  'h',  // Eddystone URL Frame - Encoded URL
-        0x07                                      // Eddystone URL Frame - Encoded URL (.com)
-    };
-    ASSERT_LR11XX_RC( lr11xx_radio_cfg_bluetooth_low_energy_beaconning_compatibility(
-        context, BLUETOOTH_LOW_ENERGY_BEACON_CHANNEL, pdu_buf, sizeof( pdu_buf ) ) );
+    for( uint8_t i = 0; i < NB_ADV_CHANNELS; i++ )
+    {
+        if( ( BLUETOOTH_LOW_ENERGY_BEACON_CHANNEL_MAP & ( 1u << i ) ) != 0 )
+        {
+            adv.channels[adv.nb_channels++] = 37 + i;
+        }
+    }
+    if( adv.nb_channels == 0 )
+    {
+        HAL_DBG_TRACE_ERROR( "No advertising channel in BLUETOOTH_LOW_ENERGY_BEACON_CHANNEL_MAP\n" );
+        while( true )
+        {
+        }
+    }
+
+    radio.ops     = APPS_RADIO_CHIP_OPS;
+    radio.context = ( void* ) context;
 
-    send_bluetooth_low_energy_beacon( );
+    smtc_hal_mcu_timer_soft_init( &beacon_timer, send_bluetooth_low_energy_beacon, NULL );
+    adv.planned_start_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+    adv.last_event_in_us    = adv.planned_start_in_us;
+    schedule_next_event( );
 
     while( 1 )
     {
-        apps_common_lr11xx_irq_process( ( void* ) context, IRQ_MASK );
+        apps_radio_irq_process( &radio, APPS_RADIO_IRQ_TX_DONE, on_radio_irq );
+        apps_radio_wait_for_event( &radio );
     }
 }
 
-void on_tx_done( void )
+static void send_bluetooth_low_energy_beacon( void* timer_context )
 {
+    const uint32_t now_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+
+    adv.uptime_in_us += now_in_us - adv.last_event_in_us;
+    adv.last_event_in_us = now_in_us;
+    adv.channel_index    = 0;
+    adv.stats.nb_events++;
+
+    // The radio keeps the last PDU it was given: it is only transferred again when it changed
+    apps_common_lr11xx_handle_pre_tx( );
+    if( adv.pdu_in_radio == adv.pdu )
+    {
+        ASSERT_LR11XX_RC( lr11xx_radio_cfg_and_send_bluetooth_low_energy_beaconning_compatibility(
+            context, adv.channels[0], NULL, 0 ) );
+    }
+    else
+    {
+        ASSERT_LR11XX_RC( lr11xx_radio_cfg_and_send_bluetooth_low_energy_beaconning_compatibility(
+            context, adv.channels[0], adv.pdu, adv.pdu_length ) );
+        adv.pdu_in_radio = adv.pdu;
+        adv.stats.nb_pdu_writes++;
+    }
+}
+
+static void on_radio_irq( const apps_radio_t* radio, apps_radio_irq_mask_t irq )
+{
+    ( void ) radio;
+
+    if( ( irq & APPS_RADIO_IRQ_TX_DONE ) == 0 )
+    {
+        return;
+    }
+
+    const uint32_t tx_done_in_us = apps_radio_get_irq_timestamp_in_us( );
+
     apps_common_lr11xx_handle_post_tx( );
-    send_bluetooth_low_energy_beacon( );
+
+    adv.stats.nb_pdus++;
+    if( adv.channel_index == 0 )
+    {
+        record_event_start( tx_done_in_us - ( adv.pdu_length + PDU_OVERHEAD_IN_BYTES ) * BYTE_TIME_ON_AIR_US );
+    }
+
+    adv.channel_index++;
+    if( adv.channel_index < adv.nb_channels )
+    {
+        // Retune and send the PDU held by the radio in a single command
+        apps_common_lr11xx_handle_pre_tx( );
+        ASSERT_LR11XX_RC( lr11xx_radio_cfg_and_send_bluetooth_low_energy_beaconning_compatibility(
+            context, adv.channels[adv.channel_index], NULL, 0 ) );
+
+        const uint32_t channel_switch_us = smtc_hal_mcu_timer_get_time_in_us( ) - tx_done_in_us;
+        if( channel_switch_us > adv.stats.channel_switch_max_us )
+        {
+            adv.stats.channel_switch_max_us = channel_switch_us;
+        }
+        return;
+    }
+
+    if( ( adv.stats.nb_events % BLUETOOTH_LOW_ENERGY_BEACON_STATS_PERIOD ) == 0 )
+    {
+        print_stats( );
+    }
+    schedule_next_event( );
 }
 
-static void send_bluetooth_low_energy_beacon( )
+static void schedule_next_event( void )
 {
-    LL_mDelay( BLUETOOTH_LOW_ENERGY_BEACON_PERIOD_MS );
-    lr11xx_radio_set_tx( ( void* ) context, 0 );
+    const uint32_t event_index = adv.stats.nb_events;
+
+    if( ( BLUETOOTH_LOW_ENERGY_BEACON_TLM_PERIOD != 0 ) &&
+        ( ( event_index % BLUETOOTH_LOW_ENERGY_BEACON_TLM_PERIOD ) == ( BLUETOOTH_LOW_ENERGY_BEACON_TLM_PERIOD - 1 ) ) )
+    {
+        patch_tlm_pdu( );
+        adv.pdu          = tlm_pdu;
+        adv.pdu_length   = sizeof( tlm_pdu );
+        adv.pdu_in_radio = NULL;
+    }
+    else
+    {
+        adv.pdu        = url_pdu;
+        adv.pdu_length = sizeof( url_pdu );
+    }
+
+    // advInterval plus the pseudo-random advDelay of the Bluetooth(R) specification, counted from the planned start of
+    // the previous event so that the scheduling errors do not accumulate
+    const uint32_t adv_delay_us = apps_entropy_get_range( BLUETOOTH_LOW_ENERGY_BEACON_ADV_DELAY_MAX_US + 1 );
+
+    adv.planned_start_in_us += BLUETOOTH_LOW_ENERGY_BEACON_PERIOD_MS * 1000 + adv_delay_us;
+
+    const int32_t timeout_us = ( int32_t ) ( adv.planned_start_in_us - smtc_hal_mcu_timer_get_time_in_us( ) );
+    smtc_hal_mcu_timer_soft_start( &beacon_timer, ( timeout_us > 0 ) ? ( uint32_t ) timeout_us : 0, 0 );
+}
+
+static void patch_tlm_pdu( void )
+{
+    uint8_t  vbat = 0;
+    uint16_t temp = 0;
+
+    ASSERT_LR11XX_RC( lr11xx_system_get_vbat( context, &vbat ) );
+    ASSERT_LR11XX_RC( lr11xx_system_get_temp( context, &temp ) );
+
+    // Vbat = ( 5 * vbat / 255 - 1 ) * Vana and Temp = ( temp / 2047 * Vana - Vbe25 ) / VbeSlope + 25, with Vana = 1.35 V,
+    // Vbe25 = 0.7295 V and VbeSlope = -1.7 mV/degC
+    const uint32_t vbat_x5_in_mv   = ( ( uint32_t ) vbat * 6750 ) / 255;
+    const uint32_t vbat_in_mv      = ( vbat_x5_in_mv > 1350 ) ? vbat_x5_in_mv - 1350 : 0;
+    const int32_t  vbe_in_uv       = ( int32_t ) ( ( ( uint32_t ) ( temp & 0x7FF ) * 1350000 ) / 2047 );
+    const int32_t  temp_in_256th_c = 25 * 256 - ( ( vbe_in_uv - 729500 ) * 256 ) / 1700;
+
+    write_be( &tlm_pdu[TLM_VBATT_OFFSET], vbat_in_mv, 2 );
+    write_be( &tlm_pdu[TLM_TEMP_OFFSET], ( uint16_t ) temp_in_256th_c, 2 );
+    write_be( &tlm_pdu[TLM_ADV_CNT_OFFSET], adv.stats.nb_pdus, 4 );
+    write_be( &tlm_pdu[TLM_SEC_CNT_OFFSET], ( uint32_t ) ( adv.uptime_in_us / 100000 ), 4 );
+}
+
+static void write_be( uint8_t* field, uint32_t value, uint8_t length )
+{
+    for( uint8_t i = 0; i < length; i++ )
+    {
+        field[i] = ( uint8_t ) ( value >> ( 8 * ( length - 1 - i ) ) );
+    }
+}
+
+static void record_event_start( uint32_t start_in_us )
+{
+    const int32_t schedule_error_us = ( int32_t ) ( start_in_us - adv.planned_start_in_us );
+
+    if( ( adv.stats.nb_events == 1 ) || ( schedule_error_us < adv.stats.schedule_error_min_us ) )
+    {
+        adv.stats.schedule_error_min_us = schedule_error_us;
+    }
+    if( ( adv.stats.nb_events == 1 ) || ( schedule_error_us > adv.stats.schedule_error_max_us ) )
+    {
+        adv.stats.schedule_error_max_us = schedule_error_us;
+    }
+
+    if( adv.stats.nb_events > 1 )
+    {
+        const uint32_t interval_us = start_in_us - adv.last_start_in_us;
+
+        if( ( adv.stats.nb_intervals == 0 ) || ( interval_us < adv.stats.interval_min_us ) )
+        {
+            adv.stats.interval_min_us = interval_us;
+        }
+        if( interval_us > adv.stats.interval_max_us )
+        {
+            adv.stats.interval_max_us = interval_us;
+        }
+        adv.stats.interval_sum_us += interval_us;
+        adv.stats.nb_intervals++;
+    }
+    adv.last_start_in_us = start_in_us;
+}
+
+static void print_stats( void )
+{
+    const adv_stats_t* stats = &adv.stats;
+
+    HAL_DBG_TRACE_INFO( "Advertising: %u events, %u PDUs sent, %u transferred to the radio\n", stats->nb_events,
+                        stats->nb_pdus, stats->nb_pdu_writes );
+    if( stats->nb_intervals != 0 )
+    {
+        HAL_DBG_TRACE_PRINTF( "   interval: min %u us, avg %u us, max %u us (advInterval %u ms + advDelay 0 to %u us)\n",
+                              stats->interval_min_us, ( uint32_t ) ( stats->interval_sum_us / stats->nb_intervals ),
+                              stats->interval_max_us, BLUETOOTH_LOW_ENERGY_BEACON_PERIOD_MS,
+                              BLUETOOTH_LOW_ENERGY_BEACON_ADV_DELAY_MAX_US );
+    }
+    HAL_DBG_TRACE_PRINTF( "   start vs plan: %d to %d us, jitter %u us peak-to-peak\n", stats->schedule_error_min_us,
+                          stats->schedule_error_max_us,
+                          ( uint32_t ) ( stats->schedule_error_max_us - stats->schedule_error_min_us ) );
+    HAL_DBG_TRACE_PRINTF( "   channel switch: %u us max from TX_DONE\n", stats->channel_switch_max_us );
 }
 
 void initialize_lr1110_pll_for_bluetooth_low_energy( void )
@@ -55,15 +55,32 @@ extern "C" {
  */
 
 /*!
- *  @brief Defines the Bluetooth channel used for beacon transmission.
+ *  @brief Defines the advertising channels used by each advertising event: bit 0 for channel 37, bit 1 for 38 and bit
+ *  2 for 39. The channels are used in increasing order.
  */
-#define BLUETOOTH_LOW_ENERGY_BEACON_CHANNEL 37u
+#define BLUETOOTH_LOW_ENERGY_BEACON_CHANNEL_MAP 0x07u
 
 /*!
- *  @brief Defines the beacon transmission period [ms].
+ *  @brief Defines the advertising interval (advInterval) between two advertising events [ms].
  */
 #define BLUETOOTH_LOW_ENERGY_BEACON_PERIOD_MS 5000u
 
+/*!
+ *  @brief Defines the largest random delay (advDelay) added to each advertising interval [us].
+ */
+#define BLUETOOTH_LOW_ENERGY_BEACON_ADV_DELAY_MAX_US 10000u
+
+/*!
+ *  @brief Defines the number of advertising events between two Eddystone-TLM beacons, the other events send the
+ *  Eddystone-URL beacon. 0 only sends the Eddystone-URL beacon.
+ */
+#define BLUETOOTH_LOW_ENERGY_BEACON_TLM_PERIOD 5u
+
+/*!
+ *  @brief Defines the number of advertising events between two prints of the scheduling statistics.
+ */
+#define BLUETOOTH_LOW_ENERGY_BEACON_STATS_PERIOD 10u
+
 /*!
  *  @brief Defines the beacon transmission power [dBm].
  */
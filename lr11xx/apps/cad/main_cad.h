@@ -77,13 +77,13 @@ symbols. Threshold used to decide if there is a LoRa activity.
  *  @brief Defines the action to be performed after a CAD operation
  */
 #ifndef CAD_EXIT_MODE
-#define CAD_EXIT_MODE LR11XX_RADIO_CAD_EXIT_MODE_STANDBYRC
+#define CAD_EXIT_MODE APPS_RADIO_CAD_EXIT_MODE_STANDBY
 #endif
 
 /*!
- *  @brief Timeout is only used when the CAD is performed with CAD_EXIT_MODE = LR11XX_RADIO_CAD_EXIT_MODE_RX or LR11XX_RADIO_CAD_EXIT_MODE_TX
- *  If CAD_EXIT_MODE = LR11XX_RADIO_CAD_EXIT_MODE_RX, check SetRx for Timout definition.
- *  If CAD_EXIT_MODE = LR11XX_RADIO_CAD_EXIT_MODE_TX, check SetTx for Timout definition.
+ *  @brief Timeout is only used when the CAD is performed with CAD_EXIT_MODE = APPS_RADIO_CAD_EXIT_MODE_RX or APPS_RADIO_CAD_EXIT_MODE_TX
+ *  If CAD_EXIT_MODE = APPS_RADIO_CAD_EXIT_MODE_RX, check SetRx for Timout definition.
+ *  If CAD_EXIT_MODE = APPS_RADIO_CAD_EXIT_MODE_TX, check SetTx for Timout definition.
  */
 #ifndef CAD_TIMEOUT_MS
 #define CAD_TIMEOUT_MS 1000
@@ -108,6 +108,31 @@ symbols. Threshold used to decide if there is a LoRa activity.
 #define DELAY_MS_BEFORE_CAD 900
 #endif
 
+/*!
+ *  @brief Adapt the detection peak and the number of symbols to the false alarms and missed packets observed
+ *  Only used when CAD_EXIT_MODE = APPS_RADIO_CAD_EXIT_MODE_RX: the setting learned for the channel is saved to flash
+ */
+#ifndef CAD_ADAPTIVE_TUNING
+#define CAD_ADAPTIVE_TUNING true
+#endif
+
+/*!
+ *  @brief Range the adaptive tuning may move the detection peak in, around its initial value
+ */
+#ifndef CAD_TUNING_DETECT_PEAK_SPAN
+#define CAD_TUNING_DETECT_PEAK_SPAN 10
+#endif
+
+/*!
+ *  @brief Range of the number of symbols used by the adaptive tuning
+ */
+#ifndef CAD_TUNING_SYMBOL_NUM_MIN
+#define CAD_TUNING_SYMBOL_NUM_MIN 2
+#endif
+#ifndef CAD_TUNING_SYMBOL_NUM_MAX
+#define CAD_TUNING_SYMBOL_NUM_MAX 16
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC CONSTANTS --------------------------------------------------------
@@ -40,7 +40,6 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <time.h>
 
 #include "apps_common.h"
 #include "apps_utilities.h"
@@ -51,6 +50,7 @@
 #include "smtc_hal_mcu.h"
 #include "smtc_hal_dbg_trace.h"
 #include "uart_init.h"
+#include "apps_entropy.h"
 #include "main_tx_lr_fhss.h"
 
 /*
@@ -81,6 +81,8 @@ static lr11xx_hal_context_t* context;
 
 static uint8_t buffer[PAYLOAD_LENGTH];
 
+static smtc_hal_mcu_timer_soft_t tx_timer;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -96,6 +98,13 @@ static uint8_t buffer[PAYLOAD_LENGTH];
  */
 static void build_frame_and_send( const lr11xx_lr_fhss_params_t* params, uint8_t* payload, uint16_t length );
 
+/**
+ * @brief Send the next frame once the delay following a transmission has elapsed
+ *
+ * @param [in] timer_context Unused
+ */
+static void on_tx_delay_elapsed( void* timer_context );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -110,7 +119,6 @@ int main( void )
     smtc_hal_mcu_init( );
     apps_common_shield_init( );
     uart_init( );
-    srand( time( NULL ) );
 
     HAL_DBG_TRACE_INFO( "===== LR11xx TX LR-FHSS example =====\n\n" );
     apps_common_print_sdk_driver_version( );
@@ -124,6 +132,8 @@ int main( void )
     ASSERT_LR11XX_RC( lr11xx_system_set_dio_irq_params( context, LR11XX_SYSTEM_IRQ_TX_DONE, LR11XX_SYSTEM_IRQ_NONE ) );
     ASSERT_LR11XX_RC( lr11xx_system_clear_irq_status( context, LR11XX_SYSTEM_IRQ_ALL_MASK ) );
 
+    smtc_hal_mcu_timer_soft_init( &tx_timer, on_tx_delay_elapsed, NULL );
+
     for( int i = 0; i < PAYLOAD_LENGTH; i++ )
     {
         buffer[i] = i;
@@ -144,6 +154,7 @@ int main( void )
     while( 1 )
     {
         apps_common_lr11xx_irq_process( context, LR11XX_SYSTEM_IRQ_TX_DONE );
+        apps_common_lr11xx_wait_for_event( );
     }
 }
 
@@ -151,14 +162,17 @@ void on_tx_done( void )
 {
     apps_common_lr11xx_handle_post_tx( );
 
-    LL_mDelay( TX_TO_TX_DELAY_IN_MS );
+    smtc_hal_mcu_timer_soft_start( &tx_timer, TX_TO_TX_DELAY_IN_MS * 1000, 0 );
+}
 
+static void on_tx_delay_elapsed( void* timer_context )
+{
     build_frame_and_send( &lr_fhss_params, buffer, PAYLOAD_LENGTH );
 }
 
 void build_frame_and_send( const lr11xx_lr_fhss_params_t* params, uint8_t* payload, uint16_t length )
 {
-    const uint16_t hop_seq_id = ( uint16_t )( rand( ) % lr11xx_lr_fhss_get_hop_sequence_count( params ) );
+    const uint16_t hop_seq_id = ( uint16_t ) apps_entropy_get_range( lr11xx_lr_fhss_get_hop_sequence_count( params ) );
 
     lr11xx_lr_fhss_build_frame( ( void* ) context, &lr_fhss_params, hop_seq_id, payload, length );
 
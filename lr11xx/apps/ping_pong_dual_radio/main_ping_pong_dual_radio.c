@@ -0,0 +1,382 @@
+/*!
+ * @file      main_ping_pong_dual_radio.c
+ *
+ * @brief     Ping-pong example between two LR11xx chips driven by the same MCU
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "apps_common.h"
+#include "apps_utilities.h"
+#include "lr11xx_radio.h"
+#include "lr11xx_system.h"
+#include "lr11xx_system_types.h"
+#include "lr11xx_regmem.h"
+#include "main_ping_pong_dual_radio.h"
+#include "radio_registry.h"
+#include "smtc_hal_dbg_trace.h"
+#include "uart_init.h"
+#include "apps_entropy.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/**
+ * @brief Size of ping-pong message prefix
+ *
+ * Expressed in bytes
+ */
+#define PING_PONG_PREFIX_SIZE 4
+
+/**
+ * @brief Threshold:number of exchanges before informing user on UART that the radio pair is still not synchronized
+ *
+ * Expressed in number of packet exchanged
+ */
+#define SYNC_PACKET_THRESHOLD 64
+
+/**
+ * @brief Location in the payload of the exchange counter
+ *
+ * Expressed in bytes
+ */
+#define ITERATION_INDEX ( PING_PONG_PREFIX_SIZE + 1 )
+
+/**
+ * @brief Duration of the wait before packet transmission to assure reception status is ready on the other side
+ *
+ * Expressed in milliseconds
+ */
+#define DELAY_BEFORE_TX_MS 20
+
+/**
+ * @brief Duration of the wait between each ping-pong activity, can be used to adjust ping-pong speed
+ *
+ * Expressed in milliseconds
+ */
+#define DELAY_PING_PONG_PACE_MS 200
+
+/**
+ * @brief Number of radios playing ping-pong
+ */
+#define NB_RADIOS 2
+
+/**
+ * @brief LR11xx interrupt mask used by the application
+ */
+#define IRQ_MASK                                                                          \
+    ( LR11XX_SYSTEM_IRQ_TX_DONE | LR11XX_SYSTEM_IRQ_RX_DONE | LR11XX_SYSTEM_IRQ_TIMEOUT | \
+      LR11XX_SYSTEM_IRQ_HEADER_ERROR | LR11XX_SYSTEM_IRQ_CRC_ERROR | LR11XX_SYSTEM_IRQ_FSK_LEN_ERROR )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#if NB_RADIOS > RADIO_REGISTRY_MAX_RADIOS
+#error "RADIO_REGISTRY_MAX_RADIOS is too small for this example"
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Ping-pong state of one radio
+ */
+typedef struct ping_pong_radio_s
+{
+    const char*               name;
+    lr11xx_hal_context_t*     context;
+    uint8_t                   buffer_tx[PAYLOAD_LENGTH];
+    bool                      is_master;
+    uint8_t                   iteration;
+    uint16_t                  packets_to_sync;
+    uint32_t                  nb_exchanges;
+    smtc_hal_mcu_timer_soft_t rx_start_timer;
+    smtc_hal_mcu_timer_soft_t tx_start_timer;
+} ping_pong_radio_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static ping_pong_radio_t radios[NB_RADIOS] = {
+    { .name = "A", .is_master = true },
+    { .name = "B", .is_master = false },
+};
+
+static const uint8_t ping_msg[PING_PONG_PREFIX_SIZE] = "PING";
+static const uint8_t pong_msg[PING_PONG_PREFIX_SIZE] = "PONG";
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Get the ping-pong state of the radio whose interrupts are being processed
+ *
+ * @returns Pointer to the state of the radio
+ */
+static ping_pong_radio_t* ping_pong_get_irq_radio( void );
+
+/**
+ * @brief Handle reception failure for ping-pong example
+ *
+ * @param [in] radio Radio which failed to receive
+ */
+static void ping_pong_reception_failure_handling( ping_pong_radio_t* radio );
+
+/**
+ * @brief Start the reception once the pace delay following a transmission has elapsed
+ *
+ * @param [in] timer_context Radio to start
+ */
+static void ping_pong_start_rx( void* timer_context );
+
+/**
+ * @brief Start the transmission once the pace delay following a reception has elapsed
+ *
+ * @param [in] timer_context Radio to start
+ */
+static void ping_pong_start_tx( void* timer_context );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+/**
+ * @brief Main application entry point.
+ */
+int main( void )
+{
+    const radio_registry_binding_t bindings[NB_RADIOS] = {
+        RADIO_REGISTRY_BINDING_ARDUINO,
+        RADIO_REGISTRY_BINDING_SECONDARY,
+    };
+
+    smtc_hal_mcu_init( );
+    apps_common_shield_init( );
+    uart_init( );
+
+    HAL_DBG_TRACE_INFO( "===== LR11xx dual-radio Ping-Pong example =====\n\n" );
+    apps_common_print_sdk_driver_version( );
+
+    for( uint8_t i = 0; i < NB_RADIOS; i++ )
+    {
+        ping_pong_radio_t* radio = &radios[i];
+
+        HAL_DBG_TRACE_INFO( "Radio %s:\n", radio->name );
+
+        radio->context = apps_common_lr11xx_get_context_from_binding( i, &bindings[i] );
+
+        apps_common_lr11xx_system_init( ( void* ) radio->context );
+        apps_common_lr11xx_fetch_and_print_version( ( void* ) radio->context );
+        apps_common_lr11xx_radio_init( ( void* ) radio->context );
+
+        ASSERT_LR11XX_RC( lr11xx_system_set_dio_irq_params( radio->context, IRQ_MASK, 0 ) );
+        ASSERT_LR11XX_RC( lr11xx_system_clear_irq_status( radio->context, LR11XX_SYSTEM_IRQ_ALL_MASK ) );
+
+        smtc_hal_mcu_timer_soft_init( &radio->rx_start_timer, ping_pong_start_rx, radio );
+        smtc_hal_mcu_timer_soft_init( &radio->tx_start_timer, ping_pong_start_tx, radio );
+
+        memcpy( radio->buffer_tx, ping_msg, PING_PONG_PREFIX_SIZE );
+        radio->buffer_tx[PING_PONG_PREFIX_SIZE] = ( uint8_t ) 0;
+        radio->buffer_tx[ITERATION_INDEX]       = ( uint8_t ) ( radio->iteration );
+        for( int j = PING_PONG_PREFIX_SIZE + 1 + 1; j < PAYLOAD_LENGTH; j++ )
+        {
+            radio->buffer_tx[j] = j;
+        }
+    }
+
+    // Radio B listens first so that the very first PING of radio A locks the exchange, instead of both radios
+    // starting as masters and colliding until their random reception timeouts drift apart
+    ping_pong_start_rx( &radios[1] );
+    ping_pong_start_tx( &radios[0] );
+
+    while( 1 )
+    {
+        radio_registry_dispatch( IRQ_MASK );
+        apps_common_lr11xx_wait_for_event( );
+    }
+}
+
+void on_tx_done( void )
+{
+    ping_pong_radio_t* radio = ping_pong_get_irq_radio( );
+
+    apps_common_lr11xx_handle_post_tx( );
+    HAL_DBG_TRACE_INFO( "Radio %s sent message %s, iteration %d\n", radio->name, radio->buffer_tx, radio->iteration );
+
+    smtc_hal_mcu_timer_soft_start( &radio->rx_start_timer, DELAY_PING_PONG_PACE_MS * 1000, 0 );
+}
+
+void on_rx_done( void )
+{
+    ping_pong_radio_t* radio = ping_pong_get_irq_radio( );
+    uint8_t            buffer_rx[PAYLOAD_LENGTH];
+    uint8_t            size;
+
+    radio->packets_to_sync = 0;
+    apps_common_lr11xx_handle_post_rx( );
+
+    apps_common_lr11xx_receive( radio->context, buffer_rx, PAYLOAD_LENGTH, &size );
+    radio->iteration = buffer_rx[ITERATION_INDEX];
+
+    radio->iteration++;
+    HAL_DBG_TRACE_INFO( "Radio %s received message %s, iteration %d\n", radio->name, buffer_rx, radio->iteration );
+
+    if( radio->is_master == true )
+    {
+        if( memcmp( buffer_rx, ping_msg, PING_PONG_PREFIX_SIZE ) == 0 )
+        {
+            radio->is_master = false;
+            memcpy( radio->buffer_tx, pong_msg, PING_PONG_PREFIX_SIZE );
+        }
+        else if( memcmp( buffer_rx, pong_msg, PING_PONG_PREFIX_SIZE ) != 0 )
+        {
+            HAL_DBG_TRACE_ERROR( "Unexpected message\n" );
+        }
+    }
+    else
+    {
+        if( memcmp( buffer_rx, ping_msg, PING_PONG_PREFIX_SIZE ) != 0 )
+        {
+            HAL_DBG_TRACE_ERROR( "Unexpected message\n" );
+
+            radio->is_master = true;
+            memcpy( radio->buffer_tx, ping_msg, PING_PONG_PREFIX_SIZE );
+        }
+    }
+
+    radio->nb_exchanges++;
+    if( ( radio->nb_exchanges % STATS_PERIOD ) == 0 )
+    {
+        HAL_DBG_TRACE_PRINTF( "Radio %s: ", radio->name );
+        apps_common_lr11xx_irq_print_stats( radio->context );
+    }
+
+    smtc_hal_mcu_timer_soft_start( &radio->tx_start_timer, ( DELAY_PING_PONG_PACE_MS + DELAY_BEFORE_TX_MS ) * 1000,
+                                   0 );
+}
+
+void on_rx_timeout( void )
+{
+    ping_pong_radio_t* radio = ping_pong_get_irq_radio( );
+
+    radio->packets_to_sync++;
+    if( radio->packets_to_sync > SYNC_PACKET_THRESHOLD )
+    {
+        HAL_DBG_TRACE_WARNING( "Radio %s: it looks like synchronisation is still not done, check the wiring of both "
+                               "radios and their antennas\n",
+                               radio->name );
+    }
+    ping_pong_reception_failure_handling( radio );
+}
+
+void on_rx_crc_error( void )
+{
+    ping_pong_reception_failure_handling( ping_pong_get_irq_radio( ) );
+}
+
+void on_fsk_len_error( void )
+{
+    ping_pong_reception_failure_handling( ping_pong_get_irq_radio( ) );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static ping_pong_radio_t* ping_pong_get_irq_radio( void )
+{
+    const void* context = apps_common_lr11xx_irq_get_context( );
+
+    for( uint8_t i = 0; i < NB_RADIOS; i++ )
+    {
+        if( radios[i].context == context )
+        {
+            return &radios[i];
+        }
+    }
+
+    // Interrupt routines are only called by apps_common_lr11xx_irq_process, for a registered radio
+    return &radios[0];
+}
+
+static void ping_pong_reception_failure_handling( ping_pong_radio_t* radio )
+{
+    apps_common_lr11xx_handle_post_rx( );
+
+    radio->is_master = true;
+    radio->iteration = 0;
+    memcpy( radio->buffer_tx, ping_msg, PING_PONG_PREFIX_SIZE );
+
+    ping_pong_start_tx( radio );
+}
+
+static void ping_pong_start_rx( void* timer_context )
+{
+    ping_pong_radio_t* radio = ( ping_pong_radio_t* ) timer_context;
+
+    apps_common_lr11xx_handle_pre_rx( );
+    // Random delay to avoid unwanted synchronization of two masters: drawn from the entropy pool so that the two radios
+    // do not follow the same sequence
+    ASSERT_LR11XX_RC( lr11xx_radio_set_rx(
+        radio->context, get_time_on_air_in_ms( ) + RX_TIMEOUT_VALUE + apps_entropy_get_range( 500 ) ) );
+}
+
+static void ping_pong_start_tx( void* timer_context )
+{
+    ping_pong_radio_t* radio = ( ping_pong_radio_t* ) timer_context;
+
+    radio->buffer_tx[ITERATION_INDEX] = radio->iteration;
+
+    ASSERT_LR11XX_RC( lr11xx_regmem_write_buffer8( radio->context, radio->buffer_tx, PAYLOAD_LENGTH ) );
+
+    apps_common_lr11xx_handle_pre_tx( );
+    ASSERT_LR11XX_RC( lr11xx_radio_set_tx( radio->context, 0 ) );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -1,10 +1,10 @@
 /*!
- * @file      main_ping_pong.h
+ * @file      main_ping_pong_dual_radio.h
  *
- * @brief     Ping-pong example for LR11xx chip
+ * @brief     Ping-pong example between two LR11xx chips driven by the same MCU
  *
  * The Clear BSD License
- * Copyright Semtech Corporation 2022. All rights reserved.
+ * Copyright Semtech Corporation 2024. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted (subject to the limitations in the disclaimer
@@ -32,8 +32,8 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef MAIN_PER_H
-#define MAIN_PER_H
+#ifndef MAIN_PING_PONG_DUAL_RADIO_H
+#define MAIN_PING_PONG_DUAL_RADIO_H
 
 #ifdef __cplusplus
 extern "C" {
@@ -53,6 +53,13 @@ extern "C" {
 #define RX_TIMEOUT_VALUE 600
 #endif
 
+/*!
+ * @brief Number of exchanges between two prints of the interrupt queue statistics of each radio
+ */
+#ifndef STATS_PERIOD
+#define STATS_PERIOD 32
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC CONSTANTS --------------------------------------------------------
@@ -72,6 +79,6 @@ extern "C" {
 }
 #endif
 
-#endif  // MAIN_PER_H
+#endif  // MAIN_PING_PONG_DUAL_RADIO_H
 
 /* --- EOF ------------------------------------------------------------------ */
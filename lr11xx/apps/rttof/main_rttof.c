@@ -108,6 +108,11 @@ static const bool is_manager = false;
 #error Application must define RTTOF_DEVICE_MODE
 #endif
 
+/**
+ * @brief Timer pacing the RTToF requests sent by the manager
+ */
+static smtc_hal_mcu_timer_soft_t request_timer;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -123,6 +128,13 @@ static const bool is_manager = false;
  */
 lr11xx_status_t get_rttof_result( lr11xx_radio_lora_bw_t rttof_bw, rttof_result_t* result );
 
+/**
+ * @brief Send a new RTToF request once the sleep period has elapsed
+ *
+ * @param [in] timer_context Unused
+ */
+static void send_rttof_request( void* timer_context );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -157,6 +169,7 @@ int main( void )
         /* Manager specific LoRa RTToF parameter configuration */
         ASSERT_LR11XX_RC( lr11xx_system_set_dio_irq_params( ( void* ) context, RTTOF_MANAGER_IRQ_MASK, 0 ) );
         ASSERT_LR11XX_RC( lr11xx_rttof_set_request_address( ( void* ) context, RTTOF_ADDRESS ) );
+        smtc_hal_mcu_timer_soft_init( &request_timer, send_rttof_request, NULL );
         ASSERT_LR11XX_RC( lr11xx_system_clear_irq_status( ( void* ) context, LR11XX_SYSTEM_IRQ_ALL_MASK ) );
         ASSERT_LR11XX_RC( lr11xx_radio_set_tx( ( void* ) context, MANAGER_TX_RX_TIMEOUT_MS ) );
     }
@@ -182,6 +195,7 @@ int main( void )
         {
             apps_common_lr11xx_irq_process( ( void* ) context, RTTOF_SUBORDINATE_IRQ_MASK );
         }
+        apps_common_lr11xx_wait_for_event( );
     }
 }
 
@@ -234,15 +248,18 @@ void on_rttof_exchange_valid( void )
     HAL_DBG_TRACE_INFO( "RTToF result: Distance: %dm, RSSI: %d \n", result.distance_m, result.rssi );
 
     /* start new rttof transmission */
-    LL_mDelay( MANAGER_RTTOF_SLEEP_PERIOD );
-    ASSERT_LR11XX_RC( lr11xx_radio_set_tx( ( void* ) context, MANAGER_TX_RX_TIMEOUT_MS ) );
+    smtc_hal_mcu_timer_soft_start( &request_timer, MANAGER_RTTOF_SLEEP_PERIOD * 1000UL, 0 );
 }
 
 void on_rttof_timeout( void )
 {
     HAL_DBG_TRACE_WARNING( "RTTOF request timeout\n\n" );
     /* start new rttof transmission */
-    LL_mDelay( MANAGER_RTTOF_SLEEP_PERIOD );
+    smtc_hal_mcu_timer_soft_start( &request_timer, MANAGER_RTTOF_SLEEP_PERIOD * 1000UL, 0 );
+}
+
+static void send_rttof_request( void* timer_context )
+{
     ASSERT_LR11XX_RC( lr11xx_radio_set_tx( ( void* ) context, MANAGER_TX_RX_TIMEOUT_MS ) );
 }
 
@@ -47,6 +47,7 @@
 #include "apps_utilities.h"
 #include "lr11xx_system.h"
 #include "lr11xx_radio.h"
+#include "lr11xx_radio_timings.h"
 #include "lr11xx_driver_version.h"
 #include "lr11xx_rttof.h"
 #include "smtc_hal_dbg_trace.h"
@@ -70,11 +71,23 @@
 
 #include "smtc_dbpsk.h"
 #include "atc.h"
+#include "uart_init.h"
+#include "smtc_hal_mcu_lpm.h"
+#include "apps_kv_store.h"
+#include "radio_registry.h"
+#include "apps_entropy.h"
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE MACROS-----------------------------------------------------------
  */
 
+#define IRQ_HANDLERS_COUNT ( sizeof( irq_handlers ) / sizeof( irq_handlers[0] ) )
+
+/*!
+ * @brief Number of iterations averaged by the GPIO benchmark
+ */
+#define GPIO_BENCHMARK_NB_ITERATIONS 1000
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE CONSTANTS -------------------------------------------------------
@@ -173,14 +186,70 @@ static lr11xx_radio_pkt_params_bpsk_t bpsk_pkt_params = {
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
+/*!
+ * @brief Trace level used to report a dispatched interrupt
+ */
+typedef enum irq_trace_level_e
+{
+    IRQ_TRACE_LEVEL_INFO,
+    IRQ_TRACE_LEVEL_WARNING,
+    IRQ_TRACE_LEVEL_ERROR,
+} irq_trace_level_t;
+
+/*!
+ * @brief Entry of the interrupt dispatch table
+ *
+ * The callback is called when all the bits of required_mask and none of the bits of rejected_mask are raised.
+ */
+typedef struct irq_handler_s
+{
+    lr11xx_system_irq_mask_t required_mask;
+    lr11xx_system_irq_mask_t rejected_mask;
+    void ( *callback )( void );
+    const char*       name;
+    irq_trace_level_t trace_level;
+} irq_handler_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-static lr11xx_hal_context_t context;
+/*!
+ * @brief HAL contexts of the radios, indexed as in the radio registry
+ */
+static lr11xx_hal_context_t contexts[RADIO_REGISTRY_MAX_RADIOS];
+
+/*!
+ * @brief Context of the radio whose interrupts are being dispatched by apps_common_lr11xx_irq_process
+ */
+static const void* irq_context = NULL;
 
-static volatile bool irq_fired = false;
+/*!
+ * @brief DIO edge timestamp of the event being dispatched by apps_common_lr11xx_irq_process, in the timebase of
+ * smtc_hal_mcu_timer_get_time_in_us
+ */
+static uint32_t irq_timestamp_in_us = 0;
+
+/*!
+ * @brief Radio configuration currently applied to the transceiver
+ *
+ * Used by apps_common_lr11xx_radio_get_pending_changes to find the minimal set of driver calls required to apply the
+ * ATC_M_* parameters. LoRa modulation parameters are tracked in lora_mod_params.
+ */
+static struct
+{
+    bool                                         is_valid;
+    uint32_t                                     rf_freq_in_hz;
+    const lr11xx_radio_rssi_calibration_table_t* rssi_calibration_table;
+    smtc_shield_lr11xx_pa_pwr_cfg_t              pa_pwr_cfg;
+    bool                                         rx_boost;
+} radio_cfg_applied = { 0 };
+
+/*!
+ * @brief Duration of the last apps_common_lr11xx_radio_init call, reported along with reconfiguration latency
+ */
+static uint32_t radio_init_duration_in_us = 0;
 
 static const smtc_shield_lr11xx_pinout_t* shield_pinout = 0;
 
@@ -237,6 +306,18 @@ void print_gfsk_configuration( void );
  */
 static void print_driver_version( void );
 
+/*!
+ * @brief Get the PA and output power configuration matching the ATC_M_* parameters
+ *
+ * The shield PA table entry for ATC_M_RF_FREQ_IN_HZ / ATC_M_TX_OUTPUT_POWER_DBM is overridden by the ATC_M_PA_*
+ * parameters which are not left to their default value (1000).
+ *
+ * @param [out] pa_pwr_cfg  PA and output power configuration
+ *
+ * @returns false if the shield does not support the requested frequency / power pair, true otherwise
+ */
+static bool apps_common_lr11xx_get_atc_pa_pwr_cfg( smtc_shield_lr11xx_pa_pwr_cfg_t* pa_pwr_cfg );
+
 void radio_on_dio_irq( void* context );
 void on_tx_done( void ) __attribute__( ( weak ) );
 void on_rx_done( void ) __attribute__( ( weak ) );
@@ -258,6 +339,78 @@ void on_rttof_timeout( void ) __attribute__( ( weak ) );
 void on_wifi_scan_done( void ) __attribute__( ( weak ) );
 void on_gnss_scan_done( void ) __attribute__( ( weak ) );
 
+/*!
+ * @brief Check if a dispatch table entry matches the raised interrupts
+ *
+ * @param [in] handler  Dispatch table entry
+ * @param [in] irq_regs  Raised interrupts
+ *
+ * @returns true if the entry callback has to be called
+ */
+static bool irq_handler_matches( const irq_handler_t* handler, lr11xx_system_irq_mask_t irq_regs );
+
+/*!
+ * @brief Print the name of a dispatched interrupt
+ *
+ * @param [in] handler  Dispatch table entry
+ */
+static void irq_handler_trace( const irq_handler_t* handler );
+
+/*!
+ * @brief Dispatch the queued DIO events of a radio, see apps_common_lr11xx_irq_process
+ *
+ * @param [in] context  Pointer to the radio context
+ * @param [in] irq_filter_mask  Mask of IRQ to process
+ * @param [in] is_traced  Print the raised interrupts once their callbacks have been called
+ */
+static void irq_dispatch( const void* context, lr11xx_system_irq_mask_t irq_filter_mask, bool is_traced );
+
+/*!
+ * @brief Interrupt handler registered to the radio registry
+ *
+ * @param [in] context  Pointer to the radio context
+ * @param [in] irq_filter_mask  Mask of IRQ to process
+ */
+static void apps_common_lr11xx_irq_handler( void* context, uint32_t irq_filter_mask );
+
+/*!
+ * @brief Check if a DIO event or an AT command is waiting to be processed
+ *
+ * @returns true if an event is pending
+ */
+static bool apps_common_lr11xx_is_event_pending( void );
+
+/*!
+ * @brief Interrupt dispatch table, in processing order
+ */
+static const irq_handler_t irq_handlers[] = {
+    { LR11XX_SYSTEM_IRQ_TX_DONE, 0, on_tx_done, "Tx done", IRQ_TRACE_LEVEL_INFO },
+    { LR11XX_SYSTEM_IRQ_PREAMBLE_DETECTED, 0, on_preamble_detected, "Preamble detected", IRQ_TRACE_LEVEL_INFO },
+    { LR11XX_SYSTEM_IRQ_HEADER_ERROR, 0, on_header_error, "Header error", IRQ_TRACE_LEVEL_ERROR },
+    { LR11XX_SYSTEM_IRQ_SYNC_WORD_HEADER_VALID, 0, on_syncword_header_valid, "Syncword or header valid",
+      IRQ_TRACE_LEVEL_INFO },
+    { LR11XX_SYSTEM_IRQ_RX_DONE | LR11XX_SYSTEM_IRQ_CRC_ERROR, 0, on_rx_crc_error, "CRC error",
+      IRQ_TRACE_LEVEL_ERROR },
+    { LR11XX_SYSTEM_IRQ_RX_DONE | LR11XX_SYSTEM_IRQ_FSK_LEN_ERROR, LR11XX_SYSTEM_IRQ_CRC_ERROR, on_fsk_len_error,
+      "FSK length error", IRQ_TRACE_LEVEL_ERROR },
+    { LR11XX_SYSTEM_IRQ_RX_DONE, LR11XX_SYSTEM_IRQ_CRC_ERROR | LR11XX_SYSTEM_IRQ_FSK_LEN_ERROR, on_rx_done, "Rx done",
+      IRQ_TRACE_LEVEL_INFO },
+    { LR11XX_SYSTEM_IRQ_CAD_DONE | LR11XX_SYSTEM_IRQ_CAD_DETECTED, 0, on_cad_done_detected,
+      "CAD done - channel activity detected", IRQ_TRACE_LEVEL_INFO },
+    { LR11XX_SYSTEM_IRQ_CAD_DONE, LR11XX_SYSTEM_IRQ_CAD_DETECTED, on_cad_done_undetected,
+      "CAD done - no channel activity detected", IRQ_TRACE_LEVEL_INFO },
+    { LR11XX_SYSTEM_IRQ_TIMEOUT, 0, on_rx_timeout, "Rx timeout", IRQ_TRACE_LEVEL_WARNING },
+    { LR11XX_SYSTEM_IRQ_LORA_RX_TIMESTAMP, 0, on_lora_rx_timestamp, "LoRa Rx timestamp", IRQ_TRACE_LEVEL_INFO },
+    { LR11XX_SYSTEM_IRQ_RTTOF_REQ_VALID, 0, on_rttof_request_valid, "RTToF request valid", IRQ_TRACE_LEVEL_INFO },
+    { LR11XX_SYSTEM_IRQ_RTTOF_REQ_DISCARDED, 0, on_rttof_request_discarded, "RTToF request discarded",
+      IRQ_TRACE_LEVEL_INFO },
+    { LR11XX_SYSTEM_IRQ_RTTOF_RESP_DONE, 0, on_rttof_response_done, "RTToF response done", IRQ_TRACE_LEVEL_INFO },
+    { LR11XX_SYSTEM_IRQ_RTTOF_EXCH_VALID, 0, on_rttof_exchange_valid, "RTToF exchange valid", IRQ_TRACE_LEVEL_INFO },
+    { LR11XX_SYSTEM_IRQ_RTTOF_TIMEOUT, 0, on_rttof_timeout, "RTToF timeout", IRQ_TRACE_LEVEL_INFO },
+    { LR11XX_SYSTEM_IRQ_WIFI_SCAN_DONE, 0, on_wifi_scan_done, "Wi-Fi scan done", IRQ_TRACE_LEVEL_INFO },
+    { LR11XX_SYSTEM_IRQ_GNSS_SCAN_DONE, 0, on_gnss_scan_done, "GNSS scan done", IRQ_TRACE_LEVEL_INFO },
+};
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC VARIABLES --------------------------------------------------------
@@ -270,41 +423,64 @@ void on_gnss_scan_done( void ) __attribute__( ( weak ) );
 
 lr11xx_hal_context_t* apps_common_lr11xx_get_context( )
 {
-    context.busy.cfg                 = smtc_shield_pinout_mapping_get_gpio_cfg( SMTC_SHIELD_PINOUT_D3 );
-    context.busy.cfg_input.pull_mode = SMTC_HAL_MCU_GPIO_PULL_MODE_NONE;
-    context.busy.cfg_input.irq_mode  = SMTC_HAL_MCU_GPIO_IRQ_MODE_OFF;
-    context.busy.cfg_input.callback  = NULL;
+    const radio_registry_binding_t binding = RADIO_REGISTRY_BINDING_ARDUINO;
+
+    return apps_common_lr11xx_get_context_from_binding( 0, &binding );
+}
+
+lr11xx_hal_context_t* apps_common_lr11xx_get_context_from_binding( uint8_t                         radio_id,
+                                                                   const radio_registry_binding_t* binding )
+{
+    if( radio_id >= RADIO_REGISTRY_MAX_RADIOS )
+    {
+        return NULL;
+    }
 
-    context.irq.cfg                 = smtc_shield_pinout_mapping_get_gpio_cfg( SMTC_SHIELD_PINOUT_D5 );
-    context.irq.cfg_input.pull_mode = SMTC_HAL_MCU_GPIO_PULL_MODE_NONE;
-    context.irq.cfg_input.irq_mode  = SMTC_HAL_MCU_GPIO_IRQ_MODE_RISING;
-    context.irq.cfg_input.callback  = radio_on_dio_irq;
-    context.irq.cfg_input.context   = NULL;
+    lr11xx_hal_context_t* context   = &contexts[radio_id];
+    radio_irq_queue_t*    irq_queue = radio_registry_add( radio_id, context, apps_common_lr11xx_irq_handler );
 
-    context.nss.cfg                      = smtc_shield_pinout_mapping_get_gpio_cfg( SMTC_SHIELD_PINOUT_D7 );
-    context.nss.cfg_output.initial_state = SMTC_HAL_MCU_GPIO_STATE_HIGH;
-    context.nss.cfg_output.mode          = SMTC_HAL_MCU_GPIO_OUTPUT_MODE_PUSH_PULL;
+    context->busy.cfg                 = smtc_shield_pinout_mapping_get_gpio_cfg( binding->busy );
+    context->busy.cfg_input.pull_mode = SMTC_HAL_MCU_GPIO_PULL_MODE_NONE;
+    context->busy.cfg_input.irq_mode  = SMTC_HAL_MCU_GPIO_IRQ_MODE_OFF;
+    context->busy.cfg_input.callback  = NULL;
 
-    context.reset.cfg                      = smtc_shield_pinout_mapping_get_gpio_cfg( SMTC_SHIELD_PINOUT_A0 );
-    context.reset.cfg_output.initial_state = SMTC_HAL_MCU_GPIO_STATE_HIGH;
-    context.reset.cfg_output.mode          = SMTC_HAL_MCU_GPIO_OUTPUT_MODE_PUSH_PULL;
+    context->irq.cfg                 = smtc_shield_pinout_mapping_get_gpio_cfg( binding->irq );
+    context->irq.cfg_input.pull_mode = SMTC_HAL_MCU_GPIO_PULL_MODE_NONE;
+    context->irq.cfg_input.irq_mode  = SMTC_HAL_MCU_GPIO_IRQ_MODE_RISING;
+    context->irq.cfg_input.callback  = radio_on_dio_irq;
+    context->irq.cfg_input.context   = irq_queue;
 
-    context.spi.cfg.spi = SPI1;
+    context->nss.cfg                      = smtc_shield_pinout_mapping_get_gpio_cfg( binding->nss );
+    context->nss.cfg_output.initial_state = SMTC_HAL_MCU_GPIO_STATE_HIGH;
+    context->nss.cfg_output.mode          = SMTC_HAL_MCU_GPIO_OUTPUT_MODE_PUSH_PULL;
 
-    smtc_hal_mcu_gpio_init_input( context.busy.cfg, &( context.busy.cfg_input ), &( context.busy.inst ) );
-    smtc_hal_mcu_gpio_init_input( context.irq.cfg, &( context.irq.cfg_input ), &( context.irq.inst ) );
-    smtc_hal_mcu_gpio_init_output( context.nss.cfg, &( context.nss.cfg_output ), &( context.nss.inst ) );
-    smtc_hal_mcu_gpio_init_output( context.reset.cfg, &( context.reset.cfg_output ), &( context.reset.inst ) );
+    context->reset.cfg                      = smtc_shield_pinout_mapping_get_gpio_cfg( binding->reset );
+    context->reset.cfg_output.initial_state = SMTC_HAL_MCU_GPIO_STATE_HIGH;
+    context->reset.cfg_output.mode          = SMTC_HAL_MCU_GPIO_OUTPUT_MODE_PUSH_PULL;
 
-    smtc_hal_mcu_gpio_enable_irq( context.irq.inst );
+    context->spi.cfg.spi = binding->spi;
 
-    smtc_hal_mcu_spi_init( &( context.spi.cfg ), &( context.spi.inst ) );
+    smtc_hal_mcu_gpio_init_input( context->busy.cfg, &( context->busy.cfg_input ), &( context->busy.inst ) );
+    smtc_hal_mcu_gpio_init_input( context->irq.cfg, &( context->irq.cfg_input ), &( context->irq.inst ) );
+    smtc_hal_mcu_gpio_init_output( context->nss.cfg, &( context->nss.cfg_output ), &( context->nss.inst ) );
+    smtc_hal_mcu_gpio_init_output( context->reset.cfg, &( context->reset.cfg_output ), &( context->reset.inst ) );
 
-    return &context;
+    // Resolve the pins toggled or polled around every radio transaction to their port and mask once and for all
+    smtc_hal_mcu_gpio_stm32l4_get_fast( context->busy.inst, &( context->busy.fast ) );
+    smtc_hal_mcu_gpio_stm32l4_get_fast( context->nss.inst, &( context->nss.fast ) );
+    smtc_hal_mcu_gpio_stm32l4_get_fast( context->reset.inst, &( context->reset.fast ) );
+
+    smtc_hal_mcu_gpio_enable_irq( context->irq.inst );
+
+    smtc_hal_mcu_spi_init( &( context->spi.cfg ), &( context->spi.inst ) );
+
+    return context;
 }
 
 void apps_common_shield_init( void )
 {
+    apps_entropy_init( );
+
     shield_pinout = smtc_shield_lr11xx_get_pinout( &shield );
 
     if( shield_pinout->led_tx != SMTC_SHIELD_PINOUT_NONE )
@@ -370,9 +546,74 @@ void apps_common_lr11xx_system_init( const lr11xx_hal_context_t* context )
     uint16_t errors;
     ASSERT_LR11XX_RC( lr11xx_system_get_errors( context, &errors ) );
     ASSERT_LR11XX_RC( lr11xx_system_clear_errors( context ) );
+
+    apps_common_lr11xx_harvest_entropy( context );
+
     ASSERT_LR11XX_RC( lr11xx_system_clear_irq_status( context, LR11XX_SYSTEM_IRQ_ALL_MASK ) );
 }
 
+void apps_common_lr11xx_harvest_entropy( const void* context )
+{
+    uint32_t       words[APPS_ENTROPY_RADIO_HARVEST_NB_WORDS];
+    const uint32_t start_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+
+    // The LR11xx returns one word per GetRandomNumber command: read them back to back while the radio is idle rather
+    // than one at a time when random numbers are needed
+    for( int i = 0; i < APPS_ENTROPY_RADIO_HARVEST_NB_WORDS; i++ )
+    {
+        ASSERT_LR11XX_RC( lr11xx_system_get_random_number( context, &words[i] ) );
+    }
+
+    if( apps_entropy_add_radio_words( words, APPS_ENTROPY_RADIO_HARVEST_NB_WORDS,
+                                      smtc_hal_mcu_timer_get_elapsed_time_in_us( start_in_us ) ) == false )
+    {
+        HAL_DBG_TRACE_WARNING( "Radio random numbers rejected by the entropy pool\n" );
+    }
+}
+
+void apps_common_lr11xx_print_gpio_benchmark( const void* context )
+{
+    const lr11xx_hal_context_t* lr11xx_context = ( const lr11xx_hal_context_t* ) context;
+    lr11xx_system_irq_mask_t    irq_status;
+    uint32_t                    start_cycles;
+
+    // NSS pulses without SPI clock are ignored by the radio, it only has to be out of sleep
+    start_cycles = apps_common_cycle_counter_get( );
+    for( int i = 0; i < GPIO_BENCHMARK_NB_ITERATIONS; i++ )
+    {
+        smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+        smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    }
+    const uint32_t generic_pair_in_cycles =
+        ( apps_common_cycle_counter_get( ) - start_cycles ) / GPIO_BENCHMARK_NB_ITERATIONS;
+
+    start_cycles = apps_common_cycle_counter_get( );
+    for( int i = 0; i < GPIO_BENCHMARK_NB_ITERATIONS; i++ )
+    {
+        smtc_hal_mcu_gpio_stm32l4_fast_set_low( &( lr11xx_context->nss.fast ) );
+        smtc_hal_mcu_gpio_stm32l4_fast_set_high( &( lr11xx_context->nss.fast ) );
+    }
+    const uint32_t fast_pair_in_cycles =
+        ( apps_common_cycle_counter_get( ) - start_cycles ) / GPIO_BENCHMARK_NB_ITERATIONS;
+
+    start_cycles = apps_common_cycle_counter_get( );
+    for( int i = 0; i < GPIO_BENCHMARK_NB_ITERATIONS; i++ )
+    {
+        ASSERT_LR11XX_RC( lr11xx_system_get_irq_status( context, &irq_status ) );
+    }
+    const uint32_t transaction_in_cycles =
+        ( apps_common_cycle_counter_get( ) - start_cycles ) / GPIO_BENCHMARK_NB_ITERATIONS;
+
+    // A GetIrqStatus read drives NSS low and high twice, once for the command and once for the response
+    const uint32_t saved_in_cycles = 2 * ( generic_pair_in_cycles - fast_pair_in_cycles );
+
+    HAL_DBG_TRACE_INFO( "GPIO benchmark, NSS low + high: generic %u cycles, BSRR %u cycles\n", generic_pair_in_cycles,
+                        fast_pair_in_cycles );
+    HAL_DBG_TRACE_INFO( "GetIrqStatus transaction: %u cycles (%u us), %u cycles saved per transaction (%u%%)\n",
+                        transaction_in_cycles, apps_common_cycle_counter_to_us( transaction_in_cycles ),
+                        saved_in_cycles, ( saved_in_cycles * 100 ) / ( transaction_in_cycles + saved_in_cycles ) );
+}
+
 void apps_common_lr11xx_fetch_and_print_version( const lr11xx_hal_context_t* context )
 {
     lr11xx_system_version_t version;
@@ -493,12 +734,11 @@ void apps_common_print_sdk_driver_version( void )
 // }
 void apps_common_lr11xx_radio_init( const void* context )
 {
-    // 从 PA 表中获取对应的配置（注意：返回的是 const 指针）
-    const smtc_shield_lr11xx_pa_pwr_cfg_t* pa_pwr_cfg_const =
-    //    smtc_shield_lr11xx_get_pa_pwr_cfg( &shield, RF_FREQ_IN_HZ, TX_OUTPUT_POWER_DBM );
-            smtc_shield_lr11xx_get_pa_pwr_cfg( &shield, ATC_M_RF_FREQ_IN_HZ, ATC_M_TX_OUTPUT_POWER_DBM );
+    const uint32_t start_cycles = apps_common_cycle_counter_get( );
 
-    if( pa_pwr_cfg_const == NULL )
+    smtc_shield_lr11xx_pa_pwr_cfg_t pa_pwr_cfg;
+
+    if( apps_common_lr11xx_get_atc_pa_pwr_cfg( &pa_pwr_cfg ) == false )
     {
         HAL_DBG_TRACE_ERROR( "Invalid target frequency or power level\n" );
         while( true )
@@ -506,34 +746,6 @@ void apps_common_lr11xx_radio_init( const void* context )
         }
     }
 
-    // 复制配置到局部变量（这样可以修改）
-    smtc_shield_lr11xx_pa_pwr_cfg_t pa_pwr_cfg = *pa_pwr_cfg_const;
-
-    // 根据变量或其他条件，修改 pa 配置中需要调整的参数
-    // 例如，这里使用一个变量 new_pa_duty_cycle 来更新占空比
-		if(ATC_M_PA_PA_DUTY_CYCLE !=1000){
-			uint8_t new_pa_duty_cycle = ATC_M_PA_PA_DUTY_CYCLE;		
-			pa_pwr_cfg.pa_config.pa_duty_cycle = new_pa_duty_cycle;
-		}
-		if(ATC_M_PA_PA_SEL !=1000){
-			uint8_t new_pa_sel= ATC_M_PA_PA_SEL;
-			pa_pwr_cfg.pa_config.pa_sel = new_pa_sel;
-		}
-		if(ATC_M_PA_PA_HP_SEL !=1000){
-			uint8_t new_pa_hp_sel= ATC_M_PA_PA_HP_SEL;
-			pa_pwr_cfg.pa_config.pa_hp_sel = new_pa_hp_sel;
-		}
-		if(ATC_M_PA_PA_SEL !=1000){
-			uint8_t new_pa_reg_supply= ATC_M_PA_PA_SEL;
-			pa_pwr_cfg.pa_config.pa_reg_supply = ATC_M_PA_PA_RGE_SUPPLY;
-		}
-		if(ATC_M_PA_PA_REAL_POWER !=1000){
-			int8_t new_power =ATC_M_PA_PA_REAL_POWER;
-			pa_pwr_cfg.power =new_power;
-		}
-		
-    print_common_configuration( );
-
     ASSERT_LR11XX_RC( lr11xx_radio_set_pkt_type( context, PACKET_TYPE ) );
     // 设置射频频率
     ASSERT_LR11XX_RC( lr11xx_radio_set_rf_freq( context, ATC_M_RF_FREQ_IN_HZ ) );
@@ -548,7 +760,6 @@ void apps_common_lr11xx_radio_init( const void* context )
 
     if( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_LORA )
     {
-        print_lora_configuration( );
         lora_mod_params.sf = ATC_M_LORA_SF;
         lora_mod_params.bw = ATC_M_LORA_BW;
         lora_mod_params.cr = ATC_M_LORA_CR;
@@ -559,8 +770,6 @@ void apps_common_lr11xx_radio_init( const void* context )
     }
     else if( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_GFSK )
     {
-        print_gfsk_configuration( );
-
         ASSERT_LR11XX_RC( lr11xx_radio_set_gfsk_mod_params( context, &gfsk_mod_params ) );
         ASSERT_LR11XX_RC( lr11xx_radio_set_gfsk_pkt_params( context, &gfsk_pkt_params ) );
         ASSERT_LR11XX_RC( lr11xx_radio_set_gfsk_sync_word( context, gfsk_sync_word ) );
@@ -589,8 +798,148 @@ void apps_common_lr11xx_radio_init( const void* context )
 
         ASSERT_LR11XX_RC( lr11xx_radio_set_lr_fhss_mod_params( context, &mod_lr_fhss ) );
     }
+
+    radio_cfg_applied.is_valid               = true;
+    radio_cfg_applied.rf_freq_in_hz          = ATC_M_RF_FREQ_IN_HZ;
+    radio_cfg_applied.rssi_calibration_table = smtc_shield_lr11xx_get_rssi_calibration_table( &shield, ATC_M_RF_FREQ_IN_HZ );
+    radio_cfg_applied.pa_pwr_cfg             = pa_pwr_cfg;
+    radio_cfg_applied.rx_boost               = ( ATC_M_LORA_RX_BOOST != 0 );
+
+    radio_init_duration_in_us = apps_common_cycle_counter_to_us( apps_common_cycle_counter_get( ) - start_cycles );
+
+    // Printed once the radio is configured, so that the UART output is not part of radio_init_duration_in_us
+    print_common_configuration( );
+    if( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_LORA )
+    {
+        print_lora_configuration( );
+    }
+    else if( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_GFSK )
+    {
+        print_gfsk_configuration( );
+    }
+}
+
+apps_common_lr11xx_radio_cfg_change_mask_t apps_common_lr11xx_radio_get_pending_changes( void )
+{
+    apps_common_lr11xx_radio_cfg_change_mask_t changes = APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_NONE;
+    smtc_shield_lr11xx_pa_pwr_cfg_t            pa_pwr_cfg;
+
+    if( radio_cfg_applied.is_valid == false )
+    {
+        return changes;
+    }
+
+    if( ATC_M_RF_FREQ_IN_HZ != radio_cfg_applied.rf_freq_in_hz )
+    {
+        changes |= APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_RF_FREQ;
+
+        if( smtc_shield_lr11xx_get_rssi_calibration_table( &shield, ATC_M_RF_FREQ_IN_HZ ) !=
+            radio_cfg_applied.rssi_calibration_table )
+        {
+            changes |= APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_RSSI_CALIBRATION;
+        }
+    }
+
+    // An invalid frequency / power pair leaves the PA untouched, apps_common_lr11xx_radio_reconfigure rejects it
+    if( apps_common_lr11xx_get_atc_pa_pwr_cfg( &pa_pwr_cfg ) == true )
+    {
+        const lr11xx_radio_pa_cfg_t* applied_pa_cfg = &radio_cfg_applied.pa_pwr_cfg.pa_config;
+
+        if( ( pa_pwr_cfg.pa_config.pa_sel != applied_pa_cfg->pa_sel ) ||
+            ( pa_pwr_cfg.pa_config.pa_reg_supply != applied_pa_cfg->pa_reg_supply ) ||
+            ( pa_pwr_cfg.pa_config.pa_duty_cycle != applied_pa_cfg->pa_duty_cycle ) ||
+            ( pa_pwr_cfg.pa_config.pa_hp_sel != applied_pa_cfg->pa_hp_sel ) )
+        {
+            changes |= APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_PA_CFG;
+        }
+
+        if( pa_pwr_cfg.power != radio_cfg_applied.pa_pwr_cfg.power )
+        {
+            changes |= APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_TX_POWER;
+        }
+    }
+
+    if( ( ATC_M_LORA_RX_BOOST != 0 ) != radio_cfg_applied.rx_boost )
+    {
+        changes |= APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_RX_BOOST;
+    }
+
+    if( ( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_LORA ) &&
+        ( ( ATC_M_LORA_SF != lora_mod_params.sf ) || ( ATC_M_LORA_BW != lora_mod_params.bw ) ||
+          ( ATC_M_LORA_CR != lora_mod_params.cr ) ) )
+    {
+        changes |= APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_LORA_MOD_PARAMS;
+    }
+
+    return changes;
 }
 
+apps_common_lr11xx_radio_cfg_change_mask_t apps_common_lr11xx_radio_reconfigure( const void* context )
+{
+    const uint32_t start_cycles = apps_common_cycle_counter_get( );
+
+    const apps_common_lr11xx_radio_cfg_change_mask_t changes = apps_common_lr11xx_radio_get_pending_changes( );
+    smtc_shield_lr11xx_pa_pwr_cfg_t                  pa_pwr_cfg;
+
+    if( changes == APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_NONE )
+    {
+        return changes;
+    }
+
+    if( apps_common_lr11xx_get_atc_pa_pwr_cfg( &pa_pwr_cfg ) == false )
+    {
+        HAL_DBG_TRACE_ERROR( "Invalid target frequency or power level - reconfiguration rejected\n" );
+        return APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_NONE;
+    }
+
+    if( ( changes & APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_RF_FREQ ) != 0 )
+    {
+        ASSERT_LR11XX_RC( lr11xx_radio_set_rf_freq( context, ATC_M_RF_FREQ_IN_HZ ) );
+        radio_cfg_applied.rf_freq_in_hz = ATC_M_RF_FREQ_IN_HZ;
+    }
+
+    if( ( changes & APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_RSSI_CALIBRATION ) != 0 )
+    {
+        radio_cfg_applied.rssi_calibration_table =
+            smtc_shield_lr11xx_get_rssi_calibration_table( &shield, ATC_M_RF_FREQ_IN_HZ );
+        ASSERT_LR11XX_RC( lr11xx_radio_set_rssi_calibration( context, radio_cfg_applied.rssi_calibration_table ) );
+    }
+
+    if( ( changes & APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_PA_CFG ) != 0 )
+    {
+        ASSERT_LR11XX_RC( lr11xx_radio_set_pa_cfg( context, &( pa_pwr_cfg.pa_config ) ) );
+    }
+
+    // The TX power is relative to the selected PA, so it has to be re-sent whenever the PA changes
+    if( ( changes & ( APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_PA_CFG | APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_TX_POWER ) ) !=
+        0 )
+    {
+        ASSERT_LR11XX_RC( lr11xx_radio_set_tx_params( context, pa_pwr_cfg.power, PA_RAMP_TIME ) );
+        radio_cfg_applied.pa_pwr_cfg = pa_pwr_cfg;
+    }
+
+    if( ( changes & APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_RX_BOOST ) != 0 )
+    {
+        ASSERT_LR11XX_RC( lr11xx_radio_cfg_rx_boosted( context, ATC_M_LORA_RX_BOOST ) );
+        radio_cfg_applied.rx_boost = ( ATC_M_LORA_RX_BOOST != 0 );
+    }
+
+    if( ( changes & APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_LORA_MOD_PARAMS ) != 0 )
+    {
+        lora_mod_params.sf   = ATC_M_LORA_SF;
+        lora_mod_params.bw   = ATC_M_LORA_BW;
+        lora_mod_params.cr   = ATC_M_LORA_CR;
+        lora_mod_params.ldro = apps_common_compute_lora_ldro( ATC_M_LORA_SF, ATC_M_LORA_BW );
+        ASSERT_LR11XX_RC( lr11xx_radio_set_lora_mod_params( context, &lora_mod_params ) );
+    }
+
+    const uint32_t duration_in_us = apps_common_cycle_counter_to_us( apps_common_cycle_counter_get( ) - start_cycles );
+
+    HAL_DBG_TRACE_INFO( "Radio reconfigured (changes 0x%02X) in %u us - full init took %u us\n", changes,
+                        duration_in_us, radio_init_duration_in_us );
+
+    return changes;
+}
 
 void apps_common_lr11xx_radio_dbpsk_init( const void* context, const uint8_t payload_len )
 {
@@ -723,133 +1072,87 @@ void apps_common_lr11xx_receive( const void* context, uint8_t* buffer, uint8_t b
 
 void apps_common_lr11xx_irq_process( const void* context, lr11xx_system_irq_mask_t irq_filter_mask )
 {
-    if( irq_fired == true )
-    {
-        irq_fired = false;
-
-        lr11xx_system_irq_mask_t irq_regs;
-        lr11xx_system_get_and_clear_irq_status( context, &irq_regs );
-
-        HAL_DBG_TRACE_INFO( "Interrupt flags = 0x%08X\n", irq_regs );
-
-        irq_regs &= irq_filter_mask;
-
-        HAL_DBG_TRACE_INFO( "Interrupt flags (after filtering) = 0x%08X\n", irq_regs );
-
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_TX_DONE ) == LR11XX_SYSTEM_IRQ_TX_DONE )
-        {
-            HAL_DBG_TRACE_INFO( "Tx done\n" );
-            on_tx_done( );
-        }
+    irq_dispatch( context, irq_filter_mask, true );
+}
 
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_PREAMBLE_DETECTED ) == LR11XX_SYSTEM_IRQ_PREAMBLE_DETECTED )
-        {
-            HAL_DBG_TRACE_INFO( "Preamble detected\n" );
-            on_preamble_detected( );
-        }
+void apps_common_lr11xx_irq_process_quiet( const void* context, lr11xx_system_irq_mask_t irq_filter_mask )
+{
+    irq_dispatch( context, irq_filter_mask, false );
+}
 
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_HEADER_ERROR ) == LR11XX_SYSTEM_IRQ_HEADER_ERROR )
-        {
-            HAL_DBG_TRACE_ERROR( "Header error\n" );
-            on_header_error( );
-        }
+const void* apps_common_lr11xx_irq_get_context( void )
+{
+    return irq_context;
+}
 
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_SYNC_WORD_HEADER_VALID ) == LR11XX_SYSTEM_IRQ_SYNC_WORD_HEADER_VALID )
-        {
-            HAL_DBG_TRACE_INFO( "Syncword or header valid\n" );
-            on_syncword_header_valid( );
-        }
+uint32_t apps_common_lr11xx_irq_get_timestamp_in_us( void )
+{
+    return irq_timestamp_in_us;
+}
 
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_RX_DONE ) == LR11XX_SYSTEM_IRQ_RX_DONE )
-        {
-            if( ( irq_regs & LR11XX_SYSTEM_IRQ_CRC_ERROR ) == LR11XX_SYSTEM_IRQ_CRC_ERROR )
-            {
-                HAL_DBG_TRACE_ERROR( "CRC error\n" );
-                on_rx_crc_error( );
-            }
-            else if( ( irq_regs & LR11XX_SYSTEM_IRQ_FSK_LEN_ERROR ) == LR11XX_SYSTEM_IRQ_FSK_LEN_ERROR )
-            {
-                HAL_DBG_TRACE_ERROR( "FSK length error\n" );
-                on_fsk_len_error( );
-            }
-            else
-            {
-                HAL_DBG_TRACE_INFO( "Rx done\n" );
-                on_rx_done( );
-            }
-        }
+uint32_t apps_common_lr11xx_get_rx_done_delay_in_us( void )
+{
+    if( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_LORA )
+    {
+        return lr11xx_radio_timings_get_delay_between_last_bit_sent_and_rx_done_in_us( &lora_mod_params );
+    }
+    return 0;
+}
 
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_CAD_DONE ) == LR11XX_SYSTEM_IRQ_CAD_DONE )
-        {
-            HAL_DBG_TRACE_INFO( "CAD done\n" );
-            if( ( irq_regs & LR11XX_SYSTEM_IRQ_CAD_DETECTED ) == LR11XX_SYSTEM_IRQ_CAD_DETECTED )
-            {
-                HAL_DBG_TRACE_INFO( "Channel activity detected\n" );
-                on_cad_done_detected( );
-            }
-            else
-            {
-                HAL_DBG_TRACE_INFO( "No channel activity detected\n" );
-                on_cad_done_undetected( );
-            }
-        }
+uint32_t apps_common_lr11xx_get_tx_done_delay_in_us( void )
+{
+    return lr11xx_radio_timings_get_delay_between_last_bit_sent_and_tx_done_in_us( PA_RAMP_TIME );
+}
 
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_TIMEOUT ) == LR11XX_SYSTEM_IRQ_TIMEOUT )
-        {
-            HAL_DBG_TRACE_WARNING( "Rx timeout\n" );
-            on_rx_timeout( );
-        }
+uint32_t apps_common_lr11xx_get_rx_end_of_packet_in_us( void )
+{
+    return irq_timestamp_in_us - apps_common_lr11xx_get_rx_done_delay_in_us( );
+}
 
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_LORA_RX_TIMESTAMP ) == LR11XX_SYSTEM_IRQ_LORA_RX_TIMESTAMP )
-        {
-            HAL_DBG_TRACE_INFO( "LoRa Rx timestamp\n" );
-            on_lora_rx_timestamp( );
-        }
+uint32_t apps_common_lr11xx_get_tx_end_of_packet_in_us( void )
+{
+    return irq_timestamp_in_us - apps_common_lr11xx_get_tx_done_delay_in_us( );
+}
 
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_RTTOF_REQ_VALID ) == LR11XX_SYSTEM_IRQ_RTTOF_REQ_VALID )
-        {
-            HAL_DBG_TRACE_INFO( "RTToF request valid\n" );
-            on_rttof_request_valid( );
-        }
+void apps_common_lr11xx_irq_get_stats( const void* context, radio_irq_queue_stats_t* stats )
+{
+    radio_irq_queue_get_stats( radio_registry_get_irq_queue( context ), stats );
+}
 
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_RTTOF_REQ_DISCARDED ) == LR11XX_SYSTEM_IRQ_RTTOF_REQ_DISCARDED )
-        {
-            HAL_DBG_TRACE_INFO( "RTToF request discarded\n" );
-            on_rttof_request_discarded( );
-        }
+void apps_common_lr11xx_irq_reset_stats( const void* context )
+{
+    radio_irq_queue_reset_stats( radio_registry_get_irq_queue( context ) );
+}
 
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_RTTOF_RESP_DONE ) == LR11XX_SYSTEM_IRQ_RTTOF_RESP_DONE )
-        {
-            HAL_DBG_TRACE_INFO( "RTToF response done\n" );
-            on_rttof_response_done( );
-        }
+void apps_common_lr11xx_irq_print_stats( const void* context )
+{
+    radio_irq_queue_stats_t stats;
 
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_RTTOF_EXCH_VALID ) == LR11XX_SYSTEM_IRQ_RTTOF_EXCH_VALID )
-        {
-            HAL_DBG_TRACE_INFO( "RTToF exchange valid\n" );
-            on_rttof_exchange_valid( );
-        }
+    radio_irq_queue_get_stats( radio_registry_get_irq_queue( context ), &stats );
 
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_RTTOF_TIMEOUT ) == LR11XX_SYSTEM_IRQ_RTTOF_TIMEOUT )
-        {
-            HAL_DBG_TRACE_INFO( "RTToF timeout\n" );
-            on_rttof_timeout( );
-        }
-
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_WIFI_SCAN_DONE ) == LR11XX_SYSTEM_IRQ_WIFI_SCAN_DONE )
-        {
-            HAL_DBG_TRACE_INFO( "Wi-Fi scan done\n" );
-            on_wifi_scan_done( );
-        }
+    HAL_DBG_TRACE_PRINTF( "IRQ queue %u: %u events, %u dispatched, %u overflows, depth high-water mark %u/%u\n",
+                          radio_registry_get_id( context ), stats.nb_events, stats.nb_dispatched, stats.nb_overflows,
+                          stats.depth_high_water_mark, RADIO_IRQ_QUEUE_SIZE );
+    if( stats.nb_dispatched != 0 )
+    {
+        HAL_DBG_TRACE_PRINTF( "IRQ latency: min %u us, avg %u us, max %u us\n",
+                              apps_common_cycle_counter_to_us( stats.latency_min_in_cycles ),
+                              apps_common_cycle_counter_to_us(
+                                  ( uint32_t ) ( stats.latency_sum_in_cycles / stats.nb_dispatched ) ),
+                              apps_common_cycle_counter_to_us( stats.latency_max_in_cycles ) );
+    }
+}
 
-        if( ( irq_regs & LR11XX_SYSTEM_IRQ_GNSS_SCAN_DONE ) == LR11XX_SYSTEM_IRQ_GNSS_SCAN_DONE )
-        {
-            HAL_DBG_TRACE_INFO( "GNSS scan done\n" );
-            on_gnss_scan_done( );
-        }
+void apps_common_lr11xx_wait_for_event( void )
+{
+    apps_entropy_process( );
 
-        HAL_DBG_TRACE_PRINTF( "\n" );
+    // Flash housekeeping runs in idle time; skip sleeping while there is more of it to do
+    if( apps_kv_store_process( ) == false )
+    {
+        smtc_hal_mcu_lpm_wait_for_event( apps_common_lr11xx_is_event_pending );
     }
+    smtc_hal_mcu_timer_soft_process( );
 }
 
 void apps_common_lr11xx_handle_pre_tx( void )
@@ -950,6 +1253,132 @@ uint32_t get_time_on_air_in_ms( void )
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
+static void irq_dispatch( const void* context, lr11xx_system_irq_mask_t irq_filter_mask, bool is_traced )
+{
+    radio_irq_queue_t* irq_queue = radio_registry_get_irq_queue( context );
+    radio_irq_event_t  event;
+
+    if( irq_queue == NULL )
+    {
+        return;
+    }
+
+    irq_context = context;
+
+    while( radio_irq_queue_pop( irq_queue, &event ) == true )
+    {
+        lr11xx_system_irq_mask_t irq_regs;
+        lr11xx_system_get_and_clear_irq_status( context, &irq_regs );
+
+        const lr11xx_system_irq_mask_t irq_regs_filtered = irq_regs & irq_filter_mask;
+
+        // The cycle counter wraps every 53 s, so the edge is moved to the microsecond timebase, which only wraps after
+        // 71 minutes - both counters are read back to back and the edge is rebuilt from the elapsed cycles
+        const uint32_t now_in_us         = smtc_hal_mcu_timer_get_time_in_us( );
+        const uint32_t latency_in_cycles = apps_common_cycle_counter_get( ) - event.timestamp_in_cycles;
+
+        radio_irq_queue_record_latency( irq_queue, latency_in_cycles );
+        irq_timestamp_in_us = now_in_us - apps_common_cycle_counter_to_us( latency_in_cycles );
+
+        for( uint8_t i = 0; i < IRQ_HANDLERS_COUNT; i++ )
+        {
+            if( irq_handler_matches( &irq_handlers[i], irq_regs_filtered ) == true )
+            {
+                irq_handlers[i].callback( );
+            }
+        }
+
+        if( is_traced == false )
+        {
+            continue;
+        }
+
+        // Traces are only emitted once all the callbacks have been called to keep them out of the dispatch latency
+        HAL_DBG_TRACE_INFO( "Interrupt flags = 0x%08X (after filtering = 0x%08X)\n", irq_regs, irq_regs_filtered );
+        for( uint8_t i = 0; i < IRQ_HANDLERS_COUNT; i++ )
+        {
+            if( irq_handler_matches( &irq_handlers[i], irq_regs_filtered ) == true )
+            {
+                irq_handler_trace( &irq_handlers[i] );
+            }
+        }
+        HAL_DBG_TRACE_PRINTF( "\n" );
+    }
+
+    irq_context = NULL;
+}
+
+static void apps_common_lr11xx_irq_handler( void* context, uint32_t irq_filter_mask )
+{
+    apps_common_lr11xx_irq_process( context, irq_filter_mask );
+}
+
+static bool apps_common_lr11xx_is_event_pending( void )
+{
+    return ( radio_registry_is_event_pending( ) == true ) ||
+           ( smtc_hal_mcu_timer_soft_is_expiry_pending( ) == true ) || ( uart_is_at_command_pending( ) == true );
+}
+
+static bool irq_handler_matches( const irq_handler_t* handler, lr11xx_system_irq_mask_t irq_regs )
+{
+    return ( ( irq_regs & handler->required_mask ) == handler->required_mask ) &&
+           ( ( irq_regs & handler->rejected_mask ) == 0 );
+}
+
+static void irq_handler_trace( const irq_handler_t* handler )
+{
+    switch( handler->trace_level )
+    {
+    case IRQ_TRACE_LEVEL_ERROR:
+        HAL_DBG_TRACE_ERROR( "%s\n", handler->name );
+        break;
+    case IRQ_TRACE_LEVEL_WARNING:
+        HAL_DBG_TRACE_WARNING( "%s\n", handler->name );
+        break;
+    default:
+        HAL_DBG_TRACE_INFO( "%s\n", handler->name );
+        break;
+    }
+}
+
+static bool apps_common_lr11xx_get_atc_pa_pwr_cfg( smtc_shield_lr11xx_pa_pwr_cfg_t* pa_pwr_cfg )
+{
+    // 从 PA 表中获取对应的配置（注意：返回的是 const 指针）
+    const smtc_shield_lr11xx_pa_pwr_cfg_t* pa_pwr_cfg_const =
+        smtc_shield_lr11xx_get_pa_pwr_cfg( &shield, ATC_M_RF_FREQ_IN_HZ, ATC_M_TX_OUTPUT_POWER_DBM );
+
+    if( pa_pwr_cfg_const == NULL )
+    {
+        return false;
+    }
+
+    // 复制配置（这样可以修改），再根据 AT 指令设置的参数覆盖 PA 配置
+    *pa_pwr_cfg = *pa_pwr_cfg_const;
+
+    if( ATC_M_PA_PA_DUTY_CYCLE != 1000 )
+    {
+        pa_pwr_cfg->pa_config.pa_duty_cycle = ( uint8_t ) ATC_M_PA_PA_DUTY_CYCLE;
+    }
+    if( ATC_M_PA_PA_SEL != 1000 )
+    {
+        pa_pwr_cfg->pa_config.pa_sel = ( lr11xx_radio_pa_selection_t ) ATC_M_PA_PA_SEL;
+    }
+    if( ATC_M_PA_PA_HP_SEL != 1000 )
+    {
+        pa_pwr_cfg->pa_config.pa_hp_sel = ( uint8_t ) ATC_M_PA_PA_HP_SEL;
+    }
+    if( ATC_M_PA_PA_RGE_SUPPLY != 1000 )
+    {
+        pa_pwr_cfg->pa_config.pa_reg_supply = ( lr11xx_radio_pa_reg_supply_t ) ATC_M_PA_PA_RGE_SUPPLY;
+    }
+    if( ATC_M_PA_PA_REAL_POWER != 1000 )
+    {
+        pa_pwr_cfg->power = ( int8_t ) ATC_M_PA_PA_REAL_POWER;
+    }
+
+    return true;
+}
+
 void print_common_configuration( void )
 {
     HAL_DBG_TRACE_INFO( "Common parameters:\n" );
@@ -1028,7 +1457,7 @@ void print_driver_version( void )
 
 void radio_on_dio_irq( void* context )
 {
-    irq_fired = true;
+    radio_irq_queue_push( ( radio_irq_queue_t* ) context, apps_common_cycle_counter_get( ) );
 }
 void on_tx_done( void )
 {
@@ -46,12 +46,17 @@ extern "C" {
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "lr11xx_radio_types_str.h"
 #include "apps_configuration.h"
 #include "lr11xx_hal_context.h"
 #include "lr11xx_system_types.h"
 #include "lr11xx_radio_types.h"
 #include "lr11xx_radio.h"
+#include "apps_cycle_counter.h"
+#include "radio_irq_queue.h"
+#include "radio_registry.h"
+#include "smtc_hal_mcu_timer.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -73,6 +78,25 @@ extern "C" {
  * --- PUBLIC TYPES ------------------------------------------------------------
  */
 
+/*!
+ * @brief Radio configuration items which can be re-applied by apps_common_lr11xx_radio_reconfigure
+ */
+enum apps_common_lr11xx_radio_cfg_change_e
+{
+    APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_NONE             = 0x00,
+    APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_RF_FREQ          = 0x01,  //!< RF frequency
+    APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_RSSI_CALIBRATION = 0x02,  //!< RSSI calibration table (new frequency band)
+    APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_PA_CFG           = 0x04,  //!< PA configuration
+    APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_TX_POWER         = 0x08,  //!< Output power
+    APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_RX_BOOST         = 0x10,  //!< RX boosted mode
+    APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_LORA_MOD_PARAMS  = 0x20,  //!< LoRa SF / BW / CR (and LDRO)
+};
+
+/*!
+ * @brief Bitmask of @ref apps_common_lr11xx_radio_cfg_change_e values
+ */
+typedef uint8_t apps_common_lr11xx_radio_cfg_change_mask_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
@@ -88,6 +112,20 @@ extern "C" {
  */
 lr11xx_hal_context_t* apps_common_lr11xx_get_context( );
 
+/*!
+ * @brief Initialise the lr11xx_hal_context_t object of a radio wired to the given MCU resources and register it
+ *
+ * @remark apps_common_lr11xx_get_context is equivalent to radio 0 bound to RADIO_REGISTRY_BINDING_ARDUINO. Each radio
+ * gets its own DIO event queue, served by radio_registry_dispatch or apps_common_lr11xx_irq_process
+ *
+ * @param [in] radio_id  Index of the radio, lower than RADIO_REGISTRY_MAX_RADIOS
+ * @param [in] binding  SPI peripheral and pins the radio is wired to
+ *
+ * @returns Pointer to the lr11xx_hal_context_t object of the radio, NULL if radio_id is out of range
+ */
+lr11xx_hal_context_t* apps_common_lr11xx_get_context_from_binding( uint8_t                         radio_id,
+                                                                   const radio_registry_binding_t* binding );
+
 /*!
  * @brief Initialize the system configuration of the transceiver
  */
@@ -100,6 +138,25 @@ void apps_common_shield_init( void );
  */
 void apps_common_lr11xx_system_init( const lr11xx_hal_context_t* context );
 
+/*!
+ * @brief Read a batch of random numbers from the radio and mix it into the entropy pool
+ *
+ * @remark Called by apps_common_lr11xx_system_init. The radio has to be idle
+ *
+ * @param [in] context  Pointer to the radio context
+ */
+void apps_common_lr11xx_harvest_entropy( const void* context );
+
+/*!
+ * @brief Measure with the cycle counter the cost of the NSS toggling through the generic GPIO API and through the BSRR
+ * fast path, and the cost of a short radio transaction, then print them
+ *
+ * @remark The radio has to be awake: it is sent a thousand GetIrqStatus commands
+ *
+ * @param [in] context  Pointer to the radio context
+ */
+void apps_common_lr11xx_print_gpio_benchmark( const void* context );
+
 /*!
  * @brief Initialize the radio configuration of the transceiver
  *
@@ -107,6 +164,31 @@ void apps_common_lr11xx_system_init( const lr11xx_hal_context_t* context );
  */
 void apps_common_lr11xx_radio_init( const void* context );
 
+/*!
+ * @brief Get the radio configuration items whose ATC_M_* parameter differs from what is applied to the transceiver
+ *
+ * @returns Bitmask of pending changes, APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_NONE if apps_common_lr11xx_radio_init has
+ * not been called yet
+ */
+apps_common_lr11xx_radio_cfg_change_mask_t apps_common_lr11xx_radio_get_pending_changes( void );
+
+/*!
+ * @brief Apply the ATC_M_* parameters changed since the last radio init / reconfiguration
+ *
+ * Only the driver calls required by the pending changes are issued (e.g. a frequency change within the same band is
+ * a single lr11xx_radio_set_rf_freq call). The reconfiguration latency is reported on the debug interface along with
+ * the duration of the last full radio init.
+ *
+ * @remark Must be called while the transceiver is in standby, typically from a TX / RX done handler before the next
+ * packet is started
+ *
+ * @param [in] context  Pointer to the radio context
+ *
+ * @returns Bitmask of the changes applied, APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_NONE if nothing was pending or if the
+ * new frequency / power pair is not supported by the shield
+ */
+apps_common_lr11xx_radio_cfg_change_mask_t apps_common_lr11xx_radio_reconfigure( const void* context );
+
 /*!
  * @brief Initialize the radio configuration of the transceiver for dbpsk only
  *
@@ -179,8 +261,8 @@ void apps_common_lr11xx_receive( const void* context, uint8_t* buffer, uint8_t b
 /*!
  * @brief Interface to lr11xx interrupt processing routine
  *
- * This function fetched the IRQ mask from the lr11xx and process the raised IRQ if the corresponding bit is also set in
- * irq_filter.
+ * For each DIO event queued by the interrupt handler, this function fetches the IRQ mask from the lr11xx and calls the
+ * routine of each raised IRQ whose bit is also set in irq_filter.
  * The argument irq_filter allows to not process an IRQ even if it is raised by the lr11xx.
  *
  * @warning This function must be called from the main loop of project to dispense all the lr11xx interrupt routine
@@ -190,6 +272,106 @@ void apps_common_lr11xx_receive( const void* context, uint8_t* buffer, uint8_t b
  */
 void apps_common_lr11xx_irq_process( const void* context, lr11xx_system_irq_mask_t irq_filter_mask );
 
+/*!
+ * @brief Same as apps_common_lr11xx_irq_process, without the trace of the raised interrupts
+ *
+ * @remark For the loops that must not print anything per frame, like throughput measurements
+ *
+ * @param [in] context  Pointer to the radio context
+ * @param [in] irq_filter_mask  Mask of IRQ to process
+ */
+void apps_common_lr11xx_irq_process_quiet( const void* context, lr11xx_system_irq_mask_t irq_filter_mask );
+
+/*!
+ * @brief Get the radio whose interrupt routines are being called
+ *
+ * @remark Lets the on_* routines tell the radios apart when several of them are registered
+ *
+ * @returns Pointer to the radio context given to apps_common_lr11xx_irq_process, NULL outside of it
+ */
+const void* apps_common_lr11xx_irq_get_context( void );
+
+/*!
+ * @brief Get the time of the DIO edge of the interrupt being dispatched
+ *
+ * The edge is stamped with the cycle counter in the EXTI interrupt handler, so neither the main loop latency nor the
+ * traces add jitter to it. It is moved to the timebase of smtc_hal_mcu_timer_get_time_in_us when the event is
+ * dispatched.
+ *
+ * @remark Only meaningful in the callbacks called by apps_common_lr11xx_irq_process
+ *
+ * @returns DIO edge timestamp, in microseconds
+ */
+uint32_t apps_common_lr11xx_irq_get_timestamp_in_us( void );
+
+/*!
+ * @brief Get the delay between the last bit on air and the RX_DONE interrupt with the current radio configuration
+ *
+ * @returns lr11xx_radio_timings_get_delay_between_last_bit_sent_and_rx_done_in_us for LoRa, 0 for the other packet
+ * types
+ */
+uint32_t apps_common_lr11xx_get_rx_done_delay_in_us( void );
+
+/*!
+ * @brief Get the delay between the last bit on air and the TX_DONE interrupt with PA_RAMP_TIME
+ *
+ * @returns lr11xx_radio_timings_get_delay_between_last_bit_sent_and_tx_done_in_us
+ */
+uint32_t apps_common_lr11xx_get_tx_done_delay_in_us( void );
+
+/*!
+ * @brief Get the time the last bit of the packet which raised RX_DONE was on air
+ *
+ * The RX_DONE edge is moved back by apps_common_lr11xx_get_rx_done_delay_in_us.
+ *
+ * @remark Only meaningful in on_rx_done
+ *
+ * @returns End of packet timestamp, in the timebase of smtc_hal_mcu_timer_get_time_in_us
+ */
+uint32_t apps_common_lr11xx_get_rx_end_of_packet_in_us( void );
+
+/*!
+ * @brief Get the time the last bit of the packet which raised TX_DONE was on air
+ *
+ * The TX_DONE edge is moved back by apps_common_lr11xx_get_tx_done_delay_in_us.
+ *
+ * @remark Only meaningful in on_tx_done
+ *
+ * @returns End of packet timestamp, in the timebase of smtc_hal_mcu_timer_get_time_in_us
+ */
+uint32_t apps_common_lr11xx_get_tx_end_of_packet_in_us( void );
+
+/*!
+ * @brief Get the statistics of the DIO event queue of a radio
+ *
+ * @param [in] context  Pointer to the radio context
+ * @param [out] stats  Queue depth high-water mark, overflow count and DIO edge to dispatch latency
+ */
+void apps_common_lr11xx_irq_get_stats( const void* context, radio_irq_queue_stats_t* stats );
+
+/*!
+ * @brief Reset the statistics of the DIO event queue of a radio
+ *
+ * @param [in] context  Pointer to the radio context
+ */
+void apps_common_lr11xx_irq_reset_stats( const void* context );
+
+/*!
+ * @brief Print the statistics of the DIO event queue of a radio
+ *
+ * @param [in] context  Pointer to the radio context
+ */
+void apps_common_lr11xx_irq_print_stats( const void* context );
+
+/*!
+ * @brief Put the MCU in low power mode until a DIO event, a software timer expiry or an AT command is waiting to be
+ * processed, then call the callbacks of the expired software timers
+ *
+ * @remark The deepest power mode is the one allowed with smtc_hal_mcu_lpm_set_max_mode. Events raised by the callbacks
+ * called from the main loop must be handled before calling this function as they do not wake the MCU up.
+ */
+void apps_common_lr11xx_wait_for_event( void );
+
 /*!
  * @brief Computes time on air, packet type agnostic
  */
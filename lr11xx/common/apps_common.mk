@@ -118,14 +118,39 @@ C_SOURCES +=  \
 $(TOP_DIR)/lr11xx/common/apps_common.c \
 $(TOP_DIR)/lr11xx/common/lr11xx_hal.c \
 $(TOP_DIR)/lr11xx/common/apps_version.c \
+$(TOP_DIR)/lr11xx/common/atc_lr11xx.c \
+$(TOP_DIR)/lr11xx/common/apps_radio_lr11xx.c \
 $(TOP_DIR)/common/src/smtc_hal_dbg_trace.c \
 $(TOP_DIR)/common/src/common_version.c \
 $(TOP_DIR)/common/src/smtc_shield_pinout_mapping.c \
 $(TOP_DIR)/common/src/uart_init.c \
+$(TOP_DIR)/common/src/radio_irq_queue.c \
+$(TOP_DIR)/common/src/radio_registry.c \
+$(TOP_DIR)/common/src/apps_radio.c \
+$(TOP_DIR)/common/src/apps_cycle_counter.c \
+$(TOP_DIR)/common/src/atc.c \
+$(TOP_DIR)/common/src/apps_kv_store.c \
+$(TOP_DIR)/libs/smtc_kv_store/src/smtc_kv_store.c \
+$(TOP_DIR)/common/src/apps_entropy.c \
+$(TOP_DIR)/libs/smtc_entropy_pool/src/smtc_entropy_pool.c \
+$(TOP_DIR)/libs/smtc_time_sync/src/smtc_time_sync.c \
+$(TOP_DIR)/common/src/apps_link_stats.c \
+$(TOP_DIR)/common/src/apps_rx_pool.c \
+$(TOP_DIR)/common/src/apps_cad_scan.c \
+$(TOP_DIR)/common/src/apps_cad_tuner.c \
+$(TOP_DIR)/common/src/apps_spectral_sweep.c \
+$(TOP_DIR)/libs/smtc_link_stats/src/smtc_link_stats.c \
+$(TOP_DIR)/common/src/apps_occupancy_recorder.c \
+$(TOP_DIR)/libs/smtc_occupancy_log/src/smtc_occupancy_log.c \
 
 C_INCLUDES +=  \
 -I$(TOP_DIR)/lr11xx/common \
--I$(TOP_DIR)/common/inc
+-I$(TOP_DIR)/common/inc \
+-I$(TOP_DIR)/libs/smtc_kv_store/src \
+-I$(TOP_DIR)/libs/smtc_entropy_pool/src \
+-I$(TOP_DIR)/libs/smtc_time_sync/src \
+-I$(TOP_DIR)/libs/smtc_link_stats/src \
+-I$(TOP_DIR)/libs/smtc_occupancy_log/src
 
 ifneq (,$(findstring LR1110,$(RADIO_SHIELD)))
 TRX_IS_GEOLOCATION_CAPABLE = true
@@ -138,6 +163,7 @@ endif
 C_SOURCES +=  \
 $(TOP_DIR)/lr11xx/lr11xx_driver/src/lr11xx_system.c \
 $(TOP_DIR)/lr11xx/lr11xx_driver/src/lr11xx_radio.c \
+$(TOP_DIR)/lr11xx/lr11xx_driver/src/lr11xx_radio_timings.c \
 $(TOP_DIR)/lr11xx/lr11xx_driver/src/lr11xx_regmem.c \
 $(TOP_DIR)/lr11xx/lr11xx_driver/src/lr11xx_wifi.c \
 $(TOP_DIR)/lr11xx/lr11xx_driver/src/lr11xx_gnss.c \
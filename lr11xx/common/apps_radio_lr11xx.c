@@ -0,0 +1,325 @@
+/*!
+ * @file      apps_radio_lr11xx.c
+ *
+ * @brief     LR11xx adapter of the chip-agnostic radio API
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include "apps_radio.h"
+#include "apps_radio_lr11xx.h"
+#include "apps_common.h"
+#include "apps_utilities.h"
+#include "smtc_hal_dbg_trace.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*!
+ * @brief Number of calls timed per path by apps_radio_lr11xx_print_call_benchmark
+ */
+#define CALL_BENCHMARK_NB_ITERATIONS 100
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+// The adapters pass the LoRa and CAD codes through: they must match the LR11xx register values
+_Static_assert( ( int ) APPS_RADIO_LORA_SF12 == ( int ) LR11XX_RADIO_LORA_SF12, "SF codes differ" );
+_Static_assert( ( int ) APPS_RADIO_LORA_BW_10 == ( int ) LR11XX_RADIO_LORA_BW_10, "BW codes differ" );
+_Static_assert( ( int ) APPS_RADIO_LORA_BW_41 == ( int ) LR11XX_RADIO_LORA_BW_41, "BW codes differ" );
+_Static_assert( ( int ) APPS_RADIO_LORA_BW_500 == ( int ) LR11XX_RADIO_LORA_BW_500, "BW codes differ" );
+_Static_assert( ( int ) APPS_RADIO_LORA_CR_4_8 == ( int ) LR11XX_RADIO_LORA_CR_4_8, "CR codes differ" );
+_Static_assert( ( int ) APPS_RADIO_CAD_EXIT_MODE_TX == ( int ) LR11XX_RADIO_CAD_EXIT_MODE_TX, "CAD codes differ" );
+_Static_assert( ( int ) APPS_RADIO_STANDBY_CFG_XOSC == ( int ) LR11XX_SYSTEM_STANDBY_CFG_XOSC, "Standby codes differ" );
+
+/*!
+ * @brief Best measured CAD detection peak, per number of symbols (2, 4, 8, 16), bandwidth (62.5 kHz to 500 kHz) and
+ * spreading factor (SF5 to SF12) - 0 where no better value than the one of the application is known
+ */
+static const uint8_t cad_detect_peaks[4][4][8] = {
+    // 2 symbols
+    {
+        // SF5, SF6, SF7, SF8, SF9, SF10, SF11, SF12,
+        { 39, 45, 47, 53, 59, 61, 64, 63 },  //  BW_62500
+        { 44, 51, 49, 55, 56, 60, 62, 68 },  // BW_125000
+        { 48, 48, 50, 55, 55, 59, 61, 65 },  // BW_250000
+        { 76, 80, 71, 77, 69, 0, 0, 0 },     // BW_500000
+    },
+    // 4 symbols
+    {
+        // SF5, SF6, SF7, SF8, SF9, SF10, SF11, SF12,
+        { 43, 45, 45, 50, 53, 57, 59, 63 },  //  BW_62500
+        { 44, 46, 49, 53, 53, 55, 57, 62 },  // BW_125000
+        { 45, 47, 47, 51, 51, 56, 59, 62 },  // BW_250000
+        { 58, 66, 58, 65, 62, 55, 60, 57 },  // BW_500000
+    },
+    // 8 symbols
+    {
+        // SF5, SF6, SF7, SF8, SF9, SF10, SF11, SF12,
+        { 43, 44, 46, 48, 51, 53, 56, 59 },  //  BW_62500
+        { 45, 43, 44, 50, 52, 55, 56, 61 },  // BW_125000
+        { 42, 44, 45, 48, 50, 53, 55, 60 },  // BW_250000
+        { 49, 52, 50, 59, 56, 57, 57, 60 },  // BW_500000
+    },
+    // 16 symbols
+    {
+        // SF5, SF6, SF7, SF8, SF9, SF10, SF11, SF12,
+        { 41, 44, 43, 46, 49, 52, 54, 60 },  //  BW_62500
+        { 42, 42, 43, 48, 49, 53, 55, 59 },  // BW_125000
+        { 41, 42, 43, 48, 48, 53, 54, 58 },  // BW_250000
+        { 44, 47, 45, 53, 52, 53, 57, 62 },  // BW_500000
+    },
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC VARIABLES --------------------------------------------------------
+ */
+
+const apps_radio_ops_t apps_radio_lr11xx_ops = {
+    .get_context                   = apps_radio_lr11xx_get_context,
+    .print_version                 = apps_radio_lr11xx_print_version,
+    .init                          = apps_radio_lr11xx_init,
+    .init_dbpsk                    = apps_radio_lr11xx_init_dbpsk,
+    .reconfigure                   = apps_radio_lr11xx_reconfigure,
+    .is_lora_pkt_type              = apps_radio_lr11xx_is_lora_pkt_type,
+    .set_rf_freq                   = apps_radio_lr11xx_set_rf_freq,
+    .set_fs                        = apps_radio_lr11xx_set_fs,
+    .set_standby                   = apps_radio_lr11xx_set_standby,
+    .set_lora_params               = apps_radio_lr11xx_set_lora_params,
+    .set_irq_mask                  = apps_radio_lr11xx_set_irq_mask,
+    .write_payload                 = apps_radio_lr11xx_write_payload,
+    .read_payload                  = apps_radio_lr11xx_read_payload,
+    .read_payload_head             = apps_radio_lr11xx_read_payload_head,
+    .get_lora_pkt_status           = apps_radio_lr11xx_get_lora_pkt_status,
+    .get_gfsk_pkt_status           = apps_radio_lr11xx_get_gfsk_pkt_status,
+    .receive_packet                = apps_radio_lr11xx_receive_packet,
+    .set_tx                        = apps_radio_lr11xx_set_tx,
+    .set_tx_cw                     = apps_radio_lr11xx_set_tx_cw,
+    .set_tx_infinite_preamble      = apps_radio_lr11xx_set_tx_infinite_preamble,
+    .set_rx                        = apps_radio_lr11xx_set_rx,
+    .set_rx_continuous             = apps_radio_lr11xx_set_rx_continuous,
+    .get_rssi_inst                 = apps_radio_lr11xx_get_rssi_inst,
+    .start_cad                     = apps_radio_lr11xx_start_cad,
+    .restart_cad                   = apps_radio_lr11xx_restart_cad,
+    .get_cad_recommended_params    = apps_radio_lr11xx_get_cad_recommended_params,
+    .get_and_clear_irq_status      = apps_radio_lr11xx_get_and_clear_irq_status,
+    .get_rx_done_delay_in_us       = apps_radio_lr11xx_get_rx_done_delay_in_us,
+    .get_tx_done_delay_in_us       = apps_radio_lr11xx_get_tx_done_delay_in_us,
+    .is_timing_model_characterised = apps_radio_lr11xx_is_timing_model_characterised,
+    .wait_for_event                = apps_radio_lr11xx_wait_for_event,
+    .print_call_benchmark          = apps_radio_lr11xx_print_call_benchmark,
+    .print_gpio_benchmark          = apps_radio_lr11xx_print_gpio_benchmark,
+    .print_irq_stats               = apps_radio_lr11xx_print_irq_stats,
+};
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void* apps_radio_lr11xx_get_context( uint8_t radio_id, const radio_registry_binding_t* binding )
+{
+    return apps_common_lr11xx_get_context_from_binding( radio_id, binding );
+}
+
+void apps_radio_lr11xx_print_version( void )
+{
+    apps_common_print_sdk_driver_version( );
+}
+
+void apps_radio_lr11xx_init( const void* context )
+{
+    apps_common_lr11xx_system_init( context );
+    apps_common_lr11xx_fetch_and_print_version( context );
+    apps_common_lr11xx_radio_init( context );
+}
+
+void apps_radio_lr11xx_init_dbpsk( const void* context, uint8_t payload_length )
+{
+    apps_common_lr11xx_system_init( context );
+    apps_common_lr11xx_fetch_and_print_version( context );
+    apps_common_lr11xx_radio_dbpsk_init( context, payload_length );
+}
+
+void apps_radio_lr11xx_get_cad_recommended_params( apps_radio_lora_sf_t sf, apps_radio_lora_bw_t bw,
+                                                   apps_radio_cad_params_t* params )
+{
+    uint8_t symbol_index = 0;
+    uint8_t detect_peak  = 0;
+
+    if( ( bw < APPS_RADIO_LORA_BW_62 ) || ( bw > APPS_RADIO_LORA_BW_500 ) || ( sf < APPS_RADIO_LORA_SF5 ) ||
+        ( sf > APPS_RADIO_LORA_SF12 ) )
+    {
+        HAL_DBG_TRACE_WARNING( "CAD may not function properly, no detection peak measured for SF%d and this bandwidth\n",
+                               sf );
+        return;
+    }
+
+    while( ( symbol_index < 4 ) && ( ( 2u << symbol_index ) != params->nb_symbols ) )
+    {
+        symbol_index++;
+    }
+    if( symbol_index == 4 )
+    {
+        HAL_DBG_TRACE_WARNING( "CAD may not function properly, no detection peak measured for %d symbols\n",
+                               params->nb_symbols );
+        return;
+    }
+
+    detect_peak = cad_detect_peaks[symbol_index][bw - APPS_RADIO_LORA_BW_62][sf - APPS_RADIO_LORA_SF5];
+    if( detect_peak != 0 )
+    {
+        params->detect_peak = detect_peak;
+    }
+}
+
+bool apps_radio_lr11xx_receive_packet( const void* context, uint32_t rx_restart_timeout_in_ms,
+                                       apps_radio_rx_packet_t* packet )
+{
+    lr11xx_radio_rx_buffer_status_t rx_buffer_status;
+    bool                            is_read = false;
+
+    packet->length = 0;
+
+    // Three commands back to back: each one only waits for BUSY to drop after the previous one
+    ASSERT_LR11XX_RC( lr11xx_radio_get_rx_buffer_status( context, &rx_buffer_status ) );
+    if( PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_LORA )
+    {
+        lr11xx_radio_pkt_status_lora_t pkt_status_lora;
+
+        ASSERT_LR11XX_RC( lr11xx_radio_get_lora_pkt_status( context, &pkt_status_lora ) );
+        packet->pkt_status.lora.rssi_pkt_in_dbm        = pkt_status_lora.rssi_pkt_in_dbm;
+        packet->pkt_status.lora.snr_pkt_in_db          = pkt_status_lora.snr_pkt_in_db;
+        packet->pkt_status.lora.signal_rssi_pkt_in_dbm = pkt_status_lora.signal_rssi_pkt_in_dbm;
+    }
+    else
+    {
+        lr11xx_radio_pkt_status_gfsk_t pkt_status_gfsk;
+
+        ASSERT_LR11XX_RC( lr11xx_radio_get_gfsk_pkt_status( context, &pkt_status_gfsk ) );
+        packet->pkt_status.gfsk.rssi_sync_in_dbm = pkt_status_gfsk.rssi_sync_in_dbm;
+        packet->pkt_status.gfsk.rssi_avg_in_dbm  = pkt_status_gfsk.rssi_avg_in_dbm;
+    }
+    if( rx_buffer_status.pld_len_in_bytes <= APPS_RADIO_RX_PACKET_MAX_LENGTH )
+    {
+        ASSERT_LR11XX_RC( lr11xx_regmem_read_buffer8( context, packet->payload, rx_buffer_status.buffer_start_pointer,
+                                                      rx_buffer_status.pld_len_in_bytes ) );
+        packet->length = rx_buffer_status.pld_len_in_bytes;
+        is_read        = true;
+    }
+    packet->latency_in_cycles = apps_common_cycle_counter_get( ) - packet->rx_done_in_cycles;
+
+    // The radio buffer has been read out, so the next packet can be received into it right away
+    if( rx_restart_timeout_in_ms != APPS_RADIO_RX_RESTART_NONE )
+    {
+        ASSERT_LR11XX_RC( lr11xx_radio_set_rx( context, rx_restart_timeout_in_ms ) );
+        apps_common_lr11xx_handle_pre_rx( );
+    }
+
+    if( is_read == false )
+    {
+        HAL_DBG_TRACE_ERROR( "Received payload (size: %d) is bigger than the buffer (size: %d)!\n",
+                             rx_buffer_status.pld_len_in_bytes, APPS_RADIO_RX_PACKET_MAX_LENGTH );
+    }
+    return is_read;
+}
+
+void apps_radio_lr11xx_print_call_benchmark( const void* context )
+{
+    const apps_radio_t radio = { .ops = &apps_radio_lr11xx_ops, .context = ( void* ) context };
+    // Read through a volatile pointer so that the compiler cannot bind the indirect call at build time
+    const apps_radio_ops_t* volatile ops      = &apps_radio_lr11xx_ops;
+    apps_radio_call_benchmark_t      overhead = { 0 };
+    apps_radio_call_benchmark_t      direct   = { 0 };
+    apps_radio_call_benchmark_t      api      = { 0 };
+    apps_radio_call_benchmark_t      table    = { 0 };
+    volatile uint32_t                result;
+    uint32_t                         start_cycles;
+
+    for( int i = 0; i < CALL_BENCHMARK_NB_ITERATIONS; i++ )
+    {
+        start_cycles = apps_common_cycle_counter_get( );
+        apps_radio_call_benchmark_record( &overhead, apps_common_cycle_counter_get( ) - start_cycles );
+
+        start_cycles = apps_common_cycle_counter_get( );
+        result       = apps_common_lr11xx_get_tx_done_delay_in_us( );
+        apps_radio_call_benchmark_record( &direct, apps_common_cycle_counter_get( ) - start_cycles );
+
+        start_cycles = apps_common_cycle_counter_get( );
+        result       = apps_radio_get_tx_done_delay_in_us( &radio );
+        apps_radio_call_benchmark_record( &api, apps_common_cycle_counter_get( ) - start_cycles );
+
+        start_cycles = apps_common_cycle_counter_get( );
+        result       = ops->get_tx_done_delay_in_us( context );
+        apps_radio_call_benchmark_record( &table, apps_common_cycle_counter_get( ) - start_cycles );
+    }
+    ( void ) result;
+
+    HAL_DBG_TRACE_INFO( "Radio call benchmark, get_tx_done_delay_in_us (no SPI) x %u:\n",
+                        CALL_BENCHMARK_NB_ITERATIONS );
+    apps_radio_call_benchmark_print( "cycle counter", &overhead );
+    apps_radio_call_benchmark_print( "direct", &direct );
+    apps_radio_call_benchmark_print( "apps_radio", &api );
+    apps_radio_call_benchmark_print( "function table", &table );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+/* --- EOF ------------------------------------------------------------------ */
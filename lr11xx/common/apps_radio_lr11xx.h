@@ -0,0 +1,410 @@
+/*!
+ * @file      apps_radio_lr11xx.h
+ *
+ * @brief     LR11xx adapter of the chip-agnostic radio API
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef APPS_RADIO_LR11XX_H
+#define APPS_RADIO_LR11XX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "apps_radio_types.h"
+#include "apps_common.h"
+#include "apps_utilities.h"
+#include "lr11xx_radio.h"
+#include "lr11xx_regmem.h"
+#include "lr11xx_system.h"
+#include "smtc_hal_dbg_trace.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * @brief Function table of the LR11xx adapter
+ */
+extern const apps_radio_ops_t apps_radio_lr11xx_ops;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * @see apps_common_lr11xx_get_context_from_binding
+ */
+void* apps_radio_lr11xx_get_context( uint8_t radio_id, const radio_registry_binding_t* binding );
+
+/*!
+ * @see apps_common_print_sdk_driver_version
+ */
+void apps_radio_lr11xx_print_version( void );
+
+/*!
+ * @brief Initialize the chip, print its version and apply the radio configuration
+ */
+void apps_radio_lr11xx_init( const void* context );
+
+/*!
+ * @brief Initialize the chip, print its version and apply the DBPSK configuration
+ */
+void apps_radio_lr11xx_init_dbpsk( const void* context, uint8_t payload_length );
+
+/*!
+ * @see apps_radio_receive_packet
+ */
+bool apps_radio_lr11xx_receive_packet( const void* context, uint32_t rx_restart_timeout_in_ms,
+                                       apps_radio_rx_packet_t* packet );
+
+/*!
+ * @brief Time apps_common_lr11xx_get_tx_done_delay_in_us called directly, through apps_radio_get_tx_done_delay_in_us
+ * and through apps_radio_lr11xx_ops, then print the results
+ */
+void apps_radio_lr11xx_print_call_benchmark( const void* context );
+
+/*!
+ * @see apps_radio_get_cad_recommended_params
+ */
+void apps_radio_lr11xx_get_cad_recommended_params( apps_radio_lora_sf_t sf, apps_radio_lora_bw_t bw,
+                                                   apps_radio_cad_params_t* params );
+
+/*!
+ * @brief Translate interrupts of the chip-agnostic API into LR11xx IRQ flags
+ */
+static inline lr11xx_system_irq_mask_t apps_radio_lr11xx_irq_to_chip( apps_radio_irq_mask_t irq )
+{
+    lr11xx_system_irq_mask_t chip_irq = LR11XX_SYSTEM_IRQ_NONE;
+
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_TX_DONE ) != 0 ) ? LR11XX_SYSTEM_IRQ_TX_DONE : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_RX_DONE ) != 0 ) ? LR11XX_SYSTEM_IRQ_RX_DONE : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_TIMEOUT ) != 0 ) ? LR11XX_SYSTEM_IRQ_TIMEOUT : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_PREAMBLE_DETECTED ) != 0 ) ? LR11XX_SYSTEM_IRQ_PREAMBLE_DETECTED : 0;
+    chip_irq |=
+        ( ( irq & APPS_RADIO_IRQ_SYNCWORD_HEADER_VALID ) != 0 ) ? LR11XX_SYSTEM_IRQ_SYNC_WORD_HEADER_VALID : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_HEADER_ERROR ) != 0 ) ? LR11XX_SYSTEM_IRQ_HEADER_ERROR : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_CRC_ERROR ) != 0 ) ? LR11XX_SYSTEM_IRQ_CRC_ERROR : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_LENGTH_ERROR ) != 0 )
+                    ? ( LR11XX_SYSTEM_IRQ_FSK_LEN_ERROR | LR11XX_SYSTEM_IRQ_FSK_ADDR_ERROR )
+                    : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_CAD_DONE ) != 0 ) ? LR11XX_SYSTEM_IRQ_CAD_DONE : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_CAD_DETECTED ) != 0 ) ? LR11XX_SYSTEM_IRQ_CAD_DETECTED : 0;
+
+    return chip_irq;
+}
+
+/*!
+ * @brief Translate LR11xx IRQ flags into interrupts of the chip-agnostic API
+ */
+static inline apps_radio_irq_mask_t apps_radio_lr11xx_irq_from_chip( lr11xx_system_irq_mask_t chip_irq )
+{
+    apps_radio_irq_mask_t irq = APPS_RADIO_IRQ_NONE;
+
+    irq |= ( ( chip_irq & LR11XX_SYSTEM_IRQ_TX_DONE ) != 0 ) ? APPS_RADIO_IRQ_TX_DONE : 0;
+    irq |= ( ( chip_irq & LR11XX_SYSTEM_IRQ_RX_DONE ) != 0 ) ? APPS_RADIO_IRQ_RX_DONE : 0;
+    irq |= ( ( chip_irq & LR11XX_SYSTEM_IRQ_TIMEOUT ) != 0 ) ? APPS_RADIO_IRQ_TIMEOUT : 0;
+    irq |= ( ( chip_irq & LR11XX_SYSTEM_IRQ_PREAMBLE_DETECTED ) != 0 ) ? APPS_RADIO_IRQ_PREAMBLE_DETECTED : 0;
+    irq |=
+        ( ( chip_irq & LR11XX_SYSTEM_IRQ_SYNC_WORD_HEADER_VALID ) != 0 ) ? APPS_RADIO_IRQ_SYNCWORD_HEADER_VALID : 0;
+    irq |= ( ( chip_irq & LR11XX_SYSTEM_IRQ_HEADER_ERROR ) != 0 ) ? APPS_RADIO_IRQ_HEADER_ERROR : 0;
+    irq |= ( ( chip_irq & LR11XX_SYSTEM_IRQ_CRC_ERROR ) != 0 ) ? APPS_RADIO_IRQ_CRC_ERROR : 0;
+    irq |= ( ( chip_irq & ( LR11XX_SYSTEM_IRQ_FSK_LEN_ERROR | LR11XX_SYSTEM_IRQ_FSK_ADDR_ERROR ) ) != 0 )
+               ? APPS_RADIO_IRQ_LENGTH_ERROR
+               : 0;
+    irq |= ( ( chip_irq & LR11XX_SYSTEM_IRQ_CAD_DONE ) != 0 ) ? APPS_RADIO_IRQ_CAD_DONE : 0;
+    irq |= ( ( chip_irq & LR11XX_SYSTEM_IRQ_CAD_DETECTED ) != 0 ) ? APPS_RADIO_IRQ_CAD_DETECTED : 0;
+
+    return irq;
+}
+
+/*
+ * The adapters below are bound at compile time by apps_radio.h in single-chip builds: keep them as thin as the driver
+ * calls they wrap
+ */
+
+static inline bool apps_radio_lr11xx_reconfigure( const void* context )
+{
+    const uint8_t changes = apps_common_lr11xx_radio_reconfigure( context );
+
+    return ( changes & APPS_COMMON_LR11XX_RADIO_CFG_CHANGE_LORA_MOD_PARAMS ) != 0;
+}
+
+static inline bool apps_radio_lr11xx_is_lora_pkt_type( void )
+{
+    return PACKET_TYPE == LR11XX_RADIO_PKT_TYPE_LORA;
+}
+
+static inline void apps_radio_lr11xx_set_rf_freq( const void* context, uint32_t freq_in_hz )
+{
+    ASSERT_LR11XX_RC( lr11xx_radio_set_rf_freq( context, freq_in_hz ) );
+}
+
+static inline void apps_radio_lr11xx_set_fs( const void* context )
+{
+    ASSERT_LR11XX_RC( lr11xx_system_set_fs( context ) );
+}
+
+static inline void apps_radio_lr11xx_set_lora_params( const void* context, const apps_radio_lora_params_t* params )
+{
+    const lr11xx_radio_mod_params_lora_t mod_params = {
+        .sf   = ( lr11xx_radio_lora_sf_t ) params->sf,
+        .bw   = ( lr11xx_radio_lora_bw_t ) params->bw,
+        .cr   = ( lr11xx_radio_lora_cr_t ) params->cr,
+        .ldro = ( params->ldro_is_on == true ) ? 1 : 0,
+    };
+    const lr11xx_radio_pkt_params_lora_t pkt_params = {
+        .preamble_len_in_symb = params->preamble_len_in_symb,
+        .header_type          = ( params->header_is_implicit == true ) ? LR11XX_RADIO_LORA_PKT_IMPLICIT
+                                                                       : LR11XX_RADIO_LORA_PKT_EXPLICIT,
+        .pld_len_in_bytes     = params->pld_len_in_bytes,
+        .crc                  = ( params->crc_is_on == true ) ? LR11XX_RADIO_LORA_CRC_ON : LR11XX_RADIO_LORA_CRC_OFF,
+        .iq = ( params->invert_iq_is_on == true ) ? LR11XX_RADIO_LORA_IQ_INVERTED : LR11XX_RADIO_LORA_IQ_STANDARD,
+    };
+
+    ASSERT_LR11XX_RC( lr11xx_radio_set_lora_mod_params( context, &mod_params ) );
+    ASSERT_LR11XX_RC( lr11xx_radio_set_lora_pkt_params( context, &pkt_params ) );
+}
+
+static inline void apps_radio_lr11xx_set_irq_mask( const void* context, apps_radio_irq_mask_t irq_mask )
+{
+    ASSERT_LR11XX_RC( lr11xx_system_set_dio_irq_params( context, apps_radio_lr11xx_irq_to_chip( irq_mask ), 0 ) );
+    ASSERT_LR11XX_RC( lr11xx_system_clear_irq_status( context, LR11XX_SYSTEM_IRQ_ALL_MASK ) );
+}
+
+static inline void apps_radio_lr11xx_write_payload( const void* context, const uint8_t* buffer, uint8_t length )
+{
+    ASSERT_LR11XX_RC( lr11xx_regmem_write_buffer8( context, buffer, length ) );
+}
+
+static inline uint8_t apps_radio_lr11xx_read_payload( const void* context, uint8_t* buffer, uint8_t max_length )
+{
+    lr11xx_radio_rx_buffer_status_t rx_buffer_status;
+
+    ASSERT_LR11XX_RC( lr11xx_radio_get_rx_buffer_status( context, &rx_buffer_status ) );
+    if( rx_buffer_status.pld_len_in_bytes > max_length )
+    {
+        HAL_DBG_TRACE_ERROR( "Received payload (size: %d) is bigger than the buffer (size: %d)!\n",
+                             rx_buffer_status.pld_len_in_bytes, max_length );
+        return 0;
+    }
+
+    ASSERT_LR11XX_RC( lr11xx_regmem_read_buffer8( context, buffer, rx_buffer_status.buffer_start_pointer,
+                                                  rx_buffer_status.pld_len_in_bytes ) );
+    return rx_buffer_status.pld_len_in_bytes;
+}
+
+static inline uint8_t apps_radio_lr11xx_read_payload_head( const void* context, uint8_t* buffer, uint8_t length )
+{
+    lr11xx_radio_rx_buffer_status_t rx_buffer_status;
+
+    ASSERT_LR11XX_RC( lr11xx_radio_get_rx_buffer_status( context, &rx_buffer_status ) );
+    if( rx_buffer_status.pld_len_in_bytes >= length )
+    {
+        ASSERT_LR11XX_RC(
+            lr11xx_regmem_read_buffer8( context, buffer, rx_buffer_status.buffer_start_pointer, length ) );
+    }
+    return rx_buffer_status.pld_len_in_bytes;
+}
+
+static inline bool apps_radio_lr11xx_get_lora_pkt_status( const void*                   context,
+                                                          apps_radio_lora_pkt_status_t* pkt_status )
+{
+    lr11xx_radio_pkt_status_lora_t pkt_status_lora;
+
+    if( PACKET_TYPE != LR11XX_RADIO_PKT_TYPE_LORA )
+    {
+        return false;
+    }
+
+    ASSERT_LR11XX_RC( lr11xx_radio_get_lora_pkt_status( context, &pkt_status_lora ) );
+    pkt_status->rssi_pkt_in_dbm        = pkt_status_lora.rssi_pkt_in_dbm;
+    pkt_status->snr_pkt_in_db          = pkt_status_lora.snr_pkt_in_db;
+    pkt_status->signal_rssi_pkt_in_dbm = pkt_status_lora.signal_rssi_pkt_in_dbm;
+    return true;
+}
+
+static inline bool apps_radio_lr11xx_get_gfsk_pkt_status( const void*                   context,
+                                                          apps_radio_gfsk_pkt_status_t* pkt_status )
+{
+    lr11xx_radio_pkt_status_gfsk_t pkt_status_gfsk;
+
+    if( PACKET_TYPE != LR11XX_RADIO_PKT_TYPE_GFSK )
+    {
+        return false;
+    }
+
+    ASSERT_LR11XX_RC( lr11xx_radio_get_gfsk_pkt_status( context, &pkt_status_gfsk ) );
+    pkt_status->rssi_sync_in_dbm = pkt_status_gfsk.rssi_sync_in_dbm;
+    pkt_status->rssi_avg_in_dbm  = pkt_status_gfsk.rssi_avg_in_dbm;
+    return true;
+}
+
+static inline void apps_radio_lr11xx_set_tx( const void* context, uint32_t timeout_in_ms )
+{
+    apps_common_lr11xx_handle_pre_tx( );
+    ASSERT_LR11XX_RC( lr11xx_radio_set_tx( context, timeout_in_ms ) );
+}
+
+static inline void apps_radio_lr11xx_set_standby( const void* context, apps_radio_standby_cfg_t cfg )
+{
+    ASSERT_LR11XX_RC( lr11xx_system_set_standby( context, ( lr11xx_system_standby_cfg_t ) cfg ) );
+    apps_common_lr11xx_handle_post_tx( );
+    apps_common_lr11xx_handle_post_rx( );
+}
+
+static inline void apps_radio_lr11xx_set_tx_cw( const void* context )
+{
+    apps_common_lr11xx_handle_pre_tx( );
+    ASSERT_LR11XX_RC( lr11xx_radio_set_tx_cw( context ) );
+}
+
+static inline void apps_radio_lr11xx_set_tx_infinite_preamble( const void* context )
+{
+    apps_common_lr11xx_handle_pre_tx( );
+    ASSERT_LR11XX_RC( lr11xx_radio_set_tx_infinite_preamble( context ) );
+}
+
+static inline void apps_radio_lr11xx_set_rx( const void* context, uint32_t timeout_in_ms )
+{
+    apps_common_lr11xx_handle_pre_rx( );
+    ASSERT_LR11XX_RC( lr11xx_radio_set_rx( context, timeout_in_ms ) );
+}
+
+static inline void apps_radio_lr11xx_set_rx_continuous( const void* context )
+{
+    apps_common_lr11xx_handle_pre_rx( );
+    ASSERT_LR11XX_RC( lr11xx_radio_set_rx_with_timeout_in_rtc_step( context, RX_CONTINUOUS ) );
+}
+
+static inline int16_t apps_radio_lr11xx_get_rssi_inst( const void* context )
+{
+    int8_t rssi_in_dbm = 0;
+
+    ASSERT_LR11XX_RC( lr11xx_radio_get_rssi_inst( context, &rssi_in_dbm ) );
+    return rssi_in_dbm;
+}
+
+static inline void apps_radio_lr11xx_start_cad( const void* context, const apps_radio_cad_params_t* params )
+{
+    const lr11xx_radio_cad_params_t cad_params = {
+        .cad_symb_nb     = params->nb_symbols,
+        .cad_detect_peak = params->detect_peak,
+        .cad_detect_min  = params->detect_min,
+        .cad_exit_mode   = ( lr11xx_radio_cad_exit_mode_t ) params->exit_mode,
+        .cad_timeout     = lr11xx_radio_convert_time_in_ms_to_rtc_step( params->timeout_in_ms ),
+    };
+
+    ASSERT_LR11XX_RC( lr11xx_radio_set_cad_params( context, &cad_params ) );
+    ASSERT_LR11XX_RC( lr11xx_radio_set_cad( context ) );
+}
+
+static inline void apps_radio_lr11xx_restart_cad( const void* context )
+{
+    ASSERT_LR11XX_RC( lr11xx_radio_set_cad( context ) );
+}
+
+static inline apps_radio_irq_mask_t apps_radio_lr11xx_get_and_clear_irq_status( const void* context )
+{
+    lr11xx_system_irq_mask_t chip_irq = LR11XX_SYSTEM_IRQ_NONE;
+
+    ASSERT_LR11XX_RC( lr11xx_system_get_and_clear_irq_status( context, &chip_irq ) );
+
+    if( ( chip_irq & LR11XX_SYSTEM_IRQ_TX_DONE ) != 0 )
+    {
+        apps_common_lr11xx_handle_post_tx( );
+    }
+    if( ( chip_irq & ( LR11XX_SYSTEM_IRQ_RX_DONE | LR11XX_SYSTEM_IRQ_TIMEOUT ) ) != 0 )
+    {
+        apps_common_lr11xx_handle_post_rx( );
+    }
+
+    return apps_radio_lr11xx_irq_from_chip( chip_irq );
+}
+
+static inline uint32_t apps_radio_lr11xx_get_rx_done_delay_in_us( const void* context )
+{
+    ( void ) context;
+    return apps_common_lr11xx_get_rx_done_delay_in_us( );
+}
+
+static inline uint32_t apps_radio_lr11xx_get_tx_done_delay_in_us( const void* context )
+{
+    ( void ) context;
+    return apps_common_lr11xx_get_tx_done_delay_in_us( );
+}
+
+static inline bool apps_radio_lr11xx_is_timing_model_characterised( void )
+{
+    return true;
+}
+
+static inline void apps_radio_lr11xx_wait_for_event( void )
+{
+    apps_common_lr11xx_wait_for_event( );
+}
+
+static inline void apps_radio_lr11xx_print_gpio_benchmark( const void* context )
+{
+    apps_common_lr11xx_print_gpio_benchmark( context );
+}
+
+static inline void apps_radio_lr11xx_print_irq_stats( const void* context )
+{
+    apps_common_lr11xx_irq_print_stats( context );
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // APPS_RADIO_LR11XX_H
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,46 @@
+#include "atc.h"
+#include "lr11xx_radio_types.h"
+//global macros initial: LR11xx defaults
+int ATC_M_TX_OUTPUT_POWER_DBM = 22;   // range [-17, +22] for sub-G, range [-18, 13] for 2.4G ( HF_PA )
+
+uint32_t ATC_M_RF_FREQ_IN_HZ = 868000000;
+
+int ATC_M_LORA_SF = LR11XX_RADIO_LORA_SF7;
+
+int ATC_M_LORA_BW = LR11XX_RADIO_LORA_BW_125;
+
+int ATC_M_LORA_CR = LR11XX_RADIO_LORA_CR_4_5;
+
+int ATC_M_LORA_RX_BOOST =1;
+
+static const ATC_ParamMapTypeDef ATC_Lr11xxLoraSfMap[] = {
+    {5, LR11XX_RADIO_LORA_SF5},   {6, LR11XX_RADIO_LORA_SF6},   {7, LR11XX_RADIO_LORA_SF7},
+    {8, LR11XX_RADIO_LORA_SF8},   {9, LR11XX_RADIO_LORA_SF9},   {10, LR11XX_RADIO_LORA_SF10},
+    {11, LR11XX_RADIO_LORA_SF11}, {12, LR11XX_RADIO_LORA_SF12},
+};
+
+// 200, 400 and 800 kHz are 2G4 bandwidths, compatible with LR112x chips only
+static const ATC_ParamMapTypeDef ATC_Lr11xxLoraBwMap[] = {
+    {10, LR11XX_RADIO_LORA_BW_10},   {15, LR11XX_RADIO_LORA_BW_15},   {20, LR11XX_RADIO_LORA_BW_20},
+    {31, LR11XX_RADIO_LORA_BW_31},   {41, LR11XX_RADIO_LORA_BW_41},   {62, LR11XX_RADIO_LORA_BW_62},
+    {125, LR11XX_RADIO_LORA_BW_125}, {250, LR11XX_RADIO_LORA_BW_250}, {500, LR11XX_RADIO_LORA_BW_500},
+    {200, LR11XX_RADIO_LORA_BW_200}, {400, LR11XX_RADIO_LORA_BW_400}, {800, LR11XX_RADIO_LORA_BW_800},
+};
+
+// 0: no coding rate, 1-4: 4/5 to 4/8, 5-7: long interleaver 4/5, 4/6, 4/8
+static const ATC_ParamMapTypeDef ATC_Lr11xxLoraCrMap[] = {
+    {0, LR11XX_RADIO_LORA_NO_CR},     {1, LR11XX_RADIO_LORA_CR_4_5},    {2, LR11XX_RADIO_LORA_CR_4_6},
+    {3, LR11XX_RADIO_LORA_CR_4_7},    {4, LR11XX_RADIO_LORA_CR_4_8},    {5, LR11XX_RADIO_LORA_CR_LI_4_5},
+    {6, LR11XX_RADIO_LORA_CR_LI_4_6}, {7, LR11XX_RADIO_LORA_CR_LI_4_8},
+};
+
+const ATC_BindingTypeDef ATC_Binding = {
+    .pFamily = "LR11xx",
+    .pLoraSf = ATC_Lr11xxLoraSfMap,
+    .LoraSfCount = ATC_MAP_SIZE(ATC_Lr11xxLoraSfMap),
+    .pLoraBw = ATC_Lr11xxLoraBwMap,
+    .LoraBwCount = ATC_MAP_SIZE(ATC_Lr11xxLoraBwMap),
+    .pLoraCr = ATC_Lr11xxLoraCrMap,
+    .LoraCrCount = ATC_MAP_SIZE(ATC_Lr11xxLoraCrMap),
+    .Features = ATC_FEATURE_PER_SWEEP | ATC_FEATURE_PER_FAST,
+};
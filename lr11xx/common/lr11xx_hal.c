@@ -43,7 +43,7 @@
 
 #include "lr11xx_hal.h"
 #include "smtc_hal_mcu_spi.h"
-#include "smtc_hal_mcu_gpio.h"
+#include "smtc_hal_mcu_gpio_stm32l4.h"
 
 #include "lr11xx_hal_context.h"
 
@@ -86,9 +86,9 @@ lr11xx_hal_status_t lr11xx_hal_reset( const void* context )
 {
     const lr11xx_hal_context_t* lr11xx_context = ( const lr11xx_hal_context_t* ) context;
 
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->reset.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_low( &( lr11xx_context->reset.fast ) );
     LL_mDelay( 1 );
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->reset.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_high( &( lr11xx_context->reset.fast ) );
 
     return LR11XX_HAL_STATUS_OK;
 }
@@ -97,9 +97,9 @@ lr11xx_hal_status_t lr11xx_hal_wakeup( const void* context )
 {
     const lr11xx_hal_context_t* lr11xx_context = ( const lr11xx_hal_context_t* ) context;
 
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_low( &( lr11xx_context->nss.fast ) );
     LL_mDelay( 1 );
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_high( &( lr11xx_context->nss.fast ) );
 
     return LR11XX_HAL_STATUS_OK;
 }
@@ -109,9 +109,9 @@ lr11xx_hal_status_t lr11xx_hal_abort_blocking_cmd( const void* context )
     const lr11xx_hal_context_t* lr11xx_context = ( const lr11xx_hal_context_t* ) context;
     uint8_t                     command[4]     = { 0 };
 
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_low( &( lr11xx_context->nss.fast ) );
     smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, command, NULL, 4 );
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_high( &( lr11xx_context->nss.fast ) );
 
     lr11xx_hal_wait_on_busy( lr11xx_context );
 
@@ -131,13 +131,13 @@ lr11xx_hal_status_t lr11xx_hal_write( const void* context, const uint8_t* comman
 
     lr11xx_hal_wait_on_busy( lr11xx_context );
 
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_low( &( lr11xx_context->nss.fast ) );
     smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, command, NULL, command_length );
     smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, data, NULL, data_length );
 #if defined( USE_LR11XX_CRC_OVER_SPI )
     smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, &cmd_crc, NULL, 1 );
 #endif
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_high( &( lr11xx_context->nss.fast ) );
 
     return LR11XX_HAL_STATUS_OK;
 }
@@ -155,23 +155,23 @@ lr11xx_hal_status_t lr11xx_hal_read( const void* context, const uint8_t* command
 
     lr11xx_hal_wait_on_busy( lr11xx_context );
 
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_low( &( lr11xx_context->nss.fast ) );
     smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, command, NULL, command_length );
 #if defined( USE_LR11XX_CRC_OVER_SPI )
     smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, &cmd_crc, NULL, 1 );
 #endif
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_high( &( lr11xx_context->nss.fast ) );
 
     lr11xx_hal_wait_on_busy( lr11xx_context );
 
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_low( &( lr11xx_context->nss.fast ) );
     smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, &dummy_byte, &dummy_byte_rx, 1 );
     smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, NULL, data, data_length );
 #if defined( USE_LR11XX_CRC_OVER_SPI )
     uint8_t crc_rx;
     smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, &dummy_byte, &crc_rx, 1 );
 #endif
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_high( &( lr11xx_context->nss.fast ) );
 
 #if defined( USE_LR11XX_CRC_OVER_SPI )
     uint8_t crc_computed = lr11xx_hal_compute_crc( 0xFF, &dummy, 1 );
@@ -191,13 +191,13 @@ lr11xx_hal_status_t lr11xx_hal_direct_read( const void* radio, uint8_t* data, co
 
     lr11xx_hal_wait_on_busy( lr11xx_context );
 
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_low( &( lr11xx_context->nss.fast ) );
     smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, NULL, data, data_length );
 #if defined( USE_LR11XX_CRC_OVER_SPI )
     uint8_t crc_rx;
     smtc_hal_mcu_spi_rw_buffer( lr11xx_context->spi.inst, NULL, &crc_rx, 1 );
 #endif
-    smtc_hal_mcu_gpio_set_state( lr11xx_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_high( &( lr11xx_context->nss.fast ) );
 
 #if defined( USE_LR11XX_CRC_OVER_SPI )
     // check crc value
@@ -219,12 +219,10 @@ lr11xx_hal_status_t lr11xx_hal_direct_read( const void* radio, uint8_t* data, co
 void lr11xx_hal_wait_on_busy( const void* radio )
 {
     const lr11xx_hal_context_t* lr11xx_context = ( const lr11xx_hal_context_t* ) radio;
-    smtc_hal_mcu_gpio_state_t   gpio_state;
 
-    do
+    while( smtc_hal_mcu_gpio_stm32l4_fast_is_high( &( lr11xx_context->busy.fast ) ) )
     {
-        smtc_hal_mcu_gpio_get_state( lr11xx_context->busy.inst, &gpio_state );
-    } while( gpio_state == SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    }
 }
 
 /* --- EOF ------------------------------------------------------------------ */
@@ -75,15 +75,17 @@ typedef struct
     } spi;
     struct
     {
-        smtc_hal_mcu_gpio_cfg_t        cfg;
-        smtc_hal_mcu_gpio_output_cfg_t cfg_output;
-        smtc_hal_mcu_gpio_inst_t       inst;
+        smtc_hal_mcu_gpio_cfg_t          cfg;
+        smtc_hal_mcu_gpio_output_cfg_t   cfg_output;
+        smtc_hal_mcu_gpio_inst_t         inst;
+        smtc_hal_mcu_gpio_stm32l4_fast_t fast;  //!< Resolved once at init, toggled around every transaction
     } nss;
     struct
     {
-        smtc_hal_mcu_gpio_cfg_t        cfg;
-        smtc_hal_mcu_gpio_output_cfg_t cfg_output;
-        smtc_hal_mcu_gpio_inst_t       inst;
+        smtc_hal_mcu_gpio_cfg_t          cfg;
+        smtc_hal_mcu_gpio_output_cfg_t   cfg_output;
+        smtc_hal_mcu_gpio_inst_t         inst;
+        smtc_hal_mcu_gpio_stm32l4_fast_t fast;  //!< Resolved once at init
     } reset;
     struct
     {
@@ -93,9 +95,10 @@ typedef struct
     } irq;
     struct
     {
-        smtc_hal_mcu_gpio_cfg_t       cfg;
-        smtc_hal_mcu_gpio_input_cfg_t cfg_input;
-        smtc_hal_mcu_gpio_inst_t      inst;
+        smtc_hal_mcu_gpio_cfg_t          cfg;
+        smtc_hal_mcu_gpio_input_cfg_t    cfg_input;
+        smtc_hal_mcu_gpio_inst_t         inst;
+        smtc_hal_mcu_gpio_stm32l4_fast_t fast;  //!< Resolved once at init, polled while waiting on BUSY
     } busy;
 } lr11xx_hal_context_t;
 
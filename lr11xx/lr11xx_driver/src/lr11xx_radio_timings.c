@@ -227,7 +227,7 @@ static uint32_t lr11xx_radio_timings_get_lora_rx_input_delay_in_us( lr11xx_radio
 static uint32_t lr11xx_radio_timings_get_lora_symb_time_in_us( const lr11xx_radio_lora_sf_t sf,
                                                                const lr11xx_radio_lora_bw_t bw )
 {
-    return ( 1 << ( uint8_t ) sf ) * 1000000 / lr11xx_radio_get_lora_bw_in_hz( bw );
+    return ( ( uint32_t ) 1 << ( uint8_t ) sf ) * 1000000UL / lr11xx_radio_get_lora_bw_in_hz( bw );
 }
 
 /* --- EOF ------------------------------------------------------------------ */
@@ -40,7 +40,6 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <time.h>
 
 #include "apps_common.h"
 #include "apps_utilities.h"
@@ -49,6 +48,7 @@
 #include "smtc_hal_mcu.h"
 #include "smtc_hal_dbg_trace.h"
 #include "uart_init.h"
+#include "apps_entropy.h"
 #include "main_tx_lr_fhss.h"
 #include "sx126x_lr_fhss.h"
 #include "lr_fhss_mac.h"
@@ -82,6 +82,8 @@ static sx126x_hal_context_t* context;
 
 static uint8_t buffer[PAYLOAD_LENGTH];
 
+static smtc_hal_mcu_timer_soft_t tx_timer;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -97,6 +99,13 @@ static uint8_t buffer[PAYLOAD_LENGTH];
  */
 static void build_frame_and_send( const sx126x_lr_fhss_params_t* params, uint8_t* payload, uint16_t length );
 
+/**
+ * @brief Send the next frame once the delay following a transmission has elapsed
+ *
+ * @param [in] timer_context Unused
+ */
+static void on_tx_delay_elapsed( void* timer_context );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -111,7 +120,6 @@ int main( void )
     smtc_hal_mcu_init( );
     uart_init( );
     apps_common_shield_init( );
-    srand( time( NULL ) );
 
     HAL_DBG_TRACE_INFO( "===== SX126x TX LR-FHSS example =====\n\n" );
     apps_common_sx126x_print_version_info( );
@@ -124,6 +132,8 @@ int main( void )
     sx126x_set_dio_irq_params( context, SX126X_IRQ_ALL, SX126X_IRQ_TX_DONE, SX126X_IRQ_NONE, SX126X_IRQ_NONE );
 
     sx126x_clear_irq_status( context, SX126X_IRQ_ALL );
+
+    smtc_hal_mcu_timer_soft_init( &tx_timer, on_tx_delay_elapsed, NULL );
     for( int i = 0; i < PAYLOAD_LENGTH; i++ )
     {
         buffer[i] = i;
@@ -145,6 +155,7 @@ int main( void )
     while( 1 )
     {
         apps_common_sx126x_irq_process( context );
+        apps_common_sx126x_wait_for_event( );
     }
 }
 
@@ -152,8 +163,11 @@ void on_tx_done( void )
 {
     apps_common_sx126x_handle_post_tx( );
 
-    LL_mDelay( TX_TO_TX_DELAY_IN_MS );
+    smtc_hal_mcu_timer_soft_start( &tx_timer, TX_TO_TX_DELAY_IN_MS * 1000, 0 );
+}
 
+static void on_tx_delay_elapsed( void* timer_context )
+{
     build_frame_and_send( &lr_fhss_params, buffer, PAYLOAD_LENGTH );
 }
 
@@ -166,7 +180,8 @@ void build_frame_and_send( const sx126x_lr_fhss_params_t* params, uint8_t* paylo
 {
     sx126x_lr_fhss_init( context, &lr_fhss_params );
 
-    const uint16_t hop_sequence_id = ( uint16_t ) rand( ) % sx126x_lr_fhss_get_hop_sequence_count( &lr_fhss_params );
+    const uint16_t hop_sequence_id =
+        ( uint16_t ) apps_entropy_get_range( sx126x_lr_fhss_get_hop_sequence_count( &lr_fhss_params ) );
 
     sx126x_lr_fhss_build_frame( ( void* ) context, &lr_fhss_params, &lr_fhss_state, hop_sequence_id, payload,
                                 PAYLOAD_LENGTH, 0 );
@@ -74,6 +74,37 @@ extern "C" {
 #define NB_FRAME 20
 #endif
 
+/*!
+ *  @brief Delay in ms the transmitter waits at the beginning of each sweep point to let the receiver retune
+ */
+#ifndef SWEEP_POINT_GUARD_IN_MS
+#define SWEEP_POINT_GUARD_IN_MS 100
+#endif
+
+/*!
+ *  @brief Time in ms the receiver waits for the transmitter to start the sweep, on top of the first point duration
+ */
+#ifndef SWEEP_START_TIMEOUT_IN_MS
+#define SWEEP_START_TIMEOUT_IN_MS 30000
+#endif
+
+/*!
+ *  @brief Margin in ms added to the frame period when the receiver tracks the end of a sweep point
+ */
+#ifndef SWEEP_FRAME_MARGIN_IN_MS
+#define SWEEP_FRAME_MARGIN_IN_MS 20
+#endif
+
+/*!
+ *  @brief Read received frames into the RX packet pool and check them from the main loop (1), or read and check them
+ *  in the RX done handler (0)
+ *
+ *  The RX_DONE to payload latency of the path in use is printed at the end of the test
+ */
+#ifndef PER_FUSED_RX_READ
+#define PER_FUSED_RX_READ 0
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC CONSTANTS --------------------------------------------------------
@@ -71,10 +71,50 @@ extern "C" {
 #endif
 
 /*!
- * @brief number of seconds between 2 scans in the thread
+ * @brief number of milliseconds between 2 sweeps of all the channels, 0 to sweep back to back
  */
-#ifndef PACE_S
-#define PACE_S 1
+#ifndef SWEEP_PACE_MS
+#define SWEEP_PACE_MS 0
+#endif
+
+/*!
+ * @brief time between 2 instant RSSI samples, in microseconds (rounded up to the 16 us software timer tick)
+ */
+#ifndef SAMPLE_PERIOD_US
+#define SAMPLE_PERIOD_US 64
+#endif
+
+/*!
+ * @brief time between the switch to a channel and its first instant RSSI sample, in microseconds
+ *
+ * The radio only goes through frequency synthesis between channels: this covers the PLL lock and the RSSI filter.
+ */
+#ifndef SETTLE_TIME_US
+#define SETTLE_TIME_US 200
+#endif
+
+/*!
+ * @brief Stream the histograms as binary frames (true) or print them as text (false)
+ */
+#ifndef BINARY_OUTPUT
+#define BINARY_OUTPUT true
+#endif
+
+/*!
+ * @brief Seconds of sweeps accumulated in each record of the occupancy log kept in flash, 0 to disable the recorder
+ *
+ * The flash area holds about 9 days of 30-channel records every 900 s on the synthetic survey of
+ * libs/smtc_occupancy_log/host, the oldest records being overwritten.
+ */
+#ifndef RECORD_PERIOD_S
+#define RECORD_PERIOD_S 900
+#endif
+
+/*!
+ * @brief Full scale of the histogram levels stored by the recorder: a lower value makes the records smaller
+ */
+#ifndef RECORD_LEVEL_MAX
+#define RECORD_LEVEL_MAX 63
 #endif
 
 /*!
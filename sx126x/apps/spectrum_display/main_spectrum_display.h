@@ -64,10 +64,21 @@ extern "C" {
 #endif
 
 /*!
- * @brief number of seconds between 2 scans in the thread
+ * @brief number of milliseconds between 2 scans in the thread
+ *
+ * @remark Only the characters which changed are sent to the terminal, so the display keeps up with a short pace: see
+ * the UART cost reported below the plot
+ */
+#ifndef PACE_MS
+#define PACE_MS 100
+#endif
+
+/*!
+ * @brief display mode: CURVE_PLOT_MODE_CURVE (RSSI curve of the last scan) or CURVE_PLOT_MODE_WATERFALL (one shaded
+ * line per scan)
  */
-#ifndef PACE_S
-#define PACE_S 1
+#ifndef DISPLAY_MODE
+#define DISPLAY_MODE CURVE_PLOT_MODE_CURVE
 #endif
 
 /*!
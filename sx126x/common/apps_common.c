@@ -44,6 +44,7 @@
 #include "apps_common.h"
 #include "common_version.h"
 #include "apps_utilities.h"
+#include "sx126x_radio_timings.h"
 #include "sx126x_str.h"
 #include "smtc_hal_dbg_trace.h"
 #include "smtc_shield_pinout_mapping.h"
@@ -60,12 +61,31 @@
 #include "smtc_shield_sx1268mb1gas.h"
 
 #include "smtc_dbpsk.h"
+#include "atc.h"
+#include "uart_init.h"
+#include "smtc_hal_mcu_lpm.h"
+#include "apps_kv_store.h"
+#include "radio_registry.h"
+#include "apps_entropy.h"
 
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE MACROS-----------------------------------------------------------
  */
 
+#define IRQ_HANDLERS_COUNT ( sizeof( irq_handlers ) / sizeof( irq_handlers[0] ) )
+
+/*!
+ * @brief Number of iterations averaged by the GPIO benchmark
+ */
+#define GPIO_BENCHMARK_NB_ITERATIONS 1000
+
+/*!
+ * @brief Software flags appended to the IRQ mask when the GFSK packet status of a Rx done reports an error
+ */
+#define IRQ_GFSK_STATUS_CRC_ERROR ( 1UL << 16 )
+#define IRQ_GFSK_STATUS_PKT_ERROR ( 1UL << 17 )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE CONSTANTS -------------------------------------------------------
@@ -149,14 +169,49 @@ static sx126x_pkt_params_bpsk_t bpsk_pkt_params = {
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
+/*!
+ * @brief Trace level used to report a dispatched interrupt
+ */
+typedef enum irq_trace_level_e
+{
+    IRQ_TRACE_LEVEL_INFO,
+    IRQ_TRACE_LEVEL_WARNING,
+    IRQ_TRACE_LEVEL_ERROR,
+} irq_trace_level_t;
+
+/*!
+ * @brief Entry of the interrupt dispatch table
+ *
+ * The callback is called when all the bits of required_mask and none of the bits of rejected_mask are raised.
+ */
+typedef struct irq_handler_s
+{
+    uint32_t required_mask;
+    uint32_t rejected_mask;
+    void ( *callback )( void );
+    const char*       name;
+    irq_trace_level_t trace_level;
+} irq_handler_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-static sx126x_hal_context_t context;
+/*!
+ * @brief HAL contexts of the radios, indexed as in the radio registry
+ */
+static sx126x_hal_context_t contexts[RADIO_REGISTRY_MAX_RADIOS];
 
-static volatile bool irq_fired = false;
+/*!
+ * @brief Context of the radio whose interrupts are being dispatched by apps_common_sx126x_irq_process
+ */
+static const void* irq_context = NULL;
+
+/*!
+ * @brief DIO edge of the event being dispatched, in the timebase of smtc_hal_mcu_timer_get_time_in_us
+ */
+static uint32_t irq_timestamp_in_us = 0;
 
 static const smtc_shield_sx126x_pinout_t* shield_pinout = 0;
 
@@ -185,6 +240,20 @@ struct
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
  */
+
+/*!
+ * @brief Get the PA and output power configuration matching the ATC_M_* parameters
+ *
+ * The shield PA table entry for ATC_M_RF_FREQ_IN_HZ / ATC_M_TX_OUTPUT_POWER_DBM is overridden by the ATC_M_PA_*
+ * parameters which are not left to their default value (1000): AT+PA_SEL sets device_sel, AT+HP_PA_SEL sets hp_max,
+ * AT+PA_DUTY_CYCLE sets pa_duty_cycle and AT+PA_REAL_POWER sets the power. AT+PA_RGE_SUPPLY has no SX126x equivalent.
+ *
+ * @param [out] pa_pwr_cfg  PA and output power configuration
+ *
+ * @returns false if the shield does not support the requested frequency / power pair, true otherwise
+ */
+static bool apps_common_sx126x_get_atc_pa_pwr_cfg( smtc_shield_sx126x_pa_pwr_cfg_t* pa_pwr_cfg );
+
 void radio_on_dio_irq( void* context );
 void on_tx_done( void ) __attribute__( ( weak ) );
 void on_rx_done( void ) __attribute__( ( weak ) );
@@ -199,6 +268,62 @@ void on_cad_done_undetected( void ) __attribute__( ( weak ) );
 void on_cad_done_detected( void ) __attribute__( ( weak ) );
 void on_fhss_hop_done( void ) __attribute__( ( weak ) );
 
+/*!
+ * @brief Check if a dispatch table entry matches the raised interrupts
+ *
+ * @param [in] handler  Dispatch table entry
+ * @param [in] irq_regs  Raised interrupts, including the IRQ_GFSK_STATUS_* flags
+ *
+ * @returns true if the entry callback has to be called
+ */
+static bool irq_handler_matches( const irq_handler_t* handler, uint32_t irq_regs );
+
+/*!
+ * @brief Print the name of a dispatched interrupt
+ *
+ * @param [in] handler  Dispatch table entry
+ */
+static void irq_handler_trace( const irq_handler_t* handler );
+
+/*!
+ * @brief Interrupt handler registered to the radio registry
+ *
+ * @param [in] context  Pointer to the radio context
+ * @param [in] irq_filter_mask  Mask of IRQ to process
+ */
+static void apps_common_sx126x_irq_handler( void* context, uint32_t irq_filter_mask );
+
+/*!
+ * @brief Check if a DIO event or an AT command is waiting to be processed
+ *
+ * @returns true if an event is pending
+ */
+static bool apps_common_sx126x_is_event_pending( void );
+
+/*!
+ * @brief Interrupt dispatch table, in processing order
+ *
+ * A GFSK packet received with a CRC error is only reported through on_crc_error.
+ */
+static const irq_handler_t irq_handlers[] = {
+    { SX126X_IRQ_TX_DONE, 0, on_tx_done, "Tx done", IRQ_TRACE_LEVEL_INFO },
+    { SX126X_IRQ_RX_DONE | IRQ_GFSK_STATUS_PKT_ERROR, 0, on_rx_error, "Address or length error from packet status",
+      IRQ_TRACE_LEVEL_ERROR },
+    { SX126X_IRQ_RX_DONE, IRQ_GFSK_STATUS_CRC_ERROR | IRQ_GFSK_STATUS_PKT_ERROR, on_rx_done, "Rx done",
+      IRQ_TRACE_LEVEL_INFO },
+    { SX126X_IRQ_PREAMBLE_DETECTED, 0, on_preamble_detected, "Preamble detected", IRQ_TRACE_LEVEL_INFO },
+    { SX126X_IRQ_SYNC_WORD_VALID, 0, on_syncword_valid, "Syncword valid", IRQ_TRACE_LEVEL_INFO },
+    { SX126X_IRQ_HEADER_VALID, 0, on_header_valid, "Header valid", IRQ_TRACE_LEVEL_INFO },
+    { SX126X_IRQ_HEADER_ERROR, 0, on_header_error, "Header error", IRQ_TRACE_LEVEL_ERROR },
+    { SX126X_IRQ_CRC_ERROR, 0, on_crc_error, "CRC error", IRQ_TRACE_LEVEL_ERROR },
+    { SX126X_IRQ_CAD_DONE | SX126X_IRQ_CAD_DETECTED, 0, on_cad_done_detected, "CAD done - channel activity detected",
+      IRQ_TRACE_LEVEL_INFO },
+    { SX126X_IRQ_CAD_DONE, SX126X_IRQ_CAD_DETECTED, on_cad_done_undetected, "CAD done - no channel activity detected",
+      IRQ_TRACE_LEVEL_INFO },
+    { SX126X_IRQ_TIMEOUT, 0, on_rx_timeout, "Rx timeout", IRQ_TRACE_LEVEL_WARNING },
+    { SX126X_IRQ_LR_FHSS_HOP, 0, on_fhss_hop_done, "FHSS hop done", IRQ_TRACE_LEVEL_INFO },
+};
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC VARIABLES --------------------------------------------------------
@@ -211,41 +336,64 @@ void on_fhss_hop_done( void ) __attribute__( ( weak ) );
 
 sx126x_hal_context_t* apps_common_sx126x_get_context( )
 {
-    context.busy.cfg                 = smtc_shield_pinout_mapping_get_gpio_cfg( SMTC_SHIELD_PINOUT_D3 );
-    context.busy.cfg_input.pull_mode = SMTC_HAL_MCU_GPIO_PULL_MODE_NONE;
-    context.busy.cfg_input.irq_mode  = SMTC_HAL_MCU_GPIO_IRQ_MODE_OFF;
-    context.busy.cfg_input.callback  = NULL;
+    const radio_registry_binding_t binding = RADIO_REGISTRY_BINDING_ARDUINO;
+
+    return apps_common_sx126x_get_context_from_binding( 0, &binding );
+}
+
+sx126x_hal_context_t* apps_common_sx126x_get_context_from_binding( uint8_t                         radio_id,
+                                                                   const radio_registry_binding_t* binding )
+{
+    if( radio_id >= RADIO_REGISTRY_MAX_RADIOS )
+    {
+        return NULL;
+    }
 
-    context.irq.cfg                 = smtc_shield_pinout_mapping_get_gpio_cfg( SMTC_SHIELD_PINOUT_D5 );
-    context.irq.cfg_input.pull_mode = SMTC_HAL_MCU_GPIO_PULL_MODE_NONE;
-    context.irq.cfg_input.irq_mode  = SMTC_HAL_MCU_GPIO_IRQ_MODE_RISING;
-    context.irq.cfg_input.callback  = radio_on_dio_irq;
-    context.irq.cfg_input.context   = NULL;
+    sx126x_hal_context_t* context   = &contexts[radio_id];
+    radio_irq_queue_t*    irq_queue = radio_registry_add( radio_id, context, apps_common_sx126x_irq_handler );
 
-    context.nss.cfg                      = smtc_shield_pinout_mapping_get_gpio_cfg( SMTC_SHIELD_PINOUT_D7 );
-    context.nss.cfg_output.initial_state = SMTC_HAL_MCU_GPIO_STATE_HIGH;
-    context.nss.cfg_output.mode          = SMTC_HAL_MCU_GPIO_OUTPUT_MODE_PUSH_PULL;
+    context->busy.cfg                 = smtc_shield_pinout_mapping_get_gpio_cfg( binding->busy );
+    context->busy.cfg_input.pull_mode = SMTC_HAL_MCU_GPIO_PULL_MODE_NONE;
+    context->busy.cfg_input.irq_mode  = SMTC_HAL_MCU_GPIO_IRQ_MODE_OFF;
+    context->busy.cfg_input.callback  = NULL;
 
-    context.reset.cfg                      = smtc_shield_pinout_mapping_get_gpio_cfg( SMTC_SHIELD_PINOUT_A0 );
-    context.reset.cfg_output.initial_state = SMTC_HAL_MCU_GPIO_STATE_HIGH;
-    context.reset.cfg_output.mode          = SMTC_HAL_MCU_GPIO_OUTPUT_MODE_PUSH_PULL;
+    context->irq.cfg                 = smtc_shield_pinout_mapping_get_gpio_cfg( binding->irq );
+    context->irq.cfg_input.pull_mode = SMTC_HAL_MCU_GPIO_PULL_MODE_NONE;
+    context->irq.cfg_input.irq_mode  = SMTC_HAL_MCU_GPIO_IRQ_MODE_RISING;
+    context->irq.cfg_input.callback  = radio_on_dio_irq;
+    context->irq.cfg_input.context   = irq_queue;
 
-    context.spi.cfg.spi = SPI1;
+    context->nss.cfg                      = smtc_shield_pinout_mapping_get_gpio_cfg( binding->nss );
+    context->nss.cfg_output.initial_state = SMTC_HAL_MCU_GPIO_STATE_HIGH;
+    context->nss.cfg_output.mode          = SMTC_HAL_MCU_GPIO_OUTPUT_MODE_PUSH_PULL;
 
-    smtc_hal_mcu_gpio_init_input( context.busy.cfg, &( context.busy.cfg_input ), &( context.busy.inst ) );
-    smtc_hal_mcu_gpio_init_input( context.irq.cfg, &( context.irq.cfg_input ), &( context.irq.inst ) );
-    smtc_hal_mcu_gpio_init_output( context.nss.cfg, &( context.nss.cfg_output ), &( context.nss.inst ) );
-    smtc_hal_mcu_gpio_init_output( context.reset.cfg, &( context.reset.cfg_output ), &( context.reset.inst ) );
+    context->reset.cfg                      = smtc_shield_pinout_mapping_get_gpio_cfg( binding->reset );
+    context->reset.cfg_output.initial_state = SMTC_HAL_MCU_GPIO_STATE_HIGH;
+    context->reset.cfg_output.mode          = SMTC_HAL_MCU_GPIO_OUTPUT_MODE_PUSH_PULL;
 
-    smtc_hal_mcu_gpio_enable_irq( context.irq.inst );
+    context->spi.cfg.spi = binding->spi;
 
-    smtc_hal_mcu_spi_init( &( context.spi.cfg ), &( context.spi.inst ) );
+    smtc_hal_mcu_gpio_init_input( context->busy.cfg, &( context->busy.cfg_input ), &( context->busy.inst ) );
+    smtc_hal_mcu_gpio_init_input( context->irq.cfg, &( context->irq.cfg_input ), &( context->irq.inst ) );
+    smtc_hal_mcu_gpio_init_output( context->nss.cfg, &( context->nss.cfg_output ), &( context->nss.inst ) );
+    smtc_hal_mcu_gpio_init_output( context->reset.cfg, &( context->reset.cfg_output ), &( context->reset.inst ) );
 
-    return &context;
+    // Resolve the pins toggled or polled around every radio transaction to their port and mask once and for all
+    smtc_hal_mcu_gpio_stm32l4_get_fast( context->busy.inst, &( context->busy.fast ) );
+    smtc_hal_mcu_gpio_stm32l4_get_fast( context->nss.inst, &( context->nss.fast ) );
+    smtc_hal_mcu_gpio_stm32l4_get_fast( context->reset.inst, &( context->reset.fast ) );
+
+    smtc_hal_mcu_gpio_enable_irq( context->irq.inst );
+
+    smtc_hal_mcu_spi_init( &( context->spi.cfg ), &( context->spi.inst ) );
+
+    return context;
 }
 
 void apps_common_shield_init( void )
 {
+    apps_entropy_init( );
+
     shield_pinout = smtc_shield_sx126x_get_pinout( &shield );
 
     if( shield_pinout->led_tx != SMTC_SHIELD_PINOUT_NONE )
@@ -280,17 +428,17 @@ void apps_common_sx126x_print_config( void )
 {
     HAL_DBG_TRACE_INFO( "Common RF parameters:\n" );
     HAL_DBG_TRACE_INFO( "   Packet type     = %s\n", sx126x_pkt_type_to_str( PACKET_TYPE ) );
-    HAL_DBG_TRACE_INFO( "   RF Freq         = %d Hz\n", RF_FREQ_IN_HZ );
-    HAL_DBG_TRACE_INFO( "   Output power    = %d dBm\n", TX_OUTPUT_POWER_DBM );
+    HAL_DBG_TRACE_INFO( "   RF Freq         = %u Hz\n", ATC_M_RF_FREQ_IN_HZ );
+    HAL_DBG_TRACE_INFO( "   Output power    = %d dBm\n", ATC_M_TX_OUTPUT_POWER_DBM );
     HAL_DBG_TRACE_INFO( "   Fallback mode   = %s\n", sx126x_fallback_modes_to_str( FALLBACK_MODE ) );
-    HAL_DBG_TRACE_INFO( "   Rx boost mode %sactivated\n", ( ENABLE_RX_BOOST_MODE ) ? "" : "de" );
+    HAL_DBG_TRACE_INFO( "   Rx boost mode %sactivated\n", ( ATC_M_LORA_RX_BOOST ) ? "" : "de" );
     HAL_DBG_TRACE_INFO( "\n" );
     if( PACKET_TYPE == SX126X_PKT_TYPE_LORA )
     {
         HAL_DBG_TRACE_INFO( "LoRa modulation parameters:\n" );
-        HAL_DBG_TRACE_INFO( "   Spreading Factor = %s\n", sx126x_lora_sf_to_str( LORA_SPREADING_FACTOR ) );
-        HAL_DBG_TRACE_INFO( "   Bandwidth        = %s\n", sx126x_lora_bw_to_str( LORA_BANDWIDTH ) );
-        HAL_DBG_TRACE_INFO( "   Coding rate      = %s\n", sx126x_lora_cr_to_str( LORA_CODING_RATE ) );
+        HAL_DBG_TRACE_INFO( "   Spreading Factor = %s\n", sx126x_lora_sf_to_str( ATC_M_LORA_SF ) );
+        HAL_DBG_TRACE_INFO( "   Bandwidth        = %s\n", sx126x_lora_bw_to_str( ATC_M_LORA_BW ) );
+        HAL_DBG_TRACE_INFO( "   Coding rate      = %s\n", sx126x_lora_cr_to_str( ATC_M_LORA_CR ) );
         HAL_DBG_TRACE_INFO( "\n" );
         HAL_DBG_TRACE_INFO( "LoRa packet parameters:\n" );
         HAL_DBG_TRACE_INFO( "   Preamble length  = %d symbol(s)\n", LORA_PREAMBLE_LENGTH );
@@ -345,16 +493,78 @@ void apps_common_sx126x_init( const sx126x_hal_context_t* context )
             sx126x_set_dio3_as_tcxo_ctrl( context, xosc_cfg->supply_voltage, xosc_cfg->startup_time_in_tick ) );
         ASSERT_SX126X_RC( sx126x_cal( context, SX126X_CAL_ALL ) );
     }
+
+    apps_common_sx126x_harvest_entropy( context );
+}
+
+void apps_common_sx126x_harvest_entropy( const void* context )
+{
+    uint32_t       words[APPS_ENTROPY_RADIO_HARVEST_NB_WORDS];
+    const uint32_t start_in_us = smtc_hal_mcu_timer_get_time_in_us( );
+
+    // The radio has to be in RX for its random number register to change: read all the words during a single RX
+    // session rather than paying the RX entry, register save and restore for every word
+    ASSERT_SX126X_RC( sx126x_get_random_numbers( context, words, APPS_ENTROPY_RADIO_HARVEST_NB_WORDS ) );
+    ASSERT_SX126X_RC( sx126x_clear_irq_status( context, SX126X_IRQ_ALL ) );
+
+    if( apps_entropy_add_radio_words( words, APPS_ENTROPY_RADIO_HARVEST_NB_WORDS,
+                                      smtc_hal_mcu_timer_get_elapsed_time_in_us( start_in_us ) ) == false )
+    {
+        HAL_DBG_TRACE_WARNING( "Radio random numbers rejected by the entropy pool\n" );
+    }
+}
+
+void apps_common_sx126x_print_gpio_benchmark( const void* context )
+{
+    const sx126x_hal_context_t* sx126x_context = ( const sx126x_hal_context_t* ) context;
+    sx126x_irq_mask_t           irq_status;
+    uint32_t                    start_cycles;
+
+    // NSS pulses without SPI clock are ignored by the radio, it only has to be out of sleep
+    start_cycles = apps_common_cycle_counter_get( );
+    for( int i = 0; i < GPIO_BENCHMARK_NB_ITERATIONS; i++ )
+    {
+        smtc_hal_mcu_gpio_set_state( sx126x_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+        smtc_hal_mcu_gpio_set_state( sx126x_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    }
+    const uint32_t generic_pair_in_cycles =
+        ( apps_common_cycle_counter_get( ) - start_cycles ) / GPIO_BENCHMARK_NB_ITERATIONS;
+
+    start_cycles = apps_common_cycle_counter_get( );
+    for( int i = 0; i < GPIO_BENCHMARK_NB_ITERATIONS; i++ )
+    {
+        smtc_hal_mcu_gpio_stm32l4_fast_set_low( &( sx126x_context->nss.fast ) );
+        smtc_hal_mcu_gpio_stm32l4_fast_set_high( &( sx126x_context->nss.fast ) );
+    }
+    const uint32_t fast_pair_in_cycles =
+        ( apps_common_cycle_counter_get( ) - start_cycles ) / GPIO_BENCHMARK_NB_ITERATIONS;
+
+    start_cycles = apps_common_cycle_counter_get( );
+    for( int i = 0; i < GPIO_BENCHMARK_NB_ITERATIONS; i++ )
+    {
+        ASSERT_SX126X_RC( sx126x_get_irq_status( context, &irq_status ) );
+    }
+    const uint32_t transaction_in_cycles =
+        ( apps_common_cycle_counter_get( ) - start_cycles ) / GPIO_BENCHMARK_NB_ITERATIONS;
+
+    // A GetIrqStatus read drives NSS low and high once
+    const uint32_t saved_in_cycles = generic_pair_in_cycles - fast_pair_in_cycles;
+
+    HAL_DBG_TRACE_INFO( "GPIO benchmark, NSS low + high: generic %u cycles, BSRR %u cycles\n", generic_pair_in_cycles,
+                        fast_pair_in_cycles );
+    HAL_DBG_TRACE_INFO( "GetIrqStatus transaction: %u cycles (%u us), %u cycles saved per transaction (%u%%)\n",
+                        transaction_in_cycles, apps_common_cycle_counter_to_us( transaction_in_cycles ),
+                        saved_in_cycles, ( saved_in_cycles * 100 ) / ( transaction_in_cycles + saved_in_cycles ) );
 }
 
 void apps_common_sx126x_radio_init( const void* context )
 {
-    const smtc_shield_sx126x_pa_pwr_cfg_t* pa_pwr_cfg =
-        smtc_shield_sx126x_get_pa_pwr_cfg( &shield, RF_FREQ_IN_HZ, TX_OUTPUT_POWER_DBM );
+    smtc_shield_sx126x_pa_pwr_cfg_t pa_pwr_cfg;
+    const bool                      pa_pwr_cfg_is_valid = apps_common_sx126x_get_atc_pa_pwr_cfg( &pa_pwr_cfg );
 
     apps_common_sx126x_print_config( );
 
-    if( pa_pwr_cfg == NULL )
+    if( pa_pwr_cfg_is_valid == false )
     {
         HAL_DBG_TRACE_ERROR( "Invalid target frequency or power level\n" );
         while( true )
@@ -363,17 +573,20 @@ void apps_common_sx126x_radio_init( const void* context )
     }
     ASSERT_SX126X_RC( sx126x_set_standby( context, SX126X_STANDBY_CFG_RC ) );
     ASSERT_SX126X_RC( sx126x_set_pkt_type( context, PACKET_TYPE ) );
-    ASSERT_SX126X_RC( sx126x_set_rf_freq( context, RF_FREQ_IN_HZ ) );
+    ASSERT_SX126X_RC( sx126x_set_rf_freq( context, ATC_M_RF_FREQ_IN_HZ ) );
 
-    ASSERT_SX126X_RC( sx126x_set_pa_cfg( context, &( pa_pwr_cfg->pa_config ) ) );
-    ASSERT_SX126X_RC( sx126x_set_tx_params( context, pa_pwr_cfg->power, PA_RAMP_TIME ) );
+    ASSERT_SX126X_RC( sx126x_set_pa_cfg( context, &( pa_pwr_cfg.pa_config ) ) );
+    ASSERT_SX126X_RC( sx126x_set_tx_params( context, pa_pwr_cfg.power, PA_RAMP_TIME ) );
 
     ASSERT_SX126X_RC( sx126x_set_rx_tx_fallback_mode( context, FALLBACK_MODE ) );
-    ASSERT_SX126X_RC( sx126x_cfg_rx_boosted( context, ENABLE_RX_BOOST_MODE ) );
+    ASSERT_SX126X_RC( sx126x_cfg_rx_boosted( context, ATC_M_LORA_RX_BOOST ) );
 
     if( PACKET_TYPE == SX126X_PKT_TYPE_LORA )
     {
-        lora_mod_params.ldro = apps_common_compute_lora_ldro( LORA_SPREADING_FACTOR, LORA_BANDWIDTH );
+        lora_mod_params.sf   = ATC_M_LORA_SF;
+        lora_mod_params.bw   = ATC_M_LORA_BW;
+        lora_mod_params.cr   = ATC_M_LORA_CR;
+        lora_mod_params.ldro = apps_common_compute_lora_ldro( ATC_M_LORA_SF, ATC_M_LORA_BW );
         ASSERT_SX126X_RC( sx126x_set_lora_mod_params( context, &lora_mod_params ) );
         ASSERT_SX126X_RC( sx126x_set_lora_pkt_params( context, &lora_pkt_params ) );
         ASSERT_SX126X_RC( sx126x_set_lora_sync_word( context, LORA_SYNCWORD ) );
@@ -401,6 +614,35 @@ void apps_common_sx126x_radio_init( const void* context )
     }
 }
 
+bool apps_common_sx126x_radio_reconfigure( const void* context )
+{
+    smtc_shield_sx126x_pa_pwr_cfg_t pa_pwr_cfg;
+
+    if( apps_common_sx126x_get_atc_pa_pwr_cfg( &pa_pwr_cfg ) == false )
+    {
+        HAL_DBG_TRACE_ERROR( "Invalid target frequency or power level, configuration not applied\n" );
+        return false;
+    }
+    ASSERT_SX126X_RC( sx126x_set_rf_freq( context, ATC_M_RF_FREQ_IN_HZ ) );
+    ASSERT_SX126X_RC( sx126x_set_pa_cfg( context, &( pa_pwr_cfg.pa_config ) ) );
+    ASSERT_SX126X_RC( sx126x_set_tx_params( context, pa_pwr_cfg.power, PA_RAMP_TIME ) );
+    ASSERT_SX126X_RC( sx126x_cfg_rx_boosted( context, ATC_M_LORA_RX_BOOST ) );
+
+    if( ( PACKET_TYPE == SX126X_PKT_TYPE_LORA ) &&
+        ( ( ATC_M_LORA_SF != lora_mod_params.sf ) || ( ATC_M_LORA_BW != lora_mod_params.bw ) ||
+          ( ATC_M_LORA_CR != lora_mod_params.cr ) ) )
+    {
+        lora_mod_params.sf   = ATC_M_LORA_SF;
+        lora_mod_params.bw   = ATC_M_LORA_BW;
+        lora_mod_params.cr   = ATC_M_LORA_CR;
+        lora_mod_params.ldro = apps_common_compute_lora_ldro( ATC_M_LORA_SF, ATC_M_LORA_BW );
+        ASSERT_SX126X_RC( sx126x_set_lora_mod_params( context, &lora_mod_params ) );
+        return true;
+    }
+
+    return false;
+}
+
 void apps_common_sx126x_radio_dbpsk_init( const void* context, const uint8_t payload_len )
 {
     const smtc_shield_sx126x_pa_pwr_cfg_t* pa_pwr_cfg =
@@ -515,22 +757,25 @@ void apps_common_sx126x_receive( const void* context, uint8_t* buffer, uint8_t*
 
 void apps_common_sx126x_irq_process( const void* context )
 {
-    if( irq_fired == true )
+    radio_irq_queue_t* irq_queue = radio_registry_get_irq_queue( context );
+    radio_irq_event_t  event;
+
+    if( irq_queue == NULL )
     {
-        irq_fired = false;
+        return;
+    }
 
+    irq_context = context;
+
+    while( radio_irq_queue_pop( irq_queue, &event ) == true )
+    {
         sx126x_irq_mask_t irq_regs;
         sx126x_get_and_clear_irq_status( context, &irq_regs );
 
-        if( ( irq_regs & SX126X_IRQ_TX_DONE ) == SX126X_IRQ_TX_DONE )
-        {
-            HAL_DBG_TRACE_INFO( "Tx done\n" );
-            on_tx_done( );
-        }
+        uint32_t irq_flags = irq_regs;
 
         if( ( irq_regs & SX126X_IRQ_RX_DONE ) == SX126X_IRQ_RX_DONE )
         {
-            HAL_DBG_TRACE_INFO( "Rx done\n" );
             ASSERT_SX126X_RC( sx126x_handle_rx_done( context ) );
             if( PACKET_TYPE == SX126X_PKT_TYPE_GFSK )
             {
@@ -539,89 +784,119 @@ void apps_common_sx126x_irq_process( const void* context )
 
                 if( pkt_status.rx_status.crc_error == true )
                 {
-                    HAL_DBG_TRACE_ERROR( "CRC error from packet status\n" );
-                    // The CRC error call to on_crc_error is handled with SX126X_IRQ_CRC_ERROR
+                    irq_flags |= IRQ_GFSK_STATUS_CRC_ERROR;
                 }
-                else if( pkt_status.rx_status.adrs_error == true )
+                else if( ( pkt_status.rx_status.adrs_error == true ) || ( pkt_status.rx_status.length_error == true ) )
                 {
-                    HAL_DBG_TRACE_ERROR( "Address error from packet status\n" );
-                    on_rx_error( );
+                    irq_flags |= IRQ_GFSK_STATUS_PKT_ERROR;
                 }
-                else if( pkt_status.rx_status.length_error == true )
-                {
-                    HAL_DBG_TRACE_ERROR( "Length error from packet status\n" );
-                    on_rx_error( );
-                }
-                else
-                {
-                    on_rx_done( );
-                }
-            }
-            else
-            {
-                on_rx_done( );
             }
         }
 
-        if( ( irq_regs & SX126X_IRQ_PREAMBLE_DETECTED ) == SX126X_IRQ_PREAMBLE_DETECTED )
-        {
-            HAL_DBG_TRACE_INFO( "Preamble detected\n" );
-            on_preamble_detected( );
-        }
+        // The cycle counter wraps every 53 s, so the edge is moved to the microsecond timebase, which only wraps after
+        // 71 minutes - both counters are read back to back and the edge is rebuilt from the elapsed cycles
+        const uint32_t now_in_us         = smtc_hal_mcu_timer_get_time_in_us( );
+        const uint32_t latency_in_cycles = apps_common_cycle_counter_get( ) - event.timestamp_in_cycles;
 
-        if( ( irq_regs & SX126X_IRQ_SYNC_WORD_VALID ) == SX126X_IRQ_SYNC_WORD_VALID )
-        {
-            HAL_DBG_TRACE_INFO( "Syncword valid\n" );
-            on_syncword_valid( );
-        }
-
-        if( ( irq_regs & SX126X_IRQ_HEADER_VALID ) == SX126X_IRQ_HEADER_VALID )
-        {
-            HAL_DBG_TRACE_INFO( "Header valid\n" );
-            on_header_valid( );
-        }
-
-        if( ( irq_regs & SX126X_IRQ_HEADER_ERROR ) == SX126X_IRQ_HEADER_ERROR )
-        {
-            HAL_DBG_TRACE_ERROR( "Header error\n" );
-            on_header_error( );
-        }
+        radio_irq_queue_record_latency( irq_queue, latency_in_cycles );
+        irq_timestamp_in_us = now_in_us - apps_common_cycle_counter_to_us( latency_in_cycles );
 
-        if( ( irq_regs & SX126X_IRQ_CRC_ERROR ) == SX126X_IRQ_CRC_ERROR )
+        for( uint8_t i = 0; i < IRQ_HANDLERS_COUNT; i++ )
         {
-            HAL_DBG_TRACE_ERROR( "CRC error\n" );
-            on_crc_error( );
+            if( irq_handler_matches( &irq_handlers[i], irq_flags ) == true )
+            {
+                irq_handlers[i].callback( );
+            }
         }
 
-        if( ( irq_regs & SX126X_IRQ_CAD_DONE ) == SX126X_IRQ_CAD_DONE )
+        // Traces are only emitted once all the callbacks have been called to keep them out of the dispatch latency
+        for( uint8_t i = 0; i < IRQ_HANDLERS_COUNT; i++ )
         {
-            HAL_DBG_TRACE_INFO( "CAD done\n" );
-            if( ( irq_regs & SX126X_IRQ_CAD_DETECTED ) == SX126X_IRQ_CAD_DETECTED )
+            if( irq_handler_matches( &irq_handlers[i], irq_flags ) == true )
             {
-                HAL_DBG_TRACE_INFO( "Channel activity detected\n" );
-                on_cad_done_detected( );
-            }
-            else
-            {
-                HAL_DBG_TRACE_INFO( "No channel activity detected\n" );
-                on_cad_done_undetected( );
+                irq_handler_trace( &irq_handlers[i] );
             }
         }
+    }
 
-        if( ( irq_regs & SX126X_IRQ_TIMEOUT ) == SX126X_IRQ_TIMEOUT )
-        {
-            HAL_DBG_TRACE_WARNING( "Rx timeout\n" );
-            on_rx_timeout( );
-        }
+    irq_context = NULL;
+}
 
-        if( ( irq_regs & SX126X_IRQ_LR_FHSS_HOP ) == SX126X_IRQ_LR_FHSS_HOP )
-        {
-            HAL_DBG_TRACE_INFO( "FHSS hop done\n" );
-            on_fhss_hop_done( );
-        }
+const void* apps_common_sx126x_irq_get_context( void )
+{
+    return irq_context;
+}
+
+uint32_t apps_common_sx126x_irq_get_timestamp_in_us( void )
+{
+    return irq_timestamp_in_us;
+}
+
+uint32_t apps_common_sx126x_get_rx_done_delay_in_us( void )
+{
+    if( PACKET_TYPE == SX126X_PKT_TYPE_LORA )
+    {
+        return sx126x_radio_timings_get_delay_between_last_bit_sent_and_rx_done_in_us( &lora_mod_params );
+    }
+    return 0;
+}
+
+uint32_t apps_common_sx126x_get_tx_done_delay_in_us( void )
+{
+    return sx126x_radio_timings_get_delay_between_last_bit_sent_and_tx_done_in_us( PA_RAMP_TIME );
+}
+
+uint32_t apps_common_sx126x_get_rx_end_of_packet_in_us( void )
+{
+    return irq_timestamp_in_us - apps_common_sx126x_get_rx_done_delay_in_us( );
+}
+
+uint32_t apps_common_sx126x_get_tx_end_of_packet_in_us( void )
+{
+    return irq_timestamp_in_us - apps_common_sx126x_get_tx_done_delay_in_us( );
+}
+
+void apps_common_sx126x_irq_get_stats( const void* context, radio_irq_queue_stats_t* stats )
+{
+    radio_irq_queue_get_stats( radio_registry_get_irq_queue( context ), stats );
+}
+
+void apps_common_sx126x_irq_reset_stats( const void* context )
+{
+    radio_irq_queue_reset_stats( radio_registry_get_irq_queue( context ) );
+}
+
+void apps_common_sx126x_irq_print_stats( const void* context )
+{
+    radio_irq_queue_stats_t stats;
+
+    radio_irq_queue_get_stats( radio_registry_get_irq_queue( context ), &stats );
+
+    HAL_DBG_TRACE_PRINTF( "IRQ queue %u: %u events, %u dispatched, %u overflows, depth high-water mark %u/%u\n",
+                          radio_registry_get_id( context ), stats.nb_events, stats.nb_dispatched, stats.nb_overflows,
+                          stats.depth_high_water_mark, RADIO_IRQ_QUEUE_SIZE );
+    if( stats.nb_dispatched != 0 )
+    {
+        HAL_DBG_TRACE_PRINTF( "IRQ latency: min %u us, avg %u us, max %u us\n",
+                              apps_common_cycle_counter_to_us( stats.latency_min_in_cycles ),
+                              apps_common_cycle_counter_to_us(
+                                  ( uint32_t ) ( stats.latency_sum_in_cycles / stats.nb_dispatched ) ),
+                              apps_common_cycle_counter_to_us( stats.latency_max_in_cycles ) );
     }
 }
 
+void apps_common_sx126x_wait_for_event( void )
+{
+    apps_entropy_process( );
+
+    // Flash housekeeping runs in idle time; skip sleeping while there is more of it to do
+    if( apps_kv_store_process( ) == false )
+    {
+        smtc_hal_mcu_lpm_wait_for_event( apps_common_sx126x_is_event_pending );
+    }
+    smtc_hal_mcu_timer_soft_process( );
+}
+
 void apps_common_sx126x_handle_pre_tx( void )
 {
     if( shield_pinout->led_tx != SMTC_SHIELD_PINOUT_NONE )
@@ -679,9 +954,77 @@ uint32_t get_time_on_air_in_ms( void )
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
+static void apps_common_sx126x_irq_handler( void* context, uint32_t irq_filter_mask )
+{
+    // The SX126x only raises its DIO for the interrupts enabled by sx126x_set_dio_irq_params: nothing to filter here
+    ( void ) irq_filter_mask;
+
+    apps_common_sx126x_irq_process( context );
+}
+
+static bool apps_common_sx126x_is_event_pending( void )
+{
+    return ( radio_registry_is_event_pending( ) == true ) ||
+           ( smtc_hal_mcu_timer_soft_is_expiry_pending( ) == true ) || ( uart_is_at_command_pending( ) == true );
+}
+
+static bool irq_handler_matches( const irq_handler_t* handler, uint32_t irq_regs )
+{
+    return ( ( irq_regs & handler->required_mask ) == handler->required_mask ) &&
+           ( ( irq_regs & handler->rejected_mask ) == 0 );
+}
+
+static void irq_handler_trace( const irq_handler_t* handler )
+{
+    switch( handler->trace_level )
+    {
+    case IRQ_TRACE_LEVEL_ERROR:
+        HAL_DBG_TRACE_ERROR( "%s\n", handler->name );
+        break;
+    case IRQ_TRACE_LEVEL_WARNING:
+        HAL_DBG_TRACE_WARNING( "%s\n", handler->name );
+        break;
+    default:
+        HAL_DBG_TRACE_INFO( "%s\n", handler->name );
+        break;
+    }
+}
+
+static bool apps_common_sx126x_get_atc_pa_pwr_cfg( smtc_shield_sx126x_pa_pwr_cfg_t* pa_pwr_cfg )
+{
+    const smtc_shield_sx126x_pa_pwr_cfg_t* pa_pwr_cfg_table =
+        smtc_shield_sx126x_get_pa_pwr_cfg( &shield, ATC_M_RF_FREQ_IN_HZ, ATC_M_TX_OUTPUT_POWER_DBM );
+
+    if( pa_pwr_cfg_table == NULL )
+    {
+        return false;
+    }
+
+    *pa_pwr_cfg = *pa_pwr_cfg_table;
+
+    if( ATC_M_PA_PA_DUTY_CYCLE != 1000 )
+    {
+        pa_pwr_cfg->pa_config.pa_duty_cycle = ( uint8_t ) ATC_M_PA_PA_DUTY_CYCLE;
+    }
+    if( ATC_M_PA_PA_SEL != 1000 )
+    {
+        pa_pwr_cfg->pa_config.device_sel = ( uint8_t ) ATC_M_PA_PA_SEL;
+    }
+    if( ATC_M_PA_PA_HP_SEL != 1000 )
+    {
+        pa_pwr_cfg->pa_config.hp_max = ( uint8_t ) ATC_M_PA_PA_HP_SEL;
+    }
+    if( ATC_M_PA_PA_REAL_POWER != 1000 )
+    {
+        pa_pwr_cfg->power = ( int8_t ) ATC_M_PA_PA_REAL_POWER;
+    }
+
+    return true;
+}
+
 void radio_on_dio_irq( void* context )
 {
-    irq_fired = true;
+    radio_irq_queue_push( ( radio_irq_queue_t* ) context, apps_common_cycle_counter_get( ) );
 }
 void on_tx_done( void )
 {
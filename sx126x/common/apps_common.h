@@ -49,6 +49,10 @@ extern "C" {
 #include "apps_configuration.h"
 #include "sx126x_hal_context.h"
 #include "sx126x.h"
+#include "apps_cycle_counter.h"
+#include "radio_irq_queue.h"
+#include "radio_registry.h"
+#include "smtc_hal_mcu_timer.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -81,6 +85,20 @@ extern "C" {
  */
 sx126x_hal_context_t* apps_common_sx126x_get_context( );
 
+/*!
+ * @brief Initialise the sx126x_hal_context_t object of a radio wired to the given MCU resources and register it
+ *
+ * @remark apps_common_sx126x_get_context is equivalent to radio 0 bound to RADIO_REGISTRY_BINDING_ARDUINO. Each radio
+ * gets its own DIO event queue, served by radio_registry_dispatch or apps_common_sx126x_irq_process
+ *
+ * @param [in] radio_id  Index of the radio, lower than RADIO_REGISTRY_MAX_RADIOS
+ * @param [in] binding  SPI peripheral and pins the radio is wired to
+ *
+ * @returns Pointer to the sx126x_hal_context_t object of the radio, NULL if radio_id is out of range
+ */
+sx126x_hal_context_t* apps_common_sx126x_get_context_from_binding( uint8_t                         radio_id,
+                                                                   const radio_registry_binding_t* binding );
+
 /*!
  * @brief Initialize the system configuration of the transceiver
  */
@@ -93,6 +111,25 @@ void apps_common_shield_init( void );
  */
 void apps_common_sx126x_init( const sx126x_hal_context_t* context );
 
+/*!
+ * @brief Read a batch of random numbers from the radio and mix it into the entropy pool
+ *
+ * @remark Called by apps_common_sx126x_init. The radio has to be idle, it is left in STDBY_RC
+ *
+ * @param [in] context  Pointer to the radio context
+ */
+void apps_common_sx126x_harvest_entropy( const void* context );
+
+/*!
+ * @brief Measure with the cycle counter the cost of the NSS toggling through the generic GPIO API and through the BSRR
+ * fast path, and the cost of a short radio transaction, then print them
+ *
+ * @remark The radio has to be awake: it is sent a thousand GetIrqStatus commands
+ *
+ * @param [in] context  Pointer to the radio context
+ */
+void apps_common_sx126x_print_gpio_benchmark( const void* context );
+
 /*!
  * @brief Initialize the radio configuration of the transceiver
  *
@@ -100,6 +137,22 @@ void apps_common_sx126x_init( const sx126x_hal_context_t* context );
  */
 void apps_common_sx126x_radio_init( const void* context );
 
+/*!
+ * @brief Apply the ATC_M_* parameters changed since the last radio init / reconfiguration
+ *
+ * The RF frequency, PA configuration, output power and RX boosted mode are sent again, and the LoRa modulation
+ * parameters only if the spreading factor, bandwidth or coding rate changed.
+ *
+ * @remark Must be called while the transceiver is in standby, typically from a TX / RX done handler before the next
+ * packet is started
+ *
+ * @param [in] context  Pointer to the radio context
+ *
+ * @returns true if the LoRa modulation parameters changed, false otherwise or if the new frequency / power pair is not
+ * supported by the shield
+ */
+bool apps_common_sx126x_radio_reconfigure( const void* context );
+
 /*!
  * @brief Initialize the radio configuration of the transceiver for dbpsk only
  *
@@ -122,12 +175,105 @@ void apps_common_sx126x_receive( const void* context, uint8_t* buffer, uint8_t*
 /*!
  * @brief Interface to sx126x interrupt processing routine
  *
+ * For each DIO event queued by the interrupt handler, this function fetches the IRQ mask from the sx126x and calls the
+ * routine of each raised IRQ.
+ *
  * @warning This function must be called from the main loop of project to dispense all the sx126x interrupt routine
  *
  * @param [in] context  Pointer to the radio context
  */
 void apps_common_sx126x_irq_process( const void* context );
 
+/*!
+ * @brief Get the radio whose interrupt routines are being called
+ *
+ * @remark Lets the on_* routines tell the radios apart when several of them are registered
+ *
+ * @returns Pointer to the radio context given to apps_common_sx126x_irq_process, NULL outside of it
+ */
+const void* apps_common_sx126x_irq_get_context( void );
+
+/*!
+ * @brief Get the time of the DIO edge of the interrupt being dispatched
+ *
+ * The edge is stamped with the cycle counter in the EXTI interrupt handler, so neither the main loop latency nor the
+ * traces add jitter to it. It is moved to the timebase of smtc_hal_mcu_timer_get_time_in_us when the event is
+ * dispatched.
+ *
+ * @remark Only meaningful in the callbacks called by apps_common_sx126x_irq_process
+ *
+ * @returns DIO edge timestamp, in microseconds
+ */
+uint32_t apps_common_sx126x_irq_get_timestamp_in_us( void );
+
+/*!
+ * @brief Get the delay between the last bit on air and the RX_DONE interrupt with the current radio configuration
+ *
+ * @returns sx126x_radio_timings_get_delay_between_last_bit_sent_and_rx_done_in_us for LoRa, 0 for the other packet
+ * types
+ */
+uint32_t apps_common_sx126x_get_rx_done_delay_in_us( void );
+
+/*!
+ * @brief Get the delay between the last bit on air and the TX_DONE interrupt with PA_RAMP_TIME
+ *
+ * @returns sx126x_radio_timings_get_delay_between_last_bit_sent_and_tx_done_in_us
+ */
+uint32_t apps_common_sx126x_get_tx_done_delay_in_us( void );
+
+/*!
+ * @brief Get the time the last bit of the packet which raised RX_DONE was on air
+ *
+ * The RX_DONE edge is moved back by apps_common_sx126x_get_rx_done_delay_in_us.
+ *
+ * @remark Only meaningful in on_rx_done
+ *
+ * @returns End of packet timestamp, in the timebase of smtc_hal_mcu_timer_get_time_in_us
+ */
+uint32_t apps_common_sx126x_get_rx_end_of_packet_in_us( void );
+
+/*!
+ * @brief Get the time the last bit of the packet which raised TX_DONE was on air
+ *
+ * The TX_DONE edge is moved back by apps_common_sx126x_get_tx_done_delay_in_us.
+ *
+ * @remark Only meaningful in on_tx_done
+ *
+ * @returns End of packet timestamp, in the timebase of smtc_hal_mcu_timer_get_time_in_us
+ */
+uint32_t apps_common_sx126x_get_tx_end_of_packet_in_us( void );
+
+/*!
+ * @brief Get the statistics of the DIO event queue of a radio
+ *
+ * @param [in] context  Pointer to the radio context
+ * @param [out] stats  Queue depth high-water mark, overflow count and DIO edge to dispatch latency
+ */
+void apps_common_sx126x_irq_get_stats( const void* context, radio_irq_queue_stats_t* stats );
+
+/*!
+ * @brief Reset the statistics of the DIO event queue of a radio
+ *
+ * @param [in] context  Pointer to the radio context
+ */
+void apps_common_sx126x_irq_reset_stats( const void* context );
+
+/*!
+ * @brief Print the statistics of the DIO event queue of a radio
+ *
+ * @param [in] context  Pointer to the radio context
+ */
+void apps_common_sx126x_irq_print_stats( const void* context );
+
+/*!
+ * @brief Put the MCU in low power mode until a DIO event, a software timer expiry or an AT command is waiting to be
+ * processed, then call the callbacks of the expired software timers
+ *
+ * @remark The deepest power mode is the one allowed with smtc_hal_mcu_lpm_set_max_mode. Events raised by the callbacks
+ * called from the main loop must be handled before calling this function as they do not wake the MCU up.
+ */
+void apps_common_sx126x_wait_for_event( void );
+
 /*!
  * @brief Prints all RF parameters
  */
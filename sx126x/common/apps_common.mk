@@ -92,19 +92,45 @@ include $(SMTC_HAL_MCU_MAKEFILE)
 C_SOURCES +=  \
 $(TOP_DIR)/sx126x/common/apps_common.c \
 $(TOP_DIR)/sx126x/common/sx126x_hal.c \
+$(TOP_DIR)/sx126x/common/atc_sx126x.c \
+$(TOP_DIR)/sx126x/common/apps_radio_sx126x.c \
 $(TOP_DIR)/common/src/smtc_hal_dbg_trace.c \
 $(TOP_DIR)/common/src/common_version.c \
 $(TOP_DIR)/common/src/smtc_shield_pinout_mapping.c \
 $(TOP_DIR)/common/src/uart_init.c \
+$(TOP_DIR)/common/src/radio_irq_queue.c \
+$(TOP_DIR)/common/src/radio_registry.c \
+$(TOP_DIR)/common/src/apps_radio.c \
+$(TOP_DIR)/common/src/apps_cycle_counter.c \
+$(TOP_DIR)/common/src/atc.c \
+$(TOP_DIR)/common/src/apps_kv_store.c \
+$(TOP_DIR)/libs/smtc_kv_store/src/smtc_kv_store.c \
+$(TOP_DIR)/common/src/apps_entropy.c \
+$(TOP_DIR)/libs/smtc_entropy_pool/src/smtc_entropy_pool.c \
+$(TOP_DIR)/libs/smtc_time_sync/src/smtc_time_sync.c \
+$(TOP_DIR)/common/src/apps_link_stats.c \
+$(TOP_DIR)/common/src/apps_rx_pool.c \
+$(TOP_DIR)/common/src/apps_cad_scan.c \
+$(TOP_DIR)/common/src/apps_cad_tuner.c \
+$(TOP_DIR)/common/src/apps_spectral_sweep.c \
+$(TOP_DIR)/libs/smtc_link_stats/src/smtc_link_stats.c \
+$(TOP_DIR)/common/src/apps_occupancy_recorder.c \
+$(TOP_DIR)/libs/smtc_occupancy_log/src/smtc_occupancy_log.c \
 
 C_INCLUDES +=  \
 -I$(TOP_DIR)/sx126x/common \
--I$(TOP_DIR)/common/inc
+-I$(TOP_DIR)/common/inc \
+-I$(TOP_DIR)/libs/smtc_kv_store/src \
+-I$(TOP_DIR)/libs/smtc_entropy_pool/src \
+-I$(TOP_DIR)/libs/smtc_time_sync/src \
+-I$(TOP_DIR)/libs/smtc_link_stats/src \
+-I$(TOP_DIR)/libs/smtc_occupancy_log/src
 
 C_SOURCES +=  \
 $(TOP_DIR)/sx126x/sx126x_driver/src/sx126x.c \
 $(TOP_DIR)/sx126x/sx126x_driver/src/sx126x_lr_fhss.c \
-$(TOP_DIR)/sx126x/sx126x_driver/src/lr_fhss_driver/src/lr_fhss_mac.c
+$(TOP_DIR)/sx126x/sx126x_driver/src/sx126x_radio_timings.c \
+$(TOP_DIR)/sx126x/sx126x_driver/src/lr_fhss_mac.c
 
 C_INCLUDES +=  \
 -I$(TOP_DIR)/sx126x/sx126x_driver/src \
@@ -0,0 +1,434 @@
+/*!
+ * @file      apps_radio_sx126x.h
+ *
+ * @brief     SX126x adapter of the chip-agnostic radio API
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef APPS_RADIO_SX126X_H
+#define APPS_RADIO_SX126X_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "apps_radio_types.h"
+#include "apps_common.h"
+#include "apps_utilities.h"
+#include "sx126x.h"
+#include "sx126x_radio_timings.h"
+#include "smtc_hal_dbg_trace.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*!
+ * @brief Function table of the SX126x adapter
+ */
+extern const apps_radio_ops_t apps_radio_sx126x_ops;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/*!
+ * @see apps_common_sx126x_get_context_from_binding
+ */
+void* apps_radio_sx126x_get_context( uint8_t radio_id, const radio_registry_binding_t* binding );
+
+/*!
+ * @see apps_common_sx126x_print_version_info
+ */
+void apps_radio_sx126x_print_version( void );
+
+/*!
+ * @brief Initialize the chip and apply the radio configuration
+ */
+void apps_radio_sx126x_init( const void* context );
+
+/*!
+ * @brief Initialize the chip and apply the DBPSK configuration
+ */
+void apps_radio_sx126x_init_dbpsk( const void* context, uint8_t payload_length );
+
+/*!
+ * @see apps_radio_receive_packet
+ */
+bool apps_radio_sx126x_receive_packet( const void* context, uint32_t rx_restart_timeout_in_ms,
+                                       apps_radio_rx_packet_t* packet );
+
+/*!
+ * @brief Time apps_common_sx126x_get_tx_done_delay_in_us called directly, through apps_radio_get_tx_done_delay_in_us
+ * and through apps_radio_sx126x_ops, then print the results
+ */
+void apps_radio_sx126x_print_call_benchmark( const void* context );
+
+/*!
+ * @see apps_radio_get_cad_recommended_params
+ */
+void apps_radio_sx126x_get_cad_recommended_params( apps_radio_lora_sf_t sf, apps_radio_lora_bw_t bw,
+                                                   apps_radio_cad_params_t* params );
+
+/*!
+ * @brief Translate interrupts of the chip-agnostic API into SX126x IRQ flags
+ *
+ * @remark GFSK length and address errors are not IRQs on the SX126x: they are read from the packet status on RX done
+ */
+static inline sx126x_irq_mask_t apps_radio_sx126x_irq_to_chip( apps_radio_irq_mask_t irq )
+{
+    sx126x_irq_mask_t chip_irq = SX126X_IRQ_NONE;
+
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_TX_DONE ) != 0 ) ? SX126X_IRQ_TX_DONE : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_RX_DONE ) != 0 ) ? SX126X_IRQ_RX_DONE : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_TIMEOUT ) != 0 ) ? SX126X_IRQ_TIMEOUT : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_PREAMBLE_DETECTED ) != 0 ) ? SX126X_IRQ_PREAMBLE_DETECTED : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_SYNCWORD_HEADER_VALID ) != 0 )
+                    ? ( SX126X_IRQ_SYNC_WORD_VALID | SX126X_IRQ_HEADER_VALID )
+                    : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_HEADER_ERROR ) != 0 ) ? SX126X_IRQ_HEADER_ERROR : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_CRC_ERROR ) != 0 ) ? SX126X_IRQ_CRC_ERROR : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_CAD_DONE ) != 0 ) ? SX126X_IRQ_CAD_DONE : 0;
+    chip_irq |= ( ( irq & APPS_RADIO_IRQ_CAD_DETECTED ) != 0 ) ? SX126X_IRQ_CAD_DETECTED : 0;
+
+    return chip_irq;
+}
+
+/*!
+ * @brief Translate SX126x IRQ flags into interrupts of the chip-agnostic API
+ */
+static inline apps_radio_irq_mask_t apps_radio_sx126x_irq_from_chip( sx126x_irq_mask_t chip_irq )
+{
+    apps_radio_irq_mask_t irq = APPS_RADIO_IRQ_NONE;
+
+    irq |= ( ( chip_irq & SX126X_IRQ_TX_DONE ) != 0 ) ? APPS_RADIO_IRQ_TX_DONE : 0;
+    irq |= ( ( chip_irq & SX126X_IRQ_RX_DONE ) != 0 ) ? APPS_RADIO_IRQ_RX_DONE : 0;
+    irq |= ( ( chip_irq & SX126X_IRQ_TIMEOUT ) != 0 ) ? APPS_RADIO_IRQ_TIMEOUT : 0;
+    irq |= ( ( chip_irq & SX126X_IRQ_PREAMBLE_DETECTED ) != 0 ) ? APPS_RADIO_IRQ_PREAMBLE_DETECTED : 0;
+    irq |= ( ( chip_irq & ( SX126X_IRQ_SYNC_WORD_VALID | SX126X_IRQ_HEADER_VALID ) ) != 0 )
+               ? APPS_RADIO_IRQ_SYNCWORD_HEADER_VALID
+               : 0;
+    irq |= ( ( chip_irq & SX126X_IRQ_HEADER_ERROR ) != 0 ) ? APPS_RADIO_IRQ_HEADER_ERROR : 0;
+    irq |= ( ( chip_irq & SX126X_IRQ_CRC_ERROR ) != 0 ) ? APPS_RADIO_IRQ_CRC_ERROR : 0;
+    irq |= ( ( chip_irq & SX126X_IRQ_CAD_DONE ) != 0 ) ? APPS_RADIO_IRQ_CAD_DONE : 0;
+    irq |= ( ( chip_irq & SX126X_IRQ_CAD_DETECTED ) != 0 ) ? APPS_RADIO_IRQ_CAD_DETECTED : 0;
+
+    return irq;
+}
+
+/*
+ * The adapters below are bound at compile time by apps_radio.h in single-chip builds: keep them as thin as the driver
+ * calls they wrap
+ */
+
+static inline bool apps_radio_sx126x_reconfigure( const void* context )
+{
+    return apps_common_sx126x_radio_reconfigure( context );
+}
+
+static inline bool apps_radio_sx126x_is_lora_pkt_type( void )
+{
+    return PACKET_TYPE == SX126X_PKT_TYPE_LORA;
+}
+
+static inline void apps_radio_sx126x_set_rf_freq( const void* context, uint32_t freq_in_hz )
+{
+    ASSERT_SX126X_RC( sx126x_set_rf_freq( context, freq_in_hz ) );
+}
+
+static inline void apps_radio_sx126x_set_fs( const void* context )
+{
+    ASSERT_SX126X_RC( sx126x_set_fs( context ) );
+}
+
+static inline void apps_radio_sx126x_set_lora_params( const void* context, const apps_radio_lora_params_t* params )
+{
+    const sx126x_mod_params_lora_t mod_params = {
+        .sf   = ( sx126x_lora_sf_t ) params->sf,
+        .bw   = ( sx126x_lora_bw_t ) params->bw,
+        .cr   = ( sx126x_lora_cr_t ) params->cr,
+        .ldro = ( params->ldro_is_on == true ) ? 1 : 0,
+    };
+    const sx126x_pkt_params_lora_t pkt_params = {
+        .preamble_len_in_symb = params->preamble_len_in_symb,
+        .header_type =
+            ( params->header_is_implicit == true ) ? SX126X_LORA_PKT_IMPLICIT : SX126X_LORA_PKT_EXPLICIT,
+        .pld_len_in_bytes = params->pld_len_in_bytes,
+        .crc_is_on        = params->crc_is_on,
+        .invert_iq_is_on  = params->invert_iq_is_on,
+    };
+
+    ASSERT_SX126X_RC( sx126x_set_lora_mod_params( context, &mod_params ) );
+    ASSERT_SX126X_RC( sx126x_set_lora_pkt_params( context, &pkt_params ) );
+}
+
+static inline void apps_radio_sx126x_set_irq_mask( const void* context, apps_radio_irq_mask_t irq_mask )
+{
+    const sx126x_irq_mask_t chip_irq_mask = apps_radio_sx126x_irq_to_chip( irq_mask );
+
+    ASSERT_SX126X_RC(
+        sx126x_set_dio_irq_params( context, SX126X_IRQ_ALL, chip_irq_mask, SX126X_IRQ_NONE, SX126X_IRQ_NONE ) );
+    ASSERT_SX126X_RC( sx126x_clear_irq_status( context, SX126X_IRQ_ALL ) );
+}
+
+static inline void apps_radio_sx126x_write_payload( const void* context, const uint8_t* buffer, uint8_t length )
+{
+    ASSERT_SX126X_RC( sx126x_write_buffer( context, 0, buffer, length ) );
+}
+
+static inline uint8_t apps_radio_sx126x_read_payload( const void* context, uint8_t* buffer, uint8_t max_length )
+{
+    sx126x_rx_buffer_status_t rx_buffer_status;
+
+    ASSERT_SX126X_RC( sx126x_get_rx_buffer_status( context, &rx_buffer_status ) );
+    if( rx_buffer_status.pld_len_in_bytes > max_length )
+    {
+        HAL_DBG_TRACE_ERROR( "Received more bytes than expected (%d vs %d), reception in buffer cancelled.\n",
+                             rx_buffer_status.pld_len_in_bytes, max_length );
+        return 0;
+    }
+
+    ASSERT_SX126X_RC( sx126x_read_buffer( context, rx_buffer_status.buffer_start_pointer, buffer,
+                                          rx_buffer_status.pld_len_in_bytes ) );
+    return rx_buffer_status.pld_len_in_bytes;
+}
+
+static inline uint8_t apps_radio_sx126x_read_payload_head( const void* context, uint8_t* buffer, uint8_t length )
+{
+    sx126x_rx_buffer_status_t rx_buffer_status;
+
+    ASSERT_SX126X_RC( sx126x_get_rx_buffer_status( context, &rx_buffer_status ) );
+    if( rx_buffer_status.pld_len_in_bytes >= length )
+    {
+        ASSERT_SX126X_RC( sx126x_read_buffer( context, rx_buffer_status.buffer_start_pointer, buffer, length ) );
+    }
+    return rx_buffer_status.pld_len_in_bytes;
+}
+
+static inline bool apps_radio_sx126x_get_lora_pkt_status( const void*                   context,
+                                                          apps_radio_lora_pkt_status_t* pkt_status )
+{
+    sx126x_pkt_status_lora_t pkt_status_lora;
+
+    if( PACKET_TYPE != SX126X_PKT_TYPE_LORA )
+    {
+        return false;
+    }
+
+    ASSERT_SX126X_RC( sx126x_get_lora_pkt_status( context, &pkt_status_lora ) );
+    pkt_status->rssi_pkt_in_dbm        = pkt_status_lora.rssi_pkt_in_dbm;
+    pkt_status->snr_pkt_in_db          = pkt_status_lora.snr_pkt_in_db;
+    pkt_status->signal_rssi_pkt_in_dbm = pkt_status_lora.signal_rssi_pkt_in_dbm;
+    return true;
+}
+
+static inline bool apps_radio_sx126x_get_gfsk_pkt_status( const void*                   context,
+                                                          apps_radio_gfsk_pkt_status_t* pkt_status )
+{
+    sx126x_pkt_status_gfsk_t pkt_status_gfsk;
+
+    if( PACKET_TYPE != SX126X_PKT_TYPE_GFSK )
+    {
+        return false;
+    }
+
+    ASSERT_SX126X_RC( sx126x_get_gfsk_pkt_status( context, &pkt_status_gfsk ) );
+    pkt_status->rssi_sync_in_dbm = pkt_status_gfsk.rssi_sync;
+    pkt_status->rssi_avg_in_dbm  = pkt_status_gfsk.rssi_avg;
+    return true;
+}
+
+static inline void apps_radio_sx126x_set_tx( const void* context, uint32_t timeout_in_ms )
+{
+    apps_common_sx126x_handle_pre_tx( );
+    ASSERT_SX126X_RC( sx126x_set_tx( context, timeout_in_ms ) );
+}
+
+static inline void apps_radio_sx126x_set_standby( const void* context, apps_radio_standby_cfg_t cfg )
+{
+    ASSERT_SX126X_RC( sx126x_set_standby( context, ( sx126x_standby_cfg_t ) cfg ) );
+    apps_common_sx126x_handle_post_tx( );
+    apps_common_sx126x_handle_post_rx( );
+}
+
+static inline void apps_radio_sx126x_set_tx_cw( const void* context )
+{
+    apps_common_sx126x_handle_pre_tx( );
+    ASSERT_SX126X_RC( sx126x_set_tx_cw( context ) );
+}
+
+static inline void apps_radio_sx126x_set_tx_infinite_preamble( const void* context )
+{
+    apps_common_sx126x_handle_pre_tx( );
+    ASSERT_SX126X_RC( sx126x_set_tx_infinite_preamble( context ) );
+}
+
+static inline void apps_radio_sx126x_set_rx( const void* context, uint32_t timeout_in_ms )
+{
+    apps_common_sx126x_handle_pre_rx( );
+    ASSERT_SX126X_RC( sx126x_set_rx( context, timeout_in_ms ) );
+}
+
+static inline void apps_radio_sx126x_set_rx_continuous( const void* context )
+{
+    apps_common_sx126x_handle_pre_rx( );
+    ASSERT_SX126X_RC( sx126x_set_rx_with_timeout_in_rtc_step( context, RX_CONTINUOUS ) );
+}
+
+static inline int16_t apps_radio_sx126x_get_rssi_inst( const void* context )
+{
+    int16_t rssi_in_dbm = 0;
+
+    ASSERT_SX126X_RC( sx126x_get_rssi_inst( context, &rssi_in_dbm ) );
+    return rssi_in_dbm;
+}
+
+static inline void apps_radio_sx126x_start_cad( const void* context, const apps_radio_cad_params_t* params )
+{
+    sx126x_cad_params_t cad_params = {
+        .cad_symb_nb     = SX126X_CAD_01_SYMB,
+        .cad_detect_peak = params->detect_peak,
+        .cad_detect_min  = params->detect_min,
+        .cad_exit_mode   = ( sx126x_cad_exit_modes_t ) params->exit_mode,
+        .cad_timeout     = sx126x_convert_timeout_in_ms_to_rtc_step( params->timeout_in_ms ),
+    };
+
+    // The SX126x takes the number of symbols as a power of two
+    while( ( cad_params.cad_symb_nb < SX126X_CAD_16_SYMB ) &&
+           ( ( 1u << cad_params.cad_symb_nb ) < params->nb_symbols ) )
+    {
+        cad_params.cad_symb_nb++;
+    }
+
+    ASSERT_SX126X_RC( sx126x_set_cad_params( context, &cad_params ) );
+    ASSERT_SX126X_RC( sx126x_set_cad( context ) );
+}
+
+static inline void apps_radio_sx126x_restart_cad( const void* context )
+{
+    ASSERT_SX126X_RC( sx126x_set_cad( context ) );
+}
+
+static inline apps_radio_irq_mask_t apps_radio_sx126x_get_and_clear_irq_status( const void* context )
+{
+    sx126x_irq_mask_t chip_irq = SX126X_IRQ_NONE;
+
+    ASSERT_SX126X_RC( sx126x_get_and_clear_irq_status( context, &chip_irq ) );
+
+    apps_radio_irq_mask_t irq = apps_radio_sx126x_irq_from_chip( chip_irq );
+
+    if( ( chip_irq & SX126X_IRQ_TX_DONE ) != 0 )
+    {
+        apps_common_sx126x_handle_post_tx( );
+    }
+    if( ( chip_irq & ( SX126X_IRQ_RX_DONE | SX126X_IRQ_TIMEOUT ) ) != 0 )
+    {
+        apps_common_sx126x_handle_post_rx( );
+    }
+    if( ( chip_irq & SX126X_IRQ_RX_DONE ) != 0 )
+    {
+        ASSERT_SX126X_RC( sx126x_handle_rx_done( context ) );
+        if( PACKET_TYPE == SX126X_PKT_TYPE_GFSK )
+        {
+            sx126x_pkt_status_gfsk_t pkt_status;
+
+            ASSERT_SX126X_RC( sx126x_get_gfsk_pkt_status( context, &pkt_status ) );
+            if( pkt_status.rx_status.crc_error == true )
+            {
+                irq |= APPS_RADIO_IRQ_CRC_ERROR;
+            }
+            else if( ( pkt_status.rx_status.adrs_error == true ) || ( pkt_status.rx_status.length_error == true ) )
+            {
+                irq |= APPS_RADIO_IRQ_LENGTH_ERROR;
+            }
+        }
+    }
+
+    return irq;
+}
+
+static inline uint32_t apps_radio_sx126x_get_rx_done_delay_in_us( const void* context )
+{
+    ( void ) context;
+    return apps_common_sx126x_get_rx_done_delay_in_us( );
+}
+
+static inline uint32_t apps_radio_sx126x_get_tx_done_delay_in_us( const void* context )
+{
+    ( void ) context;
+    return apps_common_sx126x_get_tx_done_delay_in_us( );
+}
+
+static inline bool apps_radio_sx126x_is_timing_model_characterised( void )
+{
+    return SX126X_RADIO_TIMINGS_IS_CHARACTERISED != 0;
+}
+
+static inline void apps_radio_sx126x_wait_for_event( void )
+{
+    apps_common_sx126x_wait_for_event( );
+}
+
+static inline void apps_radio_sx126x_print_gpio_benchmark( const void* context )
+{
+    apps_common_sx126x_print_gpio_benchmark( context );
+}
+
+static inline void apps_radio_sx126x_print_irq_stats( const void* context )
+{
+    apps_common_sx126x_irq_print_stats( context );
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // APPS_RADIO_SX126X_H
+
+/* --- EOF ------------------------------------------------------------------ */
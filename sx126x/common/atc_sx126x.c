@@ -0,0 +1,46 @@
+#include "atc.h"
+#include "sx126x.h"
+#include "apps_configuration.h"
+//global macros initial: SX126x defaults come from apps_configuration.h, they apply until changed by AT commands
+int ATC_M_TX_OUTPUT_POWER_DBM = TX_OUTPUT_POWER_DBM;
+
+uint32_t ATC_M_RF_FREQ_IN_HZ = RF_FREQ_IN_HZ;
+
+int ATC_M_LORA_SF = LORA_SPREADING_FACTOR;
+
+int ATC_M_LORA_BW = LORA_BANDWIDTH;
+
+int ATC_M_LORA_CR = LORA_CODING_RATE;
+
+int ATC_M_LORA_RX_BOOST = ENABLE_RX_BOOST_MODE;
+
+static const ATC_ParamMapTypeDef ATC_Sx126xLoraSfMap[] = {
+    {5, SX126X_LORA_SF5},   {6, SX126X_LORA_SF6},   {7, SX126X_LORA_SF7},   {8, SX126X_LORA_SF8},
+    {9, SX126X_LORA_SF9},   {10, SX126X_LORA_SF10}, {11, SX126X_LORA_SF11}, {12, SX126X_LORA_SF12},
+};
+
+static const ATC_ParamMapTypeDef ATC_Sx126xLoraBwMap[] = {
+    {7, SX126X_LORA_BW_007},   {10, SX126X_LORA_BW_010},  {15, SX126X_LORA_BW_015},
+    {20, SX126X_LORA_BW_020},  {31, SX126X_LORA_BW_031},  {41, SX126X_LORA_BW_041},
+    {62, SX126X_LORA_BW_062},  {125, SX126X_LORA_BW_125}, {250, SX126X_LORA_BW_250},
+    {500, SX126X_LORA_BW_500},
+};
+
+// 1-4: 4/5 to 4/8, the SX126x has no long interleaver coding rates
+static const ATC_ParamMapTypeDef ATC_Sx126xLoraCrMap[] = {
+    {1, SX126X_LORA_CR_4_5},
+    {2, SX126X_LORA_CR_4_6},
+    {3, SX126X_LORA_CR_4_7},
+    {4, SX126X_LORA_CR_4_8},
+};
+
+const ATC_BindingTypeDef ATC_Binding = {
+    .pFamily = "SX126x",
+    .pLoraSf = ATC_Sx126xLoraSfMap,
+    .LoraSfCount = ATC_MAP_SIZE(ATC_Sx126xLoraSfMap),
+    .pLoraBw = ATC_Sx126xLoraBwMap,
+    .LoraBwCount = ATC_MAP_SIZE(ATC_Sx126xLoraBwMap),
+    .pLoraCr = ATC_Sx126xLoraCrMap,
+    .LoraCrCount = ATC_MAP_SIZE(ATC_Sx126xLoraCrMap),
+    .Features = ATC_FEATURE_PER_SWEEP | ATC_FEATURE_PER_FAST,
+};
@@ -44,7 +44,7 @@
 #include "sx126x_hal_context.h"
 #include "sx126x_hal.h"
 #include "smtc_hal_mcu_spi.h"
-#include "smtc_hal_mcu_gpio.h"
+#include "smtc_hal_mcu_gpio_stm32l4.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -80,9 +80,9 @@ sx126x_hal_status_t sx126x_hal_reset( const void* context )
 {
     const sx126x_hal_context_t* sx126x_context = ( const sx126x_hal_context_t* ) context;
 
-    smtc_hal_mcu_gpio_set_state( sx126x_context->reset.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_low( &( sx126x_context->reset.fast ) );
     LL_mDelay( 1 );
-    smtc_hal_mcu_gpio_set_state( sx126x_context->reset.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_high( &( sx126x_context->reset.fast ) );
 
     return SX126X_HAL_STATUS_OK;
 }
@@ -91,9 +91,9 @@ sx126x_hal_status_t sx126x_hal_wakeup( const void* context )
 {
     const sx126x_hal_context_t* sx126x_context = ( const sx126x_hal_context_t* ) context;
 
-    smtc_hal_mcu_gpio_set_state( sx126x_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_low( &( sx126x_context->nss.fast ) );
     LL_mDelay( 1 );
-    smtc_hal_mcu_gpio_set_state( sx126x_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_high( &( sx126x_context->nss.fast ) );
 
     return SX126X_HAL_STATUS_OK;
 }
@@ -106,10 +106,10 @@ sx126x_hal_status_t sx126x_hal_write( const void* context, const uint8_t* comman
 
     sx126x_hal_wait_on_busy( sx126x_context );
 
-    smtc_hal_mcu_gpio_set_state( sx126x_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_low( &( sx126x_context->nss.fast ) );
     smtc_hal_mcu_spi_rw_buffer( sx126x_context->spi.inst, command, NULL, command_length );
     smtc_hal_mcu_spi_rw_buffer( sx126x_context->spi.inst, data, NULL, data_length );
-    smtc_hal_mcu_gpio_set_state( sx126x_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_high( &( sx126x_context->nss.fast ) );
 
     return SX126X_HAL_STATUS_OK;
 }
@@ -121,10 +121,10 @@ sx126x_hal_status_t sx126x_hal_read( const void* context, const uint8_t* command
 
     sx126x_hal_wait_on_busy( sx126x_context );
 
-    smtc_hal_mcu_gpio_set_state( sx126x_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_LOW );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_low( &( sx126x_context->nss.fast ) );
     smtc_hal_mcu_spi_rw_buffer( sx126x_context->spi.inst, command, NULL, command_length );
     smtc_hal_mcu_spi_rw_buffer( sx126x_context->spi.inst, NULL, data, data_length );
-    smtc_hal_mcu_gpio_set_state( sx126x_context->nss.inst, SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    smtc_hal_mcu_gpio_stm32l4_fast_set_high( &( sx126x_context->nss.fast ) );
 
     return SX126X_HAL_STATUS_OK;
 }
@@ -137,12 +137,10 @@ sx126x_hal_status_t sx126x_hal_read( const void* context, const uint8_t* command
 void sx126x_hal_wait_on_busy( const void* radio )
 {
     const sx126x_hal_context_t* sx126x_context = ( const sx126x_hal_context_t* ) radio;
-    smtc_hal_mcu_gpio_state_t   gpio_state;
 
-    do
+    while( smtc_hal_mcu_gpio_stm32l4_fast_is_high( &( sx126x_context->busy.fast ) ) )
     {
-        smtc_hal_mcu_gpio_get_state( sx126x_context->busy.inst, &gpio_state );
-    } while( gpio_state == SMTC_HAL_MCU_GPIO_STATE_HIGH );
+    }
 }
 
 /* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,202 @@
+/**
+ * @file      sx126x_radio_timings.c
+ *
+ * @brief     SX126x timing helper functions implementation
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include "sx126x_radio_timings.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+/**
+ * @brief Time in microsecond taken by the chip to process the Rx done interrupt - LR11xx placeholder
+ *
+ * @remark Not characterised on SX126x: this is the figure of lr11xx_radio_timings, so the delays computed here carry
+ * an unvalidated constant bias, see SX126X_RADIO_TIMINGS_IS_CHARACTERISED
+ */
+#define LR11XX_PLACEHOLDER_RX_DONE_IRQ_PROCESSING_TIME_IN_US 74
+
+/**
+ * @brief Time in microsecond taken by the chip to process the Tx done interrupt - LR11xx placeholder
+ */
+#define LR11XX_PLACEHOLDER_TX_DONE_IRQ_PROCESSING_TIME_IN_US 111
+
+/**
+ * @brief Product of the LoRa receive front-end delay and the bandwidth, in microsecond times Hz
+ *
+ * @remark The delay scales with the inverse of the bandwidth: this gives 57 / 29 / 15 us at 125 / 250 / 500 kHz, within
+ * 2 us of the LR11xx figures, and extends the model to the narrow bandwidths the SX126x supports
+ */
+#define LORA_RX_INPUT_DELAY_BW_PRODUCT ( 7000000UL )
+
+/**
+ * @brief Fixed part of the LoRa receive front-end delay, in microsecond
+ */
+#define LORA_RX_INPUT_DELAY_OFFSET_IN_US 1
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Get the power amplifier ramp time
+ *
+ * @param [in] ramp_time Power amplifier ramp time
+ *
+ * @returns Ramp time in microsecond
+ */
+static uint32_t sx126x_radio_timings_get_pa_ramp_time_in_us( const sx126x_ramp_time_t ramp_time );
+
+/**
+ * @brief Get the LoRa reception input delay
+ *
+ * @param [in] bw LoRa bandwidth
+ *
+ * @returns LoRa reception input delay in microsecond
+ */
+static uint32_t sx126x_radio_timings_get_lora_rx_input_delay_in_us( sx126x_lora_bw_t bw );
+
+/**
+ * @brief Get the LoRa symbol time
+ *
+ * @param [in] sf LoRa spreading factor
+ * @param [in] bw LoRa bandwidth
+ *
+ * @returns LoRa symbol time in microsecond
+ */
+static uint32_t sx126x_radio_timings_get_lora_symb_time_in_us( const sx126x_lora_sf_t sf, const sx126x_lora_bw_t bw );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+uint32_t sx126x_radio_timings_get_delay_between_last_bit_sent_and_rx_done_in_us(
+    const sx126x_mod_params_lora_t* mod_params )
+{
+    return sx126x_radio_timings_get_lora_rx_input_delay_in_us( mod_params->bw ) +
+           2 * sx126x_radio_timings_get_lora_symb_time_in_us( mod_params->sf, mod_params->bw ) +
+           LR11XX_PLACEHOLDER_RX_DONE_IRQ_PROCESSING_TIME_IN_US;
+}
+
+uint32_t sx126x_radio_timings_get_delay_between_last_bit_sent_and_tx_done_in_us( const sx126x_ramp_time_t ramp_time )
+{
+    return sx126x_radio_timings_get_pa_ramp_time_in_us( ramp_time ) +
+           LR11XX_PLACEHOLDER_TX_DONE_IRQ_PROCESSING_TIME_IN_US;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint32_t sx126x_radio_timings_get_pa_ramp_time_in_us( const sx126x_ramp_time_t ramp_time )
+{
+    switch( ramp_time )
+    {
+    case SX126X_RAMP_10_US:
+    {
+        return 10;
+    }
+    case SX126X_RAMP_20_US:
+    {
+        return 20;
+    }
+    case SX126X_RAMP_40_US:
+    {
+        return 40;
+    }
+    case SX126X_RAMP_80_US:
+    {
+        return 80;
+    }
+    case SX126X_RAMP_200_US:
+    {
+        return 200;
+    }
+    case SX126X_RAMP_800_US:
+    {
+        return 800;
+    }
+    case SX126X_RAMP_1700_US:
+    {
+        return 1700;
+    }
+    case SX126X_RAMP_3400_US:
+    {
+        return 3400;
+    }
+    default:
+        return 0;
+    }
+}
+
+static uint32_t sx126x_radio_timings_get_lora_rx_input_delay_in_us( sx126x_lora_bw_t bw )
+{
+    const uint32_t bw_in_hz = sx126x_get_lora_bw_in_hz( bw );
+
+    if( bw_in_hz == 0 )
+    {
+        return 0;
+    }
+    return LORA_RX_INPUT_DELAY_OFFSET_IN_US + ( LORA_RX_INPUT_DELAY_BW_PRODUCT + ( bw_in_hz / 2 ) ) / bw_in_hz;
+}
+
+static uint32_t sx126x_radio_timings_get_lora_symb_time_in_us( const sx126x_lora_sf_t sf, const sx126x_lora_bw_t bw )
+{
+    return ( ( uint32_t ) 1 << ( uint8_t ) sf ) * 1000000UL / sx126x_get_lora_bw_in_hz( bw );
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,103 @@
+/**
+ * @file      sx126x_radio_timings.h
+ *
+ * @brief     SX126x timing helper functions definition
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SX126X_RADIO_TIMINGS_H
+#define SX126X_RADIO_TIMINGS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include "sx126x.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/**
+ * @brief Whether the interrupt processing times of the model have been characterised on SX126x
+ *
+ * @remark 0 as long as the LR11xx figures are used as placeholders: the delays returned below then carry a constant
+ * bias which has not been measured
+ */
+#define SX126X_RADIO_TIMINGS_IS_CHARACTERISED 0
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Get the time between the last bit sent (on Tx side) and the Rx done event (on Rx side)
+ *
+ * @param [in] mod_params Pointer to a structure holding the LoRa modulation parameters used for the computation
+ *
+ * @returns Delay in microsecond
+ */
+uint32_t sx126x_radio_timings_get_delay_between_last_bit_sent_and_rx_done_in_us(
+    const sx126x_mod_params_lora_t* mod_params );
+
+/**
+ * @brief Get the time between the last bit sent and the Tx done event
+ *
+ * @param [in] ramp_time Power amplifier ramp time
+ *
+ * @returns Delay in microsecond
+ */
+uint32_t sx126x_radio_timings_get_delay_between_last_bit_sent_and_tx_done_in_us( const sx126x_ramp_time_t ramp_time );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SX126X_RADIO_TIMINGS_H
+
+/* --- EOF ------------------------------------------------------------------ */